@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2011-06-27
 
-  (C) Copyright 2011-2020 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2011-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -95,7 +95,13 @@ public:
 
     static size_t ScalarNumber(const DataType & data)
     {
-        return cmnDataVectorScalarNumber(data) + 1; /* treat list size as a scalar */
+        size_t result = 1; /* treat list size as a scalar */
+        typename DataType::const_iterator iter = data.begin();
+        const typename DataType::const_iterator end = data.end();
+        for (; iter != end; ++iter) {
+            result += cmnData<_elementType>::ScalarNumber(*iter);
+        }
+        return result;
     }
 
     static std::string ScalarDescription(const DataType & data, const size_t index,
@@ -106,7 +112,22 @@ public:
         if (index == 0) {
             return cmnData<size_t>::ScalarDescription(data.size(), 0, userDescription + ".size");
         }
-        return cmnDataVectorScalarDescription(data, index - 1, userDescription);
+        /* lists don't provide random access, find element iteratively */
+        size_t elementIndex = 0;
+        size_t inElementIndex = index - 1;
+        typename DataType::const_iterator iter = data.begin();
+        const typename DataType::const_iterator end = data.end();
+        for (; iter != end; ++iter, ++elementIndex) {
+            const size_t scalarNumber = cmnData<_elementType>::ScalarNumber(*iter);
+            if (inElementIndex < scalarNumber) {
+                std::stringstream suffix;
+                suffix << "[" << elementIndex << "]";
+                return cmnData<_elementType>::ScalarDescription(*iter, inElementIndex, userDescription + suffix.str());
+            }
+            inElementIndex -= scalarNumber;
+        }
+        cmnThrow(std::out_of_range("cmnDataScalarDescription: list index out of range"));
+        return "";
     }
 
     static double Scalar(const DataType & data, const size_t index)
@@ -116,7 +137,18 @@ public:
         if (index == 0) {
             return static_cast<double>(data.size());
         }
-        return cmnDataVectorScalar(data, index - 1);
+        size_t inElementIndex = index - 1;
+        typename DataType::const_iterator iter = data.begin();
+        const typename DataType::const_iterator end = data.end();
+        for (; iter != end; ++iter) {
+            const size_t scalarNumber = cmnData<_elementType>::ScalarNumber(*iter);
+            if (inElementIndex < scalarNumber) {
+                return cmnData<_elementType>::Scalar(*iter, inElementIndex);
+            }
+            inElementIndex -= scalarNumber;
+        }
+        cmnThrow(std::out_of_range("cmnDataScalar: list index out of range"));
+        return 0.0;
     }
 };
 
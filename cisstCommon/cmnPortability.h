@@ -611,4 +611,14 @@ bool CISST_EXPORT cmnIsFinite(const double & value);
 #endif // DOXYGEN
 
 
+/*! Size in bytes of a CPU cache line.  This is used to pad data
+  structures shared between threads (e.g. head and tail indices of
+  lock-free queues) so that variables written by different threads
+  don't end up on the same cache line (false sharing).  64 bytes is
+  correct for all x86 and most ARM processors supported by cisst.  */
+#ifndef CMN_CACHE_LINE_SIZE
+  #define CMN_CACHE_LINE_SIZE 64
+#endif
+
+
 #endif // _cmnPortability_h
@@ -21,6 +21,8 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <limits>
 #include <cisstCommon/cmnDataFunctionsString.h>
+#include <cisstCommon/cmnDataFunctionsList.h>
+#include <cisstCommon/cmnDataFunctionsVector.h>
 
 void cmnDataFunctionsTest::TestCopyNativeTypes(void)
 {
@@ -248,4 +250,21 @@ void cmnDataFunctionsTest::TestDescriptions(void)
 
     unsigned long long int ulli1;
     CPPUNIT_ASSERT_EQUAL(std::string("{ulli}"), cmnData<unsigned long long int>::ScalarDescription(ulli1, 0));
+
+    // list of vectors, element index is not the scalar index
+    typedef std::vector<double> VectorType;
+    std::list<VectorType> l1;
+    l1.push_back(VectorType(2, 1.0));
+    l1.push_back(VectorType(3, 2.0));
+    CPPUNIT_ASSERT_EQUAL(size_t(8), cmnData<std::list<VectorType> >::ScalarNumber(l1));
+    CPPUNIT_ASSERT_EQUAL(std::string("v[0][1]:{d}"), cmnData<std::list<VectorType> >::ScalarDescription(l1, 3));
+    CPPUNIT_ASSERT_EQUAL(std::string("v[1][0]:{d}"), cmnData<std::list<VectorType> >::ScalarDescription(l1, 5));
+    CPPUNIT_ASSERT_EQUAL(std::string("v[1][2]:{d}"), cmnData<std::list<VectorType> >::ScalarDescription(l1, 7));
+    bool exceptionReceived = false;
+    try {
+        cmnData<std::list<VectorType> >::ScalarDescription(l1, 8);
+    } catch (std::out_of_range &) {
+        exceptionReceived = true;
+    }
+    CPPUNIT_ASSERT(exceptionReceived);
 }
@@ -5,7 +5,7 @@
   Author(s):  Min Yang Jung, Anton Deguet
   Created on: 2009-03-20
 
-  (C) Copyright 2009-2025 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -140,6 +140,9 @@ void mtsCollectorBase::SetOutput(const std::string & fileName,
         case COLLECTOR_FILE_FORMAT_PLAIN_TEXT:
             ext = ".txt";
             break;
+        case COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR:
+            ext = ".ccol";
+            break;
         default:
             ext = ".cdat";
             break;
@@ -209,6 +212,10 @@ void mtsCollectorBase::OpenFileIfNeeded(void)
         this->OutputHeaderFile->open(this->OutputHeaderFileName.c_str(), std::ios::trunc);
         this->FileOpened = true;
         break;
+    case COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR:
+        // file is created by the derived class (see mtsCollectorState)
+        CMN_LOG_CLASS_INIT_ERROR << "SetOutput: columnar binary format is only supported by mtsCollectorState" << std::endl;
+        return;
     default:
         CMN_LOG_CLASS_INIT_ERROR << "SetOutput: unexpected file format.";
         break;
@@ -229,6 +236,8 @@ void mtsCollectorBase::SetOutputToDefault(const CollectorFileFormat fileFormat)
         suffix = "txt";
     } else if (fileFormat == COLLECTOR_FILE_FORMAT_CSV) {
         suffix = "csv";
+    } else if (fileFormat == COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR) {
+        suffix = "ccol"; // for cisst columnar
     } else {
         suffix = "cdat"; // for cisst dat
     }
@@ -6,7 +6,7 @@
   Author(s):  Min Yang Jung, Anton Deguet
   Created on: 2009-03-20
 
-  (C) Copyright 2009-2025 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -30,6 +30,8 @@ http://www.cisst.org/cisst/license.txt.
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <cstring>
+#include <limits>
 
 /* Header Definition. The value of END_OF_HEADER_SIZE should match the size of
    END_OF_HEADER array. */
@@ -45,6 +47,9 @@ static char EndOfHeader[END_OF_HEADER_SIZE] = END_OF_HEADER;
 mtsCollectorState::mtsCollectorState(const std::string & collectorName):
     mtsCollectorBase(collectorName,
                      COLLECTOR_FILE_FORMAT_UNDEFINED),
+    ColumnarPageSize(1024 * 1024),
+    ColumnarNumberOfPages(8),
+    ColumnarDirectIO(false),
     TargetComponent(0),
     TargetStateTable(0)
 {
@@ -57,6 +62,9 @@ mtsCollectorState::mtsCollectorState(const std::string & targetComponentName,
                                      const mtsCollectorBase::CollectorFileFormat fileFormat):
     mtsCollectorBase(std::string("StateCollectorFor") + targetComponentName + targetStateTableName,
                      fileFormat),
+    ColumnarPageSize(1024 * 1024),
+    ColumnarNumberOfPages(8),
+    ColumnarDirectIO(false),
     TargetComponent(0),
     TargetStateTable(0)
 {
@@ -68,6 +76,10 @@ mtsCollectorState::mtsCollectorState(const std::string & targetComponentName,
 
 mtsCollectorState::~mtsCollectorState()
 {
+    // background writer for columnar binary
+    if (this->ColumnarWriter.IsOpen()) {
+        this->ColumnarWriter.Close();
+    }
     // serializer was created for a binary output
     if (this->Serializer) {
         delete this->Serializer;
@@ -346,15 +358,39 @@ void mtsCollectorState::BatchCollect(const mtsStateTable::IndexRange & range)
 {
     if (RegisteredSignalElements.size() == 0) return;
 
+    const bool columnar = (this->FileFormat == COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR);
+
     // If this method is called for the first time, print out some information.
     if (FirstRunningFlag) {
-        this->OpenFileIfNeeded();
-        PrintHeader(this->FileFormat);
+        if (columnar) {
+            // try again on next batch if the file can't be opened
+            if (OpenColumnarOutput()) {
+                FirstRunningFlag = false;
+            }
+        } else {
+            this->OpenFileIfNeeded();
+            PrintHeader(this->FileFormat);
+        }
     }
 
     const size_t startIndex = range.First.Ticks() % TableHistoryLength;
     const size_t endIndex = range.Last.Ticks() % TableHistoryLength;
 
+    if (columnar) {
+        if (startIndex < endIndex) {
+            if (FetchStateTableDataColumnar(TargetStateTable, startIndex, endIndex)) {
+                LastReadIndex = (endIndex + (OffsetForNextRead - 1)) % TableHistoryLength;
+            }
+        } else if (startIndex > endIndex) {
+            if (FetchStateTableDataColumnar(TargetStateTable, startIndex, TableHistoryLength - 1)) {
+                if (FetchStateTableDataColumnar(TargetStateTable, 0, endIndex)) {
+                    LastReadIndex = (endIndex + (OffsetForNextRead - 1)) % TableHistoryLength;
+                }
+            }
+        }
+        return;
+    }
+
     if (startIndex < endIndex) {
         // normal case
         if (FetchStateTableData(TargetStateTable, startIndex, endIndex)) {
@@ -574,6 +610,212 @@ bool mtsCollectorState::FetchStateTableData(const mtsStateTable * table,
 }
 
 
+void mtsCollectorState::SetColumnarOptions(const size_t pageSize,
+                                           const size_t numberOfPages,
+                                           const bool directIO)
+{
+    ColumnarPageSize = pageSize;
+    ColumnarNumberOfPages = numberOfPages;
+    ColumnarDirectIO = directIO;
+}
+
+
+void mtsCollectorState::CloseOutput(void)
+{
+    if (this->FileFormat == COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR) {
+        if (this->ColumnarWriter.IsOpen()) {
+            CMN_LOG_CLASS_INIT_VERBOSE << "CloseOutput: closing file \"" << this->OutputFileName << "\"" << std::endl;
+            if (!this->ColumnarWriter.Close()) {
+                CMN_LOG_CLASS_INIT_ERROR << "CloseOutput: error while writing \"" << this->OutputFileName << "\"" << std::endl;
+            }
+        } else {
+            CMN_LOG_CLASS_INIT_ERROR << "CloseOutput: file not open for \"" << this->GetName() << "\"" << std::endl;
+        }
+        return;
+    }
+    mtsCollectorBase::CloseOutput();
+}
+
+
+bool mtsCollectorState::OpenColumnarOutput(void)
+{
+    // output might have been changed since last file
+    if (this->ColumnarWriter.IsOpen()) {
+        this->ColumnarWriter.Close();
+    }
+    if (this->OutputFile == 0) {
+        CMN_LOG_CLASS_RUN_ERROR << "OpenColumnarOutput: columnar binary format requires a file name, not a stream, for collector \""
+                                << this->GetName() << "\"" << std::endl;
+        return false;
+    }
+
+    std::string currentDateTime;
+    osaGetDateTimeString(currentDateTime);
+    const osaTimeServer & timeServer = mtsTaskManager::GetInstance()->GetTimeServer();
+    osaAbsoluteTime origin;
+    timeServer.GetTimeOrigin(origin);
+
+    // number of columns for each signal, based on the first element
+    std::stringstream columns;
+    size_t numberOfColumns = 0;
+    ColumnarNumberOfScalars.resize(RegisteredSignalElements.size());
+    columns << "column Ticks" << std::endl;
+    for (size_t signal = 0; signal < RegisteredSignalElements.size(); ++signal) {
+        const unsigned int id = RegisteredSignalElements[signal].ID;
+        const mtsGenericObject & element = (*(TargetStateTable->StateVector[id]))[0];
+        const size_t numberOfScalars = element.ScalarNumber();
+        if (numberOfScalars == 0) {
+            CMN_LOG_CLASS_INIT_WARNING << "OpenColumnarOutput: signal \"" << RegisteredSignalElements[signal].Name
+                                       << "\" has no scalar, it will not be collected by \"" << this->GetName() << "\"" << std::endl;
+        }
+        for (size_t scalar = 0; scalar < numberOfScalars; ++scalar) {
+            columns << "column " << element.ScalarDescription(scalar, TargetStateTable->StateVectorDataNames[id]) << std::endl;
+        }
+        ColumnarNumberOfScalars[signal] = numberOfScalars;
+        numberOfColumns += numberOfScalars;
+    }
+    columns << "end" << std::endl;
+
+    std::stringstream header;
+    header.precision(20);
+    header << "component " << TargetComponent->GetName() << std::endl
+           << "table " << TargetStateTable->GetName() << std::endl
+           << "date " << currentDateTime << std::endl
+           << "time-origin " << origin.ToSeconds() << std::endl
+           << "sampling-interval " << SamplingInterval << std::endl
+           << columns.str();
+
+    if (!this->ColumnarWriter.Open(this->OutputFileName, header.str(), numberOfColumns,
+                                   ColumnarPageSize, ColumnarNumberOfPages, ColumnarDirectIO)) {
+        CMN_LOG_CLASS_INIT_ERROR << "OpenColumnarOutput: failed to open \"" << this->OutputFileName
+                                 << "\" for collector \"" << this->GetName() << "\"" << std::endl;
+        return false;
+    }
+    this->FileOpened = true;
+    return true;
+}
+
+
+bool mtsCollectorState::FetchStateTableDataColumnar(const mtsStateTable * table,
+                                                    const size_t startIndex,
+                                                    const size_t endIndex)
+{
+    if (!this->ColumnarWriter.IsOpen()) {
+        CMN_LOG_CLASS_RUN_ERROR << "FetchStateTableDataColumnar: output file for collector \"" << this->GetName() << "\" is not available." << std::endl;
+        return true;
+    }
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    size_t index = startIndex;
+    while (index <= endIndex) {
+        const size_t requested = (endIndex - index) / SamplingInterval + 1;
+        const size_t numberOfRows = this->ColumnarWriter.BeginRows(requested);
+        if (numberOfRows == 0) {
+            CMN_LOG_CLASS_RUN_ERROR << "FetchStateTableDataColumnar: encountered problem on output file for collector \""
+                                    << this->GetName() << "\"" << std::endl;
+            break;
+        }
+        // ticks are atomic in the state table, see mtsStateTable::ValidateReadIndex
+        unsigned long long * ticks = this->ColumnarWriter.Ticks();
+        for (size_t row = 0; row < numberOfRows; ++row) {
+            ticks[row] = table->Ticks[index + row * SamplingInterval].load(std::memory_order_relaxed);
+        }
+        // one column per scalar, fill column by column
+        size_t column = 0;
+        for (size_t signal = 0; signal < RegisteredSignalElements.size(); ++signal) {
+            const mtsStateArrayBase & array = *(table->StateVector[RegisteredSignalElements[signal].ID]);
+            const size_t numberOfScalars = ColumnarNumberOfScalars[signal];
+            for (size_t scalar = 0; scalar < numberOfScalars; ++scalar, ++column) {
+                double * data = this->ColumnarWriter.Column(column);
+                for (size_t row = 0; row < numberOfRows; ++row) {
+                    const mtsGenericObject & element = array[index + row * SamplingInterval];
+                    // size of dynamic objects might change over time
+                    if (element.ScalarNumberIsFixed() || (scalar < element.ScalarNumber())) {
+                        data[row] = element.Scalar(scalar);
+                    } else {
+                        data[row] = nan;
+                    }
+                }
+            }
+        }
+        this->ColumnarWriter.EndRows(numberOfRows);
+        index += numberOfRows * SamplingInterval;
+    }
+    OffsetForNextRead = (index - endIndex == 0 ? SamplingInterval : index - endIndex);
+    return true;
+}
+
+
+bool mtsCollectorState::ConvertColumnarToText(std::ifstream & inFile,
+                                              std::ofstream & outFile,
+                                              const char delimiter)
+{
+    // parse header, "key value" per line
+    std::string line, key, value;
+    size_t headerSize = 0, pageSize = 0, rowsPerPage = 0, numberOfColumns = 0;
+    std::vector<std::string> columnNames;
+    while (std::getline(inFile, line) && (line != "end")) {
+        const size_t separator = line.find(' ');
+        key = line.substr(0, separator);
+        value = (separator == std::string::npos) ? "" : line.substr(separator + 1);
+        if (key == "header-size") {
+            headerSize = strtoul(value.c_str(), 0, 10);
+        } else if (key == "page-size") {
+            pageSize = strtoul(value.c_str(), 0, 10);
+        } else if (key == "rows-per-page") {
+            rowsPerPage = strtoul(value.c_str(), 0, 10);
+        } else if (key == "columns") {
+            numberOfColumns = strtoul(value.c_str(), 0, 10);
+        } else if (key == "column") {
+            columnNames.push_back(value);
+        } else {
+            outFile << "# " << key << ": " << value << std::endl;
+        }
+    }
+    if ((line != "end")
+        || (headerSize == 0) || (rowsPerPage == 0)
+        || (pageSize != mtsCollectorStateColumnarFormat::AlignedSize(pageSize))
+        || (rowsPerPage != mtsCollectorStateColumnarFormat::RowsPerPage(pageSize, numberOfColumns))
+        || (columnNames.size() != numberOfColumns + 1)) {
+        CMN_LOG_INIT_ERROR << "Class mtsCollectorState: ConvertBinaryToText: corrupted columnar header." << std::endl;
+        return false;
+    }
+    outFile << "#";
+    for (size_t column = 0; column < columnNames.size(); ++column) {
+        outFile << (column == 0 ? ' ' : delimiter) << columnNames[column];
+    }
+    outFile << std::endl;
+    outFile.precision(std::numeric_limits<double>::digits10 + 2);
+
+    // read page by page
+    inFile.clear();
+    inFile.seekg(headerSize, std::ios::beg);
+    std::vector<char> page(pageSize);
+    while (inFile.read(&(page[0]), pageSize)) {
+        const mtsCollectorStateColumnarFormat::PageHeader * pageHeader =
+            reinterpret_cast<const mtsCollectorStateColumnarFormat::PageHeader *>(&(page[0]));
+        if ((pageHeader->Magic != mtsCollectorStateColumnarFormat::PageMagic)
+            || (pageHeader->NumberOfRows > rowsPerPage)) {
+            CMN_LOG_INIT_ERROR << "Class mtsCollectorState: ConvertBinaryToText: corrupted page at "
+                               << inFile.tellg() << std::endl;
+            return false;
+        }
+        const unsigned long long * ticks =
+            reinterpret_cast<const unsigned long long *>(&(page[mtsCollectorStateColumnarFormat::TicksOffset()]));
+        for (size_t row = 0; row < pageHeader->NumberOfRows; ++row) {
+            outFile << ticks[row];
+            for (size_t column = 0; column < numberOfColumns; ++column) {
+                const double * data =
+                    reinterpret_cast<const double *>(&(page[mtsCollectorStateColumnarFormat::ColumnOffset(rowsPerPage, column)]));
+                outFile << delimiter << data[row];
+            }
+            outFile << std::endl;
+        }
+    }
+    return true;
+}
+
+
 bool mtsCollectorState::ConvertBinaryToText(const std::string sourceBinaryFileName,
                                             const std::string targetPlainTextFileName,
                                             const char delimiter)
@@ -597,6 +839,21 @@ bool mtsCollectorState::ConvertBinaryToText(const std::string sourceBinaryFileNa
     std::ifstream::pos_type inFileTotalSize = inFile.tellg();
     inFile.seekg(0, std::ios::beg);
 
+    // Check if this is a columnar binary file
+    std::string firstLine;
+    std::getline(inFile, firstLine);
+    if (firstLine == mtsCollectorStateColumnarFormat::FileMagic()) {
+        const bool result = ConvertColumnarToText(inFile, outFile, delimiter);
+        if (result) {
+            CMN_LOG_INIT_VERBOSE << "Class mtsCollectorState: ConvertBinaryToText: conversion completed: " << targetPlainTextFileName << std::endl;
+        }
+        outFile.close();
+        inFile.close();
+        return result;
+    }
+    inFile.clear();
+    inFile.seekg(0, std::ios::beg);
+
     // Read the first character in a line. If it is '#', it is a part of header.
     char line[2048];
     while (true) {
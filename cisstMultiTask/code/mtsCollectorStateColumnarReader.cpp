@@ -0,0 +1,385 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstMultiTask/mtsCollectorStateColumnarReader.h>
+
+#include <cisstCommon/cmnLogger.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#if (CISST_OS == CISST_WINDOWS)
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+const size_t mtsCollectorStateColumnarReader::InvalidIndex = static_cast<size_t>(-1);
+
+
+mtsCollectorStateColumnarReader::mtsCollectorStateColumnarReader(void):
+    Memory(0),
+    FileSize(0),
+    FileHandle(0),
+    MappingHandle(0),
+    HeaderSize(0),
+    PageSize(0),
+    RowsPerPage(0),
+    NumberOfColumns(0),
+    NumberOfRows(0),
+    AllPagesFull(true)
+{
+}
+
+
+mtsCollectorStateColumnarReader::~mtsCollectorStateColumnarReader()
+{
+    Close();
+}
+
+
+bool mtsCollectorStateColumnarReader::Open(const std::string & fileName)
+{
+    Close();
+    FileName = fileName;
+
+#if (CISST_OS == CISST_WINDOWS)
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorStateColumnarReader::Open: unable to open file \"" << fileName << "\"" << std::endl;
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || (size.QuadPart == 0)) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorStateColumnarReader::Open: unable to get size or empty file \"" << fileName << "\"" << std::endl;
+        CloseHandle(file);
+        return false;
+    }
+    FileSize = static_cast<size_t>(size.QuadPart);
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorStateColumnarReader::Open: unable to map file \"" << fileName << "\"" << std::endl;
+        CloseHandle(file);
+        return false;
+    }
+    Memory = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    FileHandle = file;
+    MappingHandle = mapping;
+#else
+    const int file = open(fileName.c_str(), O_RDONLY);
+    if (file < 0) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorStateColumnarReader::Open: unable to open file \"" << fileName << "\"" << std::endl;
+        return false;
+    }
+    struct stat fileStat;
+    if ((fstat(file, &fileStat) != 0) || (fileStat.st_size == 0)) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorStateColumnarReader::Open: unable to get size or empty file \"" << fileName << "\"" << std::endl;
+        close(file);
+        return false;
+    }
+    FileSize = static_cast<size_t>(fileStat.st_size);
+    void * memory = mmap(0, FileSize, PROT_READ, MAP_SHARED, file, 0);
+    // the mapping remains valid after the file is closed
+    close(file);
+    if (memory == MAP_FAILED) {
+        memory = 0;
+    }
+    Memory = static_cast<const char *>(memory);
+#endif
+    if (!Memory) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorStateColumnarReader::Open: unable to map file \"" << fileName << "\"" << std::endl;
+        Close();
+        return false;
+    }
+
+    if (!ParseHeader() || !IndexPages()) {
+        Close();
+        return false;
+    }
+    CMN_LOG_INIT_VERBOSE << "mtsCollectorStateColumnarReader::Open: opened \"" << fileName << "\", "
+                         << NumberOfRows << " rows, " << NumberOfColumns << " columns, "
+                         << Pages.size() << " pages" << std::endl;
+    return true;
+}
+
+
+void mtsCollectorStateColumnarReader::Close(void)
+{
+#if (CISST_OS == CISST_WINDOWS)
+    if (Memory) {
+        UnmapViewOfFile(Memory);
+    }
+    if (MappingHandle) {
+        CloseHandle(static_cast<HANDLE>(MappingHandle));
+    }
+    if (FileHandle) {
+        CloseHandle(static_cast<HANDLE>(FileHandle));
+    }
+#else
+    if (Memory) {
+        munmap(const_cast<char *>(Memory), FileSize);
+    }
+#endif
+    Memory = 0;
+    FileSize = 0;
+    FileHandle = 0;
+    MappingHandle = 0;
+    HeaderSize = 0;
+    PageSize = 0;
+    RowsPerPage = 0;
+    NumberOfColumns = 0;
+    NumberOfRows = 0;
+    AllPagesFull = true;
+    ColumnNames.clear();
+    HeaderValues.clear();
+    Pages.clear();
+    FirstRows.clear();
+}
+
+
+bool mtsCollectorStateColumnarReader::ParseHeader(void)
+{
+    // header is text, up to first '\0' or page alignment
+    const size_t maxHeaderSize = std::min(FileSize, mtsCollectorStateColumnarFormat::PageAlignment);
+    const char * end = static_cast<const char *>(memchr(Memory, '\0', maxHeaderSize));
+    std::stringstream firstPage(std::string(Memory, end ? (end - Memory) : maxHeaderSize));
+    std::string line;
+    std::getline(firstPage, line);
+    if (line != mtsCollectorStateColumnarFormat::FileMagic()) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorStateColumnarReader::ParseHeader: \"" << FileName
+                           << "\" is not a columnar binary file" << std::endl;
+        return false;
+    }
+    std::getline(firstPage, line);
+    if (line.compare(0, 12, "header-size ") != 0) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorStateColumnarReader::ParseHeader: missing header size in \"" << FileName << "\"" << std::endl;
+        return false;
+    }
+    HeaderSize = strtoul(line.c_str() + 12, 0, 10);
+    if ((HeaderSize == 0) || (HeaderSize > FileSize)) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorStateColumnarReader::ParseHeader: invalid header size in \"" << FileName << "\"" << std::endl;
+        return false;
+    }
+
+    // now parse the full header
+    end = static_cast<const char *>(memchr(Memory, '\0', HeaderSize));
+    std::stringstream header(std::string(Memory, end ? (end - Memory) : HeaderSize));
+    std::string key, value;
+    bool endFound = false;
+    while (!endFound && std::getline(header, line)) {
+        const size_t separator = line.find(' ');
+        key = line.substr(0, separator);
+        value = (separator == std::string::npos) ? "" : line.substr(separator + 1);
+        if (key == "end") {
+            endFound = true;
+        } else if (key == "column") {
+            ColumnNames.push_back(value);
+        } else {
+            HeaderValues[key] = value;
+        }
+    }
+    PageSize = strtoul(GetHeaderValue("page-size").c_str(), 0, 10);
+    RowsPerPage = strtoul(GetHeaderValue("rows-per-page").c_str(), 0, 10);
+    NumberOfColumns = strtoul(GetHeaderValue("columns").c_str(), 0, 10);
+    if (!endFound
+        || (PageSize == 0) || (RowsPerPage == 0)
+        || (PageSize != mtsCollectorStateColumnarFormat::AlignedSize(PageSize))
+        || (RowsPerPage != mtsCollectorStateColumnarFormat::RowsPerPage(PageSize, NumberOfColumns))
+        || (ColumnNames.size() != NumberOfColumns + 1)) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorStateColumnarReader::ParseHeader: corrupted header in \"" << FileName << "\"" << std::endl;
+        return false;
+    }
+    // first column is always ticks
+    ColumnNames.erase(ColumnNames.begin());
+    return true;
+}
+
+
+bool mtsCollectorStateColumnarReader::IndexPages(void)
+{
+    const size_t numberOfPages = (FileSize - HeaderSize) / PageSize;
+    if ((FileSize - HeaderSize) % PageSize != 0) {
+        CMN_LOG_INIT_WARNING << "mtsCollectorStateColumnarReader::IndexPages: \"" << FileName
+                             << "\" has an incomplete last page, ignoring it" << std::endl;
+    }
+    Pages.reserve(numberOfPages);
+    FirstRows.reserve(numberOfPages);
+    NumberOfRows = 0;
+    AllPagesFull = true;
+    for (size_t index = 0; index < numberOfPages; ++index) {
+        const char * page = Memory + HeaderSize + index * PageSize;
+        const mtsCollectorStateColumnarFormat::PageHeader * pageHeader =
+            reinterpret_cast<const mtsCollectorStateColumnarFormat::PageHeader *>(page);
+        if ((pageHeader->Magic != mtsCollectorStateColumnarFormat::PageMagic)
+            || (pageHeader->NumberOfRows > RowsPerPage)) {
+            CMN_LOG_INIT_ERROR << "mtsCollectorStateColumnarReader::IndexPages: corrupted page " << index
+                               << " in \"" << FileName << "\"" << std::endl;
+            return false;
+        }
+        // partial pages not at the end prevent direct computation
+        if (!Pages.empty() && (NumberOfRows - FirstRows.back() != RowsPerPage)) {
+            AllPagesFull = false;
+        }
+        Pages.push_back(page);
+        FirstRows.push_back(NumberOfRows);
+        NumberOfRows += pageHeader->NumberOfRows;
+    }
+    return true;
+}
+
+
+void mtsCollectorStateColumnarReader::PageForRow(const size_t row, size_t & page, size_t & rowInPage) const
+{
+    if (AllPagesFull) {
+        page = row / RowsPerPage;
+        rowInPage = row % RowsPerPage;
+        return;
+    }
+    page = (std::upper_bound(FirstRows.begin(), FirstRows.end(), row) - FirstRows.begin()) - 1;
+    rowInPage = row - FirstRows[page];
+}
+
+
+const std::string & mtsCollectorStateColumnarReader::GetColumnName(const size_t column) const
+{
+    return ColumnNames.at(column);
+}
+
+
+size_t mtsCollectorStateColumnarReader::GetColumnIndex(const std::string & name) const
+{
+    for (size_t column = 0; column < ColumnNames.size(); ++column) {
+        const std::string & columnName = ColumnNames[column];
+        if ((columnName == name)
+            || ((columnName.compare(0, name.size(), name) == 0)
+                && (columnName.size() > name.size())
+                && (columnName[name.size()] == ':'))) {
+            return column;
+        }
+    }
+    return InvalidIndex;
+}
+
+
+std::string mtsCollectorStateColumnarReader::GetHeaderValue(const std::string & key) const
+{
+    const HeaderValuesType::const_iterator found = HeaderValues.find(key);
+    if (found == HeaderValues.end()) {
+        return "";
+    }
+    return found->second;
+}
+
+
+size_t mtsCollectorStateColumnarReader::GetNumberOfRowsInPage(const size_t page) const
+{
+    return reinterpret_cast<const mtsCollectorStateColumnarFormat::PageHeader *>(Pages[page])->NumberOfRows;
+}
+
+
+unsigned long long mtsCollectorStateColumnarReader::GetTick(const size_t row) const
+{
+    size_t page, rowInPage;
+    PageForRow(row, page, rowInPage);
+    return GetTicks(page)[rowInPage];
+}
+
+
+double mtsCollectorStateColumnarReader::GetValue(const size_t row, const size_t column) const
+{
+    size_t page, rowInPage;
+    PageForRow(row, page, rowInPage);
+    return GetColumn(page, column)[rowInPage];
+}
+
+
+template <class _valueType, class _accessorType>
+size_t mtsCollectorStateColumnarReader::LowerBound(const _valueType & value, _accessorType accessor) const
+{
+    size_t first = 0;
+    size_t count = NumberOfRows;
+    while (count > 0) {
+        const size_t step = count / 2;
+        const size_t middle = first + step;
+        if (accessor(middle) < value) {
+            first = middle + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    return first;
+}
+
+
+namespace {
+    struct mtsCollectorStateColumnarTicksAccessor {
+        const mtsCollectorStateColumnarReader * Reader;
+        inline unsigned long long operator()(const size_t row) const {
+            return Reader->GetTick(row);
+        }
+    };
+
+    struct mtsCollectorStateColumnarValueAccessor {
+        const mtsCollectorStateColumnarReader * Reader;
+        size_t Column;
+        inline double operator()(const size_t row) const {
+            return Reader->GetValue(row, Column);
+        }
+    };
+}
+
+
+size_t mtsCollectorStateColumnarReader::FindRowByTicks(const unsigned long long ticks) const
+{
+    mtsCollectorStateColumnarTicksAccessor accessor;
+    accessor.Reader = this;
+    return LowerBound(ticks, accessor);
+}
+
+
+size_t mtsCollectorStateColumnarReader::FindRow(const size_t column, const double value) const
+{
+    if (column >= NumberOfColumns) {
+        return NumberOfRows;
+    }
+    mtsCollectorStateColumnarValueAccessor accessor;
+    accessor.Reader = this;
+    accessor.Column = column;
+    return LowerBound(value, accessor);
+}
+
+
+size_t mtsCollectorStateColumnarReader::FindRowByTime(const double time) const
+{
+    const size_t column = GetColumnIndex("Toc");
+    if (column == InvalidIndex) {
+        CMN_LOG_RUN_ERROR << "mtsCollectorStateColumnarReader::FindRowByTime: \"Toc\" was not collected in \""
+                          << FileName << "\"" << std::endl;
+        return NumberOfRows;
+    }
+    return FindRow(column, time);
+}
@@ -0,0 +1,414 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstMultiTask/mtsCollectorStateColumnarWriter.h>
+
+#include <cisstCommon/cmnLogger.h>
+#include <cisstCommon/cmnUnits.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+
+#if (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_QNX) || (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX_XENOMAI)
+#define MTS_COLLECTOR_COLUMNAR_POSIX
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#elif (CISST_OS == CISST_WINDOWS)
+#include <malloc.h>
+#endif
+
+
+const unsigned int mtsCollectorStateColumnarFormat::PageMagic;
+const size_t mtsCollectorStateColumnarFormat::PageAlignment;
+
+
+const char * mtsCollectorStateColumnarFormat::FileMagic(void)
+{
+    return "cisst-columnar 1";
+}
+
+
+size_t mtsCollectorStateColumnarFormat::AlignedSize(const size_t size)
+{
+    return ((size + PageAlignment - 1) / PageAlignment) * PageAlignment;
+}
+
+
+size_t mtsCollectorStateColumnarFormat::RowsPerPage(const size_t pageSize, const size_t numberOfColumns)
+{
+    if (pageSize <= TicksOffset()) {
+        return 0;
+    }
+    // ticks and data columns are all 8 bytes
+    return (pageSize - TicksOffset()) / (sizeof(unsigned long long) + numberOfColumns * sizeof(double));
+}
+
+
+size_t mtsCollectorStateColumnarFormat::TicksOffset(void)
+{
+    return sizeof(PageHeader);
+}
+
+
+size_t mtsCollectorStateColumnarFormat::ColumnOffset(const size_t rowsPerPage, const size_t columnIndex)
+{
+    return TicksOffset()
+        + rowsPerPage * sizeof(unsigned long long)
+        + columnIndex * rowsPerPage * sizeof(double);
+}
+
+
+mtsCollectorStateColumnarWriter::mtsCollectorStateColumnarWriter(void):
+    PageSize(0),
+    NumberOfPages(0),
+    NumberOfColumns(0),
+    RowsPerPage(0),
+    Memory(0),
+    CurrentPage(0),
+    CurrentRow(0),
+    PageCounter(0),
+    ThreadRunning(false),
+    StopRequested(false),
+    WriteError(false),
+    FileDescriptor(-1),
+    File(0),
+    DirectIO(false),
+    PagesWritten(0),
+    WaitsForFreePage(0)
+{
+}
+
+
+mtsCollectorStateColumnarWriter::~mtsCollectorStateColumnarWriter()
+{
+    if (ThreadRunning) {
+        Close();
+    }
+    Cleanup();
+}
+
+
+bool mtsCollectorStateColumnarWriter::Open(const std::string & fileName,
+                                           const std::string & header,
+                                           const size_t numberOfColumns,
+                                           const size_t pageSize,
+                                           const size_t numberOfPages,
+                                           const bool directIO)
+{
+    if (ThreadRunning) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorStateColumnarWriter::Open: file \"" << FileName
+                           << "\" is already open, close it before opening \"" << fileName << "\"" << std::endl;
+        return false;
+    }
+    Cleanup();
+
+    FileName = fileName;
+    NumberOfColumns = numberOfColumns;
+    PageSize = mtsCollectorStateColumnarFormat::AlignedSize(pageSize);
+    NumberOfPages = (numberOfPages < 2) ? 2 : numberOfPages;
+    RowsPerPage = mtsCollectorStateColumnarFormat::RowsPerPage(PageSize, NumberOfColumns);
+    if (RowsPerPage == 0) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorStateColumnarWriter::Open: page size " << PageSize
+                           << " is too small for " << NumberOfColumns << " columns" << std::endl;
+        return false;
+    }
+
+    // allocate all pages at once
+    const size_t totalSize = PageSize * NumberOfPages;
+#if (CISST_OS == CISST_WINDOWS)
+    Memory = static_cast<char *>(_aligned_malloc(totalSize, mtsCollectorStateColumnarFormat::PageAlignment));
+#else
+    void * memory = 0;
+    if (posix_memalign(&memory, mtsCollectorStateColumnarFormat::PageAlignment, totalSize) != 0) {
+        memory = 0;
+    }
+    Memory = static_cast<char *>(memory);
+#endif
+    if (!Memory) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorStateColumnarWriter::Open: failed to allocate "
+                           << totalSize << " bytes" << std::endl;
+        return false;
+    }
+    memset(Memory, 0, totalSize);
+
+    // one slot is always unused in mtsQueue
+    FullPages.SetSize(NumberOfPages + 1, 0);
+    FreePages.SetSize(NumberOfPages + 1, 0);
+    for (size_t index = 0; index < NumberOfPages; ++index) {
+        FreePages.Put(Memory + index * PageSize);
+    }
+
+    // open file
+    DirectIO = false;
+#ifdef MTS_COLLECTOR_COLUMNAR_POSIX
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#if (CISST_OS == CISST_LINUX)
+    if (directIO) {
+        flags |= O_DIRECT;
+        DirectIO = true;
+    }
+#endif
+    FileDescriptor = open(FileName.c_str(), flags, 0644);
+    if ((FileDescriptor < 0) && DirectIO) {
+        // some file systems don't support direct IO
+        CMN_LOG_INIT_WARNING << "mtsCollectorStateColumnarWriter::Open: direct IO not available for \""
+                             << FileName << "\", using buffered IO" << std::endl;
+        DirectIO = false;
+        FileDescriptor = open(FileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    const bool fileOpened = (FileDescriptor >= 0);
+#else
+    if (directIO) {
+        CMN_LOG_INIT_WARNING << "mtsCollectorStateColumnarWriter::Open: direct IO not supported on this OS" << std::endl;
+    }
+    File = std::fopen(FileName.c_str(), "wb");
+    const bool fileOpened = (File != 0);
+#endif
+    if (!fileOpened) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorStateColumnarWriter::Open: unable to open file \""
+                           << FileName << "\"" << std::endl;
+        Cleanup();
+        return false;
+    }
+
+    // build the header, size is padded to keep pages aligned
+    std::stringstream body;
+    body << "page-size " << PageSize << std::endl
+         << "rows-per-page " << RowsPerPage << std::endl
+         << "columns " << NumberOfColumns << std::endl
+         << header;
+    const size_t headerSizeWidth = 15;
+    const size_t fixedSize =
+        strlen(mtsCollectorStateColumnarFormat::FileMagic()) + 1
+        + strlen("header-size ") + headerSizeWidth + 1;
+    const size_t headerSize = mtsCollectorStateColumnarFormat::AlignedSize(fixedSize + body.str().size());
+    std::stringstream fullHeader;
+    fullHeader << mtsCollectorStateColumnarFormat::FileMagic() << std::endl
+               << "header-size " << std::setw(headerSizeWidth) << std::setfill('0') << headerSize << std::endl
+               << body.str();
+
+    // header is written synchronously using an aligned buffer
+    bool headerWritten = false;
+    char * headerBuffer = 0;
+#if (CISST_OS == CISST_WINDOWS)
+    headerBuffer = static_cast<char *>(_aligned_malloc(headerSize, mtsCollectorStateColumnarFormat::PageAlignment));
+#else
+    void * buffer = 0;
+    if (posix_memalign(&buffer, mtsCollectorStateColumnarFormat::PageAlignment, headerSize) == 0) {
+        headerBuffer = static_cast<char *>(buffer);
+    }
+#endif
+    if (headerBuffer) {
+        memset(headerBuffer, 0, headerSize);
+        memcpy(headerBuffer, fullHeader.str().c_str(), fullHeader.str().size());
+        headerWritten = WriteToFile(headerBuffer, headerSize);
+#if (CISST_OS == CISST_WINDOWS)
+        _aligned_free(headerBuffer);
+#else
+        free(headerBuffer);
+#endif
+    }
+    if (!headerWritten) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorStateColumnarWriter::Open: failed to write header to \""
+                           << FileName << "\"" << std::endl;
+        Cleanup();
+        return false;
+    }
+
+    // start writer thread
+    CurrentPage = 0;
+    CurrentRow = 0;
+    PageCounter = 0;
+    PagesWritten = 0;
+    WaitsForFreePage = 0;
+    StopRequested = false;
+    WriteError = false;
+    Thread.Create<mtsCollectorStateColumnarWriter, void *>(this, &mtsCollectorStateColumnarWriter::WriterThread,
+                                                           0, "ColWriter");
+    ThreadRunning = true;
+    CMN_LOG_INIT_VERBOSE << "mtsCollectorStateColumnarWriter::Open: opened \"" << FileName << "\" with "
+                         << NumberOfPages << " pages of " << PageSize << " bytes, "
+                         << RowsPerPage << " rows per page" << std::endl;
+    return true;
+}
+
+
+bool mtsCollectorStateColumnarWriter::GetFreePage(void)
+{
+    char ** page = FreePages.Get();
+    if (!page) {
+        ++WaitsForFreePage;
+    }
+    while (!page) {
+        if (WriteError) {
+            return false;
+        }
+        FreePageSignal.Wait(1.0 * cmn_ms);
+        page = FreePages.Get();
+    }
+    CurrentPage = *page;
+    CurrentRow = 0;
+    return true;
+}
+
+
+void mtsCollectorStateColumnarWriter::SendCurrentPage(void)
+{
+    mtsCollectorStateColumnarFormat::PageHeader * header =
+        reinterpret_cast<mtsCollectorStateColumnarFormat::PageHeader *>(CurrentPage);
+    header->Magic = mtsCollectorStateColumnarFormat::PageMagic;
+    header->NumberOfRows = static_cast<unsigned int>(CurrentRow);
+    header->PageIndex = PageCounter;
+    ++PageCounter;
+    // there are as many slots as pages so this can't fail
+    FullPages.Put(CurrentPage);
+    FullPageSignal.Raise();
+    CurrentPage = 0;
+    CurrentRow = 0;
+}
+
+
+size_t mtsCollectorStateColumnarWriter::BeginRows(const size_t numberOfRows)
+{
+    if (!ThreadRunning || WriteError) {
+        return 0;
+    }
+    if (!CurrentPage) {
+        if (!GetFreePage()) {
+            return 0;
+        }
+    }
+    const size_t available = RowsPerPage - CurrentRow;
+    return (numberOfRows < available) ? numberOfRows : available;
+}
+
+
+void mtsCollectorStateColumnarWriter::EndRows(const size_t numberOfRows)
+{
+    CurrentRow += numberOfRows;
+    if (CurrentRow >= RowsPerPage) {
+        SendCurrentPage();
+    }
+}
+
+
+void mtsCollectorStateColumnarWriter::Flush(void)
+{
+    if (CurrentPage && (CurrentRow > 0)) {
+        SendCurrentPage();
+    }
+}
+
+
+bool mtsCollectorStateColumnarWriter::Close(void)
+{
+    if (!ThreadRunning) {
+        return false;
+    }
+    Flush();
+    // a page reserved but not used is dropped by Cleanup, it can't be
+    // put back in FreePages since the writer thread is its producer
+    StopRequested = true;
+    FullPageSignal.Raise();
+    Thread.Wait();
+    ThreadRunning = false;
+    const bool result = !WriteError;
+    CMN_LOG_INIT_VERBOSE << "mtsCollectorStateColumnarWriter::Close: closed \"" << FileName << "\", "
+                         << PagesWritten.load() << " pages written, waited "
+                         << WaitsForFreePage << " time(s) for a free page" << std::endl;
+    Cleanup();
+    return result;
+}
+
+
+bool mtsCollectorStateColumnarWriter::WriteToFile(const char * buffer, const size_t size)
+{
+#ifdef MTS_COLLECTOR_COLUMNAR_POSIX
+    size_t written = 0;
+    while (written < size) {
+        const ssize_t result = write(FileDescriptor, buffer + written, size - written);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            CMN_LOG_RUN_ERROR << "mtsCollectorStateColumnarWriter: write failed for \"" << FileName
+                              << "\": " << strerror(errno) << std::endl;
+            return false;
+        }
+        written += static_cast<size_t>(result);
+    }
+    return true;
+#else
+    return (std::fwrite(buffer, 1, size, File) == size);
+#endif
+}
+
+
+void * mtsCollectorStateColumnarWriter::WriterThread(void * CMN_UNUSED(argument))
+{
+    while (true) {
+        char ** page = FullPages.Get();
+        if (page) {
+            if (!WriteError) {
+                if (WriteToFile(*page, PageSize)) {
+                    ++PagesWritten;
+                } else {
+                    WriteError = true;
+                }
+            }
+            FreePages.Put(*page);
+            FreePageSignal.Raise();
+        } else if (StopRequested) {
+            break;
+        } else {
+            FullPageSignal.Wait(10.0 * cmn_ms);
+        }
+    }
+    return 0;
+}
+
+
+void mtsCollectorStateColumnarWriter::Cleanup(void)
+{
+#ifdef MTS_COLLECTOR_COLUMNAR_POSIX
+    if (FileDescriptor >= 0) {
+        close(FileDescriptor);
+        FileDescriptor = -1;
+    }
+#else
+    if (File) {
+        std::fclose(File);
+        File = 0;
+    }
+#endif
+    if (Memory) {
+#if (CISST_OS == CISST_WINDOWS)
+        _aligned_free(Memory);
+#else
+        free(Memory);
+#endif
+        Memory = 0;
+    }
+    CurrentPage = 0;
+    CurrentRow = 0;
+}
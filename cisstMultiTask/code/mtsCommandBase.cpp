@@ -0,0 +1,34 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+#include <cisstMultiTask/mtsCommandBase.h>
+#include <cisstMultiTask/mtsCommandStatistics.h>
+
+
+mtsCommandBase::~mtsCommandBase()
+{
+    delete StatisticsRecorder;
+}
+
+
+void mtsCommandBase::SetStatisticsRecorder(mtsCommandStatisticsRecorder * recorder)
+{
+    delete this->StatisticsRecorder;
+    this->StatisticsRecorder = recorder;
+}
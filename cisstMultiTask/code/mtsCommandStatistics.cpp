@@ -0,0 +1,296 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstCommon/cmnSerializer.h>
+#include <cisstCommon/cmnDeSerializer.h>
+#include <cisstMultiTask/mtsCommandStatistics.h>
+
+#include <cmath>
+
+CMN_IMPLEMENT_SERVICES(mtsCommandStatistics);
+
+
+size_t mtsCommandStatistics::Bin(const double duration)
+{
+    const double microSeconds = duration * 1.0e6;
+    if (!(microSeconds >= 1.0)) {
+        return 0;
+    }
+    // microSeconds = mantissa * 2^exponent with mantissa in [0.5, 1)
+    int exponent;
+    std::frexp(microSeconds, &exponent);
+    const size_t bin = static_cast<size_t>(exponent);
+    return (bin < NUMBER_OF_BINS) ? bin : (NUMBER_OF_BINS - 1);
+}
+
+
+double mtsCommandStatistics::BinUpperBound(const size_t bin)
+{
+    return std::ldexp(1.0e-6, static_cast<int>(bin));
+}
+
+
+namespace {
+    double mtsCommandStatisticsPercentile(const unsigned long long * histogram,
+                                          const double percentile)
+    {
+        const size_t bin = mtsHistogramRecorder<mtsCommandStatistics>::PercentileBin(histogram, percentile);
+        if (bin == mtsCommandStatistics::NUMBER_OF_BINS) {
+            return 0.0;
+        }
+        return mtsCommandStatistics::BinUpperBound(bin);
+    }
+}
+
+
+mtsCommandStatistics::CommandType::CommandType(void):
+    NumberOfExecutions(0),
+    QueueTimeSum(0.0),
+    QueueTimeMax(0.0),
+    ExecutionTimeSum(0.0),
+    ExecutionTimeMax(0.0)
+{
+    for (size_t bin = 0; bin < NUMBER_OF_BINS; ++bin) {
+        QueueTimeHistogram[bin] = 0;
+        ExecutionTimeHistogram[bin] = 0;
+    }
+}
+
+
+double mtsCommandStatistics::CommandType::QueueTimeAvg(void) const
+{
+    if (NumberOfExecutions == 0) {
+        return 0.0;
+    }
+    return QueueTimeSum / static_cast<double>(NumberOfExecutions);
+}
+
+
+double mtsCommandStatistics::CommandType::ExecutionTimeAvg(void) const
+{
+    if (NumberOfExecutions == 0) {
+        return 0.0;
+    }
+    return ExecutionTimeSum / static_cast<double>(NumberOfExecutions);
+}
+
+
+double mtsCommandStatistics::CommandType::QueueTimePercentile(const double percentile) const
+{
+    return mtsCommandStatisticsPercentile(QueueTimeHistogram, percentile);
+}
+
+
+double mtsCommandStatistics::CommandType::ExecutionTimePercentile(const double percentile) const
+{
+    return mtsCommandStatisticsPercentile(ExecutionTimeHistogram, percentile);
+}
+
+
+mtsCommandStatistics::mtsCommandStatistics(void):
+    mtsGenericObject(),
+    NumberOfCycles(0),
+    NumberOfCommands(0),
+    CommandsLastCycle(0),
+    CommandsMaxPerCycle(0)
+{
+}
+
+
+size_t mtsCommandStatistics::MostExpensiveCommand(void) const
+{
+    size_t result = Commands.size();
+    double maxTime = -1.0;
+    for (size_t index = 0; index < Commands.size(); ++index) {
+        if (Commands[index].ExecutionTimeSum > maxTime) {
+            maxTime = Commands[index].ExecutionTimeSum;
+            result = index;
+        }
+    }
+    return result;
+}
+
+
+void mtsCommandStatistics::ToStream(std::ostream & outputStream) const
+{
+    outputStream << "Cycles: " << NumberOfCycles
+                 << " Commands: " << NumberOfCommands
+                 << " CommandsLastCycle: " << CommandsLastCycle
+                 << " CommandsMaxPerCycle: " << CommandsMaxPerCycle;
+    const CommandsType::const_iterator end = Commands.end();
+    CommandsType::const_iterator command;
+    for (command = Commands.begin(); command != end; ++command) {
+        outputStream << std::endl
+                     << " " << command->UserName << ":" << command->CommandName
+                     << " Executions: " << command->NumberOfExecutions
+                     << " QueueTimeAvg: " << command->QueueTimeAvg()
+                     << " QueueTimeP99: " << command->QueueTimePercentile(0.99)
+                     << " QueueTimeMax: " << command->QueueTimeMax
+                     << " ExecutionTimeAvg: " << command->ExecutionTimeAvg()
+                     << " ExecutionTimeP99: " << command->ExecutionTimePercentile(0.99)
+                     << " ExecutionTimeMax: " << command->ExecutionTimeMax
+                     << " ExecutionTimeTotal: " << command->ExecutionTimeSum;
+    }
+}
+
+
+void mtsCommandStatistics::ToStreamRaw(std::ostream & outputStream, const char delimiter,
+                                       bool headerOnly, const std::string & headerPrefix) const
+{
+    BaseType::ToStreamRaw(outputStream, delimiter, headerOnly, headerPrefix);
+    outputStream << delimiter;
+    if (headerOnly) {
+        outputStream << headerPrefix << "-Cycles" << delimiter
+                     << headerPrefix << "-Commands" << delimiter
+                     << headerPrefix << "-CommandsLastCycle" << delimiter
+                     << headerPrefix << "-CommandsMaxPerCycle";
+    } else {
+        outputStream << NumberOfCycles << delimiter
+                     << NumberOfCommands << delimiter
+                     << CommandsLastCycle << delimiter
+                     << CommandsMaxPerCycle;
+    }
+    const CommandsType::const_iterator end = Commands.end();
+    CommandsType::const_iterator command;
+    for (command = Commands.begin(); command != end; ++command) {
+        outputStream << delimiter;
+        if (headerOnly) {
+            const std::string prefix = headerPrefix + "-" + command->UserName + ":" + command->CommandName;
+            outputStream << prefix << "-Executions" << delimiter
+                         << prefix << "-QueueTimeAvg" << delimiter
+                         << prefix << "-QueueTimeMax" << delimiter
+                         << prefix << "-ExecutionTimeAvg" << delimiter
+                         << prefix << "-ExecutionTimeMax";
+        } else {
+            outputStream << command->NumberOfExecutions << delimiter
+                         << command->QueueTimeAvg() << delimiter
+                         << command->QueueTimeMax << delimiter
+                         << command->ExecutionTimeAvg() << delimiter
+                         << command->ExecutionTimeMax;
+        }
+    }
+}
+
+
+void mtsCommandStatistics::SerializeRaw(std::ostream & outputStream) const
+{
+    BaseType::SerializeRaw(outputStream);
+    cmnSerializeRaw(outputStream, NumberOfCycles);
+    cmnSerializeRaw(outputStream, NumberOfCommands);
+    cmnSerializeRaw(outputStream, CommandsLastCycle);
+    cmnSerializeRaw(outputStream, CommandsMaxPerCycle);
+    cmnSerializeSizeRaw(outputStream, Commands.size());
+    const CommandsType::const_iterator end = Commands.end();
+    CommandsType::const_iterator command;
+    for (command = Commands.begin(); command != end; ++command) {
+        cmnSerializeRaw(outputStream, command->UserName);
+        cmnSerializeRaw(outputStream, command->CommandName);
+        cmnSerializeRaw(outputStream, command->NumberOfExecutions);
+        cmnSerializeRaw(outputStream, command->QueueTimeSum);
+        cmnSerializeRaw(outputStream, command->QueueTimeMax);
+        cmnSerializeRaw(outputStream, command->ExecutionTimeSum);
+        cmnSerializeRaw(outputStream, command->ExecutionTimeMax);
+        for (size_t bin = 0; bin < NUMBER_OF_BINS; ++bin) {
+            cmnSerializeRaw(outputStream, command->QueueTimeHistogram[bin]);
+            cmnSerializeRaw(outputStream, command->ExecutionTimeHistogram[bin]);
+        }
+    }
+}
+
+
+void mtsCommandStatistics::DeSerializeRaw(std::istream & inputStream)
+{
+    BaseType::DeSerializeRaw(inputStream);
+    cmnDeSerializeRaw(inputStream, NumberOfCycles);
+    cmnDeSerializeRaw(inputStream, NumberOfCommands);
+    cmnDeSerializeRaw(inputStream, CommandsLastCycle);
+    cmnDeSerializeRaw(inputStream, CommandsMaxPerCycle);
+    size_t size;
+    cmnDeSerializeSizeRaw(inputStream, size);
+    Commands.resize(size);
+    const CommandsType::iterator end = Commands.end();
+    CommandsType::iterator command;
+    for (command = Commands.begin(); command != end; ++command) {
+        cmnDeSerializeRaw(inputStream, command->UserName);
+        cmnDeSerializeRaw(inputStream, command->CommandName);
+        cmnDeSerializeRaw(inputStream, command->NumberOfExecutions);
+        cmnDeSerializeRaw(inputStream, command->QueueTimeSum);
+        cmnDeSerializeRaw(inputStream, command->QueueTimeMax);
+        cmnDeSerializeRaw(inputStream, command->ExecutionTimeSum);
+        cmnDeSerializeRaw(inputStream, command->ExecutionTimeMax);
+        for (size_t bin = 0; bin < NUMBER_OF_BINS; ++bin) {
+            cmnDeSerializeRaw(inputStream, command->QueueTimeHistogram[bin]);
+            cmnDeSerializeRaw(inputStream, command->ExecutionTimeHistogram[bin]);
+        }
+    }
+}
+
+
+mtsCommandStatisticsRecorder::mtsCommandStatisticsRecorder(void)
+{
+}
+
+
+void mtsCommandStatisticsRecorder::Record(const double queueTime, const double executionTime)
+{
+    QueueTime.Record(queueTime);
+    ExecutionTime.Record(executionTime);
+}
+
+
+void mtsCommandStatisticsRecorder::Get(mtsCommandStatistics::CommandType & command) const
+{
+    // min is not reported, both histograms have the same number of samples
+    unsigned long long numberOfSamples;
+    double min;
+    QueueTime.Get(numberOfSamples, command.QueueTimeSum, min, command.QueueTimeMax,
+                  command.QueueTimeHistogram);
+    ExecutionTime.Get(command.NumberOfExecutions, command.ExecutionTimeSum, min, command.ExecutionTimeMax,
+                      command.ExecutionTimeHistogram);
+}
+
+
+mtsCommandStatisticsCycleRecorder::mtsCommandStatisticsCycleRecorder(void):
+    NumberOfCycles(0),
+    NumberOfCommands(0),
+    CommandsLastCycle(0),
+    CommandsMaxPerCycle(0)
+{
+}
+
+
+void mtsCommandStatisticsCycleRecorder::Record(const size_t numberOfCommands)
+{
+    const std::memory_order relaxed = std::memory_order_relaxed;
+    NumberOfCycles.store(NumberOfCycles.load(relaxed) + 1, relaxed);
+    NumberOfCommands.store(NumberOfCommands.load(relaxed) + numberOfCommands, relaxed);
+    CommandsLastCycle.store(numberOfCommands, relaxed);
+    if (numberOfCommands > CommandsMaxPerCycle.load(relaxed)) {
+        CommandsMaxPerCycle.store(numberOfCommands, relaxed);
+    }
+}
+
+
+void mtsCommandStatisticsCycleRecorder::Get(mtsCommandStatistics & statistics) const
+{
+    const std::memory_order relaxed = std::memory_order_relaxed;
+    statistics.NumberOfCycles = NumberOfCycles.load(relaxed);
+    statistics.NumberOfCommands = NumberOfCommands.load(relaxed);
+    statistics.CommandsLastCycle = CommandsLastCycle.load(relaxed);
+    statistics.CommandsMaxPerCycle = CommandsMaxPerCycle.load(relaxed);
+}
@@ -5,7 +5,7 @@
   Author(s):  Peter Kazanzides
   Created on: 2010-09-07
 
-  (C) Copyright 2010-2016 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2010-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -21,8 +21,13 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstOSAbstraction/osaSleep.h>
 #include <cisstMultiTask/mtsComponentViewer.h>
 #include <cisstMultiTask/mtsInterfaceRequired.h>
+#include <cisstMultiTask/mtsInterfaceProvided.h>
 #include <cisstMultiTask/mtsManagerGlobal.h>
+#include <cisstMultiTask/mtsManagerLocal.h>
 #include <cisstMultiTask/mtsManagerComponentBase.h>
+#include <cisstMultiTask/mtsCommandStatistics.h>
+
+#include <sstream>
 
 void mtsComponentViewer::WriteString(osaPipeExec & pipe, const std::string & s, double CMN_UNUSED(timeoutInSec))
 {
@@ -356,6 +361,9 @@ void mtsComponentViewer::ProcessResponse(void)
                     CMN_LOG_CLASS_RUN_WARNING << "Stopping component " << arg1 << std::endl;
                     ManagerComponentServices->ComponentStop(processName, componentName);
                 }
+                else if (arg2 == "statistics") {
+                    ShowCommandStatistics(processName, componentName);
+                }
                 else if (arg2.compare(0, 9, "Required:") == 0) {
                     if (ConnectionStarted) {
                         ChangeComponentBorder(ConnectionRequest.Client.ProcessName,
@@ -498,7 +506,8 @@ std::string mtsComponentViewer::GetComponentInUDrawGraphFormat(const std::string
         buffer.append(", m([");
         // Only allow Start/Stop of user components (but not this component)
         if ((componentType == "USER") && (componentName != GetName()))
-            buffer.append("menu_entry(\"start\", \"Start\"), menu_entry(\"stop\", \"Stop\"), blank");
+            buffer.append("menu_entry(\"start\", \"Start\"), menu_entry(\"stop\", \"Stop\"), "
+                          "menu_entry(\"statistics\", \"Command statistics\"), blank");
         MakeInterfaceList(buffer, "Required", requiredList);
         MakeInterfaceList(buffer, "Provided", providedList);
         buffer.append("])");
@@ -507,6 +516,56 @@ std::string mtsComponentViewer::GetComponentInUDrawGraphFormat(const std::string
     return buffer;
 }
 
+void mtsComponentViewer::ShowCommandStatistics(const std::string & processName, const std::string & componentName)
+{
+    mtsManagerLocal * localManager = mtsManagerLocal::GetInstance();
+    if (processName != localManager->GetProcessName()) {
+        WriteString(UDrawPipe, "window(show_status(\"Command statistics are only available for process "
+                    + localManager->GetProcessName() + "\"))\n");
+        return;
+    }
+    mtsComponent * component = localManager->GetComponent(componentName);
+    if (!component) {
+        CMN_LOG_CLASS_RUN_ERROR << "ShowCommandStatistics: can't find component " << componentName << std::endl;
+        return;
+    }
+    // uDrawGraph messages use \n for new lines
+    std::stringstream message;
+    message.precision(3);
+    const std::vector<std::string> interfaces = component->GetNamesOfInterfacesProvided();
+    for (size_t i = 0; i < interfaces.size(); i++) {
+        mtsInterfaceProvided * interfaceProvided = component->GetInterfaceProvided(interfaces[i]);
+        if (!interfaceProvided || !interfaceProvided->GetCommandStatisticsEnabled()) {
+            continue;
+        }
+        mtsCommandStatistics statistics;
+        interfaceProvided->GetCommandStatistics(statistics);
+        message << interfaces[i] << ": " << statistics.NumberOfCommands << " commands in "
+                << statistics.NumberOfCycles << " cycles, max per cycle "
+                << statistics.CommandsMaxPerCycle << "\\n";
+        for (size_t j = 0; j < statistics.Commands.size(); j++) {
+            const mtsCommandStatistics::CommandType & data = statistics.Commands[j];
+            message << "  " << data.UserName << ":" << data.CommandName
+                    << " n=" << data.NumberOfExecutions
+                    << " queue avg/max (ms) " << data.QueueTimeAvg() / cmn_ms << "/" << data.QueueTimeMax / cmn_ms
+                    << " exec avg/max (ms) " << data.ExecutionTimeAvg() / cmn_ms << "/" << data.ExecutionTimeMax / cmn_ms
+                    << " total (ms) " << data.ExecutionTimeSum / cmn_ms
+                    << "\\n";
+        }
+    }
+    std::string text = message.str();
+    if (text.empty()) {
+        text = "No command statistics for " + componentName + ", see mtsInterfaceProvided::EnableCommandStatistics";
+    }
+    // quotes would terminate the uDrawGraph string
+    for (size_t i = 0; i < text.size(); i++) {
+        if (text[i] == '"') {
+            text[i] = '\'';
+        }
+    }
+    WriteString(UDrawPipe, "window(show_message(\"" + text + "\"))\n");
+}
+
 std::string mtsComponentViewer::GetStateInUDrawGraphFormat(const mtsComponentState &componentState) const
 {
     std::string buffer("a(\"COLOR\", \"");
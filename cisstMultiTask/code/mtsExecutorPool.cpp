@@ -0,0 +1,286 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstMultiTask/mtsExecutorPool.h>
+#include <cisstOSAbstraction/osaCPUAffinity.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstOSAbstraction/osaMutex.h>
+#include <cisstOSAbstraction/osaSleep.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaThreadSignal.h>
+
+#include <deque>
+
+CMN_IMPLEMENT_SERVICES(mtsExecutorPool);
+
+namespace {
+    // job scheduling states
+    enum {JOB_IDLE, JOB_QUEUED, JOB_RUNNING, JOB_RUNNING_AND_QUEUED};
+}
+
+
+class mtsExecutorPool::Worker
+{
+public:
+    inline Worker(const size_t index):
+        Index(index),
+        Sleeping(false)
+    {}
+
+    size_t Index;
+    osaThread Thread;
+    osaThreadSignal Signal;
+    std::atomic<bool> Sleeping;
+
+    // jobs, owner uses the back and thieves use the front
+    osaMutex Mutex;
+    std::deque<Job *> Jobs;
+};
+
+
+// pool and worker index for the current thread, pool is null if the
+// current thread is not part of a pool
+static thread_local const mtsExecutorPool * mtsExecutorPoolCurrentPool = 0;
+static thread_local size_t mtsExecutorPoolCurrentWorker = 0;
+
+
+mtsExecutorPool::Job::Job(void):
+    State(JOB_IDLE)
+{
+}
+
+
+bool mtsExecutorPool::Job::IsIdle(void) const
+{
+    return (State.load() == JOB_IDLE);
+}
+
+
+mtsExecutorPool::mtsExecutorPool(const size_t numberOfThreads):
+    NextWorker(0),
+    Stopping(false),
+    NumberOfJobsExecuted(0),
+    NumberOfJobsStolen(0)
+{
+    size_t size = numberOfThreads;
+    if (size == 0) {
+        const int numberOfProcessors = osaCPUGetCount();
+        size = (numberOfProcessors > 0) ? static_cast<size_t>(numberOfProcessors) : 2;
+    }
+    size_t index;
+    for (index = 0; index < size; ++index) {
+        Workers.push_back(new Worker(index));
+    }
+    // start threads once all workers exist since they might steal from each other
+    for (index = 0; index < size; ++index) {
+        Workers[index]->Thread.Create<mtsExecutorPool, Worker *>(this, &mtsExecutorPool::WorkerLoop, Workers[index]);
+    }
+    CMN_LOG_CLASS_INIT_VERBOSE << "constructor: created pool with " << size << " thread(s)" << std::endl;
+}
+
+
+mtsExecutorPool::~mtsExecutorPool()
+{
+    Stopping = true;
+    const WorkersType::iterator end = Workers.end();
+    WorkersType::iterator worker;
+    for (worker = Workers.begin(); worker != end; ++worker) {
+        (*worker)->Signal.Raise();
+    }
+    for (worker = Workers.begin(); worker != end; ++worker) {
+        (*worker)->Thread.Wait();
+    }
+    // jobs still queued will never be executed
+    for (worker = Workers.begin(); worker != end; ++worker) {
+        if (!(*worker)->Jobs.empty()) {
+            CMN_LOG_CLASS_INIT_WARNING << "destructor: dropping " << (*worker)->Jobs.size()
+                                       << " job(s) still queued" << std::endl;
+        }
+        std::deque<Job *>::iterator job;
+        for (job = (*worker)->Jobs.begin(); job != (*worker)->Jobs.end(); ++job) {
+            (*job)->State = JOB_IDLE;
+        }
+        delete *worker;
+    }
+    Workers.clear();
+}
+
+
+void mtsExecutorPool::Schedule(Job * job)
+{
+    int state = job->State.load();
+    while (true) {
+        switch (state) {
+        case JOB_IDLE:
+            if (job->State.compare_exchange_weak(state, JOB_QUEUED)) {
+                // queue on current worker if possible
+                if (mtsExecutorPoolCurrentPool == this) {
+                    Push(Workers[mtsExecutorPoolCurrentWorker], job);
+                } else {
+                    Push(Workers[NextWorker.fetch_add(1) % Workers.size()], job);
+                }
+                return;
+            }
+            break;
+        case JOB_RUNNING:
+            // make sure the thread running the job runs it again
+            if (job->State.compare_exchange_weak(state, JOB_RUNNING_AND_QUEUED)) {
+                return;
+            }
+            break;
+        default:
+            // already queued
+            return;
+        }
+    }
+}
+
+
+void mtsExecutorPool::Push(Worker * worker, Job * job)
+{
+    worker->Mutex.Lock();
+    worker->Jobs.push_back(job);
+    worker->Mutex.Unlock();
+    WakeUp(worker);
+}
+
+
+void mtsExecutorPool::WakeUp(Worker * worker)
+{
+    // prefer the worker owning the queue, otherwise any sleeping
+    // worker can steal the job
+    if (worker->Sleeping.load()) {
+        worker->Signal.Raise();
+        return;
+    }
+    const WorkersType::iterator end = Workers.end();
+    WorkersType::iterator other;
+    for (other = Workers.begin(); other != end; ++other) {
+        if ((*other)->Sleeping.load()) {
+            (*other)->Signal.Raise();
+            return;
+        }
+    }
+}
+
+
+mtsExecutorPool::Job * mtsExecutorPool::Pop(Worker * worker)
+{
+    Job * job = 0;
+    worker->Mutex.Lock();
+    if (!worker->Jobs.empty()) {
+        job = worker->Jobs.back();
+        worker->Jobs.pop_back();
+    }
+    worker->Mutex.Unlock();
+    if (job) {
+        return job;
+    }
+    // steal from other workers, starting with the next one
+    const size_t size = Workers.size();
+    for (size_t offset = 1; offset < size; ++offset) {
+        Worker * victim = Workers[(worker->Index + offset) % size];
+        victim->Mutex.Lock();
+        if (!victim->Jobs.empty()) {
+            job = victim->Jobs.front();
+            victim->Jobs.pop_front();
+        }
+        victim->Mutex.Unlock();
+        if (job) {
+            NumberOfJobsStolen++;
+            return job;
+        }
+    }
+    return 0;
+}
+
+
+void mtsExecutorPool::Run(Worker * worker, Job * job)
+{
+    // only one thread can dequeue a given job since it is queued once
+    job->State = JOB_RUNNING;
+    job->Execute();
+    NumberOfJobsExecuted++;
+    int state = JOB_RUNNING;
+    if (!job->State.compare_exchange_strong(state, JOB_IDLE)) {
+        // scheduled while running
+        job->State = JOB_QUEUED;
+        Push(worker, job);
+    }
+}
+
+
+void * mtsExecutorPool::WorkerLoop(Worker * worker)
+{
+    mtsExecutorPoolCurrentPool = this;
+    mtsExecutorPoolCurrentWorker = worker->Index;
+    Job * job;
+    while (!Stopping) {
+        job = Pop(worker);
+        if (job) {
+            Run(worker, job);
+            continue;
+        }
+        // announce we are going to sleep, then check all queues once
+        // more in case a job was pushed before the flag was set
+        worker->Sleeping = true;
+        job = Pop(worker);
+        if (job) {
+            worker->Sleeping = false;
+            Run(worker, job);
+            continue;
+        }
+        if (!Stopping) {
+            worker->Signal.Wait();
+        }
+        worker->Sleeping = false;
+    }
+    mtsExecutorPoolCurrentPool = 0;
+    return 0;
+}
+
+
+bool mtsExecutorPool::WaitForIdle(const Job * job, const double timeout) const
+{
+    const double endTime = osaGetTime() + timeout;
+    while (!job->IsIdle()) {
+        if (osaGetTime() > endTime) {
+            return false;
+        }
+        osaSleep(100.0 * cmn_us);
+    }
+    return true;
+}
+
+
+size_t mtsExecutorPool::GetNumberOfThreads(void) const
+{
+    return Workers.size();
+}
+
+
+unsigned long long mtsExecutorPool::GetNumberOfJobsExecuted(void) const
+{
+    return NumberOfJobsExecuted;
+}
+
+
+unsigned long long mtsExecutorPool::GetNumberOfJobsStolen(void) const
+{
+    return NumberOfJobsStolen;
+}
@@ -5,7 +5,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides, Anton Deguet, Min Yang Jung
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2025 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -38,10 +38,15 @@ mtsInterfaceProvided::mtsInterfaceProvided(const std::string & name, mtsComponen
                                            mtsCallableVoidBase * postCommandQueuedCallable,
                                            bool isProxy):
     BaseType(name, component),
+    NumberOfInterfacesProvidedRemoved(0),
+    NumberOfMailBoxesPasses(0),
     IsProxy(isProxy),
     MailBox(0),
     QueueingPolicy(queueingPolicy),
     ArgumentQueuesSize(DEFAULT_MAIL_BOX_AND_ARGUMENT_QUEUES_SIZE),
+    MailBoxShared(false),
+    SharedMailBox(0),
+    CommandStatisticsEnabled(false),
     BlockingCommandExecuted(0),
     BlockingCommandReturnExecuted(0),
     OriginalInterface(0),
@@ -100,6 +105,9 @@ void mtsInterfaceProvided::CloneCommands(const std::string &cmdType, const _MapT
         commandQueued = dynamic_cast<_QueuedType *>(iter->second);
         if (commandQueued) {
             command = commandQueued->Clone(this->MailBox, ArgumentQueuesSize);
+            if (this->OriginalInterface && this->OriginalInterface->CommandStatisticsEnabled) {
+                command->SetStatisticsRecorder(new mtsCommandStatisticsRecorder);
+            }
             CMN_LOG_CLASS_INIT_VERBOSE << "factory constructor: cloned queued " << cmdType << " command \"" << iter->first
                                        << "\" for \"" << this->GetFullName() << "\"" << std::endl;
         } else {
@@ -117,10 +125,15 @@ mtsInterfaceProvided::mtsInterfaceProvided(mtsInterfaceProvided * originalInterf
                                            size_t argumentQueuesSize):
     BaseType(mtsInterfaceProvided::GenerateEndUserInterfaceName(originalInterface, userName),
              originalInterface->Component),
+    NumberOfInterfacesProvidedRemoved(0),
+    NumberOfMailBoxesPasses(0),
     MailBox(0),
     QueueingPolicy(MTS_COMMANDS_SHOULD_BE_QUEUED),
     MailBoxSize(mailBoxSize),
     ArgumentQueuesSize(argumentQueuesSize),
+    MailBoxShared(originalInterface->MailBoxShared),
+    SharedMailBox(0),
+    CommandStatisticsEnabled(false),
     BlockingCommandExecuted(0),
     BlockingCommandReturnExecuted(0),
     OriginalInterface(originalInterface),
@@ -150,10 +163,16 @@ mtsInterfaceProvided::mtsInterfaceProvided(mtsInterfaceProvided * originalInterf
     CommandsInternal.SetOwner(*this);
 
     if (mailBoxSize != 0) {
-        // duplicate what needs to be duplicated (i.e. void and write commands)
-        MailBox = new mtsMailBox(this->GetName(),
-                                 mailBoxSize,
-                                 this->PostCommandQueuedCallable);
+        // duplicate what needs to be duplicated (i.e. void and write
+        // commands), use the original interface mailbox if shared
+        if (this->MailBoxShared) {
+            MailBox = originalInterface->SharedMailBox;
+            CMN_ASSERT(MailBox);
+        } else {
+            MailBox = new mtsMailBox(this->GetName(),
+                                     mailBoxSize,
+                                     this->PostCommandQueuedCallable);
+        }
 
         // clone void commands
         CloneCommands<CommandVoidMapType, mtsCommandQueuedVoid>("void", originalInterface->CommandsVoid, CommandsVoid);
@@ -176,6 +195,21 @@ mtsInterfaceProvided::~mtsInterfaceProvided()
 	CMN_LOG_CLASS_INIT_VERBOSE << "Class mtsInterfaceProvided: Class destructor" << std::endl;
     // ADV: Need to add all cleanup, i.e. make sure all mailboxes are
     // properly deleted.
+
+    // commands still queued for removed end-user interfaces will never
+    // be executed
+    InterfaceProvidedRemovedListType::iterator iterator;
+    for (iterator = InterfacesProvidedRemoved.begin();
+         iterator != InterfacesProvidedRemoved.end();
+         ++iterator) {
+        delete iterator->second;
+    }
+    // shared mailbox is created by GetEndUserInterface, only delete
+    // it once no end-user interface can use it
+    if (SharedMailBox) {
+        delete SharedMailBox;
+        SharedMailBox = 0;
+    }
 }
 
 
@@ -241,6 +275,87 @@ void mtsInterfaceProvided::SetMailBoxAndArgumentQueuesSize(size_t desiredSize)
 }
 
 
+void mtsInterfaceProvided::SetMailBoxShared(bool shared)
+{
+    if (this->QueueingPolicy == MTS_COMMANDS_SHOULD_NOT_BE_QUEUED) {
+        CMN_LOG_CLASS_INIT_WARNING << "SetMailBoxShared: interface \"" << this->GetFullName()
+                                   << "\" is not queuing commands, calling SetMailBoxShared has no effect"
+                                   << std::endl;
+    }
+    if (this->EndUserInterface || this->SharedMailBox || !this->InterfacesProvidedCreated.empty()) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetMailBoxShared: interface \"" << this->GetFullName()
+                                 << "\" is already in use, mailbox can't be changed" << std::endl;
+        return;
+    }
+    this->MailBoxShared = shared;
+}
+
+
+void mtsInterfaceProvided::EnableCommandStatistics(bool enable)
+{
+    if (this->QueueingPolicy == MTS_COMMANDS_SHOULD_NOT_BE_QUEUED) {
+        CMN_LOG_CLASS_INIT_WARNING << "EnableCommandStatistics: interface \"" << this->GetFullName()
+                                   << "\" is not queuing commands, only the number of commands per cycle will be available"
+                                   << std::endl;
+    }
+    if (this->EndUserInterface || !this->InterfacesProvidedCreated.empty()) {
+        CMN_LOG_CLASS_INIT_ERROR << "EnableCommandStatistics: interface \"" << this->GetFullName()
+                                 << "\" is already in use, statistics can't be enabled or disabled" << std::endl;
+        return;
+    }
+    this->CommandStatisticsEnabled = enable;
+    if (enable && !this->CommandsRead.GetItem("GetCommandStatistics", CMN_LOG_LEVEL_NONE)) {
+        this->AddCommandRead(&mtsInterfaceProvided::GetCommandStatistics, this,
+                             "GetCommandStatistics");
+    }
+}
+
+
+template <class _MapType>
+static void mtsInterfaceProvidedAppendCommandStatistics(const _MapType & commands,
+                                                        const std::string & userName,
+                                                        mtsCommandStatistics & statistics)
+{
+    typename _MapType::const_iterator iter;
+    const typename _MapType::const_iterator end = commands.end();
+    for (iter = commands.begin(); iter != end; ++iter) {
+        const mtsCommandStatisticsRecorder * recorder = iter->second->GetStatisticsRecorder();
+        if (recorder) {
+            mtsCommandStatistics::CommandType command;
+            command.UserName = userName;
+            command.CommandName = iter->first;
+            recorder->Get(command);
+            statistics.Commands.push_back(command);
+        }
+    }
+}
+
+
+void mtsInterfaceProvided::GetCommandStatistics(mtsCommandStatistics & statistics) const
+{
+    const ThisType * original = this->OriginalInterface ? this->OriginalInterface : this;
+    statistics.Commands.clear();
+    original->CycleStatistics.Get(statistics);
+    // end-user interfaces can be added or removed from other threads
+    original->EndUserInterfacesMutex.Lock();
+    const InterfaceProvidedCreatedListType::const_iterator end = original->InterfacesProvidedCreated.end();
+    InterfaceProvidedCreatedListType::const_iterator iterator;
+    for (iterator = original->InterfacesProvidedCreated.begin();
+         iterator != end;
+         ++iterator) {
+        const ThisType * endUser = iterator->second;
+        mtsInterfaceProvidedAppendCommandStatistics(endUser->CommandsVoid, endUser->UserName, statistics);
+        mtsInterfaceProvidedAppendCommandStatistics(endUser->CommandsVoidReturn, endUser->UserName, statistics);
+        mtsInterfaceProvidedAppendCommandStatistics(endUser->CommandsWrite, endUser->UserName, statistics);
+        mtsInterfaceProvidedAppendCommandStatistics(endUser->CommandsWriteReturn, endUser->UserName, statistics);
+        mtsInterfaceProvidedAppendCommandStatistics(endUser->CommandsRead, endUser->UserName, statistics);
+        mtsInterfaceProvidedAppendCommandStatistics(endUser->CommandsQualifiedRead, endUser->UserName, statistics);
+    }
+    original->EndUserInterfacesMutex.Unlock();
+    statistics.SetValid(true);
+}
+
+
 
 // Execute all commands in the mailbox.  This is just a temporary implementation, where
 // all commands in a mailbox are executed before moving on the next mailbox.  The final
@@ -250,6 +365,38 @@ size_t mtsInterfaceProvided::ProcessMailBoxes(void)
 {
     if (!this->EndUserInterface) {
         size_t numberOfCommands = 0;
+        // single queue to process, end-user interfaces don't have their own
+        if (this->SharedMailBox) {
+            size_t commandsInMailbox = this->SharedMailBox->GetAvailable();
+            while (commandsInMailbox && this->SharedMailBox->ExecuteNext()) {
+                numberOfCommands++;
+                commandsInMailbox--;
+            }
+            commandsInMailbox = this->SharedMailBox->GetAvailable();
+            while (commandsInMailbox && this->SharedMailBox->ExecuteNext()) {
+                numberOfCommands++;
+                commandsInMailbox--;
+            }
+            if (this->CommandStatisticsEnabled) {
+                this->CycleStatistics.Record(numberOfCommands);
+            }
+            // end-user interfaces removed, see RemoveEndUserInterface
+            if (this->NumberOfInterfacesProvidedRemoved.load(std::memory_order_acquire) != 0) {
+                this->EndUserInterfacesMutex.Lock();
+                this->DeleteRemovedEndUserInterfaces(this->SharedMailBox->GetNumberOfDequeued());
+                this->EndUserInterfacesMutex.Unlock();
+            }
+            return numberOfCommands;
+        }
+        // end-user interfaces can be added and removed from another
+        // thread, collect the mailboxes and release the lock before
+        // executing commands.  Commands can call GetEndUserInterface
+        // and RemoveEndUserInterface (see mtsComponent internal
+        // interface) and clients shouldn't have to wait for all
+        // commands to be executed.
+        this->EndUserInterfacesMutex.Lock();
+        const size_t pass = ++(this->NumberOfMailBoxesPasses);
+        MailBoxesToProcess.clear();
         InterfaceProvidedCreatedListType::iterator iterator = InterfacesProvidedCreated.begin();
         //const InterfaceProvidedCreatedVectorType::iterator end = InterfacesProvidedCreated.end();
         mtsMailBox * mailBox;
@@ -259,21 +406,40 @@ size_t mtsInterfaceProvided::ProcessMailBoxes(void)
              ++iterator) {
             mailBox = iterator->second->GetMailBox();
             if (mailBox) {
-                // process everything that is available now
-                size_t commandsInMailbox = mailBox->GetAvailable();
-                while (commandsInMailbox && mailBox->ExecuteNext()) {
-                    numberOfCommands++;
-                    commandsInMailbox--;
-                }
-                // process whatever arrived while queue was being
-                // processed to reduce latency on client side
-                commandsInMailbox = mailBox->GetAvailable();
-                while (commandsInMailbox && mailBox->ExecuteNext()) {
-                    numberOfCommands++;
-                    commandsInMailbox--;
-                }
+                MailBoxesToProcess.push_back(mailBox);
+            }
+        }
+        this->EndUserInterfacesMutex.Unlock();
+
+        const std::vector<mtsMailBox *>::iterator end = MailBoxesToProcess.end();
+        std::vector<mtsMailBox *>::iterator mailBoxIterator;
+        for (mailBoxIterator = MailBoxesToProcess.begin();
+             mailBoxIterator != end;
+             ++mailBoxIterator) {
+            mailBox = *mailBoxIterator;
+            // process everything that is available now
+            size_t commandsInMailbox = mailBox->GetAvailable();
+            while (commandsInMailbox && mailBox->ExecuteNext()) {
+                numberOfCommands++;
+                commandsInMailbox--;
+            }
+            // process whatever arrived while queue was being
+            // processed to reduce latency on client side
+            commandsInMailbox = mailBox->GetAvailable();
+            while (commandsInMailbox && mailBox->ExecuteNext()) {
+                numberOfCommands++;
+                commandsInMailbox--;
             }
         }
+        if (this->CommandStatisticsEnabled) {
+            this->CycleStatistics.Record(numberOfCommands);
+        }
+        // end-user interfaces removed, see RemoveEndUserInterface
+        if (this->NumberOfInterfacesProvidedRemoved.load(std::memory_order_acquire) != 0) {
+            this->EndUserInterfacesMutex.Lock();
+            this->DeleteRemovedEndUserInterfaces(pass);
+            this->EndUserInterfacesMutex.Unlock();
+        }
         return numberOfCommands;
     }
     CMN_LOG_CLASS_RUN_ERROR << "ProcessMailBoxes: called on end user interface for " << this->GetFullName() << std::endl;
@@ -691,12 +857,21 @@ mtsInterfaceProvided * mtsInterfaceProvided::GetEndUserInterface(const std::stri
     CMN_LOG_CLASS_INIT_VERBOSE << "GetEndUserInterface: interface \"" << this->GetFullName()
                                << "\" creating new copy (#" << this->UserCounter
                                << ") for user \"" << userName << "\"" << std::endl;
+    // create shared mailbox for first user if needed
+    if (this->MailBoxShared && (this->MailBoxSize != 0) && !this->SharedMailBox) {
+        this->SharedMailBox = new mtsMailBox(this->GetName(),
+                                             this->MailBoxSize,
+                                             this->PostCommandQueuedCallable,
+                                             true);
+    }
     // new end user interface created with default size for mailbox; also adds system events
     mtsInterfaceProvided * interfaceProvided = new mtsInterfaceProvided(this,
                                                                         userName,
                                                                         this->MailBoxSize,
                                                                         this->ArgumentQueuesSize);
+    EndUserInterfacesMutex.Lock();
     InterfacesProvidedCreated.push_back(InterfaceProvidedCreatedPairType(this->UserCounter, interfaceProvided));
+    EndUserInterfacesMutex.Unlock();
 
     // finally, add system events
     if (!this->IsProxy) {
@@ -715,12 +890,14 @@ std::vector<std::string> mtsInterfaceProvided::GetListOfUserNames(void) const
         return userNames;
     }
 
+    EndUserInterfacesMutex.Lock();
     const InterfaceProvidedCreatedListType::const_iterator end = InterfacesProvidedCreated.end();
     InterfaceProvidedCreatedListType::const_iterator iterator;
     for (iterator = InterfacesProvidedCreated.begin();
          iterator != end; ++iterator) {
         userNames.push_back(iterator->second->UserName);
     }
+    EndUserInterfacesMutex.Unlock();
 
     return userNames;
 }
@@ -766,6 +943,7 @@ mtsInterfaceProvided * mtsInterfaceProvided::RemoveEndUserInterface(mtsInterface
 
     // finally, remove the end-user interface from the list of
     // end-user interfaces (InterfacesProvidedCreated).
+    EndUserInterfacesMutex.Lock();
     const InterfaceProvidedCreatedListType::iterator end = InterfacesProvidedCreated.end();
     InterfaceProvidedCreatedListType::iterator iterator;
     for (iterator = InterfacesProvidedCreated.begin();
@@ -776,10 +954,42 @@ mtsInterfaceProvided * mtsInterfaceProvided::RemoveEndUserInterface(mtsInterface
                                       << "\" removing copy (#" << iterator->first
                                       << ") for user \"" << userName << "\"" << std::endl;
             InterfacesProvidedCreated.erase(iterator);
-            delete interfaceProvided;
+            // with a shared mailbox, commands queued by this end-user
+            // interface might still be in the mailbox.  The interface
+            // (and its commands) can only be deleted once the commands
+            // queued so far have been executed, ProcessMailBoxes will
+            // take care of it (see mtsMailBox::GetNumberOfEnqueued).
+            if (this->SharedMailBox) {
+                const size_t enqueued = this->SharedMailBox->GetNumberOfEnqueued();
+                const size_t dequeued = this->SharedMailBox->GetNumberOfDequeued();
+                if (dequeued < enqueued) {
+                    InterfacesProvidedRemoved.push_back(InterfaceProvidedRemovedPairType(enqueued,
+                                                                                         interfaceProvided));
+                    NumberOfInterfacesProvidedRemoved.store(InterfacesProvidedRemoved.size(), std::memory_order_release);
+                    EndUserInterfacesMutex.Unlock();
+                    CMN_LOG_CLASS_RUN_VERBOSE << "RemoveEndUserInterface: interface \"" << this->GetFullName()
+                                              << "\" deferring deletion of copy for user \"" << userName
+                                              << "\" until " << (enqueued - dequeued) << " queued command(s) are executed" << std::endl;
+                    return 0;
+                }
+                EndUserInterfacesMutex.Unlock();
+                delete interfaceProvided;
+                return 0;
+            }
+            // otherwise, ProcessMailBoxes might be executing commands
+            // from this interface's mailbox, possibly this very call.
+            // Deletion is deferred until the current pass is over.
+            InterfacesProvidedRemoved.push_back(InterfaceProvidedRemovedPairType(NumberOfMailBoxesPasses,
+                                                                                 interfaceProvided));
+            NumberOfInterfacesProvidedRemoved.store(InterfacesProvidedRemoved.size(), std::memory_order_release);
+            EndUserInterfacesMutex.Unlock();
+            CMN_LOG_CLASS_RUN_VERBOSE << "RemoveEndUserInterface: interface \"" << this->GetFullName()
+                                      << "\" deferring deletion of copy for user \"" << userName
+                                      << "\" until mailboxes are processed" << std::endl;
             return 0;
         }
     }
+    EndUserInterfacesMutex.Unlock();
 
     CMN_LOG_CLASS_RUN_ERROR << "RemoveEndUserInterface: interface \"" << this->GetFullName()
                             << "\" could not find end-user interface for user \""
@@ -800,22 +1010,44 @@ mtsInterfaceProvided * mtsInterfaceProvided::FindEndUserInterfaceByName(const st
     if ((this->OriginalInterface == 0) && this->EndUserInterface) {
         return this;
     }
+    mtsInterfaceProvided * result = 0;
+    EndUserInterfacesMutex.Lock();
     const InterfaceProvidedCreatedListType::const_iterator end = InterfacesProvidedCreated.end();
     InterfaceProvidedCreatedListType::const_iterator iterator;
     for (iterator = InterfacesProvidedCreated.begin();
          iterator != end;
          ++iterator) {
         if (iterator->second->UserName == userName) {
-            return iterator->second;
+            result = iterator->second;
+            break;
         }
     }
-    return 0;
+    EndUserInterfacesMutex.Unlock();
+    return result;
 }
 
 
 int mtsInterfaceProvided::GetNumberOfEndUsers(void) const
 {
-    return static_cast<int>(InterfacesProvidedCreated.size());
+    EndUserInterfacesMutex.Lock();
+    const int numberOfEndUsers = static_cast<int>(InterfacesProvidedCreated.size());
+    EndUserInterfacesMutex.Unlock();
+    return numberOfEndUsers;
+}
+
+
+void mtsInterfaceProvided::DeleteRemovedEndUserInterfaces(const size_t position)
+{
+    InterfaceProvidedRemovedListType::iterator iterator = InterfacesProvidedRemoved.begin();
+    while (iterator != InterfacesProvidedRemoved.end()) {
+        if (position >= iterator->first) {
+            delete iterator->second;
+            iterator = InterfacesProvidedRemoved.erase(iterator);
+        } else {
+            ++iterator;
+        }
+    }
+    NumberOfInterfacesProvidedRemoved.store(InterfacesProvidedRemoved.size(), std::memory_order_release);
 }
 
 
@@ -914,7 +1146,10 @@ bool mtsInterfaceProvided::AddSystemEvents(void)
                                  << this->GetFullName() << "\"" << std::endl;
         return false;
     }
-    if (this->MailBox) {
+    if (this->MailBox && this->MailBox->AcceptsMultipleProducers()) {
+        CMN_LOG_CLASS_INIT_VERBOSE << "AddSystemEvents: mailbox is shared, not setting post dequeued command for blocking commands for interface \""
+                                   << this->GetFullName() << "\"" << std::endl;
+    } else if (this->MailBox) {
         MailBox->SetPostCommandDequeuedCommand(this->BlockingCommandExecuted);
     } else {
         CMN_LOG_CLASS_INIT_VERBOSE << "AddSystemEvents: can not set mailbox post dequeued command for blocking commands for interface \""
@@ -927,7 +1162,10 @@ bool mtsInterfaceProvided::AddSystemEvents(void)
                                  << this->GetFullName() << "\"" << std::endl;
         return false;
     }
-    if (this->MailBox) {
+    if (this->MailBox && this->MailBox->AcceptsMultipleProducers()) {
+        CMN_LOG_CLASS_INIT_VERBOSE << "AddSystemEvents: mailbox is shared, not setting post dequeued command for blocking return commands for interface \""
+                                   << this->GetFullName() << "\"" << std::endl;
+    } else if (this->MailBox) {
         MailBox->SetPostCommandReturnDequeuedCommand(this->BlockingCommandReturnExecuted);
     } else {
         CMN_LOG_CLASS_INIT_VERBOSE << "AddSystemEvents: can not set mailbox post dequeued command for blocking return commands for interface \""
@@ -5,7 +5,7 @@
   Author(s):  Peter Kazanzides, Anton Deguet
   Created on: 2007-09-05
 
-  (C) Copyright 2007-2019 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -17,7 +17,9 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include <cisstCommon/cmnAssert.h>
+#include <cisstOSAbstraction/osaGetTime.h>
 #include <cisstMultiTask/mtsMailBox.h>
+#include <cisstMultiTask/mtsCommandStatistics.h>
 #include <cisstMultiTask/mtsCallableVoidBase.h>
 #include <cisstMultiTask/mtsCallableVoidReturnBase.h>
 #include <cisstMultiTask/mtsCallableWriteReturnBase.h>
@@ -29,8 +31,13 @@ http://www.cisst.org/cisst/license.txt.
 
 mtsMailBox::mtsMailBox(const std::string & name,
                        size_t size,
-                       mtsCallableVoidBase * postCommandQueuedCallable):
-    CommandQueue(size, 0),
+                       mtsCallableVoidBase * postCommandQueuedCallable,
+                       bool multipleProducers):
+    CommandQueue(multipleProducers ? 0 : size, QueuedCommandType()),
+    SharedCommandQueue(multipleProducers ? size : 0, QueuedCommandType()),
+    MultipleProducers(multipleProducers),
+    NumberOfDequeued(0),
+    NumberOfEnqueued(0),
     Name(name),
     PostCommandQueuedCallable(postCommandQueuedCallable),
     PostCommandDequeuedCommand(0),
@@ -48,10 +55,38 @@ const std::string & mtsMailBox::GetName(void) const
 }
 
 
+bool mtsMailBox::AcceptsMultipleProducers(void) const
+{
+    return this->MultipleProducers;
+}
+
+
+void mtsMailBox::Dequeue(void)
+{
+    // counted before the slot is released so GetAvailable and
+    // GetNumberOfDequeued never miss the command being removed
+    NumberOfDequeued.fetch_add(1, std::memory_order_release);
+    if (MultipleProducers) {
+        SharedCommandQueue.Pop();
+    } else {
+        CommandQueue.Get();
+    }
+}
+
+
 bool mtsMailBox::Write(mtsCommandBase * command)
 {
     bool result;
-    result = (CommandQueue.Put(command) != 0);
+    const QueuedCommandType queuedCommand(command,
+                                          command->GetStatisticsRecorder() ? osaGetTime() : 0.0);
+    if (MultipleProducers) {
+        result = (SharedCommandQueue.Put(queuedCommand) != 0);
+    } else {
+        result = (CommandQueue.Put(queuedCommand) != 0);
+        if (result) {
+            NumberOfEnqueued.fetch_add(1, std::memory_order_release);
+        }
+    }
     if (this->PostCommandQueuedCallable) {
         this->PostCommandQueuedCallable->Execute();
     }
@@ -62,13 +97,28 @@ bool mtsMailBox::Write(mtsCommandBase * command)
 // return false if nothing to execute; true otherwise.
 bool mtsMailBox::ExecuteNext(void)
 {
-   mtsCommandBase** command = CommandQueue.Peek();
+   QueuedCommandType * queuedCommand;
+   if (MultipleProducers) {
+       queuedCommand = SharedCommandQueue.Peek();
+   } else {
+       queuedCommand = CommandQueue.Peek();
+   }
 
    // test for empty queue
-   if (!command) {
+   if (!queuedCommand) {
        return false;
    }
 
+   // keep a copy, the slot can be reused as soon as the command is
+   // removed from a shared queue
+   mtsCommandBase * commandCopy = queuedCommand->Command;
+   mtsCommandBase ** command = &commandCopy;
+
+   // optional statistics
+   mtsCommandStatisticsRecorder * statistics = commandCopy->GetStatisticsRecorder();
+   const double queuedTime = queuedCommand->Time;
+   const double startTime = statistics ? osaGetTime() : 0.0;
+
    mtsCommandQueuedVoid * commandVoid;
    mtsCommandQueuedWriteBase * commandWrite;
    mtsCommandQueuedVoidReturn * commandVoidReturn;
@@ -172,7 +222,7 @@ bool mtsMailBox::ExecuteNext(void)
    catch (std::exception & exceptionCaught) {
        CMN_LOG_RUN_WARNING << "mtsMailbox \"" << GetName() << "\": ExecuteNext for command \"" << (*command)->GetName()
                            << "\" caught exception \"" << exceptionCaught.what() << "\"" << std::endl;
-       CommandQueue.Get();  // Remove command from mailbox queue
+       Dequeue();  // Remove command from mailbox queue
        if (resultPointer || isBlocking)
           TriggerFinishedEventIfNeeded((*command)->GetName(), finishedEvent, resultPointer, result);
        throw;
@@ -180,16 +230,19 @@ bool mtsMailBox::ExecuteNext(void)
    catch (...) {
        CMN_LOG_RUN_WARNING << "mtsMailbox \"" << GetName() << "\": ExecuteNext for command \"" << (*command)->GetName()
                            << "\" caught exception, blocking = " << isBlocking << std::endl;
-       CommandQueue.Get();  // Remove command from mailbox queue
+       Dequeue();  // Remove command from mailbox queue
        if (resultPointer || isBlocking)
            TriggerFinishedEventIfNeeded((*command)->GetName(), finishedEvent, resultPointer, result);
        throw;
    }
+   if (statistics) {
+       statistics->Record(startTime - queuedTime, osaGetTime() - startTime);
+   }
    if (!result.IsOK()) {
        CMN_LOG_RUN_WARNING << "mtsMailbox \"" << GetName() << "\": ExecuteNext for command \"" << (*command)->GetName()
                            << "\" failed, execution result is \"" << result << "\"" << std::endl;
    }
-   CommandQueue.Get();  // Remove command from mailbox queue
+   Dequeue();  // Remove command from mailbox queue
    if (resultPointer || isBlocking)
        TriggerFinishedEventIfNeeded((*command)->GetName(), finishedEvent, resultPointer, result);
    return true;
@@ -224,28 +277,62 @@ void mtsMailBox::TriggerFinishedEventIfNeeded(const std::string &commandName, mt
 
 void mtsMailBox::SetSize(size_t size)
 {
-    if (CommandQueue.GetSize() != size) {
-        CommandQueue.SetSize(size, 0); // array of null pointers
+    // queued commands are deleted so the counters start over
+    if (MultipleProducers) {
+        if (SharedCommandQueue.GetSize() != size) {
+            SharedCommandQueue.SetSize(size, QueuedCommandType()); // array of null pointers
+            NumberOfDequeued.store(0, std::memory_order_release);
+        }
+    } else if (CommandQueue.GetSize() != size) {
+        CommandQueue.SetSize(size, QueuedCommandType()); // array of null pointers
+        NumberOfDequeued.store(0, std::memory_order_release);
+        NumberOfEnqueued.store(0, std::memory_order_release);
     }
 }
 
 
 bool mtsMailBox::IsEmpty(void) const
 {
+    if (MultipleProducers) {
+        return SharedCommandQueue.IsEmpty();
+    }
     return CommandQueue.IsEmpty();
 }
 
 
 bool mtsMailBox::IsFull(void) const
 {
+    if (MultipleProducers) {
+        return SharedCommandQueue.IsFull();
+    }
     return CommandQueue.IsFull();
 }
 
 size_t mtsMailBox::GetAvailable(void) const
 {
+    if (MultipleProducers) {
+        return SharedCommandQueue.GetAvailable();
+    }
     return CommandQueue.GetAvailable();
 }
 
+
+size_t mtsMailBox::GetNumberOfDequeued(void) const
+{
+    return NumberOfDequeued.load(std::memory_order_acquire);
+}
+
+
+size_t mtsMailBox::GetNumberOfEnqueued(void) const
+{
+    // the shared queue counts slots reserved by all producers, in
+    // the order they will be dequeued
+    if (MultipleProducers) {
+        return SharedCommandQueue.GetNumberOfEnqueued();
+    }
+    return NumberOfEnqueued.load(std::memory_order_acquire);
+}
+
 void mtsMailBox::SetPostCommandDequeuedCommand(mtsCommandVoid * command)
 {
     this->PostCommandDequeuedCommand = command;
@@ -83,6 +83,9 @@ CMN_IMPLEMENT_SERVICES_DERIVED(mtsManagerComponentBase, mtsTaskFromSignal);
 mtsManagerComponentBase::mtsManagerComponentBase(const std::string & componentName)
     : mtsTaskFromSignal(componentName, 50)
 {
+    // manager components use blocking commands and live as long as
+    // the component manager, keep them out of the executor pool
+    SetUseExecutorPool(false);
 }
 
 mtsManagerComponentBase::~mtsManagerComponentBase()
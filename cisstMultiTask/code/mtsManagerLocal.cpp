@@ -5,7 +5,7 @@
   Author(s):  Min Yang Jung
   Created on: 2009-12-07
 
-  (C) Copyright 2009-2025 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -28,6 +28,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstOSAbstraction/osaDynamicLoader.h>
 
 #include <cisstMultiTask/mtsConfig.h>
+#include <cisstMultiTask/mtsExecutorPool.h>
 #include <cisstMultiTask/mtsInterfaceProvided.h>
 #include <cisstMultiTask/mtsInterfaceOutput.h>
 #include <cisstMultiTask/mtsManagerGlobal.h>
@@ -114,6 +115,11 @@ mtsManagerLocal::~mtsManagerLocal()
     }
     */
     Cleanup();
+
+    if (ExecutorPool) {
+        delete ExecutorPool;
+        ExecutorPool = 0;
+    }
 }
 
 void mtsManagerLocal::Initialize(void)
@@ -126,6 +132,7 @@ void mtsManagerLocal::Initialize(void)
     ManagerComponent.Server = 0;
 
     CurrentMainTask = 0;
+    ExecutorPool = 0;
 
     SetGCMConnected(false);
 
@@ -1870,6 +1877,50 @@ bool mtsManagerLocal::CreateAllAndWait(double timeoutInSeconds)
 }
 
 
+bool mtsManagerLocal::SetExecutorPool(const size_t numberOfThreads)
+{
+    if (ExecutorPool) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetExecutorPool: executor pool already created with "
+                                 << ExecutorPool->GetNumberOfThreads() << " thread(s)" << std::endl;
+        return false;
+    }
+    ExecutorPool = new mtsExecutorPool(numberOfThreads);
+    CMN_LOG_CLASS_INIT_VERBOSE << "SetExecutorPool: created executor pool with "
+                               << ExecutorPool->GetNumberOfThreads() << " thread(s)" << std::endl;
+    return true;
+}
+
+
+bool mtsManagerLocal::RemoveExecutorPool(void)
+{
+    if (!ExecutorPool) {
+        CMN_LOG_CLASS_INIT_ERROR << "RemoveExecutorPool: no executor pool to remove" << std::endl;
+        return false;
+    }
+    bool inUse = false;
+    ComponentMapChange.Lock();
+    ComponentMapType::const_iterator iterator = ComponentMap.begin();
+    const ComponentMapType::const_iterator end = ComponentMap.end();
+    for (; iterator != end; ++iterator) {
+        const mtsTaskFromSignal * task = dynamic_cast<const mtsTaskFromSignal *>(iterator->second);
+        if (task && task->IsUsingExecutorPool()) {
+            CMN_LOG_CLASS_INIT_ERROR << "RemoveExecutorPool: component \"" << task->GetName()
+                                     << "\" is still using the executor pool" << std::endl;
+            inUse = true;
+        }
+    }
+    if (!inUse) {
+        delete ExecutorPool;
+        ExecutorPool = 0;
+    }
+    ComponentMapChange.Unlock();
+    if (!inUse) {
+        CMN_LOG_CLASS_INIT_VERBOSE << "RemoveExecutorPool: executor pool removed" << std::endl;
+    }
+    return !inUse;
+}
+
+
 void mtsManagerLocal::StartAll(void)
 {
     // Get the current thread id in order to check if any task will use the current thread.
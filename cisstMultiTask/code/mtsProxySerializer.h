@@ -6,7 +6,7 @@
   Author(s):  Min Yang Jung
   Created on: 2009-09-01
 
-  (C) Copyright 2009-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -30,26 +30,114 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstCommon/cmnDeSerializer.h>
 #include <cisstMultiTask/mtsGenericObject.h>
 
+#include <streambuf>
+#include <vector>
+
+/*!
+  \ingroup cisstMultiTask
+
+  Stream buffer used for serialization.  The memory is preallocated
+  and reused for all messages, it only grows when a message is larger
+  than all the previous ones.
+*/
+class mtsProxySerializerOutputBuffer: public std::streambuf {
+private:
+    std::vector<char> Buffer;
+
+public:
+    mtsProxySerializerOutputBuffer(const size_t size = 1024):
+        Buffer(size)
+    {
+        Clear();
+    }
+
+    /*! Discard the content without releasing memory. */
+    void Clear(void) {
+        setp(&Buffer[0], &Buffer[0] + Buffer.size());
+    }
+
+    const char * Data(void) const {
+        return pbase();
+    }
+
+    size_t Size(void) const {
+        return static_cast<size_t>(pptr() - pbase());
+    }
+
+protected:
+    int_type overflow(int_type c) override {
+        const size_t size = Size();
+        Buffer.resize(2 * Buffer.size());
+        setp(&Buffer[0], &Buffer[0] + Buffer.size());
+        pbump(static_cast<int>(size));
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+};
+
+
+/*!
+  \ingroup cisstMultiTask
+
+  Stream buffer used for deserialization, reads directly from a
+  memory range owned by the caller (no copy).
+*/
+class mtsProxySerializerInputBuffer: public std::streambuf {
+public:
+    void SetData(const char * data, const size_t size) {
+        char * begin = const_cast<char *>(data);
+        setg(begin, begin, begin + size);
+    }
+};
+
+
 /*!
   \ingroup cisstMultiTask
 
   This class provides the feature of serialization and deserialization for
   command proxy and function proxy classes.
+
+  Buffers are allocated once and reused so the methods using pointers
+  (Serialize(const mtsGenericObject &, const char * &, size_t &) and
+  DeSerialize(const char *, size_t, mtsGenericObject &)) don't
+  allocate memory once the buffers are large enough.  The methods
+  using std::string are preserved for convenience.  Class services
+  are only serialized the first time an object of a given type is
+  sent (see cmnSerializer).
 */
 class mtsProxySerializer {
 private:
     /*! Internal buffer for serialization and deserialization. */
-    std::stringstream SerializationBuffer;
-    std::stringstream DeSerializationBuffer;
+    mtsProxySerializerOutputBuffer SerializationBuffer;
+    mtsProxySerializerInputBuffer DeSerializationBuffer;
+    std::ostream SerializationStream;
+    std::istream DeSerializationStream;
 
     /*! Serializer and Deserializer. */
     cmnSerializer * Serializer;
     cmnDeSerializer * DeSerializer;
 
+    /*! Reset buffers and stream states for a new message. */
+    void StartSerialization(void) {
+        SerializationBuffer.Clear();
+        SerializationStream.clear();
+    }
+
+    void StartDeSerialization(const char * data, const size_t size) {
+        DeSerializationBuffer.SetData(data, size);
+        DeSerializationStream.clear();
+    }
+
 public:
-    mtsProxySerializer() {
-        Serializer = new cmnSerializer(SerializationBuffer);
-        DeSerializer = new cmnDeSerializer(DeSerializationBuffer);
+    mtsProxySerializer():
+        SerializationStream(&SerializationBuffer),
+        DeSerializationStream(&DeSerializationBuffer)
+    {
+        Serializer = new cmnSerializer(SerializationStream);
+        DeSerializer = new cmnDeSerializer(DeSerializationStream);
     }
 
     ~mtsProxySerializer() {
@@ -68,9 +156,9 @@ public:
 
     bool Serialize(const mtsGenericObject & originalObject, std::string & serializedObject) {
         try {
-            SerializationBuffer.str("");
+            StartSerialization();
             Serializer->Serialize(originalObject);
-            serializedObject = SerializationBuffer.str();
+            serializedObject.assign(SerializationBuffer.Data(), SerializationBuffer.Size());
         } catch (const std::runtime_error &e) {
             CMN_LOG_RUN_ERROR << "Serialization failed: " << originalObject.ToString() << std::endl;
             CMN_LOG_RUN_ERROR << e.what() << std::endl;
@@ -82,7 +170,7 @@ public:
 
     bool SerializeStart(const mtsGenericObject & originalObject) {
         try {
-            SerializationBuffer.str("");
+            StartSerialization();
             Serializer->Serialize(originalObject);
         } catch (const std::runtime_error &e) {
             CMN_LOG_RUN_ERROR << "Serialization failed: " << originalObject.ToString() << std::endl;
@@ -106,7 +194,7 @@ public:
     bool SerializeEnd(const mtsGenericObject & originalObject, std::string & serializedObject) {
         try {
             Serializer->Serialize(originalObject);
-            serializedObject = SerializationBuffer.str();
+            serializedObject.assign(SerializationBuffer.Data(), SerializationBuffer.Size());
         } catch (const std::runtime_error &e) {
             CMN_LOG_RUN_ERROR << "Serialization failed: " << originalObject.ToString() << std::endl;
             CMN_LOG_RUN_ERROR << e.what() << std::endl;
@@ -116,10 +204,41 @@ public:
         return true;
     }
 
+    /*! Serialize in the internal buffer, data points to the internal
+      buffer and is valid until the next serialization. */
+    bool Serialize(const mtsGenericObject & originalObject, const char * & data, size_t & size) {
+        try {
+            StartSerialization();
+            Serializer->Serialize(originalObject);
+        } catch (const std::runtime_error &e) {
+            CMN_LOG_RUN_ERROR << "Serialization failed: " << originalObject.ToString() << std::endl;
+            CMN_LOG_RUN_ERROR << e.what() << std::endl;
+            data = 0;
+            size = 0;
+            return false;
+        }
+        data = SerializationBuffer.Data();
+        size = SerializationBuffer.Size();
+        return true;
+    }
+
+    /*! DeSerialize from a memory range, the data is not copied and
+      must remain valid until the last call to DeSerializeNext. */
+    bool DeSerialize(const char * data, const size_t size, mtsGenericObject & originalObject) {
+        try {
+            StartDeSerialization(data, size);
+            DeSerializer->DeSerialize(originalObject);
+        }  catch (const std::runtime_error &e) {
+            originalObject.SetValid(false);
+            CMN_LOG_RUN_ERROR << "DeSerialization failed: " << e.what() << std::endl;
+            return false;
+        }
+        return true;
+    }
+
     bool DeSerialize(const std::string & serializedObject, mtsGenericObject & originalObject) {
         try {
-            DeSerializationBuffer.str("");
-            DeSerializationBuffer << serializedObject;
+            StartDeSerialization(serializedObject.data(), serializedObject.size());
             DeSerializer->DeSerialize(originalObject);
         }  catch (const std::runtime_error &e) {
             originalObject.SetValid(false);
@@ -145,8 +264,7 @@ public:
     mtsGenericObject * DeSerialize(const std::string & serializedObject) {
         cmnGenericObject * deserializedObject = 0;
         try {
-            DeSerializationBuffer.str("");
-            DeSerializationBuffer << serializedObject;
+            StartDeSerialization(serializedObject.data(), serializedObject.size());
             deserializedObject = DeSerializer->DeSerialize();
         }  catch (const std::runtime_error &e) {
             CMN_LOG_RUN_ERROR << "DeSerialization failed: " << e.what() << std::endl;
@@ -5,7 +5,7 @@
   Author(s):  Peter Kazanzides
   Created on: 2013-08-06
 
-  (C) Copyright 2013-2016 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2013-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -309,17 +309,19 @@ public:
             CMN_LOG_RUN_ERROR << "CommandWrapperWrite: invalid handle = " << Handle[1] << std::endl;
             return;
         }
-        std::string sendBuffer;
+        const char * argBuffer;
+        size_t argSize;
         Receiver->SetArg(0);
-        if (Proxy->Serialize(arg, sendBuffer)) {
+        if (Proxy->Serialize(arg, argBuffer, argSize)) {
             char cmdBuffer[2*CommandHandle::COMMAND_HANDLE_STRING_SIZE];
             memcpy(cmdBuffer, Handle, sizeof(Handle));
             if (Receiver->IsBlocking())
                 cmdBuffer[1] = 'w';
             CommandHandle recv_handle('W', receiveHandler);
             recv_handle.ToString(cmdBuffer+CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-            sendBuffer.insert(0, cmdBuffer, sizeof(cmdBuffer));
-            Socket.SendAsPackets(sendBuffer, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05);
+            // send handles and serialized argument without copying them in a single buffer
+            Socket.SendAsPackets(cmdBuffer, sizeof(cmdBuffer), argBuffer, static_cast<unsigned int>(argSize),
+                                 mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05);
             // Now return to the caller. If this is a blocking command, the caller will
             // wait on a thread signal, which will be raised in the Receiver object.
         }
@@ -379,14 +381,15 @@ public:
             return false;
         }
         Receiver->SetArg(&arg2);
-        std::string sendBuffer;
-        if (Proxy->Serialize(arg1, sendBuffer)) {
+        const char * argBuffer;
+        size_t argSize;
+        if (Proxy->Serialize(arg1, argBuffer, argSize)) {
             char cmdBuffer[2*CommandHandle::COMMAND_HANDLE_STRING_SIZE];
             memcpy(cmdBuffer, Handle, sizeof(Handle));
             CommandHandle recv_handle('W', receiveHandler);
             recv_handle.ToString(cmdBuffer+CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-            sendBuffer.insert(0, cmdBuffer, sizeof(cmdBuffer));
-            return (Socket.SendAsPackets(sendBuffer, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05) > 0);
+            return (Socket.SendAsPackets(cmdBuffer, sizeof(cmdBuffer), argBuffer, static_cast<unsigned int>(argSize),
+                                         mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05) > 0);
         }
         return false;
     }
@@ -448,14 +451,15 @@ public:
             return;
         }
         Receiver->SetArg(&arg2);
-        std::string sendBuffer;
-        if (Proxy->Serialize(arg1, sendBuffer)) {
+        const char * argBuffer;
+        size_t argSize;
+        if (Proxy->Serialize(arg1, argBuffer, argSize)) {
             char cmdBuffer[2*CommandHandle::COMMAND_HANDLE_STRING_SIZE];
             memcpy(cmdBuffer, Handle, sizeof(Handle));
             CommandHandle recv_handle('W', receiveHandler);
             recv_handle.ToString(cmdBuffer+CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-            sendBuffer.insert(0, cmdBuffer, sizeof(cmdBuffer));
-            Socket.SendAsPackets(sendBuffer, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05);
+            Socket.SendAsPackets(cmdBuffer, sizeof(cmdBuffer), argBuffer, static_cast<unsigned int>(argSize),
+                                 mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05);
             // Now return to the caller. The caller will wait on a thread signal, which
             // will be raised in the Receiver object.
         }
@@ -852,9 +856,9 @@ void mtsSocketProxyClient::Run(void)
 // Check for events
 void mtsSocketProxyClient::CheckForEvents(double timeoutInSec)
 {
-    std::string inputArgString;
-    char packetBuffer[mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE];
-    int bytesRead = Socket.ReceiveAsPackets(inputArgString, packetBuffer, sizeof(packetBuffer), timeoutInSec, 0.5);
+    // ReceiveBuffer is a data member so its memory is reused for all messages
+    std::string & inputArgString = ReceiveBuffer;
+    int bytesRead = Socket.ReceiveAsPackets(inputArgString, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, timeoutInSec, 0.5);
     if (bytesRead > 0) {
         size_t pos = inputArgString.find(' ');
         if ((pos == 0) && (inputArgString.size() >= CommandHandle::COMMAND_HANDLE_STRING_SIZE)) {
@@ -885,8 +889,10 @@ void mtsSocketProxyClient::CheckForEvents(double timeoutInSec)
                       else {
                           // Check if this command is the event with the return value
                           commandWriteInternal = dynamic_cast<mtsCommandWrite<EventReceiverWriteProxy, std::string> *>(commandBase);
-                          if (commandWriteInternal)
-                              commandWriteInternal->Execute(mtsStdString(inputArgString), MTS_NOT_BLOCKING);
+                          if (commandWriteInternal) {
+                              ReceivedArgument.Data.assign(inputArgString);
+                              commandWriteInternal->Execute(ReceivedArgument, MTS_NOT_BLOCKING);
+                          }
                           else
                               CMN_LOG_CLASS_RUN_ERROR << "MulticastCommandWriteProxy dynamic cast failed" << std::endl;
                       }
@@ -910,6 +916,11 @@ bool mtsSocketProxyClient::Serialize(const mtsGenericObject & originalObject, st
      return Serializer->Serialize(originalObject, serializedObject);
 }
 
+bool mtsSocketProxyClient::Serialize(const mtsGenericObject & originalObject, const char * & data, size_t & size)
+{
+    return Serializer->Serialize(originalObject, data, size);
+}
+
 bool mtsSocketProxyClient::DeSerialize(const std::string & serializedObject, mtsGenericObject & originalObject)
 {
     return Serializer->DeSerialize(serializedObject, originalObject);
@@ -5,7 +5,7 @@
   Author(s):  Peter Kazanzides
   Created on: 2013-08-06
 
-  (C) Copyright 2013-2025 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2013-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -175,34 +175,39 @@ public:
     ~mtsEventSenderWrite() {}
     void Method(const mtsGenericObject &arg)
     {
-        std::string sendBuffer;
-        std::string sendBufferWithServices;
+        // serialize at most twice (with and without class services) and send the
+        // client handle followed by the serialized argument without copying them
+        bool serialized = false;
+        bool serializedWithServices = false;
         std::vector<ClientInfo>::const_iterator it;
         for (it = ClientList.begin(); it != ClientList.end(); it++) {
             if (it->Serializer->ServicesSerialized(arg.Services())) {
-                if (sendBuffer.empty()) {
-                    if (it->Serializer->Serialize(arg, sendBuffer))
-                        sendBuffer.insert(0, it->Handle, CommandHandle::COMMAND_HANDLE_STRING_SIZE);
+                if (!serialized)
+                    serialized = it->Serializer->Serialize(arg, SendBuffer);
+                if (serialized) {
+                    Socket.SetDestination(it->IP_Port);
+                    Socket.SendAsPackets(it->Handle, CommandHandle::COMMAND_HANDLE_STRING_SIZE,
+                                         SendBuffer.data(), static_cast<unsigned int>(SendBuffer.size()),
+                                         mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05);
                 }
-                else
-                    sendBuffer.replace(0, CommandHandle::COMMAND_HANDLE_STRING_SIZE,
-                                       it->Handle,CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-                Socket.SetDestination(it->IP_Port);
-                Socket.SendAsPackets(sendBuffer, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05);
             }
             else {
-                if (sendBufferWithServices.empty()) {
-                    if (it->Serializer->Serialize(arg, sendBufferWithServices))
-                        sendBufferWithServices.insert(0, it->Handle, CommandHandle::COMMAND_HANDLE_STRING_SIZE);
+                if (!serializedWithServices)
+                    serializedWithServices = it->Serializer->Serialize(arg, SendBufferWithServices);
+                if (serializedWithServices) {
+                    Socket.SetDestination(it->IP_Port);
+                    Socket.SendAsPackets(it->Handle, CommandHandle::COMMAND_HANDLE_STRING_SIZE,
+                                         SendBufferWithServices.data(), static_cast<unsigned int>(SendBufferWithServices.size()),
+                                         mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05);
                 }
-                else
-                    sendBufferWithServices.replace(0, CommandHandle::COMMAND_HANDLE_STRING_SIZE,
-                                               it->Handle,CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-                Socket.SetDestination(it->IP_Port);
-                Socket.SendAsPackets(sendBufferWithServices, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05);
             }
         }
     }
+
+protected:
+    // Buffers reused for all events
+    std::string SendBuffer;
+    std::string SendBufferWithServices;
 };
 
 //************************************** Finished Events *************************************************
@@ -223,12 +228,11 @@ class FinishedEventEntry {
     bool Used;
 public:
     FinishedEventEntry() : Socket(0), Serializer(0), Used(false) {}
-    FinishedEventEntry(osaSocket *socket, const osaIPandPort &ip_port, const std::string &recv_handle, mtsProxySerializer *serializer) :
+    // recv_handle must contain at least COMMAND_HANDLE_STRING_SIZE characters
+    FinishedEventEntry(osaSocket *socket, const osaIPandPort &ip_port, const char *recv_handle, mtsProxySerializer *serializer) :
         Socket(socket), IP_Port(ip_port), Serializer(serializer), Used(true)
     {
-        // Make sure recv_handle string is big enough (should be exactly COMMAND_HANDLE_STRING_SIZE)
-        CMN_ASSERT(recv_handle.size() >= sizeof(CommandHandle::COMMAND_HANDLE_STRING_SIZE));
-        memcpy(RecvHandle, recv_handle.data(), sizeof(RecvHandle));
+        memcpy(RecvHandle, recv_handle, sizeof(RecvHandle));
     }
     ~FinishedEventEntry() {}
 
@@ -265,10 +269,10 @@ void FinishedEventEntry::Method(const mtsStdString &argSerialized)
     }
     CMN_ASSERT(Socket);
     CMN_ASSERT(Serializer);
-    std::string sendBuffer(RecvHandle, sizeof(RecvHandle));
-    sendBuffer.append(argSerialized.GetData());
+    const std::string &arg = argSerialized.GetData();
     Socket->SetDestination(IP_Port);
-    Socket->SendAsPackets(sendBuffer, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05);
+    Socket->SendAsPackets(RecvHandle, sizeof(RecvHandle), arg.data(), static_cast<unsigned int>(arg.size()),
+                          mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05);
     Used = false;
 }
 
@@ -276,7 +280,7 @@ void FinishedEventEntry::Method(const mtsStdString &argSerialized)
 // the need for a lot of dynamic memory allocation at runtime. This is a fixed-size list,
 // but that does not place any further restrictions on the system because there the number of
 // outstanding finished events is bounded by the server's mailbox size. Note that there still
-// is some dynamic memory allocation, since std::string objects are used.
+// is some dynamic memory allocation until the std::string objects used to serialize are large enough.
 
 class FinishedEventList {
     mtsMailBox *mailBox;
@@ -288,7 +292,7 @@ public:
     ~FinishedEventList();
 
     mtsCommandWriteBase *AllocateEntry(osaSocket *socket, const osaIPandPort &ip_port,
-                                       const std::string &recv_handle, mtsProxySerializer *serializer);
+                                       const char *recv_handle, mtsProxySerializer *serializer);
 
     bool FreeEntry(mtsCommandWriteBase *cmd);
 };
@@ -319,7 +323,7 @@ FinishedEventList::~FinishedEventList()
 }
 
 mtsCommandWriteBase *FinishedEventList::AllocateEntry(osaSocket *socket, const osaIPandPort &ip_port,
-                                                      const std::string &recv_handle, mtsProxySerializer *serializer)
+                                                      const char *recv_handle, mtsProxySerializer *serializer)
 {
     for (size_t i = 0; i < List.size(); i++) {
         if (List[i].IsAvailable()) {
@@ -805,9 +809,9 @@ void mtsSocketProxyServer::Run(void)
     ProcessQueuedCommands();
     ProcessQueuedEvents();
 
-    std::string inputArgString;
-    char packetBuffer[mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE];
-    int bytesRead = Socket.ReceiveAsPackets(inputArgString, packetBuffer, sizeof(packetBuffer), 0.001, 0.1);
+    // ReceiveBuffer and SendBuffer are data members so their memory is reused for all messages
+    std::string & inputArgString = ReceiveBuffer;
+    int bytesRead = Socket.ReceiveAsPackets(inputArgString, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.001, 0.1);
     if (bytesRead > 0) {
 
         // Process the input string. The code currently supports two protocols, which
@@ -842,8 +846,12 @@ void mtsSocketProxyServer::Run(void)
         // or by the serialized mtsExecutionResult (for blocking void and write).
 
         mtsExecutionResult ret;
-        std::string        RecvHandle;
-        std::string        outputArgString;
+        // RecvHandle is left empty (size 0) for the CommandString protocol
+        char               RecvHandle[CommandHandle::COMMAND_HANDLE_STRING_SIZE];
+        size_t             RecvHandleSize = 0;
+        std::string &      outputArgString = SendBuffer;
+        memset(RecvHandle, 0, sizeof(RecvHandle));
+        outputArgString.clear();
 
         osaIPandPort ip_port;
         Socket.GetDestination(ip_port);
@@ -856,8 +864,8 @@ void mtsSocketProxyServer::Run(void)
         size_t pos = inputArgString.find(' ');
         if ((pos == 0) && (inputArgString.size() >= 2*CommandHandle::COMMAND_HANDLE_STRING_SIZE)) {
             CommandHandle handle(inputArgString);
-            RecvHandle = inputArgString.substr(CommandHandle::COMMAND_HANDLE_STRING_SIZE,
-                                               CommandHandle::COMMAND_HANDLE_STRING_SIZE);
+            memcpy(RecvHandle, inputArgString.data() + CommandHandle::COMMAND_HANDLE_STRING_SIZE, sizeof(RecvHandle));
+            RecvHandleSize = sizeof(RecvHandle);
             inputArgString.erase(0, 2*CommandHandle::COMMAND_HANDLE_STRING_SIZE);
             // Since we know the command type (handle.cmdType) we could reinterpret_cast directly to
             // the correct mtsFunctionXXXX type, but to be safe we first reinterpret_cast to the base
@@ -1083,15 +1091,16 @@ void mtsSocketProxyServer::Run(void)
                 FinishedEvents->FreeEntry(eventSenderCommand);
             // Send a reply to the caller with the following format:
             //    RecvHandle | outputString
-            outputArgString.insert(0, RecvHandle);
-
-            size_t nBytes = outputArgString.size();
+            // RecvHandle and outputString are not copied in a single buffer (gather send).
+            size_t nBytes = RecvHandleSize + outputArgString.size();
             // If the packet size is an exact multiple of SOCKET_PROXY_PACKET_SIZE (nBytes == 0), then we
             // send an extra byte so that the receiver does not have to rely on a timeout to figure out
             // when a packet stream is finished.
             if ((nBytes%mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE) == 0)
                 outputArgString.append(" ");
-            Socket.SendAsPackets(outputArgString, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.1);
+            Socket.SendAsPackets(RecvHandle, static_cast<unsigned int>(RecvHandleSize),
+                                 outputArgString.data(), static_cast<unsigned int>(outputArgString.size()),
+                                 mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.1);
         }
     }
 }
@@ -1406,7 +1415,7 @@ mtsProxySerializer *mtsSocketProxyServer::GetSerializerForCurrentClient(void) co
     return GetSerializerForClient(ip_port);
 }
 
-mtsCommandWriteBase *mtsSocketProxyServer::AllocateFinishedEvent(const std::string &eventHandle)
+mtsCommandWriteBase *mtsSocketProxyServer::AllocateFinishedEvent(const char *eventHandle)
 {
     CMN_ASSERT(FinishedEvents);
     osaIPandPort ip_port;
@@ -5,7 +5,7 @@
  Author(s):  Ankur Kapoor, Min Yang Jung, Anton Deguet
  Created on: 2004-04-30
 
- (C) Copyright 2004-2025 Johns Hopkins University (JHU), All Rights Reserved.
+ (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -47,6 +47,7 @@ mtsStateTable::mtsStateTable(size_t size, const std::string & name):
     StateVector(0),
     StateVectorDataNames(0),
     Ticks(size, mtsStateIndex::TimeTicksType(0)),
+    NumberOfReadRetries(0),
     Tic(0.0),
     Toc(0.0),
     Period(0.0),
@@ -121,13 +122,61 @@ bool mtsStateTable::SetSize(const size_t size) {
 
 /* All the const methods that can be called from reader or writer */
 mtsStateIndex mtsStateTable::GetIndexReader(void) const {
-    size_t tmp = IndexReader;
-    return mtsStateIndex(this->Tic, static_cast<int>(tmp), Ticks[tmp], static_cast<int>(HistoryLength));
+    // pairs with the release store in Advance, data for row tmp is visible
+    const size_t tmp = IndexReader.load(std::memory_order_acquire);
+    return mtsStateIndex(this->Tic, static_cast<int>(tmp), Ticks[tmp].load(std::memory_order_relaxed),
+                         static_cast<int>(HistoryLength));
 }
 
 mtsStateIndex mtsStateTable::GetIndexDelayed(void) const {
-    size_t tmp = IndexDelayed;
-    return mtsStateIndex(this->Tic, static_cast<int>(tmp), Ticks[tmp], static_cast<int>(HistoryLength));
+    const size_t tmp = IndexDelayed.load(std::memory_order_acquire);
+    return mtsStateIndex(this->Tic, static_cast<int>(tmp), Ticks[tmp].load(std::memory_order_relaxed),
+                         static_cast<int>(HistoryLength));
+}
+
+bool mtsStateTable::GetBatch(const mtsStateIndex & when,
+                             const std::vector<mtsStateDataId> & ids,
+                             const std::vector<mtsGenericObject *> & data) const
+{
+    if (ids.size() != data.size()) {
+        CMN_LOG_CLASS_RUN_ERROR << "GetBatch: number of ids (" << ids.size()
+                                << ") doesn't match number of objects (" << data.size() << ")" << std::endl;
+        return false;
+    }
+    const size_t numberOfElements = StateVectorAccessors.size();
+    for (size_t index = 0; index < ids.size(); ++index) {
+        const size_t id = static_cast<size_t>(ids[index]);
+        if ((id >= numberOfElements) || !data[index]) {
+            CMN_LOG_CLASS_RUN_ERROR << "GetBatch: invalid id or null object at position " << index << std::endl;
+            return false;
+        }
+        if (!StateVectorAccessors[id]->Copy(when, *(data[index]))) {
+            CMN_LOG_CLASS_RUN_ERROR << "GetBatch: type mismatch for element \""
+                                    << StateVectorDataNames[id] << "\"" << std::endl;
+            return false;
+        }
+    }
+    return ValidateReadIndex(when);
+}
+
+bool mtsStateTable::GetLatestBatch(const std::vector<mtsStateDataId> & ids,
+                                   const std::vector<mtsGenericObject *> & data,
+                                   const size_t maxRetries) const
+{
+    for (size_t attempt = 0; attempt <= maxRetries; ++attempt) {
+        if (attempt != 0) {
+            NumberOfReadRetries.fetch_add(1, std::memory_order_relaxed);
+        }
+        const mtsStateIndex when = GetIndexReader();
+        if (GetBatch(when, ids, data)) {
+            return true;
+        }
+        // don't retry if the failure is not caused by the writer
+        if (ValidateReadIndex(when)) {
+            return false;
+        }
+    }
+    return false;
 }
 
 size_t mtsStateTable::SetDelay(size_t newDelay) {
@@ -160,7 +209,8 @@ mtsStateTable::AccessorBase * mtsStateTable::GetAccessorById(const size_t id) co
 
 /* All the non-const methods that can be called from writer only */
 mtsStateIndex mtsStateTable::GetIndexWriter(void) const {
-    return mtsStateIndex(this->Tic, static_cast<int>(IndexWriter), Ticks[IndexWriter], static_cast<int>(HistoryLength));
+    return mtsStateIndex(this->Tic, static_cast<int>(IndexWriter), Ticks[IndexWriter].load(std::memory_order_relaxed),
+                         static_cast<int>(HistoryLength));
 }
 
 
@@ -317,15 +367,21 @@ void mtsStateTable::Advance(void) {
     PeriodStats.Update(Period.Data, this->Toc - this->Tic);
 
     Write(TocId, Toc);
-    // now increment the IndexWriter and set its Tick value
+    // now increment the IndexWriter and set its Tick value.  The new
+    // Tick value invalidates indices held by readers on this row, the
+    // fence orders it before the data written in this row during the
+    // next Advance (see ValidateReadIndex and ReadLatest).
     IndexWriter = newIndexWriter;
-    Ticks[IndexWriter] = Ticks[tmpIndex] + 1;
-    // move index reader to recently written data
-    IndexReader = tmpIndex;
+    Ticks[IndexWriter].store(Ticks[tmpIndex].load(std::memory_order_relaxed) + 1,
+                             std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    // move index reader to recently written data, the release store
+    // publishes the data written above
+    IndexReader.store(tmpIndex, std::memory_order_release);
 
     // compute index delayed, ideally a valid index
-    if (IndexReader > Delay) {
-        IndexDelayed = IndexReader - Delay;
+    if (tmpIndex > Delay) {
+        IndexDelayed.store(tmpIndex - Delay, std::memory_order_release);
     }
 
     // update "started" status
@@ -5,7 +5,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides, Min Yang Jung
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2020 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
   --- begin cisst license - do not edit ---
 
@@ -423,7 +423,7 @@ void mtsTask::ProcessManagerCommandsIfNotActive()
         }
         else { // Wake up the thread just in case (e.g., for mtsTaskFromSignal)
             CMN_LOG_CLASS_INIT_VERBOSE << "Task " << this->GetName() << " active, not processing internal mailbox" << std::endl;
-            this->Thread.Wakeup();
+            this->Wakeup();
         }
         StateChange.Unlock();
     }
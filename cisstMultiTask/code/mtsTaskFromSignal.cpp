@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2009-12-10
 
-  (C) Copyright 2009-2019 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -22,12 +22,21 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsInterfaceProvided.h>
 #include <cisstMultiTask/mtsCommandVoid.h>
 #include <cisstMultiTask/mtsManagerComponentBase.h>
+#include <cisstMultiTask/mtsManagerLocal.h>
+
+
+// task run by the executor pool on the current thread, null if the
+// current thread is not running a task from a pool
+static thread_local const mtsTaskFromSignal * mtsTaskFromSignalCurrentTask = 0;
 
 
 mtsTaskFromSignal::mtsTaskFromSignal(const std::string & name,
                                      unsigned int sizeStateTable):
     mtsTaskContinuous(name, sizeStateTable),
-    PostCommandQueuedCallable(0)
+    PostCommandQueuedCallable(0),
+    ExecutorJob(this),
+    ExecutorPool(0),
+    UseExecutorPool(true)
 {
     this->Init();
 }
@@ -35,7 +44,10 @@ mtsTaskFromSignal::mtsTaskFromSignal(const std::string & name,
 
 mtsTaskFromSignal::mtsTaskFromSignal(const mtsTaskConstructorArg & arg):
     mtsTaskContinuous(arg.Name, arg.StateTableSize),
-    PostCommandQueuedCallable(0)
+    PostCommandQueuedCallable(0),
+    ExecutorJob(this),
+    ExecutorPool(0),
+    UseExecutorPool(true)
 {
     this->Init();
 }
@@ -51,8 +63,115 @@ void mtsTaskFromSignal::Init(void)
 }
 
 
+mtsTaskFromSignal::~mtsTaskFromSignal()
+{
+    // base class destructor can't use the pool since Wakeup is
+    // virtual, kill the task here and make sure the job is not
+    // scheduled anymore
+    if (ExecutorPool) {
+        if (!this->IsTerminated()) {
+            Kill();
+            WaitToTerminate(1.0 * cmn_s);
+        }
+        if (!ExecutorPool->WaitForIdle(&ExecutorJob, 1.0 * cmn_s)) {
+            CMN_LOG_CLASS_INIT_ERROR << "destructor: task \"" << this->GetName()
+                                     << "\" still scheduled on executor pool" << std::endl;
+        }
+    }
+}
+
+
+void mtsTaskFromSignal::SetUseExecutorPool(const bool useExecutorPool)
+{
+    if (this->State != mtsComponentState::CONSTRUCTED) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetUseExecutorPool: task \"" << this->GetName()
+                                 << "\" already created, state = " << this->State << std::endl;
+        return;
+    }
+    UseExecutorPool = useExecutorPool;
+}
+
+
 void mtsTaskFromSignal::PostCommandQueuedMethod(void) {
-    this->Thread.Wakeup();
+    this->Wakeup();
+}
+
+
+void mtsTaskFromSignal::Wakeup(void)
+{
+    if (ExecutorPool) {
+        ExecutorPool->Schedule(&ExecutorJob);
+    } else {
+        this->Thread.Wakeup();
+    }
+}
+
+
+bool mtsTaskFromSignal::CheckForOwnThread(void) const
+{
+    if (ExecutorPool) {
+        return (mtsTaskFromSignalCurrentTask == this);
+    }
+    return BaseType::CheckForOwnThread();
+}
+
+
+void mtsTaskFromSignal::StartInternal(void)
+{
+    this->Wakeup();
+}
+
+
+void mtsTaskFromSignal::ExecutorJobType::Execute(void)
+{
+    const mtsTaskFromSignal * previousTask = mtsTaskFromSignalCurrentTask;
+    mtsTaskFromSignalCurrentTask = Task;
+    Task->RunFromExecutorPool();
+    mtsTaskFromSignalCurrentTask = previousTask;
+}
+
+
+void mtsTaskFromSignal::RunFromExecutorPool(void)
+{
+    // same logic as RunInternal except that we return instead of
+    // waiting for a signal
+    switch (this->State.State()) {
+    case mtsComponentState::INITIALIZING:
+        this->StartupInternal();
+        break;
+    case mtsComponentState::ACTIVE:
+        DoRunInternal();
+        break;
+    case mtsComponentState::FINISHING:
+        CMN_LOG_CLASS_INIT_VERBOSE << "RunFromExecutorPool: end of task \"" << this->GetName() << "\"" << std::endl;
+        this->CleanupInternal();
+        break;
+    default:
+        // READY, wait for Start
+        break;
+    }
+}
+
+
+void mtsTaskFromSignal::Create(void * data)
+{
+    mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
+    mtsExecutorPool * executorPool = componentManager->GetExecutorPool();
+    if (!executorPool
+        || !UseExecutorPool
+        || !NewThread
+        || (this->State != mtsComponentState::CONSTRUCTED)
+        || (ExecIn && ExecIn->GetConnectedInterface())) {
+        BaseType::Create(data);
+        return;
+    }
+    RemoveInterfaceRequired("ExecIn", true);
+    ExecIn = 0;
+    CMN_LOG_CLASS_INIT_VERBOSE << "Create: using executor pool for task " << this->GetName() << std::endl;
+    SaveThreadStartData(data);
+    ExecutorPool = executorPool;
+    ChangeState(mtsComponentState::INITIALIZING);
+    ExecutorPool->Schedule(&ExecutorJob);
 }
 
 
@@ -102,7 +221,7 @@ void mtsTaskFromSignal::Kill(void)
     CMN_LOG_CLASS_INIT_VERBOSE << "Kill: task \"" << this->GetName() << "\", current state \"" << this->State << "\"" << std::endl;
     mtsTask::Kill();
     // only difference is that we need to wake up the thread to make sure it processes the request
-    this->Thread.Wakeup();
+    this->Wakeup();
 }
 
 
@@ -5,7 +5,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2019 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -48,9 +48,14 @@ void * mtsTaskPeriodic::RunInternal(void *data)
     while ((currentState == mtsComponentState::ACTIVE) || (currentState == mtsComponentState::READY)) {
         if (currentState == mtsComponentState::ACTIVE) {
             DoRunInternal();
-            if (StateTable.GetToc() - StateTable.GetTic() > Period) {
+            const double computeTime = StateTable.GetToc() - StateTable.GetTic();
+            const bool overran = (computeTime > Period);
+            if (overran) {
                 OverranPeriod = true;
             }
+            // wake up latency and missed periods from the wait preceding this iteration
+            TimingStatistics.Record(ThreadBuddy.GetWakeUpLatency(), computeTime, overran,
+                                    ThreadBuddy.GetNumberOfMissedPeriods());
         }
         // Wait for remaining period also handles thread suspension
         ThreadBuddy.WaitForRemainingPeriod();
@@ -179,3 +184,29 @@ bool mtsTaskPeriodic::IsPeriodic(void) const
 {
     return Period > 0.0;
 }
+
+void mtsTaskPeriodic::SetAbsoluteTimeWait(const bool absoluteTime, const double spinTime)
+{
+    if (this->State != mtsComponentState::CONSTRUCTED) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetAbsoluteTimeWait: task \"" << this->GetName()
+                                 << "\" is already created, wake up policy can't be changed" << std::endl;
+        return;
+    }
+    if (spinTime >= Period) {
+        CMN_LOG_CLASS_INIT_WARNING << "SetAbsoluteTimeWait: spin time (" << spinTime
+                                   << ") is greater than period (" << Period << ") for task \""
+                                   << this->GetName() << "\", the task will never sleep" << std::endl;
+    }
+    ThreadBuddy.SetAbsoluteTimeWait(absoluteTime, spinTime);
+}
+
+void mtsTaskPeriodic::GetTimingStatistics(mtsTaskPeriodicStatistics & statistics) const
+{
+    TimingStatistics.Get(statistics);
+    statistics.Valid() = true;
+}
+
+void mtsTaskPeriodic::ResetTimingStatistics(void)
+{
+    TimingStatistics.Reset();
+}
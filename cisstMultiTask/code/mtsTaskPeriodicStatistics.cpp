@@ -0,0 +1,285 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstCommon/cmnSerializer.h>
+#include <cisstCommon/cmnDeSerializer.h>
+#include <cisstMultiTask/mtsTaskPeriodicStatistics.h>
+
+#include <cmath>
+
+CMN_IMPLEMENT_SERVICES(mtsTaskPeriodicStatistics);
+
+
+size_t mtsTaskPeriodicStatistics::Bin(const double duration)
+{
+    // round to the nearest nano second
+    const double nanoSeconds = std::floor(duration * 1.0e9 + 0.5);
+    if (!(nanoSeconds >= 0.0)) {
+        return 0;
+    }
+    if (nanoSeconds >= std::ldexp(1.0, MAX_EXPONENT)) {
+        return NUMBER_OF_BINS - 1;
+    }
+    const unsigned long long value = static_cast<unsigned long long>(nanoSeconds);
+    if (value < SUB_BINS) {
+        return static_cast<size_t>(value);
+    }
+    // value = mantissa * 2^exponent with mantissa in [0.5, 1), so
+    // the highest bit set is exponent - 1
+    int exponent;
+    std::frexp(static_cast<double>(value), &exponent);
+    const int shift = exponent - 1 - SUB_BIN_BITS;
+    const size_t subBin = static_cast<size_t>((value >> shift) - SUB_BINS);
+    return static_cast<size_t>(shift + 1) * SUB_BINS + subBin;
+}
+
+
+double mtsTaskPeriodicStatistics::BinLowerBound(const size_t bin)
+{
+    if (bin < SUB_BINS) {
+        return static_cast<double>(bin) * 1.0e-9;
+    }
+    const int shift = static_cast<int>(bin / SUB_BINS) - 1;
+    const size_t subBin = bin % SUB_BINS;
+    return std::ldexp(static_cast<double>(SUB_BINS + subBin), shift) * 1.0e-9;
+}
+
+
+double mtsTaskPeriodicStatistics::BinUpperBound(const size_t bin)
+{
+    if (bin < SUB_BINS) {
+        return static_cast<double>(bin + 1) * 1.0e-9;
+    }
+    const int shift = static_cast<int>(bin / SUB_BINS) - 1;
+    return BinLowerBound(bin) + std::ldexp(1.0e-9, shift);
+}
+
+
+mtsTaskPeriodicStatistics::HistogramType::HistogramType(void)
+{
+    Reset();
+}
+
+
+double mtsTaskPeriodicStatistics::HistogramType::Avg(void) const
+{
+    if (NumberOfSamples == 0) {
+        return 0.0;
+    }
+    return Sum / static_cast<double>(NumberOfSamples);
+}
+
+
+double mtsTaskPeriodicStatistics::HistogramType::Percentile(const double percentile) const
+{
+    const size_t bin = mtsHistogramRecorder<mtsTaskPeriodicStatistics>::PercentileBin(Bins, percentile);
+    if (bin == NUMBER_OF_BINS) {
+        return 0.0;
+    }
+    const double upperBound = BinUpperBound(bin);
+    return (upperBound < Max) ? upperBound : Max;
+}
+
+
+void mtsTaskPeriodicStatistics::HistogramType::Reset(void)
+{
+    NumberOfSamples = 0;
+    Sum = 0.0;
+    Min = 0.0;
+    Max = 0.0;
+    for (size_t bin = 0; bin < NUMBER_OF_BINS; ++bin) {
+        Bins[bin] = 0;
+    }
+}
+
+
+mtsTaskPeriodicStatistics::mtsTaskPeriodicStatistics(void):
+    mtsGenericObject(),
+    NumberOfOverruns(0),
+    CurrentOverrunStreak(0),
+    LongestOverrunStreak(0),
+    NumberOfMissedPeriods(0)
+{
+}
+
+
+void mtsTaskPeriodicStatistics::ToStream(std::ostream & outputStream) const
+{
+    outputStream << "Iterations: " << ComputeTime.NumberOfSamples
+                 << " WakeUpLatencyAvg: " << WakeUpLatency.Avg()
+                 << " WakeUpLatencyP99: " << WakeUpLatency.Percentile(0.99)
+                 << " WakeUpLatencyP999: " << WakeUpLatency.Percentile(0.999)
+                 << " WakeUpLatencyMax: " << WakeUpLatency.Max
+                 << " ComputeTimeAvg: " << ComputeTime.Avg()
+                 << " ComputeTimeP99: " << ComputeTime.Percentile(0.99)
+                 << " ComputeTimeP999: " << ComputeTime.Percentile(0.999)
+                 << " ComputeTimeMax: " << ComputeTime.Max
+                 << " Overruns: " << NumberOfOverruns
+                 << " CurrentOverrunStreak: " << CurrentOverrunStreak
+                 << " LongestOverrunStreak: " << LongestOverrunStreak
+                 << " MissedPeriods: " << NumberOfMissedPeriods;
+}
+
+
+void mtsTaskPeriodicStatistics::ToStreamRaw(std::ostream & outputStream, const char delimiter,
+                                            bool headerOnly, const std::string & headerPrefix) const
+{
+    BaseType::ToStreamRaw(outputStream, delimiter, headerOnly, headerPrefix);
+    outputStream << delimiter;
+    if (headerOnly) {
+        outputStream << headerPrefix << "-Iterations" << delimiter
+                     << headerPrefix << "-WakeUpLatencyAvg" << delimiter
+                     << headerPrefix << "-WakeUpLatencyP99" << delimiter
+                     << headerPrefix << "-WakeUpLatencyMax" << delimiter
+                     << headerPrefix << "-ComputeTimeAvg" << delimiter
+                     << headerPrefix << "-ComputeTimeP99" << delimiter
+                     << headerPrefix << "-ComputeTimeMax" << delimiter
+                     << headerPrefix << "-Overruns" << delimiter
+                     << headerPrefix << "-LongestOverrunStreak" << delimiter
+                     << headerPrefix << "-MissedPeriods";
+    } else {
+        outputStream << ComputeTime.NumberOfSamples << delimiter
+                     << WakeUpLatency.Avg() << delimiter
+                     << WakeUpLatency.Percentile(0.99) << delimiter
+                     << WakeUpLatency.Max << delimiter
+                     << ComputeTime.Avg() << delimiter
+                     << ComputeTime.Percentile(0.99) << delimiter
+                     << ComputeTime.Max << delimiter
+                     << NumberOfOverruns << delimiter
+                     << LongestOverrunStreak << delimiter
+                     << NumberOfMissedPeriods;
+    }
+}
+
+
+namespace {
+    void mtsTaskPeriodicStatisticsSerialize(std::ostream & outputStream,
+                                            const mtsTaskPeriodicStatistics::HistogramType & histogram)
+    {
+        cmnSerializeRaw(outputStream, histogram.NumberOfSamples);
+        cmnSerializeRaw(outputStream, histogram.Sum);
+        cmnSerializeRaw(outputStream, histogram.Min);
+        cmnSerializeRaw(outputStream, histogram.Max);
+        for (size_t bin = 0; bin < mtsTaskPeriodicStatistics::NUMBER_OF_BINS; ++bin) {
+            cmnSerializeRaw(outputStream, histogram.Bins[bin]);
+        }
+    }
+
+    void mtsTaskPeriodicStatisticsDeSerialize(std::istream & inputStream,
+                                              mtsTaskPeriodicStatistics::HistogramType & histogram)
+    {
+        cmnDeSerializeRaw(inputStream, histogram.NumberOfSamples);
+        cmnDeSerializeRaw(inputStream, histogram.Sum);
+        cmnDeSerializeRaw(inputStream, histogram.Min);
+        cmnDeSerializeRaw(inputStream, histogram.Max);
+        for (size_t bin = 0; bin < mtsTaskPeriodicStatistics::NUMBER_OF_BINS; ++bin) {
+            cmnDeSerializeRaw(inputStream, histogram.Bins[bin]);
+        }
+    }
+}
+
+
+void mtsTaskPeriodicStatistics::SerializeRaw(std::ostream & outputStream) const
+{
+    BaseType::SerializeRaw(outputStream);
+    mtsTaskPeriodicStatisticsSerialize(outputStream, WakeUpLatency);
+    mtsTaskPeriodicStatisticsSerialize(outputStream, ComputeTime);
+    cmnSerializeRaw(outputStream, NumberOfOverruns);
+    cmnSerializeRaw(outputStream, CurrentOverrunStreak);
+    cmnSerializeRaw(outputStream, LongestOverrunStreak);
+    cmnSerializeRaw(outputStream, NumberOfMissedPeriods);
+}
+
+
+void mtsTaskPeriodicStatistics::DeSerializeRaw(std::istream & inputStream)
+{
+    BaseType::DeSerializeRaw(inputStream);
+    mtsTaskPeriodicStatisticsDeSerialize(inputStream, WakeUpLatency);
+    mtsTaskPeriodicStatisticsDeSerialize(inputStream, ComputeTime);
+    cmnDeSerializeRaw(inputStream, NumberOfOverruns);
+    cmnDeSerializeRaw(inputStream, CurrentOverrunStreak);
+    cmnDeSerializeRaw(inputStream, LongestOverrunStreak);
+    cmnDeSerializeRaw(inputStream, NumberOfMissedPeriods);
+}
+
+
+mtsTaskPeriodicStatisticsRecorder::mtsTaskPeriodicStatisticsRecorder(void):
+    ResetRequested(false)
+{
+    ResetAll();
+}
+
+
+void mtsTaskPeriodicStatisticsRecorder::ResetAll(void)
+{
+    const std::memory_order relaxed = std::memory_order_relaxed;
+    WakeUpLatency.Reset();
+    ComputeTime.Reset();
+    NumberOfOverruns.store(0, relaxed);
+    CurrentOverrunStreak.store(0, relaxed);
+    LongestOverrunStreak.store(0, relaxed);
+    NumberOfMissedPeriods.store(0, relaxed);
+}
+
+
+void mtsTaskPeriodicStatisticsRecorder::Record(const double wakeUpLatency, const double computeTime,
+                                               const bool overrun, const unsigned int missedPeriods)
+{
+    const std::memory_order relaxed = std::memory_order_relaxed;
+    // exchange so a Reset requested during ResetAll is not lost
+    if (ResetRequested.exchange(false, std::memory_order_acquire)) {
+        ResetAll();
+    }
+    WakeUpLatency.Record(wakeUpLatency);
+    ComputeTime.Record(computeTime);
+    if (overrun) {
+        NumberOfOverruns.store(NumberOfOverruns.load(relaxed) + 1, relaxed);
+        const unsigned long long streak = CurrentOverrunStreak.load(relaxed) + 1;
+        CurrentOverrunStreak.store(streak, relaxed);
+        if (streak > LongestOverrunStreak.load(relaxed)) {
+            LongestOverrunStreak.store(streak, relaxed);
+        }
+    } else {
+        CurrentOverrunStreak.store(0, relaxed);
+    }
+    if (missedPeriods > 0) {
+        NumberOfMissedPeriods.store(NumberOfMissedPeriods.load(relaxed) + missedPeriods, relaxed);
+    }
+}
+
+
+void mtsTaskPeriodicStatisticsRecorder::Get(mtsTaskPeriodicStatistics & statistics) const
+{
+    const std::memory_order relaxed = std::memory_order_relaxed;
+    WakeUpLatency.Get(statistics.WakeUpLatency.NumberOfSamples, statistics.WakeUpLatency.Sum,
+                      statistics.WakeUpLatency.Min, statistics.WakeUpLatency.Max,
+                      statistics.WakeUpLatency.Bins);
+    ComputeTime.Get(statistics.ComputeTime.NumberOfSamples, statistics.ComputeTime.Sum,
+                    statistics.ComputeTime.Min, statistics.ComputeTime.Max,
+                    statistics.ComputeTime.Bins);
+    statistics.NumberOfOverruns = NumberOfOverruns.load(relaxed);
+    statistics.CurrentOverrunStreak = CurrentOverrunStreak.load(relaxed);
+    statistics.LongestOverrunStreak = LongestOverrunStreak.load(relaxed);
+    statistics.NumberOfMissedPeriods = NumberOfMissedPeriods.load(relaxed);
+}
+
+
+void mtsTaskPeriodicStatisticsRecorder::Reset(void)
+{
+    ResetRequested.store(true, std::memory_order_release);
+}
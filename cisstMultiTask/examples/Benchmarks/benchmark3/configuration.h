@@ -0,0 +1,36 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#ifndef _configuration_h
+#define _configuration_h
+
+#include <cisstCommon/cmnUnits.h>
+
+const double confServerPeriod = 1.0 * cmn_ms;
+
+// default number of clients connected to the server and one active
+// client (sending commands) every confActiveClientsRatio
+const size_t confNumberOfClients = 32;
+const size_t confActiveClientsRatio = 8;
+
+const size_t confNumberOfSamples = 5000;
+const size_t confNumberOfSamplesToSkip = 500;
+
+#endif // _configuration_h
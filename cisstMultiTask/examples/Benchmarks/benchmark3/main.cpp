@@ -0,0 +1,87 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+/*
+  Benchmark comparing the cost of processing queued commands when many
+  clients are connected to a single provided interface, with one
+  mailbox per client (default) or a single shared mailbox.  Usage:
+
+  mtsExBenchmark3 [shared]
+*/
+
+#include <cisstCommon/cmnConstants.h>
+#include <cisstOSAbstraction/osaSleep.h>
+#include <cisstMultiTask/mtsManagerLocal.h>
+#include <cisstMultiTask/mtsInterfaceRequired.h>
+
+#include "serverTask.h"
+#include "configuration.h"
+
+int main(int argc, char ** argv)
+{
+    // log configuration
+    cmnLogger::SetMask(CMN_LOG_ALLOW_ALL);
+    cmnLogger::AddChannel(std::cout, CMN_LOG_ALLOW_ERRORS_AND_WARNINGS);
+
+    const bool sharedMailBox = ((argc > 1) && (std::string(argv[1]) == "shared"));
+
+    mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
+
+    serverTask * server = new serverTask("Server", confServerPeriod, sharedMailBox);
+    componentManager->AddComponent(server);
+
+    // clients are simple components, commands are sent from the main thread
+    std::vector<mtsFunctionWrite *> writeFunctions;
+    size_t index;
+    for (index = 0; index < confNumberOfClients; ++index) {
+        std::stringstream name;
+        name << "Client" << index;
+        mtsComponent * client = new mtsComponent(name.str());
+        mtsFunctionWrite * write = new mtsFunctionWrite;
+        mtsInterfaceRequired * required = client->AddInterfaceRequired("Required");
+        required->AddFunction("Write", *write);
+        componentManager->AddComponent(client);
+        componentManager->Connect(name.str(), "Required", "Server", "Provided");
+        writeFunctions.push_back(write);
+    }
+
+    componentManager->CreateAll();
+    componentManager->WaitForStateAll(mtsComponentState::READY);
+    componentManager->StartAll();
+    componentManager->WaitForStateAll(mtsComponentState::ACTIVE);
+
+    // a few active clients send a command every period
+    mtsDouble value = 0.0;
+    while (!server->IsBenchmarkCompleted()) {
+        for (index = 0; index < confNumberOfClients; index += confActiveClientsRatio) {
+            (*(writeFunctions[index]))(value);
+        }
+        value.Data += 1.0;
+        osaSleep(confServerPeriod);
+    }
+
+    server->ShowResults();
+
+    componentManager->KillAll();
+    componentManager->WaitForStateAll(mtsComponentState::FINISHED, 2.0 * cmn_s);
+    componentManager->Cleanup();
+
+    return 0;
+}
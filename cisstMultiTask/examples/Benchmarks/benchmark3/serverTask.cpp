@@ -0,0 +1,98 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstMultiTask/mtsInterfaceProvided.h>
+
+#include "serverTask.h"
+#include "configuration.h"
+
+CMN_IMPLEMENT_SERVICES(serverTask);
+
+serverTask::serverTask(const std::string & taskName, double period, bool sharedMailBox):
+    mtsTaskPeriodic(taskName, period, false, 5000),
+    NumberOfSamplesSkipped(0),
+    NumberOfSamplesCollected(0),
+    NumberOfCommands(0),
+    BenchmarkCompleted(false),
+    SharedMailBox(sharedMailBox)
+{
+    mtsInterfaceProvided * providedInterface = AddInterfaceProvided("Provided");
+    if (providedInterface) {
+        if (sharedMailBox) {
+            // one mailbox for all clients, make sure it's large enough
+            providedInterface->SetMailBoxSize(confNumberOfClients * 64);
+            providedInterface->SetMailBoxShared(true);
+        }
+        providedInterface->AddCommandWrite(&serverTask::Write, this, "Write");
+    }
+    Results.SetSize(confNumberOfSamples);
+}
+
+void serverTask::Write(const mtsDouble & CMN_UNUSED(value))
+{
+    ++NumberOfCommands;
+}
+
+void serverTask::Run(void)
+{
+    const double start = osaGetTime();
+    ProcessQueuedCommands();
+    const double elapsed = osaGetTime() - start;
+
+    if (BenchmarkCompleted) {
+        return;
+    }
+    if (NumberOfSamplesSkipped < confNumberOfSamplesToSkip) {
+        NumberOfSamplesSkipped++;
+        NumberOfCommands = 0;
+        return;
+    }
+    Results.Element(NumberOfSamplesCollected) = elapsed;
+    NumberOfSamplesCollected++;
+    if (NumberOfSamplesCollected == confNumberOfSamples) {
+        BenchmarkCompleted = true;
+    }
+}
+
+bool serverTask::IsBenchmarkCompleted(void) const
+{
+    return BenchmarkCompleted;
+}
+
+void serverTask::ShowResults(void) const
+{
+    const double average = Results.SumOfElements() / Results.size();
+    double min = 0.0;
+    double max = 0.0;
+    Results.MinAndMaxElement(min, max);
+
+    std::cout << std::endl
+              << "--------------------------------------------------------------------" << std::endl
+              << "Mailbox mode: " << (SharedMailBox ? "shared" : "one per client") << std::endl
+              << "Number of clients: " << confNumberOfClients
+              << " (" << confNumberOfClients / confActiveClientsRatio << " active)" << std::endl
+              << "Number of cycles: " << NumberOfSamplesCollected << std::endl
+              << "Number of commands processed: " << NumberOfCommands << std::endl
+              << "ProcessQueuedCommands per cycle" << std::endl
+              << " avg (us) : " << average / cmn_us << std::endl
+              << " min (us) : " << min / cmn_us << std::endl
+              << " max (us) : " << max / cmn_us << std::endl;
+}
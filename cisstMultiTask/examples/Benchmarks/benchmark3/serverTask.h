@@ -0,0 +1,58 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#ifndef _serverTask_h
+#define _serverTask_h
+
+#include <cisstVector/vctDynamicVector.h>
+#include <cisstMultiTask/mtsTaskPeriodic.h>
+
+class serverTask: public mtsTaskPeriodic {
+
+    CMN_DECLARE_SERVICES(CMN_NO_DYNAMIC_CREATION, CMN_LOG_LOD_RUN_ERROR);
+
+protected:
+    void Write(const mtsDouble & value);
+
+    size_t NumberOfSamplesSkipped;
+    size_t NumberOfSamplesCollected;
+    size_t NumberOfCommands;
+    bool BenchmarkCompleted;
+    bool SharedMailBox;
+
+    // time spent in ProcessQueuedCommands for each Run
+    vctDynamicVector<double> Results;
+
+public:
+    serverTask(const std::string & taskName, double period, bool sharedMailBox);
+    ~serverTask() {};
+
+    void Configure(const std::string & CMN_UNUSED(filename)) {};
+    void Startup(void) {};
+    void Run(void);
+    void Cleanup(void) {};
+
+    bool IsBenchmarkCompleted(void) const;
+    void ShowResults(void) const;
+};
+
+CMN_DECLARE_SERVICES_INSTANTIATION(serverTask);
+
+#endif // _serverTask_h
@@ -0,0 +1,41 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#ifndef _configuration_h
+#define _configuration_h
+
+#include <cisstCommon/cmnUnits.h>
+
+// server period and client period for latency measurements
+const double confServerPeriod = 1.0 * cmn_ms;
+const double confClientPeriod = 1.0 * cmn_ms;
+
+// port used by socket proxies, client connects to localhost
+const unsigned short confPort = 12345;
+
+// size of prmStateJoint sent over the socket
+const size_t confNumberOfJoints = 7;
+
+// number of reads for latency (at confClientPeriod) and throughput (back to back)
+const size_t confNumberOfSamples = 5000;
+const size_t confNumberOfSamplesToSkip = 500;
+const size_t confNumberOfBurstMessages = 20000;
+
+#endif // _configuration_h
@@ -0,0 +1,147 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+/*
+  Benchmark for the socket proxies (mtsSocketProxyServer and
+  mtsSocketProxyClient) using a loopback connection in a single
+  process.  A prmStateJoint is read through the proxies at a fixed
+  rate to measure the round trip latency, then as fast as possible to
+  measure the number of messages per second.  Usage:
+
+  mtsExBenchmark4
+*/
+
+#include <cisstCommon/cmnConstants.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstOSAbstraction/osaSleep.h>
+#include <cisstMultiTask/mtsManagerLocal.h>
+#include <cisstMultiTask/mtsInterfaceRequired.h>
+#include <cisstMultiTask/mtsSocketProxyServer.h>
+#include <cisstMultiTask/mtsSocketProxyClient.h>
+
+#include <algorithm>
+
+#include "serverTask.h"
+#include "configuration.h"
+
+int main(void)
+{
+    // log configuration
+    cmnLogger::SetMask(CMN_LOG_ALLOW_ALL);
+    cmnLogger::AddChannel(std::cout, CMN_LOG_ALLOW_ERRORS_AND_WARNINGS);
+
+    mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
+
+    // server side
+    serverTask * server = new serverTask("Server", confServerPeriod);
+    componentManager->AddComponent(server);
+    mtsSocketProxyServer * serverProxy = new mtsSocketProxyServer("ServerProxy", "Server", "Provided", confPort);
+    componentManager->AddComponent(serverProxy);
+    if (!componentManager->Connect("ServerProxy", "Required", "Server", "Provided")) {
+        CMN_LOG_INIT_ERROR << "Connect failed for server proxy" << std::endl;
+        return 1;
+    }
+
+    // start the server side first, the client proxy queries the server
+    // proxy when it is constructed
+    componentManager->CreateAll();
+    componentManager->WaitForStateAll(mtsComponentState::READY);
+    componentManager->StartAll();
+    componentManager->WaitForStateAll(mtsComponentState::ACTIVE);
+
+    // client side, commands are sent from the main thread
+    mtsSocketProxyClient * clientProxy = new mtsSocketProxyClient("ClientProxy", "localhost", confPort);
+    componentManager->AddComponent(clientProxy);
+    mtsComponent * client = new mtsComponent("Client");
+    mtsFunctionRead getStateJoint;
+    mtsFunctionWrite setPositionGoal;
+    mtsInterfaceRequired * required = client->AddInterfaceRequired("Required");
+    required->AddFunction("GetStateJoint", getStateJoint);
+    required->AddFunction("SetPositionGoal", setPositionGoal);
+    componentManager->AddComponent(client);
+    if (!componentManager->Connect("Client", "Required", "ClientProxy", "Provided")) {
+        CMN_LOG_INIT_ERROR << "Connect failed for client" << std::endl;
+        return 1;
+    }
+
+    clientProxy->CreateAndWait(2.0 * cmn_s);
+    client->CreateAndWait(2.0 * cmn_s);
+    clientProxy->StartAndWait(2.0 * cmn_s);
+    client->StartAndWait(2.0 * cmn_s);
+
+    prmStateJoint stateJoint;
+    mtsExecutionResult result;
+    size_t index;
+
+    // latency, one blocking read per period
+    std::vector<double> latencies;
+    latencies.reserve(confNumberOfSamples);
+    size_t numberOfErrors = 0;
+    for (index = 0; index < (confNumberOfSamplesToSkip + confNumberOfSamples); ++index) {
+        const double start = osaGetTime();
+        result = getStateJoint(stateJoint);
+        const double elapsed = osaGetTime() - start;
+        if (!result.IsOK()) {
+            ++numberOfErrors;
+        } else if (index >= confNumberOfSamplesToSkip) {
+            latencies.push_back(elapsed);
+        }
+        if (elapsed < confClientPeriod) {
+            osaSleep(confClientPeriod - elapsed);
+        }
+        // non blocking write, uses the same serialization path
+        setPositionGoal(stateJoint);
+    }
+
+    // throughput, blocking reads back to back
+    const double burstStart = osaGetTime();
+    for (index = 0; index < confNumberOfBurstMessages; ++index) {
+        result = getStateJoint(stateJoint);
+        if (!result.IsOK()) {
+            ++numberOfErrors;
+        }
+    }
+    const double burstElapsed = osaGetTime() - burstStart;
+
+    std::cout << "Socket proxy loopback, prmStateJoint with " << confNumberOfJoints << " joints" << std::endl;
+    if (!latencies.empty()) {
+        std::sort(latencies.begin(), latencies.end());
+        double sum = 0.0;
+        for (index = 0; index < latencies.size(); ++index) {
+            sum += latencies[index];
+        }
+        const size_t size = latencies.size();
+        std::cout << "Latency at " << 1.0 / confClientPeriod << " Hz (" << size << " samples) in micro seconds" << std::endl
+                  << " - min:   " << latencies.front() / cmn_us << std::endl
+                  << " - avg:   " << (sum / size) / cmn_us << std::endl
+                  << " - 50%:   " << latencies[size / 2] / cmn_us << std::endl
+                  << " - 99%:   " << latencies[(size * 99) / 100] / cmn_us << std::endl
+                  << " - 99.9%: " << latencies[(size * 999) / 1000] / cmn_us << std::endl
+                  << " - max:   " << latencies.back() / cmn_us << std::endl;
+    }
+    std::cout << "Throughput: " << confNumberOfBurstMessages / burstElapsed << " reads per second" << std::endl
+              << "Errors: " << numberOfErrors << std::endl;
+
+    componentManager->KillAll();
+    componentManager->WaitForStateAll(mtsComponentState::FINISHED, 2.0 * cmn_s);
+    componentManager->Cleanup();
+
+    return 0;
+}
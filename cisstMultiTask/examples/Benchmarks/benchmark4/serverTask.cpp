@@ -0,0 +1,56 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include <cisstMultiTask/mtsInterfaceProvided.h>
+
+#include "serverTask.h"
+#include "configuration.h"
+
+CMN_IMPLEMENT_SERVICES(serverTask);
+
+serverTask::serverTask(const std::string & taskName, double period):
+    mtsTaskPeriodic(taskName, period, false, 5000)
+{
+    StateJoint.SetSize(confNumberOfJoints);
+    StateJoint.Position().SetAll(0.0);
+    StateJoint.Velocity().SetAll(0.0);
+    StateJoint.Effort().SetAll(0.0);
+    StateJoint.SetValid(true);
+    StateTable.AddData(StateJoint, "StateJoint");
+
+    mtsInterfaceProvided * providedInterface = AddInterfaceProvided("Provided");
+    if (providedInterface) {
+        providedInterface->AddCommandReadState(StateTable, StateJoint, "GetStateJoint");
+        providedInterface->AddCommandWrite(&serverTask::SetPositionGoal, this, "SetPositionGoal");
+    }
+}
+
+void serverTask::SetPositionGoal(const prmStateJoint & goal)
+{
+    if (goal.Position().size() == StateJoint.Position().size()) {
+        StateJoint.Position().Assign(goal.Position());
+    }
+}
+
+void serverTask::Run(void)
+{
+    ProcessQueuedCommands();
+    StateJoint.Velocity().Add(1.0);
+}
@@ -5,7 +5,7 @@
   Author(s):  Min Yang Jung, Anton Deguet
   Created on: 2009-02-25
 
-  (C) Copyright 2009-2025 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -51,7 +51,8 @@ public:
         COLLECTOR_FILE_FORMAT_PLAIN_TEXT,
         COLLECTOR_FILE_FORMAT_BINARY,
         COLLECTOR_FILE_FORMAT_CSV,
-        COLLECTOR_FILE_FORMAT_UNDEFINED
+        COLLECTOR_FILE_FORMAT_UNDEFINED,
+        COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR // only supported by mtsCollectorState
     } CollectorFileFormat;
 
     typedef enum {
@@ -232,7 +233,7 @@ public:
     virtual void SetOutputToDefault(void);
 
     /*! Closes the output file stream */
-    void CloseOutput(void);
+    virtual void CloseOutput(void);
 
     /*! Get the name of log file currently being written. */
     inline const std::string & GetOutputFileName(void) const {
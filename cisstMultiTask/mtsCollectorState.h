@@ -5,7 +5,7 @@
   Author(s):  Min Yang Jung, Anton Deguet
   Created on: 2009-03-20
 
-  (C) Copyright 2009-2025 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -23,6 +23,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsCollectorBase.h>
 #include <cisstMultiTask/mtsCommandVoid.h>
 #include <cisstMultiTask/mtsStateTable.h>
+#include <cisstMultiTask/mtsCollectorStateColumnarWriter.h>
 
 #include <string>
 
@@ -34,9 +35,17 @@ http://www.cisst.org/cisst/license.txt.
 
   This class provides a way to collect data in the state table without
   loss and make a log file. The type of a log file can be plain text
-  (ascii), csv, or binary.  A state table of which data is to be
+  (ascii), csv, binary or columnar binary.  A state table of which data is to be
   collected can be specified in the constructor.  This is intended for
   future usage where a task can have more than two state tables.
+
+  The columnar binary format (COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR)
+  is meant for high frequency collection of many signals.  Each
+  signal is stored as one or more columns of doubles (see
+  cmnGenericObject::Scalar) in preallocated pages which are written to
+  disk by a background thread (see mtsCollectorStateColumnarWriter).
+  The file header is self-describing and the file can be converted to
+  CSV using ConvertBinaryToText.
 */
 class CISST_EXPORT mtsCollectorState : public mtsCollectorBase
 {
@@ -67,6 +76,16 @@ class CISST_EXPORT mtsCollectorState : public mtsCollectorBase
     /*! A stride value for data collector to skip several records. */
     size_t SamplingInterval;
 
+    /*! Writer and settings for columnar binary format. */
+    mtsCollectorStateColumnarWriter ColumnarWriter;
+    size_t ColumnarPageSize;
+    size_t ColumnarNumberOfPages;
+    bool ColumnarDirectIO;
+
+    /*! Number of columns used by each registered signal in the
+      columnar binary format. */
+    std::vector<size_t> ColumnarNumberOfScalars;
+
     /*! Pointers to the target component and the target state table. */
     mtsComponent * TargetComponent;
     mtsStateTable * TargetStateTable;
@@ -95,6 +114,20 @@ class CISST_EXPORT mtsCollectorState : public mtsCollectorBase
                              const size_t startIdx,
                              const size_t endIdx);
 
+    /*! Fetch state table data for columnar binary format. */
+    bool FetchStateTableDataColumnar(const mtsStateTable * table,
+                                     const size_t startIdx,
+                                     const size_t endIdx);
+
+    /*! Create the columnar binary file and write its header. */
+    bool OpenColumnarOutput(void);
+
+    /*! Convert a columnar binary file, the header first line has
+      already been read. */
+    static bool ConvertColumnarToText(std::ifstream & inFile,
+                                      std::ofstream & outFile,
+                                      const char delimiter);
+
     /*! Print out the signal names which are being collected. */
     void PrintHeader(const CollectorFileFormat & fileFormat);
 
@@ -164,7 +197,19 @@ public:
       component. */
     bool Disconnect(void);
 
-    /*! Convert a binary log file into a plain text one. */
+    /*! Settings for the columnar binary format.  These will be used
+      for the next file opened.  The page size is rounded up to a
+      multiple of 4096 bytes.  Direct IO bypasses the OS file cache
+      and is only supported on Linux. */
+    void SetColumnarOptions(const size_t pageSize,
+                            const size_t numberOfPages,
+                            const bool directIO = false);
+
+    /*! Closes the output file, including columnar binary files. */
+    void CloseOutput(void) override;
+
+    /*! Convert a binary log file into a plain text one.  This
+      supports both the binary and columnar binary formats. */
     static bool ConvertBinaryToText(const std::string sourceBinaryLogFileName,
                                     const std::string targetPlainTextLogFileName,
                                     const char delimiter = ',');
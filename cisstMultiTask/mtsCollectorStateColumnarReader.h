@@ -0,0 +1,189 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _mtsCollectorStateColumnarReader_h
+#define _mtsCollectorStateColumnarReader_h
+
+#include <cisstMultiTask/mtsCollectorStateColumnarWriter.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+// Always include last
+#include <cisstMultiTask/mtsExport.h>
+
+/*!
+  \ingroup cisstMultiTask
+
+  Reader for files created by mtsCollectorState using the columnar
+  binary format (see mtsCollectorStateColumnarFormat).  The file is
+  mapped in memory so opening a file only reads the header and the
+  page headers, data is loaded by the OS on demand.  Data is never
+  copied, GetTicks and GetColumn return pointers in the mapped file.
+
+  Since each page contains a segment of all the columns, the data for
+  a given column is contiguous within a page only.  To iterate
+  efficiently over all the rows, use the methods taking a page index
+  (GetNumberOfPages, GetNumberOfRowsInPage, GetTicks and GetColumn).
+  For random access, use the methods taking a row index (GetTick and
+  GetValue).
+
+  Rows can be found based on ticks or on the value of any column
+  (e.g. "Toc") as long as the values are monotonic, using a binary
+  search (see FindRowByTicks, FindRow and FindRowByTime).
+
+  \code
+  mtsCollectorStateColumnarReader reader;
+  reader.Open("StateDataCollection-robot-StateTable-2026-10-18.ccol");
+  const size_t column = reader.GetColumnIndex("Position");
+  for (size_t row = reader.FindRowByTime(10.0); row < reader.GetNumberOfRows(); ++row) {
+      std::cout << reader.GetValue(row, column) << std::endl;
+  }
+  \endcode
+*/
+class CISST_EXPORT mtsCollectorStateColumnarReader
+{
+    /*! Mapped memory and size. */
+    const char * Memory;
+    size_t FileSize;
+    std::string FileName;
+
+    /*! OS specific handles for the mapped file. */
+    void * FileHandle;
+    void * MappingHandle;
+
+    /*! Layout, from the header. */
+    size_t HeaderSize;
+    size_t PageSize;
+    size_t RowsPerPage;
+    size_t NumberOfColumns;
+
+    /*! Column names and header key value pairs. */
+    std::vector<std::string> ColumnNames;
+    typedef std::map<std::string, std::string> HeaderValuesType;
+    HeaderValuesType HeaderValues;
+
+    /*! Pages and row index for the first row of each page.  If all
+      pages but the last one are full, the page for a given row is
+      computed directly, otherwise a binary search is used. */
+    std::vector<const char *> Pages;
+    std::vector<size_t> FirstRows;
+    size_t NumberOfRows;
+    bool AllPagesFull;
+
+    /*! Parse header and build page index. */
+    bool ParseHeader(void);
+    bool IndexPages(void);
+
+    /*! Find page containing a given row and row index in page. */
+    void PageForRow(const size_t row, size_t & page, size_t & rowInPage) const;
+
+    /*! Generic binary search on monotonic data. */
+    template <class _valueType, class _accessorType>
+    size_t LowerBound(const _valueType & value, _accessorType accessor) const;
+
+    // copy not allowed
+    mtsCollectorStateColumnarReader(const mtsCollectorStateColumnarReader &);
+    mtsCollectorStateColumnarReader & operator = (const mtsCollectorStateColumnarReader &);
+
+public:
+    /*! Value returned when a column can't be found. */
+    static const size_t InvalidIndex;
+
+    mtsCollectorStateColumnarReader(void);
+    ~mtsCollectorStateColumnarReader();
+
+    /*! Map the file in memory, parse the header and index pages. */
+    bool Open(const std::string & fileName);
+
+    /*! Unmap the file.  All pointers previously returned become
+      invalid. */
+    void Close(void);
+
+    /*! Check if the file is open. */
+    inline bool IsOpen(void) const {
+        return (Memory != 0);
+    }
+
+    /*! Number of data columns, ticks not included. */
+    inline size_t GetNumberOfColumns(void) const {
+        return NumberOfColumns;
+    }
+
+    /*! Total number of rows. */
+    inline size_t GetNumberOfRows(void) const {
+        return NumberOfRows;
+    }
+
+    /*! Name of a data column. */
+    const std::string & GetColumnName(const size_t column) const;
+
+    /*! Find the column index using its name.  The name can either be
+      the full name found in the header or the name without the type
+      suffix, e.g. "Toc" for "Toc:{d}".  Returns InvalidIndex if the
+      column is not found. */
+    size_t GetColumnIndex(const std::string & name) const;
+
+    /*! Value from the header, e.g. "component", "table", "date" or
+      "time-origin".  Returns an empty string if the key is not
+      found. */
+    std::string GetHeaderValue(const std::string & key) const;
+
+    /*! Zero-copy access per page. */
+    //@{
+    inline size_t GetNumberOfPages(void) const {
+        return Pages.size();
+    }
+
+    size_t GetNumberOfRowsInPage(const size_t page) const;
+
+    inline const unsigned long long * GetTicks(const size_t page) const {
+        return reinterpret_cast<const unsigned long long *>(Pages[page] + mtsCollectorStateColumnarFormat::TicksOffset());
+    }
+
+    inline const double * GetColumn(const size_t page, const size_t column) const {
+        return reinterpret_cast<const double *>(Pages[page] + mtsCollectorStateColumnarFormat::ColumnOffset(RowsPerPage, column));
+    }
+    //@}
+
+    /*! Random access per row.  Rows are not checked against
+      GetNumberOfRows. */
+    //@{
+    unsigned long long GetTick(const size_t row) const;
+
+    double GetValue(const size_t row, const size_t column) const;
+    //@}
+
+    /*! Find first row with ticks greater or equal to ticks provided.
+      Returns GetNumberOfRows if no row is found. */
+    size_t FindRowByTicks(const unsigned long long ticks) const;
+
+    /*! Find first row with value greater or equal to value provided
+      for a given column.  The values in the column have to be
+      monotonic (e.g. "Toc" or any timestamp).  Returns
+      GetNumberOfRows if no row is found. */
+    size_t FindRow(const size_t column, const double value) const;
+
+    /*! Find first row with "Toc" greater or equal to time provided.
+      Returns GetNumberOfRows if no row is found or if "Toc" was not
+      collected. */
+    size_t FindRowByTime(const double time) const;
+};
+
+#endif // _mtsCollectorStateColumnarReader_h
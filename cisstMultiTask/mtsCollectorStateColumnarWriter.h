@@ -0,0 +1,250 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _mtsCollectorStateColumnarWriter_h
+#define _mtsCollectorStateColumnarWriter_h
+
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaThreadSignal.h>
+#include <cisstMultiTask/mtsQueue.h>
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Always include last
+#include <cisstMultiTask/mtsExport.h>
+
+/*!
+  \ingroup cisstMultiTask
+
+  Description of the columnar binary format used by mtsCollectorState
+  (see mtsCollectorBase::COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR).
+
+  The file starts with a plain text header, padded with '\\0' to a
+  multiple of PageAlignment.  The first two lines are fixed:
+
+  \code
+  cisst-columnar 1
+  header-size 000000000004096
+  \endcode
+
+  followed by one "key value" pair per line: page-size, rows-per-page,
+  columns (number of data columns, ticks excluded), component, table,
+  date and time-origin.  The header then lists the name of each column
+  ("column Ticks" first) and ends with "end".
+
+  The header is followed by pages of page-size bytes.  Each page
+  starts with a PageHeader, followed by the ticks (rows-per-page
+  unsigned long long) and then each data column (rows-per-page doubles
+  per column).  Only the first PageHeader::NumberOfRows rows of a page
+  are valid.  Since all pages have the same layout, a column can be
+  accessed in place, e.g. after mapping the file in memory.
+*/
+class CISST_EXPORT mtsCollectorStateColumnarFormat
+{
+public:
+    /*! Header at the beginning of each page. */
+    struct PageHeader {
+        unsigned int Magic;
+        unsigned int NumberOfRows;
+        unsigned long long PageIndex;
+    };
+
+    /*! Magic number for each page. */
+    static const unsigned int PageMagic = 0x43504731; // "CPG1"
+
+    /*! First line of the header. */
+    static const char * FileMagic(void);
+
+    /*! Alignment of pages, both in memory and in the file.  The page
+      size is always rounded up to a multiple of this value to allow
+      direct IO. */
+    static const size_t PageAlignment = 4096;
+
+    /*! Round size to next multiple of PageAlignment. */
+    static size_t AlignedSize(const size_t size);
+
+    /*! Compute the number of rows that fit in a page. */
+    static size_t RowsPerPage(const size_t pageSize, const size_t numberOfColumns);
+
+    /*! Offset in bytes of the ticks in a page. */
+    static size_t TicksOffset(void);
+
+    /*! Offset in bytes of a given data column in a page. */
+    static size_t ColumnOffset(const size_t rowsPerPage, const size_t columnIndex);
+};
+
+
+/*!
+  \ingroup cisstMultiTask
+
+  Writer for the columnar binary format (see
+  mtsCollectorStateColumnarFormat).  Rows are added to preallocated
+  pages and full pages are written to disk by a background thread so
+  the caller never waits on disk IO unless all pages are in use.  The
+  pages are passed to the writer thread and returned through lock-free
+  single producer, single consumer queues (mtsQueue).
+
+  The writer is used by mtsCollectorState but doesn't depend on it.
+  Typical use:
+
+  \code
+  writer.Open(fileName, header, numberOfColumns);
+  size_t count = writer.BeginRows(numberOfRows);
+  // fill writer.Ticks()[0 .. count - 1] and writer.Column(i)[0 .. count - 1]
+  writer.EndRows(count);
+  ...
+  writer.Close();
+  \endcode
+*/
+class CISST_EXPORT mtsCollectorStateColumnarWriter
+{
+    /*! Size and number of pages. */
+    size_t PageSize;
+    size_t NumberOfPages;
+    size_t NumberOfColumns;
+    size_t RowsPerPage;
+
+    /*! Memory for all pages, aligned on
+      mtsCollectorStateColumnarFormat::PageAlignment. */
+    char * Memory;
+
+    /*! Page currently filled and number of rows already used. */
+    char * CurrentPage;
+    size_t CurrentRow;
+    unsigned long long PageCounter;
+
+    /*! Pages ready to be written (caller to writer thread) and pages
+      available (writer thread to caller). */
+    mtsQueue<char *> FullPages;
+    mtsQueue<char *> FreePages;
+
+    /*! Signals used to wake up the writer thread and the caller. */
+    osaThreadSignal FullPageSignal;
+    osaThreadSignal FreePageSignal;
+
+    /*! Background thread. */
+    osaThread Thread;
+    bool ThreadRunning;
+    std::atomic<bool> StopRequested;
+    std::atomic<bool> WriteError;
+
+    /*! File handles, either a POSIX file descriptor (allows direct
+      IO) or a C stream, depending on the OS. */
+    int FileDescriptor;
+    std::FILE * File;
+    std::string FileName;
+    bool DirectIO;
+
+    /*! Statistics. */
+    std::atomic<size_t> PagesWritten;
+    size_t WaitsForFreePage;
+
+    /*! Get a free page, waits for the writer thread if needed. */
+    bool GetFreePage(void);
+
+    /*! Send current page to the writer thread. */
+    void SendCurrentPage(void);
+
+    /*! Write a block of memory to the file. */
+    bool WriteToFile(const char * buffer, const size_t size);
+
+    /*! Main loop for the writer thread. */
+    void * WriterThread(void * argument);
+
+    /*! Release all resources. */
+    void Cleanup(void);
+
+    // copy not allowed
+    mtsCollectorStateColumnarWriter(const mtsCollectorStateColumnarWriter &);
+    mtsCollectorStateColumnarWriter & operator = (const mtsCollectorStateColumnarWriter &);
+
+public:
+    mtsCollectorStateColumnarWriter(void);
+    ~mtsCollectorStateColumnarWriter();
+
+    /*! Create the file, write the header and start the writer thread.
+      The header provided should contain the "key value" lines
+      described in mtsCollectorStateColumnarFormat, excluding the
+      first two lines (magic and header size) and the page-size,
+      rows-per-page and columns lines which are added by this
+      method.  The page size is rounded up to a multiple of
+      mtsCollectorStateColumnarFormat::PageAlignment.  Direct IO is
+      only supported on Linux, it is ignored on other OSs. */
+    bool Open(const std::string & fileName,
+              const std::string & header,
+              const size_t numberOfColumns,
+              const size_t pageSize = 1024 * 1024,
+              const size_t numberOfPages = 8,
+              const bool directIO = false);
+
+    /*! Check if the file is open. */
+    inline bool IsOpen(void) const {
+        return ThreadRunning;
+    }
+
+    /*! Reserve space for up to numberOfRows rows in the current page.
+      Returns the number of rows available, which can be lower than
+      requested if the current page is almost full.  Returns 0 if the
+      file is not open or a write error occurred. */
+    size_t BeginRows(const size_t numberOfRows);
+
+    /*! Pointer on the ticks for the rows reserved by BeginRows. */
+    inline unsigned long long * Ticks(void) {
+        return reinterpret_cast<unsigned long long *>(CurrentPage + mtsCollectorStateColumnarFormat::TicksOffset())
+            + CurrentRow;
+    }
+
+    /*! Pointer on a data column for the rows reserved by BeginRows. */
+    inline double * Column(const size_t columnIndex) {
+        return reinterpret_cast<double *>(CurrentPage + mtsCollectorStateColumnarFormat::ColumnOffset(RowsPerPage, columnIndex))
+            + CurrentRow;
+    }
+
+    /*! Commit rows filled after BeginRows.  If the page is full, it
+      is sent to the writer thread. */
+    void EndRows(const size_t numberOfRows);
+
+    /*! Send the current page to the writer thread even if it is not
+      full.  This will use a full page on disk. */
+    void Flush(void);
+
+    /*! Flush, wait for the writer thread to write all pages and close
+      the file. */
+    bool Close(void);
+
+    /*! Number of rows in a page, valid after Open. */
+    inline size_t GetRowsPerPage(void) const {
+        return RowsPerPage;
+    }
+
+    /*! Number of pages written so far. */
+    inline size_t GetNumberOfPagesWritten(void) const {
+        return PagesWritten.load();
+    }
+
+    /*! Number of times the caller had to wait for a free page,
+      i.e. the disk was too slow. */
+    inline size_t GetNumberOfWaitsForFreePage(void) const {
+        return WaitsForFreePage;
+    }
+};
+
+#endif // _mtsCollectorStateColumnarWriter_h
@@ -6,7 +6,7 @@
   Author(s):  Ankur Kapoor, Anton Deguet
   Created on: 2006-05-02
 
-  (C) Copyright 2006-2009 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -37,14 +37,19 @@ http://www.cisst.org/cisst/license.txt.
 #include <iostream>
 #include <sstream>
 
+// Always include last
+#include <cisstMultiTask/mtsExport.h>
+
 /*!
   \ingroup cisstMultiTask
 */
-class mtsCommandBase {
+class CISST_EXPORT mtsCommandBase {
 
 private:
-    /*! Private copy constructor to prevent copies */
+    /*! Private copy constructor and assignment operator to prevent
+      copies, the command owns its statistics recorder */
     inline mtsCommandBase(const mtsCommandBase & CMN_UNUSED(other));
+    inline mtsCommandBase & operator = (const mtsCommandBase & CMN_UNUSED(other));
 
 protected:
     /*! Name used for the command.  The name is provided to the
@@ -57,21 +62,28 @@ protected:
       owned by an object being deleted. */
     bool EnableFlag;
 
+    /*! Optional statistics, only used for queued commands (see
+      mtsInterfaceProvided::EnableCommandStatistics and
+      mtsMailBox::ExecuteNext).  The command owns the recorder. */
+    mtsCommandStatisticsRecorder * StatisticsRecorder;
+
 public:
     /*! The constructor. Does nothing */
     inline mtsCommandBase(void):
         Name("??"),
-        EnableFlag(true)
+        EnableFlag(true),
+        StatisticsRecorder(0)
     {}
 
     /*! Constructor with command name. */
     inline mtsCommandBase(const std::string & name):
         Name(name),
-        EnableFlag(true)
+        EnableFlag(true),
+        StatisticsRecorder(0)
     {}
 
-    /*! The destructor. Does nothing */
-    virtual ~mtsCommandBase() {}
+    /*! The destructor, deletes the statistics recorder if any */
+    virtual ~mtsCommandBase();
 
     /*! For debugging. Generate a human readable output for the
       command object */
@@ -116,6 +128,17 @@ public:
     inline const std::string & GetName(void) const {
         return this->Name;
     }
+
+    /*! Set and access the statistics recorder.  The recorder should
+      be set before the command is used and the command takes
+      ownership of it. */
+    //@{
+    void SetStatisticsRecorder(mtsCommandStatisticsRecorder * recorder);
+
+    inline mtsCommandStatisticsRecorder * GetStatisticsRecorder(void) const {
+        return this->StatisticsRecorder;
+    }
+    //@}
 };
 
 
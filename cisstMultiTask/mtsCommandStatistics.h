@@ -0,0 +1,202 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+/*!
+  \file
+  \brief Statistics for queued commands
+*/
+
+#ifndef _mtsCommandStatistics_h
+#define _mtsCommandStatistics_h
+
+#include <cisstMultiTask/mtsGenericObject.h>
+#include <cisstMultiTask/mtsHistogramRecorder.h>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+// Always include last
+#include <cisstMultiTask/mtsExport.h>
+
+/*!
+  \ingroup cisstMultiTask
+
+  Statistics for the queued commands of a provided interface, see
+  mtsInterfaceProvided::EnableCommandStatistics.  This is the type
+  returned by the read command "GetCommandStatistics".
+
+  Each queued command of each end-user interface (i.e. per client and
+  per command) has its own entry.  For each entry, the time spent in
+  the mailbox (from the moment the command is queued by the client to
+  the moment the component starts executing it) and the execution
+  time are recorded.  Durations are accumulated in histograms with
+  logarithmic bins, bin 0 is for durations under 1 micro-second and
+  bin i is for durations between 2^(i-1) and 2^i micro-seconds.  The
+  last bin also contains all longer durations.
+
+  The number of commands executed per call to
+  mtsInterfaceProvided::ProcessMailBoxes, i.e. usually per cycle of
+  the component, is also provided.
+*/
+class CISST_EXPORT mtsCommandStatistics: public mtsGenericObject
+{
+    CMN_DECLARE_SERVICES(CMN_DYNAMIC_CREATION, CMN_LOG_ALLOW_DEFAULT);
+
+public:
+    /*! Base type */
+    typedef mtsGenericObject BaseType;
+
+    /*! Number of bins used for histograms. */
+    enum {NUMBER_OF_BINS = 24};
+
+    /*! Find bin for a given duration in seconds. */
+    static size_t Bin(const double duration);
+
+    /*! Upper bound of a bin in seconds. */
+    static double BinUpperBound(const size_t bin);
+
+    /*! Statistics for one command used by one client. */
+    class CISST_EXPORT CommandType {
+    public:
+        CommandType(void);
+
+        std::string UserName;
+        std::string CommandName;
+        unsigned long long NumberOfExecutions;
+        double QueueTimeSum;
+        double QueueTimeMax;
+        double ExecutionTimeSum;
+        double ExecutionTimeMax;
+        unsigned long long QueueTimeHistogram[NUMBER_OF_BINS];
+        unsigned long long ExecutionTimeHistogram[NUMBER_OF_BINS];
+
+        double QueueTimeAvg(void) const;
+        double ExecutionTimeAvg(void) const;
+
+        /*! Estimate percentiles using the histograms, e.g. 0.99.  The
+          value returned is the upper bound of the bin containing the
+          percentile. */
+        //@{
+        double QueueTimePercentile(const double percentile) const;
+        double ExecutionTimePercentile(const double percentile) const;
+        //@}
+    };
+
+    typedef std::vector<CommandType> CommandsType;
+
+    /*! Statistics for all queued commands of all clients. */
+    CommandsType Commands;
+
+    /*! Number of calls to ProcessMailBoxes. */
+    unsigned long long NumberOfCycles;
+
+    /*! Total number of commands executed by ProcessMailBoxes. */
+    unsigned long long NumberOfCommands;
+
+    /*! Number of commands executed during the last call to
+      ProcessMailBoxes and maximum for a single call. */
+    unsigned long long CommandsLastCycle;
+    unsigned long long CommandsMaxPerCycle;
+
+    mtsCommandStatistics(void);
+    inline ~mtsCommandStatistics() {}
+
+    /*! Index of the entry with the highest total execution time,
+      i.e. the client and command using most of the component's time.
+      Returns Commands.size() if there is no entry. */
+    size_t MostExpensiveCommand(void) const;
+
+    /*! Human readable text output */
+    void ToStream(std::ostream & outputStream) const override;
+
+    /*! To stream raw data, one entry per client and command. */
+    void ToStreamRaw(std::ostream & outputStream, const char delimiter = ' ',
+                     bool headerOnly = false, const std::string & headerPrefix = "") const override;
+
+    /*! Binary serialization */
+    void SerializeRaw(std::ostream & outputStream) const override;
+
+    /*! Binary deserialization */
+    void DeSerializeRaw(std::istream & inputStream) override;
+};
+
+CMN_DECLARE_SERVICES_INSTANTIATION(mtsCommandStatistics);
+
+
+/*!
+  \ingroup cisstMultiTask
+
+  Recorder for the statistics of a queued command.  Record is called
+  by the thread executing the mailbox (single writer) while Get can be
+  called from any thread, see mtsHistogramRecorder.  Recorders are
+  created by the provided interface and owned by the queued command
+  (see mtsCommandBase).
+*/
+class CISST_EXPORT mtsCommandStatisticsRecorder
+{
+    typedef mtsHistogramRecorder<mtsCommandStatistics> HistogramRecorderType;
+    HistogramRecorderType QueueTime;
+    HistogramRecorderType ExecutionTime;
+
+    // copy not allowed
+    mtsCommandStatisticsRecorder(const mtsCommandStatisticsRecorder &);
+    mtsCommandStatisticsRecorder & operator = (const mtsCommandStatisticsRecorder &);
+
+public:
+    mtsCommandStatisticsRecorder(void);
+
+    /*! Record one execution, durations in seconds.  Single writer
+      only. */
+    void Record(const double queueTime, const double executionTime);
+
+    /*! Copy statistics, can be called from any thread.  User and
+      command names are not modified. */
+    void Get(mtsCommandStatistics::CommandType & command) const;
+};
+
+
+/*!
+  \ingroup cisstMultiTask
+
+  Recorder for the number of commands executed per call to
+  mtsInterfaceProvided::ProcessMailBoxes.  Same threading model as
+  mtsCommandStatisticsRecorder.
+*/
+class CISST_EXPORT mtsCommandStatisticsCycleRecorder
+{
+    std::atomic<unsigned long long> NumberOfCycles;
+    std::atomic<unsigned long long> NumberOfCommands;
+    std::atomic<unsigned long long> CommandsLastCycle;
+    std::atomic<unsigned long long> CommandsMaxPerCycle;
+
+    // copy not allowed
+    mtsCommandStatisticsCycleRecorder(const mtsCommandStatisticsCycleRecorder &);
+    mtsCommandStatisticsCycleRecorder & operator = (const mtsCommandStatisticsCycleRecorder &);
+
+public:
+    mtsCommandStatisticsCycleRecorder(void);
+
+    /*! Record one cycle.  Single writer only. */
+    void Record(const size_t numberOfCommands);
+
+    /*! Copy cycle statistics, can be called from any thread. */
+    void Get(mtsCommandStatistics & statistics) const;
+};
+
+#endif // _mtsCommandStatistics_h
@@ -5,7 +5,7 @@
   Author(s):  Peter Kazanzides
   Created on: 2010-09-07
 
-  (C) Copyright 2010-2023 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2010-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -76,6 +76,13 @@ protected:
     std::string GetStateInUDrawGraphFormat(const mtsComponentState &componentState) const;
     std::string GetConnectionInUDrawGraphFormat(const mtsDescriptionConnection &connection) const;
 
+    /*! Display statistics for queued commands of all provided
+      interfaces of a component (see
+      mtsInterfaceProvided::EnableCommandStatistics).  This uses the
+      read command "GetCommandStatistics" and is only supported for
+      components in the same process as the viewer. */
+    void ShowCommandStatistics(const std::string & processName, const std::string & componentName);
+
     enum BorderType { BORDER_NONE, BORDER_SINGLE, BORDER_DOUBLE };
     void ChangeComponentBorder(const std::string &processName, const std::string &componentName, BorderType border);
 
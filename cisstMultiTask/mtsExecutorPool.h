@@ -0,0 +1,151 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+/*!
+  \file
+  \brief Pool of threads used to execute components
+*/
+
+#ifndef _mtsExecutorPool_h
+#define _mtsExecutorPool_h
+
+#include <cisstCommon/cmnGenericObject.h>
+#include <cisstCommon/cmnClassRegisterMacros.h>
+
+#include <atomic>
+#include <vector>
+
+// Always include last
+#include <cisstMultiTask/mtsExport.h>
+
+/*!
+  \ingroup cisstMultiTask
+
+  Fixed size pool of threads used to execute jobs, mostly
+  mtsTaskFromSignal components when the executor pool is enabled in
+  mtsManagerLocal (see mtsManagerLocal::SetExecutorPool).  Instead of
+  having one thread per component, each waiting for a signal, the
+  component is scheduled as a job on the pool every time it would have
+  been woken up (queued command or event).
+
+  Each thread has its own queue of jobs.  A job scheduled from one of
+  the pool's threads (e.g. a component sending a queued command to
+  another pooled component) is added to the queue of the current
+  thread, otherwise jobs are distributed in a round robin fashion.
+  Threads execute jobs from their own queue first (last in, first out
+  to benefit from warm caches) and steal jobs from the other queues
+  (first in, first out) when their queue is empty.  Threads only sleep
+  when all queues are empty.
+
+  A given job is never executed by two threads at the same time.  If a
+  job is scheduled while it is running, it will be executed again once
+  the current execution is over.  If it is scheduled multiple times
+  before it starts, it is executed only once.  This provides the same
+  guarantees as a dedicated thread waiting for a signal.
+
+  Since jobs share threads, they should not block for long periods of
+  time (e.g. blocking commands, long IOs).
+*/
+class CISST_EXPORT mtsExecutorPool: public cmnGenericObject
+{
+    CMN_DECLARE_SERVICES(CMN_NO_DYNAMIC_CREATION, CMN_LOG_ALLOW_DEFAULT);
+
+public:
+    /*! Base class for jobs executed by the pool. */
+    class CISST_EXPORT Job {
+        friend class mtsExecutorPool;
+        /*! Scheduling state, see mtsExecutorPool::Schedule. */
+        std::atomic<int> State;
+    public:
+        Job(void);
+        virtual ~Job() {}
+
+        /*! Method called by one of the pool's threads. */
+        virtual void Execute(void) = 0;
+
+        /*! True if the job is neither queued nor running. */
+        bool IsIdle(void) const;
+    };
+
+protected:
+    class Worker;
+    typedef std::vector<Worker *> WorkersType;
+    WorkersType Workers;
+
+    /*! Used to distribute jobs scheduled from other threads. */
+    std::atomic<size_t> NextWorker;
+
+    /*! Flag used to stop all threads. */
+    std::atomic<bool> Stopping;
+
+    /*! Statistics. */
+    std::atomic<unsigned long long> NumberOfJobsExecuted;
+    std::atomic<unsigned long long> NumberOfJobsStolen;
+
+    /*! Add job to a worker queue and wake up a thread if needed. */
+    void Push(Worker * worker, Job * job);
+
+    /*! Find a job, first in worker's queue then from other queues. */
+    Job * Pop(Worker * worker);
+
+    /*! Execute a job and re-schedule it if needed. */
+    void Run(Worker * worker, Job * job);
+
+    /*! Wake up a sleeping thread, preferably the one given. */
+    void WakeUp(Worker * worker);
+
+    /*! Main loop for each thread. */
+    void * WorkerLoop(Worker * worker);
+
+    // copy not allowed
+    mtsExecutorPool(const mtsExecutorPool &);
+    mtsExecutorPool & operator = (const mtsExecutorPool &);
+
+public:
+    /*! Create the pool and start all threads.  If numberOfThreads is
+      0, the number of threads is set to the number of processors
+      (see osaCPUGetCount) or 2 if it can't be found. */
+    mtsExecutorPool(const size_t numberOfThreads = 0);
+
+    /*! Stop all threads.  Jobs still queued are not executed. */
+    ~mtsExecutorPool();
+
+    /*! Schedule a job.  Thread safe, can be called from any thread
+      including the pool's threads. */
+    void Schedule(Job * job);
+
+    /*! Wait until the job is neither queued nor running, returns
+      false if the job is still scheduled after timeout (in seconds).
+      This must be called before deleting a job that might still be
+      scheduled. */
+    bool WaitForIdle(const Job * job, const double timeout) const;
+
+    /*! Number of threads in the pool. */
+    size_t GetNumberOfThreads(void) const;
+
+    /*! Total number of jobs executed by the pool. */
+    unsigned long long GetNumberOfJobsExecuted(void) const;
+
+    /*! Number of jobs executed by a thread other than the one they
+      were scheduled on. */
+    unsigned long long GetNumberOfJobsStolen(void) const;
+};
+
+CMN_DECLARE_SERVICES_INSTANTIATION(mtsExecutorPool);
+
+#endif // _mtsExecutorPool_h
@@ -5,7 +5,7 @@
   Author(s):	Anton Deguet
   Created on:	2007-10-07
 
-  (C) Copyright 2007-2019 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -55,6 +55,7 @@ typedef enum {MTS_BLOCKING, MTS_NOT_BLOCKING} mtsBlockingType;
 
 // commands
 class mtsCommandBase;
+class mtsCommandStatisticsRecorder;
 
 // void callables and commands
 class mtsCallableVoidBase;
@@ -131,6 +132,7 @@ class mtsTaskContinuous;
 class mtsTaskPeriodic;
 class mtsTaskFromCallback;
 class mtsTaskFromSignal;
+class mtsExecutorPool;
 
 // containers
 class mtsMailBox;
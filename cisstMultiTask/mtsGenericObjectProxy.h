@@ -5,7 +5,7 @@
   Author(s):  Ankur Kapoor, Anton Deguet, Peter Kazanzides
   Created on: 2006-05-05
 
-  (C) Copyright 2006-2025 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -20,6 +20,7 @@ http://www.cisst.org/cisst/license.txt.
 #define _mtsGenericObjectProxy_h
 
 #include <cisstCommon/cmnPortability.h>
+#include <cisstCommon/cmnThrow.h>
 #include <cisstCommon/cmnClassRegister.h>
 #include <cisstCommon/cmnSerializer.h>
 #include <cisstCommon/cmnDeSerializer.h>
@@ -67,6 +68,22 @@ public:
         // Could try the "stream in" operator
         return false;
     }
+    // no scalar available
+    static size_t ScalarNumber(const _elementType & CMN_UNUSED(data)) {
+        return 0;
+    }
+    static bool ScalarNumberIsFixed(const _elementType & CMN_UNUSED(data)) {
+        return true;
+    }
+    static double Scalar(const _elementType & CMN_UNUSED(data), const size_t CMN_UNUSED(index)) {
+        cmnThrow(std::out_of_range("mtsGenericObjectProxy: no scalar for this type"));
+        return 0.0;
+    }
+    static std::string ScalarDescription(const _elementType & CMN_UNUSED(data), const size_t CMN_UNUSED(index),
+                                         const std::string & CMN_UNUSED(userDescription)) {
+        cmnThrow(std::out_of_range("mtsGenericObjectProxy: no scalar for this type"));
+        return "";
+    }
 };
 
 template <typename _elementType>
@@ -93,6 +110,19 @@ public:
         }
         return true;
     }
+    static size_t ScalarNumber(const _elementType & data) {
+        return cmnData<_elementType>::ScalarNumber(data);
+    }
+    static bool ScalarNumberIsFixed(const _elementType & data) {
+        return cmnData<_elementType>::ScalarNumberIsFixed(data);
+    }
+    static double Scalar(const _elementType & data, const size_t index) {
+        return cmnData<_elementType>::Scalar(data, index);
+    }
+    static std::string ScalarDescription(const _elementType & data, const size_t index,
+                                         const std::string & userDescription) {
+        return cmnData<_elementType>::ScalarDescription(data, index, userDescription);
+    }
 };
 
 #ifndef SWIG
@@ -483,6 +513,36 @@ public:
         BaseType::FromStreamRaw(inputStream, delimiter);
         return cmnDataProxy<value_type, cmnData<value_type>::IS_SPECIALIZED>::FromStreamRaw(inputStream, delimiter, this->Data);
     }
+
+    /*! Scalars, starting with the ones from mtsGenericObject
+      (timestamps and valid flag) followed by the ones of the actual
+      data if cmnData is specialized for the actual type. */
+    //@{
+    inline size_t ScalarNumber(void) const override {
+        return BaseType::ScalarNumber()
+            + cmnDataProxy<value_type, cmnData<value_type>::IS_SPECIALIZED>::ScalarNumber(this->Data);
+    }
+
+    inline bool ScalarNumberIsFixed(void) const override {
+        return cmnDataProxy<value_type, cmnData<value_type>::IS_SPECIALIZED>::ScalarNumberIsFixed(this->Data);
+    }
+
+    inline double Scalar(const size_t index) const CISST_THROW(std::out_of_range) override {
+        const size_t baseNumber = BaseType::ScalarNumber();
+        if (index < baseNumber) {
+            return BaseType::Scalar(index);
+        }
+        return cmnDataProxy<value_type, cmnData<value_type>::IS_SPECIALIZED>::Scalar(this->Data, index - baseNumber);
+    }
+
+    inline std::string ScalarDescription(const size_t index, const std::string & userDescription = "") const CISST_THROW(std::out_of_range) override {
+        const size_t baseNumber = BaseType::ScalarNumber();
+        if (index < baseNumber) {
+            return BaseType::ScalarDescription(index, userDescription);
+        }
+        return cmnDataProxy<value_type, cmnData<value_type>::IS_SPECIALIZED>::ScalarDescription(this->Data, index - baseNumber, userDescription);
+    }
+    //@}
 };
 
 
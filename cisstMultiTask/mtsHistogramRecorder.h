@@ -0,0 +1,136 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+/*!
+  \file
+  \brief Lock-free recorder for duration histograms
+*/
+
+#ifndef _mtsHistogramRecorder_h
+#define _mtsHistogramRecorder_h
+
+#include <atomic>
+#include <cstddef>
+
+/*!
+  \ingroup cisstMultiTask
+
+  Recorder for a histogram of durations along with the number of
+  samples, sum, min and max.  The bin layout is defined by
+  _layoutType which must provide an enum NUMBER_OF_BINS and a static
+  method size_t Bin(double duration), see mtsCommandStatistics and
+  mtsTaskPeriodicStatistics.
+
+  Record and Reset must be called by a single thread (the writer)
+  while Get can be called from any thread.  Since there is a single
+  writer, values are updated with relaxed loads and stores instead of
+  read-modify-write atomic operations.  Get might return values
+  recorded at slightly different times (e.g. the number of samples
+  might not match the sum of the bins).
+*/
+template <class _layoutType>
+class mtsHistogramRecorder
+{
+public:
+    enum {NUMBER_OF_BINS = _layoutType::NUMBER_OF_BINS};
+
+private:
+    std::atomic<unsigned long long> NumberOfSamples;
+    std::atomic<double> Sum;
+    std::atomic<double> Min;
+    std::atomic<double> Max;
+    std::atomic<unsigned long long> Bins[NUMBER_OF_BINS];
+
+    // copy not allowed
+    mtsHistogramRecorder(const mtsHistogramRecorder &);
+    mtsHistogramRecorder & operator = (const mtsHistogramRecorder &);
+
+public:
+    inline mtsHistogramRecorder(void) {
+        Reset();
+    }
+
+    /*! Reset all values, writer only. */
+    inline void Reset(void) {
+        const std::memory_order relaxed = std::memory_order_relaxed;
+        NumberOfSamples.store(0, relaxed);
+        Sum.store(0.0, relaxed);
+        Min.store(0.0, relaxed);
+        Max.store(0.0, relaxed);
+        for (size_t bin = 0; bin < NUMBER_OF_BINS; ++bin) {
+            Bins[bin].store(0, relaxed);
+        }
+    }
+
+    /*! Record one duration in seconds, writer only. */
+    inline void Record(const double duration) {
+        const std::memory_order relaxed = std::memory_order_relaxed;
+        std::atomic<unsigned long long> & bin = Bins[_layoutType::Bin(duration)];
+        bin.store(bin.load(relaxed) + 1, relaxed);
+        Sum.store(Sum.load(relaxed) + duration, relaxed);
+        const unsigned long long numberOfSamples = NumberOfSamples.load(relaxed);
+        if ((numberOfSamples == 0) || (duration < Min.load(relaxed))) {
+            Min.store(duration, relaxed);
+        }
+        if ((numberOfSamples == 0) || (duration > Max.load(relaxed))) {
+            Max.store(duration, relaxed);
+        }
+        NumberOfSamples.store(numberOfSamples + 1, relaxed);
+    }
+
+    /*! Copy the values, can be called from any thread.  bins must
+      have NUMBER_OF_BINS elements. */
+    inline void Get(unsigned long long & numberOfSamples,
+                    double & sum, double & min, double & max,
+                    unsigned long long * bins) const {
+        const std::memory_order relaxed = std::memory_order_relaxed;
+        numberOfSamples = NumberOfSamples.load(relaxed);
+        sum = Sum.load(relaxed);
+        min = Min.load(relaxed);
+        max = Max.load(relaxed);
+        for (size_t bin = 0; bin < NUMBER_OF_BINS; ++bin) {
+            bins[bin] = Bins[bin].load(relaxed);
+        }
+    }
+
+    /*! Find the bin containing a given percentile (e.g. 0.99) in a
+      histogram copied with Get.  Returns NUMBER_OF_BINS if the
+      histogram is empty. */
+    static size_t PercentileBin(const unsigned long long * bins,
+                                const double percentile) {
+        unsigned long long total = 0;
+        size_t bin;
+        for (bin = 0; bin < NUMBER_OF_BINS; ++bin) {
+            total += bins[bin];
+        }
+        if (total == 0) {
+            return NUMBER_OF_BINS;
+        }
+        const double target = percentile * static_cast<double>(total);
+        unsigned long long cumulated = 0;
+        for (bin = 0; bin < NUMBER_OF_BINS; ++bin) {
+            cumulated += bins[bin];
+            if (static_cast<double>(cumulated) >= target) {
+                return bin;
+            }
+        }
+        return NUMBER_OF_BINS - 1;
+    }
+};
+
+#endif // _mtsHistogramRecorder_h
@@ -5,7 +5,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides, Anton Deguet
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2025 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -27,6 +27,7 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstCommon/cmnPortability.h>
 #include <cisstCommon/cmnNamedMap.h>
+#include <cisstOSAbstraction/osaMutex.h>
 
 #include <cisstMultiTask/mtsMailBox.h>
 #include <cisstMultiTask/mtsStateTable.h>
@@ -44,6 +45,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsMulticastCommandWrite.h>
 #include <cisstMultiTask/mtsInterface.h>
 #include <cisstMultiTask/mtsParameterTypes.h>
+#include <cisstMultiTask/mtsCommandStatistics.h>
 #include <cisstMultiTask/mtsForwardDeclarations.h>
 
 // Always include last
@@ -112,6 +114,7 @@ class CISST_EXPORT mtsInterfaceProvided: public mtsInterface {
     friend class mtsSocketProxyServer;
     // for unit-testing
     friend class mtsManagerLocalTest;
+    friend class mtsCommandAndEventLocalTest;
 
  public:
     /*! This type */
@@ -203,6 +206,51 @@ class CISST_EXPORT mtsInterfaceProvided: public mtsInterface {
     /*! Get the current argument queues size. */
     size_t GetArgumentQueuesSize(void) const { return ArgumentQueuesSize; }
 
+    /*! Use a single mailbox shared by all the end-user interfaces
+      instead of one mailbox per connected required interface.  The
+      shared mailbox relies on a multiple-producers/single-consumer
+      queue so the component only has to drain one queue in
+      ProcessMailBoxes, which is more efficient when many clients
+      are connected but mostly idle.
+
+      Commands queued by a given client are executed in the order
+      they were queued.  Commands queued by different clients are
+      executed in the order they were added to the shared queue
+      (instead of all commands of the first client, then all
+      commands of the second client, ...).  The mailbox size (see
+      SetMailBoxSize) is used for the shared mailbox so it should be
+      large enough for all clients.  Argument queues are not shared,
+      each end-user interface still has its own.
+
+      This must be set before any required interface is connected to
+      this provided interface. */
+    void SetMailBoxShared(bool shared);
+
+    /*! Returns true if a shared mailbox is used, see SetMailBoxShared. */
+    bool GetMailBoxShared(void) const { return MailBoxShared; }
+
+    /*! Enable statistics for queued commands.  When enabled, each
+      queued command of each end-user interface records how long it
+      waited in the mailbox and how long it took to execute (see
+      mtsCommandStatistics) and the interface records how many
+      commands are executed per call to ProcessMailBoxes.  This also
+      adds the read command "GetCommandStatistics" to this interface.
+      Recording relies on osaGetTime and atomic counters so the
+      overhead is limited to two time reads per queued command.
+
+      Commands that are not queued are not instrumented.  This must
+      be set before any required interface is connected to this
+      provided interface. */
+    void EnableCommandStatistics(bool enable = true);
+
+    /*! Returns true if statistics are enabled, see EnableCommandStatistics. */
+    bool GetCommandStatisticsEnabled(void) const { return CommandStatisticsEnabled; }
+
+    /*! Collect statistics for all queued commands of all end-user
+      interfaces.  This method is thread safe and is used for the
+      read command "GetCommandStatistics". */
+    void GetCommandStatistics(mtsCommandStatistics & statistics) const;
+
     /*! Set the desired size for the command mail box and argument
       queues.  See SetMailBoxSize and SetArgumentQueuesSize. */
     void SetMailBoxAndArgumentQueuesSize(size_t desiredSize);
@@ -664,6 +712,37 @@ protected: // PK TEMP
     typedef std::list<InterfaceProvidedCreatedPairType> InterfaceProvidedCreatedListType;
     InterfaceProvidedCreatedListType InterfacesProvidedCreated;
 
+    /*! Mutex for the lists of end-user interfaces, end-user
+      interfaces can be created and removed from any thread. */
+    mutable osaMutex EndUserInterfacesMutex;
+
+    /*! End-user interfaces removed while ProcessMailBoxes might still
+      use them.  With a shared mailbox, the position is the number of
+      commands the shared mailbox has to execute before they can be
+      deleted (see mtsMailBox::GetNumberOfEnqueued).  Otherwise, it is
+      the last call to ProcessMailBoxes that might have started
+      processing their mailbox (see NumberOfMailBoxesPasses).  They
+      are deleted by ProcessMailBoxes. */
+    typedef std::pair<size_t, ThisType *> InterfaceProvidedRemovedPairType;
+    typedef std::list<InterfaceProvidedRemovedPairType> InterfaceProvidedRemovedListType;
+    InterfaceProvidedRemovedListType InterfacesProvidedRemoved;
+    std::atomic<size_t> NumberOfInterfacesProvidedRemoved;
+
+    /*! Number of calls to ProcessMailBoxes that collected the
+      mailboxes of the end-user interfaces.  EndUserInterfacesMutex
+      must be locked. */
+    size_t NumberOfMailBoxesPasses;
+
+    /*! Mailboxes collected by ProcessMailBoxes so that commands can be
+      executed without holding EndUserInterfacesMutex.  Only used by
+      the component's thread. */
+    std::vector<mtsMailBox *> MailBoxesToProcess;
+
+    /*! Delete the removed end-user interfaces whose position is lower
+      or equal to the given position (see InterfacesProvidedRemoved).
+      EndUserInterfacesMutex must be locked. */
+    void DeleteRemovedEndUserInterfaces(const size_t position);
+
     /*! Indicates if this interface is used to generate a proxy */
     bool IsProxy;
 
@@ -682,6 +761,19 @@ protected: // PK TEMP
     /*! Size to be used for argument queues */
     size_t ArgumentQueuesSize;
 
+    /*! Use a single mailbox for all end-user interfaces, see SetMailBoxShared */
+    bool MailBoxShared;
+
+    /*! Mailbox shared by all end-user interfaces, only created by the
+      original interface if MailBoxShared is set. */
+    mtsMailBox * SharedMailBox;
+
+    /*! Statistics for queued commands, see EnableCommandStatistics */
+    bool CommandStatisticsEnabled;
+
+    /*! Number of commands processed per call to ProcessMailBoxes */
+    mtsCommandStatisticsCycleRecorder CycleStatistics;
+
     /*! Command to trigger void event for blocking commands. */
     mtsCommandVoid * BlockingCommandExecuted;
 
@@ -5,7 +5,7 @@
   Author(s):  Peter Kazanzides
   Created on: 2007-09-05
 
-  (C) Copyright 2007-2019 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -32,9 +32,55 @@ http://www.cisst.org/cisst/license.txt.
 
 class mtsExecutionResult;
 
+/*!
+  \ingroup cisstMultiTask
+
+  Mailbox of queued commands.  By default, the mailbox is used by a
+  single client (end-user provided interface) and relies on a
+  single-producer/single-consumer queue.  When created with
+  multipleProducers set to true, the mailbox can be shared by all the
+  end-user interfaces created for a given provided interface (see
+  mtsInterfaceProvided::SetMailBoxShared) and uses a
+  multiple-producers/single-consumer queue.  In both cases, the
+  commands are executed by the thread owning the mailbox.
+
+  If a queued command has a statistics recorder (see
+  mtsInterfaceProvided::EnableCommandStatistics), the time spent in
+  the mailbox and the execution time are recorded for each
+  execution.
+*/
 class CISST_EXPORT mtsMailBox
 {
-    mtsQueue<mtsCommandBase *> CommandQueue;
+    /*! Element of the queues, the time the command was queued is
+      only set if the command has a statistics recorder. */
+    struct QueuedCommandType {
+        mtsCommandBase * Command;
+        double Time;
+        inline QueuedCommandType(mtsCommandBase * command = 0, const double time = 0.0):
+            Command(command),
+            Time(time)
+        {}
+    };
+
+    /*! Queue used by default, single client */
+    mtsQueue<QueuedCommandType> CommandQueue;
+
+    /*! Queue used when shared between multiple clients */
+    mtsQueueMultiProducer<QueuedCommandType> SharedCommandQueue;
+
+    /*! Determines which queue is used */
+    bool MultipleProducers;
+
+    /*! Number of commands removed from the queue since the mailbox
+      was created, see GetNumberOfDequeued */
+    std::atomic<size_t> NumberOfDequeued;
+
+    /*! Number of commands queued since the mailbox was created, only
+      used with a single producer, see GetNumberOfEnqueued */
+    std::atomic<size_t> NumberOfEnqueued;
+
+    /*! Remove the oldest command from the queue in use */
+    void Dequeue(void);
 
     /*! Name provided for logs */
     std::string Name;
@@ -65,13 +111,18 @@ class CISST_EXPORT mtsMailBox
 public:
     mtsMailBox(const std::string & name,
                size_t size,
-               mtsCallableVoidBase * postCommandQueuedCallable = 0);
+               mtsCallableVoidBase * postCommandQueuedCallable = 0,
+               bool multipleProducers = false);
 
     ~mtsMailBox(void);
 
     /*! Get the mailbox's name */
     const std::string & GetName(void) const;
 
+    /*! Returns true if the mailbox can be used by multiple clients,
+      i.e. multiple threads can call Write concurrently. */
+    bool AcceptsMultipleProducers(void) const;
+
     /*! Write a command to the mailbox.  If a post command queued
       command has been provided, the command is executed. */
     bool Write(mtsCommandBase * command);
@@ -95,6 +146,19 @@ public:
       of slots used. */
     size_t GetAvailable(void) const;
 
+    /*! Returns the number of commands executed and removed from the
+      mailbox since it was created.  Commands are counted once
+      executed, before they are removed from the queue.  This method
+      can be called from any thread. */
+    size_t GetNumberOfDequeued(void) const;
+
+    /*! Returns the number of commands queued since the mailbox was
+      created.  Commands are executed in order so all the commands
+      queued before the call have been executed once
+      GetNumberOfDequeued returns the same value or more.  This
+      method can be called from any thread. */
+    size_t GetNumberOfEnqueued(void) const;
+
     /*! Set the command to be called after a blocking command is
       de-queued and executed.  This can be used to call a trigger for
       event.  The event handler on the client site can then raise a
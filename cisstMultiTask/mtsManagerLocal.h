@@ -5,7 +5,7 @@
   Author(s):  Min Yang Jung
   Created on: 2009-12-07
 
-  (C) Copyright 2009-2025 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -115,6 +115,10 @@ private:
     /*! Pointer to task that currently has main thread (set when that task is started) */
     mtsTaskContinuous * CurrentMainTask;
 
+    /*! Optional pool of threads used to execute mtsTaskFromSignal
+      components, see SetExecutorPool */
+    mtsExecutorPool * ExecutorPool;
+
     /*! Flag for unit tests. Enabled only for unit tests (false by default) */
     static bool UnitTestEnabled;
 
@@ -397,6 +401,29 @@ public:
     /*! Call CreateAll method followed by WaitForStateAll. */
     bool CreateAllAndWait(double timeoutInSeconds);
 
+    /*! Create a pool of threads used to execute all mtsTaskFromSignal
+      components created afterwards (see mtsExecutorPool).  Instead of
+      having a thread per component, components are scheduled on the
+      pool when they receive a queued command or event.  If
+      numberOfThreads is 0, the number of threads is based on the
+      number of processors.  This method must be called before any
+      component is created (e.g. before CreateAll) and returns false if
+      a pool already exists.  The pool is deleted along the component
+      manager so all components using the pool must be killed first
+      (see also RemoveExecutorPool). */
+    bool SetExecutorPool(const size_t numberOfThreads = 0);
+
+    /*! Stop and delete the executor pool so components created
+      afterwards use their own thread.  Returns false if there is no
+      pool or if a component using the pool is still registered, i.e.
+      all components using the pool must be killed and removed first. */
+    bool RemoveExecutorPool(void);
+
+    /*! Executor pool, null if SetExecutorPool has not been called. */
+    inline mtsExecutorPool * GetExecutorPool(void) const {
+        return ExecutorPool;
+    }
+
     /*! \brief Start all components. If a component is of type mtsTask,
       mtsTask::Start() is called internally. */
     void StartAll(void);
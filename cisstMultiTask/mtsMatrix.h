@@ -5,7 +5,7 @@
   Author(s):	Anton Deguet
   Created on:   2009-04-29
 
-  (C) Copyright 2009-2023 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -113,6 +113,35 @@ public:
         MatrixType::ToStreamRaw(outputStream, delimiter, headerOnly, headerPrefix);
     }
 
+    /*! Scalars, starting with the ones from mtsGenericObject
+      (timestamps and valid flag) followed by the matrix size and
+      elements. */
+    //@{
+    size_t ScalarNumber(void) const override {
+        return mtsGenericObject::ScalarNumber() + cmnData<MatrixType>::ScalarNumber(*this);
+    }
+
+    bool ScalarNumberIsFixed(void) const override {
+        return false;
+    }
+
+    double Scalar(const size_t index) const CISST_THROW(std::out_of_range) override {
+        const size_t baseNumber = mtsGenericObject::ScalarNumber();
+        if (index < baseNumber) {
+            return mtsGenericObject::Scalar(index);
+        }
+        return cmnData<MatrixType>::Scalar(*this, index - baseNumber);
+    }
+
+    std::string ScalarDescription(const size_t index, const std::string & userDescription = "") const CISST_THROW(std::out_of_range) override {
+        const size_t baseNumber = mtsGenericObject::ScalarNumber();
+        if (index < baseNumber) {
+            return mtsGenericObject::ScalarDescription(index, userDescription);
+        }
+        return cmnData<MatrixType>::ScalarDescription(*this, index - baseNumber, userDescription);
+    }
+    //@}
+
     /*! Binary serialization */
     void SerializeRaw(std::ostream & outputStream) const override
     {
@@ -6,7 +6,7 @@
   Author(s):  Peter Kazanzides, Anton Deguet
   Created on: 2007-09-05
 
-  (C) Copyright 2007-2010 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -27,14 +27,176 @@ http://www.cisst.org/cisst/license.txt.
 #ifndef _mtsQueue_h
 #define _mtsQueue_h
 
+#include <cisstCommon/cmnPortability.h>
 #include <cisstMultiTask/mtsGenericObjectProxy.h>
 
+#include <atomic>
+
+/*!
+  \ingroup cisstMultiTask
+
+  Head and tail indices shared by the single-producer/single-consumer
+  queues (mtsQueue and mtsQueueGeneric).  The head index is only
+  written by the producer and the tail index is only written by the
+  consumer.  Both are std::atomic and published with release
+  semantics so that the element stored (resp. released) before the
+  index update is visible to the other thread once it observes the
+  new index (acquire).
+
+  To avoid false sharing, the producer's data (head index and its
+  cached copy of the tail) and the consumer's data (tail index and its
+  cached copy of the head) are on separate cache lines.  The cached
+  copies allow the producer (resp. consumer) to avoid reading the
+  peer's index, i.e. a cache line owned by the other core, until the
+  queue looks full (resp. empty).
+
+  One slot is always left unused to differentiate empty (head ==
+  tail) from full (head + 1 == tail).  A side effect is that the slot
+  returned by Get remains untouched by the producer until the next
+  call to Get, so the consumer can safely use the returned pointer
+  until then.
+*/
+class mtsQueueIndices
+{
+public:
+    typedef size_t size_type;
+    typedef size_t index_type;
+
+protected:
+    char PaddingBefore[CMN_CACHE_LINE_SIZE];
+
+    /*! Producer side */
+    std::atomic<index_type> Head;
+    mutable index_type TailCache;
+    char PaddingHead[CMN_CACHE_LINE_SIZE - sizeof(std::atomic<index_type>) - sizeof(index_type)];
+
+    /*! Consumer side */
+    std::atomic<index_type> Tail;
+    mutable index_type HeadCache;
+    char PaddingTail[CMN_CACHE_LINE_SIZE - sizeof(std::atomic<index_type>) - sizeof(index_type)];
+
+    /*! Number of slots, including the unused one */
+    size_type NumberOfSlots;
+
+    inline index_type NextIndex(const index_type index) const {
+        const index_type next = index + 1;
+        return (next >= NumberOfSlots) ? 0 : next;
+    }
+
+public:
+    inline mtsQueueIndices(void):
+        Head(0),
+        TailCache(0),
+        Tail(0),
+        HeadCache(0),
+        NumberOfSlots(0)
+    {}
+
+    /*! Reset indices, not thread safe. */
+    inline void Reset(const size_type numberOfSlots) {
+        NumberOfSlots = numberOfSlots;
+        Head.store(0, std::memory_order_relaxed);
+        TailCache = 0;
+        Tail.store(0, std::memory_order_relaxed);
+        HeadCache = 0;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    /*! Number of elements queued.  Can be called from any thread but
+      the result might be outdated as soon as it is returned. */
+    inline size_type Available(void) const {
+        const index_type tail = Tail.load(std::memory_order_acquire);
+        const index_type head = Head.load(std::memory_order_acquire);
+        return (head >= tail) ? (head - tail) : (head + NumberOfSlots - tail);
+    }
+
+    /*! True if queue is full, see Available. */
+    inline bool Full(void) const {
+        if (NumberOfSlots == 0) {
+            return true;
+        }
+        return NextIndex(Head.load(std::memory_order_acquire))
+            == Tail.load(std::memory_order_acquire);
+    }
+
+    /*! True if queue is empty, see Available. */
+    inline bool Empty(void) const {
+        return Head.load(std::memory_order_acquire)
+            == Tail.load(std::memory_order_acquire);
+    }
+
+    /*! Producer only.  Returns the number of slots that can be
+      written starting at index head.  The tail index is only
+      reloaded if the cached copy doesn't provide enough room for
+      the requested number of elements. */
+    inline size_type FreeForProducer(const index_type head, const size_type requested) {
+        if (NumberOfSlots == 0) {
+            return 0;
+        }
+        size_type free = (TailCache > head) ? (TailCache - head - 1) : (TailCache + NumberOfSlots - head - 1);
+        if (free < requested) {
+            TailCache = Tail.load(std::memory_order_acquire);
+            free = (TailCache > head) ? (TailCache - head - 1) : (TailCache + NumberOfSlots - head - 1);
+        }
+        return free;
+    }
+
+    /*! Consumer only.  Returns the number of elements that can be
+      read starting at index tail, reloading the head index only if
+      the cached copy doesn't show enough elements. */
+    inline size_type AvailableForConsumer(const index_type tail, const size_type requested) const {
+        size_type available = (HeadCache >= tail) ? (HeadCache - tail) : (HeadCache + NumberOfSlots - tail);
+        if (available < requested) {
+            HeadCache = Head.load(std::memory_order_acquire);
+            available = (HeadCache >= tail) ? (HeadCache - tail) : (HeadCache + NumberOfSlots - tail);
+        }
+        return available;
+    }
+
+    /*! Producer only, current head index */
+    inline index_type ProducerHead(void) const {
+        return Head.load(std::memory_order_relaxed);
+    }
+
+    /*! Producer only, make elements up to (excluding) newHead visible to consumer */
+    inline void Publish(const index_type newHead) {
+        Head.store(newHead, std::memory_order_release);
+    }
+
+    /*! Consumer only, current tail index */
+    inline index_type ConsumerTail(void) const {
+        return Tail.load(std::memory_order_relaxed);
+    }
+
+    /*! Consumer only, release slots up to (excluding) newTail to producer */
+    inline void Release(const index_type newTail) {
+        Tail.store(newTail, std::memory_order_release);
+    }
+
+    /*! Index after index, wrapping around */
+    inline index_type Next(const index_type index) const {
+        return NextIndex(index);
+    }
+
+    /*! Index count slots after index, wrapping around */
+    inline index_type Advance(const index_type index, const size_type count) const {
+        const index_type result = index + count;
+        return (result >= NumberOfSlots) ? (result - NumberOfSlots) : result;
+    }
+};
+
+
 /*!
   \ingroup cisstMultiTask
 
-  Defines a queue that can be accessed in a thread-safe manner,
-  assuming that there is only one reader and one writer and that
-  pointer updates are atomic.
+  Defines a lock-free queue that can be accessed in a thread-safe
+  manner, assuming that there is only one reader (consumer) and one
+  writer (producer).  See mtsQueueIndices for the memory ordering
+  guarantees.  The queue can hold up to GetSize() - 1 elements.
+
+  Put, PutBatch are reserved to the producer thread.  Peek, Get and
+  GetBatch are reserved to the consumer thread.  SetSize is not thread
+  safe.
 */
 template<class _elementType>
 class mtsQueue
@@ -49,10 +211,8 @@ public:
     typedef size_t index_type;
 
 protected:
+    mtsQueueIndices Indices;
     pointer Data;
-    pointer Head;
-    pointer Tail;
-    pointer Sentinel;  // end marker
     size_type Size;
 
     // private method, can only be used once by constructor.  Doesn't support resize!
@@ -68,18 +228,18 @@ protected:
             this->Data = 0;
         }
         // head == tail implies empty queue
-        this->Head = this->Data;
-        this->Tail = this->Data;
-        this->Sentinel = this->Data + this->Size;
+        this->Indices.Reset(this->Size);
     }
 
+private:
+    // queue can't be copied, indices are atomic and data is owned
+    mtsQueue(const mtsQueue &);
+    mtsQueue & operator = (const mtsQueue &);
+
 public:
 
     inline mtsQueue(void):
         Data(0),
-        Head(0),
-        Tail(0),
-        Sentinel(0),
         Size(0)
     {}
 
@@ -110,82 +270,115 @@ public:
 
     /*! Returns number of elements available in queue, i.e. the number
       of slots used. */
-    inline size_type GetAvailable(void) const
-    {
-        ptrdiff_t available = Head - Tail;
-        if (available < 0) {
-            available += Size;
-        }
-        return available;
+    inline size_type GetAvailable(void) const {
+        return Indices.Available();
     }
 
 
     /*! Returns true if queue is full. */
     inline bool IsFull(void) const {
-        pointer oneAfterHead = this->Head + 1;
-        if (oneAfterHead >= this->Sentinel) {
-            oneAfterHead = this->Data;
-        }
-        return oneAfterHead == this->Tail;
+        return Indices.Full();
     }
 
 
     /*! Returns true if queue is empty. */
     inline bool IsEmpty(void) const {
-        return Head == Tail;
+        return Indices.Empty();
     }
 
 
-    /*! Copy an object to the queue.
+    /*! Copy an object to the queue.  Producer only.
       \param in reference to the object to be copied
-      \result Pointer to element in queue (use iterator instead?)
+      \result Pointer to element in queue, 0 if the queue is full
     */
     //inline const_pointer Put(const_reference newObject)
     //Following signature is equivalent for types that are not Proxy types. If a Proxy type,
     //then we use the ProxyBase instead, so that we can also accept ProxyRef objects.
     inline const_pointer Put(const typename mtsGenericTypesUnwrap<value_type>::BaseType &newObject)
     {
-        pointer newHead = this->Head + 1;
-        // test if end of buffer (same as IsFull method)
-        if (newHead >= this->Sentinel) {
-            newHead = this->Data;
-        }
-        // test if full
-        if (newHead == this->Tail) {
+        const index_type head = Indices.ProducerHead();
+        if (Indices.FreeForProducer(head, 1) == 0) {
             return 0;    // queue full
         }
         // queue new object and move head
-        *(this->Head) = newObject;
-        this->Head = newHead;
-        return this->Head;
+        this->Data[head] = newObject;
+        Indices.Publish(Indices.Next(head));
+        return this->Data + head;
+    }
+
+
+    /*! Copy up to count objects to the queue.  Producer only.  The
+      head index is published once for all elements, i.e. the
+      consumer will either see none or all of the elements queued by
+      this call.
+      \result Number of elements actually queued
+    */
+    inline size_type PutBatch(const_pointer newObjects, size_type count)
+    {
+        index_type head = Indices.ProducerHead();
+        const size_type free = Indices.FreeForProducer(head, count);
+        if (count > free) {
+            count = free;
+        }
+        size_type index;
+        for (index = 0; index < count; ++index) {
+            this->Data[head] = newObjects[index];
+            head = Indices.Next(head);
+        }
+        if (count > 0) {
+            Indices.Publish(head);
+        }
+        return count;
     }
 
 
     /*! Get a pointer to the next object to be read, but do not
-        remove the item from the queue.
-        \result Pointer to top element in queue (use iterator instead?)
+        remove the item from the queue.  Consumer only.
+        \result Pointer to top element in queue, 0 if queue is empty
      */
     inline pointer Peek(void) const {
-        if (this->IsEmpty()) {
+        const index_type tail = Indices.ConsumerTail();
+        if (Indices.AvailableForConsumer(tail, 1) == 0) {
             return 0;
         }
-        return this->Tail;
+        return this->Data + tail;
     }
 
 
-    /*! Pop the next object to be read from the queue.
-        \result Pointer to element just popped (use iterator instead?)
+    /*! Pop the next object to be read from the queue.  Consumer only.
+        The element pointed to remains valid until the next call to
+        Get or GetBatch.
+        \result Pointer to element just popped, 0 if queue is empty
      */
     inline pointer Get(void) {
-        if (this->IsEmpty()) {
+        const index_type tail = Indices.ConsumerTail();
+        if (Indices.AvailableForConsumer(tail, 1) == 0) {
             return 0;
         }
-        pointer result = this->Tail;
-        this->Tail++;
-        if (this->Tail >= this->Sentinel) {
-            this->Tail = this->Data;
+        Indices.Release(Indices.Next(tail));
+        return this->Data + tail;
+    }
+
+
+    /*! Copy and pop up to maxCount objects from the queue.  Consumer
+      only.  The tail index is released once for all elements.
+      \result Number of elements actually copied
+    */
+    inline size_type GetBatch(pointer destination, size_type maxCount) {
+        index_type tail = Indices.ConsumerTail();
+        const size_type available = Indices.AvailableForConsumer(tail, maxCount);
+        if (maxCount > available) {
+            maxCount = available;
+        }
+        size_type index;
+        for (index = 0; index < maxCount; ++index) {
+            destination[index] = this->Data[tail];
+            tail = Indices.Next(tail);
+        }
+        if (maxCount > 0) {
+            Indices.Release(tail);
         }
-        return result;
+        return maxCount;
     }
 
 };
@@ -193,6 +386,14 @@ public:
 
 
 
+/*!
+  \ingroup cisstMultiTask
+
+  Single-producer/single-consumer lock-free queue of generic objects,
+  the type of elements is defined at runtime using the class services
+  of the prototype passed to SetSize.  Same thread safety rules as
+  mtsQueue.
+*/
 class mtsQueueGeneric
 {
 public:
@@ -205,11 +406,9 @@ public:
     typedef size_t index_type;
 
 protected:
+    mtsQueueIndices Indices;
     const cmnClassServicesBase * ClassServices;
     pointer * Data;
-    pointer * Head;
-    pointer * Tail;
-    pointer * Sentinel;  // end marker
     size_type Size;
 
     // private method, can only be used once by constructor.  Doesn't support resize!
@@ -233,9 +432,7 @@ protected:
             this->Data = 0;
         }
         // head == tail implies empty queue
-        this->Head = this->Data;
-        this->Tail = this->Data;
-        this->Sentinel = this->Data + this->Size;
+        this->Indices.Reset(this->Size);
     }
 
     void Free(void) {
@@ -247,16 +444,20 @@ protected:
         this->Data = 0;
     }
 
+private:
+    // queue can't be copied, indices are atomic and data is owned
+    mtsQueueGeneric(const mtsQueueGeneric &);
+    mtsQueueGeneric & operator = (const mtsQueueGeneric &);
+
 public:
 
     inline mtsQueueGeneric(void):
         ClassServices(0),
         Data(0),
-        Head(0),
-        Tail(0),
-        Sentinel(0),
         Size(1)
-    {}
+    {
+        this->Indices.Reset(0);
+    }
 
 
     inline mtsQueueGeneric(size_type size, const_reference value) {
@@ -301,87 +502,295 @@ public:
 
     /*! Returns number of elements available in queue, i.e. the number
       of slots used. */
-    inline size_type GetAvailable(void) const
-    {
-        ptrdiff_t available = Head - Tail;
-        if (available < 0) {
-            available += Size;
-        }
-        return available;
+    inline size_type GetAvailable(void) const {
+        return Indices.Available();
     }
 
 
     /*! Returns true if queue is full. */
     inline bool IsFull(void) const {
-        pointer * oneAfterHead = this->Head + 1;
-        if (oneAfterHead >= this->Sentinel) {
-            oneAfterHead = this->Data;
-        }
-        return oneAfterHead == this->Tail;
+        return Indices.Full();
     }
 
 
     /*! Returns true if queue is empty. */
     inline bool IsEmpty(void) const {
-        return Head == Tail;
+        return Indices.Empty();
     }
 
 
-    /*! Copy an object to the queue.
+    /*! Copy an object to the queue.  Producer only.
       \param in reference to the object to be copied
-      \result Pointer to element in queue (use iterator instead?)
+      \result Pointer to element in queue, 0 if the queue is full
     */
     inline const_pointer Put(const_reference newObject) {
-        pointer * newHead = this->Head + 1;
-        // test if end of buffer (same as IsFull method)
-        if (newHead >= this->Sentinel) {
-            newHead = this->Data;
-        }
-        // test if full
-        if (newHead == this->Tail) {
+        const index_type head = Indices.ProducerHead();
+        if (Indices.FreeForProducer(head, 1) == 0) {
             return 0;    // queue full
         }
         // queue new object and move head
         // using in place new to make sure copy constructor is used
-        if (!this->ClassServices->Create(*(this->Head), newObject)) {
-            // if Create fails, it does not modify the input parameter (this->Head)
+        if (!this->ClassServices->Create(this->Data[head], newObject)) {
+            // if Create fails, it does not modify the input parameter (this->Data[head])
             CMN_LOG_RUN_ERROR << "mtsQueueGeneric::Put failed for " << newObject.Services()->GetName() << std::endl;
             return 0;
         }
-        this->Head = newHead;
-        return *(this->Head);
+        Indices.Publish(Indices.Next(head));
+        return this->Data[head];
     }
 
 
     /*! Get a pointer to the next object to be read, but do not
-        remove the item from the queue.
-        \result Pointer to top element in queue (use iterator instead?)
+        remove the item from the queue.  Consumer only.
+        \result Pointer to top element in queue, 0 if queue is empty
      */
     inline pointer Peek(void) const {
-        if (this->IsEmpty()) {
+        const index_type tail = Indices.ConsumerTail();
+        if (Indices.AvailableForConsumer(tail, 1) == 0) {
             return 0;
         }
-        return *(this->Tail);
+        return this->Data[tail];
     }
 
 
-    /*! Pop the next object to be read from the queue.
-        \result Pointer to element just popped (use iterator instead?)
+    /*! Pop the next object to be read from the queue.  Consumer only.
+        The element pointed to remains valid until the next call to
+        Get.
+        \result Pointer to element just popped, 0 if queue is empty
      */
     inline pointer Get(void) {
-        if (this->IsEmpty()) {
+        const index_type tail = Indices.ConsumerTail();
+        if (Indices.AvailableForConsumer(tail, 1) == 0) {
+            return 0;
+        }
+        Indices.Release(Indices.Next(tail));
+        return this->Data[tail];
+    }
+
+};
+
+
+
+/*!
+  \ingroup cisstMultiTask
+
+  Bounded lock-free queue for multiple producers and a single
+  consumer.  Each slot has a sequence number used to determine if
+  the slot is free for the producer that reserved it (by atomically
+  incrementing the enqueue position) or ready for the consumer.  Put
+  can be called concurrently from any number of threads.  Peek, Pop
+  and Get are reserved to the consumer thread.  SetSize is not thread
+  safe.
+
+  Elements are dequeued in the order their slots were reserved by
+  the producers, so elements queued by a given thread remain in
+  order.  Elements queued concurrently by different threads are
+  ordered by whichever reservation succeeded first.  Contrary to
+  mtsQueue, all slots can be used (the queue holds GetSize()
+  elements) but a slot is released as soon as it is popped, so the
+  consumer shouldn't keep a pointer on an element once popped.
+*/
+template<class _elementType>
+class mtsQueueMultiProducer
+{
+public:
+    typedef _elementType value_type;
+    typedef value_type * pointer;
+    typedef const value_type * const_pointer;
+    typedef value_type & reference;
+    typedef const value_type & const_reference;
+    typedef size_t size_type;
+    typedef size_t index_type;
+
+protected:
+    class Slot {
+    public:
+        std::atomic<index_type> Sequence;
+        value_type Data;
+    };
+
+    char PaddingBefore[CMN_CACHE_LINE_SIZE];
+
+    /*! Shared by all producers */
+    std::atomic<index_type> EnqueuePosition;
+    char PaddingEnqueue[CMN_CACHE_LINE_SIZE - sizeof(std::atomic<index_type>)];
+
+    /*! Only modified by consumer, read by producers to test if full */
+    std::atomic<index_type> DequeuePosition;
+    char PaddingDequeue[CMN_CACHE_LINE_SIZE - sizeof(std::atomic<index_type>)];
+
+    Slot * Slots;
+    size_type Size;
+
+    void Allocate(size_type size, const_reference value) {
+        this->Size = size;
+        if (this->Size > 0) {
+            this->Slots = new Slot[this->Size];
+            index_type index;
+            for (index = 0; index < this->Size; index++) {
+                this->Slots[index].Sequence.store(index, std::memory_order_relaxed);
+                this->Slots[index].Data = value;
+            }
+        } else {
+            this->Slots = 0;
+        }
+        EnqueuePosition.store(0, std::memory_order_relaxed);
+        DequeuePosition.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+private:
+    // queue can't be copied, positions are atomic and data is owned
+    mtsQueueMultiProducer(const mtsQueueMultiProducer &);
+    mtsQueueMultiProducer & operator = (const mtsQueueMultiProducer &);
+
+public:
+
+    inline mtsQueueMultiProducer(void):
+        EnqueuePosition(0),
+        DequeuePosition(0),
+        Slots(0),
+        Size(0)
+    {}
+
+
+    inline mtsQueueMultiProducer(size_type size, const_reference value) {
+        Allocate(size, value);
+    }
+
+
+    inline ~mtsQueueMultiProducer() {
+        delete [] Slots;
+    }
+
+
+    /*! Sets the size of the queue (destructive, i.e. won't preserve
+      previously queued elements). */
+    inline void SetSize(size_type size, const_reference value) {
+        delete [] Slots;
+        this->Allocate(size, value);
+    }
+
+
+    /*! Returns size of queue. */
+    inline size_type GetSize(void) const {
+        return Size;
+    }
+
+
+    /*! Returns number of slots used, including slots reserved by
+      producers still copying their element.  Can be called from any
+      thread but the result might be outdated as soon as returned. */
+    inline size_type GetAvailable(void) const {
+        const index_type dequeue = DequeuePosition.load(std::memory_order_acquire);
+        const index_type enqueue = EnqueuePosition.load(std::memory_order_acquire);
+        return (enqueue > dequeue) ? (enqueue - dequeue) : 0;
+    }
+
+
+    /*! Returns the number of slots reserved by producers since the
+      queue was allocated.  Elements are dequeued in this order so
+      once the consumer has removed that many elements, all the
+      elements put before the call have been removed.  Can be called
+      from any thread. */
+    inline index_type GetNumberOfEnqueued(void) const {
+        return EnqueuePosition.load(std::memory_order_acquire);
+    }
+
+
+    /*! Returns true if queue is full, see GetAvailable. */
+    inline bool IsFull(void) const {
+        return GetAvailable() >= Size;
+    }
+
+
+    /*! Returns true if queue is empty, see GetAvailable. */
+    inline bool IsEmpty(void) const {
+        return GetAvailable() == 0;
+    }
+
+
+    /*! Copy an object to the queue.  Can be called from any thread.
+      \result Pointer to element in queue, 0 if the queue is full.
+      The pointer should only be used to test success as the element
+      can be dequeued anytime by the consumer.
+    */
+    inline const_pointer Put(const typename mtsGenericTypesUnwrap<value_type>::BaseType & newObject)
+    {
+        if (Size == 0) {
+            return 0;
+        }
+        Slot * slot;
+        index_type position = EnqueuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            slot = this->Slots + (position % Size);
+            const index_type sequence = slot->Sequence.load(std::memory_order_acquire);
+            const ptrdiff_t difference = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(position);
+            if (difference == 0) {
+                // slot is free, try to reserve it
+                if (EnqueuePosition.compare_exchange_weak(position, position + 1,
+                                                          std::memory_order_relaxed)) {
+                    break;
+                }
+                // on failure, position has been updated by compare_exchange
+            } else if (difference < 0) {
+                return 0; // queue full
+            } else {
+                // another producer reserved this slot, try again
+                position = EnqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        slot->Data = newObject;
+        // publish to consumer
+        slot->Sequence.store(position + 1, std::memory_order_release);
+        return &(slot->Data);
+    }
+
+
+    /*! Get a pointer to the next object to be read, but do not
+      remove the item from the queue.  Consumer only.
+      \result Pointer to top element in queue, 0 if queue is empty or
+      if the next element is still being copied by a producer.
+    */
+    inline pointer Peek(void) const {
+        if (Size == 0) {
+            return 0;
+        }
+        const index_type position = DequeuePosition.load(std::memory_order_relaxed);
+        Slot * slot = this->Slots + (position % Size);
+        if (slot->Sequence.load(std::memory_order_acquire) != (position + 1)) {
             return 0;
         }
-        pointer result = *(this->Tail);
-        this->Tail++;
-        if (this->Tail >= this->Sentinel) {
-            this->Tail = this->Data;
+        return &(slot->Data);
+    }
+
+
+    /*! Remove the next object from the queue and make the slot
+      available to producers.  Consumer only.
+      \result false if queue is empty */
+    inline bool Pop(void) {
+        if (!Peek()) {
+            return false;
+        }
+        const index_type position = DequeuePosition.load(std::memory_order_relaxed);
+        DequeuePosition.store(position + 1, std::memory_order_release);
+        this->Slots[position % Size].Sequence.store(position + Size, std::memory_order_release);
+        return true;
+    }
+
+
+    /*! Copy and remove the next object from the queue.  Consumer only.
+      \result false if queue is empty */
+    inline bool Get(reference element) {
+        pointer next = Peek();
+        if (!next) {
+            return false;
         }
-        return result;
+        element = *next;
+        return Pop();
     }
 
 };
 
 
 #endif // _mtsQueue_h
-
@@ -5,7 +5,7 @@
   Author(s):  Peter Kazanzides
   Created on: 2013-08-06
 
-  (C) Copyright 2013-2023 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2013-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -102,6 +102,10 @@ class CISST_EXPORT mtsSocketProxyClient : public mtsTaskContinuous
 
     void CheckForEvents(double timeoutInSec);
 
+    // Buffers reused for all events received (see CheckForEvents)
+    std::string ReceiveBuffer;
+    mtsStdString ReceivedArgument;
+
     friend class CommandWrapperBase;
     friend class MulticastCommandVoidProxy;
     friend class MulticastCommandWriteProxy;
@@ -131,6 +135,8 @@ class CISST_EXPORT mtsSocketProxyClient : public mtsTaskContinuous
     // Following used by command wrappers
     bool CheckForEventsImmediate(double timeoutInSec);
     bool Serialize(const mtsGenericObject & originalObject, std::string & serializedObject);
+    // Serialize in the serializer's internal buffer, data is valid until the next call
+    bool Serialize(const mtsGenericObject & originalObject, const char * & data, size_t & size);
     bool DeSerialize(const std::string & serializedObject, mtsGenericObject & originalObject);
     mtsGenericObject * DeSerialize(const std::string & serializedObject);
 };
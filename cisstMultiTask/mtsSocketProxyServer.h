@@ -5,7 +5,7 @@
   Author(s):  Peter Kazanzides
   Created on: 2013-08-06
 
-  (C) Copyright 2013-2023 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2013-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -117,6 +117,10 @@ class CISST_EXPORT mtsSocketProxyServer : public mtsTaskContinuous
 
     FinishedEventList *FinishedEvents;
 
+    // Buffers reused for all messages (see Run)
+    std::string ReceiveBuffer;
+    std::string SendBuffer;
+
     // For memory cleanup
     std::vector<mtsCommandBase *> SpecialCommands;
 
@@ -173,7 +177,11 @@ class CISST_EXPORT mtsSocketProxyServer : public mtsTaskContinuous
     */
     mtsProxySerializer *GetSerializerForCurrentClient(void) const;
 
-    mtsCommandWriteBase *AllocateFinishedEvent(const std::string &eventHandle);
+    /*! Allocate a finished event for the current client
+        \param eventHandle Client's handle, at least CommandHandle::COMMAND_HANDLE_STRING_SIZE characters
+        \return Command used to send the response, 0 if no entry is available
+    */
+    mtsCommandWriteBase *AllocateFinishedEvent(const char *eventHandle);
 
 };
 
@@ -5,7 +5,7 @@
   Author(s):  Ankur Kapoor, Min Yang Jung, Peter Kazanzides
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2025 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -37,6 +37,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsIntervalStatistics.h>
 
 
+#include <atomic>
 #include <vector>
 #include <iostream>
 
@@ -163,6 +164,11 @@ public:
         AccessorBase(const mtsStateTable &table, mtsStateDataId id): Table(table), Id(id) {}
         virtual ~AccessorBase() {}
         virtual void ToStream(std::ostream & outputStream, const mtsStateIndex & when) const = 0;
+
+        /*! Copy data without validating the index, the caller is
+          responsible for calling ValidateReadIndex after the copy.
+          See mtsStateTable::GetBatch. */
+        virtual bool Copy(const mtsStateIndex & when, mtsGenericObject & data) const = 0;
     };
 
     template <class _elementType>
@@ -197,13 +203,19 @@ public:
         }
 
         bool Get(const mtsStateIndex & when, mtsGenericObject & data) const {
+            return Copy(when, data) && Table.ValidateReadIndex(when);
+        }
+
+        bool Copy(const mtsStateIndex & when, mtsGenericObject & data) const {
             value_type* pdata = dynamic_cast<value_type*>(&data);
             if (pdata) {
-                return Get(when, *pdata);
+                *pdata = History.Element(when.Index());
+                return true;
             }
             value_ref_type* pref = dynamic_cast<value_ref_type*>(&data);
             if (pref) {
-                return Get(when, *pref);
+                *pref = History.Element(when.Index());
+                return true;
             }
             return false;
         }
@@ -226,6 +238,53 @@ public:
         }
     };
 
+    /*! Zero-copy, read-only view of one row of the state table.
+      Snapshots are provided by mtsStateTable::ReadLatest to a reader
+      callback.  Elements are accessed in place, i.e. in the table
+      itself, so the writer might be updating them while they are
+      read.  The content read is only consistent if IsValid returns
+      true after all the elements have been read.
+
+      Validation can only detect that the row changed, it can't
+      prevent the reader from accessing memory the writer is
+      reallocating.  Snapshots must therefore only be used for
+      elements whose storage is never reallocated by the writer,
+      i.e. fixed size types (e.g. mtsDouble, mtsInt) or dynamic
+      containers sized once before the task starts and never resized
+      afterwards.  Other elements must be read using the Accessor
+      methods. */
+    class CISST_EXPORT Snapshot {
+        friend class mtsStateTable;
+        const mtsStateTable * Table;
+        mtsStateIndex Index;
+    public:
+        inline Snapshot(const mtsStateTable * table):
+            Table(table)
+        {}
+
+        /*! Index of the row viewed. */
+        inline const mtsStateIndex & GetIndex(void) const {
+            return Index;
+        }
+
+        /*! Element in place, as a generic object. */
+        inline const mtsGenericObject & Element(const mtsStateDataId id) const {
+            return (*(Table->StateVector[id]))[Index.Index()];
+        }
+
+        /*! Element in place, returns 0 if the type doesn't match. */
+        template <class _elementType>
+        inline const typename mtsGenericTypes<_elementType>::FinalType * Get(const mtsStateDataId id) const {
+            return dynamic_cast<const typename mtsGenericTypes<_elementType>::FinalType *>(&(Element(id)));
+        }
+
+        /*! Check that the row hasn't been overwritten since the
+          snapshot was taken. */
+        inline bool IsValid(void) const {
+            return Table->ValidateReadIndex(Index);
+        }
+    };
+
  protected:
 
     /*! Flag to indicate if the table has started.  True between
@@ -238,11 +297,36 @@ public:
     /*! The index of the writer in the data table. */
     size_t IndexWriter;
 
-    /*! The index of the reader in the table. */
-    size_t IndexReader;
+    /*! std::atomic that can be copied, used for the indices and
+      ticks shared between the writer and the readers so the table
+      (and components owning a table) remain copyable.  Copies are
+      not atomic and should only be performed when the table is not
+      in use. */
+    template <class _type>
+    class CopyableAtomic: public std::atomic<_type> {
+    public:
+        inline CopyableAtomic(const _type value = _type()):
+            std::atomic<_type>(value)
+        {}
+        inline CopyableAtomic(const CopyableAtomic & other):
+            std::atomic<_type>(other.load(std::memory_order_relaxed))
+        {}
+        inline CopyableAtomic & operator = (const CopyableAtomic & other) {
+            this->store(other.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+        inline CopyableAtomic & operator = (const _type value) {
+            this->store(value);
+            return *this;
+        }
+    };
+
+    /*! The index of the reader in the table.  Published by Advance
+      with release semantic, see GetIndexReader. */
+    CopyableAtomic<size_t> IndexReader;
 
     /*! The index of the delayed reader in the table. */
-    size_t IndexDelayed;
+    CopyableAtomic<size_t> IndexDelayed;
 
     /*! Delay used for GetIndexDelayed and GetDelayed.  In number of
       rows in state tables. */
@@ -275,8 +359,31 @@ public:
     std::vector<AccessorBase *> StateVectorAccessors;
 
     /*! The vector contains the time stamp in counts or ticks per
-      period of the task that the state table is associated with. */
-    std::vector<mtsStateIndex::TimeTicksType> Ticks;
+      period of the task that the state table is associated with.
+      The ticks of a row are also used as a sequence number by the
+      readers to detect that the row has been overwritten, see
+      ValidateReadIndex. */
+    typedef CopyableAtomic<mtsStateIndex::TimeTicksType> TicksType;
+    std::vector<TicksType> Ticks;
+
+    /*! Number of times readers had to read a row again because it
+      was overwritten by the writer, see ReadLatest and
+      GetLatestBatch.  Counter is reset on copy so the table (and
+      components owning a table) remain copyable. */
+    class ReadRetriesCounter: public std::atomic<size_t> {
+    public:
+        inline ReadRetriesCounter(const size_t value = 0):
+            std::atomic<size_t>(value)
+        {}
+        inline ReadRetriesCounter(const ReadRetriesCounter &):
+            std::atomic<size_t>(0)
+        {}
+        inline ReadRetriesCounter & operator = (const ReadRetriesCounter &) {
+            this->store(0);
+            return *this;
+        }
+    };
+    mutable ReadRetriesCounter NumberOfReadRetries;
 
     /*! The state table indices for Tic, Toc, and Period. */
     mtsStateDataId TicId, TocId;
@@ -343,9 +450,59 @@ public:
     /*! Set delay in number of rows. */
     size_t SetDelay(size_t newDelay);
 
-    /*! Verifies if the data is valid. */
+    /*! Verifies if the data is valid.  This must be called after the
+      data has been read, the fence prevents the reads of data to be
+      moved after the load of the ticks. */
     inline bool ValidateReadIndex(const mtsStateIndex &timeIndex) const {
-        return (Ticks[timeIndex.Index()] == timeIndex.Ticks());
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return (Ticks[timeIndex.Index()].load(std::memory_order_relaxed) == timeIndex.Ticks());
+    }
+
+    /*! Read the latest row in place.  This is similar to a seqlock,
+      the reader is called with a Snapshot of the latest row and, if
+      the row has been overwritten while the reader was using it, the
+      reader is called again with the new latest row, up to
+      maxRetries times.  Any number of readers can use this method
+      concurrently and the writer never waits for them.  The reader
+      must be a callable object taking a const Snapshot reference; it
+      should be short and must not keep pointers on the elements of
+      the snapshot.  Since the reader might see partially written
+      data, it should only copy or compute from the elements and its
+      results should be discarded if ReadLatest returns false.  The
+      elements read must not be reallocated by the writer, see
+      Snapshot.
+
+      \code
+      double position;
+      bool valid = table.ReadLatest([&](const mtsStateTable::Snapshot & snapshot) {
+              position = snapshot.Get<mtsDouble>(positionId)->Data;
+          });
+      \endcode
+
+      \returns true if the reader completed on a consistent row. */
+    template <class _readerType>
+    bool ReadLatest(_readerType reader, const size_t maxRetries = 10) const;
+
+    /*! Copy many elements from the same row and validate the index
+      only once.  Elements are identified by their Id (see
+      GetStateVectorID) and data must contain one object per Id, of
+      the same type as the corresponding element.  Returns false if
+      the index is not valid anymore or if the types don't match. */
+    bool GetBatch(const mtsStateIndex & when,
+                  const std::vector<mtsStateDataId> & ids,
+                  const std::vector<mtsGenericObject *> & data) const;
+
+    /*! Copy many elements from the latest row, see GetBatch.  If the
+      row is overwritten during the copy, the copy is performed again
+      on the new latest row, up to maxRetries times. */
+    bool GetLatestBatch(const std::vector<mtsStateDataId> & ids,
+                        const std::vector<mtsGenericObject *> & data,
+                        const size_t maxRetries = 10) const;
+
+    /*! Number of times readers had to start over since the table was
+      created, see ReadLatest and GetLatestBatch. */
+    inline size_t GetNumberOfReadRetries(void) const {
+        return NumberOfReadRetries.load(std::memory_order_relaxed);
     }
 
     /*! Get method for auto advance flag. See AutomaticAdvanceFlag */
@@ -551,6 +708,23 @@ mtsStateDataId mtsStateTable::NewElement(const std::string & name, _elementType
     return id;
 }
 
+template <class _readerType>
+bool mtsStateTable::ReadLatest(_readerType reader, const size_t maxRetries) const
+{
+    Snapshot snapshot(this);
+    for (size_t attempt = 0; attempt <= maxRetries; ++attempt) {
+        if (attempt != 0) {
+            NumberOfReadRetries.fetch_add(1, std::memory_order_relaxed);
+        }
+        snapshot.Index = GetIndexReader();
+        reader(static_cast<const Snapshot &>(snapshot));
+        if (snapshot.IsValid()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 template <class _elementType>
 mtsStateTable::AccessorBase *mtsStateTable::GetAccessorByInstance(const _elementType & element) const
 {
@@ -283,7 +283,7 @@ public:
     void ProcessManagerCommandsIfNotActive();
 
     /*! Returns true if currently executing in thread-space of component. */
-    bool CheckForOwnThread(void) const;
+    virtual bool CheckForOwnThread(void) const;
 
     /********************* Methods for task period and overrun ************/
 
@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2009-12-10
 
-  (C) Copyright 2009-2023 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -28,12 +28,22 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstCommon/cmnPortability.h>
 #include <cisstMultiTask/mtsForwardDeclarations.h>
 #include <cisstMultiTask/mtsTaskContinuous.h>
+#include <cisstMultiTask/mtsExecutorPool.h>
 
 // Always include last
 #include <cisstMultiTask/mtsExport.h>
 
 /*!
   \ingroup cisstMultiTask
+
+  Task with a Run method triggered by signals, i.e. any queued command
+  or event.  By default, each task has its own thread waiting for a
+  signal.  If an executor pool has been created in the component
+  manager (see mtsManagerLocal::SetExecutorPool) when the task is
+  created, the task doesn't create a thread and is scheduled as a job
+  on the pool instead.  The pool guarantees that Startup, Run and
+  Cleanup are never called concurrently for a given task.  Tasks with
+  long blocking calls in Run should opt out using SetUseExecutorPool.
 */
 
 class CISST_EXPORT mtsTaskFromSignal: public mtsTaskContinuous
@@ -57,6 +67,31 @@ class CISST_EXPORT mtsTaskFromSignal: public mtsTaskContinuous
     /*! Callable created around the PostCommandQueuedMethod. */
     mtsCallableVoidBase * PostCommandQueuedCallable;
 
+    /*! Job used to schedule this task on an executor pool. */
+    class CISST_EXPORT ExecutorJobType: public mtsExecutorPool::Job {
+        mtsTaskFromSignal * Task;
+    public:
+        inline ExecutorJobType(mtsTaskFromSignal * task):
+            Task(task)
+        {}
+        void Execute(void) override;
+    };
+    ExecutorJobType ExecutorJob;
+
+    /*! Executor pool used by this task, null if the task has its own
+      thread. */
+    mtsExecutorPool * ExecutorPool;
+
+    /*! Allow use of executor pool, true by default. */
+    bool UseExecutorPool;
+
+    /*! Method called by the executor pool's threads, performs a
+      single iteration of RunInternal based on the current state. */
+    void RunFromExecutorPool(void);
+
+    /* documented in base class */
+    void StartInternal(void) override;
+
  public:
     /*! Create a task with name 'name' and set the state table size.
 
@@ -73,12 +108,34 @@ class CISST_EXPORT mtsTaskFromSignal: public mtsTaskContinuous
 
     mtsTaskFromSignal(const mtsTaskConstructorArg & arg);
 
-    /*! Default Destructor. */
-    virtual ~mtsTaskFromSignal() {}
+    /*! Destructor.  If the task uses an executor pool, waits until
+      the task is not scheduled anymore. */
+    virtual ~mtsTaskFromSignal();
+
+    /*! Allow or prevent use of the component manager's executor pool.
+      This must be called before the task is created.  Tasks with
+      long blocking calls in Run should not use the pool. */
+    void SetUseExecutorPool(const bool useExecutorPool);
+
+    /*! True if the task is executed by an executor pool. */
+    inline bool IsUsingExecutorPool(void) const {
+        return (ExecutorPool != 0);
+    }
+
+    /* documented in base class */
+    void Create(void * data = 0) override;
 
     /* documented in base class */
     void Kill(void) override;
 
+    /* documented in base class */
+    void Wakeup(void) override;
+
+    /*! Returns true if currently executing in thread-space of
+      component.  When the task uses an executor pool, this is the
+      pool's thread currently running the task, if any. */
+    bool CheckForOwnThread(void) const override;
+
     /* documented in base class */
     mtsInterfaceRequired * AddInterfaceRequiredWithoutSystemEventHandlers(const std::string & interfaceRequiredName,
                                                                           mtsRequiredType required = MTS_REQUIRED) override;
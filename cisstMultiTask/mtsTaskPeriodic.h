@@ -5,7 +5,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides, Anton Deguet
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2023 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -26,6 +26,7 @@ http://www.cisst.org/cisst/license.txt.
 #define _mtsTaskPeriodic_h
 
 #include <cisstMultiTask/mtsTaskContinuous.h>
+#include <cisstMultiTask/mtsTaskPeriodicStatistics.h>
 #include <cisstOSAbstraction/osaThreadBuddy.h>
 #include <cisstOSAbstraction/osaTimeServer.h>
 
@@ -64,6 +65,9 @@ class CISST_EXPORT mtsTaskPeriodic : public mtsTaskContinuous
       time systems. */
     bool IsHardRealTime;
 
+    /*! Wake up latency and compute time histograms, overruns. */
+    mtsTaskPeriodicStatisticsRecorder TimingStatistics;
+
     /********************* Methods that call user methods *****************/
 
     /*! The member function that is passed as 'start routine' argument for
@@ -130,6 +134,31 @@ class CISST_EXPORT mtsTaskPeriodic : public mtsTaskContinuous
       the thread was created with a period > 0. */
     bool IsPeriodic(void) const override;
 
+    /*! Use absolute wake up times and optionally busy-wait for the
+      last spinTime seconds before each wake up to reduce the wake up
+      jitter.  Spinning should only be used if the task's thread runs
+      on an isolated core.  See osaThreadBuddy::SetAbsoluteTimeWait
+      for details and supported OSs.  This method must be called
+      before the task is created. */
+    void SetAbsoluteTimeWait(const bool absoluteTime, const double spinTime = 0.0);
+
+    /********************* Methods for timing statistics ******************/
+
+    /*! Get the wake up latency and compute time histograms as well as
+      overrun counts since the task started or since the last call to
+      ResetTimingStatistics.  Can be called from any thread, e.g. as a
+      read command added to a provided interface:
+      \code
+      interfaceProvided->AddCommandRead(&mtsTaskPeriodic::GetTimingStatistics, this,
+                                        "GetTimingStatistics");
+      \endcode
+    */
+    void GetTimingStatistics(mtsTaskPeriodicStatistics & statistics) const;
+
+    /*! Reset timing statistics.  The reset is performed by the task
+      at the end of its next iteration. */
+    void ResetTimingStatistics(void);
+
 };
 
 
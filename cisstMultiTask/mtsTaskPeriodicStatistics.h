@@ -0,0 +1,189 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+/*!
+  \file
+  \brief Timing histograms for periodic tasks
+*/
+
+#ifndef _mtsTaskPeriodicStatistics_h
+#define _mtsTaskPeriodicStatistics_h
+
+#include <cisstMultiTask/mtsGenericObject.h>
+#include <cisstMultiTask/mtsHistogramRecorder.h>
+
+#include <atomic>
+
+// Always include last
+#include <cisstMultiTask/mtsExport.h>
+
+/*!
+  \ingroup cisstMultiTask
+
+  Timing statistics for a periodic task (see
+  mtsTaskPeriodic::GetTimingStatistics).  Contrary to
+  mtsIntervalStatistics which provides the average, standard
+  deviation, min and max over a given time interval, this class
+  provides histograms accumulated since the task started (or since the
+  last reset) so tail latencies (e.g. 99.9th percentile) can be
+  estimated.
+
+  Histograms use a fixed number of bins with a constant relative
+  precision, similar to HDR histograms.  Durations are converted to
+  nano seconds, values under SUB_BINS nano seconds have their own bin
+  and each following power of 2 is divided in SUB_BINS bins, so the
+  error on a value is less than 1 / SUB_BINS (about 3%).  Durations
+  over 2^MAX_EXPONENT nano seconds (about 4 seconds) all go in the
+  last bin.
+
+  The wake up latency is the difference between the time the thread
+  should have woken up and the time it actually woke up (see
+  osaThreadBuddy::GetWakeUpLatency).  The compute time is the time
+  spent in the task's Run method, including the processing of queued
+  commands.  An overrun happens when the compute time is greater than
+  the period, i.e. the task missed its deadline.
+*/
+class CISST_EXPORT mtsTaskPeriodicStatistics: public mtsGenericObject
+{
+    CMN_DECLARE_SERVICES(CMN_DYNAMIC_CREATION, CMN_LOG_ALLOW_DEFAULT);
+
+public:
+    /*! Base type */
+    typedef mtsGenericObject BaseType;
+
+    /*! Histogram layout. */
+    enum {SUB_BIN_BITS = 5,
+          SUB_BINS = 1 << SUB_BIN_BITS,
+          MAX_EXPONENT = 32,
+          NUMBER_OF_BINS = (MAX_EXPONENT - SUB_BIN_BITS + 1) * SUB_BINS};
+
+    /*! Find bin for a given duration in seconds. */
+    static size_t Bin(const double duration);
+
+    /*! Lower and upper bounds of a bin in seconds. */
+    //@{
+    static double BinLowerBound(const size_t bin);
+    static double BinUpperBound(const size_t bin);
+    //@}
+
+    /*! Histogram with summary values. */
+    class CISST_EXPORT HistogramType {
+    public:
+        HistogramType(void);
+
+        unsigned long long NumberOfSamples;
+        double Sum;
+        double Min;
+        double Max;
+        unsigned long long Bins[NUMBER_OF_BINS];
+
+        double Avg(void) const;
+
+        /*! Estimate a percentile, e.g. 0.999.  The value returned is
+          the upper bound of the bin containing the percentile, bound
+          by the maximum value recorded. */
+        double Percentile(const double percentile) const;
+
+        void Reset(void);
+    };
+
+    /*! Wake up latency and compute time histograms. */
+    //@{
+    HistogramType WakeUpLatency;
+    HistogramType ComputeTime;
+    //@}
+
+    /*! Number of iterations with a compute time greater than the
+      period. */
+    unsigned long long NumberOfOverruns;
+
+    /*! Number of consecutive overruns up to the last iteration and
+      longest streak of consecutive overruns. */
+    //@{
+    unsigned long long CurrentOverrunStreak;
+    unsigned long long LongestOverrunStreak;
+    //@}
+
+    /*! Number of periods skipped, only available when using absolute
+      wake up times (see mtsTaskPeriodic::SetAbsoluteTimeWait). */
+    unsigned long long NumberOfMissedPeriods;
+
+    mtsTaskPeriodicStatistics(void);
+    inline ~mtsTaskPeriodicStatistics() {}
+
+    /*! Human readable text output */
+    void ToStream(std::ostream & outputStream) const override;
+
+    /*! To stream raw data, summary values and percentiles only. */
+    void ToStreamRaw(std::ostream & outputStream, const char delimiter = ' ',
+                     bool headerOnly = false, const std::string & headerPrefix = "") const override;
+
+    /*! Binary serialization */
+    void SerializeRaw(std::ostream & outputStream) const override;
+
+    /*! Binary deserialization */
+    void DeSerializeRaw(std::istream & inputStream) override;
+};
+
+CMN_DECLARE_SERVICES_INSTANTIATION(mtsTaskPeriodicStatistics);
+
+
+/*!
+  \ingroup cisstMultiTask
+
+  Recorder for the timing statistics of a periodic task.  Record is
+  called by the task's thread (single writer) at the end of each
+  iteration while Get and Reset can be called from any thread, see
+  mtsHistogramRecorder.  All the memory is allocated at construction
+  so no lock nor allocation is needed.  Reset only sets a flag, the
+  actual reset is performed by the writer on the next call to Record.
+*/
+class CISST_EXPORT mtsTaskPeriodicStatisticsRecorder
+{
+    typedef mtsHistogramRecorder<mtsTaskPeriodicStatistics> HistogramRecorderType;
+    HistogramRecorderType WakeUpLatency;
+    HistogramRecorderType ComputeTime;
+    std::atomic<unsigned long long> NumberOfOverruns;
+    std::atomic<unsigned long long> CurrentOverrunStreak;
+    std::atomic<unsigned long long> LongestOverrunStreak;
+    std::atomic<unsigned long long> NumberOfMissedPeriods;
+    std::atomic<bool> ResetRequested;
+
+    void ResetAll(void);
+
+    // copy not allowed
+    mtsTaskPeriodicStatisticsRecorder(const mtsTaskPeriodicStatisticsRecorder &);
+    mtsTaskPeriodicStatisticsRecorder & operator = (const mtsTaskPeriodicStatisticsRecorder &);
+
+public:
+    mtsTaskPeriodicStatisticsRecorder(void);
+
+    /*! Record one iteration, durations in seconds.  Single writer
+      only. */
+    void Record(const double wakeUpLatency, const double computeTime,
+                const bool overrun, const unsigned int missedPeriods);
+
+    /*! Copy statistics, can be called from any thread. */
+    void Get(mtsTaskPeriodicStatistics & statistics) const;
+
+    /*! Request a reset, performed by the writer on the next call to
+      Record. */
+    void Reset(void);
+};
+
+#endif // _mtsTaskPeriodicStatistics_h
@@ -5,7 +5,7 @@
   Author(s):	Anton Deguet
   Created on:   2008-02-05
 
-  (C) Copyright 2008-2023 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2008-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -22,6 +22,7 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstCommon/cmnClassRegister.h>
 #include <cisstVector/vctDynamicVector.h>
+#include <cisstVector/vctDataFunctionsDynamicVector.h>
 #include <cisstMultiTask/mtsForwardDeclarations.h>
 
 // Always include last
@@ -111,6 +112,35 @@ public:
         VectorType::ToStreamRaw(outputStream, delimiter, headerOnly, headerPrefix);
     }
 
+    /*! Scalars, starting with the ones from mtsGenericObject
+      (timestamps and valid flag) followed by the vector size and
+      elements. */
+    //@{
+    size_t ScalarNumber(void) const override {
+        return mtsGenericObject::ScalarNumber() + cmnData<VectorType>::ScalarNumber(*this);
+    }
+
+    bool ScalarNumberIsFixed(void) const override {
+        return false;
+    }
+
+    double Scalar(const size_t index) const CISST_THROW(std::out_of_range) override {
+        const size_t baseNumber = mtsGenericObject::ScalarNumber();
+        if (index < baseNumber) {
+            return mtsGenericObject::Scalar(index);
+        }
+        return cmnData<VectorType>::Scalar(*this, index - baseNumber);
+    }
+
+    std::string ScalarDescription(const size_t index, const std::string & userDescription = "") const CISST_THROW(std::out_of_range) override {
+        const size_t baseNumber = mtsGenericObject::ScalarNumber();
+        if (index < baseNumber) {
+            return mtsGenericObject::ScalarDescription(index, userDescription);
+        }
+        return cmnData<VectorType>::ScalarDescription(*this, index - baseNumber, userDescription);
+    }
+    //@}
+
     /*! Binary serialization */
     void SerializeRaw(std::ostream & outputStream) const override
     {
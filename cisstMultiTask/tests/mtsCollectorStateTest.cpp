@@ -20,9 +20,14 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstMultiTask/mtsManagerLocal.h>
 #include <cisstMultiTask/mtsCollectorState.h>
+#include <cisstMultiTask/mtsCollectorStateColumnarReader.h>
 
 #include "mtsTestComponents.h"
 
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
 
 mtsCollectorStateTest::mtsCollectorStateTest()
 {
@@ -283,4 +288,136 @@ void mtsCollectorStateTest::TestFromSignal_int(void) {
     mtsCollectorStateTest::TestFromSignal<int>();
 }
 
+
+void mtsCollectorStateTest::TestColumnarWriter(void)
+{
+    const std::string fileName = "StateDataCollectionUnitTest.ccol";
+    const std::string textFileName = "StateDataCollectionUnitTest-converted.csv";
+    const size_t numberOfColumns = 2;
+    const size_t numberOfRows = 1000;
+
+    // small pages and only 2 of them to test page rotation
+    mtsCollectorStateColumnarWriter writer;
+    CPPUNIT_ASSERT(writer.Open(fileName,
+                               "component test\ncolumn Ticks\ncolumn a\ncolumn b\nend\n",
+                               numberOfColumns, 4096, 2));
+    CPPUNIT_ASSERT(writer.IsOpen());
+    const size_t rowsPerPage = writer.GetRowsPerPage();
+    CPPUNIT_ASSERT_EQUAL(mtsCollectorStateColumnarFormat::RowsPerPage(4096, numberOfColumns), rowsPerPage);
+
+    size_t row = 0;
+    while (row < numberOfRows) {
+        // add rows by small batches
+        const size_t requested = std::min(static_cast<size_t>(7), numberOfRows - row);
+        const size_t count = writer.BeginRows(requested);
+        CPPUNIT_ASSERT(count > 0);
+        CPPUNIT_ASSERT(count <= requested);
+        for (size_t index = 0; index < count; ++index) {
+            writer.Ticks()[index] = row + index;
+            writer.Column(0)[index] = 0.5 * (row + index);
+            writer.Column(1)[index] = -1.0 * (row + index);
+        }
+        writer.EndRows(count);
+        row += count;
+    }
+    CPPUNIT_ASSERT(writer.Close());
+    CPPUNIT_ASSERT(!writer.IsOpen());
+    const size_t numberOfPages = (row + rowsPerPage - 1) / rowsPerPage;
+    CPPUNIT_ASSERT_EQUAL(numberOfPages, writer.GetNumberOfPagesWritten());
+
+    // convert and check content
+    CPPUNIT_ASSERT(mtsCollectorState::ConvertBinaryToText(fileName, textFileName, ','));
+    std::ifstream text(textFileName.c_str());
+    std::string line;
+    size_t rowsRead = 0;
+    while (std::getline(text, line)) {
+        if (line[0] == '#') {
+            continue;
+        }
+        unsigned long long tick;
+        double a, b;
+        char comma;
+        std::stringstream rowStream(line);
+        rowStream >> tick >> comma >> a >> comma >> b;
+        CPPUNIT_ASSERT(!rowStream.fail());
+        CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(rowsRead), tick);
+        CPPUNIT_ASSERT_EQUAL(0.5 * rowsRead, a);
+        CPPUNIT_ASSERT_EQUAL(-1.0 * rowsRead, b);
+        rowsRead++;
+    }
+    CPPUNIT_ASSERT_EQUAL(numberOfRows, rowsRead);
+}
+
+
+void mtsCollectorStateTest::TestColumnarReader(void)
+{
+    const std::string fileName = "StateDataCollectionUnitTest-reader.ccol";
+    const size_t numberOfRows = 1000;
+
+    // write a file with a partial page in the middle
+    mtsCollectorStateColumnarWriter writer;
+    CPPUNIT_ASSERT(writer.Open(fileName,
+                               "component test\ncolumn Ticks\ncolumn TocValid\ncolumn Toc:{d}\nend\n",
+                               2, 4096, 4));
+    size_t row = 0;
+    while (row < numberOfRows) {
+        const size_t count = writer.BeginRows(numberOfRows - row);
+        for (size_t index = 0; index < count; ++index) {
+            writer.Ticks()[index] = 10 * (row + index);
+            writer.Column(0)[index] = 1.0;
+            writer.Column(1)[index] = 0.001 * (row + index);
+        }
+        writer.EndRows(count);
+        row += count;
+        if ((row > 300) && (row < 400)) {
+            writer.Flush();
+        }
+    }
+    CPPUNIT_ASSERT(writer.Close());
+
+    mtsCollectorStateColumnarReader reader;
+    CPPUNIT_ASSERT(!reader.Open("this-file-does-not-exist.ccol"));
+    CPPUNIT_ASSERT(reader.Open(fileName));
+    CPPUNIT_ASSERT(reader.IsOpen());
+    CPPUNIT_ASSERT_EQUAL(numberOfRows, reader.GetNumberOfRows());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), reader.GetNumberOfColumns());
+    CPPUNIT_ASSERT_EQUAL(std::string("test"), reader.GetHeaderValue("component"));
+    CPPUNIT_ASSERT_EQUAL(std::string("TocValid"), reader.GetColumnName(0));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), reader.GetColumnIndex("Toc"));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), reader.GetColumnIndex("Toc:{d}"));
+    CPPUNIT_ASSERT_EQUAL(mtsCollectorStateColumnarReader::InvalidIndex, reader.GetColumnIndex("To"));
+
+    // page based access
+    size_t rowsInPages = 0;
+    for (size_t page = 0; page < reader.GetNumberOfPages(); ++page) {
+        const unsigned long long * ticks = reader.GetTicks(page);
+        const double * toc = reader.GetColumn(page, 1);
+        for (size_t index = 0; index < reader.GetNumberOfRowsInPage(page); ++index) {
+            CPPUNIT_ASSERT_EQUAL(10ULL * (rowsInPages + index), ticks[index]);
+            CPPUNIT_ASSERT_EQUAL(0.001 * (rowsInPages + index), toc[index]);
+        }
+        rowsInPages += reader.GetNumberOfRowsInPage(page);
+    }
+    CPPUNIT_ASSERT_EQUAL(numberOfRows, rowsInPages);
+
+    // random access
+    for (row = 0; row < numberOfRows; row += 37) {
+        CPPUNIT_ASSERT_EQUAL(10ULL * row, reader.GetTick(row));
+        CPPUNIT_ASSERT_EQUAL(1.0, reader.GetValue(row, 0));
+        CPPUNIT_ASSERT_EQUAL(0.001 * row, reader.GetValue(row, 1));
+    }
+
+    // seek
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), reader.FindRowByTicks(0));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(500), reader.FindRowByTicks(5000));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(501), reader.FindRowByTicks(5001));
+    CPPUNIT_ASSERT_EQUAL(numberOfRows, reader.FindRowByTicks(100000));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(351), reader.FindRowByTime(0.3505));
+    CPPUNIT_ASSERT_EQUAL(numberOfRows, reader.FindRowByTime(2.0));
+
+    reader.Close();
+    CPPUNIT_ASSERT(!reader.IsOpen());
+}
+
+
 CPPUNIT_TEST_SUITE_REGISTRATION(mtsCollectorStateTest);
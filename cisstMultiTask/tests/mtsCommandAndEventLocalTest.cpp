@@ -5,7 +5,7 @@
   Author(s):  Min Yang Jung, Anton Deguet
   Created on: 2009-11-17
 
-  (C) Copyright 2009-2022 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -19,6 +19,9 @@ http://www.cisst.org/cisst/license.txt.
 #include "mtsCommandAndEventLocalTest.h"
 
 #include <cisstMultiTask/mtsManagerLocal.h>
+#include <cisstMultiTask/mtsExecutorPool.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaGetTime.h>
 
 #include "mtsTestComponents.h"
 
@@ -710,4 +713,259 @@ void mtsCommandAndEventLocalTest::TestArgumentPrototypes_int(void) {
 }
 
 
+void mtsCommandAndEventLocalTest::TestCommandStatistics(void)
+{
+    // histogram bins, 0 is under 1 micro-second, i for [2^(i-1), 2^i[
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), mtsCommandStatistics::Bin(0.5 * cmn_us));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), mtsCommandStatistics::Bin(1.5 * cmn_us));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4), mtsCommandStatistics::Bin(10.0 * cmn_us));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(mtsCommandStatistics::NUMBER_OF_BINS - 1),
+                         mtsCommandStatistics::Bin(1000.0 * cmn_s));
+    CPPUNIT_ASSERT(mtsCommandStatistics::BinUpperBound(4) > 10.0 * cmn_us);
+
+    mtsTestPeriodic1<mtsInt> * client = new mtsTestPeriodic1<mtsInt>("mtsTestPeriodic1Client");
+    mtsTestPeriodic1<mtsInt> * server = new mtsTestPeriodic1<mtsInt>("mtsTestPeriodic1Server");
+    mtsInterfaceProvided * provided = server->GetInterfaceProvided("p1");
+    CPPUNIT_ASSERT(provided);
+    provided->EnableCommandStatistics();
+    CPPUNIT_ASSERT(provided->GetCommandStatisticsEnabled());
+
+    mtsManagerLocal * manager = mtsManagerLocal::GetInstance();
+    manager->RemoveAllUserComponents();
+    CPPUNIT_ASSERT(manager->AddComponent(client));
+    CPPUNIT_ASSERT(manager->AddComponent(server));
+    CPPUNIT_ASSERT(manager->Connect(client->GetName(), "r1", server->GetName(), "p1"));
+    manager->CreateAll();
+    CPPUNIT_ASSERT(manager->WaitForStateAll(mtsComponentState::READY, StateTransitionMaximumDelay));
+    manager->StartAll();
+    CPPUNIT_ASSERT(manager->WaitForStateAll(mtsComponentState::ACTIVE, StateTransitionMaximumDelay));
+
+    const unsigned int numberOfVoid = 5;
+    const unsigned int numberOfWrite = 3;
+    unsigned int index;
+    for (index = 0; index < numberOfVoid; index++) {
+        CPPUNIT_ASSERT(client->InterfaceRequired1.FunctionVoid.ExecuteBlocking().IsOK());
+    }
+    for (index = 0; index < numberOfWrite; index++) {
+        CPPUNIT_ASSERT(client->InterfaceRequired1.FunctionWrite.ExecuteBlocking(mtsInt(index)).IsOK());
+    }
+
+    // statistics are available to other components using the read command
+    mtsInterfaceProvided * endUser = provided->GetEndUserInterface("TestCommandStatistics");
+    CPPUNIT_ASSERT(endUser);
+    mtsCommandRead * statisticsCommand = endUser->GetCommandRead("GetCommandStatistics");
+    CPPUNIT_ASSERT(statisticsCommand);
+    mtsCommandStatistics statistics;
+    CPPUNIT_ASSERT(statisticsCommand->Execute(statistics).IsOK());
+    CPPUNIT_ASSERT(statistics.Valid());
+    CPPUNIT_ASSERT(statistics.NumberOfCycles > 0);
+    // cycle statistics are recorded after the blocking commands return
+    CPPUNIT_ASSERT(statistics.CommandsMaxPerCycle >= 1);
+    bool voidFound = false;
+    bool writeFound = false;
+    for (index = 0; index < statistics.Commands.size(); index++) {
+        const mtsCommandStatistics::CommandType & command = statistics.Commands[index];
+        // one entry per client, including the end-user interface created above
+        if (command.UserName != "r1") {
+            CPPUNIT_ASSERT_EQUAL(std::string("TestCommandStatistics"), command.UserName);
+            CPPUNIT_ASSERT_EQUAL(0ULL, command.NumberOfExecutions);
+        } else if (command.CommandName == "Void") {
+            voidFound = true;
+            CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(numberOfVoid), command.NumberOfExecutions);
+            CPPUNIT_ASSERT(command.QueueTimeSum > 0.0);
+            CPPUNIT_ASSERT(command.QueueTimeMax <= 1.0 * cmn_s);
+            CPPUNIT_ASSERT(command.ExecutionTimeMax >= command.ExecutionTimeAvg());
+            CPPUNIT_ASSERT(command.ExecutionTimePercentile(1.0) >= command.ExecutionTimeMax);
+        } else if (command.CommandName == "Write") {
+            writeFound = true;
+            CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(numberOfWrite), command.NumberOfExecutions);
+        }
+    }
+    CPPUNIT_ASSERT(voidFound);
+    CPPUNIT_ASSERT(writeFound);
+    CPPUNIT_ASSERT(statistics.MostExpensiveCommand() < statistics.Commands.size());
+
+    // serialization round trip
+    std::stringstream stream;
+    statistics.SerializeRaw(stream);
+    mtsCommandStatistics copy;
+    copy.DeSerializeRaw(stream);
+    CPPUNIT_ASSERT_EQUAL(statistics.Commands.size(), copy.Commands.size());
+    CPPUNIT_ASSERT_EQUAL(statistics.NumberOfCommands, copy.NumberOfCommands);
+    CPPUNIT_ASSERT_EQUAL(statistics.Commands[0].CommandName, copy.Commands[0].CommandName);
+    CPPUNIT_ASSERT_EQUAL(statistics.Commands[0].ExecutionTimeHistogram[2], copy.Commands[0].ExecutionTimeHistogram[2]);
+
+    // stop all and cleanup
+    manager->KillAll();
+    CPPUNIT_ASSERT(manager->WaitForStateAll(mtsComponentState::FINISHED, StateTransitionMaximumDelay));
+    CPPUNIT_ASSERT(manager->Disconnect(client->GetName(), "r1", server->GetName(), "p1"));
+    CPPUNIT_ASSERT(manager->RemoveComponent(client));
+    CPPUNIT_ASSERT(manager->RemoveComponent(server));
+    delete client;
+    delete server;
+}
+
+
+const size_t mtsCommandAndEventLocalTestNumberOfProducers = 4;
+const size_t mtsCommandAndEventLocalTestNumberOfCommands = 2000; // per producer
+
+// commands are executed by the thread calling ProcessMailBoxes
+class mtsCommandAndEventLocalTestCounter {
+public:
+    size_t NumberOfVoid;
+    int Sum;
+    mtsCommandAndEventLocalTestCounter(void):
+        NumberOfVoid(0),
+        Sum(0)
+    {}
+    void Void(void) {
+        NumberOfVoid++;
+    }
+    void Write(const mtsInt & value) {
+        Sum += value.Data;
+    }
+};
+
+struct mtsCommandAndEventLocalTestProducerData {
+    mtsInterfaceProvided * EndUserInterface;
+    int Id;
+};
+
+void * mtsCommandAndEventLocalTestProducer(mtsCommandAndEventLocalTestProducerData * data)
+{
+    // alternate void and write commands, retry if the mailbox is full
+    mtsCommandVoid * commandVoid = data->EndUserInterface->GetCommandVoid("Void");
+    mtsCommandWriteBase * commandWrite = data->EndUserInterface->GetCommandWrite("Write");
+    const mtsInt argument(data->Id);
+    size_t index = 0;
+    while (index < mtsCommandAndEventLocalTestNumberOfCommands) {
+        mtsExecutionResult result;
+        if (index % 2) {
+            result = commandWrite->Execute(argument, MTS_NOT_BLOCKING);
+        } else {
+            result = commandVoid->Execute(MTS_NOT_BLOCKING);
+        }
+        if (result.IsOK()) {
+            index++;
+        } else {
+            osaSleep(10.0 * cmn_us);
+        }
+    }
+    return 0;
+}
+
+
+void mtsCommandAndEventLocalTest::TestSharedMailBox(void)
+{
+    // the test plays the role of the server thread, the task is never started
+    mtsTestPeriodic1<mtsInt> * server = new mtsTestPeriodic1<mtsInt>("mtsTestPeriodic1Server");
+    mtsInterfaceProvided * provided = server->AddInterfaceProvided("Shared");
+    CPPUNIT_ASSERT(provided);
+    provided->SetMailBoxAndArgumentQueuesSize(32);
+    provided->SetMailBoxShared(true);
+    CPPUNIT_ASSERT(provided->GetMailBoxShared());
+    mtsCommandAndEventLocalTestCounter counter;
+    CPPUNIT_ASSERT(provided->AddCommandVoid(&mtsCommandAndEventLocalTestCounter::Void, &counter, "Void"));
+    CPPUNIT_ASSERT(provided->AddCommandWrite(&mtsCommandAndEventLocalTestCounter::Write, &counter, "Write"));
+
+    // one end-user interface and thread per producer, all using the same mailbox
+    mtsCommandAndEventLocalTestProducerData data[mtsCommandAndEventLocalTestNumberOfProducers];
+    osaThread producers[mtsCommandAndEventLocalTestNumberOfProducers];
+    size_t index;
+    int expectedSum = 0;
+    for (index = 0; index < mtsCommandAndEventLocalTestNumberOfProducers; index++) {
+        std::stringstream userName;
+        userName << "Producer" << index;
+        data[index].EndUserInterface = provided->GetEndUserInterface(userName.str());
+        CPPUNIT_ASSERT(data[index].EndUserInterface);
+        CPPUNIT_ASSERT(data[index].EndUserInterface->GetMailBox() == provided->SharedMailBox);
+        data[index].Id = static_cast<int>(index + 1);
+        expectedSum += data[index].Id * static_cast<int>(mtsCommandAndEventLocalTestNumberOfCommands / 2);
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<int>(mtsCommandAndEventLocalTestNumberOfProducers), provided->GetNumberOfEndUsers());
+    for (index = 0; index < mtsCommandAndEventLocalTestNumberOfProducers; index++) {
+        producers[index].Create(mtsCommandAndEventLocalTestProducer, &(data[index]));
+    }
+    const size_t total = mtsCommandAndEventLocalTestNumberOfProducers * mtsCommandAndEventLocalTestNumberOfCommands;
+    size_t executed = 0;
+    const double timeout = osaGetTime() + 10.0 * cmn_s;
+    while ((executed < total) && (osaGetTime() < timeout)) {
+        const size_t numberOfCommands = provided->ProcessMailBoxes();
+        if (numberOfCommands == 0) {
+            osaSleep(10.0 * cmn_us);
+        }
+        executed += numberOfCommands;
+    }
+    for (index = 0; index < mtsCommandAndEventLocalTestNumberOfProducers; index++) {
+        producers[index].Wait();
+    }
+    CPPUNIT_ASSERT_EQUAL(total, executed);
+    CPPUNIT_ASSERT_EQUAL(total / 2, counter.NumberOfVoid);
+    CPPUNIT_ASSERT_EQUAL(expectedSum, counter.Sum);
+    CPPUNIT_ASSERT(provided->SharedMailBox->IsEmpty());
+
+    // removing an end-user interface while its commands are still
+    // queued, the interface can't be deleted until they are executed
+    mtsInterfaceProvided * endUser = data[0].EndUserInterface;
+    const size_t queued = 10;
+    for (index = 0; index < queued; index++) {
+        CPPUNIT_ASSERT(endUser->GetCommandVoid("Void")->Execute(MTS_NOT_BLOCKING).IsOK());
+    }
+    CPPUNIT_ASSERT(provided->RemoveEndUserInterface(endUser, "Producer0") == 0);
+    CPPUNIT_ASSERT(provided->FindEndUserInterfaceByName("Producer0") == 0);
+    CPPUNIT_ASSERT_EQUAL(static_cast<int>(mtsCommandAndEventLocalTestNumberOfProducers - 1), provided->GetNumberOfEndUsers());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), provided->InterfacesProvidedRemoved.size());
+    // commands from other users queued after the removal
+    CPPUNIT_ASSERT(data[1].EndUserInterface->GetCommandVoid("Void")->Execute(MTS_NOT_BLOCKING).IsOK());
+    CPPUNIT_ASSERT_EQUAL(queued + 1, provided->ProcessMailBoxes());
+    CPPUNIT_ASSERT_EQUAL(total / 2 + queued + 1, counter.NumberOfVoid);
+    CPPUNIT_ASSERT(provided->InterfacesProvidedRemoved.empty());
+
+    // without queued commands, the end-user interface is deleted right away
+    for (index = 1; index < mtsCommandAndEventLocalTestNumberOfProducers; index++) {
+        CPPUNIT_ASSERT(provided->RemoveEndUserInterface(data[index].EndUserInterface, "Producer") == 0);
+        CPPUNIT_ASSERT(provided->InterfacesProvidedRemoved.empty());
+    }
+    CPPUNIT_ASSERT_EQUAL(0, provided->GetNumberOfEndUsers());
+    delete server;
+}
+
+
+template <class _elementType>
+void mtsCommandAndEventLocalTest::TestFromSignalFromSignalExecutorPool(void)
+{
+    // same as blocking test but both components share an executor
+    // pool instead of using their own thread
+    mtsManagerLocal * manager = mtsManagerLocal::GetInstance();
+    CPPUNIT_ASSERT(!manager->GetExecutorPool());
+    CPPUNIT_ASSERT(manager->SetExecutorPool(2));
+    CPPUNIT_ASSERT(manager->GetExecutorPool());
+    const unsigned long long numberOfJobsExecuted = manager->GetExecutorPool()->GetNumberOfJobsExecuted();
+
+    const double blockingDelay = 0.25 * cmn_s;
+    mtsTestFromSignal1<_elementType> * client = new mtsTestFromSignal1<_elementType>("mtsTestFromSignal1Client");
+    mtsTestFromSignal1<_elementType> * server = new mtsTestFromSignal1<_elementType>("mtsTestFromSignal1Server", blockingDelay);
+    // these delays are OS dependent, we might need to increase them later
+    const double clientExecutionDelay = 0.1 * cmn_s;
+    const double serverExecutionDelay = 0.1 * cmn_s;
+    TestExecution(client, server, clientExecutionDelay, serverExecutionDelay, blockingDelay);
+    CPPUNIT_ASSERT(client->IsUsingExecutorPool());
+    CPPUNIT_ASSERT(server->IsUsingExecutorPool());
+    CPPUNIT_ASSERT(manager->GetExecutorPool()->GetNumberOfJobsExecuted() > numberOfJobsExecuted);
+    delete client;
+    delete server;
+
+    // remove pool so other tests use their own threads
+    CPPUNIT_ASSERT(manager->RemoveExecutorPool());
+    CPPUNIT_ASSERT(!manager->GetExecutorPool());
+    CPPUNIT_ASSERT(!manager->RemoveExecutorPool());
+}
+void mtsCommandAndEventLocalTest::TestFromSignalFromSignalExecutorPool_mtsInt(void) {
+    mtsCommandAndEventLocalTest::TestFromSignalFromSignalExecutorPool<mtsInt>();
+}
+void mtsCommandAndEventLocalTest::TestFromSignalFromSignalExecutorPool_int(void) {
+    mtsCommandAndEventLocalTest::TestFromSignalFromSignalExecutorPool<int>();
+}
+
+
 CPPUNIT_TEST_SUITE_REGISTRATION(mtsCommandAndEventLocalTest);
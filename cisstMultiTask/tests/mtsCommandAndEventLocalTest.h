@@ -6,7 +6,7 @@
   Author(s):  Min Yang Jung, Anton Deguet
   Created on: 2009-11-17
 
-  (C) Copyright 2009-2011 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -57,6 +57,13 @@ private:
 
         CPPUNIT_TEST(TestArgumentPrototypes_mtsInt);
         CPPUNIT_TEST(TestArgumentPrototypes_int);
+
+        CPPUNIT_TEST(TestCommandStatistics);
+
+        CPPUNIT_TEST(TestSharedMailBox);
+
+        CPPUNIT_TEST(TestFromSignalFromSignalExecutorPool_mtsInt);
+        CPPUNIT_TEST(TestFromSignalFromSignalExecutorPool_int);
     }
     CPPUNIT_TEST_SUITE_END();
 
@@ -110,4 +117,12 @@ public:
     template <class _elementType> void TestArgumentPrototypes(void);
     void TestArgumentPrototypes_mtsInt(void);
     void TestArgumentPrototypes_int(void);
+
+    void TestCommandStatistics(void);
+
+    void TestSharedMailBox(void);
+
+    template <class _elementType> void TestFromSignalFromSignalExecutorPool(void);
+    void TestFromSignalFromSignalExecutorPool_mtsInt(void);
+    void TestFromSignalFromSignalExecutorPool_int(void);
 };
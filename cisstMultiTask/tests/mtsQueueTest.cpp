@@ -21,6 +21,9 @@ http://www.cisst.org/cisst/license.txt.
 #include "mtsQueueTest.h"
 #include "mtsMacrosTestClasses.h"
 #include <cisstVector/vctRandom.h>
+#include <cisstCommon/cmnUnits.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaSleep.h>
 
 void mtsQueueTest::TestQueue_mtsDouble(void)
 {
@@ -147,3 +150,208 @@ void mtsQueueTest::TestConstructorDestructorCalls(void)
     CPPUNIT_ASSERT_EQUAL(mtsMacrosTestClassB::CopyConstructorCalls, static_cast<size_t>(0));
     CPPUNIT_ASSERT_EQUAL(mtsMacrosTestClassB::DestructorCalls, 2 * size + 1);
 }
+
+
+void mtsQueueTest::TestBatch(void)
+{
+    const size_t size = 10;
+    mtsQueue<size_t> queue(size, 0);
+    CPPUNIT_ASSERT_EQUAL(size, queue.GetSize());
+    CPPUNIT_ASSERT(queue.IsEmpty());
+
+    size_t input[2 * size];
+    size_t output[2 * size];
+    size_t index, iteration;
+    size_t nextInput = 0;
+    size_t nextOutput = 0;
+
+    // one slot is always unused so at most size - 1 elements can be queued
+    for (index = 0; index < 2 * size; index++) {
+        input[index] = nextInput + index;
+    }
+    CPPUNIT_ASSERT_EQUAL(size - 1, queue.PutBatch(input, 2 * size));
+    nextInput += size - 1;
+    CPPUNIT_ASSERT(queue.IsFull());
+    CPPUNIT_ASSERT_EQUAL(size - 1, queue.GetAvailable());
+    CPPUNIT_ASSERT(!queue.Put(input[0]));
+    CPPUNIT_ASSERT_EQUAL(size - 1, queue.GetBatch(output, 2 * size));
+    for (index = 0; index < size - 1; index++) {
+        CPPUNIT_ASSERT_EQUAL(nextOutput + index, output[index]);
+    }
+    nextOutput += size - 1;
+    CPPUNIT_ASSERT(queue.IsEmpty());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), queue.GetBatch(output, size));
+
+    // odd batch sizes to wrap around at different positions
+    for (iteration = 0; iteration < 5 * size; iteration++) {
+        const size_t batchSize = (iteration % (size - 1)) + 1;
+        for (index = 0; index < batchSize; index++) {
+            input[index] = nextInput + index;
+        }
+        CPPUNIT_ASSERT_EQUAL(batchSize, queue.PutBatch(input, batchSize));
+        nextInput += batchSize;
+        CPPUNIT_ASSERT_EQUAL(batchSize, queue.GetAvailable());
+        // mix single and batch gets
+        CPPUNIT_ASSERT_EQUAL(nextOutput, *(queue.Peek()));
+        CPPUNIT_ASSERT_EQUAL(nextOutput, *(queue.Get()));
+        nextOutput++;
+        CPPUNIT_ASSERT_EQUAL(batchSize - 1, queue.GetBatch(output, size));
+        for (index = 0; index < batchSize - 1; index++) {
+            CPPUNIT_ASSERT_EQUAL(nextOutput + index, output[index]);
+        }
+        nextOutput += batchSize - 1;
+        CPPUNIT_ASSERT(queue.IsEmpty());
+    }
+}
+
+
+const size_t mtsQueueTestNumberOfElements = 100000;
+
+void * mtsQueueTestProducer(mtsQueue<size_t> * queue)
+{
+    size_t value = 0;
+    size_t batch[7];
+    while (value < mtsQueueTestNumberOfElements) {
+        if (value % 2) {
+            if (queue->Put(value)) {
+                value++;
+            } else {
+                osaSleep(1.0 * cmn_us); // queue full, let consumer run
+            }
+        } else {
+            size_t index;
+            for (index = 0; index < 7; index++) {
+                batch[index] = value + index;
+            }
+            size_t count = 7;
+            if (value + count > mtsQueueTestNumberOfElements) {
+                count = mtsQueueTestNumberOfElements - value;
+            }
+            count = queue->PutBatch(batch, count);
+            if (count == 0) {
+                osaSleep(1.0 * cmn_us);
+            }
+            value += count;
+        }
+    }
+    return 0;
+}
+
+
+void mtsQueueTest::TestProducerConsumer(void)
+{
+    mtsQueue<size_t> queue(64, 0);
+    osaThread producer;
+    producer.Create(mtsQueueTestProducer, &queue);
+
+    size_t expected = 0;
+    size_t batch[5];
+    size_t * element;
+    bool ordered = true;
+    while (ordered && (expected < mtsQueueTestNumberOfElements)) {
+        if (expected % 3) {
+            element = queue.Get();
+            if (element) {
+                ordered = (*element == expected);
+                expected++;
+            } else {
+                osaSleep(1.0 * cmn_us); // queue empty, let producer run
+            }
+        } else {
+            const size_t count = queue.GetBatch(batch, 5);
+            if (count == 0) {
+                osaSleep(1.0 * cmn_us);
+            }
+            size_t index;
+            for (index = 0; index < count; index++) {
+                ordered = ordered && (batch[index] == expected);
+                expected++;
+            }
+        }
+    }
+    producer.Wait();
+    CPPUNIT_ASSERT(ordered);
+    CPPUNIT_ASSERT_EQUAL(mtsQueueTestNumberOfElements, expected);
+    CPPUNIT_ASSERT(queue.IsEmpty());
+}
+
+
+const size_t mtsQueueTestNumberOfProducers = 4;
+
+struct mtsQueueTestProducerData {
+    mtsQueueMultiProducer<size_t> * Queue;
+    size_t Id;
+};
+
+void * mtsQueueTestMultiProducer(mtsQueueTestProducerData * data)
+{
+    // encode producer Id in lower bits to check order per producer
+    size_t value = 0;
+    while (value < mtsQueueTestNumberOfElements) {
+        if (data->Queue->Put(value * mtsQueueTestNumberOfProducers + data->Id)) {
+            value++;
+        } else {
+            osaSleep(1.0 * cmn_us);
+        }
+    }
+    return 0;
+}
+
+
+void mtsQueueTest::TestMultipleProducers(void)
+{
+    mtsQueueMultiProducer<size_t> queue(32, 0);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(32), queue.GetSize());
+    CPPUNIT_ASSERT(queue.IsEmpty());
+
+    // single thread, all slots can be used
+    size_t index;
+    for (index = 0; index < queue.GetSize(); index++) {
+        CPPUNIT_ASSERT(queue.Put(index));
+    }
+    CPPUNIT_ASSERT(queue.IsFull());
+    CPPUNIT_ASSERT(!queue.Put(index));
+    // failed put doesn't count
+    CPPUNIT_ASSERT_EQUAL(queue.GetSize(), queue.GetNumberOfEnqueued());
+    size_t element;
+    for (index = 0; index < queue.GetSize(); index++) {
+        CPPUNIT_ASSERT_EQUAL(index, *(queue.Peek()));
+        CPPUNIT_ASSERT(queue.Get(element));
+        CPPUNIT_ASSERT_EQUAL(index, element);
+    }
+    CPPUNIT_ASSERT(queue.IsEmpty());
+    CPPUNIT_ASSERT(!queue.Pop());
+
+    // multiple producers
+    mtsQueueTestProducerData data[mtsQueueTestNumberOfProducers];
+    osaThread producers[mtsQueueTestNumberOfProducers];
+    size_t expected[mtsQueueTestNumberOfProducers];
+    for (index = 0; index < mtsQueueTestNumberOfProducers; index++) {
+        data[index].Queue = &queue;
+        data[index].Id = index;
+        expected[index] = 0;
+        producers[index].Create(mtsQueueTestMultiProducer, &(data[index]));
+    }
+    size_t total = 0;
+    bool ordered = true;
+    while (ordered && (total < mtsQueueTestNumberOfProducers * mtsQueueTestNumberOfElements)) {
+        if (queue.Get(element)) {
+            const size_t id = element % mtsQueueTestNumberOfProducers;
+            ordered = ((element / mtsQueueTestNumberOfProducers) == expected[id]);
+            expected[id]++;
+            total++;
+        } else {
+            osaSleep(1.0 * cmn_us);
+        }
+    }
+    for (index = 0; index < mtsQueueTestNumberOfProducers; index++) {
+        producers[index].Wait();
+    }
+    CPPUNIT_ASSERT(ordered);
+    for (index = 0; index < mtsQueueTestNumberOfProducers; index++) {
+        CPPUNIT_ASSERT_EQUAL(mtsQueueTestNumberOfElements, expected[index]);
+    }
+    CPPUNIT_ASSERT(queue.IsEmpty());
+    CPPUNIT_ASSERT_EQUAL(queue.GetSize() + mtsQueueTestNumberOfProducers * mtsQueueTestNumberOfElements,
+                         queue.GetNumberOfEnqueued());
+}
@@ -31,6 +31,9 @@ class mtsQueueTest: public CppUnit::TestFixture
 
     CPPUNIT_TEST(TestQueue_mtsDouble);
     CPPUNIT_TEST(TestConstructorDestructorCalls);
+    CPPUNIT_TEST(TestBatch);
+    CPPUNIT_TEST(TestProducerConsumer);
+    CPPUNIT_TEST(TestMultipleProducers);
 
     CPPUNIT_TEST_SUITE_END();
     
@@ -44,6 +47,15 @@ public:
 
     /*! Tests calls to constructors and detructors */
     void TestConstructorDestructorCalls(void);
+
+    /*! Tests PutBatch and GetBatch, including wrap around */
+    void TestBatch(void);
+
+    /*! Tests with one producer and one consumer thread */
+    void TestProducerConsumer(void);
+
+    /*! Tests multiple producers queue with multiple threads */
+    void TestMultipleProducers(void);
 };
 
 
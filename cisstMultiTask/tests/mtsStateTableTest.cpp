@@ -6,7 +6,7 @@
   Author(s):  Min Yang Jung
   Created on: 2009-03-05
 
-  (C) Copyright 2009-2010 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -18,7 +18,10 @@ http://www.cisst.org/cisst/license.txt.
 --- end cisst license ---
 */
 
+#include <cisstOSAbstraction/osaSleep.h>
+#include <cisstOSAbstraction/osaThread.h>
 #include <cisstMultiTask/mtsStateTable.h>
+#include <cisstMultiTask/mtsVector.h>
 
 #include "mtsStateTableTest.h"
 
@@ -64,4 +67,158 @@ void mtsStateTableTest::TestGetStateVectorID(void)
     }
 }
 
+
+void mtsStateTableTest::TestReadLatest(void)
+{
+    mtsStateTable table(10, "Test");
+    mtsDouble scalar;
+    mtsDoubleVec vector(5);
+    table.AddData(scalar, "Scalar");
+    table.AddData(vector, "Vector");
+    const mtsStateDataId scalarId = table.GetStateVectorID("Scalar");
+    const mtsStateDataId vectorId = table.GetStateVectorID("Vector");
+
+    for (size_t row = 1; row < 25; ++row) {
+        table.Start();
+        scalar = static_cast<double>(row);
+        vector.SetAll(static_cast<double>(row * 10));
+        table.Advance();
+
+        double scalarRead = 0.0;
+        double sumRead = 0.0;
+        bool typesMatch = true;
+        const bool valid = table.ReadLatest([&](const mtsStateTable::Snapshot & snapshot) {
+                const mtsDouble * scalarPointer = snapshot.Get<mtsDouble>(scalarId);
+                const mtsDoubleVec * vectorPointer = snapshot.Get<mtsDoubleVec>(vectorId);
+                // wrong type, should return 0
+                typesMatch = (scalarPointer != 0) && (vectorPointer != 0)
+                    && (snapshot.Get<mtsDoubleVec>(scalarId) == 0);
+                if (typesMatch) {
+                    scalarRead = scalarPointer->Data;
+                    sumRead = vectorPointer->SumOfElements();
+                }
+            });
+        CPPUNIT_ASSERT(valid);
+        CPPUNIT_ASSERT(typesMatch);
+        CPPUNIT_ASSERT_EQUAL(static_cast<double>(row), scalarRead);
+        CPPUNIT_ASSERT_EQUAL(static_cast<double>(row * 50), sumRead);
+    }
+    // single thread, no retry needed
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), table.GetNumberOfReadRetries());
+}
+
+
+void mtsStateTableTest::TestGetBatch(void)
+{
+    mtsStateTable table(10, "Test");
+    mtsDouble scalar;
+    mtsInt integer;
+    mtsDoubleVec vector(3);
+    table.AddData(scalar, "Scalar");
+    table.AddData(integer, "Integer");
+    table.AddData(vector, "Vector");
+
+    std::vector<mtsStateDataId> ids;
+    ids.push_back(table.GetStateVectorID("Vector"));
+    ids.push_back(table.GetStateVectorID("Scalar"));
+    ids.push_back(table.GetStateVectorID("Integer"));
+
+    mtsDouble scalarRead;
+    mtsInt integerRead;
+    mtsDoubleVec vectorRead;
+    std::vector<mtsGenericObject *> data;
+    data.push_back(&vectorRead);
+    data.push_back(&scalarRead);
+    data.push_back(&integerRead);
+
+    table.Start();
+    scalar = 1.5;
+    integer = 3;
+    vector.SetAll(2.0);
+    table.Advance();
+    const mtsStateIndex index = table.GetIndexReader();
+
+    CPPUNIT_ASSERT(table.GetBatch(index, ids, data));
+    CPPUNIT_ASSERT_EQUAL(1.5, scalarRead.Data);
+    CPPUNIT_ASSERT_EQUAL(3, integerRead.Data);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), vectorRead.size());
+    CPPUNIT_ASSERT_EQUAL(6.0, vectorRead.SumOfElements());
+
+    // latest, after a few more rows
+    for (size_t row = 0; row < 4; ++row) {
+        table.Start();
+        scalar = scalar + 1.0;
+        table.Advance();
+    }
+    CPPUNIT_ASSERT(table.GetLatestBatch(ids, data));
+    CPPUNIT_ASSERT_EQUAL(5.5, scalarRead.Data);
+
+    // overwrite the row of the old index
+    for (size_t row = 0; row < 10; ++row) {
+        table.Start();
+        table.Advance();
+    }
+    CPPUNIT_ASSERT(!table.GetBatch(index, ids, data));
+
+    // wrong type or size
+    std::swap(data[0], data[1]);
+    CPPUNIT_ASSERT(!table.GetLatestBatch(ids, data));
+    data.pop_back();
+    CPPUNIT_ASSERT(!table.GetLatestBatch(ids, data));
+}
+
+
+const size_t mtsStateTableTestNumberOfRows = 20000;
+
+void * mtsStateTableTestWriter(mtsStateTable * table)
+{
+    mtsDoubleVec * vector = dynamic_cast<mtsDoubleVec *>(table->GetStateVectorElement(table->GetStateVectorID("Vector")));
+    for (size_t row = 1; row <= mtsStateTableTestNumberOfRows; ++row) {
+        table->Start();
+        vector->SetAll(static_cast<double>(row));
+        table->Advance();
+    }
+    return 0;
+}
+
+
+void mtsStateTableTest::TestReadLatestMultiThreading(void)
+{
+    // short history to increase the chances of overwrites
+    mtsStateTable table(3, "Test");
+    mtsDoubleVec vector(256);
+    vector.SetAll(0.0);
+    table.AddData(vector, "Vector");
+    const mtsStateDataId vectorId = table.GetStateVectorID("Vector");
+
+    osaThread writer;
+    writer.Create(mtsStateTableTestWriter, &table);
+
+    // all elements of the vector are equal for a given row, a
+    // successful read should never see a mix of rows
+    bool consistent = true;
+    double last = 0.0;
+    while (consistent && (last < static_cast<double>(mtsStateTableTestNumberOfRows))) {
+        double first = 0.0;
+        bool allEqual = true;
+        const bool valid = table.ReadLatest([&](const mtsStateTable::Snapshot & snapshot) {
+                const mtsDoubleVec & data = *(snapshot.Get<mtsDoubleVec>(vectorId));
+                first = data.Element(0);
+                allEqual = true;
+                for (size_t index = 1; index < data.size(); ++index) {
+                    allEqual = allEqual && (data.Element(index) == first);
+                }
+            });
+        if (valid) {
+            consistent = allEqual && (first >= last);
+            last = first;
+        } else {
+            osaSleep(1.0 * cmn_us);
+        }
+    }
+    writer.Wait();
+    CPPUNIT_ASSERT(consistent);
+}
+
+
 CPPUNIT_TEST_SUITE_REGISTRATION(mtsStateTableTest);
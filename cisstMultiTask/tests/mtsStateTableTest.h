@@ -6,7 +6,7 @@
   Author(s):  Min Yang Jung
   Created on: 2009-03-05
 
-  (C) Copyright 2009 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -30,6 +30,9 @@ class mtsStateTableTest: public CppUnit::TestFixture
     CPPUNIT_TEST_SUITE(mtsStateTableTest);
     {
         CPPUNIT_TEST(TestGetStateVectorID);
+        CPPUNIT_TEST(TestReadLatest);
+        CPPUNIT_TEST(TestGetBatch);
+        CPPUNIT_TEST(TestReadLatestMultiThreading);
     }
     CPPUNIT_TEST_SUITE_END();
 
@@ -39,4 +42,10 @@ public:
     void tearDown(void);
 
     void TestGetStateVectorID(void);
+
+    void TestReadLatest(void);
+
+    void TestGetBatch(void);
+
+    void TestReadLatestMultiThreading(void);
 };
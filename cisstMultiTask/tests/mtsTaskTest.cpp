@@ -6,7 +6,7 @@
   Author(s):  Min Yang Jung
   Created on: 2009-03-05
   
-  (C) Copyright 2009 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -19,7 +19,10 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include <cisstCommon/cmnUnits.h>
+#include <cisstOSAbstraction/osaSleep.h>
 #include <cisstMultiTask/mtsStateTable.h>
+#include <cisstMultiTask/mtsManagerLocal.h>
+#include <cisstMultiTask/mtsExecutorPool.h>
 
 #include "mtsTaskTest.h"
 
@@ -51,4 +54,164 @@ void mtsTaskTest::TestGetStateVectorID(void)
     task.TestGetStateVectorID();
 }
 
+void mtsTaskTest::TestTimingStatisticsBins(void)
+{
+    // one bin per nano second for the first bins
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), mtsTaskPeriodicStatistics::Bin(0.0));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(5), mtsTaskPeriodicStatistics::Bin(5.2 * cmn_ns));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(mtsTaskPeriodicStatistics::NUMBER_OF_BINS - 1),
+                         mtsTaskPeriodicStatistics::Bin(100.0 * cmn_s));
+
+    // bins are contiguous and values fall within their bin bounds
+    size_t bin;
+    for (bin = 1; bin < mtsTaskPeriodicStatistics::NUMBER_OF_BINS; ++bin) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(mtsTaskPeriodicStatistics::BinUpperBound(bin - 1),
+                                     mtsTaskPeriodicStatistics::BinLowerBound(bin),
+                                     1.0e-15);
+    }
+    const double durations[] = {10.0 * cmn_ns, 33.0 * cmn_ns, 7.3 * cmn_us, 980.0 * cmn_us, 1.0 * cmn_ms, 2.5 * cmn_s};
+    for (size_t index = 0; index < sizeof(durations) / sizeof(double); ++index) {
+        bin = mtsTaskPeriodicStatistics::Bin(durations[index]);
+        // bounds are computed in seconds, allow for rounding errors
+        CPPUNIT_ASSERT(mtsTaskPeriodicStatistics::BinLowerBound(bin) <= (durations[index] + 1.0e-15));
+        CPPUNIT_ASSERT(mtsTaskPeriodicStatistics::BinUpperBound(bin) > (durations[index] + 1.0e-15));
+        // relative precision
+        CPPUNIT_ASSERT((mtsTaskPeriodicStatistics::BinUpperBound(bin) - durations[index])
+                       <= (durations[index] / mtsTaskPeriodicStatistics::SUB_BINS + cmn_ns));
+    }
+
+    // percentiles
+    mtsTaskPeriodicStatistics::HistogramType histogram;
+    CPPUNIT_ASSERT_EQUAL(0.0, histogram.Percentile(0.5));
+    for (size_t index = 0; index < 99; ++index) {
+        histogram.Bins[mtsTaskPeriodicStatistics::Bin(10.0 * cmn_us)]++;
+    }
+    histogram.Bins[mtsTaskPeriodicStatistics::Bin(1.0 * cmn_ms)]++;
+    histogram.Max = 1.0 * cmn_ms;
+    CPPUNIT_ASSERT(histogram.Percentile(0.5) < 11.0 * cmn_us);
+    CPPUNIT_ASSERT(histogram.Percentile(0.99) < 11.0 * cmn_us);
+    CPPUNIT_ASSERT_EQUAL(1.0 * cmn_ms, histogram.Percentile(1.0));
+}
+
+void mtsTaskTest::TestTimingStatistics(void)
+{
+    const double period = 5.0 * cmn_ms;
+    const double stateTransitionMaximumDelay = 10.0 * cmn_s;
+    mtsTaskTestTask * task = new mtsTaskTestTask("testingTimingStatistics", period);
+    task->SetAbsoluteTimeWait(true);
+
+    mtsManagerLocal * manager = mtsManagerLocal::GetInstance();
+    CPPUNIT_ASSERT(manager->AddComponent(task));
+    manager->CreateAll();
+    CPPUNIT_ASSERT(manager->WaitForStateAll(mtsComponentState::READY, stateTransitionMaximumDelay));
+    manager->StartAll();
+    CPPUNIT_ASSERT(manager->WaitForStateAll(mtsComponentState::ACTIVE, stateTransitionMaximumDelay));
+    osaSleep(100.0 * period);
+
+    mtsTaskPeriodicStatistics statistics;
+    task->GetTimingStatistics(statistics);
+    CPPUNIT_ASSERT(statistics.Valid());
+    CPPUNIT_ASSERT(statistics.ComputeTime.NumberOfSamples > 10);
+    CPPUNIT_ASSERT_EQUAL(statistics.ComputeTime.NumberOfSamples, statistics.WakeUpLatency.NumberOfSamples);
+    CPPUNIT_ASSERT(statistics.ComputeTime.Max < period);
+    CPPUNIT_ASSERT(statistics.WakeUpLatency.Min >= 0.0);
+    CPPUNIT_ASSERT(statistics.WakeUpLatency.Percentile(0.5) <= statistics.WakeUpLatency.Max);
+    CPPUNIT_ASSERT(statistics.LongestOverrunStreak <= statistics.NumberOfOverruns);
+
+    // serialization round trip
+    std::stringstream stream;
+    statistics.SerializeRaw(stream);
+    mtsTaskPeriodicStatistics copy;
+    copy.DeSerializeRaw(stream);
+    CPPUNIT_ASSERT_EQUAL(statistics.ComputeTime.NumberOfSamples, copy.ComputeTime.NumberOfSamples);
+    CPPUNIT_ASSERT_EQUAL(statistics.WakeUpLatency.Max, copy.WakeUpLatency.Max);
+    CPPUNIT_ASSERT_EQUAL(statistics.NumberOfOverruns, copy.NumberOfOverruns);
+
+    // reset is performed by the task on next iteration
+    task->ResetTimingStatistics();
+    osaSleep(5.0 * period);
+    task->GetTimingStatistics(statistics);
+    CPPUNIT_ASSERT(statistics.ComputeTime.NumberOfSamples < copy.ComputeTime.NumberOfSamples);
+
+    manager->KillAll();
+    CPPUNIT_ASSERT(manager->WaitForStateAll(mtsComponentState::FINISHED, stateTransitionMaximumDelay));
+    CPPUNIT_ASSERT(manager->RemoveComponent(task));
+    delete task;
+}
+
+// job used to check that a job is never executed concurrently and is
+// executed again if scheduled while running
+class mtsTaskTestJob: public mtsExecutorPool::Job
+{
+public:
+    mtsExecutorPool * Pool;
+    std::atomic<bool> Running;
+    std::atomic<unsigned int> NumberOfExecutions;
+    std::atomic<unsigned int> NumberOfOverlaps;
+    unsigned int NumberOfReschedules;
+
+    mtsTaskTestJob(mtsExecutorPool * pool):
+        Pool(pool),
+        Running(false),
+        NumberOfExecutions(0),
+        NumberOfOverlaps(0),
+        NumberOfReschedules(0)
+    {}
+
+    void Execute(void) override {
+        if (Running.exchange(true)) {
+            NumberOfOverlaps++;
+        }
+        NumberOfExecutions++;
+        if (NumberOfReschedules > 0) {
+            NumberOfReschedules--;
+            Pool->Schedule(this);
+        }
+        osaSleep(100.0 * cmn_us);
+        Running = false;
+    }
+};
+
+void mtsTaskTest::TestExecutorPool(void)
+{
+    mtsExecutorPool pool(3);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), pool.GetNumberOfThreads());
+
+    const size_t numberOfJobs = 10;
+    std::vector<mtsTaskTestJob *> jobs;
+    size_t index;
+    for (index = 0; index < numberOfJobs; ++index) {
+        jobs.push_back(new mtsTaskTestJob(&pool));
+        CPPUNIT_ASSERT(jobs[index]->IsIdle());
+    }
+
+    // job scheduling itself while running is executed again
+    jobs[0]->NumberOfReschedules = 5;
+    pool.Schedule(jobs[0]);
+    CPPUNIT_ASSERT(pool.WaitForIdle(jobs[0], 5.0 * cmn_s));
+    CPPUNIT_ASSERT_EQUAL(6u, jobs[0]->NumberOfExecutions.load());
+
+    // scheduling many times from different threads never leads to
+    // concurrent executions
+    for (unsigned int iteration = 0; iteration < 200; ++iteration) {
+        for (index = 0; index < numberOfJobs; ++index) {
+            pool.Schedule(jobs[index]);
+        }
+        if (iteration % 20 == 0) {
+            osaSleep(1.0 * cmn_ms);
+        }
+    }
+    for (index = 0; index < numberOfJobs; ++index) {
+        CPPUNIT_ASSERT(pool.WaitForIdle(jobs[index], 5.0 * cmn_s));
+        CPPUNIT_ASSERT_EQUAL(0u, jobs[index]->NumberOfOverlaps.load());
+        // executed at least once after last schedule
+        CPPUNIT_ASSERT(jobs[index]->NumberOfExecutions.load() >= 1);
+    }
+    CPPUNIT_ASSERT(pool.GetNumberOfJobsExecuted() >= numberOfJobs + 5);
+
+    for (index = 0; index < numberOfJobs; ++index) {
+        delete jobs[index];
+    }
+}
+
 CPPUNIT_TEST_SUITE_REGISTRATION(mtsTaskTest);
@@ -47,6 +47,9 @@ class mtsTaskTest: public CppUnit::TestFixture
     CPPUNIT_TEST_SUITE(mtsTaskTest);
     {
         CPPUNIT_TEST(TestGetStateVectorID);
+        CPPUNIT_TEST(TestTimingStatisticsBins);
+        CPPUNIT_TEST(TestTimingStatistics);
+        CPPUNIT_TEST(TestExecutorPool);
     }
     CPPUNIT_TEST_SUITE_END();
 
@@ -56,4 +59,7 @@ public:
     void tearDown(void) {}
 
     void TestGetStateVectorID(void);
+    void TestTimingStatisticsBins(void);
+    void TestTimingStatistics(void);
+    void TestExecutorPool(void);
 };
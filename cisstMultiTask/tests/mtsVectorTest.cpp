@@ -20,6 +20,7 @@ http://www.cisst.org/cisst/license.txt.
 
 #include "mtsVectorTest.h"
 #include <cisstVector/vctRandomDynamicVector.h>
+#include <cisstMultiTask/mtsGenericObjectProxy.h>
 
 template <class _elementType>
 void mtsVectorTest::TestSetSizeFrom(void)
@@ -80,3 +81,25 @@ void mtsVectorTest::TestConversionInt(void)
 {
     TestConversion<int>();
 }
+
+
+void mtsVectorTest::TestScalar(void)
+{
+    mtsDoubleVec vector(4);
+    vector.SetAll(2.0);
+    vector.Element(3) = 5.0;
+    vector.SetValid(true);
+    // 3 scalars for mtsGenericObject, size and 4 elements
+    const cmnGenericObject & object = vector;
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(8), object.ScalarNumber());
+    CPPUNIT_ASSERT_EQUAL(1.0, object.Scalar(2)); // valid
+    CPPUNIT_ASSERT_EQUAL(4.0, object.Scalar(3)); // size
+    CPPUNIT_ASSERT_EQUAL(2.0, object.Scalar(4));
+    CPPUNIT_ASSERT_EQUAL(5.0, object.Scalar(7));
+
+    // same for proxy types
+    mtsDouble value(3.0);
+    const cmnGenericObject & proxy = value;
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4), proxy.ScalarNumber());
+    CPPUNIT_ASSERT_EQUAL(3.0, proxy.Scalar(3));
+}
@@ -33,6 +33,8 @@ class mtsVectorTest: public CppUnit::TestFixture
     CPPUNIT_TEST(TestConversionDouble);
     CPPUNIT_TEST(TestConversionInt);
 
+    CPPUNIT_TEST(TestScalar);
+
     CPPUNIT_TEST_SUITE_END();
     
 public:
@@ -49,6 +51,9 @@ public:
     template <class _elementType> void TestConversion(void);
     void TestConversionDouble(void);
     void TestConversionInt(void);
+
+    /*! Test scalar methods, including mtsGenericObject scalars */
+    void TestScalar(void);
 };
 
 
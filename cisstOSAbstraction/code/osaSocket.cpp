@@ -6,7 +6,7 @@
 Author(s):  Peter Kazanzides
 Created on: 2009
 
-(C) Copyright 2007-2015 Johns Hopkins University (JHU), All Rights Reserved.
+(C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -30,6 +30,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <netinet/in.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h> // for iovec
 #include <errno.h>
 #include <string.h>  // for memset
 #include <unistd.h> // for gethostname
@@ -428,41 +429,13 @@ int osaSocket::Send(const char * bufsend, unsigned int msglen, const double time
         return -1;
     }
 
-    int retval = 0;
-    int err    = 0;
-
-    fd_set writefds;
-    FD_ZERO(&writefds);
-    FD_SET(SocketFD, &writefds);
-
-#if (CISST_OS == CISST_WINDOWS)
-    long sec = static_cast<long>(floor(timeoutSec));
-    long usec = static_cast<long>((timeoutSec - sec) * 1e6);
-#else
-    time_t sec = static_cast<time_t>(floor(timeoutSec));
-    suseconds_t usec = static_cast<suseconds_t>((timeoutSec - sec) * 1e6);
-#endif
-    timeval timeout = { sec, usec };
-
-    //see if the socket is available for writing
-    //timeout is useful here if lots of data is to be sent.
-    retval = select(SocketFD + 1, NULL, &writefds, NULL, &timeout);
-
-    if (retval == SOCKET_ERROR) {
-
-#if (CISST_OS == CISST_WINDOWS)
-        err = WSAGetLastError();
-#else
-        err = errno;
-#endif
-        //! \Todo : some of the errors here might be soft errors, EAGAIN/EWOULDBLOCK and we might be able to recover from those.
-        CMN_LOG_CLASS_RUN_ERROR << "Send: failed to send because socket is not ready " << SocketFD << " Error: " <<err<<std::endl;
-
-        if (SocketType == TCP)
-            Close();
+    if (!WaitForSend(timeoutSec)) {
         return -1;
     }
 
+    int retval = 0;
+    int err    = 0;
+
     //UDP
     if (SocketType == UDP) {
         socklen_t length = sizeof(SERVER_ADDR);
@@ -523,6 +496,119 @@ int osaSocket::Send(const char * bufsend, unsigned int msglen, const double time
     return retval;
 }
 
+bool osaSocket::WaitForSend(double timeoutSec)
+{
+    int retval = 0;
+    int err    = 0;
+
+    fd_set writefds;
+    FD_ZERO(&writefds);
+    FD_SET(SocketFD, &writefds);
+
+#if (CISST_OS == CISST_WINDOWS)
+    long sec = static_cast<long>(floor(timeoutSec));
+    long usec = static_cast<long>((timeoutSec - sec) * 1e6);
+#else
+    time_t sec = static_cast<time_t>(floor(timeoutSec));
+    suseconds_t usec = static_cast<suseconds_t>((timeoutSec - sec) * 1e6);
+#endif
+    timeval timeout = { sec, usec };
+
+    //see if the socket is available for writing
+    //timeout is useful here if lots of data is to be sent.
+    retval = select(SocketFD + 1, NULL, &writefds, NULL, &timeout);
+
+    if (retval == SOCKET_ERROR) {
+
+#if (CISST_OS == CISST_WINDOWS)
+        err = WSAGetLastError();
+#else
+        err = errno;
+#endif
+        //! \Todo : some of the errors here might be soft errors, EAGAIN/EWOULDBLOCK and we might be able to recover from those.
+        CMN_LOG_CLASS_RUN_ERROR << "Send: failed to send because socket is not ready " << SocketFD << " Error: " <<err<<std::endl;
+
+        if (SocketType == TCP)
+            Close();
+        return false;
+    }
+    return true;
+}
+
+int osaSocket::Send(const char * header, unsigned int headerLength,
+                    const char * bufsend, unsigned int msglen, double timeoutSec)
+{
+    //TCP Socket
+    if (SocketType == TCP && !Connected) {
+        CMN_LOG_CLASS_RUN_WARNING << "Send: Not Connected " << std::endl;
+        return -1;
+    }
+
+    if (!WaitForSend(timeoutSec)) {
+        return -1;
+    }
+
+    int retval = 0;
+    int err    = 0;
+    const unsigned int totalLength = headerLength + msglen;
+
+#if (CISST_OS == CISST_WINDOWS)
+    WSABUF buffers[2];
+    buffers[0].buf = const_cast<char *>(header);
+    buffers[0].len = headerLength;
+    buffers[1].buf = const_cast<char *>(bufsend);
+    buffers[1].len = msglen;
+    DWORD bytesSent = 0;
+    if (SocketType == UDP) {
+        retval = WSASendTo(SocketFD, buffers, 2, &bytesSent, 0,
+                           reinterpret_cast<struct sockaddr *>(&SERVER_ADDR), sizeof(SERVER_ADDR), NULL, NULL);
+    } else {
+        retval = WSASend(SocketFD, buffers, 2, &bytesSent, 0, NULL, NULL);
+    }
+    if (retval != SOCKET_ERROR) {
+        retval = static_cast<int>(bytesSent);
+    }
+#else
+    struct iovec buffers[2];
+    buffers[0].iov_base = const_cast<char *>(header);
+    buffers[0].iov_len = headerLength;
+    buffers[1].iov_base = const_cast<char *>(bufsend);
+    buffers[1].iov_len = msglen;
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    if (SocketType == UDP) {
+        message.msg_name = &SERVER_ADDR;
+        message.msg_namelen = sizeof(SERVER_ADDR);
+    }
+    message.msg_iov = buffers;
+    message.msg_iovlen = 2;
+    retval = sendmsg(SocketFD, &message, 0);
+#endif
+
+    if (retval == SOCKET_ERROR) {
+#if (CISST_OS == CISST_WINDOWS)
+        err = WSAGetLastError();
+        if ((SocketType == TCP) && (err == WSAEWOULDBLOCK)) {
+#else
+        err = errno;
+        if ((SocketType == TCP) && (err == EWOULDBLOCK)) {
+#endif
+            CMN_LOG_CLASS_RUN_WARNING << "Send: failed to send the whole message, missing " << totalLength << " bytes" << std::endl;
+            return 0;
+        }
+        CMN_LOG_CLASS_RUN_ERROR << "Send: failed to send with Error: " << err << std::endl;
+        if (SocketType == TCP) {
+            Close();
+        }
+        return -1;
+    }
+    else if (retval != static_cast<int>(totalLength)) {
+        CMN_LOG_CLASS_RUN_WARNING << "Send: failed to send the whole message, missing " << totalLength - retval << " bytes" << std::endl;
+    }
+    CMN_LOG_CLASS_RUN_DEBUG << "Send: sent " << retval << " bytes" << std::endl;
+    return retval;
+}
+
 int osaSocket::Send(const std::string & bufsend, double timeoutSec)
 {
     return Send(bufsend.data(), static_cast<int>(bufsend.length()), timeoutSec);
@@ -549,6 +635,36 @@ int osaSocket::SendAsPackets(const std::string & bufsend, unsigned int packetSiz
     return SendAsPackets(bufsend.data(), static_cast<int>(bufsend.length()), packetSize, timeoutSec);
 }
 
+int osaSocket::SendAsPackets(const char * header, unsigned int headerLength,
+                             const char * bufsend, unsigned int msglen,
+                             unsigned int packetSize, double timeoutSec)
+{
+    if (headerLength >= packetSize) {
+        CMN_LOG_CLASS_RUN_ERROR << "SendAsPackets: header length (" << headerLength
+                                << ") must be less than packet size (" << packetSize << ")" << std::endl;
+        return -1;
+    }
+    // first packet gathers the header and the beginning of the data
+    // so packets are the same as for the concatenated buffers
+    unsigned int firstLength = packetSize - headerLength;
+    if (firstLength > msglen) {
+        firstLength = msglen;
+    }
+    int n = Send(header, headerLength, bufsend, firstLength, timeoutSec);
+    if (n <= 0) {
+        return n;
+    }
+    if (static_cast<unsigned int>(n) != headerLength + firstLength) {
+        return n;
+    }
+    unsigned int numSent = n;
+    if (firstLength < msglen) {
+        n = SendAsPackets(bufsend + firstLength, msglen - firstLength, packetSize, timeoutSec);
+        if (n > 0) numSent += n;
+    }
+    return numSent;
+}
+
 int osaSocket::Receive(char * bufrecv, unsigned int maxlen, const double timeoutSec )
 {
     
@@ -684,6 +800,27 @@ int osaSocket::ReceiveAsPackets(std::string & bufrecv, char *packetBuffer, unsig
     return ((n < 0) && bufrecv.empty()) ? n : static_cast<int>(bufrecv.size());
 }
 
+int osaSocket::ReceiveAsPackets(std::string & bufrecv, unsigned int packetSize,
+                                double timeoutStartSec, double timeoutNextSec)
+{
+    // receive in place, string capacity is preserved across calls
+    size_t received = 0;
+    int n;
+    double timeoutSec = timeoutStartSec;
+    do {
+        if (bufrecv.size() < received + packetSize) {
+            bufrecv.resize(received + packetSize);
+        }
+        n = Receive(&bufrecv[received], packetSize, timeoutSec);
+        if (n > 0) {
+            received += n;
+        }
+        timeoutSec = timeoutNextSec;
+    } while (n == static_cast<int>(packetSize));
+    bufrecv.resize(received);
+    return ((n < 0) && bufrecv.empty()) ? n : static_cast<int>(bufrecv.size());
+}
+
 //! This could be static or external to the osaSocket class
 unsigned long osaSocket::GetIP(const std::string & host) const
 {
@@ -6,7 +6,7 @@
   Author(s): Ankur Kapoor, Min Yang Jung
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2010 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -54,6 +54,10 @@ http://www.cisst.org/cisst/license.txt.
     #include <sys/time.h>
     #include <sys/select.h>
     #include <unistd.h>
+#if (CISST_OS == CISST_LINUX)
+    #include <time.h>
+    #include <errno.h>
+#endif
 #endif
 
 #if (CISST_OS == CISST_LINUX_RTAI)
@@ -236,6 +240,11 @@ void __os_exit(void)
 
 struct osaThreadBuddyInternals {
     bool IsSuspended;
+    // wake up statistics and options, see SetAbsoluteTimeWait
+    double WakeUpLatency;
+    unsigned int MissedPeriods;
+    bool AbsoluteTime;
+    double SpinTime;
 #if (CISST_OS == CISST_LINUX_RTAI)
     // A pointer to the thread buddy on RTAI.
     RT_TASK *RTTask;
@@ -256,12 +265,31 @@ struct osaThreadBuddyInternals {
 #else
     struct timeval DueTime;
     char Name[6];
+    // next absolute wake up time in nano seconds, 0 before first wait
+    long long NextWakeUp;
 #endif // end of others
 };
 
+#if (CISST_OS == CISST_LINUX)
+// current time in nano seconds using the monotonic clock
+static inline long long osaThreadBuddyMonotonicTime(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<long long>(now.tv_sec) * 1000000000LL + now.tv_nsec;
+}
+#endif
+
 // Constructor. Allocates memory for thread buddy internal data.
-osaThreadBuddy::osaThreadBuddy() {
+osaThreadBuddy::osaThreadBuddy():
+    Period(0.0)
+{
     Data = new osaThreadBuddyInternals;
+    Data->IsSuspended = false;
+    Data->WakeUpLatency = 0.0;
+    Data->MissedPeriods = 0;
+    Data->AbsoluteTime = false;
+    Data->SpinTime = 0.0;
 }
 
 // Destructor. Frees memory for thread buddy internal data.
@@ -388,6 +416,7 @@ void osaThreadBuddy::Create(const char *name, const osaAbsoluteTime& tv, int CMN
 #else // default unix
     Data->DueTime.tv_sec = 0;
     Data->DueTime.tv_usec = 0;
+    Data->NextWakeUp = 0;
     for (unsigned int i = 0; i < sizeof(Data->Name); i++) Data->Name[i] = name[i];
     Data->Name[sizeof(Data->Name)-1] = 0;
 #endif    
@@ -570,6 +599,44 @@ void osaThreadBuddy::WaitForRemainingPeriod(void)
     if (!IsPeriodic()) {
         return;
     }
+#if (CISST_OS == CISST_LINUX)
+    if (Data->AbsoluteTime) {
+        const long long period = static_cast<long long>(Period);
+        const long long spinTime = static_cast<long long>(Data->SpinTime * 1.0e9);
+        long long timeNow;
+        struct timespec timeSleep;
+        do {
+            timeNow = osaThreadBuddyMonotonicTime();
+            if (Data->NextWakeUp == 0) {
+                // this is the first time this is being called
+                Data->NextWakeUp = timeNow;
+            }
+            Data->NextWakeUp += period;
+            // skip periods completely missed
+            Data->MissedPeriods = 0;
+            if (Data->NextWakeUp <= timeNow) {
+                const long long missed = (timeNow - Data->NextWakeUp) / period + 1;
+                Data->MissedPeriods = static_cast<unsigned int>(missed);
+                Data->NextWakeUp += missed * period;
+            }
+            // sleep until the beginning of the spin time
+            const long long sleepUntil = Data->NextWakeUp - spinTime;
+            if (sleepUntil > timeNow) {
+                timeSleep.tv_sec = static_cast<time_t>(sleepUntil / 1000000000LL);
+                timeSleep.tv_nsec = static_cast<long>(sleepUntil % 1000000000LL);
+                while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &timeSleep, NULL) == EINTR) {
+                    // interrupted by a signal, go back to sleep
+                }
+            }
+            // busy-wait for the remaining time, if any
+            do {
+                timeNow = osaThreadBuddyMonotonicTime();
+            } while (timeNow < Data->NextWakeUp);
+            Data->WakeUpLatency = static_cast<double>(timeNow - Data->NextWakeUp) * 1.0e-9;
+        } while (Data->IsSuspended);
+        return;
+    }
+#endif
     double elapsedTimeMicroSec, timeRemainingNanoSec;
     struct timeval timeNow, timeLater;
     struct timespec timeSleep;
@@ -591,12 +658,45 @@ void osaThreadBuddy::WaitForRemainingPeriod(void)
         }
         pselect(0, NULL, NULL, NULL, &timeSleep, NULL);
         gettimeofday(&timeLater, NULL);
+        // wake up latency compared to requested sleep time
+        if (timeRemainingNanoSec < 0.0) {
+            timeRemainingNanoSec = 0.0;
+        }
+        Data->WakeUpLatency = static_cast<double>(timeLater.tv_sec - timeNow.tv_sec)
+            + static_cast<double>(timeLater.tv_usec - timeNow.tv_usec) * 1.0e-6
+            - timeRemainingNanoSec * 1.0e-9;
         Data->DueTime.tv_sec = timeLater.tv_sec;
         Data->DueTime.tv_usec = timeLater.tv_usec;
     } while (Data->IsSuspended);
 #endif
 }
 
+void osaThreadBuddy::SetAbsoluteTimeWait(const bool absoluteTime, const double spinTime)
+{
+#if (CISST_OS == CISST_LINUX)
+    Data->AbsoluteTime = absoluteTime;
+    Data->SpinTime = (spinTime > 0.0) ? spinTime : 0.0;
+    Data->NextWakeUp = 0;
+#else
+    if (absoluteTime) {
+        CMN_LOG_INIT_WARNING << "osaThreadBuddy::SetAbsoluteTimeWait: absolute wake up times are not supported on this OS"
+                             << std::endl;
+    }
+    Data->AbsoluteTime = false;
+    Data->SpinTime = spinTime;
+#endif
+}
+
+double osaThreadBuddy::GetWakeUpLatency(void) const
+{
+    return Data->WakeUpLatency;
+}
+
+unsigned int osaThreadBuddy::GetNumberOfMissedPeriods(void) const
+{
+    return Data->MissedPeriods;
+}
+
 void osaThreadBuddy::MakeHardRealTime(void) 
 {
 #if (CISST_OS == CISST_LINUX_RTAI)
@@ -6,7 +6,7 @@
   Author(s):  Peter Kazanzides, Ali Uneri
   Created on: 2009
 
-  (C) Copyright 2007-2013 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -296,6 +296,33 @@ class CISST_EXPORT osaSocket : public cmnGenericObject
     */
     int SendAsPackets(const std::string & bufsend, unsigned int packetSize, double timeoutSec = 0.0);
 
+    /*! \brief Send a header followed by a byte array via the socket without copying them
+               in a single buffer (gather send).  For UDP, both are sent in a single datagram.
+        \param header Buffer holding the header bytes
+        \param headerLength Number of header bytes
+        \param bufsend Buffer holding bytes to be sent after the header
+        \param msglen Number of bytes to send after the header
+        \param timeoutSec is the longest time we should wait to send something
+        \return Number of bytes sent, including the header (-1 if error)
+    */
+    int Send(const char * header, unsigned int headerLength,
+             const char * bufsend, unsigned int msglen, double timeoutSec = 0.0);
+
+    /*! \brief Send a header followed by a byte array via the socket, possibly in multiple
+               packets.  The packets sent are the same as SendAsPackets for the header and
+               byte array concatenated, but the data is not copied.
+        \param header Buffer holding the header bytes, headerLength must be less than packetSize
+        \param headerLength Number of header bytes
+        \param bufsend Buffer holding bytes to be sent after the header
+        \param msglen Number of bytes to send after the header
+        \param packetSize Maximum packet size
+        \param timeoutSec is the longest time we should wait to send something
+        \return Number of bytes sent, including the header (-1 if error)
+    */
+    int SendAsPackets(const char * header, unsigned int headerLength,
+                      const char * bufsend, unsigned int msglen,
+                      unsigned int packetSize, double timeoutSec = 0.0);
+
     /*! \brief Receive a byte array via the socket
         \param bufrecv Buffer to store received data
         \param maxlen Maximum number of bytes to receive
@@ -324,6 +351,14 @@ class CISST_EXPORT osaSocket : public cmnGenericObject
     int ReceiveAsPackets(std::string & bufrecv, char *packetBuffer, unsigned int packetSize,
                          double timeoutStartSec = 0.0, double timeoutNextSec = 0.0);
 
+    /*! \brief Same as ReceiveAsPackets above but packets are received directly in bufrecv,
+               without an intermediate packet buffer.  If the same string is used for
+               multiple calls, its memory is reused and there is no allocation once the
+               string is large enough for the longest message.
+    */
+    int ReceiveAsPackets(std::string & bufrecv, unsigned int packetSize,
+                         double timeoutStartSec = 0.0, double timeoutNextSec = 0.0);
+
     /*! \brief Close the socket
         \return False if close fails*/
     bool Close(void);
@@ -350,6 +385,10 @@ class CISST_EXPORT osaSocket : public cmnGenericObject
     /*! \return IP address (as a number) for the given host */
     unsigned long GetIP(const std::string & host) const;
 
+    /*! \brief Wait until the socket is ready to send, used by Send methods
+        \return False if select failed (TCP socket is closed) */
+    bool WaitForSend(double timeoutSec);
+
     SocketTypes SocketType;
     int SocketFD;
     bool Connected;
@@ -6,7 +6,7 @@
   Author(s): Ankur Kapoor, Min Yang Jung
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2010 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -100,6 +100,29 @@ public:
     /*! Suspend the execution of the real time thread for the
       remainder of the current period. */
     void WaitForRemainingPeriod(void);
+
+    /*! Use absolute wake up times for WaitForRemainingPeriod,
+      i.e. wake up times are computed from the first wake up time
+      plus a multiple of the period so the period doesn't drift.  If a
+      period has been completely missed, the next wake up time is the
+      next period boundary.  The thread wakes up spinTime seconds
+      before the wake up time and then busy-waits; this reduces the
+      wake up jitter at the cost of CPU usage and should only be used
+      on isolated cores.  This is only supported on Linux (using
+      clock_nanosleep with TIMER_ABSTIME), it is ignored on other
+      OSs.  Must be called before Create. */
+    void SetAbsoluteTimeWait(const bool absoluteTime, const double spinTime = 0.0);
+
+    /*! Wake up latency for the last call to WaitForRemainingPeriod,
+      i.e. difference between the actual and expected wake up times in
+      seconds.  Always 0 on OSs where it can't be measured (RTAI,
+      Xenomai, QNX). */
+    double GetWakeUpLatency(void) const;
+
+    /*! Number of periods skipped by the last call to
+      WaitForRemainingPeriod when using absolute wake up times
+      (see SetAbsoluteTimeWait), 0 otherwise. */
+    unsigned int GetNumberOfMissedPeriods(void) const;
     
     /*! Make a thread hard real time. */
     void MakeHardRealTime(void);
@@ -6,7 +6,7 @@
   Author(s): Martin Kelly, Anton Deguet
   Created on: 2011-03-15
 
-  (C) Copyright 2011 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2011-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -19,11 +19,17 @@ http://www.cisst.org/cisst/license.txt.
 
 */
 
+#ifndef _osaTripleBuffer_h
+#define _osaTripleBuffer_h
+
 #include <cisstConfig.h> // to define CISST_OS and CISST_COMPILER
 
+#include <cisstCommon/cmnPortability.h>
 #include <cisstCommon/cmnAssert.h>
 #include <cisstOSAbstraction/osaMutex.h>
 
+#include <atomic>
+
 /*!  Triple buffer to implement a thread safe, lock free, single
   reader single writer container.  This relies on a LIFO circular
   buffer with only three slots, one to read the latest value and two
@@ -40,12 +46,15 @@ http://www.cisst.org/cisst/license.txt.
   on valid memory slots or allocate the memory itself (see
   constructors).
 
-  The implementation relies on a mutex (using osaMutex) to make sure
-  the BeginRead, EndRead, BeginWrite and EndWrite methods are thread
-  safe.  The mutex is used for very brief
-  operations so there shouldn't be any long wait times.
+  The default implementation relies on a mutex (using osaMutex) to
+  make sure the BeginRead, EndRead, BeginWrite and EndWrite methods
+  are thread safe.  The mutex is used for very brief operations so
+  there shouldn't be any long wait times.  For real-time writers, use
+  the wait-free implementation by setting the second template
+  parameter to true, i.e. osaTripleBuffer<_elementType, true>.  The
+  API is the same for both implementations.
  */
-template <class _elementType>
+template <class _elementType, bool _waitFree = false>
 class osaTripleBuffer
 {
     friend class osaTripleBufferTest;
@@ -233,3 +242,188 @@ public:
                      << "WriteNode address: " << this->WriteNode << std::endl;
     }
 };
+
+
+/*! Wait-free triple buffer, same API as the default osaTripleBuffer.
+
+  The writer and the reader each own one slot (WriteIndex and
+  ReadIndex).  The third slot is shared and its index is stored in an
+  atomic state word along with a flag indicating if it contains data
+  that hasn't been read yet.  EndWrite atomically swaps the writer's
+  slot with the shared one and sets the flag.  BeginRead swaps the
+  reader's slot with the shared one only if the flag is set, i.e. if
+  a newer value is available.  Each method performs at most one
+  atomic exchange so neither thread ever waits for the other.
+
+  BeginWrite and EndRead don't do anything but are kept for
+  compatibility.
+*/
+template <class _elementType>
+class osaTripleBuffer<_elementType, true>
+{
+    friend class osaTripleBufferTest;
+
+    typedef _elementType value_type;
+
+    typedef osaTripleBuffer<value_type, true> ThisType;
+
+    typedef value_type * pointer;
+    typedef const value_type * const_pointer;
+    typedef value_type & reference;
+    typedef const value_type & const_reference;
+
+    // did the buffer allocate memory or used existing pointers
+    bool OwnMemory;
+    pointer Memory;
+
+    // the three slots
+    pointer Slots[3];
+
+    // bit set in state when the shared slot has been written but not read yet
+    enum {INDEX_MASK = 0x3, NEW_DATA = 0x4};
+
+    // shared between reader and writer
+    char PaddingBefore[CMN_CACHE_LINE_SIZE];
+    std::atomic<unsigned int> State;
+    char PaddingState[CMN_CACHE_LINE_SIZE - sizeof(std::atomic<unsigned int>)];
+
+    // only used by the writer
+    unsigned int WriteIndex;
+    char PaddingWrite[CMN_CACHE_LINE_SIZE - sizeof(unsigned int)];
+
+    // only used by the reader
+    unsigned int ReadIndex;
+    char PaddingRead[CMN_CACHE_LINE_SIZE - sizeof(unsigned int)];
+
+    // copy not allowed
+    osaTripleBuffer(const ThisType &);
+    ThisType & operator = (const ThisType &);
+
+public:
+    /*! Constructor that allocates memory for the triple buffer using
+      the default constructor for each element. */
+    inline osaTripleBuffer(void):
+        OwnMemory(true)
+    {
+        this->Memory = new value_type[3];
+        SetupSlots(this->Memory,
+                   this->Memory + 1,
+                   this->Memory + 2);
+    }
+
+    /*! Constructor that allocates memory for the triple buffer using
+      the copy constructor for each element. */
+    inline osaTripleBuffer(const_reference initialValue):
+        OwnMemory(true),
+        Memory(0)
+    {
+        SetupSlots(new value_type(initialValue),
+                   new value_type(initialValue),
+                   new value_type(initialValue));
+    }
+
+    /*! Constructor that doesn't allocate any memory, user has to
+      provide 3 valid pointers on 3 different pre-allocated
+      objects. */
+    inline osaTripleBuffer(pointer pointer1, pointer pointer2, pointer pointer3):
+        OwnMemory(false),
+        Memory(0)
+    {
+        SetupSlots(pointer1, pointer2, pointer3);
+    }
+
+    /*! Internal method to setup the slots.  The first slot is used
+      for reads until something is written, i.e. the reader sees the
+      same initial value as with the default implementation. */
+    inline void SetupSlots(pointer pointer1, pointer pointer2, pointer pointer3) {
+        CMN_ASSERT(pointer1);
+        CMN_ASSERT(pointer2);
+        CMN_ASSERT(pointer3);
+        this->Slots[0] = pointer1;
+        this->Slots[1] = pointer2;
+        this->Slots[2] = pointer3;
+        this->ReadIndex = 0;
+        this->WriteIndex = 1;
+        this->State.store(2, std::memory_order_release);
+    }
+
+    /*! Destructor.  If the memory is owned, it will delete the 3
+      objects allocated. */
+    inline ~osaTripleBuffer() {
+        if (this->OwnMemory) {
+            if (this->Memory) {
+                delete[] this->Memory;
+            } else {
+                delete this->Slots[2];
+                delete this->Slots[1];
+                delete this->Slots[0];
+            }
+        }
+    }
+
+    /*! Calls BeginRead, assign the last written value using the
+      operator = and then calls EndRead. */
+    inline void Read(reference placeHolder) {
+        this->BeginRead();
+        placeHolder = *(this->Slots[this->ReadIndex]);
+        this->EndRead();
+    }
+
+    /*! Calls BeginWrite, assign the new value to the current write
+      location using the operator = and then calls EndWrite. */
+    inline void Write(const_reference newValue) {
+        this->BeginWrite();
+        *(this->Slots[this->WriteIndex]) = newValue;
+        this->EndWrite();
+    }
+
+    /*! Function to access the memory to read safely, see BeginRead. */
+    inline const_pointer GetReadPointer(void) const {
+        return this->Slots[this->ReadIndex];
+    }
+
+    /*! Function to access the memory to write safely, see BeginWrite. */
+    inline pointer GetWritePointer(void) const {
+        return this->Slots[this->WriteIndex];
+    }
+
+    /*! Get the latest value written if it hasn't been read yet.  To
+      access the actual memory, use GetReadPointer. */
+    inline void BeginRead(void) {
+        if (this->State.load(std::memory_order_relaxed) & NEW_DATA) {
+            // acquire to see the data written before EndWrite
+            const unsigned int previous = this->State.exchange(this->ReadIndex,
+                                                               std::memory_order_acq_rel);
+            this->ReadIndex = previous & INDEX_MASK;
+        }
+    }
+
+    /*! Nothing to do, the read slot is owned by the reader until next BeginRead. */
+    inline void EndRead(void) {
+    }
+
+    /*! Nothing to do, the write slot is owned by the writer until EndWrite. */
+    inline void BeginWrite(void) {
+    }
+
+    /*! Publish the write slot and get the shared one to write next. */
+    inline void EndWrite(void) {
+        // release to publish the data written
+        const unsigned int previous = this->State.exchange(this->WriteIndex | NEW_DATA,
+                                                           std::memory_order_acq_rel);
+        this->WriteIndex = previous & INDEX_MASK;
+    }
+
+    /*! Method to display current state of triple buffer */
+    void ToStream(std::ostream & outputStream) const {
+        const unsigned int state = this->State.load();
+        outputStream << "Slots: "
+                     << this->Slots[0] << " " << this->Slots[1] << " " << this->Slots[2] << std::endl
+                     << "Shared slot: " << (state & INDEX_MASK)
+                     << ((state & NEW_DATA) ? " (new data)" : " (already read)") << std::endl
+                     << "Read slot: " << this->ReadIndex << std::endl
+                     << "Write slot: " << this->WriteIndex << std::endl;
+    }
+};
+
+#endif // _osaTripleBuffer_h
@@ -27,6 +27,7 @@ http://www.cisst.org/cisst/license.txt.
 
 typedef vctDynamicVector<size_t> value_type;
 typedef osaTripleBuffer<value_type> buffer_type;
+typedef osaTripleBuffer<value_type, true> buffer_wait_free_type;
 
 // sizes must be large enough to have a chance to find a problem but
 // short enough so that unit tests don't timeout.
@@ -45,7 +46,8 @@ void osaTripleBufferTest::setUp(void)
 }
 
 
-void * osaTripleBufferTestWriteThread(buffer_type * buffer)
+template <class _bufferType>
+void * osaTripleBufferTestWriteThread(_bufferType * buffer)
 {
     for (size_t iteration = 1;
          iteration <= NumberOfIterations;
@@ -68,7 +70,8 @@ void * osaTripleBufferTestWriteThread(buffer_type * buffer)
 }
 
 
-void * osaTripleBufferTestReadThread(buffer_type * buffer)
+template <class _bufferType>
+void * osaTripleBufferTestReadThread(_bufferType * buffer)
 {
     ErrorFoundInRead = false;
     size_t firstElement = 0;
@@ -114,16 +117,16 @@ void osaTripleBufferTest::TestMultiThreading(void)
     referenceVector.SetSize(TestVectorSize);
     referenceVector.SetAll(0);
 
-    osaTripleBuffer<value_type > tripleBuffer(referenceVector);
+    buffer_type tripleBuffer(referenceVector);
     CPPUNIT_ASSERT_EQUAL(TestVectorSize, tripleBuffer.LastWriteNode->Pointer->size());
     CPPUNIT_ASSERT_EQUAL(TestVectorSize, tripleBuffer.LastWriteNode->Next->Pointer->size());
     CPPUNIT_ASSERT_EQUAL(TestVectorSize, tripleBuffer.LastWriteNode->Next->Next->Pointer->size());
 
     osaThread readThread;
-    readThread.Create(osaTripleBufferTestReadThread, &tripleBuffer);
+    readThread.Create(osaTripleBufferTestReadThread<buffer_type>, &tripleBuffer);
 
     osaThread writeThread;
-    writeThread.Create(osaTripleBufferTestWriteThread, &tripleBuffer);
+    writeThread.Create(osaTripleBufferTestWriteThread<buffer_type>, &tripleBuffer);
 
     while (!(ReadThreadDone && WriteThreadDone)) {
         osaSleep(1.0 * cmn_ms);
@@ -201,4 +204,84 @@ void osaTripleBufferTest::TestLogic(void)
 }
 
 
+
+void osaTripleBufferTest::TestMultiThreadingWaitFree(void)
+{
+    value_type referenceVector;
+    referenceVector.SetSize(TestVectorSize);
+    referenceVector.SetAll(0);
+
+    buffer_wait_free_type tripleBuffer(referenceVector);
+    CPPUNIT_ASSERT_EQUAL(TestVectorSize, tripleBuffer.Slots[0]->size());
+    CPPUNIT_ASSERT_EQUAL(TestVectorSize, tripleBuffer.Slots[1]->size());
+    CPPUNIT_ASSERT_EQUAL(TestVectorSize, tripleBuffer.Slots[2]->size());
+
+    osaThread readThread;
+    readThread.Create(osaTripleBufferTestReadThread<buffer_wait_free_type>, &tripleBuffer);
+
+    osaThread writeThread;
+    writeThread.Create(osaTripleBufferTestWriteThread<buffer_wait_free_type>, &tripleBuffer);
+
+    while (!(ReadThreadDone && WriteThreadDone)) {
+        osaSleep(1.0 * cmn_ms);
+    }
+    CPPUNIT_ASSERT(!ErrorFoundInRead);
+}
+
+
+void osaTripleBufferTest::TestLogicWaitFree(void)
+{
+    int value1 = 0;
+    int value2 = 0;
+    int value3 = 0;
+    osaTripleBuffer<int, true> tripleBuffer(&value1, &value2, &value3);
+
+    // test initial configuration, reader starts on first slot
+    CPPUNIT_ASSERT_EQUAL(tripleBuffer.Slots[0], &value1);
+    CPPUNIT_ASSERT_EQUAL(tripleBuffer.Slots[1], &value2);
+    CPPUNIT_ASSERT_EQUAL(tripleBuffer.Slots[2], &value3);
+    CPPUNIT_ASSERT(tripleBuffer.GetReadPointer() == &value1);
+    CPPUNIT_ASSERT(tripleBuffer.GetWritePointer() != &value1);
+
+    // read without any write, should get initial value
+    tripleBuffer.BeginRead(); {
+        CPPUNIT_ASSERT_EQUAL(0, *(tripleBuffer.GetReadPointer()));
+    } tripleBuffer.EndRead();
+
+    // write and read
+    tripleBuffer.Write(1);
+    int result = 0;
+    tripleBuffer.Read(result);
+    CPPUNIT_ASSERT_EQUAL(1, result);
+
+    // read twice without new write, value shouldn't change
+    tripleBuffer.Read(result);
+    CPPUNIT_ASSERT_EQUAL(1, result);
+
+    // very long write, read in between
+    tripleBuffer.BeginWrite(); {
+        *(tripleBuffer.GetWritePointer()) = 2;
+        tripleBuffer.BeginRead(); {
+            CPPUNIT_ASSERT_EQUAL(1, *(tripleBuffer.GetReadPointer()));
+        } tripleBuffer.EndRead();
+    } tripleBuffer.EndWrite();
+    tripleBuffer.BeginRead(); {
+        CPPUNIT_ASSERT_EQUAL(2, *(tripleBuffer.GetReadPointer()));
+    } tripleBuffer.EndRead();
+
+    // very long read with multiple writes, writer never uses the read slot
+    tripleBuffer.BeginRead(); {
+        const int * readPointer = tripleBuffer.GetReadPointer();
+        for (int i = 3; i < 10; ++i) {
+            CPPUNIT_ASSERT(tripleBuffer.GetWritePointer() != readPointer);
+            tripleBuffer.Write(i);
+            CPPUNIT_ASSERT_EQUAL(2, *readPointer);
+        }
+    } tripleBuffer.EndRead();
+    // final read, only latest value
+    tripleBuffer.Read(result);
+    CPPUNIT_ASSERT_EQUAL(9, result);
+}
+
+
 CPPUNIT_TEST_SUITE_REGISTRATION(osaTripleBufferTest);
@@ -30,6 +30,8 @@ class osaTripleBufferTest : public CppUnit::TestFixture
     {
         CPPUNIT_TEST(TestLogic);
         CPPUNIT_TEST(TestMultiThreading);
+        CPPUNIT_TEST(TestLogicWaitFree);
+        CPPUNIT_TEST(TestMultiThreadingWaitFree);
 	}
     CPPUNIT_TEST_SUITE_END();
 
@@ -41,6 +43,12 @@ public:
 
     /*! Test multi threading */
     void TestMultiThreading(void);
+
+    /*! Test logic for wait-free implementation */
+    void TestLogicWaitFree(void);
+
+    /*! Test multi threading for wait-free implementation */
+    void TestMultiThreadingWaitFree(void);
 };
 
 #endif // _osaTripleBufferTest_h
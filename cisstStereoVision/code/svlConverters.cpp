@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2007 
 
-  (C) Copyright 2006-2007 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -20,6 +20,7 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include <cisstStereoVision/svlConverters.h>
+#include "svlConvertersSIMD.h"
 
 #define ACCURATE_COLOR_TO_GRAYSCALE     false
 
@@ -258,6 +259,26 @@ int svlConverter::ConvertImage(const svlSampleImage* inimage, const unsigned int
                      param);
 }
 
+svlConverter::SIMDInstructionSet svlConverter::SetSIMDInstructionSet(SIMDInstructionSet maxset)
+{
+    svlConverterSIMD::SetMaxInstructionSet(maxset);
+    return svlConverterSIMD::GetInstructionSet();
+}
+
+svlConverter::SIMDInstructionSet svlConverter::GetSIMDInstructionSet()
+{
+    return svlConverterSIMD::GetInstructionSet();
+}
+
+std::string svlConverter::GetSIMDInstructionSetName(SIMDInstructionSet set)
+{
+    switch (set) {
+        case SIMDSSE2: return "SSE2";
+        case SIMDAVX2: return "AVX2";
+        default:       return "none";
+    }
+}
+
 void svlConverter::Gray8toRGB24(unsigned char* input, unsigned char* output, const unsigned int pixelcount)
 {
     unsigned char chval;
@@ -671,9 +692,15 @@ void svlConverter::RGB24toRGBA32(unsigned char* input, unsigned char* output, co
 void svlConverter::RGB24toGray8(unsigned char* input, unsigned char* output, const unsigned int pixelcount, bool accurate, bool bgr)
 {
     unsigned int i, sum;
+
+    // AVX2 version, remaining pixels are converted below
+    i = svlConverterSIMD::RGB24toGray8(input, output, pixelcount, accurate, bgr);
+    input  += i * 3;
+    output += i;
+
     if (accurate) {
         if (bgr) {
-            for (i = 0; i < pixelcount; i ++) {
+            for (; i < pixelcount; i ++) {
                 sum  = 28  * (*input); input ++;
                 sum += 150 * (*input); input ++;
                 sum += 77  * (*input); input ++;
@@ -681,7 +708,7 @@ void svlConverter::RGB24toGray8(unsigned char* input, unsigned char* output, con
             }
         }
         else {
-            for (i = 0; i < pixelcount; i ++) {
+            for (; i < pixelcount; i ++) {
                 sum  = 77  * (*input); input ++;
                 sum += 150 * (*input); input ++;
                 sum += 28  * (*input); input ++;
@@ -690,7 +717,7 @@ void svlConverter::RGB24toGray8(unsigned char* input, unsigned char* output, con
         }
     }
     else {
-        for (i = 0; i < pixelcount; i ++) {
+        for (; i < pixelcount; i ++) {
             sum  = *input; input ++;
             sum += *input; input ++;
             sum += *input; input ++;
@@ -828,8 +855,16 @@ void svlConverter::BGR24toYUV422(unsigned char* input, unsigned char* output, co
 {
     int r, g, b, y1, y2, u1, u2, v1, v2;
     const unsigned int pixelcounthalf = pixelcount >> 1;
+    unsigned int i = 0;
 
-    for (unsigned int i = 0; i < pixelcounthalf; i ++) {
+    // SSE2/AVX2 version, remaining pixels are converted below
+    if (ch1 && ch2 && ch3) {
+        i = svlConverterSIMD::RGB24toYUV422(input, output, pixelcount, true) >> 1;
+        input  += i * 6;
+        output += i * 4;
+    }
+
+    for (; i < pixelcounthalf; i ++) {
         b = *input; input ++;
         g = *input; input ++;
         r = *input; input ++;
@@ -879,8 +914,16 @@ void svlConverter::RGB24toYUV422(unsigned char* input, unsigned char* output, co
 {
     int r, g, b, y1, y2, u1, u2, v1, v2;
     const unsigned int pixelcounthalf = pixelcount >> 1;
+    unsigned int i = 0;
 
-    for (unsigned int i = 0; i < pixelcounthalf; i ++) {
+    // SSE2/AVX2 version, remaining pixels are converted below
+    if (ch1 && ch2 && ch3) {
+        i = svlConverterSIMD::RGB24toYUV422(input, output, pixelcount, false) >> 1;
+        input  += i * 6;
+        output += i * 4;
+    }
+
+    for (; i < pixelcounthalf; i ++) {
         r = *input; input ++;
         g = *input; input ++;
         b = *input; input ++;
@@ -1336,6 +1379,14 @@ void svlConverter::YUV422toRGB24(unsigned char* input, unsigned char* output, co
     const unsigned int pixelcounthalf = pixelcount >> 1;
     unsigned char *y1, *y2, *u, *v, *r1, *g1, *b1, *r2, *g2, *b2;
     int ty1, ty2, tv1, tv2, tu1, tu2, res;
+    unsigned int i = 0;
+
+    // SSE2/AVX2 version, remaining pixels are converted below
+    if (ch1 && ch2 && ch3) {
+        i = svlConverterSIMD::YUV422toRGB24(input, output, pixelcount, false) >> 1;
+        input  += i * 4;
+        output += i * 6;
+    }
 
     y1 = input;
     u  = y1 + 1;
@@ -1349,7 +1400,7 @@ void svlConverter::YUV422toRGB24(unsigned char* input, unsigned char* output, co
     g2 = b2 + 1;
     r2 = g2 + 1;
 
-    for (unsigned int i = 0; i < pixelcounthalf; i ++) {
+    for (; i < pixelcounthalf; i ++) {
         tu1 = *u;
         tu1 -= 128;
 
@@ -1493,7 +1544,16 @@ void svlConverter::NV21toRGB24(unsigned char* input, unsigned char* output, cons
     unsigned int i, j;
 
     for (j = 0; j < height_half; j ++) {
-        for (i = 0; i < width_half; i ++) {
+
+        // SSE2/AVX2 version, remaining columns are converted below
+        i = svlConverterSIMD::NV21toRGB24(iny1, iny2, inuv, output, output2, width_half << 1);
+        iny1    += i;
+        iny2    += i;
+        inuv    += i;
+        output  += i * 3;
+        output2 += i * 3;
+
+        for (i >>= 1; i < width_half; i ++) {
 
             u = *inuv; inuv ++;
             v = *inuv; inuv ++;
@@ -1597,6 +1657,14 @@ void svlConverter::UYVYtoRGB24(unsigned char* input, unsigned char* output, cons
     const unsigned int pixelcounthalf = pixelcount >> 1;
     unsigned char *y1, *y2, *u, *v, *r1, *g1, *b1, *r2, *g2, *b2;
     int ty1, ty2, tv1, tv2, tu1, tu2, res;
+    unsigned int i = 0;
+
+    // SSE2/AVX2 version, remaining pixels are converted below
+    if (ch1 && ch2 && ch3) {
+        i = svlConverterSIMD::YUV422toRGB24(input, output, pixelcount, true) >> 1;
+        input  += i * 4;
+        output += i * 6;
+    }
 
     u  = input;
     y1 = u  + 1;
@@ -1610,7 +1678,7 @@ void svlConverter::UYVYtoRGB24(unsigned char* input, unsigned char* output, cons
     g2 = b2 + 1;
     r2 = g2 + 1;
 
-    for (unsigned int i = 0; i < pixelcounthalf; i ++) {
+    for (; i < pixelcounthalf; i ++) {
         tu1 = *u;
         tu1 -= 128;
 
@@ -0,0 +1,344 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include "svlConvertersSIMD.h"
+
+#include <atomic>
+
+
+#ifdef SVL_CONVERTER_SSE2
+
+/***************************/
+/*** SSE2 implementation ***/
+/***************************/
+
+namespace svlConverterSSE2
+{
+    class Vec
+    {
+    public:
+        typedef __m128i Reg;
+        enum {Bytes = 16};
+
+        static inline Reg Load(const unsigned char* input) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(input)); }
+        static inline void Store(unsigned char* output, const Reg a) { _mm_storeu_si128(reinterpret_cast<__m128i*>(output), a); }
+
+        static inline Reg Set16(const int a) { return _mm_set1_epi16(static_cast<short>(a)); }
+        static inline Reg Set32(const int a) { return _mm_set1_epi32(a); }
+        // First value in the lower 16 bits of each 32 bit element, for Madd16
+        static inline Reg Set16Pair(const int lo, const int hi) { return _mm_set1_epi32(static_cast<int>((static_cast<unsigned int>(hi) << 16) | (lo & 0xFFFF))); }
+
+        static inline Reg And(const Reg a, const Reg b) { return _mm_and_si128(a, b); }
+        static inline Reg Or(const Reg a, const Reg b) { return _mm_or_si128(a, b); }
+        static inline Reg Add16(const Reg a, const Reg b) { return _mm_add_epi16(a, b); }
+        static inline Reg Sub16(const Reg a, const Reg b) { return _mm_sub_epi16(a, b); }
+        static inline Reg Add32(const Reg a, const Reg b) { return _mm_add_epi32(a, b); }
+        static inline Reg Min16(const Reg a, const Reg b) { return _mm_min_epi16(a, b); }
+        static inline Reg Mullo16(const Reg a, const Reg b) { return _mm_mullo_epi16(a, b); }
+        static inline Reg Mulhi16u(const Reg a, const Reg b) { return _mm_mulhi_epu16(a, b); }
+        static inline Reg Madd16(const Reg a, const Reg b) { return _mm_madd_epi16(a, b); }
+        static inline Reg Unpacklo16(const Reg a, const Reg b) { return _mm_unpacklo_epi16(a, b); }
+        static inline Reg Unpackhi16(const Reg a, const Reg b) { return _mm_unpackhi_epi16(a, b); }
+        static inline Reg Packs32(const Reg a, const Reg b) { return _mm_packs_epi32(a, b); }
+        static inline Reg Packus16(const Reg a, const Reg b) { return _mm_packus_epi16(a, b); }
+
+        template <int n> static inline Reg Srli16(const Reg a) { return _mm_srli_epi16(a, n); }
+        template <int n> static inline Reg Slli16(const Reg a) { return _mm_slli_epi16(a, n); }
+        template <int n> static inline Reg Srli32(const Reg a) { return _mm_srli_epi32(a, n); }
+        template <int n> static inline Reg Slli32(const Reg a) { return _mm_slli_epi32(a, n); }
+        template <int n> static inline Reg Srai32(const Reg a) { return _mm_srai_epi32(a, n); }
+
+        // Unsigned 8 bit to 16 bit
+        static inline void Expand8(const Reg a, Reg& lo, Reg& hi)
+        {
+            const Reg zero = _mm_setzero_si128();
+            lo = _mm_unpacklo_epi8(a, zero);
+            hi = _mm_unpackhi_epi8(a, zero);
+        }
+
+        // SSE2 has no byte shuffle, 3 channel (de)interleaving is scalar
+        static inline void Load3(const unsigned char* input, Reg& c0, Reg& c1, Reg& c2)
+        {
+            unsigned char buffer[3][Bytes];
+            for (unsigned int i = 0; i < Bytes; i ++) {
+                buffer[0][i] = input[0];
+                buffer[1][i] = input[1];
+                buffer[2][i] = input[2];
+                input += 3;
+            }
+            c0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer[0]));
+            c1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer[1]));
+            c2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer[2]));
+        }
+
+        static inline void Store3(unsigned char* output, const Reg c0, const Reg c1, const Reg c2)
+        {
+            unsigned char buffer[3][Bytes];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer[0]), c0);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer[1]), c1);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer[2]), c2);
+            for (unsigned int i = 0; i < Bytes; i ++) {
+                output[0] = buffer[0][i];
+                output[1] = buffer[1][i];
+                output[2] = buffer[2][i];
+                output += 3;
+            }
+        }
+    };
+
+    #include "svlConvertersSIMDKernels.h"
+}
+
+#endif // SVL_CONVERTER_SSE2
+
+
+#ifdef SVL_CONVERTER_AVX2
+
+/***************************/
+/*** AVX2 implementation ***/
+/***************************/
+
+#if defined(__clang__)
+    #pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+    #pragma GCC push_options
+    #pragma GCC target("avx2")
+#endif
+
+namespace svlConverterAVX2
+{
+    class Vec
+    {
+    public:
+        typedef __m256i Reg;
+        enum {Bytes = 32};
+
+        static inline Reg Load(const unsigned char* input) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input)); }
+        static inline void Store(unsigned char* output, const Reg a) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), a); }
+
+        static inline Reg Set16(const int a) { return _mm256_set1_epi16(static_cast<short>(a)); }
+        static inline Reg Set32(const int a) { return _mm256_set1_epi32(a); }
+        static inline Reg Set16Pair(const int lo, const int hi) { return _mm256_set1_epi32(static_cast<int>((static_cast<unsigned int>(hi) << 16) | (lo & 0xFFFF))); }
+
+        // Unpacks and packs operate within each 128 bit lane, unpacking
+        // then packing restores the original order
+        static inline Reg And(const Reg a, const Reg b) { return _mm256_and_si256(a, b); }
+        static inline Reg Or(const Reg a, const Reg b) { return _mm256_or_si256(a, b); }
+        static inline Reg Add16(const Reg a, const Reg b) { return _mm256_add_epi16(a, b); }
+        static inline Reg Sub16(const Reg a, const Reg b) { return _mm256_sub_epi16(a, b); }
+        static inline Reg Add32(const Reg a, const Reg b) { return _mm256_add_epi32(a, b); }
+        static inline Reg Min16(const Reg a, const Reg b) { return _mm256_min_epi16(a, b); }
+        static inline Reg Mullo16(const Reg a, const Reg b) { return _mm256_mullo_epi16(a, b); }
+        static inline Reg Mulhi16u(const Reg a, const Reg b) { return _mm256_mulhi_epu16(a, b); }
+        static inline Reg Madd16(const Reg a, const Reg b) { return _mm256_madd_epi16(a, b); }
+        static inline Reg Unpacklo16(const Reg a, const Reg b) { return _mm256_unpacklo_epi16(a, b); }
+        static inline Reg Unpackhi16(const Reg a, const Reg b) { return _mm256_unpackhi_epi16(a, b); }
+        static inline Reg Packs32(const Reg a, const Reg b) { return _mm256_packs_epi32(a, b); }
+        // Packing two different registers interleaves their lanes
+        static inline Reg Packus16(const Reg a, const Reg b) { return _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8); }
+
+        template <int n> static inline Reg Srli16(const Reg a) { return _mm256_srli_epi16(a, n); }
+        template <int n> static inline Reg Slli16(const Reg a) { return _mm256_slli_epi16(a, n); }
+        template <int n> static inline Reg Srli32(const Reg a) { return _mm256_srli_epi32(a, n); }
+        template <int n> static inline Reg Slli32(const Reg a) { return _mm256_slli_epi32(a, n); }
+        template <int n> static inline Reg Srai32(const Reg a) { return _mm256_srai_epi32(a, n); }
+
+        static inline void Expand8(const Reg a, Reg& lo, Reg& hi)
+        {
+            const Reg zero = _mm256_setzero_si256();
+            const Reg b = _mm256_permute4x64_epi64(a, 0xD8);
+            lo = _mm256_unpacklo_epi8(b, zero);
+            hi = _mm256_unpackhi_epi8(b, zero);
+        }
+
+        // 16 pixels (48 bytes) to/from 3 registers of 16 bytes
+        static inline void Deinterleave3(const unsigned char* input, __m128i& c0, __m128i& c1, __m128i& c2)
+        {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 16));
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 32));
+            const char z = -128;
+            c0 = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, _mm_setr_epi8(0, 3, 6, 9, 12, 15, z, z, z, z, z, z, z, z, z, z)),
+                                           _mm_shuffle_epi8(b, _mm_setr_epi8(z, z, z, z, z, z, 2, 5, 8, 11, 14, z, z, z, z, z))),
+                              _mm_shuffle_epi8(c, _mm_setr_epi8(z, z, z, z, z, z, z, z, z, z, z, 1, 4, 7, 10, 13)));
+            c1 = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, _mm_setr_epi8(1, 4, 7, 10, 13, z, z, z, z, z, z, z, z, z, z, z)),
+                                           _mm_shuffle_epi8(b, _mm_setr_epi8(z, z, z, z, z, 0, 3, 6, 9, 12, 15, z, z, z, z, z))),
+                              _mm_shuffle_epi8(c, _mm_setr_epi8(z, z, z, z, z, z, z, z, z, z, z, 2, 5, 8, 11, 14)));
+            c2 = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, _mm_setr_epi8(2, 5, 8, 11, 14, z, z, z, z, z, z, z, z, z, z, z)),
+                                           _mm_shuffle_epi8(b, _mm_setr_epi8(z, z, z, z, z, 1, 4, 7, 10, 13, z, z, z, z, z, z))),
+                              _mm_shuffle_epi8(c, _mm_setr_epi8(z, z, z, z, z, z, z, z, z, z, 0, 3, 6, 9, 12, 15)));
+        }
+
+        static inline void Interleave3(unsigned char* output, const __m128i c0, const __m128i c1, const __m128i c2)
+        {
+            const char z = -128;
+            const __m128i a = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(c0, _mm_setr_epi8(0, z, z, 1, z, z, 2, z, z, 3, z, z, 4, z, z, 5)),
+                                                        _mm_shuffle_epi8(c1, _mm_setr_epi8(z, 0, z, z, 1, z, z, 2, z, z, 3, z, z, 4, z, z))),
+                                           _mm_shuffle_epi8(c2, _mm_setr_epi8(z, z, 0, z, z, 1, z, z, 2, z, z, 3, z, z, 4, z)));
+            const __m128i b = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(c0, _mm_setr_epi8(z, z, 6, z, z, 7, z, z, 8, z, z, 9, z, z, 10, z)),
+                                                        _mm_shuffle_epi8(c1, _mm_setr_epi8(5, z, z, 6, z, z, 7, z, z, 8, z, z, 9, z, z, 10))),
+                                           _mm_shuffle_epi8(c2, _mm_setr_epi8(z, 5, z, z, 6, z, z, 7, z, z, 8, z, z, 9, z, z)));
+            const __m128i c = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(c0, _mm_setr_epi8(z, 11, z, z, 12, z, z, 13, z, z, 14, z, z, 15, z, z)),
+                                                        _mm_shuffle_epi8(c1, _mm_setr_epi8(z, z, 11, z, z, 12, z, z, 13, z, z, 14, z, z, 15, z))),
+                                           _mm_shuffle_epi8(c2, _mm_setr_epi8(10, z, z, 11, z, z, 12, z, z, 13, z, z, 14, z, z, 15)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output), a);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 16), b);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 32), c);
+        }
+
+        static inline void Load3(const unsigned char* input, Reg& c0, Reg& c1, Reg& c2)
+        {
+            __m128i lo0, lo1, lo2, hi0, hi1, hi2;
+            Deinterleave3(input, lo0, lo1, lo2);
+            Deinterleave3(input + 48, hi0, hi1, hi2);
+            c0 = _mm256_inserti128_si256(_mm256_castsi128_si256(lo0), hi0, 1);
+            c1 = _mm256_inserti128_si256(_mm256_castsi128_si256(lo1), hi1, 1);
+            c2 = _mm256_inserti128_si256(_mm256_castsi128_si256(lo2), hi2, 1);
+        }
+
+        static inline void Store3(unsigned char* output, const Reg c0, const Reg c1, const Reg c2)
+        {
+            Interleave3(output, _mm256_castsi256_si128(c0), _mm256_castsi256_si128(c1), _mm256_castsi256_si128(c2));
+            Interleave3(output + 48, _mm256_extracti128_si256(c0, 1), _mm256_extracti128_si256(c1, 1), _mm256_extracti128_si256(c2, 1));
+        }
+    };
+
+    #include "svlConvertersSIMDKernels.h"
+}
+
+#if defined(__clang__)
+    #pragma clang attribute pop
+#elif defined(__GNUC__)
+    #pragma GCC pop_options
+#endif
+
+#endif // SVL_CONVERTER_AVX2
+
+
+/**************************/
+/*** Run time dispatch ****/
+/**************************/
+
+static std::atomic<int> svlConverterSIMDMaxInstructionSet(svlConverter::SIMDAVX2);
+
+svlConverter::SIMDInstructionSet svlConverterSIMD::GetSupportedInstructionSet()
+{
+    static const svlConverter::SIMDInstructionSet supported = []() {
+#ifdef SVL_CONVERTER_AVX2
+    #if defined(_MSC_VER)
+        // AVX2 requires OS support for the YMM registers (OSXSAVE and XCR0)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] >= 7) {
+            __cpuid(info, 1);
+            if ((info[2] & (1 << 27)) && (info[2] & (1 << 28)) && ((_xgetbv(0) & 6) == 6)) {
+                __cpuidex(info, 7, 0);
+                if (info[1] & (1 << 5)) return svlConverter::SIMDAVX2;
+            }
+        }
+    #else
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return svlConverter::SIMDAVX2;
+    #endif
+#endif
+#ifdef SVL_CONVERTER_SSE2
+        return svlConverter::SIMDSSE2;
+#else
+        return svlConverter::SIMDNone;
+#endif
+    }();
+    return supported;
+}
+
+svlConverter::SIMDInstructionSet svlConverterSIMD::GetInstructionSet()
+{
+    const int supported = GetSupportedInstructionSet();
+    const int maxset = svlConverterSIMDMaxInstructionSet;
+    return static_cast<svlConverter::SIMDInstructionSet>(supported < maxset ? supported : maxset);
+}
+
+void svlConverterSIMD::SetMaxInstructionSet(svlConverter::SIMDInstructionSet maxset)
+{
+    svlConverterSIMDMaxInstructionSet = maxset;
+}
+
+unsigned int svlConverterSIMD::YUV422toRGB24(const unsigned char* input, unsigned char* output, const unsigned int pixelcount, const bool uyvy)
+{
+    switch (GetInstructionSet()) {
+#ifdef SVL_CONVERTER_AVX2
+        case svlConverter::SIMDAVX2:
+            return svlConverterAVX2::YUV422toRGB24(input, output, pixelcount, uyvy);
+#endif
+#ifdef SVL_CONVERTER_SSE2
+        case svlConverter::SIMDSSE2:
+            return svlConverterSSE2::YUV422toRGB24(input, output, pixelcount, uyvy);
+#endif
+        default:
+            return 0;
+    }
+}
+
+unsigned int svlConverterSIMD::RGB24toYUV422(const unsigned char* input, unsigned char* output, const unsigned int pixelcount, const bool bgr)
+{
+    switch (GetInstructionSet()) {
+#ifdef SVL_CONVERTER_AVX2
+        case svlConverter::SIMDAVX2:
+            return svlConverterAVX2::RGB24toYUV422(input, output, pixelcount, bgr);
+#endif
+#ifdef SVL_CONVERTER_SSE2
+        case svlConverter::SIMDSSE2:
+            return svlConverterSSE2::RGB24toYUV422(input, output, pixelcount, bgr);
+#endif
+        default:
+            return 0;
+    }
+}
+
+unsigned int svlConverterSIMD::RGB24toGray8(const unsigned char* input, unsigned char* output, const unsigned int pixelcount, const bool accurate, const bool bgr)
+{
+    switch (GetInstructionSet()) {
+#ifdef SVL_CONVERTER_AVX2
+        case svlConverter::SIMDAVX2:
+            return svlConverterAVX2::RGB24toGray8(input, output, pixelcount, accurate, bgr);
+#endif
+        // The SSE2 version is limited by the scalar deinterleaving and
+        // slower than the compiler optimized scalar code
+        default:
+            return 0;
+    }
+}
+
+unsigned int svlConverterSIMD::NV21toRGB24(const unsigned char* iny1, const unsigned char* iny2, const unsigned char* inuv,
+                                           unsigned char* output1, unsigned char* output2, const unsigned int width)
+{
+    switch (GetInstructionSet()) {
+#ifdef SVL_CONVERTER_AVX2
+        case svlConverter::SIMDAVX2:
+            return svlConverterAVX2::NV21toRGB24(iny1, iny2, inuv, output1, output2, width);
+#endif
+#ifdef SVL_CONVERTER_SSE2
+        case svlConverter::SIMDSSE2:
+            return svlConverterSSE2::NV21toRGB24(iny1, iny2, inuv, output1, output2, width);
+#endif
+        default:
+            return 0;
+    }
+}
+
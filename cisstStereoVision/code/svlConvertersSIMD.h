@@ -0,0 +1,68 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#ifndef _svlConvertersSIMD_h
+#define _svlConvertersSIMD_h
+
+#include <cisstStereoVision/svlConverters.h>
+
+// SSE2 is part of all x86-64 processors.  AVX2 kernels are compiled
+// for a different target (GCC and clang) or directly (Visual Studio)
+// without any specific compiler flag and only used if supported by
+// the CPU.
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define SVL_CONVERTER_SSE2
+    #include <emmintrin.h>
+    #if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ >= 5)) || (defined(_MSC_VER) && (_MSC_VER >= 1900))
+        #define SVL_CONVERTER_AVX2
+        #include <immintrin.h>
+        #if defined(_MSC_VER)
+            #include <intrin.h>
+        #endif
+    #endif
+#endif
+
+
+/*
+  SSE2 and AVX2 versions of the converters listed in
+  svlConverter::SIMDInstructionSet, dispatched at run time.  Each
+  function converts the largest number of pixels it can process with
+  full SIMD registers and returns that number (0 if no instruction set
+  is available), the caller converts the remaining pixels with the
+  scalar code.  Only used when all channels are enabled.
+*/
+namespace svlConverterSIMD
+{
+    svlConverter::SIMDInstructionSet GetSupportedInstructionSet();
+    svlConverter::SIMDInstructionSet GetInstructionSet();
+    void SetMaxInstructionSet(svlConverter::SIMDInstructionSet maxset);
+
+    // Input is Y1 U Y2 V (or U Y1 V Y2 if uyvy is true), output is BGR
+    unsigned int YUV422toRGB24(const unsigned char* input, unsigned char* output, const unsigned int pixelcount, const bool uyvy);
+    // Input is RGB (or BGR if bgr is true), output is Y1 U Y2 V
+    unsigned int RGB24toYUV422(const unsigned char* input, unsigned char* output, const unsigned int pixelcount, const bool bgr);
+    unsigned int RGB24toGray8(const unsigned char* input, unsigned char* output, const unsigned int pixelcount, const bool accurate, const bool bgr);
+    // Converts a pair of rows sharing the same interleaved chroma row, output is RGB
+    unsigned int NV21toRGB24(const unsigned char* iny1, const unsigned char* iny2, const unsigned char* inuv,
+                             unsigned char* output1, unsigned char* output2, const unsigned int width);
+}
+
+#endif // _svlConvertersSIMD_h
+
@@ -0,0 +1,257 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+/*
+  Converter kernels shared by all instruction sets.  This file has no
+  include guard: svlConvertersSIMD.cpp includes it once per
+  instruction set, inside a namespace defining the class Vec which
+  wraps the SIMD register type and operations.  Vec::Bytes pixels are
+  converted per iteration.
+
+  All computations use the same integer arithmetic as the scalar code
+  in svlConverters.cpp: products are accumulated in 32 bits with
+  Madd16 on interleaved (value, value) pairs, and the final clamping is
+  performed by the saturating packs.
+*/
+
+// Splits Y1 U Y2 V (or U Y1 V Y2) into 16 bit Y, U and V, chroma
+// values are duplicated for both pixels of each pair
+static inline void SplitYUV422(const Vec::Reg in, const bool uyvy,
+                               Vec::Reg& y, Vec::Reg& u, Vec::Reg& v)
+{
+    const Vec::Reg lowbytes = Vec::Set16(0x00FF);
+    const Vec::Reg lowwords = Vec::Set32(0x0000FFFF);
+    Vec::Reg c;
+    if (uyvy) {
+        y = Vec::Srli16<8>(in);
+        c = Vec::And(in, lowbytes);
+    }
+    else {
+        y = Vec::And(in, lowbytes);
+        c = Vec::Srli16<8>(in);
+    }
+    u = Vec::And(c, lowwords);
+    u = Vec::Or(u, Vec::Slli32<16>(u));
+    v = Vec::Srli32<16>(c);
+    v = Vec::Or(v, Vec::Slli32<16>(v));
+}
+
+// Duplicates interleaved 16 bit chroma values U V for both pixels of
+// each pair, same as above
+static inline void SplitUV(const Vec::Reg c, Vec::Reg& u, Vec::Reg& v)
+{
+    const Vec::Reg lowwords = Vec::Set32(0x0000FFFF);
+    u = Vec::And(c, lowwords);
+    u = Vec::Or(u, Vec::Slli32<16>(u));
+    v = Vec::Srli32<16>(c);
+    v = Vec::Or(v, Vec::Slli32<16>(v));
+}
+
+// Computes (a * coef_a + b * coef_b) >> shift for all 16 bit elements
+// of a and b, coefficients are interleaved in coef (see Vec::Set16Pair)
+template <int shift>
+static inline Vec::Reg MultiplyAdd(const Vec::Reg a, const Vec::Reg b, const Vec::Reg coef)
+{
+    return Vec::Packs32(Vec::Srai32<shift>(Vec::Madd16(Vec::Unpacklo16(a, b), coef)),
+                        Vec::Srai32<shift>(Vec::Madd16(Vec::Unpackhi16(a, b), coef)));
+}
+
+// Same with two pairs of values: (a * coef1_a + b * coef1_b + c * coef2_c + d * coef2_d) >> shift
+template <int shift>
+static inline Vec::Reg MultiplyAdd(const Vec::Reg a, const Vec::Reg b, const Vec::Reg coef1,
+                                   const Vec::Reg c, const Vec::Reg d, const Vec::Reg coef2)
+{
+    return Vec::Packs32(Vec::Srai32<shift>(Vec::Add32(Vec::Madd16(Vec::Unpacklo16(a, b), coef1),
+                                                      Vec::Madd16(Vec::Unpacklo16(c, d), coef2))),
+                        Vec::Srai32<shift>(Vec::Add32(Vec::Madd16(Vec::Unpackhi16(a, b), coef1),
+                                                      Vec::Madd16(Vec::Unpackhi16(c, d), coef2))));
+}
+
+
+unsigned int YUV422toRGB24(const unsigned char* input, unsigned char* output, const unsigned int pixelcount, const bool uyvy)
+{
+    const unsigned int count = pixelcount - pixelcount % Vec::Bytes;
+    const Vec::Reg offset_y = Vec::Set16(16);
+    const Vec::Reg offset_c = Vec::Set16(128);
+    const Vec::Reg coef_b   = Vec::Set16Pair(298, 517);   // y, u
+    const Vec::Reg coef_g1  = Vec::Set16Pair(298, -208);  // y, v
+    const Vec::Reg coef_g2  = Vec::Set16Pair(0, 100);     // y, u
+    const Vec::Reg coef_r   = Vec::Set16Pair(298, 409);   // y, v
+    Vec::Reg y, u, v, b[2], g[2], r[2];
+    unsigned int i, k;
+
+    for (i = 0; i < count; i += Vec::Bytes) {
+        for (k = 0; k < 2; k ++) {
+            SplitYUV422(Vec::Load(input), uyvy, y, u, v);
+            input += Vec::Bytes;
+
+            y = Vec::Sub16(y, offset_y);
+            u = Vec::Sub16(u, offset_c);
+            v = Vec::Sub16(v, offset_c);
+
+            b[k] = MultiplyAdd<8>(y, u, coef_b);
+            g[k] = MultiplyAdd<8>(y, v, coef_g1, y, u, coef_g2);
+            r[k] = MultiplyAdd<8>(y, v, coef_r);
+        }
+        Vec::Store3(output, Vec::Packus16(b[0], b[1]), Vec::Packus16(g[0], g[1]), Vec::Packus16(r[0], r[1]));
+        output += 3 * Vec::Bytes;
+    }
+
+    return count;
+}
+
+unsigned int RGB24toYUV422(const unsigned char* input, unsigned char* output, const unsigned int pixelcount, const bool bgr)
+{
+    const unsigned int count = pixelcount - pixelcount % Vec::Bytes;
+    // Constant terms are multiplied by 4096 in the second coefficient:
+    //   33 * 4096 = 4096 + 131072 and 257 * 4096 = 4096 + 1048576
+    // All sums are positive for 8 bit inputs so that no absolute value
+    // is needed
+    const Vec::Reg offset_y  = Vec::Set16(33);
+    const Vec::Reg offset_uv = Vec::Set16(257);
+    const Vec::Reg coef_y_rg = Vec::Set16Pair(2104, 4130);
+    const Vec::Reg coef_y_b  = Vec::Set16Pair(802, 4096);
+    const Vec::Reg coef_u_rg = Vec::Set16Pair(-1214, -2384);
+    const Vec::Reg coef_u_b  = Vec::Set16Pair(3598, 4096);
+    const Vec::Reg coef_v_rg = Vec::Set16Pair(3598, -3013);
+    const Vec::Reg coef_v_b  = Vec::Set16Pair(-585, 4096);
+    const Vec::Reg max_y     = Vec::Set16(235);
+    const Vec::Reg max_uv    = Vec::Set16(240);
+    const Vec::Reg ones      = Vec::Set16(1);
+    Vec::Reg c0, c1, c2, r[2], g[2], b[2], y, u, v, uv;
+    unsigned int i, k;
+
+    for (i = 0; i < count; i += Vec::Bytes) {
+        Vec::Load3(input, c0, c1, c2);
+        input += 3 * Vec::Bytes;
+
+        Vec::Expand8(bgr ? c2 : c0, r[0], r[1]);
+        Vec::Expand8(c1, g[0], g[1]);
+        Vec::Expand8(bgr ? c0 : c2, b[0], b[1]);
+
+        for (k = 0; k < 2; k ++) {
+            y = Vec::Min16(MultiplyAdd<13>(r[k], g[k], coef_y_rg, b[k], offset_y, coef_y_b), max_y);
+            u = Vec::Min16(MultiplyAdd<13>(r[k], g[k], coef_u_rg, b[k], offset_uv, coef_u_b), max_uv);
+            v = Vec::Min16(MultiplyAdd<13>(r[k], g[k], coef_v_rg, b[k], offset_uv, coef_v_b), max_uv);
+
+            // Average chroma of each pair: U in the lower and V in the
+            // upper 16 bits, then moved to the upper byte of Y1 and Y2
+            uv = Vec::Or(Vec::Srli32<1>(Vec::Madd16(u, ones)),
+                         Vec::Slli32<16>(Vec::Srli32<1>(Vec::Madd16(v, ones))));
+            Vec::Store(output, Vec::Or(y, Vec::Slli16<8>(uv)));
+            output += Vec::Bytes;
+        }
+    }
+
+    return count;
+}
+
+unsigned int RGB24toGray8(const unsigned char* input, unsigned char* output, const unsigned int pixelcount, const bool accurate, const bool bgr)
+{
+    const unsigned int count = pixelcount - pixelcount % Vec::Bytes;
+    // Largest accurate sum is 255 * 255 and x / 3 == (x * 43691) >> 17
+    // for all 16 bit values so that all operations fit in 16 bits
+    const Vec::Reg coef_0 = Vec::Set16(bgr ? 28 : 77);
+    const Vec::Reg coef_1 = Vec::Set16(150);
+    const Vec::Reg coef_2 = Vec::Set16(bgr ? 77 : 28);
+    const Vec::Reg third  = Vec::Set16(43691);
+    Vec::Reg c0, c1, c2, a[2], b[2], c[2], gray[2];
+    unsigned int i, k;
+
+    for (i = 0; i < count; i += Vec::Bytes) {
+        Vec::Load3(input, c0, c1, c2);
+        input += 3 * Vec::Bytes;
+
+        Vec::Expand8(c0, a[0], a[1]);
+        Vec::Expand8(c1, b[0], b[1]);
+        Vec::Expand8(c2, c[0], c[1]);
+
+        for (k = 0; k < 2; k ++) {
+            if (accurate) {
+                gray[k] = Vec::Add16(Vec::Add16(Vec::Mullo16(a[k], coef_0), Vec::Mullo16(b[k], coef_1)),
+                                     Vec::Mullo16(c[k], coef_2));
+                gray[k] = Vec::Srli16<8>(gray[k]);
+            }
+            else {
+                gray[k] = Vec::Add16(Vec::Add16(a[k], b[k]), c[k]);
+                gray[k] = Vec::Srli16<1>(Vec::Mulhi16u(gray[k], third));
+            }
+        }
+        Vec::Store(output, Vec::Packus16(gray[0], gray[1]));
+        output += Vec::Bytes;
+    }
+
+    return count;
+}
+
+// Converts Vec::Bytes pixels of one NV21 row, y is the expanded and
+// offset luminance
+static inline void NV21toRGB24Row(const Vec::Reg* y, const Vec::Reg* u, const Vec::Reg* v, unsigned char* output)
+{
+    const Vec::Reg coef_r  = Vec::Set16Pair(9535, 13074);  // y, v
+    const Vec::Reg coef_g1 = Vec::Set16Pair(9535, -6660);  // y, v
+    const Vec::Reg coef_g2 = Vec::Set16Pair(0, -3203);     // y, u
+    const Vec::Reg coef_b  = Vec::Set16Pair(9535, 16531);  // y, u
+    Vec::Reg r[2], g[2], b[2];
+
+    for (unsigned int k = 0; k < 2; k ++) {
+        r[k] = MultiplyAdd<13>(y[k], v[k], coef_r);
+        g[k] = MultiplyAdd<13>(y[k], v[k], coef_g1, y[k], u[k], coef_g2);
+        b[k] = MultiplyAdd<13>(y[k], u[k], coef_b);
+    }
+    Vec::Store3(output, Vec::Packus16(r[0], r[1]), Vec::Packus16(g[0], g[1]), Vec::Packus16(b[0], b[1]));
+}
+
+unsigned int NV21toRGB24(const unsigned char* iny1, const unsigned char* iny2, const unsigned char* inuv,
+                         unsigned char* output1, unsigned char* output2, const unsigned int width)
+{
+    const unsigned int count = width - width % Vec::Bytes;
+    const Vec::Reg offset_y = Vec::Set16(16);
+    const Vec::Reg offset_c = Vec::Set16(128);
+    Vec::Reg c[2], u[2], v[2], y[2];
+    unsigned int i, k;
+
+    for (i = 0; i < count; i += Vec::Bytes) {
+        Vec::Expand8(Vec::Load(inuv), c[0], c[1]);
+        inuv += Vec::Bytes;
+        for (k = 0; k < 2; k ++) {
+            SplitUV(c[k], u[k], v[k]);
+            u[k] = Vec::Sub16(u[k], offset_c);
+            v[k] = Vec::Sub16(v[k], offset_c);
+        }
+
+        Vec::Expand8(Vec::Load(iny1), y[0], y[1]);
+        iny1 += Vec::Bytes;
+        y[0] = Vec::Sub16(y[0], offset_y);
+        y[1] = Vec::Sub16(y[1], offset_y);
+        NV21toRGB24Row(y, u, v, output1);
+        output1 += 3 * Vec::Bytes;
+
+        Vec::Expand8(Vec::Load(iny2), y[0], y[1]);
+        iny2 += Vec::Bytes;
+        y[0] = Vec::Sub16(y[0], offset_y);
+        y[1] = Vec::Sub16(y[1], offset_y);
+        NV21toRGB24Row(y, u, v, output2);
+        output2 += 3 * Vec::Bytes;
+    }
+
+    return count;
+}
+
@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2006
 
-  (C) Copyright 2006-2007 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -21,9 +21,11 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstStereoVision/svlFilterComputationalStereo.h>
 #include <cisstStereoVision/svlFilterInput.h>
 #include <cisstStereoVision/svlFilterOutput.h>
+#include <cisstOSAbstraction/osaGetTime.h>
 
 #include "svlStereoDP.h"
 #include "svlStereoDPMono.h"
+#include "svlStereoSGM.h"
 
 
 /*******************************************/
@@ -38,6 +40,7 @@ svlFilterComputationalStereo::svlFilterComputationalStereo() :
     StereoAlgorithm(0),
     XCheckStereoAlgorithm(0),
     XCheckImage(0),
+    XCheckImageResult(SVL_OK),
     ROI(0, 0, 0, 0),
     MinDisparity(0),
     MaxDisparity(64),
@@ -49,7 +52,9 @@ svlFilterComputationalStereo::svlFilterComputationalStereo() :
     SpatialFilterRadius(0),
     SubpixelPrecision(false),
     XCheckEnabled(false),
-    Method(DynamicProgramming)
+    Method(DynamicProgramming),
+    ProcessingStartTime(0.0),
+    ProcessingTime(0.0)
 {
     AddInput("input", true);
     AddInputType("input", svlTypeImageMono8Stereo);
@@ -99,41 +104,7 @@ int svlFilterComputationalStereo::Initialize(svlSample* syncInput, svlSample* &s
     ROI.Trim(0, w1 - 1, 0, h1 - 1);
 
     // Creating computational stereo object(s)
-    switch (Method) {
-        case DynamicProgramming:
-            if (inputtype == svlTypeImageRGBStereo) { // Color input
-                StereoAlgorithm = new svlStereoDP(w1, h1,
-                                                  ROI,
-                                                  MinDisparity,
-                                                  MaxDisparity,
-                                                  static_cast<int>(Geometry.GetIntrinsics(SVL_RIGHT).cc[0] -
-                                                                   Geometry.GetIntrinsics(SVL_LEFT ).cc[0]),
-                                                  ScaleFactor,
-                                                  BlockSize,
-                                                  NarrowedSearchRadius,
-                                                  Smoothness,
-                                                  TemporalFilter,
-                                                  SubpixelPrecision);
-            }
-            else { // Mono input
-                StereoAlgorithm = new svlStereoDPMono(w1, h1,
-                                                      ROI,
-                                                      MinDisparity,
-                                                      MaxDisparity,
-                                                      static_cast<int>(Geometry.GetIntrinsics(SVL_RIGHT).cc[0] -
-                                                                       Geometry.GetIntrinsics(SVL_LEFT ).cc[0]),
-                                                      ScaleFactor,
-                                                      BlockSize,
-                                                      NarrowedSearchRadius,
-                                                      Smoothness,
-                                                      TemporalFilter,
-                                                      SubpixelPrecision);
-            }
-        break;
-
-        default:
-        break;
-    }
+    StereoAlgorithm = CreateStereoAlgorithm(ROI);
 
     if (StereoAlgorithm == 0 || StereoAlgorithm->Initialize() != 0) {
         Release();
@@ -151,41 +122,7 @@ int svlFilterComputationalStereo::Initialize(svlSample* syncInput, svlSample* &s
         // calculate reverse ROI
         svlRect xroi(w1 - ROI.right, h1 - ROI.bottom, w1 - ROI.left, h1 - ROI.top);
 
-        switch (Method) {
-            case DynamicProgramming:
-                if (inputtype == svlTypeImageRGBStereo) { // Color input
-                    XCheckStereoAlgorithm = new svlStereoDP(w1, h1,
-                                                            xroi,
-                                                            MinDisparity,
-                                                            MaxDisparity,
-                                                            static_cast<int>(Geometry.GetIntrinsics(SVL_RIGHT).cc[0] -
-                                                                             Geometry.GetIntrinsics(SVL_LEFT ).cc[0]),
-                                                            ScaleFactor,
-                                                            BlockSize,
-                                                            NarrowedSearchRadius,
-                                                            Smoothness,
-                                                            TemporalFilter,
-                                                            SubpixelPrecision);
-                }
-                else { // Mono input
-                    XCheckStereoAlgorithm = new svlStereoDPMono(w1, h1,
-                                                                xroi,
-                                                                MinDisparity,
-                                                                MaxDisparity,
-                                                                static_cast<int>(Geometry.GetIntrinsics(SVL_RIGHT).cc[0] -
-                                                                                 Geometry.GetIntrinsics(SVL_LEFT ).cc[0]),
-                                                                ScaleFactor,
-                                                                BlockSize,
-                                                                NarrowedSearchRadius,
-                                                                Smoothness,
-                                                                TemporalFilter,
-                                                                SubpixelPrecision);
-                }
-            break;
-
-            default:
-            break;
-        }
+        XCheckStereoAlgorithm = CreateStereoAlgorithm(xroi);
 
         if (XCheckStereoAlgorithm == 0 || XCheckStereoAlgorithm->Initialize() != 0) {
             Release();
@@ -203,81 +140,70 @@ int svlFilterComputationalStereo::Process(svlProcInfo* procInfo, svlSample* sync
 
     svlSampleImage* stimg = dynamic_cast<svlSampleImage*>(syncInput);
 
-    // Process data
-    if (procInfo->count == 1 || procInfo->ID == 1) {
-        if (XCheckEnabled) {
-            svlStreamType inputtype = GetInput()->GetType();
-
-            // Process data
-            if (inputtype == svlTypeImageRGBStereo) {
-                CreateXCheckImageColor(stimg->GetUCharPointer(SVL_LEFT),
-                                       XCheckImage->GetUCharPointer(SVL_RIGHT),
-                                       stimg->GetWidth(SVL_LEFT),
-                                       stimg->GetHeight(SVL_LEFT));
-                CreateXCheckImageColor(stimg->GetUCharPointer(SVL_RIGHT),
-                                       XCheckImage->GetUCharPointer(SVL_LEFT),
-                                       stimg->GetWidth(SVL_RIGHT),
-                                       stimg->GetHeight(SVL_RIGHT));
-            }
-            else if (inputtype == svlTypeImageMono8Stereo) {
-                CreateXCheckImageMono<unsigned char>(stimg->GetUCharPointer(SVL_LEFT),
-                                                     XCheckImage->GetUCharPointer(SVL_RIGHT),
-                                                     stimg->GetWidth(SVL_LEFT),
-                                                     stimg->GetHeight(SVL_LEFT));
-                CreateXCheckImageMono<unsigned char>(stimg->GetUCharPointer(SVL_RIGHT),
-                                                     XCheckImage->GetUCharPointer(SVL_LEFT),
-                                                     stimg->GetWidth(SVL_RIGHT),
-                                                     stimg->GetHeight(SVL_RIGHT));
-            }
-            else if (inputtype == svlTypeImageMono16Stereo) {
-                CreateXCheckImageMono<unsigned short>(reinterpret_cast<unsigned short*>(stimg->GetUCharPointer(SVL_LEFT)),
-                                                      reinterpret_cast<unsigned short*>(XCheckImage->GetUCharPointer(SVL_RIGHT)),
-                                                      stimg->GetWidth(SVL_LEFT),
-                                                      stimg->GetHeight(SVL_LEFT));
-                CreateXCheckImageMono<unsigned short>(reinterpret_cast<unsigned short*>(stimg->GetUCharPointer(SVL_RIGHT)),
-                                                      reinterpret_cast<unsigned short*>(XCheckImage->GetUCharPointer(SVL_LEFT)),
-                                                      stimg->GetWidth(SVL_RIGHT),
-                                                      stimg->GetHeight(SVL_RIGHT));
-            }
-            else return SVL_FAIL;
+    if (procInfo->ID == 0) ProcessingStartTime = osaGetTime();
 
-            // Stereo: computing disparity map
-            XCheckStereoAlgorithm->Process(XCheckImage, XCheckDisparityBuffer.Pointer());
+    if (Method == SemiGlobalMatching) {
+        // All threads take part in computing both disparity maps
+        if (XCheckEnabled) {
+            if (procInfo->ID == 0) XCheckImageResult = CreateXCheckImage(stimg);
+            _SynchronizeThreads(procInfo);
+            // All threads have to give up together
+            if (XCheckImageResult != SVL_OK) return XCheckImageResult;
+        }
 
-            if (procInfo->ID == 1) {
-                _SynchronizeThreads(procInfo);
-                return SVL_OK;
-            }
+        // Stereo: computing disparity map
+        StereoAlgorithm->ProcessMT(procInfo, stimg, DisparityBuffer.Pointer());
+        if (XCheckEnabled) {
+            XCheckStereoAlgorithm->ProcessMT(procInfo, XCheckImage, XCheckDisparityBuffer.Pointer());
         }
+
+        _SynchronizeThreads(procInfo);
+        if (procInfo->ID != 0) return SVL_OK;
     }
+    else {
+        // The cross checked disparity map is computed in parallel on the second thread
+        if (XCheckEnabled && (procInfo->count == 1 || procInfo->ID == 1)) {
+            // Failure is reported by all threads after the sync point
+            XCheckImageResult = CreateXCheckImage(stimg);
 
-    if (procInfo->ID == 0) {
+            // Stereo: computing disparity map
+            if (XCheckImageResult == SVL_OK) {
+                XCheckStereoAlgorithm->Process(XCheckImage, XCheckDisparityBuffer.Pointer());
+            }
+        }
 
-        // Stereo: computing disparity map
-        StereoAlgorithm->Process(stimg, DisparityBuffer.Pointer());
+        if (procInfo->ID == 0) {
+            // Stereo: computing disparity map
+            StereoAlgorithm->Process(stimg, DisparityBuffer.Pointer());
+        }
 
+        // All threads have to reach the sync point, not only the first two
         if (XCheckEnabled) {
             _SynchronizeThreads(procInfo);
-
-            // Compare results with the cross checked results and update final disparity map
-            PerformXCheck();
+            if (XCheckImageResult != SVL_OK) return XCheckImageResult;
         }
-
-        // Store disparity map
-        ConvertDisparitiesToFloat(DisparityBuffer.Pointer(),
-                                  OutputMatrix->GetPointer(),
-                                  static_cast<int>(OutputMatrix->GetCols()),
-                                  static_cast<int>(OutputMatrix->GetRows()));
-
-        // Apply spatial filter if enabled
-        if (SpatialFilterRadius > 0) ApplySpatialFilter(SpatialFilterRadius,
-                                                        OutputMatrix->GetPointer(ROI.left, ROI.top),
-                                                        SpatialFilterBuffer.Pointer(ROI.top, ROI.left),
-                                                        ROI.right - ROI.left,
-                                                        ROI.bottom - ROI.top,
-                                                        static_cast<int>(OutputMatrix->GetCols()));
+        if (procInfo->ID != 0) return SVL_OK;
     }
 
+    // Compare results with the cross checked results and update final disparity map
+    if (XCheckEnabled) PerformXCheck();
+
+    // Store disparity map
+    ConvertDisparitiesToFloat(DisparityBuffer.Pointer(),
+                              OutputMatrix->GetPointer(),
+                              static_cast<int>(OutputMatrix->GetCols()),
+                              static_cast<int>(OutputMatrix->GetRows()));
+
+    // Apply spatial filter if enabled
+    if (SpatialFilterRadius > 0) ApplySpatialFilter(SpatialFilterRadius,
+                                                    OutputMatrix->GetPointer(ROI.left, ROI.top),
+                                                    SpatialFilterBuffer.Pointer(ROI.top, ROI.left),
+                                                    ROI.right - ROI.left,
+                                                    ROI.bottom - ROI.top,
+                                                    static_cast<int>(OutputMatrix->GetCols()));
+
+    ProcessingTime = osaGetTime() - ProcessingStartTime;
+
     return SVL_OK;
 }
 
@@ -423,9 +349,11 @@ unsigned int svlFilterComputationalStereo::GetSpatialFiltering()
     return SpatialFilterRadius;
 }
 
-void svlFilterComputationalStereo::SetMethod(svlFilterComputationalStereo::StereoMethod method)
+int svlFilterComputationalStereo::SetMethod(svlFilterComputationalStereo::StereoMethod method)
 {
+    if (IsInitialized()) return SVL_FAIL;
     Method = method;
+    return SVL_OK;
 }
 
 svlFilterComputationalStereo::StereoMethod svlFilterComputationalStereo::GetMethod()
@@ -433,6 +361,98 @@ svlFilterComputationalStereo::StereoMethod svlFilterComputationalStereo::GetMeth
     return Method;
 }
 
+double svlFilterComputationalStereo::GetProcessingTime()
+{
+    return ProcessingTime;
+}
+
+svlComputationalStereoMethodBase* svlFilterComputationalStereo::CreateStereoAlgorithm(const svlRect & roi)
+{
+    const int width = static_cast<int>(DisparityBuffer.cols());
+    const int height = static_cast<int>(DisparityBuffer.rows());
+    const int ppoffset = static_cast<int>(Geometry.GetIntrinsics(SVL_RIGHT).cc[0] -
+                                          Geometry.GetIntrinsics(SVL_LEFT ).cc[0]);
+
+    switch (Method) {
+        case DynamicProgramming:
+            if (GetInput()->GetType() == svlTypeImageRGBStereo) { // Color input
+                return new svlStereoDP(width, height,
+                                       roi,
+                                       MinDisparity,
+                                       MaxDisparity,
+                                       ppoffset,
+                                       ScaleFactor,
+                                       BlockSize,
+                                       NarrowedSearchRadius,
+                                       Smoothness,
+                                       TemporalFilter,
+                                       SubpixelPrecision);
+            }
+            // Mono input
+            return new svlStereoDPMono(width, height,
+                                       roi,
+                                       MinDisparity,
+                                       MaxDisparity,
+                                       ppoffset,
+                                       ScaleFactor,
+                                       BlockSize,
+                                       NarrowedSearchRadius,
+                                       Smoothness,
+                                       TemporalFilter,
+                                       SubpixelPrecision);
+
+        case SemiGlobalMatching:
+            return new svlStereoSGM(width, height,
+                                    roi,
+                                    MinDisparity,
+                                    MaxDisparity,
+                                    ppoffset,
+                                    Smoothness,
+                                    SubpixelPrecision);
+    }
+
+    return 0;
+}
+
+int svlFilterComputationalStereo::CreateXCheckImage(svlSampleImage* image)
+{
+    const svlStreamType inputtype = GetInput()->GetType();
+
+    if (inputtype == svlTypeImageRGBStereo) {
+        CreateXCheckImageColor(image->GetUCharPointer(SVL_LEFT),
+                               XCheckImage->GetUCharPointer(SVL_RIGHT),
+                               image->GetWidth(SVL_LEFT),
+                               image->GetHeight(SVL_LEFT));
+        CreateXCheckImageColor(image->GetUCharPointer(SVL_RIGHT),
+                               XCheckImage->GetUCharPointer(SVL_LEFT),
+                               image->GetWidth(SVL_RIGHT),
+                               image->GetHeight(SVL_RIGHT));
+    }
+    else if (inputtype == svlTypeImageMono8Stereo) {
+        CreateXCheckImageMono<unsigned char>(image->GetUCharPointer(SVL_LEFT),
+                                             XCheckImage->GetUCharPointer(SVL_RIGHT),
+                                             image->GetWidth(SVL_LEFT),
+                                             image->GetHeight(SVL_LEFT));
+        CreateXCheckImageMono<unsigned char>(image->GetUCharPointer(SVL_RIGHT),
+                                             XCheckImage->GetUCharPointer(SVL_LEFT),
+                                             image->GetWidth(SVL_RIGHT),
+                                             image->GetHeight(SVL_RIGHT));
+    }
+    else if (inputtype == svlTypeImageMono16Stereo) {
+        CreateXCheckImageMono<unsigned short>(reinterpret_cast<unsigned short*>(image->GetUCharPointer(SVL_LEFT)),
+                                              reinterpret_cast<unsigned short*>(XCheckImage->GetUCharPointer(SVL_RIGHT)),
+                                              image->GetWidth(SVL_LEFT),
+                                              image->GetHeight(SVL_LEFT));
+        CreateXCheckImageMono<unsigned short>(reinterpret_cast<unsigned short*>(image->GetUCharPointer(SVL_RIGHT)),
+                                              reinterpret_cast<unsigned short*>(XCheckImage->GetUCharPointer(SVL_LEFT)),
+                                              image->GetWidth(SVL_RIGHT),
+                                              image->GetHeight(SVL_RIGHT));
+    }
+    else return SVL_FAIL;
+
+    return SVL_OK;
+}
+
 void svlFilterComputationalStereo::CreateXCheckImageColor(unsigned char* source, unsigned char* target,
                                                           const unsigned int width, const unsigned int height)
 {
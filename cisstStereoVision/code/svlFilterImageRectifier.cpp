@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2006 
 
-  (C) Copyright 2006-2007 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -101,6 +101,7 @@ int svlFilterImageRectifier::Process(svlProcInfo* procInfo, svlSample* syncInput
                 if(camgeo->IsInitialized())
                 {
                     table = new svlImageProcessingHelper::RectificationInternals;
+                    table->CacheDirectory = TableCacheDirectory;
                     if (!table->Generate(inimg->GetWidth(idx), inimg->GetHeight(idx), *camgeo, idx)) {
                         delete table;
                         continue;
@@ -176,6 +177,7 @@ int svlFilterImageRectifier::SetTableFromCameraCalibration(unsigned int height,u
     if (videoch >= SVL_MAX_CHANNELS) return SVL_FAIL;
 
     svlImageProcessingHelper::RectificationInternals* table = new svlImageProcessingHelper::RectificationInternals;
+    table->CacheDirectory = TableCacheDirectory;
     if (!table->SetFromCameraCalibration(height,width,R, f, c, k, alpha, videoch)) {
         delete table;
         return SVL_FAIL;
@@ -192,3 +194,8 @@ void svlFilterImageRectifier::EnableInterpolation(bool enable)
     InterpolationEnabled = enable;
 }
 
+void svlFilterImageRectifier::SetTableCacheDirectory(const std::string & directory)
+{
+    TableCacheDirectory = directory;
+}
+
@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2006
 
-  (C) Copyright 2006-2008 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -140,6 +140,8 @@ svlFilterSourceVideoCapture::~svlFilterSourceVideoCapture()
         if (DeviceID) delete [] DeviceID;
         if (InputID) delete [] InputID;
         if (Trigger) delete [] Trigger;
+        if (ZeroCopyInFlight) delete [] ZeroCopyInFlight;
+        if (ZeroCopy) delete [] ZeroCopy;
         if (Format) {
             for (i = 0; i < NumberOfChannels; i ++) {
                 if (Format[i]) delete Format[i];
@@ -306,6 +308,8 @@ int svlFilterSourceVideoCapture::SetChannelCount(unsigned int channelcount)
     Format = new ImageFormat*[NumberOfChannels];
     Properties = new ImageProperties*[NumberOfChannels];
     Trigger = new ExternalTrigger[NumberOfChannels];
+    ZeroCopyInFlight = new unsigned int[NumberOfChannels];
+    ZeroCopy = new bool[NumberOfChannels];
     DevSpecConfigBuffer = new unsigned char*[NumberOfChannels];
     DevSpecConfigBufferSize = new unsigned int[NumberOfChannels];
     APIChannelID = new int[NumberOfChannels];
@@ -318,6 +322,8 @@ int svlFilterSourceVideoCapture::SetChannelCount(unsigned int channelcount)
         Format[i] = 0;
         Properties[i] = 0;
         memset(&(Trigger[i]), 0, sizeof(ExternalTrigger));
+        ZeroCopyInFlight[i] = 0;
+        ZeroCopy[i] = false;
         DevSpecConfigBuffer[i] = 0;
         DevSpecConfigBufferSize[i] = 0;
         APIChannelID[i] = -1;
@@ -385,6 +391,15 @@ int svlFilterSourceVideoCapture::Initialize(svlSample* &syncOutput)
         DeviceObj[API[i]]->SetTrigger(Trigger[i], APIChannelID[i]);
     }
 
+    // Request zero-copy frame hand-off if enabled
+    for (i = 0; i < NumberOfChannels; i ++) {
+        ZeroCopy[i] = false;
+        if (ZeroCopyInFlight[i] > 0 &&
+            DeviceObj[API[i]]->SetZeroCopy(ZeroCopyInFlight[i], APIChannelID[i]) != SVL_OK) {
+            CMN_LOG_CLASS_INIT_WARNING << "Initialize: zero-copy not supported by capture API on channel: " << i << std::endl;
+        }
+    }
+
     // Open devices
     for (i = 0; i < NumberOfChannels; i ++) {
         if (DeviceObj[API[i]]->Open() != SVL_OK) {
@@ -393,6 +408,16 @@ int svlFilterSourceVideoCapture::Initialize(svlSample* &syncOutput)
         }
     }
 
+    // Check if zero-copy is available with the selected formats
+    for (i = 0; i < NumberOfChannels; i ++) {
+        if (ZeroCopyInFlight[i] > 0) {
+            ZeroCopy[i] = DeviceObj[API[i]]->GetZeroCopy(APIChannelID[i]);
+            if (!ZeroCopy[i]) {
+                CMN_LOG_CLASS_INIT_WARNING << "Initialize: zero-copy not available, copying frames on channel: " << i << std::endl;
+            }
+        }
+    }
+
     // Set image properties if available
     for (i = 0; i < NumberOfChannels; i ++) {
         platform = DeviceObj[API[i]]->GetPlatformType();
@@ -439,18 +464,32 @@ int svlFilterSourceVideoCapture::Process(svlProcInfo* procInfo, svlSample* &sync
     syncOutput = OutputImage;
 
     svlImageRGB* image;
+    vctDynamicMatrixRef<unsigned char> imageref;
     unsigned int idx;
 
     _ParallelLoop(procInfo, idx, NumberOfChannels)
     {
-        // Requesting frame from the capture buffer
-        image = DeviceObj[API[idx]]->GetLatestFrame(true, APIChannelID[idx]);
-        if (image == 0) return SVL_FAIL;
-        if (NumberOfChannels == 1) {
-            dynamic_cast<svlSampleImageRGB*>(OutputImage)->SetMatrix(*image, idx);
+        if (ZeroCopy[idx]) {
+            // Referencing the capture buffer directly; the previous
+            // frame is returned to the device at this point
+            if (DeviceObj[API[idx]]->GetLatestFrameRef(true, imageref, APIChannelID[idx]) != SVL_OK) return SVL_FAIL;
+            if (NumberOfChannels == 1) {
+                dynamic_cast<svlSampleImageRGB*>(OutputImage)->SetMatrix(imageref, idx);
+            }
+            else {
+                dynamic_cast<svlSampleImageRGBStereo*>(OutputImage)->SetMatrix(imageref, idx);
+            }
         }
         else {
-            dynamic_cast<svlSampleImageRGBStereo*>(OutputImage)->SetMatrix(*image, idx);
+            // Requesting frame from the capture buffer
+            image = DeviceObj[API[idx]]->GetLatestFrame(true, APIChannelID[idx]);
+            if (image == 0) return SVL_FAIL;
+            if (NumberOfChannels == 1) {
+                dynamic_cast<svlSampleImageRGB*>(OutputImage)->SetMatrix(*image, idx);
+            }
+            else {
+                dynamic_cast<svlSampleImageRGBStereo*>(OutputImage)->SetMatrix(*image, idx);
+            }
         }
     }
 
@@ -1364,6 +1403,32 @@ int svlFilterSourceVideoCapture::GetTrigger(ExternalTrigger& trigger, unsigned i
     return SVL_OK;
 }
 
+int svlFilterSourceVideoCapture::SetZeroCopy(bool enable, unsigned int inflight, unsigned int videoch)
+{
+    if (OutputImage == 0)
+        return SVL_FAIL;
+    if (IsInitialized() == true)
+        return SVL_ALREADY_INITIALIZED;
+    if (videoch >= NumberOfChannels)
+        return SVL_WRONG_CHANNEL;
+    // One frame is held by the stream while the next one is captured
+    if (enable && inflight < 2)
+        return SVL_FAIL;
+
+    ZeroCopyInFlight[videoch] = enable ? inflight : 0;
+
+    return SVL_OK;
+}
+
+bool svlFilterSourceVideoCapture::GetZeroCopy(unsigned int videoch) const
+{
+    if (OutputImage == 0 || videoch >= NumberOfChannels)
+        return false;
+    if (IsInitialized() == true)
+        return ZeroCopy[videoch];
+    return (ZeroCopyInFlight[videoch] > 0);
+}
+
 int svlFilterSourceVideoCapture::SetImageProperties(const ImageProperties& properties, unsigned int videoch)
 {
     // Available only after initialization
@@ -2225,6 +2290,21 @@ int svlVidCapSrcBase::GetTrigger(svlFilterSourceVideoCapture::ExternalTrigger &
     return SVL_FAIL;
 }
 
+int svlVidCapSrcBase::SetZeroCopy(unsigned int CMN_UNUSED(inflight), unsigned int CMN_UNUSED(videoch))
+{
+    return SVL_FAIL;
+}
+
+bool svlVidCapSrcBase::GetZeroCopy(unsigned int CMN_UNUSED(videoch))
+{
+    return false;
+}
+
+int svlVidCapSrcBase::GetLatestFrameRef(bool CMN_UNUSED(waitfornew), vctDynamicMatrixRef<unsigned char> & CMN_UNUSED(frame), unsigned int CMN_UNUSED(videoch))
+{
+    return SVL_FAIL;
+}
+
 
 /***********************************************/
 /*** svlVidCapSrcDialogThread class ************/
@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2006
 
-  (C) Copyright 2006-2007 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -23,6 +23,9 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstStereoVision/svlFilterOutput.h>
 #include <cisstMultiTask/mtsInterfaceProvided.h>
 #include <cisstOSAbstraction/osaSleep.h>
+#include <cmath>
+
+#include "svlVideoFrameCache.h"
 
 
 #ifdef _MSC_VER
@@ -46,6 +49,9 @@ CMN_IMPLEMENT_SERVICES_DERIVED(svlFilterSourceVideoFile, svlFilterSourceBase)
 svlFilterSourceVideoFile::svlFilterSourceVideoFile() :
     svlFilterSourceBase(false),  // manual timestamp management
     OutputImage(0),
+    ReadAheadFrames(0),
+    CacheFrames(0),
+    ReversePlayback(false),
     FirstTimestamp(-1.0),
     NativeFramerate(-1.0)
 {
@@ -58,6 +64,9 @@ svlFilterSourceVideoFile::svlFilterSourceVideoFile() :
 svlFilterSourceVideoFile::svlFilterSourceVideoFile(unsigned int channelcount) :
     svlFilterSourceBase(false),  // manual timestamp management
     OutputImage(0),
+    ReadAheadFrames(0),
+    CacheFrames(0),
+    ReversePlayback(false),
     FirstTimestamp(-1.0),
     NativeFramerate(-1.0)
 {
@@ -97,6 +106,8 @@ int svlFilterSourceVideoFile::SetChannelCount(unsigned int channelcount)
 
     Codec.SetSize(channelcount);
     Codec.SetAll(0);
+    FrameCache.SetSize(channelcount);
+    FrameCache.SetAll(0);
 
     FilePath.SetSize(channelcount);
     Length.SetSize(channelcount);
@@ -152,6 +163,27 @@ int svlFilterSourceVideoFile::Initialize(svlSample* &syncOutput)
         OutputImage->SetSize(i, width, height);
     }
 
+    if (ret == SVL_OK && ReadAheadFrames > 0) {
+        // Read-ahead requires seeking in all video files
+        bool seekable = true;
+        for (unsigned int i = 0; i < OutputImage->GetVideoChannels(); i ++) {
+            if (Codec[i]->SetPos(Codec[i]->GetPos()) != SVL_OK) seekable = false;
+        }
+
+        if (seekable) {
+            for (unsigned int i = 0; i < OutputImage->GetVideoChannels(); i ++) {
+                FrameCache[i] = new svlVideoFrameCache(Codec[i], ReadAheadFrames, CacheFrames);
+                FrameCache[i]->SetReverse(ReversePlayback);
+            }
+        }
+        else {
+            CMN_LOG_CLASS_INIT_WARNING << "Initialize: video files are not seekable; read-ahead disabled" << std::endl;
+        }
+    }
+    if (ReversePlayback && !FrameCache[0]) {
+        CMN_LOG_CLASS_INIT_WARNING << "Initialize: reverse playback requires read-ahead; playing forward" << std::endl;
+    }
+
     // Initialize timestamp for case of timestamp errors
     OutputImage->SetTimestamp(0.0);
 
@@ -178,8 +210,87 @@ int svlFilterSourceVideoFile::Process(svlProcInfo* procInfo, svlSample* &syncOut
     double timestamp, timespan;
     int pos, ret = SVL_OK;
 
+    if (FrameCache[0]) {
+        // Frames are decoded on the read-ahead threads,
+        // only copying them from the frame caches
+
+        const int direction = ReversePlayback ? -1 : 1;
+        int first, last;
+
+        _ParallelLoop(procInfo, idx, videochannels)
+        {
+            pos = FrameCache[idx]->GetPos();
+            Position[idx] = pos;
+
+            if (UseRange[idx]) {
+                // Check if position is outside of the playback segment
+                first = std::min(Range[idx][ReversePlayback ? 1 : 0], Length[idx] - 1);
+                last  = std::min(Range[idx][ReversePlayback ? 0 : 1], Length[idx] - 1);
+                if ((pos - first) * direction < 0) {
+                    FrameCache[idx]->SetPos(first);
+                    ResetTimer = true;
+                }
+                else if ((pos - last) * direction > 0) {
+                    if (!GetLoop()) {
+                        ret = SVL_STOP_REQUEST;
+                        break;
+                    }
+                    else {
+                        FrameCache[idx]->SetPos(first);
+                        ResetTimer = true;
+                    }
+                }
+            }
+
+            // Extract frame
+            ret = FrameCache[idx]->Read(*OutputImage, idx);
+
+            // Manage looped playback and errors
+            if (ret == SVL_VID_END_REACHED) {
+                if (!GetLoop()) {
+                    ret = SVL_STOP_REQUEST;
+                    break;
+                }
+                else {
+                    // Loop around
+                    ret = FrameCache[idx]->Read(*OutputImage, idx);
+                    ResetTimer = true;
+                }
+            }
+            if (ret != SVL_OK) {
+                CMN_LOG_CLASS_INIT_ERROR << "Process: failed to read video frame on channel: " << idx << std::endl; 
+                break;
+            }
+
+            // Run timer based in the first video channel
+            if (idx == 0) {
+
+                // Get timestamp stored in the video file
+                timestamp = FrameCache[idx]->GetTimestamp();
+                if (timestamp > 0.0) {
+
+                    if (!IsTargetTimerRunning()) {
+
+                        // Try to keep orignal frame intervals, in both directions
+                        if (ResetTimer || !Timer.IsRunning()) {
+                            FirstTimestamp = timestamp;
+                            Timer.Reset();
+                            Timer.Start();
+                            ResetTimer = false;
+                        }
+                        else {
+                            timespan = fabs(timestamp - FirstTimestamp) - Timer.GetElapsedTime();
+                            if (timespan > 0.0) osaSleep(timespan);
+                        }
+                    }
+                }
+
+                OutputImage->SetTimestamp(timestamp);
+            }
+        }
+    }
     // TO DO: add a little more sophisticated logic here
-    if (Codec[0]->IsMultithreaded()) {
+    else if (Codec[0]->IsMultithreaded()) {
         // Codecs are multithreaded, so it's worth
         // splitting work between all threads
 
@@ -353,6 +464,11 @@ int svlFilterSourceVideoFile::Process(svlProcInfo* procInfo, svlSample* &syncOut
 
 int svlFilterSourceVideoFile::Release()
 {
+    // Stop read-ahead threads before closing the files
+    for (unsigned int i = 0; i < FrameCache.size(); i ++) {
+        delete FrameCache[i];
+        FrameCache[i] = 0;
+    }
     for (unsigned int i = 0; i < Codec.size(); i ++) {
         svlVideoIO::ReleaseCodec(Codec[i]);
         Codec[i] = 0;
@@ -429,7 +545,8 @@ int svlFilterSourceVideoFile::SetPosition(const int position, unsigned int video
         CMN_LOG_CLASS_INIT_ERROR << "SetPosition: video channel out of range: " << videoch << std::endl;
         return SVL_FAIL;
     }
-    Codec[videoch]->SetPos(position);
+    if (FrameCache[videoch]) FrameCache[videoch]->SetPos(position);
+    else Codec[videoch]->SetPos(position);
     Position[videoch] = position;
     ResetTimer = true;
     return SVL_OK;
@@ -441,6 +558,7 @@ int svlFilterSourceVideoFile::GetPosition(unsigned int videoch) const
         CMN_LOG_CLASS_INIT_ERROR << "GetPosition: video channel out of range: " << videoch << std::endl;
         return SVL_FAIL;
     }
+    if (FrameCache[videoch]) return FrameCache[videoch]->GetPos();
     return Codec[videoch]->GetPos();
 }
 
@@ -485,6 +603,37 @@ int svlFilterSourceVideoFile::GetLength(unsigned int videoch) const
     return (Codec[videoch]->GetEndPos() + 1);
 }
 
+int svlFilterSourceVideoFile::SetReadAhead(const unsigned int readahead, const unsigned int cachesize)
+{
+    if (IsInitialized() == true) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetReadAhead: filter has already been initialized" << std::endl;
+        return SVL_ALREADY_INITIALIZED;
+    }
+    ReadAheadFrames = readahead;
+    CacheFrames = std::max(readahead, cachesize);
+    return SVL_OK;
+}
+
+unsigned int svlFilterSourceVideoFile::GetReadAhead() const
+{
+    return ReadAheadFrames;
+}
+
+int svlFilterSourceVideoFile::SetReversePlayback(const bool enable)
+{
+    ReversePlayback = enable;
+    for (unsigned int i = 0; i < FrameCache.size(); i ++) {
+        if (FrameCache[i]) FrameCache[i]->SetReverse(enable);
+    }
+    ResetTimer = true;
+    return SVL_OK;
+}
+
+bool svlFilterSourceVideoFile::GetReversePlayback() const
+{
+    return ReversePlayback;
+}
+
 unsigned int svlFilterSourceVideoFile::GetWidth(unsigned int videoch) const
 {
     if (!IsInitialized()) {
@@ -541,6 +690,7 @@ void svlFilterSourceVideoFile::CreateInterfaces()
         provided->AddCommandWrite(&svlFilterSourceVideoFile::SetRangeLCommand,      this, "SetRange");
         provided->AddCommandWrite(&svlFilterSourceVideoFile::SetRangeLCommand,      this, "SetLeftRange");
         provided->AddCommandWrite(&svlFilterSourceVideoFile::SetRangeRCommand,      this, "SetRightRange");
+        provided->AddCommandWrite(&svlFilterSourceVideoFile::SetReverseCommand,     this, "SetReversePlayback");
         provided->AddCommandRead (&svlFilterSourceVideoFile::GetChannelsCommand,    this, "GetChannels");
         provided->AddCommandRead (&svlFilterSourceVideoFile::GetPathLCommand,       this, "GetFilename");
         provided->AddCommandRead (&svlFilterSourceVideoFile::GetPathLCommand,       this, "GetLeftFilename");
@@ -554,6 +704,7 @@ void svlFilterSourceVideoFile::CreateInterfaces()
         provided->AddCommandRead (&svlFilterSourceVideoFile::GetRangeLCommand,      this, "GetRange");
         provided->AddCommandRead (&svlFilterSourceVideoFile::GetRangeLCommand,      this, "GetLeftRange");
         provided->AddCommandRead (&svlFilterSourceVideoFile::GetRangeRCommand,      this, "GetRightRange");
+        provided->AddCommandRead (&svlFilterSourceVideoFile::GetReverseCommand,     this, "GetReversePlayback");
         provided->AddCommandRead (&svlFilterSourceVideoFile::GetDimensionsLCommand, this, "GetDimensions");
         provided->AddCommandRead (&svlFilterSourceVideoFile::GetDimensionsLCommand, this, "GetLeftDimensions");
         provided->AddCommandRead (&svlFilterSourceVideoFile::GetDimensionsRCommand, this, "GetRightDimensions");
@@ -637,6 +788,11 @@ void svlFilterSourceVideoFile::SetRangeRCommand(const vctInt2& range)
     }
 }
 
+void svlFilterSourceVideoFile::SetReverseCommand(const bool & reverse)
+{
+    SetReversePlayback(reverse);
+}
+
 void svlFilterSourceVideoFile::GetChannelsCommand(int & channels) const
 {
     channels = static_cast<int>(Codec.size());
@@ -706,6 +862,11 @@ void svlFilterSourceVideoFile::GetRangeRCommand(vctInt2 & range) const
     }
 }
 
+void svlFilterSourceVideoFile::GetReverseCommand(bool & reverse) const
+{
+    reverse = GetReversePlayback();
+}
+
 void svlFilterSourceVideoFile::GetDimensionsLCommand(vctInt2 & dimensions) const
 {
     dimensions[0] = static_cast<int>(GetWidth(SVL_LEFT));
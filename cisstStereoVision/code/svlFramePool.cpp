@@ -0,0 +1,234 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include <cisstStereoVision/svlFramePool.h>
+#include <cisstCommon/cmnPortability.h>
+#include <cstdlib>
+#include <cstring>
+
+#if (CISST_OS == CISST_WINDOWS)
+    #include <malloc.h>
+#else
+    #include <sys/mman.h>
+#endif
+
+#define SVL_FRAME_POOL_PAGE_SIZE            4096
+#define SVL_FRAME_POOL_HUGE_PAGE_SIZE       (2 * 1024 * 1024)
+#define SVL_FRAME_POOL_SMALL_BUFFER_SIZE    (64 * 1024)
+#define SVL_FRAME_POOL_MAX_POOLED_BYTES     (512 * 1024 * 1024)
+
+
+/******************************/
+/*** svlFramePool class *******/
+/******************************/
+
+bool svlFramePool::Destroyed = false;
+
+svlFramePool::svlFramePool() :
+    MaxPooledBytes(SVL_FRAME_POOL_MAX_POOLED_BYTES),
+    HugePages(true)
+{
+    memset(&Stats, 0, sizeof(Statistics));
+}
+
+svlFramePool::~svlFramePool()
+{
+    Trim();
+    Destroyed = true;
+}
+
+svlFramePool* svlFramePool::GetInstance()
+{
+    static svlFramePool Instance;
+    return &Instance;
+}
+
+void* svlFramePool::Acquire(const size_t size)
+{
+    if (size == 0) return 0;
+
+    const size_t classsize = GetSizeClass(size);
+    if (Destroyed) return Allocate(classsize, false);
+
+    svlFramePool* instance = GetInstance();
+    void* buffer = 0;
+
+    instance->CS.Enter();
+        _BufferListMap::iterator iter = instance->FreeBuffers.find(classsize);
+        if (iter != instance->FreeBuffers.end() && !iter->second.empty()) {
+            buffer = iter->second.back();
+            iter->second.pop_back();
+            instance->Stats.BytesPooled -= classsize;
+            instance->Stats.Hits ++;
+        }
+        else {
+            instance->Stats.Misses ++;
+        }
+        instance->Stats.BytesInUse += classsize;
+        const bool hugepages = instance->HugePages;
+    instance->CS.Leave();
+
+    if (!buffer) {
+        // Heap allocation outside of the critical section
+        buffer = Allocate(classsize, hugepages);
+        if (!buffer) {
+            instance->CS.Enter();
+                instance->Stats.BytesInUse -= classsize;
+            instance->CS.Leave();
+        }
+    }
+
+    return buffer;
+}
+
+void svlFramePool::Release(void* buffer, const size_t size)
+{
+    if (!buffer) return;
+
+    if (Destroyed) {
+        Free(buffer);
+        return;
+    }
+
+    const size_t classsize = GetSizeClass(size);
+    svlFramePool* instance = GetInstance();
+    bool pooled = false;
+
+    instance->CS.Enter();
+        instance->Stats.Releases ++;
+        instance->Stats.BytesInUse -= classsize;
+        if (instance->Stats.BytesPooled + classsize <= instance->MaxPooledBytes) {
+            instance->FreeBuffers[classsize].push_back(buffer);
+            instance->Stats.BytesPooled += classsize;
+            pooled = true;
+        }
+        else {
+            instance->Stats.Frees ++;
+        }
+    instance->CS.Leave();
+
+    if (!pooled) Free(buffer);
+}
+
+size_t svlFramePool::GetSizeClass(const size_t size)
+{
+    if (size <= SVL_FRAME_POOL_SMALL_BUFFER_SIZE) {
+        return (size + SVL_FRAME_POOL_PAGE_SIZE - 1) & ~static_cast<size_t>(SVL_FRAME_POOL_PAGE_SIZE - 1);
+    }
+
+    // Four classes between consecutive powers of two: less than 25% overhead
+    size_t step = SVL_FRAME_POOL_SMALL_BUFFER_SIZE >> 2;
+    while ((step << 3) <= size) step <<= 1;
+    return (size + step - 1) & ~(step - 1);
+}
+
+svlFramePool::Statistics svlFramePool::GetStatistics()
+{
+    svlFramePool* instance = GetInstance();
+    instance->CS.Enter();
+        Statistics stats = instance->Stats;
+    instance->CS.Leave();
+    return stats;
+}
+
+void svlFramePool::ResetStatistics()
+{
+    svlFramePool* instance = GetInstance();
+    instance->CS.Enter();
+        instance->Stats.Hits = 0;
+        instance->Stats.Misses = 0;
+        instance->Stats.Releases = 0;
+        instance->Stats.Frees = 0;
+    instance->CS.Leave();
+}
+
+void svlFramePool::Trim()
+{
+    svlFramePool* instance = GetInstance();
+    _BufferListMap buffers;
+
+    instance->CS.Enter();
+        buffers.swap(instance->FreeBuffers);
+        instance->Stats.BytesPooled = 0;
+    instance->CS.Leave();
+
+    for (_BufferListMap::iterator iter = buffers.begin(); iter != buffers.end(); iter ++) {
+        const size_t count = iter->second.size();
+        for (size_t i = 0; i < count; i ++) Free(iter->second[i]);
+
+        instance->CS.Enter();
+            instance->Stats.Frees += count;
+        instance->CS.Leave();
+    }
+}
+
+void svlFramePool::SetMaxPooledBytes(const size_t maxbytes)
+{
+    svlFramePool* instance = GetInstance();
+    instance->CS.Enter();
+        instance->MaxPooledBytes = maxbytes;
+        const bool trim = instance->Stats.BytesPooled > maxbytes;
+    instance->CS.Leave();
+
+    if (trim) Trim();
+}
+
+size_t svlFramePool::GetMaxPooledBytes()
+{
+    return GetInstance()->MaxPooledBytes;
+}
+
+void svlFramePool::SetHugePages(const bool enable)
+{
+    GetInstance()->HugePages = enable;
+}
+
+bool svlFramePool::GetHugePages()
+{
+    return GetInstance()->HugePages;
+}
+
+void* svlFramePool::Allocate(const size_t size, const bool hugepages)
+{
+    const bool huge = hugepages && size >= SVL_FRAME_POOL_HUGE_PAGE_SIZE;
+    const size_t alignment = huge ? SVL_FRAME_POOL_HUGE_PAGE_SIZE : SVL_FRAME_POOL_PAGE_SIZE;
+    void* buffer = 0;
+
+#if (CISST_OS == CISST_WINDOWS)
+    buffer = _aligned_malloc(size, alignment);
+#else
+    if (posix_memalign(&buffer, alignment, size) != 0) return 0;
+    #if defined(MADV_HUGEPAGE)
+    if (huge) madvise(buffer, size, MADV_HUGEPAGE);
+    #endif
+#endif
+
+    return buffer;
+}
+
+void svlFramePool::Free(void* buffer)
+{
+#if (CISST_OS == CISST_WINDOWS)
+    _aligned_free(buffer);
+#else
+    free(buffer);
+#endif
+}
+
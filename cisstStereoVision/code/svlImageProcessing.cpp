@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2010
 
-  (C) Copyright 2006-2010 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -133,6 +133,46 @@ int svlImageProcessing::Convolution(svlSampleImage* src_img, unsigned int src_vi
         width  < 1 || width  != static_cast<int>(dst_img->GetWidth(dst_videoch)) ||
         height < 1 || height != static_cast<int>(dst_img->GetHeight(dst_videoch))) return SVL_FAIL;
 
+    vctDynamicVector<double> kernel_horiz, kernel_vert;
+    if (type != svlPixelMono32 &&
+        svlImageProcessingHelper::IsSeparable(kernel, kernel_horiz, kernel_vert)) {
+
+        switch (type) {
+            case svlPixelRGB:
+                svlImageProcessingHelper::ConvolutionSeparable(src_img->GetUCharPointer(src_videoch),
+                                                               dst_img->GetUCharPointer(dst_videoch),
+                                                               width, height, 3,
+                                                               kernel_horiz, kernel_vert, absres);
+            break;
+
+            case svlPixelRGBA:
+                svlImageProcessingHelper::ConvolutionSeparable(src_img->GetUCharPointer(src_videoch),
+                                                               dst_img->GetUCharPointer(dst_videoch),
+                                                               width, height, 4,
+                                                               kernel_horiz, kernel_vert, absres);
+            break;
+
+            case svlPixelMono8:
+                svlImageProcessingHelper::ConvolutionSeparable(src_img->GetUCharPointer(src_videoch),
+                                                               dst_img->GetUCharPointer(dst_videoch),
+                                                               width, height, 1,
+                                                               kernel_horiz, kernel_vert, absres);
+            break;
+
+            case svlPixelMono16:
+                svlImageProcessingHelper::ConvolutionSeparable(reinterpret_cast<unsigned short*>(src_img->GetUCharPointer(src_videoch)),
+                                                               reinterpret_cast<unsigned short*>(dst_img->GetUCharPointer(dst_videoch)),
+                                                               width, height,
+                                                               kernel_horiz, kernel_vert, absres);
+            break;
+
+            default:
+                return SVL_FAIL;
+        }
+
+        return SVL_OK;
+    }
+
     vctDynamicMatrix<int> fp_kernel;
     fp_kernel.SetSize(kernel.rows(), kernel.cols());
     fp_kernel.Assign(kernel.Multiply(1024));
@@ -188,7 +228,7 @@ int svlImageProcessing::UnsharpMask(const svlSampleImage* src_img,
     }
 
     unsigned int width = src_img->GetWidth(src_videoch);
-    unsigned int height = src_img->GetWidth(src_videoch);
+    unsigned int height = src_img->GetHeight(src_videoch);
     if (width == 0 || height == 0 ||
         dst_img->GetWidth(dst_videoch) != width ||
         dst_img->GetHeight(dst_videoch) != height) {
@@ -602,118 +642,7 @@ int svlImageProcessing::Rectify(svlSampleImage* src_img, unsigned int src_videoc
 
     dst_img->SetSize(dst_videoch, src_img->GetWidth(src_videoch), src_img->GetHeight(src_videoch));
 
-    unsigned char* srcimg = src_img->GetUCharPointer(src_videoch);
-    unsigned char* destimg = dst_img->GetUCharPointer(dst_videoch);
-
-    unsigned char *srcbld1, *srcbld2, *srcbld3, *srcbld4;
-    unsigned int *destidx, *srcidx1, *srcidx2, *srcidx3, *srcidx4;
-    unsigned char *destr, *destg, *destb;
-    unsigned char *srcr, *srcg, *srcb;
-    unsigned int destofs, srcofs;
-    unsigned int resr, resg, resb;
-    unsigned int blnd;
-
-    const unsigned int destlen = table->idxDestSize;
-
-    if (interpolation) {
-        destidx = table->idxDest;
-        srcidx1 = table->idxSrc1;
-        srcidx2 = table->idxSrc2;
-        srcidx3 = table->idxSrc3;
-        srcidx4 = table->idxSrc4;
-        srcbld1 = table->blendSrc1;
-        srcbld2 = table->blendSrc2;
-        srcbld3 = table->blendSrc3;
-        srcbld4 = table->blendSrc4;
-    
-        for (unsigned int i = 0; i < destlen; i ++) {
-
-            // interpolation - 1st source pixel and weight
-            srcofs = *srcidx1;
-            srcr = srcimg + srcofs;
-            srcg = srcr + 1;
-            srcb = srcg + 1;
-
-            blnd = *srcbld1;
-            resr = blnd * (*srcr);
-            resg = blnd * (*srcg);
-            resb = blnd * (*srcb);
-
-            // interpolation - 2nd source pixel and weight
-            srcofs = *srcidx2;
-            srcr = srcimg + srcofs;
-            srcg = srcr + 1;
-            srcb = srcg + 1;
-
-            blnd = *srcbld2;
-            resr += blnd * (*srcr);
-            resg += blnd * (*srcg);
-            resb += blnd * (*srcb);
-
-            // interpolation - 3rd source pixel and weight
-            srcofs = *srcidx3;
-            srcr = srcimg + srcofs;
-            srcg = srcr + 1;
-            srcb = srcg + 1;
-
-            blnd = *srcbld3;
-            resr += blnd * (*srcr);
-            resg += blnd * (*srcg);
-            resb += blnd * (*srcb);
-
-            // interpolation - 4th source pixel and weight
-            srcofs = *srcidx4;
-            srcr = srcimg + srcofs;
-            srcg = srcr + 1;
-            srcb = srcg + 1;
-
-            blnd = *srcbld4;
-            resr += blnd * (*srcr);
-            resg += blnd * (*srcg);
-            resb += blnd * (*srcb);
-
-            // destination pixel
-            destofs = *destidx;
-            destr = destimg + destofs;
-            destg = destr + 1;
-            destb = destg + 1;
-
-            *destr = static_cast<unsigned char>(resr >> 8);
-            *destg = static_cast<unsigned char>(resg >> 8);
-            *destb = static_cast<unsigned char>(resb >> 8);
-
-            destidx ++;
-            srcidx1 ++;
-            srcidx2 ++;
-            srcidx3 ++;
-            srcidx4 ++;
-            srcbld1 ++;
-            srcbld2 ++;
-            srcbld3 ++;
-            srcbld4 ++;
-        }
-    }
-    else {
-        destidx = table->idxDest;
-        srcidx1 = table->idxSrc1;
-        svlRGB *prgb1, *prgb2;
-
-        for (unsigned int i = 0; i < destlen; i ++) {
-            
-            // sampling - 1st source pixel
-            srcofs = *srcidx1;
-            prgb1 = reinterpret_cast<svlRGB*>(srcimg + srcofs);
-
-            // copying value
-            destofs = *destidx;
-            prgb2 = reinterpret_cast<svlRGB*>(destimg + destofs);
-
-            *prgb2 = *prgb1;
-
-            destidx ++;
-            srcidx1 ++;
-        }
-    }
+    table->Remap(src_img->GetUCharPointer(src_videoch), dst_img->GetUCharPointer(dst_videoch), interpolation);
 
     return SVL_OK;
 }
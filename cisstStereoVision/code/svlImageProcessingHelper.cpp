@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2010
 
-  (C) Copyright 2006-2010 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -20,9 +20,15 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include "svlImageProcessingHelper.h"
+#include "svlImageProcessingSIMD.h"
 #include "cisstCommon/cmnPortability.h"
 #include <fstream>
 #include <cmath>
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
 
 
 /*****************************************/
@@ -45,512 +51,198 @@ svlImageProcessingInternals::~svlImageProcessingInternals()
 }
 
 
-/******************************************/
-/*** svlImageProcessingHelper namespace ***/
-/******************************************/
+/*****************************************/
+/*** Separable convolution row kernels ***/
+/*****************************************/
 
-void svlImageProcessingHelper::ConvolutionRGB(unsigned char* input, unsigned char* output, const int width, const int height,
-                                              vctDynamicVector<int> & kernel, bool horizontal, bool absres)
-{
-    if (!input || !output || kernel.size() < 1) return;
+// Length of the row segments processed at once by the vertical passes so
+// the accumulator and the input segments remain in the L1 cache
+#define SVL_CONVOLUTION_TILE_SIZE   2048
 
-    const int kernel_size = static_cast<int>(kernel.size());
+// Adds the horizontal convolution of one row to the accumulator; the
+// kernel is centered on kernel[kernel_size / 2] and pixels outside of
+// the image are ignored
+template <class _Type>
+static void svlConvolutionAccumulateRow(const _Type* input, int* accumulator, const int rowsize, const int channels,
+                                        const int* kernel, const int kernel_size)
+{
     const int kernel_rad = kernel_size / 2;
-    const int rowstride = width * 3;
-    int sum1, sum2, sum3;
-    unsigned char *input2;
-    int *kernelptr;
-    int i, j, k_val;
-
-    if (horizontal) {
-
-        int k, k_from, k_to;
-
-        for (j = 0; j < height; j ++) {
-            for (i = 0; i < width; i ++) {
-
-                sum1 = sum2 = sum3 = 0;
-
-                kernelptr = kernel.Pointer();
-
-                k = kernel_size;
-                k_from = i - kernel_rad;
-                k_to   = k_from + kernel_size;
-                if (k_from < 0) {
-                    k += k_from;
-                    kernelptr -= k_from;
-                    k_from = 0;
-                }
-                if (k_to > width) {
-                    k -= k_to - width;
-                    k_to = width;
-                }
-
-                input2 = input + j * rowstride + k_from * 3;
-
-                while (k) {
-
-                    k_val = *kernelptr; kernelptr ++;
-                    sum1 += (*input2) * k_val; input2 ++; 
-                    sum2 += (*input2) * k_val; input2 ++;
-                    sum3 += (*input2) * k_val; input2 ++;
-
-                    k --;
-                }
-
-                sum1 >>= 10; sum2 >>= 10; sum3 >>= 10;
-
-                if (absres) {
-                    if (sum1 < 0) sum1 = -sum1; if (sum1 > 255) sum1 = 255;
-                    *output = static_cast<unsigned char>(sum1); output ++;
-                    if (sum2 < 0) sum2 = -sum2; if (sum2 > 255) sum2 = 255;
-                    *output = static_cast<unsigned char>(sum2); output ++;
-                    if (sum3 < 0) sum3 = -sum3; if (sum3 > 255) sum3 = 255;
-                    *output = static_cast<unsigned char>(sum3); output ++;
-                }
-                else {
-                    if (sum1 < 0) sum1 = 0; else if (sum1 > 255) sum1 = 255;
-                    *output = static_cast<unsigned char>(sum1); output ++;
-                    if (sum2 < 0) sum2 = 0; else if (sum2 > 255) sum2 = 255;
-                    *output = static_cast<unsigned char>(sum2); output ++;
-                    if (sum3 < 0) sum3 = 0; else if (sum3 > 255) sum3 = 255;
-                    *output = static_cast<unsigned char>(sum3); output ++;
-                }
-            }
-        }
-
-    }
-    else {
-
-        const int rowstride_short = rowstride - 3;
-        int l, l_from, l_to;
-
-        for (j = 0; j < height; j ++) {
-            for (i = 0; i < width; i ++) {
-
-                sum1 = sum2 = sum3 = 0;
-
-                kernelptr = kernel.Pointer();
-
-                l = kernel_size;
-                l_from = j - kernel_rad;
-                l_to   = l_from + kernel_size;
-                if (l_from < 0) {
-                    l += l_from;
-                    kernelptr -= l_from;
-                    l_from = 0;
-                }
-                if (l_to > height) {
-                    l -= l_to - height;
-                    l_to = height;
-                }
-
-                input2 = input + l_from * rowstride + i * 3;
-
-                while (l) {
-
-                    k_val = *kernelptr; kernelptr ++;
-                    sum1 += (*input2) * k_val; input2 ++; 
-                    sum2 += (*input2) * k_val; input2 ++;
-                    sum3 += (*input2) * k_val; input2 ++;
-
-                    input2 += rowstride_short;
-
-                    l --;
-                }
+    int k, offset, from, to;
 
-                sum1 >>= 10; sum2 >>= 10; sum3 >>= 10;
+    for (k = 0; k < kernel_size; k ++) {
+        if (kernel[k] == 0) continue;
 
-                if (absres) {
-                    if (sum1 < 0) sum1 = -sum1; if (sum1 > 255) sum1 = 255;
-                    *output = static_cast<unsigned char>(sum1); output ++;
-                    if (sum2 < 0) sum2 = -sum2; if (sum2 > 255) sum2 = 255;
-                    *output = static_cast<unsigned char>(sum2); output ++;
-                    if (sum3 < 0) sum3 = -sum3; if (sum3 > 255) sum3 = 255;
-                    *output = static_cast<unsigned char>(sum3); output ++;
-                }
-                else {
-                    if (sum1 < 0) sum1 = 0; else if (sum1 > 255) sum1 = 255;
-                    *output = static_cast<unsigned char>(sum1); output ++;
-                    if (sum2 < 0) sum2 = 0; else if (sum2 > 255) sum2 = 255;
-                    *output = static_cast<unsigned char>(sum2); output ++;
-                    if (sum3 < 0) sum3 = 0; else if (sum3 > 255) sum3 = 255;
-                    *output = static_cast<unsigned char>(sum3); output ++;
-                }
-            }
+        offset = (k - kernel_rad) * channels;
+        from = (offset < 0) ? -offset : 0;
+        to   = (offset > 0) ? rowsize - offset : rowsize;
+        if (to > from) {
+            svlImageProcessingSIMD::MultiplyAccumulate(input + from + offset, accumulator + from, to - from, kernel[k]);
         }
-
     }
 }
 
-void svlImageProcessingHelper::ConvolutionRGBA(unsigned char* input, unsigned char* output, const int width, const int height,
-                                               vctDynamicVector<int> & kernel, bool horizontal, bool absres)
+// Horizontal or vertical convolution with a 10 bit fixed point kernel
+template <class _Type>
+static void svlConvolutionSinglePass(const _Type* input, _Type* output, const int width, const int height, const int channels,
+                                     vctDynamicVector<int> & kernel, bool horizontal, bool absres)
 {
-    if (!input || !output || kernel.size() < 1) return;
-
     const int kernel_size = static_cast<int>(kernel.size());
     const int kernel_rad = kernel_size / 2;
-    const int rowstride = width * 4;
-    int sum1, sum2, sum3, sum4;
-    unsigned char *input2;
-    int *kernelptr;
-    int i, j, k_val;
+    const int rowsize = width * channels;
+    const int* kernelptr = kernel.Pointer();
+    int i, j, k, l, length;
 
     if (horizontal) {
 
-        int k, k_from, k_to;
+        vctDynamicVector<int> accumulator(rowsize);
 
         for (j = 0; j < height; j ++) {
-            for (i = 0; i < width; i ++) {
-
-                sum1 = sum2 = sum3 = sum4 = 0;
-
-                kernelptr = kernel.Pointer();
-
-                k = kernel_size;
-                k_from = i - kernel_rad;
-                k_to   = k_from + kernel_size;
-                if (k_from < 0) {
-                    k += k_from;
-                    kernelptr -= k_from;
-                    k_from = 0;
-                }
-                if (k_to > width) {
-                    k -= k_to - width;
-                    k_to = width;
-                }
+            accumulator.SetAll(0);
+            svlConvolutionAccumulateRow(input, accumulator.Pointer(), rowsize, channels, kernelptr, kernel_size);
+            svlImageProcessingSIMD::ShiftAndSaturate(accumulator.Pointer(), output, rowsize, 10, absres);
 
-                input2 = input + j * rowstride + k_from * 4;
-
-                while (k) {
-
-                    k_val = *kernelptr; kernelptr ++;
-                    sum1 += (*input2) * k_val; input2 ++; 
-                    sum2 += (*input2) * k_val; input2 ++;
-                    sum3 += (*input2) * k_val; input2 ++;
-                    sum4 += (*input2) * k_val; input2 ++;
-
-                    k --;
-                }
-
-                sum1 >>= 10; sum2 >>= 10; sum3 >>= 10; sum4 >>= 10;
-
-                if (absres) {
-                    if (sum1 < 0) sum1 = -sum1; if (sum1 > 255) sum1 = 255;
-                    *output = static_cast<unsigned char>(sum1); output ++;
-                    if (sum2 < 0) sum2 = -sum2; if (sum2 > 255) sum2 = 255;
-                    *output = static_cast<unsigned char>(sum2); output ++;
-                    if (sum3 < 0) sum3 = -sum3; if (sum3 > 255) sum3 = 255;
-                    *output = static_cast<unsigned char>(sum3); output ++;
-                    if (sum4 < 0) sum4 = -sum4; if (sum4 > 255) sum4 = 255;
-                    *output = static_cast<unsigned char>(sum4); output ++;
-                }
-                else {
-                    if (sum1 < 0) sum1 = 0; else if (sum1 > 255) sum1 = 255;
-                    *output = static_cast<unsigned char>(sum1); output ++;
-                    if (sum2 < 0) sum2 = 0; else if (sum2 > 255) sum2 = 255;
-                    *output = static_cast<unsigned char>(sum2); output ++;
-                    if (sum3 < 0) sum3 = 0; else if (sum3 > 255) sum3 = 255;
-                    *output = static_cast<unsigned char>(sum3); output ++;
-                    if (sum4 < 0) sum4 = 0; else if (sum4 > 255) sum4 = 255;
-                    *output = static_cast<unsigned char>(sum4); output ++;
-                }
-            }
+            input += rowsize;
+            output += rowsize;
         }
 
     }
     else {
 
-        const int rowstride_short = rowstride - 4;
-        int l, l_from, l_to;
+        const int tilesize = std::min(rowsize, SVL_CONVOLUTION_TILE_SIZE);
+        vctDynamicVector<int> accumulator(tilesize);
 
         for (j = 0; j < height; j ++) {
-            for (i = 0; i < width; i ++) {
-
-                sum1 = sum2 = sum3 = sum4 = 0;
-
-                kernelptr = kernel.Pointer();
-
-                l = kernel_size;
-                l_from = j - kernel_rad;
-                l_to   = l_from + kernel_size;
-                if (l_from < 0) {
-                    l += l_from;
-                    kernelptr -= l_from;
-                    l_from = 0;
-                }
-                if (l_to > height) {
-                    l -= l_to - height;
-                    l_to = height;
-                }
-
-                input2 = input + l_from * rowstride + i * 4;
-
-                while (l) {
-
-                    k_val = *kernelptr; kernelptr ++;
-                    sum1 += (*input2) * k_val; input2 ++; 
-                    sum2 += (*input2) * k_val; input2 ++;
-                    sum3 += (*input2) * k_val; input2 ++;
-                    sum4 += (*input2) * k_val; input2 ++;
-
-                    input2 += rowstride_short;
-
-                    l --;
-                }
+            for (i = 0; i < rowsize; i += tilesize) {
+                length = std::min(tilesize, rowsize - i);
 
-                sum1 >>= 10; sum2 >>= 10; sum3 >>= 10; sum4 >>= 10;
-
-                if (absres) {
-                    if (sum1 < 0) sum1 = -sum1; if (sum1 > 255) sum1 = 255;
-                    *output = static_cast<unsigned char>(sum1); output ++;
-                    if (sum2 < 0) sum2 = -sum2; if (sum2 > 255) sum2 = 255;
-                    *output = static_cast<unsigned char>(sum2); output ++;
-                    if (sum3 < 0) sum3 = -sum3; if (sum3 > 255) sum3 = 255;
-                    *output = static_cast<unsigned char>(sum3); output ++;
-                    if (sum4 < 0) sum4 = -sum4; if (sum4 > 255) sum4 = 255;
-                    *output = static_cast<unsigned char>(sum4); output ++;
-                }
-                else {
-                    if (sum1 < 0) sum1 = 0; else if (sum1 > 255) sum1 = 255;
-                    *output = static_cast<unsigned char>(sum1); output ++;
-                    if (sum2 < 0) sum2 = 0; else if (sum2 > 255) sum2 = 255;
-                    *output = static_cast<unsigned char>(sum2); output ++;
-                    if (sum3 < 0) sum3 = 0; else if (sum3 > 255) sum3 = 255;
-                    *output = static_cast<unsigned char>(sum3); output ++;
-                    if (sum4 < 0) sum4 = 0; else if (sum4 > 255) sum4 = 255;
-                    *output = static_cast<unsigned char>(sum4); output ++;
+                accumulator.SetAll(0);
+                for (k = 0; k < kernel_size; k ++) {
+                    l = j + k - kernel_rad;
+                    if (l < 0 || l >= height || kernelptr[k] == 0) continue;
+                    svlImageProcessingSIMD::MultiplyAccumulate(input + l * rowsize + i, accumulator.Pointer(), length, kernelptr[k]);
                 }
+                svlImageProcessingSIMD::ShiftAndSaturate(accumulator.Pointer(), output + j * rowsize + i, length, 10, absres);
             }
         }
 
     }
 }
 
-void svlImageProcessingHelper::ConvolutionMono8(unsigned char* input, unsigned char* output, const int width, const int height,
-                                                vctDynamicVector<int> & kernel, bool horizontal, bool absres)
+// Two dimensional convolution with the outer product of the vertical and
+// horizontal kernels in a single pass.  The horizontal results of the
+// rows covered by the vertical kernel are kept in a ring buffer so each
+// input row is filtered horizontally only once.
+template <class _Type>
+static void svlConvolutionSeparable(const _Type* input, _Type* output, const int width, const int height, const int channels,
+                                    const double maxvalue,
+                                    const vctDynamicVector<double> & kernel_horiz, const vctDynamicVector<double> & kernel_vert,
+                                    bool absres)
 {
-    if (!input || !output || kernel.size() < 1) return;
-
-    const int kernel_size = static_cast<int>(kernel.size());
-    const int kernel_rad = kernel_size / 2;
-    unsigned char *input2;
-    int *kernelptr;
-    int i, j, k_val, sum;
-
-    if (horizontal) {
-
-        int k, k_from, k_to;
-
-        for (j = 0; j < height; j ++) {
-            for (i = 0; i < width; i ++) {
-
-                sum = 0;
-
-                kernelptr = kernel.Pointer();
-
-                k = kernel_size;
-                k_from = i - kernel_rad;
-                k_to   = k_from + kernel_size;
-                if (k_from < 0) {
-                    k += k_from;
-                    kernelptr -= k_from;
-                    k_from = 0;
-                }
-                if (k_to > width) {
-                    k -= k_to - width;
-                    k_to = width;
-                }
+    const int kernel_h_size = static_cast<int>(kernel_horiz.size());
+    const int kernel_v_size = static_cast<int>(kernel_vert.size());
+    const int kernel_v_rad = kernel_v_size / 2;
+    const int rowsize = width * channels;
+    const double gain_h = kernel_horiz.L1Norm();
+    const double gain_v = kernel_vert.L1Norm();
+
+    if (gain_h <= 0.0 || gain_v <= 0.0) {
+        memset(output, 0, rowsize * height * sizeof(_Type));
+        return;
+    }
 
-                input2 = input + j * width + k_from;
+    // Fractional bits of the fixed point kernels, chosen so the 32 bit
+    // accumulators don't overflow with 1 bit left for rounding errors.
+    // When both kernels can't get 10 bits (16 bit images) the horizontal
+    // results are rounded to fewer fractional bits before the vertical
+    // pass, which keeps the precision of the vertical kernel.
+    const double range = 1073741823.0;
+    const int total = static_cast<int>(std::floor(std::log(range / (maxvalue * gain_h * gain_v)) / std::log(2.0)));
+    int bits_h, bits_v, pre_shift;
+    if (total >= 20) {
+        bits_h = std::min(14, total - total / 2);
+        bits_v = std::min(14, total - bits_h);
+        pre_shift = 0;
+    }
+    else {
+        bits_h = static_cast<int>(std::floor(std::log(range / (maxvalue * gain_h)) / std::log(2.0)));
+        bits_h = std::max(0, std::min(14, bits_h));
+        bits_v = std::max(0, std::min(14, total));
+        pre_shift = std::min(bits_h, std::max(0, bits_h + bits_v - total));
+    }
+    const int shift = bits_h + bits_v - pre_shift;
+    const int round_h = (pre_shift > 0) ? 1 << (pre_shift - 1) : 0;
+    const int round_v = (shift > 0) ? 1 << (shift - 1) : 0;
+
+    vctDynamicVector<int> fp_kernel_horiz(kernel_h_size), fp_kernel_vert(kernel_v_size);
+    int i, j, k, l, length;
+    for (k = 0; k < kernel_h_size; k ++) {
+        fp_kernel_horiz[k] = static_cast<int>(std::floor(kernel_horiz[k] * (1 << bits_h) + 0.5));
+    }
+    for (k = 0; k < kernel_v_size; k ++) {
+        fp_kernel_vert[k] = static_cast<int>(std::floor(kernel_vert[k] * (1 << bits_v) + 0.5));
+    }
 
-                while (k) {
+    const int tilesize = std::min(rowsize, SVL_CONVOLUTION_TILE_SIZE);
+    vctDynamicMatrix<int> rows(kernel_v_size, rowsize);
+    vctDynamicVector<int> accumulator(tilesize);
+    int *row, last, next = 0;
 
-                    k_val = *kernelptr; kernelptr ++;
-                    sum += (*input2) * k_val; input2 ++; 
+    for (j = 0; j < height; j ++) {
 
-                    k --;
-                }
+        // Horizontal pass on the rows entering the vertical window
+        last = std::min(j - kernel_v_rad + kernel_v_size - 1, height - 1);
+        for (; next <= last; next ++) {
+            row = rows.Pointer(next % kernel_v_size, 0);
+            std::fill(row, row + rowsize, round_h);
+            svlConvolutionAccumulateRow(input + next * rowsize, row, rowsize, channels, fp_kernel_horiz.Pointer(), kernel_h_size);
+            if (pre_shift > 0) svlImageProcessingSIMD::ShiftRight(row, rowsize, pre_shift);
+        }
 
-                sum >>= 10;
+        // Vertical pass
+        for (i = 0; i < rowsize; i += tilesize) {
+            length = std::min(tilesize, rowsize - i);
 
-                if (absres) {
-                    if (sum < 0) sum = -sum; if (sum > 255) sum = 255;
-                    *output = static_cast<unsigned char>(sum); output ++;
-                }
-                else {
-                    if (sum < 0) sum = 0; else if (sum > 255) sum = 255;
-                    *output = static_cast<unsigned char>(sum); output ++;
-                }
+            accumulator.SetAll(round_v);
+            for (k = 0; k < kernel_v_size; k ++) {
+                l = j + k - kernel_v_rad;
+                if (l < 0 || l >= height || fp_kernel_vert[k] == 0) continue;
+                svlImageProcessingSIMD::MultiplyAccumulate(rows.Pointer(l % kernel_v_size, i), accumulator.Pointer(), length, fp_kernel_vert[k]);
             }
+            svlImageProcessingSIMD::ShiftAndSaturate(accumulator.Pointer(), output + j * rowsize + i, length, shift, absres);
         }
-
     }
-    else {
+}
+/******************************************/
+/*** svlImageProcessingHelper namespace ***/
+/******************************************/
 
-        const int rowstride_short = width - 1;
-        int l, l_from, l_to;
+void svlImageProcessingHelper::ConvolutionRGB(unsigned char* input, unsigned char* output, const int width, const int height,
+                                              vctDynamicVector<int> & kernel, bool horizontal, bool absres)
+{
+    if (!input || !output || kernel.size() < 1) return;
+    svlConvolutionSinglePass(input, output, width, height, 3, kernel, horizontal, absres);
+}
 
-        for (j = 0; j < height; j ++) {
-            for (i = 0; i < width; i ++) {
+void svlImageProcessingHelper::ConvolutionRGBA(unsigned char* input, unsigned char* output, const int width, const int height,
+                                               vctDynamicVector<int> & kernel, bool horizontal, bool absres)
+{
+    if (!input || !output || kernel.size() < 1) return;
+    svlConvolutionSinglePass(input, output, width, height, 4, kernel, horizontal, absres);
+}
 
-                sum = 0;
-                
-                kernelptr = kernel.Pointer();
-                
-                l = kernel_size;
-                l_from = j - kernel_rad;
-                l_to   = l_from + kernel_size;
-                if (l_from < 0) {
-                    l += l_from;
-                    kernelptr -= l_from;
-                    l_from = 0;
-                }
-                if (l_to > height) {
-                    l -= l_to - height;
-                    l_to = height;
-                }
-                
-                input2 = input + l_from * width + i;
-                
-                while (l) {
-                    
-                    k_val = *kernelptr; kernelptr ++;
-                    sum += (*input2) * k_val; input2 ++; 
-                    
-                    input2 += rowstride_short;
-                    
-                    l --;
-                }
-                
-                sum >>= 10;
-                
-                if (absres) {
-                    if (sum < 0) sum = -sum; if (sum > 255) sum = 255;
-                    *output = static_cast<unsigned char>(sum); output ++;
-                }
-                else {
-                    if (sum < 0) sum = 0; else if (sum > 255) sum = 255;
-                    *output = static_cast<unsigned char>(sum); output ++;
-                }
-            }
-        }
-        
-    }
+void svlImageProcessingHelper::ConvolutionMono8(unsigned char* input, unsigned char* output, const int width, const int height,
+                                                vctDynamicVector<int> & kernel, bool horizontal, bool absres)
+{
+    if (!input || !output || kernel.size() < 1) return;
+    svlConvolutionSinglePass(input, output, width, height, 1, kernel, horizontal, absres);
 }
 
 void svlImageProcessingHelper::ConvolutionMono16(unsigned short* input, unsigned short* output, const int width, const int height,
                                                  vctDynamicVector<int> & kernel, bool horizontal, bool absres)
 {
     if (!input || !output || kernel.size() < 1) return;
-
-    const int kernel_size = static_cast<int>(kernel.size());
-    const int kernel_rad = kernel_size / 2;
-    unsigned short *input2;
-    int *kernelptr;
-    int i, j, k_val, sum;
-
-    if (horizontal) {
-
-        int k, k_from, k_to;
-
-        for (j = 0; j < height; j ++) {
-            for (i = 0; i < width; i ++) {
-
-                sum = 0;
-
-                kernelptr = kernel.Pointer();
-
-                k = kernel_size;
-                k_from = i - kernel_rad;
-                k_to   = k_from + kernel_size;
-                if (k_from < 0) {
-                    k += k_from;
-                    kernelptr -= k_from;
-                    k_from = 0;
-                }
-                if (k_to > width) {
-                    k -= k_to - width;
-                    k_to = width;
-                }
-
-                input2 = input + j * width + k_from;
-
-                while (k) {
-
-                    k_val = *kernelptr; kernelptr ++;
-                    sum += (*input2) * k_val; input2 ++; 
-
-                    k --;
-                }
-
-                sum >>= 10;
-
-                if (absres) {
-                    if (sum < 0) sum = -sum; if (sum > 65535) sum = 65535;
-                    *output = static_cast<unsigned char>(sum); output ++;
-                }
-                else {
-                    if (sum < 0) sum = 0; else if (sum > 65535) sum = 65535;
-                    *output = static_cast<unsigned char>(sum); output ++;
-                }
-            }
-        }
-
-    }
-    else {
-
-        const int rowstride_short = width - 1;
-        int l, l_from, l_to;
-
-        for (j = 0; j < height; j ++) {
-            for (i = 0; i < width; i ++) {
-
-                sum = 0;
-
-                kernelptr = kernel.Pointer();
-
-                l = kernel_size;
-                l_from = j - kernel_rad;
-                l_to   = l_from + kernel_size;
-                if (l_from < 0) {
-                    l += l_from;
-                    kernelptr -= l_from;
-                    l_from = 0;
-                }
-                if (l_to > height) {
-                    l -= l_to - height;
-                    l_to = height;
-                }
-
-                input2 = input + l_from * width + i;
-
-                while (l) {
-
-                    k_val = *kernelptr; kernelptr ++;
-                    sum += (*input2) * k_val; input2 ++; 
-
-                    input2 += rowstride_short;
-
-                    l --;
-                }
-
-                sum >>= 10;
-
-                if (absres) {
-                    if (sum < 0) sum = -sum; if (sum > 65535) sum = 65535;
-                    *output = static_cast<unsigned char>(sum); output ++;
-                }
-                else {
-                    if (sum < 0) sum = 0; else if (sum > 65535) sum = 65535;
-                    *output = static_cast<unsigned char>(sum); output ++;
-                }
-            }
-        }
-
-    }
+    svlConvolutionSinglePass(input, output, width, height, 1, kernel, horizontal, absres);
 }
-
 void svlImageProcessingHelper::ConvolutionMono32(unsigned int* input, unsigned int* output, const int width, const int height,
                                                  vctDynamicVector<int> & kernel, bool horizontal, bool absres)
 {
@@ -1127,95 +819,133 @@ void svlImageProcessingHelper::ConvolutionMono32(unsigned int* input, unsigned i
     }
 }
 
+bool svlImageProcessingHelper::IsSeparable(const vctDynamicMatrix<double> & kernel,
+                                           vctDynamicVector<double> & kernel_horiz, vctDynamicVector<double> & kernel_vert)
+{
+    const int kernel_width  = static_cast<int>(kernel.cols());
+    const int kernel_height = static_cast<int>(kernel.rows());
+    if (kernel_width < 1 || kernel_height < 1) return false;
+
+    // If the kernel has rank 1, all rows are multiples of the row
+    // containing the largest coefficient
+    int i, j, pivot_row = 0, pivot_col = 0;
+    double value, maxvalue = 0.0;
+    for (j = 0; j < kernel_height; j ++) {
+        for (i = 0; i < kernel_width; i ++) {
+            value = std::fabs(kernel.Element(j, i));
+            if (value > maxvalue) {
+                maxvalue = value;
+                pivot_row = j;
+                pivot_col = i;
+            }
+        }
+    }
+    if (maxvalue == 0.0) return false;
+
+    const double pivot = kernel.Element(pivot_row, pivot_col);
+    kernel_horiz.SetSize(kernel_width);
+    kernel_vert.SetSize(kernel_height);
+    for (i = 0; i < kernel_width; i ++) kernel_horiz[i] = kernel.Element(pivot_row, i);
+    for (j = 0; j < kernel_height; j ++) kernel_vert[j] = kernel.Element(j, pivot_col) / pivot;
+
+    // Same gain for both kernels
+    const double scale = std::sqrt(kernel_vert.L1Norm() / kernel_horiz.L1Norm());
+    kernel_horiz.Multiply(scale);
+    kernel_vert.Divide(scale);
+
+    const double tolerance = 1.0e-6 * maxvalue;
+    for (j = 0; j < kernel_height; j ++) {
+        for (i = 0; i < kernel_width; i ++) {
+            if (std::fabs(kernel.Element(j, i) - kernel_vert[j] * kernel_horiz[i]) > tolerance) return false;
+        }
+    }
+    return true;
+}
+
+void svlImageProcessingHelper::ConvolutionSeparable(const unsigned char* input, unsigned char* output, const int width, const int height, const int channels,
+                                                    const vctDynamicVector<double> & kernel_horiz, const vctDynamicVector<double> & kernel_vert, bool absres)
+{
+    if (!input || !output || kernel_horiz.size() < 1 || kernel_vert.size() < 1) return;
+    svlConvolutionSeparable(input, output, width, height, channels, 255.0, kernel_horiz, kernel_vert, absres);
+}
+
+void svlImageProcessingHelper::ConvolutionSeparable(const unsigned short* input, unsigned short* output, const int width, const int height,
+                                                    const vctDynamicVector<double> & kernel_horiz, const vctDynamicVector<double> & kernel_vert, bool absres)
+{
+    if (!input || !output || kernel_horiz.size() < 1 || kernel_vert.size() < 1) return;
+    svlConvolutionSeparable(input, output, width, height, 1, 65535.0, kernel_horiz, kernel_vert, absres);
+}
 void svlImageProcessingHelper::UnsharpMaskBlurRGB(const unsigned char* img_in, unsigned char* img_out, const int width, const int height, int radius)
 {
+    // Box filter with running sums: the column sums over the rows of the
+    // window are updated when the window moves down, then the window
+    // slides along the column sums on each row
     const int rowstride = width * 3;
-    const int rs_minus2 = rowstride - 2;
+    vctDynamicVector<int> colsums(rowstride, 0);
 
-    int i, j, k, l;
-    int xstart, xend, ystart, yend;
+    int i, j, k;
+    int ystart, yend, rowcount, colcount;
     int sum_r, sum_g, sum_b, divider;
-    const unsigned char* input;
+    const int* colsum;
     unsigned char* output;
 
+    if (radius < 0) radius = 0;
+
+    // Rows [0, radius - 1], row j + radius is added in the loop
+    yend = std::min(radius, height);
+    for (j = 0; j < yend; j ++) {
+        svlImageProcessingSIMD::MultiplyAccumulate(img_in + j * rowstride, colsums.Pointer(), rowstride, 1);
+    }
+
     for (j = 0; j < height; j ++) {
 
-        sum_r = 0;
-        sum_g = 0;
-        sum_b = 0;
-        divider = 0;
-
-        // Initializing region of processing
-        xstart = 0;
-        xend = radius;
-        ystart = j - radius;
-        if (ystart < 0) ystart = 0;
-        yend = j + radius;
-        if (yend >= height) yend = height - 1;
-
-        // Computing initial sum
-        for (l = ystart; l <= yend; l ++) {
-            input = img_in + l * rowstride + xstart * 3;
-            for (k = xstart; k <= xend; k ++) {
-
-                sum_r += *input;
-                input ++;
-                sum_g += *input;
-                input ++;
-                sum_b += *input;
-                input ++;
-
-                divider ++;
-            }
+        // Updating column sums
+        if (j + radius < height) {
+            svlImageProcessingSIMD::MultiplyAccumulate(img_in + (j + radius) * rowstride, colsums.Pointer(), rowstride, 1);
+        }
+        if (j - radius > 0) {
+            svlImageProcessingSIMD::MultiplyAccumulate(img_in + (j - radius - 1) * rowstride, colsums.Pointer(), rowstride, -1);
+        }
+        ystart = std::max(0, j - radius);
+        yend = std::min(height - 1, j + radius);
+        rowcount = yend - ystart + 1;
+
+        // Columns [0, radius - 1], column i + radius is added in the loop
+        sum_r = sum_g = sum_b = 0;
+        colcount = std::min(radius, width);
+        colsum = colsums.Pointer();
+        for (k = 0; k < colcount; k ++) {
+            sum_r += colsum[0];
+            sum_g += colsum[1];
+            sum_b += colsum[2];
+            colsum += 3;
         }
 
-        // Setting value of first column
         output = img_out + j * rowstride;
-        *output = sum_r / divider;
-        output ++;
-        *output = sum_g / divider;
-        output ++;
-        *output = sum_b / divider;
-        output ++;
-
-        // Proceeding on the rest of the line
-        for (i = 1; i < width; i ++) {
+        for (i = 0; i < width; i ++) {
 
-            // Subtracting previous column
-            xstart = i - radius - 1;
-            if (xstart >= 0) {
-                input = img_in + ystart * rowstride + xstart * 3;
-                for (l = ystart; l <= yend; l ++) {
-
-                    sum_r -= *input;
-                    input ++;
-                    sum_g -= *input;
-                    input ++;
-                    sum_b -= *input;
-                    input += rs_minus2;
-
-                    divider --;
-                }
+            // Adding next column
+            k = i + radius;
+            if (k < width) {
+                colsum = colsums.Pointer() + k * 3;
+                sum_r += colsum[0];
+                sum_g += colsum[1];
+                sum_b += colsum[2];
+                colcount ++;
             }
 
-            // Adding next column
-            xend = i + radius;
-            if (xend < width) {
-                input = img_in + ystart * rowstride + xend * 3;
-                for (l = ystart; l <= yend; l ++) {
-
-                    sum_r += *input;
-                    input ++;
-                    sum_g += *input;
-                    input ++;
-                    sum_b += *input;
-                    input += rs_minus2;
-
-                    divider ++;
-                }
+            // Subtracting previous column
+            k = i - radius - 1;
+            if (k >= 0) {
+                colsum = colsums.Pointer() + k * 3;
+                sum_r -= colsum[0];
+                sum_g -= colsum[1];
+                sum_b -= colsum[2];
+                colcount --;
             }
 
             // Setting value
+            divider = rowcount * colcount;
             *output = sum_r / divider;
             output ++;
             *output = sum_g / divider;
@@ -1693,28 +1423,37 @@ void svlImageProcessingHelper::DeinterlaceAdaptiveDiscarding(unsigned char* buff
 /*** svlImageProcessingHelper::RectificationInternals class ***/
 /**************************************************************/
 
+// Binary remap table files, see SaveRemapTable
+#define SVL_RECTIFICATION_TABLE_MAGIC       "svlRECT\0"
+#define SVL_RECTIFICATION_TABLE_VERSION     1
+
+// FNV-1a hash of the parameters of SetFromCameraCalibration
+static unsigned long long svlRectificationTableKey(unsigned int height, unsigned int width,
+                                                   const vct3x3 & R, const vct2 & f, const vct2 & c,
+                                                   const vctFixedSizeVector<double, 7> & k, double alpha)
+{
+    double params[2 + 9 + 2 + 2 + 7 + 1];
+    unsigned int i, n = 0;
+    params[n ++] = height;
+    params[n ++] = width;
+    for (i = 0; i < 9; i ++) params[n ++] = R.Element(i / 3, i % 3);
+    for (i = 0; i < 2; i ++) params[n ++] = f[i];
+    for (i = 0; i < 2; i ++) params[n ++] = c[i];
+    for (i = 0; i < 7; i ++) params[n ++] = k[i];
+    params[n ++] = alpha;
+
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(params);
+    unsigned long long key = 14695981039346656037ULL;
+    for (i = 0; i < sizeof(params); i ++) {
+        key = (key ^ bytes[i]) * 1099511628211ULL;
+    }
+    return key;
+}
+
 svlImageProcessingHelper::RectificationInternals::RectificationInternals() :
     svlImageProcessingInternals(),
     Width(0),
-    Height(0),
-    idxDest(0),
-    idxDestSize(0),
-    idxSrc1(0),
-    idxSrc1Size(0),
-    idxSrc2(0),
-    idxSrc2Size(0),
-    idxSrc3(0),
-    idxSrc3Size(0),
-    idxSrc4(0),
-    idxSrc4Size(0),
-    blendSrc1(0),
-    blendSrc1Size(0),
-    blendSrc2(0),
-    blendSrc2Size(0),
-    blendSrc3(0),
-    blendSrc3Size(0),
-    blendSrc4(0),
-    blendSrc4Size(0)
+    Height(0)
 {
 }
 
@@ -1781,6 +1520,10 @@ bool svlImageProcessingHelper::RectificationInternals::Load(const std::string &f
     char* chbuf    = new char[(16 * size) + 1];
     int valcnt, i;
 
+    // Destination and source pixel indices and source blending weights
+    vctDynamicVector<unsigned int> idxDest, idxSrc1, idxSrc2, idxSrc3, idxSrc4;
+    vctDynamicVector<unsigned char> blendSrc1, blendSrc2, blendSrc3, blendSrc4, fracX, fracY;
+
     // lutpos:
     //          1 - width, height
     //          2 - destination index lut
@@ -1810,8 +1553,7 @@ bool svlImageProcessingHelper::RectificationInternals::Load(const std::string &f
             case 1:
                 valcnt = LoadLine(file, dblbuf, chbuf, size, explen);
                 if (valcnt < 1) goto labError;
-                idxDestSize = valcnt;
-                idxDest = new unsigned int[valcnt];
+                idxDest.SetSize(valcnt);
                 for (i = 0; i < valcnt; i ++) {
                     idxDest[i] = static_cast<unsigned int>(dblbuf[i] + 0.5);
                 }
@@ -1822,8 +1564,7 @@ bool svlImageProcessingHelper::RectificationInternals::Load(const std::string &f
             case 2:
                 valcnt = LoadLine(file, dblbuf, chbuf, size, explen);
                 if (valcnt < 1) goto labError;
-                idxSrc1Size = valcnt;
-                idxSrc1 = new unsigned int[valcnt];
+                idxSrc1.SetSize(valcnt);
                 for (i = 0; i < valcnt; i ++) {
                     idxSrc1[i] = static_cast<unsigned int>(dblbuf[i] + 0.5);
                 }
@@ -1834,8 +1575,7 @@ bool svlImageProcessingHelper::RectificationInternals::Load(const std::string &f
             case 3:
                 valcnt = LoadLine(file, dblbuf, chbuf, size, explen);
                 if (valcnt < 1) goto labError;
-                idxSrc2Size = valcnt;
-                idxSrc2 = new unsigned int[valcnt];
+                idxSrc2.SetSize(valcnt);
                 for (i = 0; i < valcnt; i ++) {
                     idxSrc2[i] = static_cast<unsigned int>(dblbuf[i] + 0.5);
                 }
@@ -1846,8 +1586,7 @@ bool svlImageProcessingHelper::RectificationInternals::Load(const std::string &f
             case 4:
                 valcnt = LoadLine(file, dblbuf, chbuf, size, explen);
                 if (valcnt < 1) goto labError;
-                idxSrc3Size = valcnt;
-                idxSrc3 = new unsigned int[valcnt];
+                idxSrc3.SetSize(valcnt);
                 for (i = 0; i < valcnt; i ++) {
                     idxSrc3[i] = static_cast<unsigned int>(dblbuf[i] + 0.5);
                 }
@@ -1858,8 +1597,7 @@ bool svlImageProcessingHelper::RectificationInternals::Load(const std::string &f
             case 5:
                 valcnt = LoadLine(file, dblbuf, chbuf, size, explen);
                 if (valcnt < 1) goto labError;
-                idxSrc4Size = valcnt;
-                idxSrc4 = new unsigned int[valcnt];
+                idxSrc4.SetSize(valcnt);
                 for (i = 0; i < valcnt; i ++) {
                     idxSrc4[i] = static_cast<unsigned int>(dblbuf[i] + 0.5);
                 }
@@ -1870,8 +1608,7 @@ bool svlImageProcessingHelper::RectificationInternals::Load(const std::string &f
             case 6:
                 valcnt = LoadLine(file, dblbuf, chbuf, size, explen);
                 if (valcnt < 1) goto labError;
-                blendSrc1Size = valcnt;
-                blendSrc1 = new unsigned char[valcnt];
+                blendSrc1.SetSize(valcnt);
                 for (i = 0; i < valcnt; i ++) {
                     blendSrc1[i] = static_cast<unsigned char>(dblbuf[i] * 256);
                 }
@@ -1882,8 +1619,7 @@ bool svlImageProcessingHelper::RectificationInternals::Load(const std::string &f
             case 7:
                 valcnt = LoadLine(file, dblbuf, chbuf, size, explen);
                 if (valcnt < 1) goto labError;
-                blendSrc2Size = valcnt;
-                blendSrc2 = new unsigned char[valcnt];
+                blendSrc2.SetSize(valcnt);
                 for (i = 0; i < valcnt; i ++) {
                     blendSrc2[i] = static_cast<unsigned char>(dblbuf[i] * 256);
                 }
@@ -1894,8 +1630,7 @@ bool svlImageProcessingHelper::RectificationInternals::Load(const std::string &f
             case 8:
                 valcnt = LoadLine(file, dblbuf, chbuf, size, explen);
                 if (valcnt < 1) goto labError;
-                blendSrc3Size = valcnt;
-                blendSrc3 = new unsigned char[valcnt];
+                blendSrc3.SetSize(valcnt);
                 for (i = 0; i < valcnt; i ++) {
                     blendSrc3[i] = static_cast<unsigned char>(dblbuf[i] * 256);
                 }
@@ -1906,8 +1641,7 @@ bool svlImageProcessingHelper::RectificationInternals::Load(const std::string &f
             case 9:
                 valcnt = LoadLine(file, dblbuf, chbuf, size, explen);
                 if (valcnt < 1) goto labError;
-                blendSrc4Size = valcnt;
-                blendSrc4 = new unsigned char[valcnt];
+                blendSrc4.SetSize(valcnt);
                 for (i = 0; i < valcnt; i ++) {
                     blendSrc4[i] = static_cast<unsigned char>(dblbuf[i] * 256);
                 }
@@ -1919,29 +1653,28 @@ bool svlImageProcessingHelper::RectificationInternals::Load(const std::string &f
 
     file.close();
 
-    valcnt = idxDestSize;
-    if (idxSrc1Size != valcnt ||
-        idxSrc2Size != valcnt ||
-        idxSrc3Size != valcnt ||
-        idxSrc4Size != valcnt ||
-        blendSrc1Size != valcnt ||
-        blendSrc2Size != valcnt ||
-        blendSrc3Size != valcnt ||
-        blendSrc4Size != valcnt) goto labError;
-
-    TransposeLUTArray(idxDest, valcnt, Width, Height);
-    TransposeLUTArray(idxSrc1, valcnt, Width, Height);
-    TransposeLUTArray(idxSrc2, valcnt, Width, Height);
-    TransposeLUTArray(idxSrc3, valcnt, Width, Height);
-    TransposeLUTArray(idxSrc4, valcnt, Width, Height);
-
+    valcnt = static_cast<int>(idxDest.size());
+    if (static_cast<int>(idxSrc1.size()) != valcnt ||
+        static_cast<int>(idxSrc2.size()) != valcnt ||
+        static_cast<int>(idxSrc3.size()) != valcnt ||
+        static_cast<int>(idxSrc4.size()) != valcnt ||
+        static_cast<int>(blendSrc1.size()) != valcnt ||
+        static_cast<int>(blendSrc2.size()) != valcnt ||
+        static_cast<int>(blendSrc3.size()) != valcnt ||
+        static_cast<int>(blendSrc4.size()) != valcnt) goto labError;
+
+    TransposeLUTArray(idxDest.Pointer(), valcnt, Width, Height);
+    TransposeLUTArray(idxSrc1.Pointer(), valcnt, Width, Height);
+
+    // Sources 2, 3 and 4 are the right, bottom and bottom-right neighbors
+    // of source 1, the position in the quad is recovered from the weights
+    fracX.SetSize(valcnt);
+    fracY.SetSize(valcnt);
     for (i = 0; i < valcnt; i ++) {
-        idxDest[i] *= 3;
-        idxSrc1[i] *= 3;
-        idxSrc2[i] *= 3;
-        idxSrc3[i] *= 3;
-        idxSrc4[i] *= 3;
+        fracX[i] = static_cast<unsigned char>(std::min(255, blendSrc2[i] + blendSrc4[i]));
+        fracY[i] = static_cast<unsigned char>(std::min(255, blendSrc3[i] + blendSrc4[i]));
     }
+    BuildRemapTable(idxDest.Pointer(), idxSrc1.Pointer(), fracX.Pointer(), fracY.Pointer(), valcnt);
 
     if (dblbuf) delete [] dblbuf;
     if (chbuf) delete [] chbuf;
@@ -1987,9 +1720,20 @@ bool svlImageProcessingHelper::RectificationInternals::SetFromCameraCalibration(
     Release();
 	bool debug = false;
 
-    const unsigned int maxwidth = 1920;
-    const unsigned int maxheight = 1200;
-    //const unsigned int size = maxwidth * maxheight;
+    // Offsets of the remap table are 16 bit
+    if (width > 32767 || height > 32767) return false;
+
+    // Loading table generated with the same parameters
+    const unsigned long long key = svlRectificationTableKey(height, width, R, f, c, k, alpha);
+    std::string cachefile;
+    if (!CacheDirectory.empty()) {
+        std::stringstream name;
+        name << CacheDirectory << "/svlRectification_" << std::hex << std::setw(16) << std::setfill('0') << key << ".lut";
+        cachefile = name.str();
+        if (LoadRemapTable(cachefile, key) && Width == width && Height == height) return true;
+        Release();
+    }
+
     int valcnt, i;
 	vct3x3 KK_new = vct3x3::Eye();
 
@@ -2465,73 +2209,27 @@ bool svlImageProcessingHelper::RectificationInternals::SetFromCameraCalibration(
 	//========SetTable(height,width,ind_new,ind_1,ind_2,ind_3,ind_4,a1,a2,a3,a4,videoch);========//
 	Height = height;
 	Width = width;
-	if (Width > maxwidth || Height > maxheight) goto labError;
-               
-	//this is not efficient 
-	valcnt = static_cast<int>(ind_new.size());
-
-	idxDestSize = static_cast<int>(ind_new.size());
-    idxDest = new unsigned int[ind_new.size()];
-
-	idxSrc1Size = static_cast<int>(ind_1.size());
-    idxSrc1 = new unsigned int[ind_1.size()];
-
-	idxSrc2Size = static_cast<int>(ind_2.size());
-    idxSrc2 = new unsigned int[ind_2.size()];
-
-	idxSrc3Size = static_cast<int>(ind_3.size());
-    idxSrc3 = new unsigned int[ind_3.size()];
 
-	idxSrc4Size = static_cast<int>(ind_4.size());
-    idxSrc4 = new unsigned int[ind_4.size()];
+	valcnt = static_cast<int>(good_points.size());
 
-	blendSrc1Size = static_cast<int>(a1.size());
-    blendSrc1 = new unsigned char[a1.size()];
+    {
+        vctDynamicVector<unsigned int> idxDest(valcnt), idxSrc(valcnt);
+        vctDynamicVector<unsigned char> fracX(valcnt), fracY(valcnt);
 
-	blendSrc2Size = static_cast<int>(a2.size());
-    blendSrc2 = new unsigned char[a2.size()];
-
-	blendSrc3Size = static_cast<int>(a3.size());
-    blendSrc3 = new unsigned char[a3.size()];
-
-	blendSrc4Size = static_cast<int>(a4.size());
-    blendSrc4 = new unsigned char[a4.size()];
-
-    for (i = 0; i < valcnt; i ++) {
-        idxDest[i] = static_cast<unsigned int>(ind_new[i] + 0.5);
-
-        idxSrc1[i] = static_cast<unsigned int>(ind_1[i] + 0.5);
-		idxSrc2[i] = static_cast<unsigned int>(ind_2[i] + 0.5);
-		idxSrc3[i] = static_cast<unsigned int>(ind_3[i] + 0.5);
-		idxSrc4[i] = static_cast<unsigned int>(ind_4[i] + 0.5);
+        for (i = 0; i < valcnt; i ++) {
+            idxDest[i] = static_cast<unsigned int>(py_good[i] + 0.5) * width + static_cast<unsigned int>(px_good[i] + 0.5);
+            idxSrc[i]  = static_cast<unsigned int>(py_0_good[i] + 0.5) * width + static_cast<unsigned int>(px_0_good[i] + 0.5);
+            fracX[i] = static_cast<unsigned char>(std::min(255.0, std::floor(alpha_x[i] * 256.0 + 0.5)));
+            fracY[i] = static_cast<unsigned char>(std::min(255.0, std::floor(alpha_y[i] * 256.0 + 0.5)));
+        }
 
-		blendSrc1[i] = static_cast<unsigned char>(a1[i] * 256);
-		blendSrc2[i] = static_cast<unsigned char>(a2[i] * 256);
-		blendSrc3[i] = static_cast<unsigned char>(a3[i] * 256);
-		blendSrc4[i] = static_cast<unsigned char>(a4[i] * 256);
+        BuildRemapTable(idxDest.Pointer(), idxSrc.Pointer(), fracX.Pointer(), fracY.Pointer(), valcnt);
     }
 
-	TransposeLUTArray2(idxDest, valcnt, Width, Height);
-    TransposeLUTArray2(idxSrc1, valcnt, Width, Height);
-    TransposeLUTArray2(idxSrc2, valcnt, Width, Height);
-    TransposeLUTArray2(idxSrc3, valcnt, Width, Height);
-    TransposeLUTArray2(idxSrc4, valcnt, Width, Height);
-
-    for (i = 0; i < valcnt; i ++) {
-        idxDest[i] *= 3;
-        idxSrc1[i] *= 3;
-        idxSrc2[i] *= 3;
-        idxSrc3[i] *= 3;
-        idxSrc4[i] *= 3;
-    }
+    // Failing to save the table only means it will be generated again
+    if (!cachefile.empty()) SaveRemapTable(cachefile, key);
 
     return true;
-
-labError:
-    Release();
-
-    return false;
-
 }
 
 void svlImageProcessingHelper::RectificationInternals::TransposeLUTArray2(unsigned int* index, unsigned int size, unsigned int width, unsigned int height)
@@ -2768,38 +2466,185 @@ void svlImageProcessingHelper::RectificationInternals::TransposeLUTArray(unsigne
     }
 }
 
-void svlImageProcessingHelper::RectificationInternals::Release()
+bool svlImageProcessingHelper::RectificationInternals::SaveRemapTable(const std::string & filepath, unsigned long long key) const
 {
-    if (idxDest) delete [] idxDest;
-    if (idxSrc1) delete [] idxSrc1;
-    if (idxSrc2) delete [] idxSrc2;
-    if (idxSrc3) delete [] idxSrc3;
-    if (idxSrc4) delete [] idxSrc4;
-    if (blendSrc1) delete [] blendSrc1;
-    if (blendSrc2) delete [] blendSrc2;
-    if (blendSrc3) delete [] blendSrc3;
-    if (blendSrc4) delete [] blendSrc4;
+    if (Width < 1 || Height < 1) return false;
 
+    // Written to a temporary file first so other processes never load a partial table
+    const std::string tmppath = filepath + ".tmp";
+    std::ofstream file(tmppath.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!file.is_open()) return false;
+
+    const unsigned int header[5] = { SVL_RECTIFICATION_TABLE_VERSION, Width, Height, TileWidth, TileHeight };
+    const std::streamsize size = static_cast<std::streamsize>(Width) * Height;
+
+    file.write(SVL_RECTIFICATION_TABLE_MAGIC, 8);
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+    file.write(reinterpret_cast<const char*>(OffsetX.Pointer()), size * sizeof(short));
+    file.write(reinterpret_cast<const char*>(OffsetY.Pointer()), size * sizeof(short));
+    file.write(reinterpret_cast<const char*>(FractionX.Pointer()), size);
+    file.write(reinterpret_cast<const char*>(FractionY.Pointer()), size);
+    file.close();
+
+    if (file.fail()) {
+        std::remove(tmppath.c_str());
+        return false;
+    }
+    if (std::rename(tmppath.c_str(), filepath.c_str()) != 0) {
+        // Fails on Windows if the file already exists
+        std::remove(filepath.c_str());
+        if (std::rename(tmppath.c_str(), filepath.c_str()) != 0) {
+            std::remove(tmppath.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool svlImageProcessingHelper::RectificationInternals::LoadRemapTable(const std::string & filepath, unsigned long long key)
+{
+    Release();
+
+    std::ifstream file(filepath.c_str(), std::ios_base::in | std::ios_base::binary);
+    if (!file.is_open()) return false;
+
+    char magic[8];
+    unsigned int header[5];
+    unsigned long long filekey;
+
+    file.read(magic, 8);
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    file.read(reinterpret_cast<char*>(&filekey), sizeof(filekey));
+    if (file.fail() ||
+        memcmp(magic, SVL_RECTIFICATION_TABLE_MAGIC, 8) != 0 ||
+        header[0] != SVL_RECTIFICATION_TABLE_VERSION ||
+        header[1] < 1 || header[1] > 32767 ||
+        header[2] < 1 || header[2] > 32767 ||
+        header[3] != TileWidth || header[4] != TileHeight ||
+        filekey != key) return false;
+
+    const unsigned int size = header[1] * header[2];
+    OffsetX.SetSize(size);
+    OffsetY.SetSize(size);
+    FractionX.SetSize(size);
+    FractionY.SetSize(size);
+    file.read(reinterpret_cast<char*>(OffsetX.Pointer()), static_cast<std::streamsize>(size) * sizeof(short));
+    file.read(reinterpret_cast<char*>(OffsetY.Pointer()), static_cast<std::streamsize>(size) * sizeof(short));
+    file.read(reinterpret_cast<char*>(FractionX.Pointer()), size);
+    file.read(reinterpret_cast<char*>(FractionY.Pointer()), size);
+    if (file.fail()) {
+        Release();
+        return false;
+    }
+
+    Width = header[1];
+    Height = header[2];
+
+    // Corrupted or forged tables would make Remap read outside the source image
+    if (!CheckRemapTable()) {
+        Release();
+        return false;
+    }
+    return true;
+}
+
+bool svlImageProcessingHelper::RectificationInternals::CheckRemapTable() const
+{
+    const int width = static_cast<int>(Width);
+    const int height = static_cast<int>(Height);
+    int tx, ty, tw, th, x, y, x0, y0;
+    unsigned int index = 0;
+
+    // Same order as Remap
+    for (ty = 0; ty < height; ty += TileHeight) {
+        th = std::min(static_cast<int>(TileHeight), height - ty);
+        for (tx = 0; tx < width; tx += TileWidth) {
+            tw = std::min(static_cast<int>(TileWidth), width - tx);
+            for (y = ty; y < ty + th; y ++) {
+                for (x = tx; x < tx + tw; x ++, index ++) {
+                    if (OffsetX[index] == svlImageProcessingSIMD::RemapInvalid) continue;
+                    x0 = x + OffsetX[index];
+                    y0 = y + OffsetY[index];
+                    // The source pixel quad has to be inside the image
+                    if (x0 < 0 || y0 < 0 || x0 + 1 >= width || y0 + 1 >= height) return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void svlImageProcessingHelper::RectificationInternals::BuildRemapTable(const unsigned int* destination, const unsigned int* source,
+                                                                       const unsigned char* fractionx, const unsigned char* fractiony,
+                                                                       const unsigned int count)
+{
+    const unsigned int size = Width * Height;
+    unsigned int i, x, y, x0, y0, tx, ty, index;
+
+    OffsetX.SetSize(size);
+    OffsetY.SetSize(size);
+    FractionX.SetSize(size);
+    FractionY.SetSize(size);
+    OffsetX.SetAll(svlImageProcessingSIMD::RemapInvalid);
+    OffsetY.SetAll(0);
+    FractionX.SetAll(0);
+    FractionY.SetAll(0);
+
+    for (i = 0; i < count; i ++) {
+        if (destination[i] >= size || source[i] >= size) continue;
+
+        x  = destination[i] % Width;
+        y  = destination[i] / Width;
+        x0 = source[i] % Width;
+        y0 = source[i] / Width;
+        // The source pixel quad has to be inside the image
+        if (x0 + 1 >= Width || y0 + 1 >= Height) continue;
+
+        tx = x - x % TileWidth;
+        ty = y - y % TileHeight;
+        index = ty * Width +
+                tx * std::min(static_cast<unsigned int>(TileHeight), Height - ty) +
+                (y - ty) * std::min(static_cast<unsigned int>(TileWidth), Width - tx) +
+                x - tx;
+
+        OffsetX[index] = static_cast<short>(static_cast<int>(x0) - static_cast<int>(x));
+        OffsetY[index] = static_cast<short>(static_cast<int>(y0) - static_cast<int>(y));
+        FractionX[index] = fractionx[i];
+        FractionY[index] = fractiony[i];
+    }
+}
+
+void svlImageProcessingHelper::RectificationInternals::Remap(const unsigned char* input, unsigned char* output, bool interpolation) const
+{
+    const unsigned int rowstride = Width * 3;
+    unsigned int tx, ty, tw, th, y, index = 0;
+
+    // Tiles keep the source and destination pixels of the inner loop in the cache
+    for (ty = 0; ty < Height; ty += TileHeight) {
+        th = std::min(static_cast<unsigned int>(TileHeight), Height - ty);
+        for (tx = 0; tx < Width; tx += TileWidth) {
+            tw = std::min(static_cast<unsigned int>(TileWidth), Width - tx);
+            for (y = ty; y < ty + th; y ++) {
+                svlImageProcessingSIMD::RemapRGB(input, Width, Height,
+                                                 output + y * rowstride + tx * 3, tx, y, tw,
+                                                 OffsetX.Pointer(index), OffsetY.Pointer(index),
+                                                 FractionX.Pointer(index), FractionY.Pointer(index),
+                                                 interpolation);
+                index += tw;
+            }
+        }
+    }
+}
+
+void svlImageProcessingHelper::RectificationInternals::Release()
+{
     Width = 0;
     Height = 0;
-    idxDest = 0;
-    idxDestSize = 0;
-    idxSrc1 = 0;
-    idxSrc1Size = 0;
-    idxSrc2 = 0;
-    idxSrc2Size = 0;
-    idxSrc3 = 0;
-    idxSrc3Size = 0;
-    idxSrc4 = 0;
-    idxSrc4Size = 0;
-    blendSrc1 = 0;
-    blendSrc1Size = 0;
-    blendSrc2 = 0;
-    blendSrc2Size = 0;
-    blendSrc3 = 0;
-    blendSrc3Size = 0;
-    blendSrc4 = 0;
-    blendSrc4Size = 0;
+    OffsetX.SetSize(0);
+    OffsetY.SetSize(0);
+    FractionX.SetSize(0);
+    FractionY.SetSize(0);
 }
 
 
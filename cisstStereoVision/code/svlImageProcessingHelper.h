@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2010
 
-  (C) Copyright 2006-2013 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -133,6 +133,12 @@ namespace svlImageProcessingHelper
     void CISST_EXPORT ConvolutionMono16(unsigned short* input, unsigned short* output, const int width, const int height, vctDynamicMatrix<int> & kernel, bool absres);
     void CISST_EXPORT ConvolutionMono32(unsigned int* input, unsigned int* output, const int width, const int height, vctDynamicMatrix<int> & kernel, bool absres);
 
+    // Returns true if the kernel is the outer product of a vertical and a horizontal kernel
+    bool CISST_EXPORT IsSeparable(const vctDynamicMatrix<double> & kernel, vctDynamicVector<double> & kernel_horiz, vctDynamicVector<double> & kernel_vert);
+    // Two dimensional convolution with the separated kernel in a single pass, results are rounded
+    void CISST_EXPORT ConvolutionSeparable(const unsigned char* input, unsigned char* output, const int width, const int height, const int channels, const vctDynamicVector<double> & kernel_horiz, const vctDynamicVector<double> & kernel_vert, bool absres);
+    void CISST_EXPORT ConvolutionSeparable(const unsigned short* input, unsigned short* output, const int width, const int height, const vctDynamicVector<double> & kernel_horiz, const vctDynamicVector<double> & kernel_vert, bool absres);
+
     //////////////////
     // Unsharp Mask //
     //////////////////
@@ -177,6 +183,9 @@ namespace svlImageProcessingHelper
     class CISST_EXPORT RectificationInternals : public svlImageProcessingInternals
     {
     public:
+        // Size of the tiles of the remap table
+        enum { TileWidth = 64, TileHeight = 16 };
+
         RectificationInternals();
         virtual ~RectificationInternals();
 
@@ -185,30 +194,39 @@ namespace svlImageProcessingHelper
         bool SetFromCameraCalibration(unsigned int height,unsigned int width,vct3x3 R,vct2 f, vct2 c, vctFixedSizeVector<double,7> k, double alpha, unsigned int videoch=0);
         void TransposeLUTArray2(unsigned int* index, unsigned int size, unsigned int width, unsigned int height);
 
+        // Binary copy of the remap table, key identifies the parameters the table was generated from
+        bool SaveRemapTable(const std::string & filepath, unsigned long long key = 0) const;
+        bool LoadRemapTable(const std::string & filepath, unsigned long long key = 0);
+
+        // Rectifies an RGB image of Width x Height pixels, pixels without source are set to black
+        void Remap(const unsigned char* input, unsigned char* output, bool interpolation) const;
+
         unsigned int Width;
         unsigned int Height;
-        unsigned int* idxDest;
-        int idxDestSize;
-        unsigned int* idxSrc1;
-        int idxSrc1Size;
-        unsigned int* idxSrc2;
-        int idxSrc2Size;
-        unsigned int* idxSrc3;
-        int idxSrc3Size;
-        unsigned int* idxSrc4;
-        int idxSrc4Size;
-        unsigned char* blendSrc1;
-        int blendSrc1Size;
-        unsigned char* blendSrc2;
-        int blendSrc2Size;
-        unsigned char* blendSrc3;
-        int blendSrc3Size;
-        unsigned char* blendSrc4;
-        int blendSrc4Size;
+
+        // If not empty, SetFromCameraCalibration loads the table from this
+        // directory if it has been generated before with the same parameters
+        // and saves it there otherwise
+        std::string CacheDirectory;
+
+        // Remap table in tile order (TileWidth x TileHeight tiles, row by
+        // row, pixels row by row in each tile): top-left source pixel
+        // relative to the destination pixel (svlImageProcessingSIMD::RemapInvalid
+        // if there is no source pixel) and position in the source pixel
+        // quad in 1/256 pixels
+        vctDynamicVector<short> OffsetX;
+        vctDynamicVector<short> OffsetY;
+        vctDynamicVector<unsigned char> FractionX;
+        vctDynamicVector<unsigned char> FractionY;
 
     protected:
         int LoadLine(std::ifstream &file, double* dblbuf, char* chbuf, unsigned int size, int explen);
         void TransposeLUTArray(unsigned int* index, unsigned int size, unsigned int width, unsigned int height);
+        // Destination and source pixel indices are y * Width + x
+        void BuildRemapTable(const unsigned int* destination, const unsigned int* source,
+                             const unsigned char* fractionx, const unsigned char* fractiony, const unsigned int count);
+        // True if all source pixel quads of the remap table are inside the image
+        bool CheckRemapTable() const;
         void Release();
     };
 
@@ -0,0 +1,554 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include "svlImageProcessingSIMD.h"
+#include "svlConvertersSIMD.h"
+#include <algorithm>
+
+
+/*****************************/
+/*** Scalar implementation ***/
+/*****************************/
+
+template <class _inputType>
+static inline void svlImageProcessingMultiplyAccumulate(const _inputType* input, int* accumulator, const int count, const int coefficient)
+{
+    for (int i = 0; i < count; i ++) {
+        accumulator[i] += static_cast<int>(input[i]) * coefficient;
+    }
+}
+
+static inline void svlImageProcessingShiftRight(int* values, const int count, const int shift)
+{
+    for (int i = 0; i < count; i ++) {
+        values[i] >>= shift;
+    }
+}
+
+template <class _outputType, int _maxValue>
+static inline void svlImageProcessingShiftAndSaturate(const int* accumulator, _outputType* output, const int count, const int shift, const bool absres)
+{
+    int i, value;
+    if (absres) {
+        for (i = 0; i < count; i ++) {
+            value = accumulator[i] >> shift;
+            if (value < 0) value = -value;
+            if (value > _maxValue) value = _maxValue;
+            output[i] = static_cast<_outputType>(value);
+        }
+    }
+    else {
+        for (i = 0; i < count; i ++) {
+            value = accumulator[i] >> shift;
+            if (value < 0) value = 0;
+            else if (value > _maxValue) value = _maxValue;
+            output[i] = static_cast<_outputType>(value);
+        }
+    }
+}
+
+static inline void svlImageProcessingRemapRGB(const unsigned char* input, const int width,
+                                              unsigned char* output, const int x, const int y, const int count,
+                                              const short* offsetx, const short* offsety,
+                                              const unsigned char* fractionx, const unsigned char* fractiony,
+                                              const bool interpolation)
+{
+    const int rowstride = width * 3;
+    const unsigned char* src;
+    int i, fx, fy, w00, w01, w10, w11;
+
+    for (i = 0; i < count; i ++) {
+        if (offsetx[i] == svlImageProcessingSIMD::RemapInvalid) {
+            output[0] = output[1] = output[2] = 0;
+        }
+        else {
+            src = input + (y + offsety[i]) * rowstride + (x + i + offsetx[i]) * 3;
+            if (interpolation) {
+                fx = fractionx[i];
+                fy = fractiony[i];
+                w00 = (256 - fx) * (256 - fy);
+                w01 = fx * (256 - fy);
+                w10 = (256 - fx) * fy;
+                w11 = fx * fy;
+                output[0] = static_cast<unsigned char>((src[0] * w00 + src[3] * w01 + src[rowstride    ] * w10 + src[rowstride + 3] * w11 + 32768) >> 16);
+                output[1] = static_cast<unsigned char>((src[1] * w00 + src[4] * w01 + src[rowstride + 1] * w10 + src[rowstride + 4] * w11 + 32768) >> 16);
+                output[2] = static_cast<unsigned char>((src[2] * w00 + src[5] * w01 + src[rowstride + 2] * w10 + src[rowstride + 5] * w11 + 32768) >> 16);
+            }
+            else {
+                output[0] = src[0];
+                output[1] = src[1];
+                output[2] = src[2];
+            }
+        }
+        output += 3;
+    }
+}
+
+
+static inline void svlImageProcessingCensusUpdate(const unsigned short* center, const unsigned short* neighbor, unsigned int* census, const int count)
+{
+    for (int i = 0; i < count; i ++) {
+        census[i] = (census[i] << 1) | (neighbor[i] < center[i] ? 1 : 0);
+    }
+}
+
+static inline void svlImageProcessingCensusCost(const unsigned int reference, const unsigned int* match, unsigned short* cost, const int count)
+{
+    unsigned int bits;
+    for (int i = 0; i < count; i ++) {
+        // Number of differing bits
+        bits = reference ^ match[i];
+        bits = bits - ((bits >> 1) & 0x55555555);
+        bits = (bits & 0x33333333) + ((bits >> 2) & 0x33333333);
+        cost[i] = static_cast<unsigned short>((((bits + (bits >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24);
+    }
+}
+
+static inline int svlImageProcessingAggregateCost(const unsigned short* cost, const unsigned short* previous, const int previousmin,
+                                                  unsigned short* current, unsigned short* sum, const int count,
+                                                  const int p1, const int p2, int minimum)
+{
+    const int jump = previousmin + p2;
+    int i, value, neighbor;
+    for (i = 0; i < count; i ++) {
+        value = previous[i];
+        neighbor = std::min(previous[i - 1], previous[i + 1]) + p1;
+        if (value > neighbor) value = neighbor;
+        if (value > jump) value = jump;
+        value += cost[i] - previousmin;
+        current[i] = static_cast<unsigned short>(value);
+        if (value < minimum) minimum = value;
+        value += sum[i];
+        sum[i] = static_cast<unsigned short>(std::min(value, 65535));
+    }
+    return minimum;
+}
+
+static inline void svlImageProcessingFindMinimum(const unsigned short* values, const int from, const int count, int& minimum, int& index)
+{
+    for (int i = from; i < count; i ++) {
+        if (values[i] < minimum) {
+            minimum = values[i];
+            index = i;
+        }
+    }
+}
+
+#ifdef SVL_CONVERTER_AVX2
+
+/***************************/
+/*** AVX2 implementation ***/
+/***************************/
+
+// See svlConvertersSIMD.cpp
+#if defined(__clang__)
+    #pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+    #pragma GCC push_options
+    #pragma GCC target("avx2")
+#endif
+
+namespace svlImageProcessingAVX2
+{
+    // Each function returns the number of elements processed, the
+    // caller processes the remaining elements
+
+    int MultiplyAccumulate(const unsigned char* input, int* accumulator, const int count, const int coefficient)
+    {
+        const __m256i coef = _mm256_set1_epi32(coefficient);
+        const int end = count - count % 8;
+        __m256i* acc;
+        for (int i = 0; i < end; i += 8) {
+            acc = reinterpret_cast<__m256i*>(accumulator + i);
+            _mm256_storeu_si256(acc,
+                                _mm256_add_epi32(_mm256_loadu_si256(acc),
+                                                 _mm256_mullo_epi32(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input + i))), coef)));
+        }
+        return end;
+    }
+
+    int MultiplyAccumulate(const unsigned short* input, int* accumulator, const int count, const int coefficient)
+    {
+        const __m256i coef = _mm256_set1_epi32(coefficient);
+        const int end = count - count % 8;
+        __m256i* acc;
+        for (int i = 0; i < end; i += 8) {
+            acc = reinterpret_cast<__m256i*>(accumulator + i);
+            _mm256_storeu_si256(acc,
+                                _mm256_add_epi32(_mm256_loadu_si256(acc),
+                                                 _mm256_mullo_epi32(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i))), coef)));
+        }
+        return end;
+    }
+
+    int MultiplyAccumulate(const int* input, int* accumulator, const int count, const int coefficient)
+    {
+        const __m256i coef = _mm256_set1_epi32(coefficient);
+        const int end = count - count % 8;
+        __m256i* acc;
+        for (int i = 0; i < end; i += 8) {
+            acc = reinterpret_cast<__m256i*>(accumulator + i);
+            _mm256_storeu_si256(acc,
+                                _mm256_add_epi32(_mm256_loadu_si256(acc),
+                                                 _mm256_mullo_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i)), coef)));
+        }
+        return end;
+    }
+
+    int ShiftRight(int* values, const int count, const int shift)
+    {
+        const __m128i shiftv = _mm_cvtsi32_si128(shift);
+        const int end = count - count % 8;
+        __m256i* val;
+        for (int i = 0; i < end; i += 8) {
+            val = reinterpret_cast<__m256i*>(values + i);
+            _mm256_storeu_si256(val, _mm256_sra_epi32(_mm256_loadu_si256(val), shiftv));
+        }
+        return end;
+    }
+
+    // Interpolates one channel of 8 pixels stored in 32 bit lanes
+    static inline __m256i RemapChannel(const __m256i p00, const __m256i p01, const __m256i p10, const __m256i p11,
+                                       const __m256i w00, const __m256i w01, const __m256i w10, const __m256i w11,
+                                       const int shift)
+    {
+        const __m256i mask = _mm256_set1_epi32(0xFF);
+        __m256i sum = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_and_si256(_mm256_srli_epi32(p00, shift), mask), w00),
+                                       _mm256_mullo_epi32(_mm256_and_si256(_mm256_srli_epi32(p01, shift), mask), w01));
+        sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(_mm256_and_si256(_mm256_srli_epi32(p10, shift), mask), w10));
+        sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(_mm256_and_si256(_mm256_srli_epi32(p11, shift), mask), w11));
+        return _mm256_srli_epi32(_mm256_add_epi32(sum, _mm256_set1_epi32(32768)), 16);
+    }
+
+    int RemapRGB(const unsigned char* input, const int width, const int height,
+                 unsigned char* output, const int x, const int y, const int count,
+                 const short* offsetx, const short* offsety,
+                 const unsigned char* fractionx, const unsigned char* fractiony,
+                 const bool interpolation)
+    {
+        if (!interpolation) return 0;
+
+        const int rowstride = width * 3;
+        const int* base00 = reinterpret_cast<const int*>(input);
+        const int* base01 = reinterpret_cast<const int*>(input + 3);
+        const int* base10 = reinterpret_cast<const int*>(input + rowstride);
+        const int* base11 = reinterpret_cast<const int*>(input + rowstride + 3);
+        // The 4 byte loads of the last source pixel would read past the
+        // end of the image, these pixels are left to the scalar code
+        const __m256i limit = _mm256_set1_epi32(rowstride * height - rowstride - 7);
+        const __m256i invalid = _mm256_set1_epi32(svlImageProcessingSIMD::RemapInvalid);
+        const __m256i stride = _mm256_set1_epi32(rowstride);
+        const __m256i full = _mm256_set1_epi32(256);
+        const __m256i posy = _mm256_set1_epi32(y);
+        // Packs the 3 bytes of each 32 bit lane in the lower 24 bytes
+        const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                                                 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+        const __m256i permute = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+        __m256i posx = _mm256_setr_epi32(x, x + 1, x + 2, x + 3, x + 4, x + 5, x + 6, x + 7);
+        __m256i dx, dy, skip, offset, fx, fy, ifx, ify, w00, w01, w10, w11, p00, p01, p10, p11, result;
+        int i;
+
+        for (i = 0; i + 8 <= count; i += 8, posx = _mm256_add_epi32(posx, _mm256_set1_epi32(8))) {
+            dx = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(offsetx + i)));
+            dy = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(offsety + i)));
+            skip = _mm256_cmpeq_epi32(dx, invalid);
+
+            // Byte offset of the source quads, 0 for invalid pixels
+            dx = _mm256_add_epi32(posx, dx);
+            offset = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_add_epi32(posy, dy), stride),
+                                      _mm256_add_epi32(dx, _mm256_add_epi32(dx, dx)));
+            offset = _mm256_andnot_si256(skip, offset);
+            if (_mm256_movemask_epi8(_mm256_cmpgt_epi32(offset, limit))) break;
+
+            // Bilinear weights summing up to 65536, 0 for invalid pixels
+            fx = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(fractionx + i)));
+            fy = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(fractiony + i)));
+            ifx = _mm256_sub_epi32(full, fx);
+            ify = _mm256_andnot_si256(skip, _mm256_sub_epi32(full, fy));
+            fy = _mm256_andnot_si256(skip, fy);
+            w00 = _mm256_mullo_epi32(ifx, ify);
+            w01 = _mm256_mullo_epi32(fx, ify);
+            w10 = _mm256_mullo_epi32(ifx, fy);
+            w11 = _mm256_mullo_epi32(fx, fy);
+
+            p00 = _mm256_i32gather_epi32(base00, offset, 1);
+            p01 = _mm256_i32gather_epi32(base01, offset, 1);
+            p10 = _mm256_i32gather_epi32(base10, offset, 1);
+            p11 = _mm256_i32gather_epi32(base11, offset, 1);
+
+            result = _mm256_or_si256(RemapChannel(p00, p01, p10, p11, w00, w01, w10, w11, 0),
+                     _mm256_or_si256(_mm256_slli_epi32(RemapChannel(p00, p01, p10, p11, w00, w01, w10, w11, 8), 8),
+                                     _mm256_slli_epi32(RemapChannel(p00, p01, p10, p11, w00, w01, w10, w11, 16), 16)));
+            result = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(result, shuffle), permute);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm256_castsi256_si128(result));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(output + 16), _mm256_extracti128_si256(result, 1));
+            output += 24;
+        }
+        return i;
+    }
+
+    // Shifts 16 values, packs them to 16 bits with signed saturation
+    // (unsigned for 16 bit outputs) in the original order
+    static inline __m256i ShiftAndPack(const int* accumulator, const __m128i shift, const bool absres, const bool pack_unsigned)
+    {
+        __m256i a = _mm256_sra_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(accumulator)), shift);
+        __m256i b = _mm256_sra_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(accumulator + 8)), shift);
+        if (absres) {
+            a = _mm256_abs_epi32(a);
+            b = _mm256_abs_epi32(b);
+        }
+        // Packs operate within each 128 bit lane
+        if (pack_unsigned) return _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b), 0xD8);
+        return _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+    }
+
+    int ShiftAndSaturate(const int* accumulator, unsigned char* output, const int count, const int shift, const bool absres)
+    {
+        const __m128i shiftv = _mm_cvtsi32_si128(shift);
+        const int end = count - count % 16;
+        __m256i values;
+        for (int i = 0; i < end; i += 16) {
+            values = ShiftAndPack(accumulator + i, shiftv, absres, false);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),
+                             _mm_packus_epi16(_mm256_castsi256_si128(values), _mm256_extracti128_si256(values, 1)));
+        }
+        return end;
+    }
+
+    int ShiftAndSaturate(const int* accumulator, unsigned short* output, const int count, const int shift, const bool absres)
+    {
+        const __m128i shiftv = _mm_cvtsi32_si128(shift);
+        const int end = count - count % 16;
+        for (int i = 0; i < end; i += 16) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), ShiftAndPack(accumulator + i, shiftv, absres, true));
+        }
+        return end;
+    }
+
+    int CensusUpdate(const unsigned short* center, const unsigned short* neighbor, unsigned int* census, const int count)
+    {
+        const __m256i one = _mm256_set1_epi32(1);
+        const int end = count - count % 8;
+        __m256i c, n, *dest;
+        for (int i = 0; i < end; i += 8) {
+            c = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(center + i)));
+            n = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(neighbor + i)));
+            dest = reinterpret_cast<__m256i*>(census + i);
+            _mm256_storeu_si256(dest, _mm256_or_si256(_mm256_slli_epi32(_mm256_loadu_si256(dest), 1),
+                                                      _mm256_and_si256(_mm256_cmpgt_epi32(c, n), one)));
+        }
+        return end;
+    }
+
+    int CensusCost(const unsigned int reference, const unsigned int* match, unsigned short* cost, const int count)
+    {
+        // Bit counts of the 4 bit nibbles
+        const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                             0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i low = _mm256_set1_epi8(0x0F);
+        const __m256i ones8 = _mm256_set1_epi8(1);
+        const __m256i ones16 = _mm256_set1_epi16(1);
+        const __m256i ref = _mm256_set1_epi32(static_cast<int>(reference));
+        const int end = count - count % 16;
+        __m256i bits, counts[2];
+        int i, j;
+
+        for (i = 0; i < end; i += 16) {
+            for (j = 0; j < 2; j ++) {
+                bits = _mm256_xor_si256(ref, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(match + i + j * 8)));
+                bits = _mm256_add_epi8(_mm256_shuffle_epi8(lut, _mm256_and_si256(bits, low)),
+                                       _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(bits, 4), low)));
+                counts[j] = _mm256_madd_epi16(_mm256_maddubs_epi16(bits, ones8), ones16);
+            }
+            // Packs operate within each 128 bit lane
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(cost + i),
+                                _mm256_permute4x64_epi64(_mm256_packs_epi32(counts[0], counts[1]), 0xD8));
+        }
+        return end;
+    }
+
+    static inline int HorizontalMinimum(const __m256i values)
+    {
+        return _mm_cvtsi128_si32(_mm_minpos_epu16(_mm_min_epu16(_mm256_castsi256_si128(values),
+                                                                _mm256_extracti128_si256(values, 1)))) & 0xFFFF;
+    }
+
+    int AggregateCost(const unsigned short* cost, const unsigned short* previous, const int previousmin,
+                      unsigned short* current, unsigned short* sum, const int count,
+                      const int p1, const int p2, int& minimum)
+    {
+        const __m256i penalty1 = _mm256_set1_epi16(static_cast<short>(p1));
+        const __m256i jump = _mm256_set1_epi16(static_cast<short>(previousmin + p2));
+        const __m256i offset = _mm256_set1_epi16(static_cast<short>(previousmin));
+        const int end = count - count % 16;
+        __m256i value, neighbor, minv = _mm256_set1_epi16(-1);
+        __m256i* dest;
+
+        for (int i = 0; i < end; i += 16) {
+            neighbor = _mm256_min_epu16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(previous + i - 1)),
+                                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(previous + i + 1)));
+            value = _mm256_min_epu16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(previous + i)),
+                                     _mm256_adds_epu16(neighbor, penalty1));
+            value = _mm256_min_epu16(value, jump);
+            value = _mm256_add_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(cost + i)),
+                                     _mm256_sub_epi16(value, offset));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(current + i), value);
+            minv = _mm256_min_epu16(minv, value);
+            dest = reinterpret_cast<__m256i*>(sum + i);
+            _mm256_storeu_si256(dest, _mm256_adds_epu16(_mm256_loadu_si256(dest), value));
+        }
+        if (end > 0) minimum = std::min(minimum, HorizontalMinimum(minv));
+        return end;
+    }
+
+    int FindMinimum(const unsigned short* values, const int count, int& minimum, int& index)
+    {
+        const int end = count - count % 16;
+        if (end == 0) return 0;
+
+        __m256i minv = _mm256_set1_epi16(-1);
+        int i, mask;
+        for (i = 0; i < end; i += 16) {
+            minv = _mm256_min_epu16(minv, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+        }
+        const int value = HorizontalMinimum(minv);
+        if (value >= minimum) return end;
+
+        // First position of the minimum
+        minv = _mm256_set1_epi16(static_cast<short>(value));
+        for (i = 0; i < end; i += 16) {
+            mask = _mm256_movemask_epi8(_mm256_cmpeq_epi16(minv, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i))));
+            if (mask) {
+                minimum = value;
+                for (index = i; (mask & 1) == 0; mask >>= 2) index ++;
+                break;
+            }
+        }
+        return end;
+    }
+}
+
+#if defined(__clang__)
+    #pragma clang attribute pop
+#elif defined(__GNUC__)
+    #pragma GCC pop_options
+#endif
+
+#define SVL_IMAGE_PROCESSING_AVX2(function) \
+    if (svlConverterSIMD::GetInstructionSet() == svlConverter::SIMDAVX2) { \
+        done = svlImageProcessingAVX2::function; \
+    }
+
+#else // SVL_CONVERTER_AVX2
+
+#define SVL_IMAGE_PROCESSING_AVX2(function)
+
+#endif // SVL_CONVERTER_AVX2
+
+
+/*******************************************/
+/*** svlImageProcessingSIMD namespace ******/
+/*******************************************/
+
+void svlImageProcessingSIMD::MultiplyAccumulate(const unsigned char* input, int* accumulator, const int count, const int coefficient)
+{
+    int done = 0;
+    SVL_IMAGE_PROCESSING_AVX2(MultiplyAccumulate(input, accumulator, count, coefficient));
+    svlImageProcessingMultiplyAccumulate(input + done, accumulator + done, count - done, coefficient);
+}
+
+void svlImageProcessingSIMD::MultiplyAccumulate(const unsigned short* input, int* accumulator, const int count, const int coefficient)
+{
+    int done = 0;
+    SVL_IMAGE_PROCESSING_AVX2(MultiplyAccumulate(input, accumulator, count, coefficient));
+    svlImageProcessingMultiplyAccumulate(input + done, accumulator + done, count - done, coefficient);
+}
+
+void svlImageProcessingSIMD::MultiplyAccumulate(const int* input, int* accumulator, const int count, const int coefficient)
+{
+    int done = 0;
+    SVL_IMAGE_PROCESSING_AVX2(MultiplyAccumulate(input, accumulator, count, coefficient));
+    svlImageProcessingMultiplyAccumulate(input + done, accumulator + done, count - done, coefficient);
+}
+
+void svlImageProcessingSIMD::ShiftRight(int* values, const int count, const int shift)
+{
+    int done = 0;
+    SVL_IMAGE_PROCESSING_AVX2(ShiftRight(values, count, shift));
+    svlImageProcessingShiftRight(values + done, count - done, shift);
+}
+
+void svlImageProcessingSIMD::ShiftAndSaturate(const int* accumulator, unsigned char* output, const int count, const int shift, const bool absres)
+{
+    int done = 0;
+    SVL_IMAGE_PROCESSING_AVX2(ShiftAndSaturate(accumulator, output, count, shift, absres));
+    svlImageProcessingShiftAndSaturate<unsigned char, 255>(accumulator + done, output + done, count - done, shift, absres);
+}
+
+void svlImageProcessingSIMD::ShiftAndSaturate(const int* accumulator, unsigned short* output, const int count, const int shift, const bool absres)
+{
+    int done = 0;
+    SVL_IMAGE_PROCESSING_AVX2(ShiftAndSaturate(accumulator, output, count, shift, absres));
+    svlImageProcessingShiftAndSaturate<unsigned short, 65535>(accumulator + done, output + done, count - done, shift, absres);
+}
+
+void svlImageProcessingSIMD::RemapRGB(const unsigned char* input, const int width, const int height,
+                                      unsigned char* output, const int x, const int y, const int count,
+                                      const short* offsetx, const short* offsety,
+                                      const unsigned char* fractionx, const unsigned char* fractiony,
+                                      const bool interpolation)
+{
+    int done = 0;
+    SVL_IMAGE_PROCESSING_AVX2(RemapRGB(input, width, height, output, x, y, count, offsetx, offsety, fractionx, fractiony, interpolation));
+    svlImageProcessingRemapRGB(input, width, output + done * 3, x + done, y, count - done,
+                               offsetx + done, offsety + done, fractionx + done, fractiony + done, interpolation);
+}
+
+void svlImageProcessingSIMD::CensusUpdate(const unsigned short* center, const unsigned short* neighbor, unsigned int* census, const int count)
+{
+    int done = 0;
+    SVL_IMAGE_PROCESSING_AVX2(CensusUpdate(center, neighbor, census, count));
+    svlImageProcessingCensusUpdate(center + done, neighbor + done, census + done, count - done);
+}
+
+void svlImageProcessingSIMD::CensusCost(const unsigned int reference, const unsigned int* match, unsigned short* cost, const int count)
+{
+    int done = 0;
+    SVL_IMAGE_PROCESSING_AVX2(CensusCost(reference, match, cost, count));
+    svlImageProcessingCensusCost(reference, match + done, cost + done, count - done);
+}
+
+int svlImageProcessingSIMD::AggregateCost(const unsigned short* cost, const unsigned short* previous, const int previousmin,
+                                          unsigned short* current, unsigned short* sum, const int count,
+                                          const int p1, const int p2)
+{
+    int done = 0, minimum = 0xFFFF;
+    SVL_IMAGE_PROCESSING_AVX2(AggregateCost(cost, previous, previousmin, current, sum, count, p1, p2, minimum));
+    return svlImageProcessingAggregateCost(cost + done, previous + done, previousmin, current + done, sum + done,
+                                           count - done, p1, p2, minimum);
+}
+
+int svlImageProcessingSIMD::FindMinimum(const unsigned short* values, const int count)
+{
+    int done = 0, minimum = 0x10000, index = 0;
+    SVL_IMAGE_PROCESSING_AVX2(FindMinimum(values, count, minimum, index));
+    svlImageProcessingFindMinimum(values, done, count, minimum, index);
+    return index;
+}
@@ -0,0 +1,87 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#ifndef _svlImageProcessingSIMD_h
+#define _svlImageProcessingSIMD_h
+
+
+/*
+  Row operations used by the separable convolutions and the
+  rectification in svlImageProcessingHelper and by the semi-global
+  matching in svlStereoSGM.  AVX2 versions are used when available
+  (see svlConverter::SetSIMDInstructionSet), scalar code otherwise.
+  Results do not depend on the instruction set.
+*/
+namespace svlImageProcessingSIMD
+{
+    // accumulator[i] += input[i] * coefficient
+    void MultiplyAccumulate(const unsigned char* input, int* accumulator, const int count, const int coefficient);
+    void MultiplyAccumulate(const unsigned short* input, int* accumulator, const int count, const int coefficient);
+    void MultiplyAccumulate(const int* input, int* accumulator, const int count, const int coefficient);
+
+    // values[i] >>= shift
+    void ShiftRight(int* values, const int count, const int shift);
+
+    // output[i] = accumulator[i] >> shift, absolute value if absres is
+    // true, saturated to the output range
+    void ShiftAndSaturate(const int* accumulator, unsigned char* output, const int count, const int shift, const bool absres);
+    void ShiftAndSaturate(const int* accumulator, unsigned short* output, const int count, const int shift, const bool absres);
+
+    // Offset of the output pixels without source pixel in RemapRGB
+    const short RemapInvalid = -32768;
+
+    // Rectifies the count RGB pixels of the output row segment starting at
+    // (x, y): output pixel i is interpolated from the source pixel quad
+    // starting at (x + i + offsetx[i], y + offsety[i]) with the weights
+    // fractionx[i] / 256 and fractiony[i] / 256, or copied from that pixel
+    // if interpolation is false.  The source quads have to be inside the
+    // width x height input image.
+    void RemapRGB(const unsigned char* input, const int width, const int height,
+                  unsigned char* output, const int x, const int y, const int count,
+                  const short* offsetx, const short* offsety,
+                  const unsigned char* fractionx, const unsigned char* fractiony,
+                  const bool interpolation);
+
+    // census[i] = (census[i] << 1) | (neighbor[i] < center[i])
+    void CensusUpdate(const unsigned short* center, const unsigned short* neighbor, unsigned int* census, const int count);
+
+    // cost[i] = number of bits differing between reference and match[i]
+    void CensusCost(const unsigned int reference, const unsigned int* match, unsigned short* cost, const int count);
+
+    // Semi-global matching cost aggregation along a path, for one pixel:
+    //   current[d] = cost[d] - previousmin + min(previous[d],
+    //                                            previous[d - 1] + p1,
+    //                                            previous[d + 1] + p1,
+    //                                            previousmin + p2)
+    //   sum[d] += current[d]  (saturated)
+    // where previous holds the aggregated costs of the previous pixel on
+    // the path and previousmin their minimum.  previous[-1] and
+    // previous[count] have to be readable and larger than any other
+    // value.  Returns the minimum of current.
+    int AggregateCost(const unsigned short* cost, const unsigned short* previous, const int previousmin,
+                      unsigned short* current, unsigned short* sum, const int count,
+                      const int p1, const int p2);
+
+    // Returns the index of the first minimum
+    int FindMinimum(const unsigned short* values, const int count);
+}
+
+#endif // _svlImageProcessingSIMD_h
+
@@ -0,0 +1,418 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include "svlStereoSGM.h"
+#include "svlImageProcessingSIMD.h"
+#include <cisstStereoVision/svlProcInfo.h>
+#include <cisstStereoVision/svlSyncPoint.h>
+
+// Number of rows processed above each band to initialize the paths
+// coming from above
+#define SVL_SGM_BAND_OVERLAP    24
+// Cost of the disparities matching outside of the left image (census
+// transforms have 24 bits)
+#define SVL_SGM_INVALID_COST    24
+#define SVL_SGM_PATH_SENTINEL   0xFFFF
+
+
+/******************************************/
+/*** svlStereoSGM class *******************/
+/******************************************/
+
+// *******************************************************************
+// svlStereoSGM::svlStereoSGM constructor
+// arguments:
+//           width              - width of input and output images
+//           height             - height of input and output images
+//           roi                - region of interest (where computation will be performed)
+//           mindisparity       - minimum disparity
+//           maxdisparity       - maximum disparity
+//           ppoffset           - horizontal principal point difference (from stereo calibration)
+//           smoothness         - penalty of disparity changes (the higher the smoother)
+//           subpixelprecision  - subpixel disparities on/off
+// *******************************************************************
+svlStereoSGM::svlStereoSGM(int width, int height,
+                           const svlRect & roi,
+                           int mindisparity, int maxdisparity,
+                           int ppoffset,
+                           int smoothness,
+                           bool subpixelprecision) :
+    svlComputationalStereoMethodBase(),
+    Width(width),
+    Height(height),
+    ROI(roi),
+    DisparityOffset(mindisparity + ppoffset),
+    DisparityRange(std::max(maxdisparity - mindisparity, 1)),
+    SubpixelPrecision(subpixelprecision)
+{
+    // Processing the whole image if the region of interest is empty
+    if (ROI.right <= ROI.left || ROI.bottom <= ROI.top) {
+        ROI.Assign(0, 0, width - 1, height - 1);
+    }
+
+    // Disparity range padded to full SIMD registers, each block of
+    // aggregated costs has a sentinel on each side
+    PaddedRange = (DisparityRange + 15) & ~15;
+    BlockStride = PaddedRange + 2;
+
+    // Penalties for 1 pixel and larger disparity changes
+    Penalty1 = std::max(smoothness, 1);
+    Penalty2 = std::min(Penalty1 * 8, 4096);
+}
+
+// *******************************************************************
+// svlStereoSGM::~svlStereoSGM destructor
+// arguments:
+// *******************************************************************
+svlStereoSGM::~svlStereoSGM()
+{
+    Free();
+}
+
+// *******************************************************************
+// svlStereoSGM::Initialize method
+// arguments:
+// function:
+//    To be called once before starting processing.
+//    Allocates the census images, per thread buffers are allocated
+//    on the first frame.
+// *******************************************************************
+int svlStereoSGM::Initialize()
+{
+    Free();
+
+    if (Width < 5 || Height < 5) return -1;
+
+    Intensity[SVL_LEFT].SetSize(Height, Width);
+    Intensity[SVL_RIGHT].SetSize(Height, Width);
+    Census[SVL_LEFT].SetSize(Height, Width);
+    Census[SVL_RIGHT].SetSize(Height, Width);
+
+    return 0;
+}
+
+// *******************************************************************
+// svlStereoSGM::Process method
+// arguments:
+//           images         - input image pair (non-padded)
+//           disparitymap   - output image pointer (non-padded, int32)
+// function:
+//    Computes the disparity map in the calling thread
+// *******************************************************************
+int svlStereoSGM::Process(svlSampleImage *images, int *disparitymap)
+{
+    svlProcInfo procinfo;
+    procinfo.count = 1;
+    procinfo.ID = 0;
+    procinfo.sync = 0;
+    procinfo.cs = 0;
+    return ProcessMT(&procinfo, images, disparitymap);
+}
+
+// *******************************************************************
+// svlStereoSGM::ProcessMT method
+// arguments:
+//           procInfo       - stream thread information
+//           images         - input image pair (non-padded)
+//           disparitymap   - output image pointer (non-padded, int32)
+// function:
+//    To be called once for each frame from all stream threads.
+//    Computes disparity map from the input image pair
+// *******************************************************************
+int svlStereoSGM::ProcessMT(svlProcInfo *procInfo, svlSampleImage *images, int *disparitymap)
+{
+    if (images->GetVideoChannels() != 2 ||
+        static_cast<int>(images->GetWidth(SVL_LEFT)) != Width ||
+        static_cast<int>(images->GetHeight(SVL_LEFT)) != Height)
+        return -1;
+
+    unsigned int from, to;
+
+    // Thread buffers are only used after the first synchronization
+    if (procInfo->ID == 0 && Buffers.size() != procInfo->count) AllocateThreadBuffers(procInfo->count);
+
+    // Census transforms
+    _GetParallelSubRange(procInfo, static_cast<unsigned int>(Height), from, to);
+    ComputeIntensity(images, from, to);
+
+    // Clearing the pixels outside of the region of interest
+    for (int y = from; y < static_cast<int>(to); y ++) {
+        int *output = disparitymap + y * Width;
+        if (y < ROI.top || y > ROI.bottom) {
+            memset(output, 0, Width * sizeof(int));
+        }
+        else {
+            memset(output, 0, ROI.left * sizeof(int));
+            memset(output + ROI.right + 1, 0, (Width - ROI.right - 1) * sizeof(int));
+        }
+    }
+
+    _SynchronizeThreads(procInfo);
+
+    ComputeCensus(from, to);
+
+    _SynchronizeThreads(procInfo);
+
+    // Semi-global matching on bands of the region of interest
+    _GetParallelSubRange(procInfo, static_cast<unsigned int>(ROI.bottom - ROI.top + 1), from, to);
+    if (from < to) ProcessRows(Buffers[procInfo->ID], ROI.top + from, ROI.top + to, disparitymap);
+
+    return 0;
+}
+
+// *******************************************************************
+// svlStereoSGM::Free method
+// arguments:
+// function:
+//    To be called after finishing processing. Destructor calls it too, just in case.
+//    Releases all resources allocated in the Initialize function
+// *******************************************************************
+void svlStereoSGM::Free()
+{
+    Intensity[SVL_LEFT].SetSize(0, 0);
+    Intensity[SVL_RIGHT].SetSize(0, 0);
+    Census[SVL_LEFT].SetSize(0, 0);
+    Census[SVL_RIGHT].SetSize(0, 0);
+    Buffers.clear();
+}
+
+// *******************************************************************
+// svlStereoSGM::AllocateThreadBuffers PRIVATE method
+// arguments:
+//           count          - number of threads
+// *******************************************************************
+void svlStereoSGM::AllocateThreadBuffers(const unsigned int count)
+{
+    Buffers.resize(count);
+    for (unsigned int i = 0; i < count; i ++) {
+        ThreadBuffers & buffers = Buffers[i];
+        buffers.Cost.SetSize(Width * PaddedRange);
+        buffers.Sum.SetSize(Width * PaddedRange);
+        buffers.Path[0].SetSize(3 * (Width + 2) * BlockStride);
+        buffers.Path[1].SetSize(3 * (Width + 2) * BlockStride);
+        buffers.PathMin[0].SetSize(3 * (Width + 2));
+        buffers.PathMin[1].SetSize(3 * (Width + 2));
+        buffers.RowPath.SetSize(2 * BlockStride);
+    }
+}
+
+// *******************************************************************
+// svlStereoSGM::ComputeIntensity PRIVATE method
+// arguments:
+//           images         - input image pair
+//           from, to       - range of rows to be processed
+// *******************************************************************
+void svlStereoSGM::ComputeIntensity(svlSampleImage *images, const int from, const int to)
+{
+    for (unsigned int vch = 0; vch < 2; vch ++) {
+        if (images->GetDataChannels() == 3) {
+            ComputeIntensity<unsigned char, 3>(images->GetUCharPointer(vch), Intensity[vch].Pointer(), from, to);
+        }
+        else if (images->GetBPP() == 2) {
+            ComputeIntensity<unsigned short, 1>(reinterpret_cast<unsigned short*>(images->GetUCharPointer(vch)), Intensity[vch].Pointer(), from, to);
+        }
+        else {
+            ComputeIntensity<unsigned char, 1>(images->GetUCharPointer(vch), Intensity[vch].Pointer(), from, to);
+        }
+    }
+}
+
+// *******************************************************************
+// svlStereoSGM::ComputeCensus PRIVATE method
+// arguments:
+//           from, to       - range of rows to be processed
+// function:
+//    Computes the 5x5 census transform (24 bits) of the rows.  Pixels
+//    closer than 2 pixels to the border are set to 0.
+// *******************************************************************
+void svlStereoSGM::ComputeCensus(const int from, const int to)
+{
+    const unsigned short *center;
+    unsigned int *output;
+    int i, j, y;
+
+    for (unsigned int vch = 0; vch < 2; vch ++) {
+        for (y = from; y < to; y ++) {
+            output = Census[vch].Pointer(y, 0);
+            memset(output, 0, Width * sizeof(unsigned int));
+            if (y < 2 || y >= Height - 2) continue;
+
+            // One neighbor at a time for the whole row
+            center = Intensity[vch].Pointer(y, 2);
+            for (j = -2; j <= 2; j ++) {
+                for (i = -2; i <= 2; i ++) {
+                    if (i == 0 && j == 0) continue;
+                    svlImageProcessingSIMD::CensusUpdate(center, center + j * Width + i, output + 2, Width - 4);
+                }
+            }
+        }
+    }
+}
+
+// *******************************************************************
+// svlStereoSGM::ComputeCost PRIVATE method
+// arguments:
+//           y              - row
+//           cost           - output costs (PaddedRange per pixel)
+// function:
+//    Computes the Hamming distance of the census transforms for the
+//    pixels of the region of interest in row y
+// *******************************************************************
+void svlStereoSGM::ComputeCost(const int y, unsigned short *cost)
+{
+    const unsigned int *right = Census[SVL_RIGHT].Pointer(y, 0);
+    const unsigned int *left = Census[SVL_LEFT].Pointer(y, 0);
+    unsigned short *pixelcost;
+    int x, k, first, last;
+
+    for (x = ROI.left; x <= ROI.right; x ++) {
+        pixelcost = cost + x * PaddedRange;
+
+        // Disparities matching inside the left image
+        first = std::max(-(x + DisparityOffset), 0);
+        last = std::min(Width - (x + DisparityOffset), DisparityRange);
+
+        if (first < last) {
+            svlImageProcessingSIMD::CensusCost(right[x], left + x + DisparityOffset + first, pixelcost + first, last - first);
+        }
+        else {
+            first = last = 0;
+        }
+        for (k = 0; k < first; k ++) pixelcost[k] = SVL_SGM_INVALID_COST;
+        for (k = last; k < PaddedRange; k ++) pixelcost[k] = SVL_SGM_INVALID_COST;
+    }
+}
+
+// *******************************************************************
+// svlStereoSGM::ResetPaths PRIVATE method
+// arguments:
+//           path           - blocks of aggregated costs
+//           pathmin        - minimum of each block
+//           blocks         - number of blocks
+// function:
+//    Sets the blocks to the start of a path
+// *******************************************************************
+void svlStereoSGM::ResetPaths(unsigned short *path, int *pathmin, const int blocks)
+{
+    for (int i = 0; i < blocks; i ++) {
+        path[0] = SVL_SGM_PATH_SENTINEL;
+        memset(path + 1, 0, PaddedRange * sizeof(unsigned short));
+        path[PaddedRange + 1] = SVL_SGM_PATH_SENTINEL;
+        path += BlockStride;
+        if (pathmin) pathmin[i] = 0;
+    }
+}
+
+// *******************************************************************
+// svlStereoSGM::ProcessRows PRIVATE method
+// arguments:
+//           buffers        - buffers of the calling thread
+//           from, to       - range of rows to be computed
+//           disparitymap   - output image pointer
+// function:
+//    Aggregates costs along the 5 paths and selects the disparities
+//    of the rows.  The paths coming from above start
+//    SVL_SGM_BAND_OVERLAP rows above the first row.
+// *******************************************************************
+void svlStereoSGM::ProcessRows(ThreadBuffers & buffers, const int from, const int to, int *disparitymap)
+{
+    const int rowblocks = Width + 2;
+    const int start = std::max(ROI.top, from - SVL_SGM_BAND_OVERLAP);
+    unsigned short *cost = buffers.Cost.Pointer();
+    unsigned short *sum = buffers.Sum.Pointer();
+    unsigned short *prevpath, *curpath, *pixelcost, *pixelsum, *prevblock, *curblock;
+    int *prevmin, *curmin, *output;
+    int x, y, p, block, min, index, c0, c1, c2, denom, delta;
+
+    ResetPaths(buffers.Path[0].Pointer(), buffers.PathMin[0].Pointer(), 3 * rowblocks);
+    ResetPaths(buffers.Path[1].Pointer(), buffers.PathMin[1].Pointer(), 3 * rowblocks);
+
+    for (y = start; y < to; y ++) {
+
+        ComputeCost(y, cost);
+        memset(sum, 0, Width * PaddedRange * sizeof(unsigned short));
+
+        prevpath = buffers.Path[(y - start) & 1].Pointer();
+        prevmin = buffers.PathMin[(y - start) & 1].Pointer();
+        curpath = buffers.Path[(y - start + 1) & 1].Pointer();
+        curmin = buffers.PathMin[(y - start + 1) & 1].Pointer();
+
+        // Paths coming from the upper left, upper and upper right pixels
+        for (x = ROI.left; x <= ROI.right; x ++) {
+            pixelcost = cost + x * PaddedRange;
+            pixelsum = sum + x * PaddedRange;
+            for (p = 0; p < 3; p ++) {
+                block = p * rowblocks + x + 1;
+                curmin[block] = svlImageProcessingSIMD::AggregateCost(pixelcost,
+                                                                      prevpath + (block + p - 1) * BlockStride + 1,
+                                                                      prevmin[block + p - 1],
+                                                                      curpath + block * BlockStride + 1,
+                                                                      pixelsum,
+                                                                      PaddedRange, Penalty1, Penalty2);
+            }
+        }
+
+        // Rows above the band only initialize the paths
+        if (y < from) continue;
+
+        // Horizontal paths
+        prevblock = buffers.RowPath.Pointer() + 1;
+        curblock = prevblock + BlockStride;
+        ResetPaths(buffers.RowPath.Pointer(), 0, 2);
+        for (x = ROI.left, min = 0; x <= ROI.right; x ++) {
+            min = svlImageProcessingSIMD::AggregateCost(cost + x * PaddedRange, prevblock, min, curblock,
+                                                        sum + x * PaddedRange, PaddedRange, Penalty1, Penalty2);
+            std::swap(prevblock, curblock);
+        }
+        ResetPaths(buffers.RowPath.Pointer(), 0, 2);
+        for (x = ROI.right, min = 0; x >= ROI.left; x --) {
+            min = svlImageProcessingSIMD::AggregateCost(cost + x * PaddedRange, prevblock, min, curblock,
+                                                        sum + x * PaddedRange, PaddedRange, Penalty1, Penalty2);
+            std::swap(prevblock, curblock);
+        }
+
+        // Selecting the disparities with the lowest aggregated cost
+        output = disparitymap + y * Width;
+        for (x = ROI.left; x <= ROI.right; x ++) {
+            pixelsum = sum + x * PaddedRange;
+            index = svlImageProcessingSIMD::FindMinimum(pixelsum, DisparityRange);
+
+            if (SubpixelPrecision) {
+                // Fitting a parabola on the neighboring costs
+                delta = 0;
+                if (index > 0 && index < DisparityRange - 1) {
+                    c0 = pixelsum[index - 1];
+                    c1 = pixelsum[index];
+                    c2 = pixelsum[index + 1];
+                    denom = c0 + c2 - 2 * c1;
+                    if (denom > 0) {
+                        delta = 4 * (c0 - c2);
+                        delta = (delta + (delta >= 0 ? denom : -denom)) / (2 * denom);
+                    }
+                }
+                output[x] = ((DisparityOffset + index) << 2) + delta;
+            }
+            else {
+                output[x] = DisparityOffset + index;
+            }
+        }
+    }
+}
+
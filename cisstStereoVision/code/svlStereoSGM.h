@@ -0,0 +1,126 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#ifndef _svlStereoSGM_h
+#define _svlStereoSGM_h
+
+#include <cisstStereoVision/svlFilterComputationalStereo.h>
+#include <vector>
+
+
+/*
+  Semi-global matching on 5x5 census transforms (H. Hirschmuller,
+  Stereo processing by semiglobal matching and mutual information,
+  PAMI 2008).  Costs are aggregated along 5 paths (left to right,
+  right to left and the three paths coming from the row above) so
+  that each row only depends on the rows above it.  Rows are split
+  into bands processed by the stream threads; the paths entering a
+  band from above start a few rows above the band, results depend
+  slightly on the number of threads.
+
+  Same conventions as svlStereoDP: the disparity map is computed for
+  the right image, pixel x of the right image matching pixel
+  x + disparity of the left image, disparities are in 1/4 pixels with
+  subpixel precision.  Pixels outside of the region of interest are
+  set to 0.
+*/
+class svlStereoSGM : public svlComputationalStereoMethodBase
+{
+public:
+    svlStereoSGM(int width, int height,
+                 const svlRect & roi,
+                 int mindisparity, int maxdisparity,
+                 int ppoffset,
+                 int smoothness,
+                 bool subpixelprecision);
+    virtual ~svlStereoSGM();
+
+    virtual int Initialize();
+    virtual int Process(svlSampleImage *images, int *disparitymap);
+    virtual int ProcessMT(svlProcInfo *procInfo, svlSampleImage *images, int *disparitymap);
+    virtual void Free();
+
+private:
+    typedef struct _ThreadBuffers
+    {
+        vctDynamicVector<unsigned short> Cost;
+        vctDynamicVector<unsigned short> Sum;
+        // Aggregated costs of the previous and current rows for the
+        // 3 paths coming from above, and of the previous pixel for the
+        // 2 horizontal paths
+        vctDynamicVector<unsigned short> Path[2];
+        vctDynamicVector<int>            PathMin[2];
+        vctDynamicVector<unsigned short> RowPath;
+    } ThreadBuffers;
+
+    int Width;
+    int Height;
+    svlRect ROI;
+    int DisparityOffset;
+    int DisparityRange;
+    int PaddedRange;
+    int BlockStride;
+    int Penalty1;
+    int Penalty2;
+    bool SubpixelPrecision;
+
+    vctDynamicMatrix<unsigned short> Intensity[2];
+    vctDynamicMatrix<unsigned int> Census[2];
+    std::vector<ThreadBuffers> Buffers;
+
+    void AllocateThreadBuffers(const unsigned int count);
+    void ComputeIntensity(svlSampleImage *images, const int from, const int to);
+    void ComputeCensus(const int from, const int to);
+    void ComputeCost(const int y, unsigned short *cost);
+    void ResetPaths(unsigned short *path, int *pathmin, const int blocks);
+    void ProcessRows(ThreadBuffers & buffers, const int from, const int to, int *disparitymap);
+
+    template <class _ValueType, unsigned int _DataChannels>
+    void ComputeIntensity(const _ValueType *image, unsigned short *intensity, const int from, const int to);
+};
+
+// *******************************************************************
+// ComputeIntensity PRIVATE method
+// arguments:
+//           image          - input image (non-padded)
+//           intensity      - output intensity image
+//           from, to       - range of rows to be processed
+// function:
+//    Sum of the color channels, 16 bits
+// *******************************************************************
+template <class _ValueType, unsigned int _DataChannels>
+void svlStereoSGM::ComputeIntensity(const _ValueType *image, unsigned short *intensity, const int from, const int to)
+{
+    const int channels = static_cast<int>(_DataChannels);
+    const int count = (to - from) * Width;
+    int i, k, value;
+
+    image += from * Width * channels;
+    intensity += from * Width;
+    for (i = 0; i < count; i ++) {
+        value = 0;
+        for (k = 0; k < channels; k ++) value += image[k];
+        intensity[i] = static_cast<unsigned short>(value);
+        image += channels;
+    }
+}
+
+#endif // _svlStereoSGM_h
+
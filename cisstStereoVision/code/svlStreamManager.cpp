@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2006
 
-  (C) Copyright 2006-2019 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -26,6 +26,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstStereoVision/svlFilterBase.h>
 #include <cisstStereoVision/svlFilterSourceBase.h>
 #include <cisstStereoVision/svlStreamProc.h>
+#include <cisstStereoVision/svlStreamPipeline.h>
 
 #include <cisstOSAbstraction/osaSleep.h>
 #include <cisstOSAbstraction/osaThread.h>
@@ -34,6 +35,8 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsInterfaceProvided.h>
 #include <cisstMultiTask/mtsManagerLocal.h>
 
+#include <algorithm>
+
 /*************************************/
 /*** svlStreamManager class **********/
 /*************************************/
@@ -43,11 +46,15 @@ CMN_IMPLEMENT_SERVICES(svlStreamManager);
 svlStreamManager::svlStreamManager() :
     ThreadCount(1),
     SyncPoint(0),
+    SyncMethod(svlSyncEvent),
+    SyncSpinCount(-1),
     CS(0),
     StreamSource(0),
     Initialized(false),
     Running(false),
-    StreamStatus(SVL_STREAM_CREATED)
+    StreamStatus(SVL_STREAM_CREATED),
+    Pipelined(false),
+    PipelineQueueLength(2)
 {
     CreateInterfaces();
 }
@@ -55,11 +62,15 @@ svlStreamManager::svlStreamManager() :
 svlStreamManager::svlStreamManager(unsigned int threadcount) :
     ThreadCount(std::max(1u, threadcount)),
     SyncPoint(0),
+    SyncMethod(svlSyncEvent),
+    SyncSpinCount(-1),
     CS(0),
     StreamSource(0),
     Initialized(false),
     Running(false),
-    StreamStatus(SVL_STREAM_CREATED)
+    StreamStatus(SVL_STREAM_CREATED),
+    Pipelined(false),
+    PipelineQueueLength(2)
 {
     CreateInterfaces();
     // To do: autodetect the number of available processor cores
@@ -253,6 +264,7 @@ void svlStreamManager::Release(void)
             StreamProcThread[i] = 0;
         }
     }
+    DeletePipelineStages();
 
     // Release the stream, starting from the stream source
     svlFilterBase *filter = StreamSource;
@@ -373,14 +385,20 @@ int svlStreamManager::Play(void)
         }
     }
 
+    // Split the trunk in stages if pipelined
+    DeletePipelineStages();
+    if (Pipelined) CreatePipelineStages();
+    const size_t stagecount = std::max(PipelineStages.size(), static_cast<size_t>(1));
+
     // Allocate new thread control object array
-    StreamProcInstance.SetSize(ThreadCount);
-    StreamProcThread.SetSize(ThreadCount);
+    StreamProcInstance.SetSize(ThreadCount * stagecount);
+    StreamProcThread.SetSize(ThreadCount * stagecount);
 
     // Create thread synchronization object
     if (ThreadCount > 1) {
         SyncPoint = new svlSyncPoint;
         SyncPoint->Count(ThreadCount);
+        SyncPoint->Method(SyncMethod, SyncSpinCount);
         CS = new osaCriticalSection;
     }
 
@@ -391,11 +409,22 @@ int svlStreamManager::Play(void)
     if (StreamSource->PlayCounter != 0) StreamSource->PauseAtFrameID = -1;
     else StreamSource->PauseAtFrameID = 0;
 
-    for (i = 0; i < ThreadCount; i ++) {
-        // Starting multi thread processing
-        StreamProcInstance[i] = new svlStreamProc(ThreadCount, static_cast<unsigned int>(i));
-        StreamProcThread[i] = new osaThread;
-        StreamProcThread[i]->Create<svlStreamProc, svlStreamManager*>(StreamProcInstance[i], &svlStreamProc::Proc, this);
+    if (PipelineStages.empty()) {
+        for (i = 0; i < ThreadCount; i ++) {
+            // Starting multi thread processing
+            StreamProcInstance[i] = new svlStreamProc(ThreadCount, static_cast<unsigned int>(i));
+            StreamProcThread[i] = new osaThread;
+            StreamProcThread[i]->Create<svlStreamProc, svlStreamManager*>(StreamProcInstance[i], &svlStreamProc::Proc, this);
+        }
+    }
+    else {
+        for (i = 0; i < ThreadCount * stagecount; i ++) {
+            // Starting ThreadCount threads per stage
+            StreamProcInstance[i] = new svlStreamProc(ThreadCount, static_cast<unsigned int>(i % ThreadCount),
+                                                      PipelineStages[i / ThreadCount], static_cast<unsigned int>(i));
+            StreamProcThread[i] = new osaThread;
+            StreamProcThread[i]->Create<svlStreamProc, svlStreamManager*>(StreamProcInstance[i], &svlStreamProc::ProcStage, this);
+        }
     }
 
     // Start all filter outputs recursively, if any
@@ -505,7 +534,7 @@ void svlStreamManager::Stop(void)
                                                       mtsComponentState::READY));
 
     // Stopping multi thread processing and delete thread objects
-    for (size_t i = 0; i < ThreadCount; i ++) {
+    for (size_t i = 0; i < StreamProcThread.size(); i ++) {
         if (StreamProcThread[i]) {
             StreamProcThread[i]->Wait();
             delete StreamProcThread[i];
@@ -612,7 +641,7 @@ void svlStreamManager::InternalStop(unsigned int callingthreadID)
                                                       mtsComponentState::READY));
 
     // Stopping multi thread processing and delete thread objects
-    for (size_t i = 0; i < ThreadCount; i ++) {
+    for (size_t i = 0; i < StreamProcThread.size(); i ++) {
         if (i != callingthreadID) {
             if (StreamProcThread[i]) {
                 StreamProcThread[i]->Wait();
@@ -657,6 +686,145 @@ void svlStreamManager::InternalStop(unsigned int callingthreadID)
     }
 }
 
+int svlStreamManager::SetSyncMethod(svlSyncMethod method, int spincount)
+{
+    if (Running) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetSyncMethod: stream \"" << this->GetName()
+                                 << "\" is running, can't change synchronization method" << std::endl;
+        return SVL_ALREADY_RUNNING;
+    }
+    SyncMethod = method;
+    SyncSpinCount = spincount;
+    return SVL_OK;
+}
+
+svlSyncMethod svlStreamManager::GetSyncMethod(void) const
+{
+    return SyncMethod;
+}
+
+int svlStreamManager::SetPipelined(bool pipelined, unsigned int queuelength)
+{
+    if (Running) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetPipelined: stream \"" << this->GetName()
+                                 << "\" is running, can't change execution mode" << std::endl;
+        return SVL_ALREADY_RUNNING;
+    }
+    if (queuelength < 1) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetPipelined: queue length must be at least 1 for stream \""
+                                 << this->GetName() << "\"" << std::endl;
+        return SVL_FAIL;
+    }
+    Pipelined = pipelined;
+    PipelineQueueLength = queuelength;
+    return SVL_OK;
+}
+
+bool svlStreamManager::IsPipelined(void) const
+{
+    return Pipelined;
+}
+
+int svlStreamManager::AddPipelineStage(svlFilterBase * firstfilter)
+{
+    if (firstfilter == 0) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddPipelineStage: null filter pointer provided for stream \""
+                                 << this->GetName() << "\"" << std::endl;
+        return SVL_FAIL;
+    }
+    if (Running) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddPipelineStage: stream \"" << this->GetName()
+                                 << "\" is running, can't add stage" << std::endl;
+        return SVL_ALREADY_RUNNING;
+    }
+    if (std::find(PipelineStageStarts.begin(), PipelineStageStarts.end(), firstfilter) == PipelineStageStarts.end()) {
+        PipelineStageStarts.push_back(firstfilter);
+    }
+    return SVL_OK;
+}
+
+void svlStreamManager::ClearPipelineStages(void)
+{
+    PipelineStageStarts.clear();
+}
+
+unsigned int svlStreamManager::GetPipelineStageCount(void) const
+{
+    return static_cast<unsigned int>(PipelineStages.size());
+}
+
+int svlStreamManager::GetPipelineStageInfo(unsigned int stage, svlStreamPipelineStageInfo & info) const
+{
+    if (stage >= PipelineStages.size()) return SVL_FAIL;
+    PipelineStages[stage]->GetInfo(info);
+    return SVL_OK;
+}
+
+void svlStreamManager::CreatePipelineStages(void)
+{
+    std::vector<svlStreamType> types;
+    svlFilterBase *filter = StreamSource, *first = StreamSource, *next;
+    svlFilterOutput * output;
+    svlFilterInput * input;
+    size_t found = 0, i;
+
+    while (filter) {
+        // Get next filter in the trunk
+        output = filter->GetOutput();
+        next = 0;
+        // Check if trunk output exists
+        if (output) {
+            input = output->Connection;
+            // Check if trunk output is connected to a trunk input
+            if (input && input->Trunk) next = input->Filter;
+        }
+
+        // Close the current stage at the end of the trunk or if next filter starts a stage
+        if (next == 0 ||
+            PipelineStageStarts.empty() ||
+            std::find(PipelineStageStarts.begin(), PipelineStageStarts.end(), next) != PipelineStageStarts.end()) {
+            if (next && !PipelineStageStarts.empty()) found ++;
+            PipelineStages.push_back(new svlStreamPipelineStage(first, filter, ThreadCount, SyncMethod, SyncSpinCount));
+            if (next) types.push_back(output->GetType());
+            first = next;
+        }
+        filter = next;
+    }
+
+    if (found < PipelineStageStarts.size()) {
+        CMN_LOG_CLASS_INIT_WARNING << "CreatePipelineStages: " << (PipelineStageStarts.size() - found)
+                                   << " stage(s) don't start with a trunk filter of stream \""
+                                   << this->GetName() << "\", they are ignored" << std::endl;
+    }
+    if (PipelineStages.size() < 2) {
+        CMN_LOG_CLASS_INIT_WARNING << "CreatePipelineStages: stream \"" << this->GetName()
+                                   << "\" has a single stage, using default execution" << std::endl;
+        DeletePipelineStages();
+        return;
+    }
+
+    // Connect stages, queues are owned by the downstream stage
+    svlStreamPipelineQueue * inputqueue = 0;
+    svlStreamPipelineQueue * outputqueue;
+    for (i = 0; i < PipelineStages.size(); i ++) {
+        outputqueue = 0;
+        if (i < types.size()) outputqueue = new svlStreamPipelineQueue(types[i], PipelineQueueLength);
+        PipelineStages[i]->SetQueues(inputqueue, outputqueue);
+        inputqueue = outputqueue;
+    }
+
+    CMN_LOG_CLASS_INIT_VERBOSE << "CreatePipelineStages: stream \"" << this->GetName() << "\" split in "
+                               << PipelineStages.size() << " stages" << std::endl;
+}
+
+void svlStreamManager::DeletePipelineStages(void)
+{
+    for (size_t i = 0; i < PipelineStages.size(); i ++) {
+        delete PipelineStages[i];
+    }
+    PipelineStages.clear();
+}
+
 bool svlStreamManager::IsRunning(void) const
 {
     return Running;
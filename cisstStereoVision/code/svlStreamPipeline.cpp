@@ -0,0 +1,216 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include <cisstStereoVision/svlStreamPipeline.h>
+#include <cisstStereoVision/svlFilterBase.h>
+
+
+/************************************/
+/*** svlStreamPipelineQueue class ***/
+/************************************/
+
+svlStreamPipelineQueue::svlStreamPipelineQueue(svlStreamType type, unsigned int length) :
+    Length(std::max(length, 1u)),
+    ReadIndex(0),
+    WriteIndex(0),
+    FilledCount(0),
+    UsedCount(0),
+    Finished(false),
+    Slots(Length),
+    FrameCounters(Length)
+{
+    for (unsigned int i = 0; i < Length; i ++) {
+        Slots[i] = svlSample::GetNewFromType(type);
+    }
+    FrameCounters.SetAll(0);
+}
+
+svlStreamPipelineQueue::~svlStreamPipelineQueue()
+{
+    for (unsigned int i = 0; i < Length; i ++) {
+        delete Slots[i];
+    }
+}
+
+bool svlStreamPipelineQueue::Wait(osaThreadSignal& event, bool full, const bool& stop)
+{
+    // Returns with the critical section entered if the condition is met
+    while (1) {
+        CS.Enter();
+            if (full) {
+                if (UsedCount < Length) return true;
+            }
+            else {
+                if (FilledCount > 0 || Finished) return true;
+            }
+        CS.Leave();
+
+        if (stop) return false;
+        event.Wait(0.1);
+    }
+}
+
+int svlStreamPipelineQueue::Push(const svlSample* sample, unsigned int framecounter, const bool& stop)
+{
+    if (!Wait(NotFullEvent, true, stop)) return SVL_STOP_REQUEST;
+        unsigned int index = WriteIndex;
+    CS.Leave();
+
+    // Slot is not accessed by the consumer until it gets committed
+    if (Slots[index]->CopyOf(sample) != SVL_OK) return SVL_FAIL;
+    FrameCounters[index] = framecounter;
+
+    CS.Enter();
+        WriteIndex = (WriteIndex + 1) % Length;
+        UsedCount ++;
+        FilledCount ++;
+        NotEmptyEvent.Raise();
+    CS.Leave();
+
+    return SVL_OK;
+}
+
+svlSample* svlStreamPipelineQueue::Pull(unsigned int& framecounter, const bool& stop)
+{
+    if (!Wait(NotEmptyEvent, false, stop)) return 0;
+        if (FilledCount == 0) {
+            // Producer finished and queue drained
+            CS.Leave();
+            return 0;
+        }
+        unsigned int index = ReadIndex;
+        ReadIndex = (ReadIndex + 1) % Length;
+        FilledCount --;
+    CS.Leave();
+
+    framecounter = FrameCounters[index];
+    return Slots[index];
+}
+
+void svlStreamPipelineQueue::Release()
+{
+    CS.Enter();
+        if (UsedCount > FilledCount) {
+            UsedCount --;
+            NotFullEvent.Raise();
+        }
+    CS.Leave();
+}
+
+void svlStreamPipelineQueue::Finish()
+{
+    CS.Enter();
+        Finished = true;
+        NotEmptyEvent.Raise();
+    CS.Leave();
+}
+
+unsigned int svlStreamPipelineQueue::GetLength()
+{
+    return Length;
+}
+
+unsigned int svlStreamPipelineQueue::GetUsage()
+{
+    return FilledCount;
+}
+
+
+/************************************/
+/*** svlStreamPipelineStage class ***/
+/************************************/
+
+svlStreamPipelineStage::svlStreamPipelineStage(svlFilterBase* first, svlFilterBase* last, unsigned int threadcount,
+                                               svlSyncMethod syncmethod, int spincount) :
+    FirstFilter(first),
+    LastFilter(last),
+    SyncPoint(0),
+    InputQueue(0),
+    OutputQueue(0),
+    CurrentSample(0),
+    CurrentFrameCounter(0),
+    FrameCount(0),
+    LatencySum(0.0),
+    LatencyMax(0.0),
+    InputWaitTime(0.0),
+    OutputWaitTime(0.0),
+    QueueUsageSum(0.0),
+    QueueUsageMax(0)
+{
+    if (threadcount > 1) {
+        SyncPoint = new svlSyncPoint;
+        SyncPoint->Count(threadcount);
+        SyncPoint->Method(syncmethod, spincount);
+    }
+}
+
+svlStreamPipelineStage::~svlStreamPipelineStage()
+{
+    // Queues are owned by the consuming stage
+    delete InputQueue;
+    delete SyncPoint;
+}
+
+void svlStreamPipelineStage::SetQueues(svlStreamPipelineQueue* input, svlStreamPipelineQueue* output)
+{
+    InputQueue = input;
+    OutputQueue = output;
+}
+
+void svlStreamPipelineStage::AddFrame(double latency, double inputwait, double outputwait)
+{
+    unsigned int usage = 0;
+    if (InputQueue) usage = InputQueue->GetUsage();
+
+    StatsCS.Enter();
+        FrameCount ++;
+        LatencySum += latency;
+        if (latency > LatencyMax) LatencyMax = latency;
+        InputWaitTime += inputwait;
+        OutputWaitTime += outputwait;
+        QueueUsageSum += usage;
+        if (usage > QueueUsageMax) QueueUsageMax = usage;
+    StatsCS.Leave();
+}
+
+void svlStreamPipelineStage::GetInfo(svlStreamPipelineStageInfo& info)
+{
+    info.FirstFilter = FirstFilter->GetName();
+    info.LastFilter  = LastFilter->GetName();
+    if (InputQueue) {
+        info.QueueLength = InputQueue->GetLength();
+        info.QueueUsage  = InputQueue->GetUsage();
+    }
+    else {
+        info.QueueLength = 0;
+        info.QueueUsage  = 0;
+    }
+
+    StatsCS.Enter();
+        info.FrameCount        = FrameCount;
+        info.LatencyAverage    = FrameCount ? LatencySum / FrameCount : 0.0;
+        info.LatencyMax        = LatencyMax;
+        info.InputWaitTime     = InputWaitTime;
+        info.OutputWaitTime    = OutputWaitTime;
+        info.QueueUsageAverage = FrameCount ? QueueUsageSum / FrameCount : 0.0;
+        info.QueueUsageMax     = QueueUsageMax;
+    StatsCS.Leave();
+}
+
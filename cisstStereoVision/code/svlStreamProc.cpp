@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2010
 
-  (C) Copyright 2006-2010 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -23,10 +23,12 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstStereoVision/svlStreamManager.h>
 #include <cisstStereoVision/svlFilterSourceBase.h>
 #include <cisstStereoVision/svlStreamBranchSource.h>
+#include <cisstStereoVision/svlStreamPipeline.h>
 #include <cisstStereoVision/svlFilterInput.h>
 #include <cisstStereoVision/svlFilterOutput.h>
 #include <cisstOSAbstraction/osaTimeServer.h>
 #include <cisstOSAbstraction/osaSleep.h>
+#include <cisstOSAbstraction/osaGetTime.h>
 
 
 /*****************************/
@@ -35,7 +37,18 @@ http://www.cisst.org/cisst/license.txt.
 
 svlStreamProc::svlStreamProc(unsigned int threadcount, unsigned int threadid) :
     ThreadID(threadid),
-    ThreadCount(threadcount)
+    ThreadCount(threadcount),
+    Stage(0),
+    ThreadIndex(threadid)
+{
+}
+
+svlStreamProc::svlStreamProc(unsigned int threadcount, unsigned int threadid,
+                             svlStreamPipelineStage* stage, unsigned int threadindex) :
+    ThreadID(threadid),
+    ThreadCount(threadcount),
+    Stage(stage),
+    ThreadIndex(threadindex)
 {
 }
 
@@ -309,3 +322,324 @@ void* svlStreamProc::Proc(svlStreamManager* baseref)
     return this;
 }
 
+
+void* svlStreamProc::ProcStage(svlStreamManager* baseref)
+{
+    svlSample *inputsample, *outputsample;
+    svlFilterBase *filter, *prevfilter;
+    svlFilterSourceBase* source = baseref->StreamSource;
+    svlFilterOutput* output;
+    svlFilterInput* input;
+    svlProcInfo info;
+    svlSyncPoint *sync = Stage->SyncPoint;
+    svlStreamPipelineQueue *inputqueue = Stage->InputQueue;
+    svlStreamPipelineQueue *outputqueue = Stage->OutputQueue;
+    unsigned int counter = 0;
+    osaTimeServer* timeserver = 0;
+    double timestamp, starttime = 0.0, inputwait = 0.0, outputwait = 0.0;
+    int status = SVL_OK;
+
+    // Initializing thread info structure
+    info.count = ThreadCount;
+    info.ID    = ThreadID;
+    info.sync  = sync;
+    info.cs    = baseref->CS;
+
+    if (inputqueue == 0 && ThreadID == 0) {
+    // Execute only on one thread of the first stage - BEGIN
+
+        // Initialize time server for accessing absolute time
+        timeserver = new osaTimeServer;
+        timeserver->SetTimeOrigin();
+
+    // Execute only on one thread of the first stage - END
+    }
+
+    while (baseref->StopThread == false) {
+        outputsample = 0;
+        filter = 0;
+
+        if (inputqueue == 0) {
+
+        ////////////////////////////////////////////////
+        // First stage, starting from the stream source
+
+            source->FrameCounter = counter;
+
+            if (source->PauseAtFrameID == static_cast<int>(counter)) {
+                if (ThreadID == 0) {
+                    // Wait until playback resumed or stream stopped
+                    while (source->PlayCounter == 0 && baseref->StopThread == false) {
+                        osaSleep(0.1); // check 10 times a second
+                    }
+                    if (baseref->StopThread) {
+                        CMN_LOG_INIT_DEBUG << "svlStreamProc::ProcStage (ThreadID=" << ThreadID << ", Filter=\"" << source->GetName() << "\"): stream stopped while paused" << std::endl;
+                        break;
+                    }
+                }
+
+                if (ThreadCount > 1) {
+                    // Synchronization point, wait for other threads
+                    if (sync->Sync(ThreadID) != SVL_SYNC_OK) {
+                        CMN_LOG_INIT_ERROR << "svlStreamProc::ProcStage (ThreadID=" << ThreadID << ", Filter=\"" << source->GetName() << "\"): Sync() returned error (#1)" << std::endl;
+                        break;
+                    }
+                }
+            }
+
+            if (ThreadID == 0) {
+                if (source->PlayCounter > 0) source->PlayCounter --;
+                if (source->PlayCounter == 0) {
+                    // Pause when the next frame arrives
+                    source->PauseAtFrameID = static_cast<int>(counter) + 1;
+                }
+                starttime = osaGetTime();
+            }
+
+            status = source->Process(&info, outputsample);
+            if (status == SVL_STOP_REQUEST) {
+                CMN_LOG_INIT_DEBUG << "svlStreamProc::ProcStage (ThreadID=" << ThreadID << ", Filter=\"" << source->GetName() << "\"): SVL_STOP_REQUEST received" << std::endl;
+                break;
+            }
+            else if (status < 0) {
+                CMN_LOG_INIT_ERROR << "svlStreamProc::ProcStage (ThreadID=" << ThreadID << ", Filter=\"" << source->GetName() << "\"): svlFilterSourceBase::Process() returned error (" << status << ")" << std::endl;
+                break;
+            }
+
+            if (ThreadID == 0) {
+                if (outputsample && (source->AutoTimestamp || outputsample->GetTimestamp() < 0.0)) {
+                    // Get fresh timestamp and assign it to the output sample
+                    outputsample->SetTimestamp(GetAbsoluteTime(timeserver));
+                }
+            }
+
+            if (ThreadCount > 1) {
+                // Synchronization point, wait for other threads
+                if (sync->Sync(ThreadID) != SVL_SYNC_OK) {
+                    CMN_LOG_INIT_ERROR << "svlStreamProc::ProcStage (ThreadID=" << ThreadID << ", Filter=\"" << source->GetName() << "\"): Sync() returned error (#2)" << std::endl;
+                    break;
+                }
+            }
+
+            // Check for errors and stop request
+            if (baseref->StopThread) {
+                CMN_LOG_INIT_DEBUG << "svlStreamProc::ProcStage (ThreadID=" << ThreadID << ", Filter=\"" << source->GetName() << "\"): StopThread flag is true (#1)" << std::endl;
+                break;
+            }
+            else if (baseref->StreamStatus != SVL_OK) {
+                CMN_LOG_INIT_ERROR << "svlStreamProc::ProcStage (ThreadID=" << ThreadID << ", Filter=\"" << source->GetName() << "\"): StreamStatus signals error (" << baseref->StreamStatus << ") (#1)" << std::endl;
+                break;
+            }
+
+            // Get next filter in the chain
+            output = source->GetOutput();
+            // Check if trunk output exists
+            if (output) {
+                input = output->Connection;
+                // Check if trunk output is connected
+                if (input) {
+                    // If connected input is trunk
+                    if (input->Trunk) filter = input->Filter;
+                    // If connected input is not trunk
+                    else if (ThreadID == 0 && outputsample) input->Buffer->Push(outputsample);
+                    // Store timestamps on both the filter input and the filter output
+                    if (outputsample) {
+                        timestamp = outputsample->GetTimestamp();
+                        output->Timestamp = timestamp;
+                        input->Timestamp = timestamp;
+                    }
+                }
+            }
+            if (source == Stage->LastFilter) filter = 0;
+        }
+        else {
+
+        //////////////////////////////////////////
+        // Other stages, wait for upstream stage
+
+            if (ThreadID == 0) {
+                inputwait = osaGetTime();
+                Stage->CurrentSample = inputqueue->Pull(Stage->CurrentFrameCounter, baseref->StopThread);
+                starttime = osaGetTime();
+                inputwait = starttime - inputwait;
+            }
+
+            if (ThreadCount > 1) {
+                // Synchronization point, wait for other threads
+                if (sync->Sync(ThreadID) != SVL_SYNC_OK) {
+                    CMN_LOG_INIT_ERROR << "svlStreamProc::ProcStage (ThreadID=" << ThreadID << ", Filter=\"" << Stage->FirstFilter->GetName() << "\"): Sync() returned error (#4)" << std::endl;
+                    break;
+                }
+            }
+
+            if (Stage->CurrentSample == 0) {
+                // Upstream stage stopped and all samples have been processed
+                CMN_LOG_INIT_DEBUG << "svlStreamProc::ProcStage (ThreadID=" << ThreadID << ", Filter=\"" << Stage->FirstFilter->GetName() << "\"): upstream stage stopped" << std::endl;
+                status = SVL_STOP_REQUEST;
+                break;
+            }
+
+            counter = Stage->CurrentFrameCounter;
+            outputsample = Stage->CurrentSample;
+            filter = Stage->FirstFilter;
+        }
+
+    ////////////////////////////////////////////
+    // Going downstream filter by filter
+
+        while (filter != 0) {
+            filter->FrameCounter = counter;
+
+            // Pass samples downstream
+            inputsample = outputsample; outputsample = 0;
+
+            // Check if the previous output is valid input for the next filter
+            status = filter->IsDataValid(filter->GetInput()->Type, inputsample);
+            if (status != SVL_OK) {
+                CMN_LOG_INIT_ERROR << "svlStreamProc::ProcStage (ThreadID=" << ThreadID << ", Filter=\"" << filter->GetName() << "\"): svlFilterBase::IsDataValid() returned error (" << status << ")" << std::endl;
+                break;
+            }
+
+            status = filter->Process(&info, inputsample, outputsample);
+            if (status < 0) {
+                CMN_LOG_INIT_ERROR << "svlStreamProc::ProcStage (ThreadID=" << ThreadID << ", Filter=\"" << filter->GetName() << "\"): svlFilterBase::Process() returned error (" << status << ")" << std::endl;
+                break;
+            }
+
+            if (ThreadCount > 1) {
+                // Synchronization point, wait for other threads
+                if (sync->Sync(ThreadID) != SVL_SYNC_OK) {
+                    CMN_LOG_INIT_ERROR << "svlStreamProc::ProcStage (ThreadID=" << ThreadID << ", Filter=\"" << filter->GetName() << "\"): Sync() returned error (#3)" << std::endl;
+                    break;
+                }
+            }
+
+            // Thread-safe propagation of Enabled flag to EnabledInternal.
+            if (ThreadID == 0) {
+                filter->EnabledInternal = filter->Enabled;
+            }
+
+            // Check for errors and stop request
+            if (baseref->StopThread) {
+                CMN_LOG_INIT_DEBUG << "svlStreamProc::ProcStage (ThreadID=" << ThreadID << ", Filter=\"" << filter->GetName() << "\"): StopThread flag is true (#2)" << std::endl;
+                break;
+            }
+            else if (baseref->StreamStatus != SVL_OK) {
+                CMN_LOG_INIT_ERROR << "svlStreamProc::ProcStage (ThreadID=" << ThreadID << ", Filter=\"" << filter->GetName() << "\"): StreamStatus signals error (" << baseref->StreamStatus << ") (#2)" << std::endl;
+                break;
+            }
+
+            // Store input time stamp
+            filter->PrevInputTimestamp = inputsample->GetTimestamp();
+
+            // Pass input timestamp to output sample
+            if (outputsample) outputsample->SetTimestamp(filter->PrevInputTimestamp);
+
+            prevfilter = filter;
+
+            // Get next filter in the chain
+            output = filter->GetOutput();
+            filter = 0;
+            // Check if trunk output exists
+            if (output) {
+                input = output->Connection;
+                // Check if trunk output is connected
+                if (input) {
+                    // If connected input is trunk
+                    if (input->Trunk) filter = input->Filter;
+                    // If connected input is not trunk
+                    else if (ThreadID == 0 && outputsample) input->Buffer->Push(outputsample);
+                    // Store timestamps on both the filter input and the filter output
+                    if (outputsample) {
+                        timestamp = outputsample->GetTimestamp();
+                        output->Timestamp = timestamp;
+                        input->Timestamp = timestamp;
+                    }
+                }
+            }
+
+            // Stop at the end of the stage
+            if (prevfilter == Stage->LastFilter) filter = 0;
+        }
+        if (status < 0) break;
+
+        if (ThreadID == 0) {
+        // Execute only on one thread - BEGIN
+
+            // Copy output to the next stage, this might wait if the
+            // downstream stage is slower
+            outputwait = 0.0;
+            if (outputqueue && outputsample) {
+                outputwait = osaGetTime();
+                status = outputqueue->Push(outputsample, counter, baseref->StopThread);
+                outputwait = osaGetTime() - outputwait;
+                if (status < 0 && baseref->StopThread == false) {
+                    CMN_LOG_INIT_ERROR << "svlStreamProc::ProcStage (ThreadID=" << ThreadID << ", Filter=\"" << Stage->LastFilter->GetName() << "\"): svlStreamPipelineQueue::Push() returned error (" << status << ")" << std::endl;
+                    baseref->StreamStatus = status;
+                }
+            }
+
+            // Input sample might have been passed through by the
+            // filters, it can only be reused once the output is copied
+            if (inputqueue) inputqueue->Release();
+
+            Stage->AddFrame(osaGetTime() - starttime - outputwait, inputwait, outputwait);
+
+        // Execute only on one thread - END
+        }
+
+        if (ThreadCount > 1) {
+            // Synchronization point, output sample can't be modified
+            // before it has been copied to the queue
+            if (sync->Sync(ThreadID) != SVL_SYNC_OK) {
+                CMN_LOG_INIT_ERROR << "svlStreamProc::ProcStage (ThreadID=" << ThreadID << ", Filter=\"" << Stage->LastFilter->GetName() << "\"): Sync() returned error (#5)" << std::endl;
+                break;
+            }
+        }
+
+        // Check for errors and stop request
+        if (baseref->StopThread || baseref->StreamStatus != SVL_OK) break;
+
+        // incrementing frame counter
+        counter ++;
+    }
+
+    if (ThreadID == 0) {
+    // Execute only on one thread - BEGIN
+
+        // Delete time server
+        if (timeserver) delete timeserver;
+
+        // Let the downstream stage process the remaining samples
+        if (outputqueue) outputqueue->Finish();
+
+    // Execute only on one thread - END
+    }
+
+    // Signal the error status
+    if (baseref->StopThread == false) {
+        if (outputqueue == 0) {
+            // Last stage, internal shutdown
+            if (baseref->StreamStatus == SVL_OK) baseref->StreamStatus = status;
+        }
+        else if (status < 0) {
+            baseref->StreamStatus = status;
+        }
+    }
+
+    if (ThreadCount > 1) {
+    // Execute only if multi-threaded - BEGIN
+
+        sync->ReleaseAll();
+
+    // Execute only if multi-threaded - END
+    }
+
+    // Run InternalStop() method in case of internal shutdown,
+    // upstream stages waiting on their queues stop as well
+    if (baseref->StopThread == false && outputqueue == 0 && ThreadID == 0) {
+        baseref->InternalStop(ThreadIndex);
+    }
+
+    return this;
+}
@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2008 
 
-  (C) Copyright 2006-2008 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -21,6 +21,27 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstStereoVision/svlSyncPoint.h>
 #include <cisstStereoVision/svlDefinitions.h>
+#include <cisstOSAbstraction/osaCPUAffinity.h>
+
+#if (CISST_OS == CISST_LINUX)
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #include <climits>
+#else
+    #include <thread>
+#endif
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+    #include <immintrin.h>
+    #define svlSyncPointPause() _mm_pause()
+#else
+    #define svlSyncPointPause()
+#endif
+
+// Number of iterations spent spinning before sleeping, roughly 10-50
+// micro seconds on recent CPUs
+#define SVL_SYNC_DEFAULT_SPIN_COUNT     4000
 
 
 /*************************************/
@@ -32,8 +53,14 @@ http://www.cisst.org/cisst/license.txt.
 // arguments:
 // *******************************************************************
 svlSyncPoint::svlSyncPoint() :
+    SyncMethod(svlSyncEvent),
     ThreadCount(2),
-    LastChanged(-1)
+    LastChanged(-1),
+    SpinCount(0),
+    SpinRemaining(2),
+    SpinGeneration(0),
+    SpinSleepers(0),
+    SpinReleased(false)
 {
     CheckedInCounter = ThreadCount;
     ReleaseEvent = new osaThreadSignal[ThreadCount];
@@ -66,6 +93,10 @@ int svlSyncPoint::Count(unsigned int count)
     delete [] ReleaseEvent;
     ReleaseEvent = new osaThreadSignal[ThreadCount];
 
+    SpinRemaining = ThreadCount;
+    SpinGeneration = 0;
+    SpinReleased = false;
+
     return SVL_SYNC_OK;
 }
 
@@ -74,6 +105,38 @@ unsigned int svlSyncPoint::Count()
     return ThreadCount;
 }
 
+// *******************************************************************
+// svlSyncPoint::Method method
+// arguments:
+//           method         - svlSyncEvent or svlSyncSpin
+//           spincount      - number of spin iterations before
+//                            sleeping, negative for default
+//                            (0 on single core machines)
+// function:
+//    Sets or returns the synchronization method.
+//    This method is not thread safe.
+// *******************************************************************
+int svlSyncPoint::Method(svlSyncMethod method, int spincount)
+{
+    if (method != svlSyncEvent && method != svlSyncSpin) return SVL_SYNC_ERROR;
+
+    SyncMethod = method;
+    if (spincount >= 0) {
+        SpinCount = static_cast<unsigned int>(spincount);
+    }
+    else {
+        // Spinning is a waste of time if the other threads can't run
+        SpinCount = (osaCPUGetCount() > 1) ? SVL_SYNC_DEFAULT_SPIN_COUNT : 0;
+    }
+
+    return SVL_SYNC_OK;
+}
+
+svlSyncMethod svlSyncPoint::Method()
+{
+    return SyncMethod;
+}
+
 // *******************************************************************
 // svlSyncPoint::Sync method
 // arguments:
@@ -85,6 +148,7 @@ unsigned int svlSyncPoint::Count()
 int svlSyncPoint::Sync(unsigned int _id)
 {
     if (_id >= ThreadCount) return SVL_SYNC_ERROR;
+    if (SyncMethod == svlSyncSpin) return SyncSpin();
 
     CS.Enter();
         CheckedInCounter --;
@@ -125,6 +189,16 @@ int svlSyncPoint::Sync(unsigned int _id)
 // *******************************************************************
 void svlSyncPoint::ReleaseAll()
 {
+    if (SyncMethod == svlSyncSpin) {
+        // Following Sync calls return immediately, until Count is
+        // called.  The generation is incremented, not reset, so it
+        // can't go back to the value a waiting thread is waiting on.
+        SpinReleased = true;
+        SpinGeneration.fetch_add(1);
+        WakeSpin();
+        return;
+    }
+
     CS.Enter();
         for (unsigned int i = 0; i < ThreadCount; i ++) {
             ReleaseEvent[i].Raise();
@@ -135,3 +209,62 @@ void svlSyncPoint::ReleaseAll()
     CS.Leave();
 }
 
+// *******************************************************************
+// svlSyncPoint::SyncSpin method
+// function:
+//    Generation counting barrier: the last thread to check in resets
+//    the counter and increments the generation, which releases the
+//    other threads.  Waiting threads spin for SpinCount iterations,
+//    then sleep until the generation changes or ReleaseAll is called.
+// *******************************************************************
+int svlSyncPoint::SyncSpin()
+{
+    if (SpinReleased.load(std::memory_order_acquire)) return SVL_SYNC_OK;
+
+    // Generation can't change before this thread checks in, unless
+    // ReleaseAll is called
+    const int generation = SpinGeneration.load(std::memory_order_acquire);
+
+    if (SpinRemaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        // Last thread to check in, prepare the next cycle and
+        // release the other threads
+        SpinRemaining.store(ThreadCount, std::memory_order_relaxed);
+        SpinGeneration.fetch_add(1);
+        if (SpinSleepers.load() > 0) WakeSpin();
+        return SVL_SYNC_OK;
+    }
+
+    for (unsigned int i = 0; i < SpinCount; i ++) {
+        if (SpinGeneration.load(std::memory_order_acquire) != generation ||
+            SpinReleased.load(std::memory_order_acquire)) return SVL_SYNC_OK;
+        svlSyncPointPause();
+    }
+
+    // Sleepers has to be incremented before the generation is checked
+    // again so the releasing thread can't miss this one
+    SpinSleepers.fetch_add(1);
+    while (SpinGeneration.load() == generation && !SpinReleased.load()) {
+        WaitSpin(generation);
+    }
+    SpinSleepers.fetch_sub(1);
+
+    return SVL_SYNC_OK;
+}
+
+void svlSyncPoint::WaitSpin(int generation)
+{
+#if (CISST_OS == CISST_LINUX)
+    // Returns immediately if the generation already changed
+    syscall(SYS_futex, reinterpret_cast<int*>(&SpinGeneration), FUTEX_WAIT_PRIVATE, generation, 0, 0, 0);
+#else
+    (void)generation;
+    std::this_thread::yield();
+#endif
+}
+
+void svlSyncPoint::WakeSpin()
+{
+#if (CISST_OS == CISST_LINUX)
+    syscall(SYS_futex, reinterpret_cast<int*>(&SpinGeneration), FUTEX_WAKE_PRIVATE, INT_MAX, 0, 0, 0);
+#endif
+}
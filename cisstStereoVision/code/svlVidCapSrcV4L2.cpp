@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2006 
 
-  (C) Copyright 2006-2007 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -32,6 +32,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <errno.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
+#include <sys/select.h>
 #include <linux/types.h>
 #include <linux/videodev2.h>
 
@@ -45,6 +46,7 @@ using namespace std;
 #define MV4LP_BUFFER_SIZE_TARGET    2
 #define MV4LP_MIN_BUFFER_SIZE       2
 #define MV4LP_FRAME_TIMEOUT         100
+#define MV4LP_ZEROCOPY_TIMEOUT      5.0
 #define MV4LP_CS_UNKNOWN            -1
 #define MV4LP_CS_BGR24              0
 #define MV4LP_CS_UYVY               1
@@ -77,7 +79,14 @@ svlVidCapSrcV4L2::svlVidCapSrcV4L2() :
 	FrameBufferSize(0),
     FrameBuffer(0),
     OutputBuffer(0),
-    Format(0)
+    Format(0),
+    ScratchBuffer(0),
+    ZeroCopyInFlight(0),
+    ZeroCopy(0),
+    ReadyBuffers(0),
+    LockedBuffer(0),
+    BufferCS(0),
+    NewFrameEvent(0)
 {
 }
 
@@ -113,6 +122,13 @@ int svlVidCapSrcV4L2::SetStreamCount(unsigned int numofstreams)
     FrameBuffer = new FrameBufferType*[NumOfStreams];
     OutputBuffer = new svlBufferImage*[NumOfStreams];
     Format = new svlFilterSourceVideoCapture::ImageFormat*[NumOfStreams];
+    ScratchBuffer = new unsigned char*[NumOfStreams];
+    ZeroCopyInFlight = new unsigned int[NumOfStreams];
+    ZeroCopy = new bool[NumOfStreams];
+    ReadyBuffers = new std::deque<int>[NumOfStreams];
+    LockedBuffer = new int[NumOfStreams];
+    BufferCS = new osaCriticalSection[NumOfStreams];
+    NewFrameEvent = new osaThreadSignal[NumOfStreams];
 
     for (unsigned int i = 0; i < NumOfStreams; i ++) {
         CaptureProc[i] = 0;
@@ -129,6 +145,10 @@ int svlVidCapSrcV4L2::SetStreamCount(unsigned int numofstreams)
         FrameBuffer[i] = 0;
         OutputBuffer[i] = 0;
         Format[i] = 0;
+        ScratchBuffer[i] = 0;
+        ZeroCopyInFlight[i] = 0;
+        ZeroCopy[i] = false;
+        LockedBuffer[i] = -1;
     }
 
     return SVL_OK;
@@ -287,6 +307,13 @@ int svlVidCapSrcV4L2::Open()
             cout << "-Open: QUERYCAP done - Read method selected" << endl;
 #endif
         }
+        /// Zero-copy hand-off works only on the driver's own buffers
+        if (ZeroCopyInFlight[i] > 0 && (devprops.capabilities & V4L2_CAP_STREAMING) != 0) {
+            CapMethod[i] = MV4LP_METHOD_STREAMING;
+#ifdef __verbose__
+            cout << "-Open: QUERYCAP done - Streaming method selected for zero-copy" << endl;
+#endif
+        }
 
         // Setting input
         if (ioctl(DeviceHandle[i], VIDIOC_S_INPUT, &(InputID[i])) != 0) {
@@ -382,6 +409,10 @@ int svlVidCapSrcV4L2::Open()
 
         // Stride
         CapStride[i] = format.fmt.pix.width * 3;
+        if (ColorSpace[i] == MV4LP_CS_BGR24 && format.fmt.pix.bytesperline > 0) {
+            // Lines may be padded by the driver
+            CapStride[i] = format.fmt.pix.bytesperline;
+        }
 
 #ifdef __verbose__
         cout << "-Open: Image properties: " << CapWidth[i] << "*" << CapHeight[i];
@@ -424,14 +455,12 @@ int svlVidCapSrcV4L2::Open()
 
         if (CapMethod[i] == MV4LP_METHOD_STREAMING) {
             // Streaming I/O
-            // Not yet supported, works for Hauppauge cards, but not XtremeRGB cards
-            //goto labError;
-///*
             struct v4l2_requestbuffers reqbuff;
 
-            // Requesting buffer
+            // Requesting buffer; frames held back for zero-copy
+            // hand-off shall not starve the driver
             memset(&reqbuff, 0, sizeof(v4l2_requestbuffers));
-            reqbuff.count = MV4LP_BUFFER_SIZE_TARGET;
+            reqbuff.count = MV4LP_BUFFER_SIZE_TARGET + ZeroCopyInFlight[i];
             reqbuff.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
             reqbuff.memory = V4L2_MEMORY_MMAP;
             if (ioctl(DeviceHandle[i], VIDIOC_REQBUFS, &reqbuff) != 0) {
@@ -482,7 +511,24 @@ int svlVidCapSrcV4L2::Open()
                 cout << "--Open: buffer " << j << " parameters received" << endl;
 #endif
             }
-//*/
+
+            // Frames in BGR24 without line padding can be handed over to
+            // the stream as they are, at least one buffer is always kept
+            // by the driver and two are needed in flight: the one held by
+            // the stream and the next one captured
+            if (ZeroCopyInFlight[i] > 0) {
+                ZeroCopyInFlight[i] = std::min(ZeroCopyInFlight[i], static_cast<unsigned int>(FrameBufferSize[i] - 1));
+            }
+            if (ZeroCopyInFlight[i] >= 2 &&
+                ColorSpace[i] == MV4LP_CS_BGR24 &&
+                CapStride[i] == CapWidth[i] * 3) {
+                ZeroCopy[i] = true;
+            }
+
+            // HM12 needs an intermediate buffer for reordering
+            if (ColorSpace[i] == MV4LP_CS_HM12) {
+                ScratchBuffer[i] = new unsigned char[CapStride[i] * CapHeight[i]];
+            }
         }
         else {
             // Read/write I/O
@@ -540,6 +586,12 @@ void svlVidCapSrcV4L2::Close()
             FrameBuffer[i] = 0;
         }
 
+        if (ScratchBuffer[i]) {
+            delete [] ScratchBuffer[i];
+            ScratchBuffer[i] = 0;
+        }
+        ZeroCopy[i] = false;
+
         // release output buffers
         if (OutputBuffer[i]) delete OutputBuffer[i];
         OutputBuffer[i] = 0;
@@ -557,6 +609,17 @@ int svlVidCapSrcV4L2::Start()
         if (DeviceHandle[i] < 0) return SVL_FAIL;
     }
 
+    // Hand all buffers over to the drivers
+    for (i = 0; i < NumOfStreams; i ++) {
+        if (CapMethod[i] == MV4LP_METHOD_STREAMING && StartStreaming(i) != SVL_OK) {
+            CMN_LOG_CLASS_INIT_ERROR << "Start: failed to start streaming on channel: " << i << std::endl;
+            for (unsigned int j = 0; j < i; j ++) {
+                if (CapMethod[j] == MV4LP_METHOD_STREAMING) StopStreaming(j);
+            }
+            return SVL_FAIL;
+        }
+    }
+
     Running = true;
     for (i = 0; i < NumOfStreams; i ++) {
         CaptureProc[i] = new svlVidCapSrcV4L2Thread(i);
@@ -597,6 +660,7 @@ int svlVidCapSrcV4L2::Stop()
             delete(CaptureProc[i]);
             CaptureProc[i] = 0;
         }
+        if (CapMethod[i] == MV4LP_METHOD_STREAMING) StopStreaming(i);
     }
 
     return SVL_OK;
@@ -822,6 +886,7 @@ int svlVidCapSrcV4L2::GetFormat(svlFilterSourceVideoCapture::ImageFormat& format
 int svlVidCapSrcV4L2::ReadFrame(unsigned int videoch)
 {
     if (Running == false) return SVL_FAIL;
+    if (CapMethod[videoch] == MV4LP_METHOD_STREAMING) return ReadFrameStreaming(videoch);
 
     unsigned int imlen;
     unsigned char *imbuf = NULL;
@@ -906,30 +971,7 @@ int svlVidCapSrcV4L2::ReadFrame(unsigned int videoch)
             }
         }
 
-        if (ColorSpace[videoch] == MV4LP_CS_UYVY) {
-            // Convert UYVY to BGR24
-            YUV420p_to_BGR24(imbuf, buf1, line, ystride, w, h);
-        }
-        if (ColorSpace[videoch] == MV4LP_CS_YUYV) {
-            // Convert YUYV to BGR24
-            svlConverter::YUV422toRGB24(buf1, imbuf, w*h, true, true, true);
-        }
-        else {
-            // Rescramble HM12 to UYVY
-            unsigned char *buf2 = reinterpret_cast<unsigned char*>(FrameBuffer[videoch][1].start);
-            int planesize = ystride * h;
-
-            HM12_de_macro_y(buf2, buf1, ystride, ystride, h);
-            HM12_de_macro_uv(buf2 + planesize,
-                             buf2 + planesize + planesize / 4,
-                             buf1 + planesize,
-                             ystride / 2,
-                             ystride / 2,
-                             h / 2);
-
-            // Convert UYVY to BGR24
-            YUV420p_to_BGR24(imbuf, buf2, line, ystride, w, h);
-        }
+        ConvertFrame(videoch, buf1, imbuf, reinterpret_cast<unsigned char*>(FrameBuffer[videoch][1].start));
     }
 
     // Add image to the output buffer
@@ -938,6 +980,234 @@ int svlVidCapSrcV4L2::ReadFrame(unsigned int videoch)
 	return error;
 }
 
+int svlVidCapSrcV4L2::ReadFrameStreaming(unsigned int videoch)
+{
+    int index;
+
+    if (DequeueBuffer(videoch, index) != SVL_OK) return SVL_FAIL;
+    // Timed out; the capture thread checks if it needs to stop
+    if (index < 0) return SVL_OK;
+
+    if (ZeroCopy[videoch]) {
+        bool ready;
+
+        BufferCS[videoch].Enter();
+            ReadyBuffers[videoch].push_back(index);
+            // Keep within the in-flight limit by returning the oldest
+            // frames that have not been picked up by the stream
+            const unsigned int locked = (LockedBuffer[videoch] >= 0) ? 1 : 0;
+            while (ReadyBuffers[videoch].size() + locked > ZeroCopyInFlight[videoch]) {
+                QueueBuffer(videoch, ReadyBuffers[videoch].front());
+                ReadyBuffers[videoch].pop_front();
+            }
+            ready = !ReadyBuffers[videoch].empty();
+        BufferCS[videoch].Leave();
+
+        if (ready) NewFrameEvent[videoch].Raise();
+        return SVL_OK;
+    }
+
+    unsigned int imlen;
+    unsigned char *imbuf = OutputBuffer[videoch]->GetPushBuffer(imlen);
+
+    ConvertFrame(videoch,
+                 reinterpret_cast<unsigned char*>(FrameBuffer[videoch][index].start),
+                 imbuf,
+                 ScratchBuffer[videoch]);
+
+    if (QueueBuffer(videoch, index) != SVL_OK) return SVL_FAIL;
+
+    // Add image to the output buffer
+    OutputBuffer[videoch]->Push();
+
+    return SVL_OK;
+}
+
+void svlVidCapSrcV4L2::ConvertFrame(unsigned int videoch, unsigned char* src, unsigned char* dst, unsigned char* scratch)
+{
+    const int w = CapWidth[videoch];
+    const int h = CapHeight[videoch];
+    const int stride = CapStride[videoch];
+    const int line = w * 3;
+    const int ystride = stride / 3;
+
+    if (ColorSpace[videoch] == MV4LP_CS_BGR24) {
+        if (line == stride) {
+            memcpy(dst, src, line * h);
+        }
+        else {
+            for (int j = 0; j < h; j ++) {
+                memcpy(dst, src, line);
+                dst += line;
+                src += stride;
+            }
+        }
+    }
+    else if (ColorSpace[videoch] == MV4LP_CS_UYVY) {
+        // Convert UYVY to BGR24
+        YUV420p_to_BGR24(dst, src, line, ystride, w, h);
+    }
+    else if (ColorSpace[videoch] == MV4LP_CS_YUYV) {
+        // Convert YUYV to BGR24
+        svlConverter::YUV422toRGB24(src, dst, w*h, true, true, true);
+    }
+    else {
+        // Rescramble HM12 to UYVY
+        int planesize = ystride * h;
+
+        HM12_de_macro_y(scratch, src, ystride, ystride, h);
+        HM12_de_macro_uv(scratch + planesize,
+                         scratch + planesize + planesize / 4,
+                         src + planesize,
+                         ystride / 2,
+                         ystride / 2,
+                         h / 2);
+
+        // Convert UYVY to BGR24
+        YUV420p_to_BGR24(dst, scratch, line, ystride, w, h);
+    }
+}
+
+int svlVidCapSrcV4L2::StartStreaming(unsigned int videoch)
+{
+    BufferCS[videoch].Enter();
+        ReadyBuffers[videoch].clear();
+        LockedBuffer[videoch] = -1;
+    BufferCS[videoch].Leave();
+
+    for (int j = 0; j < FrameBufferSize[videoch]; j ++) {
+        if (QueueBuffer(videoch, j) != SVL_OK) return SVL_FAIL;
+    }
+
+    enum v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    if (ioctl(DeviceHandle[videoch], VIDIOC_STREAMON, &type) != 0) {
+        CMN_LOG_CLASS_INIT_ERROR << "StartStreaming: failed to set ioctl VIDIOC_STREAMON" << std::endl;
+        return SVL_FAIL;
+    }
+
+    return SVL_OK;
+}
+
+void svlVidCapSrcV4L2::StopStreaming(unsigned int videoch)
+{
+    // Stream off returns all buffers from the driver
+    enum v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    ioctl(DeviceHandle[videoch], VIDIOC_STREAMOFF, &type);
+
+    BufferCS[videoch].Enter();
+        ReadyBuffers[videoch].clear();
+        LockedBuffer[videoch] = -1;
+    BufferCS[videoch].Leave();
+}
+
+int svlVidCapSrcV4L2::QueueBuffer(unsigned int videoch, int index)
+{
+    struct v4l2_buffer buffer;
+
+    memset(&buffer, 0, sizeof(v4l2_buffer));
+    buffer.index  = index;
+    buffer.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buffer.memory = V4L2_MEMORY_MMAP;
+
+    if (ioctl(DeviceHandle[videoch], VIDIOC_QBUF, &buffer) != 0) {
+        CMN_LOG_CLASS_RUN_ERROR << "QueueBuffer: failed to set ioctl VIDIOC_QBUF" << std::endl;
+        return SVL_FAIL;
+    }
+
+    return SVL_OK;
+}
+
+int svlVidCapSrcV4L2::DequeueBuffer(unsigned int videoch, int& index)
+{
+    const int fd = DeviceHandle[videoch];
+
+    index = -1;
+
+    // Wait with timeout, so that the capture thread can be stopped
+    fd_set fds;
+    FD_ZERO(&fds);
+    FD_SET(fd, &fds);
+
+    struct timeval timeout;
+    timeout.tv_sec  = 0;
+    timeout.tv_usec = MV4LP_FRAME_TIMEOUT * 1000;
+
+    int ret = select(fd + 1, &fds, 0, 0, &timeout);
+    if (ret == 0 || (ret < 0 && errno == EINTR)) return SVL_OK;
+    if (ret < 0) return SVL_FAIL;
+
+    struct v4l2_buffer buffer;
+
+    memset(&buffer, 0, sizeof(v4l2_buffer));
+    buffer.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buffer.memory = V4L2_MEMORY_MMAP;
+
+    if (ioctl(fd, VIDIOC_DQBUF, &buffer) != 0) {
+        if (errno == EAGAIN || errno == EINTR) return SVL_OK;
+        CMN_LOG_CLASS_RUN_ERROR << "DequeueBuffer: failed to set ioctl VIDIOC_DQBUF" << std::endl;
+        return SVL_FAIL;
+    }
+
+    index = buffer.index;
+
+    return SVL_OK;
+}
+
+int svlVidCapSrcV4L2::SetZeroCopy(unsigned int inflight, unsigned int videoch)
+{
+    if (videoch >= NumOfStreams || Initialized) return SVL_FAIL;
+    // Zero means disabled, otherwise the stream holds one buffer while
+    // at least one more is captured
+    if (inflight == 1) return SVL_FAIL;
+    ZeroCopyInFlight[videoch] = inflight;
+    return SVL_OK;
+}
+
+bool svlVidCapSrcV4L2::GetZeroCopy(unsigned int videoch)
+{
+    if (videoch >= NumOfStreams) return false;
+    return ZeroCopy[videoch];
+}
+
+int svlVidCapSrcV4L2::GetLatestFrameRef(bool waitfornew, vctDynamicMatrixRef<unsigned char> & frame, unsigned int videoch)
+{
+    if (videoch >= NumOfStreams || !Initialized || !ZeroCopy[videoch]) return SVL_FAIL;
+
+    int index;
+
+    BufferCS[videoch].Enter();
+        if (waitfornew || !ReadyBuffers[videoch].empty()) {
+            // The stream is done with the frame handed over last time
+            if (LockedBuffer[videoch] >= 0) QueueBuffer(videoch, LockedBuffer[videoch]);
+            LockedBuffer[videoch] = -1;
+        }
+
+        while (waitfornew && ReadyBuffers[videoch].empty()) {
+            BufferCS[videoch].Leave();
+            if (!Running || !NewFrameEvent[videoch].Wait(MV4LP_ZEROCOPY_TIMEOUT)) return SVL_FAIL;
+            BufferCS[videoch].Enter();
+        }
+
+        if (!ReadyBuffers[videoch].empty()) {
+            // Hand over the latest frame, return the stale ones to the driver
+            LockedBuffer[videoch] = ReadyBuffers[videoch].back();
+            ReadyBuffers[videoch].pop_back();
+            while (!ReadyBuffers[videoch].empty()) {
+                QueueBuffer(videoch, ReadyBuffers[videoch].front());
+                ReadyBuffers[videoch].pop_front();
+            }
+        }
+        index = LockedBuffer[videoch];
+    BufferCS[videoch].Leave();
+
+    if (index < 0) return SVL_FAIL;
+
+    frame.SetRef(CapHeight[videoch], CapWidth[videoch] * 3, CapWidth[videoch] * 3, 1,
+                 reinterpret_cast<unsigned char*>(FrameBuffer[videoch][index].start));
+
+    return SVL_OK;
+}
+
 
 void svlVidCapSrcV4L2::Release()
 {
@@ -956,6 +1226,13 @@ void svlVidCapSrcV4L2::Release()
     if (FrameBufferSize) delete [] FrameBufferSize;
     if (FrameBuffer) delete [] FrameBuffer;
     if (OutputBuffer) delete [] OutputBuffer;
+    if (ScratchBuffer) delete [] ScratchBuffer;
+    if (ZeroCopyInFlight) delete [] ZeroCopyInFlight;
+    if (ZeroCopy) delete [] ZeroCopy;
+    if (ReadyBuffers) delete [] ReadyBuffers;
+    if (LockedBuffer) delete [] LockedBuffer;
+    if (BufferCS) delete [] BufferCS;
+    if (NewFrameEvent) delete [] NewFrameEvent;
 
     if (Format) {
         for (unsigned int i = 0; i < NumOfStreams; i ++) {
@@ -980,6 +1257,13 @@ void svlVidCapSrcV4L2::Release()
 	FrameBufferSize = 0;
     FrameBuffer = 0;
     OutputBuffer = 0;
+    ScratchBuffer = 0;
+    ZeroCopyInFlight = 0;
+    ZeroCopy = 0;
+    ReadyBuffers = 0;
+    LockedBuffer = 0;
+    BufferCS = 0;
+    NewFrameEvent = 0;
 }
 
 int svlVidCapSrcV4L2::GetDeviceInputs(int fd, svlFilterSourceVideoCapture::DeviceInfo *deviceinfo)
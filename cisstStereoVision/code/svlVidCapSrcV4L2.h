@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2006 
 
-  (C) Copyright 2006-2007 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -23,6 +23,8 @@ http://www.cisst.org/cisst/license.txt.
 #define _svlVidCapSrcV4L2_h
 
 #include <cisstStereoVision/svlFilterSourceVideoCapture.h>
+#include <cisstOSAbstraction/osaCriticalSection.h>
+#include <deque>
 
 class svlBufferImage;
 class osaThread;
@@ -61,6 +63,10 @@ public:
     int GetFormat(svlFilterSourceVideoCapture::ImageFormat& format, unsigned int videoch = 0);
     int SetFormat(svlFilterSourceVideoCapture::ImageFormat& format, unsigned int videoch = 0);
 
+    int SetZeroCopy(unsigned int inflight, unsigned int videoch = 0);
+    bool GetZeroCopy(unsigned int videoch = 0);
+    int GetLatestFrameRef(bool waitfornew, vctDynamicMatrixRef<unsigned char> & frame, unsigned int videoch = 0);
+
 private:
     unsigned int NumOfStreams;
     bool Initialized;
@@ -80,8 +86,23 @@ private:
     FrameBufferType** FrameBuffer;
     svlBufferImage** OutputBuffer;
     svlFilterSourceVideoCapture::ImageFormat** Format;
+    unsigned char** ScratchBuffer;
+
+    // Zero-copy hand-off of streaming buffers
+    unsigned int* ZeroCopyInFlight;
+    bool* ZeroCopy;
+    std::deque<int>* ReadyBuffers;
+    int* LockedBuffer;
+    osaCriticalSection* BufferCS;
+    osaThreadSignal* NewFrameEvent;
 
     int ReadFrame(unsigned int videoch);
+    int ReadFrameStreaming(unsigned int videoch);
+    void ConvertFrame(unsigned int videoch, unsigned char* src, unsigned char* dst, unsigned char* scratch);
+    int StartStreaming(unsigned int videoch);
+    void StopStreaming(unsigned int videoch);
+    int QueueBuffer(unsigned int videoch, int index);
+    int DequeueBuffer(unsigned int videoch, int& index);
 
     void Release();
     int GetDeviceInputs(int fd, svlFilterSourceVideoCapture::DeviceInfo *deviceinfo);
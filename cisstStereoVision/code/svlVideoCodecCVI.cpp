@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2010
 
-  (C) Copyright 2006-2007 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -20,6 +20,7 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include "svlVideoCodecCVI.h"
+#include <cstddef>
 #include <cisstCommon/cmnGetChar.h>
 #include <cisstStereoVision/svlConverters.h>
 #include <cisstStereoVision/svlSyncPoint.h>
@@ -59,6 +60,7 @@ svlVideoCodecCVI::svlVideoCodecCVI() :
     yuvBufferSize(0),
     comprBuffer(0),
     comprBufferSize(0),
+    ReadStatus(SVL_OK),
     saveBufferSize(0),
     SaveThread(0),
     SaveInitEvent(0),
@@ -74,6 +76,7 @@ svlVideoCodecCVI::svlVideoCodecCVI() :
 
     Config.Level        = 4;
     Config.Differential = 0;
+    Config.RunLength    = 0;
 
     ProcInfoSingleThread.count = 1;
     ProcInfoSingleThread.ID    = 0;
@@ -230,6 +233,8 @@ int svlVideoCodecCVI::Open(const std::string &filename, unsigned int &width, uns
             CMN_LOG_CLASS_INIT_ERROR << "Open: invalid `part count`" << std::endl;
             break;
         }
+        ComprPartOffset.SetSize(PartCount);
+        ComprPartSize.SetSize(PartCount);
 
         DataOffset = File.GetPos();
 
@@ -440,8 +445,12 @@ int svlVideoCodecCVI::Close()
     if (Opened && Writing) {
 
         // Stop data saving thread
-        KillSaveThread = true;
         if (SaveInitialized) {
+            // Wait until the last frame is written, otherwise the
+            // kill request may be picked up before the last frame
+            if (!SaveThreadError) WriteDoneEvent->Wait();
+
+            KillSaveThread = true;
             NewFrameEvent->Raise();
             SaveThread->Wait();
             delete SaveThread;
@@ -653,6 +662,7 @@ svlVideoIO::Compression* svlVideoCodecCVI::GetCompression() const
     // CVI specific settings
     output_data->Level        = Config.Level;
     output_data->Differential = Config.Differential;
+    output_data->RunLength    = Config.RunLength;
 
     return compression;
 }
@@ -699,13 +709,19 @@ int svlVideoCodecCVI::SetCompression(const svlVideoIO::Compression *compression)
     else {
         local_data->Level = Config.Level;
     }
-    if (compression->datasize >= sizeof(CompressionData)) {
+    // Maintaining compatibility with older versions of the structure
+    if (compression->datasize > offsetof(CompressionData, Differential)) {
         Config.Differential = local_data->Differential = input_data->Differential;
     }
     else {
-        // Maintaining compatibility with older versions of the structure
         local_data->Differential = Config.Differential;
     }
+    if (compression->datasize > offsetof(CompressionData, RunLength)) {
+        Config.RunLength = local_data->RunLength = input_data->RunLength;
+    }
+    else {
+        local_data->RunLength = Config.RunLength;
+    }
 
     return SVL_OK;
 }
@@ -734,6 +750,17 @@ int svlVideoCodecCVI::DialogCompression()
         std::cout << "NO" << std::endl;
     }
 
+    std::cout << " # Enable run-length compression (faster, lower ratio) ['y' or other]: ";
+    int runlength = cmnGetChar();
+    if (runlength == 'y' || runlength == 'Y') {
+        runlength = 1;
+        std::cout << "YES" << std::endl;
+    }
+    else {
+        runlength = 0;
+        std::cout << "NO" << std::endl;
+    }
+
     svlVideoIO::ReleaseCompression(Codec);
     unsigned int size = sizeof(svlVideoIO::Compression) - sizeof(unsigned char) + sizeof(CompressionData);
     Codec = reinterpret_cast<svlVideoIO::Compression*>(new unsigned char[size]);
@@ -753,6 +780,7 @@ int svlVideoCodecCVI::DialogCompression()
     // CVI specific settings
     Config.Level        = local_data->Level        = static_cast<unsigned char>(level);
     Config.Differential = local_data->Differential = static_cast<unsigned char>(differential);
+    Config.RunLength    = local_data->RunLength    = static_cast<unsigned char>(runlength);
 
 	return SVL_OK;
 }
@@ -789,144 +817,31 @@ int svlVideoCodecCVI::Read(svlProcInfo* procInfo, svlSampleImage &image, const u
         return SVL_FAIL;
     }
 
-    // Uses only a single thread
-    if (procInfo && procInfo->ID != 0) return SVL_OK;
-
-    // Allocate image buffer if not done yet
-    if (Width  != image.GetWidth(videoch) || Height != image.GetHeight(videoch)) {
-        if (noresize) {
-            CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") unexpected change in image dimensions" << std::endl;
-            return SVL_FAIL;
-        }
-        image.SetSize(videoch, Width, Height);
-    }
-
-    unsigned char* img = image.GetUCharPointer(videoch);
-    unsigned int i, compressedpartsize, offset;
-    unsigned long longsize;
-    long long int len;
-    char strbuffer[32];
-    int ret = SVL_FAIL;
-
-    if (Version > 0) {
-        if (Pos > EndPos) {
-            Pos = 0;
-            return SVL_VID_END_REACHED;
-        }
-
-        // Look up the position in the frame offsets table and move the file pointer
-        if (File.Seek(FrameOffsets[Pos]) != SVL_OK) {
-            CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to seek to frame=" << Pos << std::endl;
-            return SVL_FAIL;
-        }
-
-        if (Pos == 0) {
-            if (Config.Differential) {
-                // Reset previous YUV buffer to all zeros
-                memset(prevYuvBuffer, 0, prevYuvBufferSize);
-            }
-        }
-    }
-    else {
-        if (Pos == 0) {
-            // Go to the beginning of the data, just after the header
-            if (File.Seek(DataOffset) != SVL_OK) {
-                CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to seek to position=" << DataOffset << std::endl;
-                return SVL_FAIL;
-            }
-        }
+    // Single threaded data loading phase
+    _OnSingleThread(procInfo)
+    {
+        ReadStatus = ReadFrame(procInfo, image, videoch, noresize);
     }
 
-    while (1) {
-
-        // Read "frame start marker"
-        len = FrameStartMarker.length();
-        if (File.Read(strbuffer, len) != len) break;
-        strbuffer[FrameStartMarker.length()] = 0;
-        if (FrameStartMarker.compare(strbuffer) != 0) {
-            CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to read `frame start marker`" << std::endl;
-            return SVL_FAIL;
-        }
-
-        // Read "timestamp"
-        len = sizeof(double);
-        if (File.Read(reinterpret_cast<char*>(&Timestamp), len) != len) break;
-        if (Timestamp < 0.0) {
-            CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to read `frame timestamp`" << std::endl;
-            return SVL_FAIL;
-        }
-
-        offset = 0;
-        for (i = 0; i < PartCount; i ++) {
-
-            // Read "compressed part size"
-            len = sizeof(unsigned int);
-            if (File.Read(reinterpret_cast<char*>(&compressedpartsize), len) != len) break;
-            if (compressedpartsize == 0 || compressedpartsize > comprBufferSize) {
-                CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to read `compressed part size`" << std::endl;
-                return SVL_FAIL;
-            }
-
-            // Read compressed frame part
-            len = compressedpartsize;
-            if (File.Read(reinterpret_cast<char*>(comprBuffer), len) != len) break;
-
-            // Decompress frame part
-            longsize = yuvBufferSize - offset;
-            if (uncompress(yuvBuffer + offset, &longsize, comprBuffer, compressedpartsize) != Z_OK) {
-                CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to uncompress data" << std::endl;
-                return SVL_FAIL;
-            }
+    // Synchronize threads
+    _SynchronizeThreads(procInfo);
 
-            if (Config.Differential) {
-                // Decode differential encoded data
-                DiffDecode(yuvBuffer + offset, prevYuvBuffer + offset, yuvBuffer + offset, longsize);
-            }
+    if (ReadStatus != SVL_OK) return (procInfo->ID == 0) ? ReadStatus : SVL_OK;
 
-            // Convert YUV422 planar to RGB format
-            svlConverter::YUV422PtoRGB24(yuvBuffer + offset, img + offset * 3 / 2, longsize >> 1);
+    // Multithreaded decompression phase
+    unsigned char* img = image.GetUCharPointer(videoch);
+    int ret = SVL_OK;
 
-            offset += longsize;
+    for (unsigned int i = procInfo->ID; i < PartCount; i += procInfo->count) {
+        if (DecompressPart(i, img) != SVL_OK) {
+            CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to uncompress data" << std::endl;
+            ret = SVL_FAIL;
+            break;
         }
-        if (i < PartCount) break;
-
-        Pos ++;
-        ret = SVL_OK;
-
-        break;
     }
 
-    if (Version > 0) {
-        if (ret != SVL_OK) {
-            // Video data ended earlier than expected: error
-            if (Pos > 0) {
-                // Set pointer back to the first frame
-                Pos = 0;
-
-                return SVL_VID_END_REACHED;
-            }
-            else {
-                // If it was the first frame, then file is invalid, let it fail
-                CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to read first frame" << std::endl;
-            }
-        }
-    }
-    else {
-        if (ret != SVL_OK) {
-            // End of file reached
-            if (Pos > 0) {
-                // Set pointer back to the first frame
-                EndPos = Pos;
-                Pos = 0;
-                
-                return SVL_VID_END_REACHED;
-            }
-            else {
-                // If it was the first frame, then file is invalid, let it fail
-                CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to read first frame" << std::endl;
-            }
-        }
-    }
+    // Synchronize threads
+    _SynchronizeThreads(procInfo);
 
     return ret;
 }
@@ -981,24 +896,14 @@ int svlVideoCodecCVI::Write(svlProcInfo* procInfo, const svlSampleImage &image,
 
     const unsigned int procid = procInfo->ID;
     const unsigned int proccount = procInfo->count;
-    unsigned int start, end, size, offset;
-    unsigned long comprsize;
-    int compr = Config.Level;
+    unsigned int size, offset;
+    unsigned long comprsize = comprBufferSize / proccount;
 
     // Multithreaded compression phase
-    while (1) {
-
-        // Compute part size and offset
-        size = Height / proccount + 1;
-        comprsize = comprBufferSize / proccount;
-        start = procid * size;
-        if (start >= Height) break;
-        end = start + size;
-        if (end > Height) end = Height;
-        offset = start * Width;
-        size = Width * (end - start);
-        ComprPartOffset[procid] = procid * comprsize;
+    GetPartRange(procid, proccount, offset, size);
+    ComprPartOffset[procid] = procid * comprsize;
 
+    if (size > 0) {
         // Convert RGB to YUV422 planar format
         svlConverter::RGB24toYUV422P(const_cast<unsigned char*>(image.GetUCharPointer(videoch)) + offset * 3, yuvBuffer + offset * 2, size);
 
@@ -1008,17 +913,14 @@ int svlVideoCodecCVI::Write(svlProcInfo* procInfo, const svlSampleImage &image,
             // Encode data using differential coding
             DiffEncode(yuvBuffer + offset, prevYuvBuffer + offset, yuvBuffer + offset, size);
         }
+    }
 
-        // Compress part
-        if (compress2(comprBuffer + ComprPartOffset[procid], &comprsize, yuvBuffer + offset, size, compr) != Z_OK) {
-            err = true;
-            CMN_LOG_CLASS_INIT_ERROR << "Write: (thread=" << procInfo->ID << ") failed to compress data" << std::endl;
-            break;
-        }
-        ComprPartSize[procid] = comprsize;
-
-        break;
+    // Compress part
+    if (CompressPart(yuvBuffer + offset, size, comprBuffer + ComprPartOffset[procid], comprsize) != SVL_OK) {
+        err = true;
+        CMN_LOG_CLASS_INIT_ERROR << "Write: (thread=" << procInfo->ID << ") failed to compress data" << std::endl;
     }
+    ComprPartSize[procid] = comprsize;
 
     // Synchronize threads
     _SynchronizeThreads(procInfo);
@@ -1199,6 +1101,196 @@ void svlVideoCodecCVI::GetKeyFrameEvery(int & key_every) const
     key_every = -1;
 }
 
+int svlVideoCodecCVI::ReadFrame(svlProcInfo* procInfo, svlSampleImage &image, const unsigned int videoch, const bool noresize)
+{
+    // Allocate image buffer if not done yet
+    if (Width  != image.GetWidth(videoch) || Height != image.GetHeight(videoch)) {
+        if (noresize) {
+            CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") unexpected change in image dimensions" << std::endl;
+            return SVL_FAIL;
+        }
+        image.SetSize(videoch, Width, Height);
+    }
+
+    unsigned int i, compressedpartsize, offset;
+    long long int len;
+    char strbuffer[32];
+    int ret = SVL_FAIL;
+
+    if (Version > 0) {
+        if (Pos > EndPos) {
+            Pos = 0;
+            return SVL_VID_END_REACHED;
+        }
+
+        // Look up the position in the frame offsets table and move the file pointer
+        if (File.Seek(FrameOffsets[Pos]) != SVL_OK) {
+            CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to seek to frame=" << Pos << std::endl;
+            return SVL_FAIL;
+        }
+
+        if (Pos == 0) {
+            if (Config.Differential) {
+                // Reset previous YUV buffer to all zeros
+                memset(prevYuvBuffer, 0, prevYuvBufferSize);
+            }
+        }
+    }
+    else {
+        if (Pos == 0) {
+            // Go to the beginning of the data, just after the header
+            if (File.Seek(DataOffset) != SVL_OK) {
+                CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to seek to position=" << DataOffset << std::endl;
+                return SVL_FAIL;
+            }
+        }
+    }
+
+    while (1) {
+
+        // Read "frame start marker"
+        len = FrameStartMarker.length();
+        if (File.Read(strbuffer, len) != len) break;
+        strbuffer[FrameStartMarker.length()] = 0;
+        if (FrameStartMarker.compare(strbuffer) != 0) {
+            CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to read `frame start marker`" << std::endl;
+            return SVL_FAIL;
+        }
+
+        // Read "timestamp"
+        len = sizeof(double);
+        if (File.Read(reinterpret_cast<char*>(&Timestamp), len) != len) break;
+        if (Timestamp < 0.0) {
+            CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to read `frame timestamp`" << std::endl;
+            return SVL_FAIL;
+        }
+
+        offset = 0;
+        for (i = 0; i < PartCount; i ++) {
+
+            // Read "compressed part size"
+            len = sizeof(unsigned int);
+            if (File.Read(reinterpret_cast<char*>(&compressedpartsize), len) != len) break;
+            if (compressedpartsize == 0 || compressedpartsize > comprBufferSize - offset) {
+                CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to read `compressed part size`" << std::endl;
+                return SVL_FAIL;
+            }
+
+            // Read compressed frame part; parts are uncompressed in parallel later
+            len = compressedpartsize;
+            if (File.Read(reinterpret_cast<char*>(comprBuffer + offset), len) != len) break;
+            ComprPartOffset[i] = offset;
+            ComprPartSize[i] = compressedpartsize;
+
+            offset += compressedpartsize;
+        }
+        if (i < PartCount) break;
+
+        Pos ++;
+        ret = SVL_OK;
+
+        break;
+    }
+
+    if (Version > 0) {
+        if (ret != SVL_OK) {
+            // Video data ended earlier than expected: error
+            if (Pos > 0) {
+                // Set pointer back to the first frame
+                Pos = 0;
+
+                return SVL_VID_END_REACHED;
+            }
+            else {
+                // If it was the first frame, then file is invalid, let it fail
+                CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to read first frame" << std::endl;
+            }
+        }
+    }
+    else {
+        if (ret != SVL_OK) {
+            // End of file reached
+            if (Pos > 0) {
+                // Set pointer back to the first frame
+                EndPos = Pos;
+                Pos = 0;
+                
+                return SVL_VID_END_REACHED;
+            }
+            else {
+                // If it was the first frame, then file is invalid, let it fail
+                CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to read first frame" << std::endl;
+            }
+        }
+    }
+
+    return ret;
+}
+
+void svlVideoCodecCVI::GetPartRange(const unsigned int part, const unsigned int partcount, unsigned int &offset, unsigned int &size) const
+{
+    // Frames are split into horizontal stripes, one per part; the
+    // last stripes may be shorter or empty
+    const unsigned int rows = Height / partcount + 1;
+    const unsigned int start = part * rows;
+    unsigned int end = start + rows;
+
+    if (start >= Height) {
+        offset = size = 0;
+        return;
+    }
+    if (end > Height) end = Height;
+
+    offset = start * Width;
+    size = (end - start) * Width;
+}
+
+int svlVideoCodecCVI::CompressPart(const unsigned char* input, const unsigned int size, unsigned char* output, unsigned long &outputsize) const
+{
+    // Same as compress2() with a configurable strategy; both produce
+    // regular zlib streams, thus the decoder does not need to know
+    z_stream stream;
+    memset(&stream, 0, sizeof(z_stream));
+
+    if (deflateInit2(&stream, Config.Level, Z_DEFLATED, MAX_WBITS, 8,
+                     Config.RunLength ? Z_RLE : Z_DEFAULT_STRATEGY) != Z_OK) return SVL_FAIL;
+
+    stream.next_in   = const_cast<Bytef*>(input);
+    stream.avail_in  = size;
+    stream.next_out  = output;
+    stream.avail_out = static_cast<uInt>(outputsize);
+
+    const int ret = deflate(&stream, Z_FINISH);
+    outputsize = stream.total_out;
+    deflateEnd(&stream);
+
+    return (ret == Z_STREAM_END) ? SVL_OK : SVL_FAIL;
+}
+
+int svlVideoCodecCVI::DecompressPart(const unsigned int part, unsigned char* image)
+{
+    unsigned int offset, size;
+    GetPartRange(part, PartCount, offset, size);
+    if (size == 0) return SVL_OK;
+
+    // YUV422: 2 bytes per pixel
+    offset <<= 1; size <<= 1;
+
+    unsigned long longsize = size;
+    if (uncompress(yuvBuffer + offset, &longsize, comprBuffer + ComprPartOffset[part], ComprPartSize[part]) != Z_OK ||
+        longsize != size) return SVL_FAIL;
+
+    if (Config.Differential) {
+        // Decode differential encoded data
+        DiffDecode(yuvBuffer + offset, prevYuvBuffer + offset, yuvBuffer + offset, size);
+    }
+
+    // Convert YUV422 planar to RGB format
+    svlConverter::YUV422PtoRGB24(yuvBuffer + offset, image + offset * 3 / 2, size >> 1);
+
+    return SVL_OK;
+}
+
 void svlVideoCodecCVI::DiffEncode(unsigned char* input, unsigned char* previous, unsigned char* output, const unsigned int size)
 {
     if (!input || !previous || !output || !size) return;
@@ -1312,6 +1404,8 @@ void* svlVideoCodecCVI::SaveProc(int CMN_UNUSED(param))
         if (File.Write(reinterpret_cast<char*>(saveBuffer[SaveBufferUsedID]), len) != len) {
             SaveThreadError = true;
             CMN_LOG_CLASS_INIT_ERROR << "SaveProc: failed to write compressed data" << std::endl;
+            // Release threads waiting for the write to complete
+            WriteDoneEvent->Raise();
             return this;
         }
 
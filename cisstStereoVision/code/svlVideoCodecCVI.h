@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2010
 
-  (C) Copyright 2006-2007 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -39,6 +39,7 @@ public:
     typedef struct _CompressionData {
         unsigned char Level;
         unsigned char Differential;
+        unsigned char RunLength;    // run-length only deflate (Z_RLE), faster, same file format
     } CompressionData;
 
 public:
@@ -122,6 +123,7 @@ protected:
     unsigned int comprBufferSize;
     vctDynamicVector<unsigned int> ComprPartOffset;
     vctDynamicVector<unsigned int> ComprPartSize;
+    int ReadStatus;
 
     vctFixedSizeVector<unsigned char*, 2> saveBuffer;
     unsigned int saveBufferSize;
@@ -137,6 +139,11 @@ protected:
 
     svlProcInfo ProcInfoSingleThread;
 
+    int ReadFrame(svlProcInfo* procInfo, svlSampleImage &image, const unsigned int videoch, const bool noresize);
+    void GetPartRange(const unsigned int part, const unsigned int partcount, unsigned int &offset, unsigned int &size) const;
+    int CompressPart(const unsigned char* input, const unsigned int size, unsigned char* output, unsigned long &outputsize) const;
+    int DecompressPart(const unsigned int part, unsigned char* image);
+
     void DiffEncode(unsigned char* input, unsigned char* previous, unsigned char* output, const unsigned int size);
     void DiffDecode(unsigned char* input, unsigned char* previous, unsigned char* output, const unsigned int size);
 
@@ -0,0 +1,239 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include "svlVideoFrameCache.h"
+#include <cstdlib>
+#include <cstring>
+
+
+/*************************************/
+/*** svlVideoFrameCache class ********/
+/*************************************/
+
+svlVideoFrameCache::svlVideoFrameCache(svlVideoCodecBase* codec, const unsigned int readahead, const unsigned int cachesize) :
+    Codec(codec),
+    EndPos(codec->GetEndPos()),
+    ReadAhead(std::max(readahead, 1u)),
+    Pos(codec->GetPos()),
+    LastPos(-1),
+    Direction(1),
+    Timestamp(-1.0),
+    KillThread(false)
+{
+    Frames.SetSize(std::max(cachesize, ReadAhead));
+    for (unsigned int i = 0; i < Frames.size(); i ++) {
+        Frames[i] = new Frame;
+        Frames[i]->Position = -1;
+        Frames[i]->Status = SVL_FAIL;
+        Frames[i]->Timestamp = -1.0;
+    }
+
+    Thread.Create<svlVideoFrameCache, int>(this, &svlVideoFrameCache::Proc, 0);
+}
+
+svlVideoFrameCache::~svlVideoFrameCache()
+{
+    CS.Enter();
+        KillThread = true;
+    CS.Leave();
+    RequestEvent.Raise();
+    Thread.Wait();
+
+    for (unsigned int i = 0; i < Frames.size(); i ++) delete Frames[i];
+}
+
+int svlVideoFrameCache::GetPos() const
+{
+    // Pos is updated by SetPos and by the read-ahead thread
+    CS.Enter();
+        const int pos = Pos;
+    CS.Leave();
+    return pos;
+}
+
+int svlVideoFrameCache::SetPos(const int pos)
+{
+    if (pos < 0 || pos > EndPos) return SVL_FAIL;
+
+    CS.Enter();
+        Pos = pos;
+        LastPos = -1;
+    CS.Leave();
+    RequestEvent.Raise();
+
+    return SVL_OK;
+}
+
+void svlVideoFrameCache::SetReverse(const bool reverse)
+{
+    const int direction = reverse ? -1 : 1;
+
+    CS.Enter();
+        if (direction != Direction) {
+            Direction = direction;
+            // Continue from the last frame played, in the other direction
+            if (LastPos >= 0) Pos = LastPos + Direction;
+        }
+    CS.Leave();
+    RequestEvent.Raise();
+}
+
+double svlVideoFrameCache::GetTimestamp() const
+{
+    return Timestamp;
+}
+
+int svlVideoFrameCache::Read(svlSampleImage &image, const unsigned int videoch)
+{
+    if (videoch >= image.GetVideoChannels()) return SVL_FAIL;
+
+    int pos, idx, ret = SVL_FAIL;
+
+    while (1) {
+        CS.Enter();
+            // Position may be changed by SetPos while waiting
+            pos = Pos;
+            if (pos < 0 || pos > EndPos) {
+                // Playback ran past the end of the video: rewind
+                Pos = (Direction > 0) ? 0 : EndPos;
+                LastPos = -1;
+                CS.Leave();
+                RequestEvent.Raise();
+                return SVL_VID_END_REACHED;
+            }
+
+            idx = FindFrame(pos);
+            if (idx >= 0) {
+                Frame* frame = Frames[idx];
+                ret = frame->Status;
+                if (ret == SVL_OK) {
+                    if (image.GetWidth(videoch)  != frame->Image.GetWidth() ||
+                        image.GetHeight(videoch) != frame->Image.GetHeight()) {
+                        ret = SVL_FAIL;
+                    }
+                    else {
+                        memcpy(image.GetUCharPointer(videoch), frame->Image.GetUCharPointer(), frame->Image.GetDataSize());
+                        Timestamp = frame->Timestamp;
+                    }
+                }
+                LastPos = pos;
+                Pos = pos + Direction;
+            }
+        CS.Leave();
+
+        // Let the decoder thread move on
+        RequestEvent.Raise();
+
+        if (idx >= 0) break;
+
+        // Wait for the next decoded frame
+        FrameEvent.Wait();
+    }
+
+    return ret;
+}
+
+int svlVideoFrameCache::FindFrame(const int pos) const
+{
+    for (unsigned int i = 0; i < Frames.size(); i ++) {
+        if (Frames[i]->Position == pos) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+int svlVideoFrameCache::FindNextPosition() const
+{
+    // First frame of the read-ahead window that is not decoded yet;
+    // the window wraps around to support looped playback
+    const int length = EndPos + 1;
+    int pos = Pos;
+
+    if (pos < 0 || pos > EndPos) pos = (Direction > 0) ? 0 : EndPos;
+    for (unsigned int i = 0; i < ReadAhead && i < static_cast<unsigned int>(length); i ++) {
+        if (FindFrame(pos) < 0) return pos;
+        pos = (pos + Direction + length) % length;
+    }
+    return -1;
+}
+
+int svlVideoFrameCache::FindFreeFrame() const
+{
+    // Empty slot, or the frame farthest from the playback position
+    // out of the read-ahead window
+    const int length = EndPos + 1;
+    int i, distance, maxdistance = -1, idx = 0;
+
+    for (i = 0; i < static_cast<int>(Frames.size()); i ++) {
+        if (Frames[i]->Position < 0) return i;
+
+        if (((Frames[i]->Position - Pos) * Direction + length) % length < static_cast<int>(ReadAhead)) continue;
+
+        distance = std::abs(Frames[i]->Position - Pos);
+        if (distance > maxdistance) {
+            maxdistance = distance;
+            idx = i;
+        }
+    }
+
+    return idx;
+}
+
+void* svlVideoFrameCache::Proc(int CMN_UNUSED(param))
+{
+    int pos, idx, status;
+
+    while (1) {
+
+        CS.Enter();
+            if (KillThread) {
+                CS.Leave();
+                break;
+            }
+            pos = FindNextPosition();
+            idx = -1;
+            if (pos >= 0) {
+                idx = FindFreeFrame();
+                Frames[idx]->Position = -1;
+            }
+        CS.Leave();
+
+        if (pos < 0) {
+            // Read-ahead window complete; wait for the playback to move
+            RequestEvent.Wait();
+            continue;
+        }
+
+        // Decoding outside of the critical section
+        Frame* frame = Frames[idx];
+        status = SVL_OK;
+        if (Codec->GetPos() != pos) status = Codec->SetPos(pos);
+        if (status == SVL_OK) status = Codec->Read(0, frame->Image, 0, false);
+
+        CS.Enter();
+            frame->Position = pos;
+            frame->Status = status;
+            frame->Timestamp = Codec->GetTimestamp();
+        CS.Leave();
+        FrameEvent.Raise();
+    }
+
+    return this;
+}
+
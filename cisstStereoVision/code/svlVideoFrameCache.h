@@ -0,0 +1,92 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#ifndef _svlVideoFrameCache_h
+#define _svlVideoFrameCache_h
+
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaThreadSignal.h>
+#include <cisstOSAbstraction/osaCriticalSection.h>
+#include <cisstStereoVision/svlVideoIO.h>
+#include <cisstStereoVision/svlTypes.h>
+
+
+/*
+  Decodes the frames of a seekable video file on a separate thread,
+  ahead of the playback position, and keeps the decoded frames in a
+  cache indexed by frame position.  The next `readahead` frames in
+  the playback direction are decoded in advance; the cache holds
+  `cachesize` frames, the remaining slots keeping the frames most
+  recently played so that stepping back or scrubbing around the
+  current position does not require decoding.
+
+  Mimics the position management of svlVideoCodecBase: GetPos returns
+  the position of the next frame to be read, Read returns
+  SVL_VID_END_REACHED and rewinds when playback runs past either end
+  of the video.  The codec shall not be used by anyone else while the
+  cache exists.
+*/
+class svlVideoFrameCache
+{
+public:
+    svlVideoFrameCache(svlVideoCodecBase* codec, const unsigned int readahead, const unsigned int cachesize);
+    ~svlVideoFrameCache();
+
+    int GetPos() const;
+    int SetPos(const int pos);
+    void SetReverse(const bool reverse);
+    double GetTimestamp() const;
+
+    int Read(svlSampleImage &image, const unsigned int videoch);
+
+private:
+    typedef struct _Frame
+    {
+        int Position;   // -1 if empty
+        int Status;
+        double Timestamp;
+        svlSampleImageRGB Image;
+    } Frame;
+
+    svlVideoCodecBase* Codec;
+    const int EndPos;
+    const unsigned int ReadAhead;
+    vctDynamicVector<Frame*> Frames;
+
+    int Pos;
+    int LastPos;
+    int Direction;
+    double Timestamp;
+
+    osaThread Thread;
+    osaThreadSignal RequestEvent;
+    osaThreadSignal FrameEvent;
+    mutable osaCriticalSection CS;
+    bool KillThread;
+
+    int FindFrame(const int pos) const;
+    int FindNextPosition() const;
+    int FindFreeFrame() const;
+
+    void* Proc(int param);
+};
+
+#endif // _svlVideoFrameCache_h
+
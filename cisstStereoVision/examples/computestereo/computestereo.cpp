@@ -5,7 +5,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2007
 
-  (C) Copyright 2006-2014 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -55,6 +55,7 @@ using namespace std;
 //////////////////////////////////
 
 int ComputeStereo(const char* filepath1, const char* filepath2,
+                  svlFilterComputationalStereo::StereoMethod method,
                   int mindisparity, int maxdisparity, int smoothness, int blocksize, bool subpixel_precision, bool xcheck)
 {
     cerr << "Please wait while initializing... ";
@@ -108,6 +109,7 @@ int ComputeStereo(const char* filepath1, const char* filepath2,
 
     stereo.SetROI(5, 5, srcwidth - maxdisparity, srcheight - 5);
 
+    stereo.SetMethod(method);
     stereo.SetCrossCheck(xcheck);
     stereo.SetSubpixelPrecision(subpixel_precision);
     stereo.SetDisparityRange(mindisparity, maxdisparity);
@@ -137,10 +139,14 @@ int ComputeStereo(const char* filepath1, const char* filepath2,
     if (stream.Play() != SVL_OK) goto labError;
 
     cerr << "Done" << endl << endl << "Keyboard commands:" << endl << endl;
+    cerr << "    't' - Print processing time of the last frame" << endl;
     cerr << "    'q' - Quit" << endl;
 
     int ch;
-    do ch = cmnGetChar(); while (ch != 'q');
+    do {
+        ch = cmnGetChar();
+        if (ch == 't') cerr << "Processing time: " << stereo.GetProcessingTime() * 1000.0 << " ms" << endl;
+    } while (ch != 'q');
 
     cerr << endl;
 
@@ -162,8 +168,9 @@ int main(int CMN_UNUSED(argc), char** CMN_UNUSED(argv))
     cerr << endl << "svlExComputeStereo - cisstStereoVision example by Balazs Vagvolgyi" << endl;
     cerr << "See http://www.cisst.org/cisst for details." << endl << endl;
 
-    //ComputeStereo("venus_l",  "venus_r",  0, 20, 80, 1, false, true);
-    ComputeStereo("tsukuba3", "tsukuba4", 0, 16, 40, 1, false, true);
+    //ComputeStereo("venus_l",  "venus_r",  svlFilterComputationalStereo::DynamicProgramming, 0, 20, 80, 1, false, true);
+    //ComputeStereo("tsukuba3", "tsukuba4", svlFilterComputationalStereo::SemiGlobalMatching, 0, 16, 8, 1, true, true);
+    ComputeStereo("tsukuba3", "tsukuba4", svlFilterComputationalStereo::DynamicProgramming, 0, 16, 40, 1, false, true);
 
     cerr << "Quit" << endl;
     return 1;
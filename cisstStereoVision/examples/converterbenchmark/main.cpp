@@ -0,0 +1,136 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+/*
+  Measures the throughput (in mega pixels per second) of the color
+  space converters with SIMD versions (see
+  svlConverter::SIMDInstructionSet) for each instruction set supported
+  by the CPU, and checks that all instruction sets produce the same
+  output as the scalar code.  Usage:
+    svlExConverterBenchmark [width height [iterations]]
+*/
+
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstStereoVision/svlConverters.h>
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+enum ConversionType {
+    YUV422toRGB24, UYVYtoRGB24, NV21toRGB24, RGB24toYUV422, BGR24toYUV422, RGB24toGray8, RGB24toGray8Accurate
+};
+
+const char * ConversionNames[] = {
+    "YUV422toRGB24", "UYVYtoRGB24", "NV21toRGB24", "RGB24toYUV422", "BGR24toYUV422", "RGB24toGray8", "RGB24toGray8 (accurate)"
+};
+
+void Convert(ConversionType type, unsigned char * input, unsigned char * output,
+             unsigned int width, unsigned int height)
+{
+    const unsigned int pixelcount = width * height;
+    switch (type) {
+        case YUV422toRGB24:        svlConverter::YUV422toRGB24(input, output, pixelcount); break;
+        case UYVYtoRGB24:          svlConverter::UYVYtoRGB24(input, output, pixelcount); break;
+        case NV21toRGB24:          svlConverter::NV21toRGB24(input, output, width, height); break;
+        case RGB24toYUV422:        svlConverter::RGB24toYUV422(input, output, pixelcount); break;
+        case BGR24toYUV422:        svlConverter::BGR24toYUV422(input, output, pixelcount); break;
+        case RGB24toGray8:         svlConverter::RGB24toGray8(input, output, pixelcount, false, false); break;
+        case RGB24toGray8Accurate: svlConverter::RGB24toGray8(input, output, pixelcount, true, false); break;
+    }
+}
+
+unsigned int OutputSize(ConversionType type, unsigned int pixelcount)
+{
+    switch (type) {
+        case RGB24toYUV422:
+        case BGR24toYUV422:        return pixelcount * 2;
+        case RGB24toGray8:
+        case RGB24toGray8Accurate: return pixelcount;
+        default:                   return pixelcount * 3;
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    unsigned int width = 1920, height = 1080, iterations = 100;
+    if (argc > 2) {
+        width = static_cast<unsigned int>(atoi(argv[1]));
+        height = static_cast<unsigned int>(atoi(argv[2]));
+    }
+    if (argc > 3) iterations = static_cast<unsigned int>(atoi(argv[3]));
+    if (width < 2) width = 2;
+    if (height < 2) height = 2;
+    if (iterations == 0) iterations = 1;
+
+    const unsigned int pixelcount = width * height;
+    const svlConverter::SIMDInstructionSet supported = svlConverter::SetSIMDInstructionSet(svlConverter::SIMDAVX2);
+    std::cout << "Image: " << width << "x" << height
+              << ", iterations: " << iterations
+              << ", instruction set: " << svlConverter::GetSIMDInstructionSetName(supported) << std::endl
+              << std::endl
+              << std::setw(24) << "conversion";
+    int set;
+    for (set = svlConverter::SIMDNone; set <= supported; set ++) {
+        std::cout << std::setw(12) << svlConverter::GetSIMDInstructionSetName(static_cast<svlConverter::SIMDInstructionSet>(set)) << " MP/s";
+    }
+    std::cout << std::endl;
+
+    // Random input, large enough for all conversions
+    std::vector<unsigned char> input(pixelcount * 3);
+    srand(0);
+    for (unsigned int i = 0; i < input.size(); i ++) {
+        input[i] = static_cast<unsigned char>(rand() & 0xFF);
+    }
+    std::vector<unsigned char> reference(pixelcount * 3), output(pixelcount * 3);
+
+    int errors = 0;
+    for (int type = YUV422toRGB24; type <= RGB24toGray8Accurate; type ++) {
+        const ConversionType conversion = static_cast<ConversionType>(type);
+        const unsigned int size = OutputSize(conversion, pixelcount);
+        std::cout << std::setw(24) << ConversionNames[type];
+        for (set = svlConverter::SIMDNone; set <= supported; set ++) {
+            svlConverter::SetSIMDInstructionSet(static_cast<svlConverter::SIMDInstructionSet>(set));
+            std::vector<unsigned char> & result = (set == svlConverter::SIMDNone) ? reference : output;
+            memset(&(result[0]), 0, result.size());
+
+            const double start = osaGetTime();
+            for (unsigned int i = 0; i < iterations; i ++) {
+                Convert(conversion, &(input[0]), &(result[0]), width, height);
+            }
+            const double elapsed = osaGetTime() - start;
+
+            std::cout << std::fixed << std::setprecision(1)
+                      << std::setw(17) << pixelcount * 1.0e-6 * iterations / elapsed;
+            if (set != svlConverter::SIMDNone && memcmp(&(reference[0]), &(output[0]), size) != 0) {
+                std::cout << " (different)";
+                errors ++;
+            }
+        }
+        std::cout << std::endl;
+    }
+    svlConverter::SetSIMDInstructionSet(svlConverter::SIMDAVX2);
+
+    if (errors) {
+        std::cout << errors << " conversion(s) differ from the scalar implementation" << std::endl;
+        return 1;
+    }
+    return 0;
+}
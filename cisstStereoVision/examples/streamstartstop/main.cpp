@@ -0,0 +1,158 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+/*
+  Stress test for the start and stop of multi-threaded streams.  A
+  stream with a few filters is started and stopped in a loop, after a
+  random delay, so Stop is called at any point of the processing,
+  including while threads are waiting on the svlSyncPoint barriers.
+  A watchdog thread reports an error if a cycle doesn't complete in
+  time.  Usage:
+    svlExStreamStartStop [cycles [threads [spin|event]]]
+*/
+
+#include <cisstCommon/cmnRandomSequence.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaSleep.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstStereoVision/svlInitializer.h>
+#include <cisstStereoVision/svlStreamManager.h>
+#include <cisstStereoVision/svlFilterOutput.h>
+#include <cisstStereoVision/svlFilterSourceDummy.h>
+#include <cisstStereoVision/svlFilterImageResizer.h>
+#include <cisstStereoVision/svlFilterImageFlipRotate.h>
+#include <cisstStereoVision/svlFilterImageExposureCorrection.h>
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <atomic>
+
+// Maximum time for one cycle (Play, delay and Stop), in seconds
+#define WATCHDOG_TIMEOUT    10.0
+
+class Watchdog
+{
+public:
+    std::atomic<unsigned int> Cycle;
+    std::atomic<bool> Done;
+
+    Watchdog():
+        Cycle(0),
+        Done(false)
+    {}
+
+    void * Run(int)
+    {
+        unsigned int lastCycle = Cycle;
+        double lastChange = osaGetTime();
+        while (!Done) {
+            osaSleep(0.1);
+            if (Cycle != lastCycle) {
+                lastCycle = Cycle;
+                lastChange = osaGetTime();
+            }
+            else if (osaGetTime() - lastChange > WATCHDOG_TIMEOUT) {
+                std::cout << std::endl << "Error: stream stuck in cycle " << lastCycle << std::endl;
+                std::_Exit(1);
+            }
+        }
+        return this;
+    }
+};
+
+int main(int argc, char ** argv)
+{
+    unsigned int cycles = 1000;
+    unsigned int threads = 4;
+    svlSyncMethod method = svlSyncSpin;
+    if (argc > 1) cycles = static_cast<unsigned int>(atoi(argv[1]));
+    if (argc > 2) threads = static_cast<unsigned int>(atoi(argv[2]));
+    if (argc > 3 && strcmp(argv[3], "event") == 0) method = svlSyncEvent;
+    if (threads < 2) threads = 2;
+
+    svlInitialize();
+
+    svlStreamManager stream(threads);
+    svlFilterSourceDummy source;
+    svlFilterImageExposureCorrection exposure;
+    svlFilterImageFlipRotate flip;
+    svlFilterImageResizer resizer;
+
+    // Fast source so the stream spends most of its time in the filters
+    source.SetType(svlTypeImageRGB);
+    source.SetDimensions(640, 480);
+    source.EnableNoiseImage(true);
+    source.SetTargetFrequency(1000.0);
+    exposure.SetGamma(1.5);
+    flip.SetHorizontalFlip(true);
+    resizer.SetOutputRatio(0.5, 0.5);
+
+    stream.SetSyncMethod(method);
+    stream.SetSourceFilter(&source);
+    source.GetOutput()->Connect(exposure.GetInput());
+    exposure.GetOutput()->Connect(flip.GetInput());
+    flip.GetOutput()->Connect(resizer.GetInput());
+
+    std::cout << "Starting and stopping a stream with " << threads << " threads ("
+              << (method == svlSyncSpin ? "spin" : "event") << " synchronization) "
+              << cycles << " times" << std::endl;
+
+    Watchdog watchdog;
+    osaThread watchdogThread;
+    watchdogThread.Create<Watchdog, int>(&watchdog, &Watchdog::Run, 0);
+
+    cmnRandomSequence & random = cmnRandomSequence::GetInstance();
+    double maxStopTime = 0.0;
+    int errors = 0;
+    for (unsigned int i = 0; i < cycles; i ++) {
+        if (stream.Play() != SVL_OK) {
+            errors ++;
+            std::cout << "Error: Play failed in cycle " << i << std::endl;
+        }
+        // From right after Play to a few frames
+        osaSleep(random.ExtractRandomDouble(0.0, 0.01));
+
+        const double start = osaGetTime();
+        stream.Stop();
+        const double stopTime = osaGetTime() - start;
+        if (stopTime > maxStopTime) maxStopTime = stopTime;
+        if (stream.IsRunning()) {
+            errors ++;
+            std::cout << "Error: stream still running after Stop in cycle " << i << std::endl;
+        }
+
+        watchdog.Cycle = i + 1;
+        if ((i + 1) % 100 == 0) {
+            std::cout << (i + 1) << " cycles, longest Stop: " << maxStopTime * 1000.0 << " ms" << std::endl;
+        }
+    }
+
+    watchdog.Done = true;
+    watchdogThread.Wait();
+
+    stream.Release();
+    stream.DisconnectAll();
+
+    if (errors) {
+        std::cout << errors << " error(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "No error" << std::endl;
+    return 0;
+}
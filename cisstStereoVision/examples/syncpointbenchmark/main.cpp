@@ -0,0 +1,132 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+/*
+  Measures the cost of svlSyncPoint::Sync for both synchronization
+  methods (svlSyncEvent and svlSyncSpin) and different numbers of
+  threads.  Each thread performs a fixed amount of work (busy loop)
+  between synchronizations, similar to a filter processing a slice of
+  an image.  Usage:
+    svlExSyncPointBenchmark [iterations [work in micro seconds]]
+*/
+
+#include <cisstCommon/cmnUnits.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstOSAbstraction/osaCPUAffinity.h>
+#include <cisstStereoVision/svlSyncPoint.h>
+#include <cisstStereoVision/svlDefinitions.h>
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <vector>
+
+class BenchmarkThread
+{
+public:
+    svlSyncPoint * Sync;
+    unsigned int ID;
+    unsigned int Iterations;
+    double Work;
+    int Errors;
+
+    void * Run(int)
+    {
+        Errors = 0;
+        for (unsigned int i = 0; i < Iterations; i ++) {
+            if (Work > 0.0) {
+                const double end = osaGetTime() + Work;
+                while (osaGetTime() < end) {}
+            }
+            if (Sync->Sync(ID) != SVL_SYNC_OK) Errors ++;
+        }
+        return this;
+    }
+};
+
+double Measure(svlSyncMethod method, unsigned int threadCount,
+               unsigned int iterations, double work, int & errors)
+{
+    svlSyncPoint sync;
+    sync.Count(threadCount);
+    sync.Method(method);
+
+    std::vector<BenchmarkThread> benchmarks(threadCount);
+    std::vector<osaThread *> threads(threadCount);
+    unsigned int i;
+
+    const double start = osaGetTime();
+    for (i = 0; i < threadCount; i ++) {
+        benchmarks[i].Sync = &sync;
+        benchmarks[i].ID = i;
+        benchmarks[i].Iterations = iterations;
+        benchmarks[i].Work = work;
+        threads[i] = new osaThread;
+        threads[i]->Create<BenchmarkThread, int>(&(benchmarks[i]), &BenchmarkThread::Run, 0);
+    }
+    errors = 0;
+    for (i = 0; i < threadCount; i ++) {
+        threads[i]->Wait();
+        delete threads[i];
+        errors += benchmarks[i].Errors;
+    }
+    const double elapsed = osaGetTime() - start;
+
+    // Time per synchronization, minus the work performed by each thread
+    return elapsed / iterations - work;
+}
+
+int main(int argc, char ** argv)
+{
+    unsigned int iterations = 20000;
+    double work = 0.0;
+    if (argc > 1) iterations = static_cast<unsigned int>(atoi(argv[1]));
+    if (argc > 2) work = atof(argv[2]) * cmn_us;
+    if (iterations == 0) iterations = 1;
+
+    const int cpuCount = osaCPUGetCount();
+    std::cout << "CPUs: " << cpuCount
+              << ", iterations: " << iterations
+              << ", work per thread and iteration: " << work / cmn_us << " us" << std::endl
+              << std::endl
+              << "threads   event (us)   spin (us)" << std::endl;
+
+    unsigned int maxThreads = static_cast<unsigned int>(std::max(cpuCount, 2));
+    int errors, totalErrors = 0;
+    for (unsigned int threadCount = 2; threadCount <= maxThreads; threadCount *= 2) {
+        const double event = Measure(svlSyncEvent, threadCount, iterations, work, errors);
+        totalErrors += errors;
+        const double spin = Measure(svlSyncSpin, threadCount, iterations, work, errors);
+        totalErrors += errors;
+        std::cout << std::setw(7) << threadCount
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(13) << event / cmn_us
+                  << std::setw(12) << spin / cmn_us << std::endl;
+        // Make sure the number of CPUs is tested even if not a power of 2
+        if (threadCount < maxThreads && threadCount * 2 > maxThreads) {
+            threadCount = maxThreads / 2;
+        }
+    }
+
+    if (totalErrors) {
+        std::cout << "Sync returned " << totalErrors << " error(s)" << std::endl;
+        return 1;
+    }
+    return 0;
+}
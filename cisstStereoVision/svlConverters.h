@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2007 
 
-  (C) Copyright 2006-2007 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -30,6 +30,22 @@ http://www.cisst.org/cisst/license.txt.
 
 namespace svlConverter
 {
+    /*!
+      Instruction sets used by the optimized versions of the most
+      frequently used converters (YUV422toRGB24, UYVYtoRGB24,
+      NV21toRGB24, RGB24toYUV422, BGR24toYUV422 and RGB24toGray8).
+      The best instruction set supported by the CPU is selected at run
+      time.  Results are identical to the scalar implementation.
+    */
+    enum SIMDInstructionSet {SIMDNone = 0, SIMDSSE2, SIMDAVX2};
+
+    /*! Limits the instruction set used by the optimized converters,
+        mostly for benchmarking.  Returns the instruction set actually
+        used, which also depends on the CPU and the compiler. */
+    CISST_EXPORT SIMDInstructionSet SetSIMDInstructionSet(SIMDInstructionSet maxset);
+    CISST_EXPORT SIMDInstructionSet GetSIMDInstructionSet();
+    CISST_EXPORT std::string GetSIMDInstructionSetName(SIMDInstructionSet set);
+
     CISST_EXPORT int ConvertSample(const svlSample* inimage, svlSample* outimage,
                                    unsigned int threads = 1, unsigned int threadid = 0);
     CISST_EXPORT int ConvertImage(const svlSampleImage* inimage, svlSampleImage* outimage,
@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2006 
 
-  (C) Copyright 2006-2007 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -38,6 +38,14 @@ public:
     virtual int Initialize() = 0;
     virtual int Process(svlSampleImage * images, int * depthmap) = 0;
     virtual void Free() = 0;
+
+    // Called from all stream threads by methods sharing the work
+    // between threads; by default the first thread processes the frame
+    virtual int ProcessMT(svlProcInfo * procInfo, svlSampleImage * images, int * depthmap)
+    {
+        if (procInfo->ID == 0) return Process(images, depthmap);
+        return 0;
+    }
 };
 
 class CISST_EXPORT svlFilterComputationalStereo : public svlFilterBase
@@ -46,12 +54,19 @@ class CISST_EXPORT svlFilterComputationalStereo : public svlFilterBase
 
 public:
     enum StereoMethod {
-        DynamicProgramming
+        DynamicProgramming,
+        SemiGlobalMatching
     };
 
     svlFilterComputationalStereo();
     virtual ~svlFilterComputationalStereo();
 
+    /*! Sets the disparity estimation method, default is DynamicProgramming.
+        SemiGlobalMatching uses 5x5 census costs and splits the rows
+        between all stream threads; it ignores the block size, scaling
+        factor, quick search radius and temporal filtering parameters.
+        Returns SVL_FAIL if the filter is already initialized. */
+    int  SetMethod(StereoMethod method);
     int  SetCameraGeometry(const svlCameraGeometry & geometry);
     void SetROI(const svlRect & rect);
     void SetROI(int left, int top, int right, int bottom);
@@ -74,13 +89,11 @@ public:
     unsigned int GetSmoothnessFactor();
     double       GetTemporalFiltering();
     unsigned int GetSpatialFiltering();
-
-private:
-    // Work in progress...
-    // Other methods not available yet.
-    void SetMethod(StereoMethod method);
     StereoMethod GetMethod();
 
+    //! Time spent on the last frame, in seconds.
+    double       GetProcessingTime();
+
 protected:
     virtual int Initialize(svlSample* syncInput, svlSample* &syncOutput);
     virtual int Process(svlProcInfo* procInfo, svlSample* syncInput, svlSample* &syncOutput);
@@ -93,6 +106,7 @@ private:
     svlComputationalStereoMethodBase* XCheckStereoAlgorithm;
 
     svlSampleImage* XCheckImage;
+    int XCheckImageResult;
     vctDynamicMatrix<int> DisparityBuffer;
     vctDynamicMatrix<int> XCheckDisparityBuffer;
 
@@ -115,6 +129,11 @@ private:
     bool   SubpixelPrecision;
     bool   XCheckEnabled;
     StereoMethod Method;
+    double ProcessingStartTime;
+    double ProcessingTime;
+
+    svlComputationalStereoMethodBase* CreateStereoAlgorithm(const svlRect & roi);
+    int CreateXCheckImage(svlSampleImage* image);
 
     template <class _paramType>
     void CreateXCheckImageMono(_paramType* source, _paramType* target, const unsigned int width, const unsigned int height);
@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2006 
 
-  (C) Copyright 2006-2007 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -42,6 +42,9 @@ public:
     int SetTableFromCameraCalibration(unsigned int height,unsigned int width,vct3x3 R,vct2 f, vct2 c, vctFixedSizeVector<double,7> k, double alpha, unsigned int videoch);
     vctFixedSizeVector<svlImageProcessing::Internals, SVL_MAX_CHANNELS> GetTables(){return Tables;};
     void EnableInterpolation(bool enable = true);
+    // Tables generated from camera calibrations are saved in this directory
+    // and loaded from there the next time the same calibration is used
+    void SetTableCacheDirectory(const std::string & directory);
 
 protected:
     virtual int Initialize(svlSample* syncInput, svlSample* &syncOutput);
@@ -52,6 +55,7 @@ private:
 
     vctFixedSizeVector<svlImageProcessing::Internals, SVL_MAX_CHANNELS> Tables;
     bool InterpolationEnabled;
+    std::string TableCacheDirectory;
 };
 
 CMN_DECLARE_SERVICES_INSTANTIATION_EXPORT(svlFilterImageRectifier)
@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2006
 
-  (C) Copyright 2006-2008 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -100,6 +100,15 @@ public:
     int GetTrigger(ExternalTrigger& trigger, unsigned int videoch = SVL_LEFT) const;
     int SetImageProperties(const ImageProperties& properties, unsigned int videoch = SVL_LEFT);
     int GetImageProperties(ImageProperties& properties, unsigned int videoch = SVL_LEFT) const;
+    /*! Hands the capture buffers over to the stream without copying them,
+        if the capture device and the pixel format allow; falls back to
+        copying otherwise.  A buffer is returned to the device when the
+        next frame is requested, and at most `inflight` captured frames
+        are held back from the device; `inflight` has to be at least 2
+        so that a new frame can be captured while the stream holds the
+        previous one.  Has to be called before initialization. */
+    int SetZeroCopy(bool enable, unsigned int inflight = 2, unsigned int videoch = SVL_LEFT);
+    bool GetZeroCopy(unsigned int videoch = SVL_LEFT) const;
     static std::string GetPixelTypeName(PixelType pixeltype);
     static std::string GetPatternTypeName(PatternType patterntype);
 
@@ -135,6 +144,8 @@ private:
     ImageFormat **Format;
     ImageProperties **Properties;
     ExternalTrigger *Trigger;
+    unsigned int *ZeroCopyInFlight;
+    bool *ZeroCopy;
     unsigned char **DevSpecConfigBuffer;
     unsigned int *DevSpecConfigBufferSize;
 
@@ -209,6 +220,14 @@ public:
     virtual int GetImageProperties(svlFilterSourceVideoCapture::ImageProperties & properties, unsigned int videoch = 0);
     virtual int SetTrigger(svlFilterSourceVideoCapture::ExternalTrigger & trigger, unsigned int videoch = 0);
     virtual int GetTrigger(svlFilterSourceVideoCapture::ExternalTrigger & trigger, unsigned int videoch = 0);
+
+    // Optional zero-copy frame hand-off; `inflight` is set before Open(),
+    // GetZeroCopy() tells after Open() whether the mode could be enabled.
+    // GetLatestFrameRef() makes `frame` reference the capture buffer
+    // itself, which remains valid until the next call on the same channel.
+    virtual int SetZeroCopy(unsigned int inflight, unsigned int videoch = 0);
+    virtual bool GetZeroCopy(unsigned int videoch = 0);
+    virtual int GetLatestFrameRef(bool waitfornew, vctDynamicMatrixRef<unsigned char> & frame, unsigned int videoch = 0);
 };
 
 
@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2006 
 
-  (C) Copyright 2006-2007 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -31,6 +31,9 @@ http://www.cisst.org/cisst/license.txt.
 // Always include last!
 #include <cisstStereoVision/svlExport.h>
 
+// Forward declarations
+class svlVideoFrameCache;
+
 
 class CISST_EXPORT svlFilterSourceVideoFile : public svlFilterSourceBase
 {
@@ -53,6 +56,20 @@ public:
     int GetRange(vctInt2& range, unsigned int videoch = SVL_LEFT) const;
     int GetLength(unsigned int videoch = SVL_LEFT) const;
 
+    /*! Decodes video frames on a separate thread for each channel, ahead
+        of the playback position.  `readahead` frames following the
+        current position are decoded in advance and up to `cachesize`
+        decoded frames (at least `readahead`) are kept in memory, so that
+        seeking around the current position or stepping back are served
+        without decoding.  0 disables read-ahead (default).  Only
+        available for seekable video files; has to be called before
+        initialization. */
+    int SetReadAhead(const unsigned int readahead, const unsigned int cachesize = 0);
+    unsigned int GetReadAhead() const;
+    /*! Plays the video backwards; requires read-ahead. */
+    int SetReversePlayback(const bool enable);
+    bool GetReversePlayback() const;
+
     // Run-time methods (available when 'Initialized')
     unsigned int GetWidth(unsigned int videoch = SVL_LEFT) const;
     unsigned int GetHeight(unsigned int videoch = SVL_LEFT) const;
@@ -74,6 +91,10 @@ private:
     vctDynamicVector<bool> UseRange;
     vctDynamicVector<vctInt2> Range;
     vctDynamicVector<svlVideoCodecBase*> Codec;
+    vctDynamicVector<svlVideoFrameCache*> FrameCache;
+    unsigned int ReadAheadFrames;
+    unsigned int CacheFrames;
+    bool ReversePlayback;
     bool ResetTimer;
     double FirstTimestamp;
     double NativeFramerate;
@@ -91,6 +112,7 @@ protected:
     virtual void SetPosRCommand(const int & position);
     virtual void SetRangeLCommand(const vctInt2 & position);
     virtual void SetRangeRCommand(const vctInt2 & position);
+    virtual void SetReverseCommand(const bool & reverse);
     virtual void GetChannelsCommand(int & channels) const;
     virtual void GetPathLCommand(std::string & filepath) const;
     virtual void GetPathRCommand(std::string & filepath) const;
@@ -100,6 +122,7 @@ protected:
     virtual void GetPosRCommand(int & position) const;
     virtual void GetRangeLCommand(vctInt2 & range) const;
     virtual void GetRangeRCommand(vctInt2 & range) const;
+    virtual void GetReverseCommand(bool & reverse) const;
     virtual void GetDimensionsLCommand(vctInt2 & dimensions) const;
     virtual void GetDimensionsRCommand(vctInt2 & dimensions) const;
     virtual void GetPositionAtTimeLCommand(const double & time, int & position) const;
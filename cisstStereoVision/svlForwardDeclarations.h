@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2010
 
-  (C) Copyright 2006-2010 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -32,6 +32,8 @@ class svlFilterOutput;
 class svlStreamManager;
 class svlStreamProc;
 class svlStreamBranchSource;
+class svlStreamPipelineStage;
+class svlStreamPipelineQueue;
 
 class svlFilterImageOverlay;
 
@@ -0,0 +1,111 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#ifndef _svlFramePool_h
+#define _svlFramePool_h
+
+#include <cstddef>
+#include <map>
+#include <vector>
+#include <cisstOSAbstraction/osaCriticalSection.h>
+
+// Always include last!
+#include <cisstStereoVision/svlExport.h>
+
+
+/*!
+  \brief Process wide pool of image buffers
+
+  Image samples owning their data (see svlSampleImageCustom) acquire
+  their buffers from this pool and return them when they are resized
+  or destroyed.  Requests are rounded up to a size class: whole pages
+  for small buffers, four classes per power of two for large ones, so
+  that a buffer returned by a sample can be reused by any other sample
+  of similar size.  Once a stream is running, filters re-initialized,
+  buffers reallocated or samples copied with a new size are served
+  from the pool without any heap allocation.
+
+  Buffers are page aligned.  Buffers larger than a huge page are
+  aligned to the huge page size and, on Linux, marked for transparent
+  huge pages (see SetHugePages).
+
+  All methods are thread safe.
+*/
+class CISST_EXPORT svlFramePool
+{
+public:
+    typedef struct _Statistics
+    {
+        unsigned long long Hits;        // Acquire served from the pool
+        unsigned long long Misses;      // Acquire requiring a heap allocation
+        unsigned long long Releases;    // Release calls
+        unsigned long long Frees;       // Buffers returned to the heap
+        size_t BytesInUse;              // Size of buffers held by the samples
+        size_t BytesPooled;             // Size of buffers cached by the pool
+    } Statistics;
+
+    ~svlFramePool();
+
+    //! Returns a buffer of at least size bytes, 0 if size is 0 or the allocation failed.
+    static void* Acquire(const size_t size);
+    //! Returns a buffer acquired with the same size to the pool.
+    static void Release(void* buffer, const size_t size);
+
+    //! Size of the buffer actually allocated by Acquire for a given size.
+    static size_t GetSizeClass(const size_t size);
+
+    static Statistics GetStatistics();
+    static void ResetStatistics();
+
+    //! Releases all cached buffers to the heap.
+    static void Trim();
+
+    //! Maximum size of the cached buffers, extra released buffers are freed.  Default: 512 MB.
+    static void SetMaxPooledBytes(const size_t maxbytes);
+    static size_t GetMaxPooledBytes();
+
+    //! Enables transparent huge pages for large buffers.  Default: enabled.
+    static void SetHugePages(const bool enable);
+    static bool GetHugePages();
+
+private:
+    typedef std::vector<void*> _BufferList;
+    typedef std::map<size_t, _BufferList> _BufferListMap;
+
+    svlFramePool();
+    svlFramePool(const svlFramePool &);
+    static svlFramePool* GetInstance();
+
+    static void* Allocate(const size_t size, const bool hugepages);
+    static void Free(void* buffer);
+
+    // Set by the destructor: samples destroyed after the pool at exit
+    // return their buffers directly to the heap
+    static bool Destroyed;
+
+    _BufferListMap FreeBuffers;
+    Statistics Stats;
+    size_t MaxPooledBytes;
+    bool HugePages;
+    osaCriticalSection CS;
+};
+
+#endif // _svlFramePool_h
+
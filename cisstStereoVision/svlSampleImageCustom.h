@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2010
 
-  (C) Copyright 2006-2010 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -28,6 +28,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstStereoVision/svlSampleImage.h>
 #include <cisstStereoVision/svlSampleMatrix.h>
 #include <cisstStereoVision/svlImageIO.h>
+#include <cisstStereoVision/svlFramePool.h>
 
 // Always include last!
 #include <cisstStereoVision/svlExport.h>
@@ -49,8 +50,8 @@ public:
         OwnData(true)
     {
         for (unsigned int vch = 0; vch < _VideoChannels; vch ++) {
-            OwnImage[vch] = new vctDynamicMatrix<_ValueType>;
-            Image[vch].SetRef(*(OwnImage[vch]));
+            OwnImage[vch] = 0;
+            OwnImageSize[vch] = 0;
 #if CISST_SVL_HAS_OPENCV
             int ocvdepth = GetOCVDepth();
             if (ocvdepth >= 0) OCVImageHeader[vch] = cvCreateImageHeader(cvSize(0, 0), ocvdepth, _DataChannels);
@@ -64,13 +65,8 @@ public:
         OwnData(owndata)
     {
         for (unsigned int vch = 0; vch < _VideoChannels; vch ++) {
-            if (OwnData) {
-                OwnImage[vch] = new vctDynamicMatrix<_ValueType>;
-                Image[vch].SetRef(*(OwnImage[vch]));
-            }
-            else {
-                OwnImage[vch] = 0;
-            }
+            OwnImage[vch] = 0;
+            OwnImageSize[vch] = 0;
 #if CISST_SVL_HAS_OPENCV
             int ocvdepth = GetOCVDepth();
             if (ocvdepth >= 0) OCVImageHeader[vch] = cvCreateImageHeader(cvSize(0, 0), ocvdepth, _DataChannels);
@@ -84,8 +80,8 @@ public:
         OwnData(true)
     {
         for (unsigned int vch = 0; vch < _VideoChannels; vch ++) {
-            OwnImage[vch] = new vctDynamicMatrix<_ValueType>;
-            Image[vch].SetRef(*(OwnImage[vch]));
+            OwnImage[vch] = 0;
+            OwnImageSize[vch] = 0;
 #if CISST_SVL_HAS_OPENCV
             int ocvdepth = GetOCVDepth();
             if (ocvdepth >= 0) OCVImageHeader[vch] = cvCreateImageHeader(cvSize(0, 0), ocvdepth, _DataChannels);
@@ -103,7 +99,7 @@ public:
     ~svlSampleImageCustom()
     {
         for (unsigned int vch = 0; vch < _VideoChannels; vch ++) {
-            if (OwnImage[vch]) delete OwnImage[vch];
+            svlFramePool::Release(OwnImage[vch], OwnImageSize[vch]);
 #if CISST_SVL_HAS_OPENCV
             if (OCVImageHeader[vch]) cvReleaseImageHeader(&(OCVImageHeader[vch]));
 #endif // CISST_SVL_HAS_OPENCV
@@ -378,8 +374,22 @@ public:
         if (OwnData && videochannel < _VideoChannels) {
             if (GetWidth (videochannel) == width &&
                 GetHeight(videochannel) == height) return;
-            OwnImage[videochannel]->SetSize(height,  width * _DataChannels);
-            Image[videochannel].SetRef(*(OwnImage[videochannel]));
+            // Image buffers are recycled through the frame pool
+            const size_t size = static_cast<size_t>(width) * height * _DataChannels * sizeof(_ValueType);
+            if (svlFramePool::GetSizeClass(size) != svlFramePool::GetSizeClass(OwnImageSize[videochannel])) {
+                svlFramePool::Release(OwnImage[videochannel], OwnImageSize[videochannel]);
+                OwnImage[videochannel] = static_cast<_ValueType*>(svlFramePool::Acquire(size));
+                OwnImageSize[videochannel] = OwnImage[videochannel] ? size : 0;
+            }
+            else if (OwnImage[videochannel]) {
+                OwnImageSize[videochannel] = size;
+            }
+            if (OwnImage[videochannel]) {
+                Image[videochannel].SetRef(height, width * _DataChannels, width * _DataChannels, 1, OwnImage[videochannel]);
+            }
+            else {
+                Image[videochannel].SetRef(0, 0, 1, 1, 0);
+            }
 #if CISST_SVL_HAS_OPENCV
             if (OCVImageHeader[videochannel]) {
                 cvInitImageHeader(OCVImageHeader[videochannel],
@@ -625,7 +635,8 @@ public:
 private:
     bool OwnData;
     vctDynamicMatrixRef<_ValueType> Image[_VideoChannels];
-    vctDynamicMatrix<_ValueType>*   OwnImage[_VideoChannels];
+    _ValueType*                     OwnImage[_VideoChannels];
+    size_t                          OwnImageSize[_VideoChannels];
     vctDynamicMatrix<_ValueType>    InvalidMatrix;
 
 #if CISST_SVL_HAS_OPENCV
@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2006
 
-  (C) Copyright 2006-2007 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -25,16 +25,20 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstVector/vctDynamicVector.h>
 #include <cisstMultiTask/mtsComponent.h>
+#include <cisstStereoVision/svlSyncPoint.h>
+
+#include <vector>
 
 // Always include last!
 #include <cisstStereoVision/svlExport.h>
 
 
 // Forward declarations
-class svlSyncPoint;
 class svlFilterBase;
 class svlFilterSourceBase;
 class svlStreamProc;
+class svlStreamPipelineStage;
+struct svlStreamPipelineStageInfo;
 class osaThread;
 class osaCriticalSection;
 
@@ -61,6 +65,40 @@ public:
     int GetStreamStatus(void) const;
     void DisconnectAll(void);
 
+    /*! Method used to synchronize the threads of the stream after
+        each filter when ThreadCount is greater than 1, see
+        svlSyncMethod.  svlSyncSpin reduces the synchronization
+        latency for streams with many filters and threads.  Negative
+        spincount uses the default (see svlSyncPoint::Method).  Must be
+        set before Play. */
+    int SetSyncMethod(svlSyncMethod method, int spincount = -1);
+    svlSyncMethod GetSyncMethod(void) const;
+
+    /*! Pipelined execution.  By default all the filters of the trunk
+        process the same frame, one after the other, and the source
+        doesn't capture the next frame until the last filter is done.
+        In pipelined mode the trunk is split in stages, each stage
+        having its own thread(s) (ThreadCount per stage) so successive
+        frames are processed concurrently by different stages.  Stages
+        are connected by bounded queues of length queuelength, samples
+        are copied at stage boundaries and never dropped: a stage waits
+        if the downstream stage is slower.  This increases throughput
+        at the cost of one sample copy per boundary and some latency.
+        Stages start at the source and at each filter added with
+        AddPipelineStage, or at every trunk filter if none has been
+        added.  Must be configured before Play. */
+    int SetPipelined(bool pipelined, unsigned int queuelength = 2);
+    bool IsPipelined(void) const;
+    int AddPipelineStage(svlFilterBase * firstfilter);
+    void ClearPipelineStages(void);
+
+    /*! Number of stages and per stage statistics (see
+        svlStreamPipeline.h).  Statistics are available while the
+        stream is running and after it stopped, until the next Play
+        or Release. */
+    unsigned int GetPipelineStageCount(void) const;
+    int GetPipelineStageInfo(unsigned int stage, svlStreamPipelineStageInfo & info) const;
+
     // Virtual methods from mtsComponent (these are temporary measures until 
     // ticket #67 is resolved)
     void Start(void) { Play(); }
@@ -71,6 +109,8 @@ private:
     vctDynamicVector<svlStreamProc*> StreamProcInstance;
     vctDynamicVector<osaThread*> StreamProcThread;
     svlSyncPoint* SyncPoint;
+    svlSyncMethod SyncMethod;
+    int SyncSpinCount;
     osaCriticalSection* CS;
 
     svlFilterSourceBase* StreamSource;
@@ -79,6 +119,13 @@ private:
     bool StopThread;
     int StreamStatus;
 
+    bool Pipelined;
+    unsigned int PipelineQueueLength;
+    std::vector<svlFilterBase*> PipelineStageStarts;
+    std::vector<svlStreamPipelineStage*> PipelineStages;
+
+    void CreatePipelineStages(void);
+    void DeletePipelineStages(void);
     void InternalStop(unsigned int callingthreadID);
 
 protected:
@@ -0,0 +1,138 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#ifndef _svlStreamPipeline_h
+#define _svlStreamPipeline_h
+
+#include <cisstOSAbstraction/osaThreadSignal.h>
+#include <cisstOSAbstraction/osaCriticalSection.h>
+#include <cisstStereoVision/svlForwardDeclarations.h>
+#include <cisstStereoVision/svlSyncPoint.h>
+#include <cisstStereoVision/svlTypes.h>
+
+// Always include last!
+#include <cisstStereoVision/svlExport.h>
+
+
+/*!
+  Statistics of a pipeline stage, see svlStreamManager::SetPipelined.
+  Latencies and wait times are in seconds.  The input queue is empty
+  (length 0) for the first stage.
+*/
+struct CISST_EXPORT svlStreamPipelineStageInfo
+{
+    std::string  FirstFilter;
+    std::string  LastFilter;
+    unsigned int FrameCount;
+    double       LatencyAverage;
+    double       LatencyMax;
+    double       InputWaitTime;
+    double       OutputWaitTime;
+    unsigned int QueueLength;
+    unsigned int QueueUsage;
+    double       QueueUsageAverage;
+    unsigned int QueueUsageMax;
+};
+
+
+/*!
+  Bounded queue of samples between two pipeline stages.  Samples are
+  pre-allocated and copied in, nothing is ever dropped: the producer
+  waits for a free slot and the consumer waits for a new sample.  The
+  pulled sample stays valid until Release is called.  Single producer
+  and single consumer only.
+*/
+class CISST_EXPORT svlStreamPipelineQueue
+{
+public:
+    svlStreamPipelineQueue(svlStreamType type, unsigned int length);
+    ~svlStreamPipelineQueue();
+
+    int Push(const svlSample* sample, unsigned int framecounter, const bool& stop);
+    svlSample* Pull(unsigned int& framecounter, const bool& stop);
+    void Release();
+    void Finish();
+
+    unsigned int GetLength();
+    unsigned int GetUsage();
+
+private:
+    svlStreamPipelineQueue();
+
+    bool Wait(osaThreadSignal& event, bool full, const bool& stop);
+
+    unsigned int Length;
+    unsigned int ReadIndex;
+    unsigned int WriteIndex;
+    unsigned int FilledCount;
+    unsigned int UsedCount;
+    bool Finished;
+    vctDynamicVector<svlSample*> Slots;
+    vctDynamicVector<unsigned int> FrameCounters;
+
+    osaCriticalSection CS;
+    osaThreadSignal NotEmptyEvent;
+    osaThreadSignal NotFullEvent;
+};
+
+
+/*!
+  Internal state of a pipeline stage, i.e. a range of filters along
+  the trunk processed by its own thread(s).
+*/
+class CISST_EXPORT svlStreamPipelineStage
+{
+friend class svlStreamProc;
+
+public:
+    svlStreamPipelineStage(svlFilterBase* first, svlFilterBase* last, unsigned int threadcount,
+                           svlSyncMethod syncmethod, int spincount);
+    ~svlStreamPipelineStage();
+
+    void SetQueues(svlStreamPipelineQueue* input, svlStreamPipelineQueue* output);
+    void GetInfo(svlStreamPipelineStageInfo& info);
+
+private:
+    svlStreamPipelineStage();
+
+    void AddFrame(double latency, double inputwait, double outputwait);
+
+    svlFilterBase* FirstFilter;
+    svlFilterBase* LastFilter;
+    svlSyncPoint* SyncPoint;
+    svlStreamPipelineQueue* InputQueue;
+    svlStreamPipelineQueue* OutputQueue;
+
+    // Shared between the threads of the stage
+    svlSample* CurrentSample;
+    unsigned int CurrentFrameCounter;
+
+    osaCriticalSection StatsCS;
+    unsigned int FrameCount;
+    double LatencySum;
+    double LatencyMax;
+    double InputWaitTime;
+    double OutputWaitTime;
+    double QueueUsageSum;
+    unsigned int QueueUsageMax;
+};
+
+#endif // _svlStreamPipeline_h
+
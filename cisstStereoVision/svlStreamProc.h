@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2010
 
-  (C) Copyright 2006-2010 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -32,8 +32,11 @@ class svlStreamProc
 {
 public:
     svlStreamProc(unsigned int threadcount, unsigned int threadid);
+    svlStreamProc(unsigned int threadcount, unsigned int threadid,
+                  svlStreamPipelineStage* stage, unsigned int threadindex);
 
     void* Proc(svlStreamManager* baseref);
+    void* ProcStage(svlStreamManager* baseref);
 
 private:
     svlStreamProc();
@@ -42,6 +45,11 @@ private:
 
     unsigned int ThreadID;
     unsigned int ThreadCount;
+
+    // Pipelined execution: stage processed by the thread and
+    // index of the thread among all the threads of the stream
+    svlStreamPipelineStage* Stage;
+    unsigned int ThreadIndex;
 };
 
 #endif // _svlStreamProc_h
@@ -6,7 +6,7 @@
   Author(s):  Balazs Vagvolgyi
   Created on: 2008 
 
-  (C) Copyright 2006-2008 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -25,10 +25,28 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstOSAbstraction/osaThreadSignal.h>
 #include <cisstOSAbstraction/osaCriticalSection.h>
 
+#include <atomic>
+
 // Always include last!
 #include <cisstStereoVision/svlExport.h>
 
 
+/*!
+  Synchronization method used by svlSyncPoint:
+    - svlSyncEvent: each thread waits on its own event, one system
+      call per thread and per Sync (default).
+    - svlSyncSpin: generation counting barrier, threads spin for a
+      bounded number of iterations before going to sleep (futex on Linux, yield
+      on other platforms).  Much lower latency when the threads arrive
+      close to each other, at the cost of some CPU time.
+*/
+enum svlSyncMethod
+{
+    svlSyncEvent,
+    svlSyncSpin
+};
+
+
 class CISST_EXPORT svlSyncPoint
 {
 public:
@@ -37,15 +55,30 @@ public:
 
     int Count(unsigned int count);
     unsigned int Count();
+    int Method(svlSyncMethod method, int spincount = -1);
+    svlSyncMethod Method();
     int Sync(unsigned int _id);
     void ReleaseAll();
 
 private:
+    int SyncSpin();
+    void WaitSpin(int generation);
+    void WakeSpin();
+
+    svlSyncMethod SyncMethod;
     unsigned int ThreadCount;
     int LastChanged;
     unsigned int CheckedInCounter;
     osaThreadSignal* ReleaseEvent;
     osaCriticalSection CS;
+
+    // Generation counting barrier, the generation is incremented each
+    // time all threads checked in and by ReleaseAll
+    unsigned int SpinCount;
+    std::atomic<unsigned int> SpinRemaining;
+    std::atomic<int> SpinGeneration;
+    std::atomic<unsigned int> SpinSleepers;
+    std::atomic<bool> SpinReleased;
 };
 
 #endif // _svlSyncPoint_h
@@ -0,0 +1,592 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstVector/vctDynamicMatrixProduct.h>
+#include <cisstVector/vctConfig.h>
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <vector>
+
+// AVX2 and FMA kernels are compiled for a different target (GCC and
+// clang) or directly (Visual Studio) without any specific compiler
+// flag and only used if supported by the processor
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ >= 5)) || (defined(_MSC_VER) && (_MSC_VER >= 1900))
+        #define VCT_PRODUCT_AVX2
+        #include <immintrin.h>
+        #if defined(_MSC_VER)
+            #include <intrin.h>
+        #endif
+    #endif
+#endif
+
+#if CISST_VCT_HAS_BLAS
+// Fortran BLAS, column major
+extern "C" {
+    void dgemm_(const char * transa, const char * transb,
+                const int * m, const int * n, const int * k,
+                const double * alpha, const double * a, const int * lda,
+                const double * b, const int * ldb,
+                const double * beta, double * c, const int * ldc);
+    void sgemm_(const char * transa, const char * transb,
+                const int * m, const int * n, const int * k,
+                const float * alpha, const float * a, const int * lda,
+                const float * b, const int * ldb,
+                const float * beta, float * c, const int * ldc);
+}
+#endif
+
+typedef vctDynamicMatrixProduct::size_type size_type;
+typedef vctDynamicMatrixProduct::stride_type stride_type;
+
+namespace {
+
+    /* Blocking parameters.  The kernels compute a MR x NR block of
+       the output from a MR x KC panel of input1 and a KC x NR panel
+       of input2.  Blocks of input1 (MC x KC) are sized to stay in the
+       L2 cache, blocks of input2 (KC x NC) in the L3 cache. */
+    template <class _elementType> struct Blocking;
+
+    template <> struct Blocking<double> {
+        enum {MR = 6, NR = 8, MC = 72, KC = 256, NC = 4080};
+    };
+
+    template <> struct Blocking<float> {
+        enum {MR = 6, NR = 16, MC = 144, KC = 256, NC = 4080};
+    };
+
+
+    /* Kernel: output[MR x NR] (+)= packed1[MR x kc] * packed2[kc x NR] */
+    template <class _elementType>
+    struct Kernel {
+        typedef void (*Type)(const size_type kc, const _elementType * packed1, const _elementType * packed2,
+                             _elementType * output, const stride_type outputRowStride, const stride_type outputColStride,
+                             const bool accumulate);
+    };
+
+
+    template <class _elementType>
+    void KernelScalar(const size_type kc, const _elementType * packed1, const _elementType * packed2,
+                      _elementType * output, const stride_type outputRowStride, const stride_type outputColStride,
+                      const bool accumulate)
+    {
+        enum {MR = Blocking<_elementType>::MR, NR = Blocking<_elementType>::NR};
+        _elementType block[MR * NR];
+        size_type i, j;
+        std::fill(block, block + MR * NR, _elementType(0));
+        for (size_type p = 0; p < kc; ++p, packed1 += MR, packed2 += NR) {
+            for (i = 0; i < MR; ++i) {
+                const _elementType value1 = packed1[i];
+                _elementType * blockRow = block + i * NR;
+                for (j = 0; j < NR; ++j) {
+                    blockRow[j] += value1 * packed2[j];
+                }
+            }
+        }
+        for (i = 0; i < MR; ++i, output += outputRowStride) {
+            _elementType * outputPointer = output;
+            for (j = 0; j < NR; ++j, outputPointer += outputColStride) {
+                *outputPointer = accumulate ? (*outputPointer + block[i * NR + j]) : block[i * NR + j];
+            }
+        }
+    }
+
+} // namespace
+
+
+#ifdef VCT_PRODUCT_AVX2
+
+/***************************/
+/*** AVX2 implementation ***/
+/***************************/
+
+#if defined(__clang__)
+    #pragma clang attribute push (__attribute__((target("avx2,fma"))), apply_to = function)
+#elif defined(__GNUC__)
+    #pragma GCC push_options
+    #pragma GCC target("avx2,fma")
+#endif
+
+namespace {
+
+    template <class _elementType> class VecAVX2;
+
+    template <> class VecAVX2<double>
+    {
+    public:
+        typedef __m256d Reg;
+        enum {Width = 4};
+        static inline Reg Zero(void) { return _mm256_setzero_pd(); }
+        static inline Reg Load(const double * input) { return _mm256_loadu_pd(input); }
+        static inline Reg Broadcast(const double * input) { return _mm256_broadcast_sd(input); }
+        static inline Reg MultiplyAdd(const Reg a, const Reg b, const Reg c) { return _mm256_fmadd_pd(a, b, c); }
+        static inline Reg Add(const Reg a, const Reg b) { return _mm256_add_pd(a, b); }
+        static inline void Store(double * output, const Reg a) { _mm256_storeu_pd(output, a); }
+    };
+
+    template <> class VecAVX2<float>
+    {
+    public:
+        typedef __m256 Reg;
+        enum {Width = 8};
+        static inline Reg Zero(void) { return _mm256_setzero_ps(); }
+        static inline Reg Load(const float * input) { return _mm256_loadu_ps(input); }
+        static inline Reg Broadcast(const float * input) { return _mm256_broadcast_ss(input); }
+        static inline Reg MultiplyAdd(const Reg a, const Reg b, const Reg c) { return _mm256_fmadd_ps(a, b, c); }
+        static inline Reg Add(const Reg a, const Reg b) { return _mm256_add_ps(a, b); }
+        static inline void Store(float * output, const Reg a) { _mm256_storeu_ps(output, a); }
+    };
+
+
+    // Store one row of the MR x NR block, i.e. two registers
+    template <class _elementType>
+    inline void StoreRowAVX2(_elementType * output, const stride_type outputColStride, const bool accumulate,
+                             const typename VecAVX2<_elementType>::Reg low,
+                             const typename VecAVX2<_elementType>::Reg high)
+    {
+        typedef VecAVX2<_elementType> Vec;
+        if (outputColStride == 1) {
+            if (accumulate) {
+                Vec::Store(output, Vec::Add(Vec::Load(output), low));
+                Vec::Store(output + Vec::Width, Vec::Add(Vec::Load(output + Vec::Width), high));
+            } else {
+                Vec::Store(output, low);
+                Vec::Store(output + Vec::Width, high);
+            }
+            return;
+        }
+        _elementType row[2 * Vec::Width];
+        Vec::Store(row, low);
+        Vec::Store(row + Vec::Width, high);
+        for (size_type j = 0; j < 2 * Vec::Width; ++j, output += outputColStride) {
+            *output = accumulate ? (*output + row[j]) : row[j];
+        }
+    }
+
+
+    // 6 rows of 2 registers, i.e. 6x8 for double and 6x16 for float
+    template <class _elementType>
+    void KernelAVX2(const size_type kc, const _elementType * packed1, const _elementType * packed2,
+                    _elementType * output, const stride_type outputRowStride, const stride_type outputColStride,
+                    const bool accumulate)
+    {
+        typedef VecAVX2<_elementType> Vec;
+        typedef typename Vec::Reg Reg;
+        enum {MR = Blocking<_elementType>::MR, NR = Blocking<_elementType>::NR};
+
+        Reg c00 = Vec::Zero(), c01 = Vec::Zero();
+        Reg c10 = Vec::Zero(), c11 = Vec::Zero();
+        Reg c20 = Vec::Zero(), c21 = Vec::Zero();
+        Reg c30 = Vec::Zero(), c31 = Vec::Zero();
+        Reg c40 = Vec::Zero(), c41 = Vec::Zero();
+        Reg c50 = Vec::Zero(), c51 = Vec::Zero();
+        Reg a;
+
+        for (size_type p = 0; p < kc; ++p, packed1 += MR, packed2 += NR) {
+            const Reg b0 = Vec::Load(packed2);
+            const Reg b1 = Vec::Load(packed2 + Vec::Width);
+            a = Vec::Broadcast(packed1);
+            c00 = Vec::MultiplyAdd(a, b0, c00); c01 = Vec::MultiplyAdd(a, b1, c01);
+            a = Vec::Broadcast(packed1 + 1);
+            c10 = Vec::MultiplyAdd(a, b0, c10); c11 = Vec::MultiplyAdd(a, b1, c11);
+            a = Vec::Broadcast(packed1 + 2);
+            c20 = Vec::MultiplyAdd(a, b0, c20); c21 = Vec::MultiplyAdd(a, b1, c21);
+            a = Vec::Broadcast(packed1 + 3);
+            c30 = Vec::MultiplyAdd(a, b0, c30); c31 = Vec::MultiplyAdd(a, b1, c31);
+            a = Vec::Broadcast(packed1 + 4);
+            c40 = Vec::MultiplyAdd(a, b0, c40); c41 = Vec::MultiplyAdd(a, b1, c41);
+            a = Vec::Broadcast(packed1 + 5);
+            c50 = Vec::MultiplyAdd(a, b0, c50); c51 = Vec::MultiplyAdd(a, b1, c51);
+        }
+
+        StoreRowAVX2<_elementType>(output, outputColStride, accumulate, c00, c01); output += outputRowStride;
+        StoreRowAVX2<_elementType>(output, outputColStride, accumulate, c10, c11); output += outputRowStride;
+        StoreRowAVX2<_elementType>(output, outputColStride, accumulate, c20, c21); output += outputRowStride;
+        StoreRowAVX2<_elementType>(output, outputColStride, accumulate, c30, c31); output += outputRowStride;
+        StoreRowAVX2<_elementType>(output, outputColStride, accumulate, c40, c41); output += outputRowStride;
+        StoreRowAVX2<_elementType>(output, outputColStride, accumulate, c50, c51);
+    }
+
+    // Explicit instantiations so the kernels are compiled for the AVX2 target
+    template void KernelAVX2<double>(const size_type, const double *, const double *,
+                                     double *, const stride_type, const stride_type, const bool);
+    template void KernelAVX2<float>(const size_type, const float *, const float *,
+                                    float *, const stride_type, const stride_type, const bool);
+
+} // namespace
+
+#if defined(__clang__)
+    #pragma clang attribute pop
+#elif defined(__GNUC__)
+    #pragma GCC pop_options
+#endif
+
+#endif // VCT_PRODUCT_AVX2
+
+
+namespace {
+
+    bool IsAVX2Supported(void)
+    {
+        static const bool supported = []() {
+#ifdef VCT_PRODUCT_AVX2
+    #if defined(_MSC_VER)
+            // AVX2 and FMA require OS support for the YMM registers (OSXSAVE and XCR0)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] >= 7) {
+                __cpuid(info, 1);
+                if ((info[2] & (1 << 12)) && (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && ((_xgetbv(0) & 6) == 6)) {
+                    __cpuidex(info, 7, 0);
+                    if (info[1] & (1 << 5)) return true;
+                }
+            }
+    #else
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return true;
+    #endif
+#endif
+            return false;
+        }();
+        return supported;
+    }
+
+
+    vctDynamicMatrixProduct::KernelType DefaultKernel(void)
+    {
+#if CISST_VCT_HAS_BLAS
+        return vctDynamicMatrixProduct::KERNEL_BLAS;
+#else
+        return IsAVX2Supported() ? vctDynamicMatrixProduct::KERNEL_AVX2 : vctDynamicMatrixProduct::KERNEL_SCALAR;
+#endif
+    }
+
+
+    // Kernel selected, initialized on first use.  Settings can be
+    // changed while other threads multiply matrices, relaxed loads and
+    // stores are enough since each value is used on its own
+    std::atomic<vctDynamicMatrixProduct::KernelType> & SelectedKernel(void)
+    {
+        static std::atomic<vctDynamicMatrixProduct::KernelType> kernel(DefaultKernel());
+        return kernel;
+    }
+
+    // Threshold, initialized on first use.  Measured crossover with
+    // the loop engine is below 8^3 for AVX2 and BLAS, around 48^3 for
+    // the scalar kernel
+    std::atomic<size_type> & SelectedThreshold(void)
+    {
+        static std::atomic<size_type> threshold((IsAVX2Supported() || CISST_VCT_HAS_BLAS) ? (16 * 16 * 16) : (64 * 64 * 64));
+        return threshold;
+    }
+
+
+    inline size_type RoundUp(const size_type value, const size_type multiple) {
+        return ((value + multiple - 1) / multiple) * multiple;
+    }
+
+
+    // Copy a mc x kc block of input1 in panels of MR rows, padded with zeros
+    template <class _elementType>
+    void Pack1(const size_type mc, const size_type kc,
+               const _elementType * input, const stride_type rowStride, const stride_type colStride,
+               _elementType * packed)
+    {
+        const size_type MR = Blocking<_elementType>::MR;
+        size_type i;
+        for (size_type ir = 0; ir < mc; ir += MR) {
+            const size_type mr = std::min(MR, mc - ir);
+            const _elementType * panel = input + static_cast<stride_type>(ir) * rowStride;
+            for (size_type p = 0; p < kc; ++p, panel += colStride, packed += MR) {
+                const _elementType * inputPointer = panel;
+                for (i = 0; i < mr; ++i, inputPointer += rowStride) {
+                    packed[i] = *inputPointer;
+                }
+                for (; i < MR; ++i) {
+                    packed[i] = _elementType(0);
+                }
+            }
+        }
+    }
+
+
+    // Copy a kc x nc block of input2 in panels of NR columns, padded with zeros
+    template <class _elementType>
+    void Pack2(const size_type kc, const size_type nc,
+               const _elementType * input, const stride_type rowStride, const stride_type colStride,
+               _elementType * packed)
+    {
+        const size_type NR = Blocking<_elementType>::NR;
+        size_type j;
+        for (size_type jr = 0; jr < nc; jr += NR) {
+            const size_type nr = std::min(NR, nc - jr);
+            const _elementType * panel = input + static_cast<stride_type>(jr) * colStride;
+            for (size_type p = 0; p < kc; ++p, panel += rowStride, packed += NR) {
+                const _elementType * inputPointer = panel;
+                for (j = 0; j < nr; ++j, inputPointer += colStride) {
+                    packed[j] = *inputPointer;
+                }
+                for (; j < NR; ++j) {
+                    packed[j] = _elementType(0);
+                }
+            }
+        }
+    }
+
+
+    template <class _elementType>
+    void RunBlocked(typename Kernel<_elementType>::Type kernel,
+                    const size_type rows, const size_type cols, const size_type common,
+                    const _elementType * input1, const stride_type input1RowStride, const stride_type input1ColStride,
+                    const _elementType * input2, const stride_type input2RowStride, const stride_type input2ColStride,
+                    _elementType * output, const stride_type outputRowStride, const stride_type outputColStride)
+    {
+        typedef Blocking<_elementType> BlockingType;
+        const size_type MR = BlockingType::MR;
+        const size_type NR = BlockingType::NR;
+        const size_type MC = BlockingType::MC;
+        const size_type KC = BlockingType::KC;
+        const size_type NC = BlockingType::NC;
+
+        std::vector<_elementType> packed1(std::min(RoundUp(rows, MR), MC) * std::min(common, KC));
+        std::vector<_elementType> packed2(std::min(common, KC) * std::min(RoundUp(cols, NR), NC));
+        _elementType edge[BlockingType::MR * BlockingType::NR];
+
+        size_type jc, pc, ic, jr, ir, i, j;
+        for (jc = 0; jc < cols; jc += NC) {
+            const size_type nc = std::min(NC, cols - jc);
+            for (pc = 0; pc < common; pc += KC) {
+                const size_type kc = std::min(KC, common - pc);
+                // first block along the common size sets the output
+                const bool accumulate = (pc != 0);
+                Pack2(kc, nc,
+                      input2 + static_cast<stride_type>(pc) * input2RowStride + static_cast<stride_type>(jc) * input2ColStride,
+                      input2RowStride, input2ColStride, &(packed2[0]));
+                for (ic = 0; ic < rows; ic += MC) {
+                    const size_type mc = std::min(MC, rows - ic);
+                    Pack1(mc, kc,
+                          input1 + static_cast<stride_type>(ic) * input1RowStride + static_cast<stride_type>(pc) * input1ColStride,
+                          input1RowStride, input1ColStride, &(packed1[0]));
+                    for (jr = 0; jr < nc; jr += NR) {
+                        const size_type nr = std::min(NR, nc - jr);
+                        const _elementType * panel2 = &(packed2[0]) + jr * kc;
+                        for (ir = 0; ir < mc; ir += MR) {
+                            const size_type mr = std::min(MR, mc - ir);
+                            const _elementType * panel1 = &(packed1[0]) + ir * kc;
+                            _elementType * outputPointer = output
+                                + static_cast<stride_type>(ic + ir) * outputRowStride
+                                + static_cast<stride_type>(jc + jr) * outputColStride;
+                            if ((mr == MR) && (nr == NR)) {
+                                kernel(kc, panel1, panel2, outputPointer, outputRowStride, outputColStride, accumulate);
+                            } else {
+                                // partial block on the edges, compute full block and copy valid part
+                                kernel(kc, panel1, panel2, edge, NR, 1, false);
+                                for (i = 0; i < mr; ++i) {
+                                    _elementType * outputRow = outputPointer + static_cast<stride_type>(i) * outputRowStride;
+                                    for (j = 0; j < nr; ++j, outputRow += outputColStride) {
+                                        *outputRow = accumulate ? (*outputRow + edge[i * NR + j]) : edge[i * NR + j];
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+
+#if CISST_VCT_HAS_BLAS
+    inline void Gemm(const char transpose1, const char transpose2, const int m, const int n, const int k,
+                     const double * input1, const int leadingDim1, const double * input2, const int leadingDim2,
+                     double * output, const int leadingDimOutput)
+    {
+        const double one = 1.0;
+        const double zero = 0.0;
+        dgemm_(&transpose1, &transpose2, &m, &n, &k, &one, input1, &leadingDim1, input2, &leadingDim2,
+               &zero, output, &leadingDimOutput);
+    }
+
+    inline void Gemm(const char transpose1, const char transpose2, const int m, const int n, const int k,
+                     const float * input1, const int leadingDim1, const float * input2, const int leadingDim2,
+                     float * output, const int leadingDimOutput)
+    {
+        const float one = 1.0f;
+        const float zero = 0.0f;
+        sgemm_(&transpose1, &transpose2, &m, &n, &k, &one, input1, &leadingDim1, input2, &leadingDim2,
+               &zero, output, &leadingDimOutput);
+    }
+
+    // Column major description of a matrix, false if neither stride is 1
+    bool BLASOperand(const size_type rows, const size_type cols,
+                     const stride_type rowStride, const stride_type colStride,
+                     char & transpose, int & leadingDim)
+    {
+        if ((rowStride == 1) && (colStride >= static_cast<stride_type>(std::max(rows, size_type(1))))
+            && (colStride <= INT_MAX)) {
+            transpose = 'N';
+            leadingDim = static_cast<int>(colStride);
+            return true;
+        }
+        if ((colStride == 1) && (rowStride >= static_cast<stride_type>(std::max(cols, size_type(1))))
+            && (rowStride <= INT_MAX)) {
+            transpose = 'T';
+            leadingDim = static_cast<int>(rowStride);
+            return true;
+        }
+        return false;
+    }
+
+    template <class _elementType>
+    bool RunBLAS(const size_type rows, const size_type cols, const size_type common,
+                 const _elementType * input1, const stride_type input1RowStride, const stride_type input1ColStride,
+                 const _elementType * input2, const stride_type input2RowStride, const stride_type input2ColStride,
+                 _elementType * output, const stride_type outputRowStride, const stride_type outputColStride)
+    {
+        if (outputRowStride != 1) {
+            if (outputColStride != 1) {
+                return false;
+            }
+            // row major output, compute transposed product
+            return RunBLAS(cols, rows, common,
+                           input2, input2ColStride, input2RowStride,
+                           input1, input1ColStride, input1RowStride,
+                           output, outputColStride, outputRowStride);
+        }
+        if ((rows > INT_MAX) || (cols > INT_MAX) || (common > INT_MAX)
+            || (outputColStride < static_cast<stride_type>(rows)) || (outputColStride > INT_MAX)) {
+            return false;
+        }
+        char transpose1, transpose2;
+        int leadingDim1, leadingDim2;
+        if (!BLASOperand(rows, common, input1RowStride, input1ColStride, transpose1, leadingDim1)
+            || !BLASOperand(common, cols, input2RowStride, input2ColStride, transpose2, leadingDim2)) {
+            return false;
+        }
+        Gemm(transpose1, transpose2, static_cast<int>(rows), static_cast<int>(cols), static_cast<int>(common),
+             input1, leadingDim1, input2, leadingDim2, output, static_cast<int>(outputColStride));
+        return true;
+    }
+#endif // CISST_VCT_HAS_BLAS
+
+
+    template <class _elementType>
+    bool RunProduct(const size_type rows, const size_type cols, const size_type common,
+                    const _elementType * input1, const stride_type input1RowStride, const stride_type input1ColStride,
+                    const _elementType * input2, const stride_type input2RowStride, const stride_type input2ColStride,
+                    _elementType * output, const stride_type outputRowStride, const stride_type outputColStride)
+    {
+        const vctDynamicMatrixProduct::KernelType kernel = SelectedKernel().load(std::memory_order_relaxed);
+        if ((kernel == vctDynamicMatrixProduct::KERNEL_NONE)
+            || (rows == 0) || (cols == 0) || (common == 0)
+            || ((rows * cols * common) < SelectedThreshold().load(std::memory_order_relaxed))) {
+            return false;
+        }
+#if CISST_VCT_HAS_BLAS
+        if ((kernel == vctDynamicMatrixProduct::KERNEL_BLAS)
+            && RunBLAS(rows, cols, common,
+                       input1, input1RowStride, input1ColStride,
+                       input2, input2RowStride, input2ColStride,
+                       output, outputRowStride, outputColStride)) {
+            return true;
+        }
+#endif
+        // BLAS falls back on the best kernel if strides are not supported
+        typename Kernel<_elementType>::Type kernelFunction = KernelScalar<_elementType>;
+#ifdef VCT_PRODUCT_AVX2
+        if ((kernel != vctDynamicMatrixProduct::KERNEL_SCALAR) && IsAVX2Supported()) {
+            kernelFunction = KernelAVX2<_elementType>;
+        }
+#endif
+        RunBlocked(kernelFunction, rows, cols, common,
+                   input1, input1RowStride, input1ColStride,
+                   input2, input2RowStride, input2ColStride,
+                   output, outputRowStride, outputColStride);
+        return true;
+    }
+
+} // namespace
+
+
+bool vctDynamicMatrixProduct::IsKernelSupported(const KernelType kernel)
+{
+    switch (kernel) {
+    case KERNEL_NONE:
+    case KERNEL_SCALAR:
+        return true;
+    case KERNEL_AVX2:
+        return IsAVX2Supported();
+    case KERNEL_BLAS:
+        return (CISST_VCT_HAS_BLAS != 0);
+    }
+    return false;
+}
+
+
+vctDynamicMatrixProduct::KernelType vctDynamicMatrixProduct::GetKernel(void)
+{
+    return SelectedKernel().load(std::memory_order_relaxed);
+}
+
+
+bool vctDynamicMatrixProduct::SetKernel(const KernelType kernel)
+{
+    if (!IsKernelSupported(kernel)) {
+        return false;
+    }
+    SelectedKernel().store(kernel, std::memory_order_relaxed);
+    return true;
+}
+
+
+vctDynamicMatrixProduct::size_type vctDynamicMatrixProduct::GetThreshold(void)
+{
+    return SelectedThreshold().load(std::memory_order_relaxed);
+}
+
+
+void vctDynamicMatrixProduct::SetThreshold(const size_type multiplyAdds)
+{
+    SelectedThreshold().store(multiplyAdds, std::memory_order_relaxed);
+}
+
+
+bool vctDynamicMatrixProduct::Run(const size_type rows, const size_type cols, const size_type common,
+                                  const double * input1, const stride_type input1RowStride, const stride_type input1ColStride,
+                                  const double * input2, const stride_type input2RowStride, const stride_type input2ColStride,
+                                  double * output, const stride_type outputRowStride, const stride_type outputColStride)
+{
+    return RunProduct(rows, cols, common,
+                      input1, input1RowStride, input1ColStride,
+                      input2, input2RowStride, input2ColStride,
+                      output, outputRowStride, outputColStride);
+}
+
+
+bool vctDynamicMatrixProduct::Run(const size_type rows, const size_type cols, const size_type common,
+                                  const float * input1, const stride_type input1RowStride, const stride_type input1ColStride,
+                                  const float * input2, const stride_type input2RowStride, const stride_type input2ColStride,
+                                  float * output, const stride_type outputRowStride, const stride_type outputColStride)
+{
+    return RunProduct(rows, cols, common,
+                      input1, input1RowStride, input1ColStride,
+                      input2, input2RowStride, input2ColStride,
+                      output, outputRowStride, outputColStride);
+}
@@ -0,0 +1,251 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstVector/vctParallel.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef vctParallel::size_type size_type;
+typedef vctParallel::index_type index_type;
+
+namespace {
+
+    /* true for the threads of the pool and for the calling thread while
+       it executes tasks, used to prevent nested parallel loops */
+    thread_local bool InParallelLoop = false;
+
+    std::atomic<size_type> Threshold(131072);
+
+    /* Simple pool of threads executing one job at a time, the calling
+       thread also executes tasks and waits until all the tasks are
+       completed. */
+    class ThreadPool {
+    public:
+        ThreadPool(void):
+            Stop(false),
+            Generation(0),
+            ActiveWorkers(0),
+            Task(0),
+            Data(0),
+            NumberOfTasks(0),
+            NextTask(0),
+            RemainingTasks(0)
+        {}
+
+        ~ThreadPool() {
+            SetNumberOfWorkers(0);
+        }
+
+        size_type GetNumberOfWorkers(void) {
+            std::lock_guard<std::mutex> runLock(RunMutex);
+            return Workers.size();
+        }
+
+        void SetNumberOfWorkers(const size_type numberOfWorkers) {
+            std::lock_guard<std::mutex> runLock(RunMutex);
+            if (numberOfWorkers == Workers.size()) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(Mutex);
+                Stop = true;
+            }
+            WorkCondition.notify_all();
+            for (size_t index = 0; index < Workers.size(); ++index) {
+                Workers[index].join();
+            }
+            Workers.clear();
+            Stop = false;
+            for (size_type index = 0; index < numberOfWorkers; ++index) {
+                Workers.push_back(std::thread(&ThreadPool::WorkerLoop, this));
+            }
+        }
+
+        void Run(const size_type numberOfTasks, vctParallel::TaskType task, void * data) {
+            // run sequentially if the pool is already used by another thread
+            std::unique_lock<std::mutex> runLock(RunMutex, std::try_to_lock);
+            if (!runLock.owns_lock() || Workers.empty() || (numberOfTasks < 2)) {
+                runLock = std::unique_lock<std::mutex>();
+                RunSequential(numberOfTasks, task, data);
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(Mutex);
+                Task = task;
+                Data = data;
+                NumberOfTasks = numberOfTasks;
+                NextTask = 0;
+                RemainingTasks = numberOfTasks;
+                Exception = std::exception_ptr();
+                ++Generation;
+            }
+            WorkCondition.notify_all();
+            InParallelLoop = true;
+            Work(task, data, numberOfTasks);
+            InParallelLoop = false;
+            std::exception_ptr exception;
+            {
+                std::unique_lock<std::mutex> lock(Mutex);
+                DoneCondition.wait(lock, [this] { return (RemainingTasks == 0) && (ActiveWorkers == 0); });
+                Task = 0;
+                Data = 0;
+                exception = Exception;
+                Exception = std::exception_ptr();
+            }
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+        }
+
+    protected:
+        void RunSequential(const size_type numberOfTasks, vctParallel::TaskType task, void * data) {
+            const bool inParallelLoop = InParallelLoop;
+            InParallelLoop = true;
+            try {
+                for (index_type index = 0; index < numberOfTasks; ++index) {
+                    task(data, index);
+                }
+            } catch (...) {
+                InParallelLoop = inParallelLoop;
+                throw;
+            }
+            InParallelLoop = inParallelLoop;
+        }
+
+        void Work(vctParallel::TaskType task, void * data, const size_type numberOfTasks) {
+            index_type index;
+            while ((index = NextTask.fetch_add(1)) < numberOfTasks) {
+                try {
+                    task(data, index);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(Mutex);
+                    if (!Exception) {
+                        Exception = std::current_exception();
+                    }
+                }
+                if (RemainingTasks.fetch_sub(1) == 1) {
+                    std::lock_guard<std::mutex> lock(Mutex);
+                    DoneCondition.notify_all();
+                }
+            }
+        }
+
+        void WorkerLoop(void) {
+            InParallelLoop = true;
+            size_type generation = 0;
+            std::unique_lock<std::mutex> lock(Mutex);
+            while (true) {
+                WorkCondition.wait(lock, [this, generation] { return Stop || (Generation != generation); });
+                if (Stop) {
+                    return;
+                }
+                generation = Generation;
+                // the job might already be completed
+                if (Task == 0) {
+                    continue;
+                }
+                vctParallel::TaskType task = Task;
+                void * data = Data;
+                const size_type numberOfTasks = NumberOfTasks;
+                ++ActiveWorkers;
+                lock.unlock();
+                Work(task, data, numberOfTasks);
+                lock.lock();
+                --ActiveWorkers;
+                if (ActiveWorkers == 0) {
+                    DoneCondition.notify_all();
+                }
+            }
+        }
+
+        std::vector<std::thread> Workers;
+        std::mutex RunMutex; // one job at a time
+        std::mutex Mutex; // protects the job description
+        std::condition_variable WorkCondition, DoneCondition;
+        bool Stop;
+        size_type Generation;
+        size_type ActiveWorkers;
+        vctParallel::TaskType Task;
+        void * Data;
+        size_type NumberOfTasks;
+        std::atomic<size_type> NextTask;
+        std::atomic<size_type> RemainingTasks;
+        std::exception_ptr Exception;
+    };
+
+    ThreadPool & Pool(void) {
+        static ThreadPool pool;
+        return pool;
+    }
+}
+
+
+std::atomic<size_type> vctParallel::EnabledThreshold(std::numeric_limits<size_type>::max());
+
+
+size_type vctParallel::GetNumberOfThreads(void)
+{
+    return Pool().GetNumberOfWorkers() + 1;
+}
+
+
+void vctParallel::SetNumberOfThreads(const size_type numberOfThreads)
+{
+    size_type threads = numberOfThreads;
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    if (threads == 0) {
+        threads = 1;
+    }
+    Pool().SetNumberOfWorkers(threads - 1);
+    EnabledThreshold.store((threads > 1) ? Threshold.load() : std::numeric_limits<size_type>::max());
+}
+
+
+size_type vctParallel::GetThreshold(void)
+{
+    return Threshold.load();
+}
+
+
+void vctParallel::SetThreshold(const size_type numberOfElements)
+{
+    Threshold.store(numberOfElements);
+    if (GetNumberOfThreads() > 1) {
+        EnabledThreshold.store(numberOfElements);
+    }
+}
+
+
+bool vctParallel::IsAvailable(void)
+{
+    return !InParallelLoop;
+}
+
+
+void vctParallel::Run(const size_type numberOfTasks, TaskType task, void * data)
+{
+    Pool().Run(numberOfTasks, task, data);
+}
@@ -0,0 +1,103 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstVector/vctDynamicMatrix.h>
+#include <cisstVector/vctDynamicMatrixProduct.h>
+#include <cisstOSAbstraction/osaStopwatch.h>
+#include <cisstVector/vctRandom.h>
+#include <cisstCommon/cmnPrintf.h>
+#include <iostream>
+
+/* test "parameters" */
+typedef double value_type;
+const double minimumTime = 0.2; // in seconds, per size and kernel
+
+typedef vctDynamicMatrix<value_type> MatrixType;
+typedef vctDynamicMatrixProduct ProductType;
+
+
+/* average time in milliseconds for output = input1 * input2, repeated for at least minimumTime */
+double TimeProduct(MatrixType & output, const MatrixType & input1, const MatrixType & input2)
+{
+    osaStopwatch timer;
+    unsigned int iterations = 0;
+    /* "prime" the pump */
+    output.ProductOf(input1, input2);
+    timer.Reset();
+    timer.Start();
+    do {
+        output.ProductOf(input1, input2);
+        ++iterations;
+    } while (timer.GetElapsedTime() < minimumTime);
+    timer.Stop();
+    return 1000.0 * timer.GetElapsedTime() / iterations;
+}
+
+
+int main()
+{
+    const size_t sizes[] = {8, 16, 32, 64, 100, 200, 400, 800};
+    const size_t numberOfSizes = sizeof(sizes) / sizeof(size_t);
+    const ProductType::KernelType kernels[] = {ProductType::KERNEL_NONE, ProductType::KERNEL_SCALAR,
+                                               ProductType::KERNEL_AVX2, ProductType::KERNEL_BLAS};
+    const char * names[] = {"loop engine", "blocked", "blocked AVX2", "BLAS"};
+    const size_t numberOfKernels = sizeof(kernels) / sizeof(ProductType::KernelType);
+
+    std::cout << "This program compares the engines used to compute the product of square matrices.\n"
+              << "Times are in milliseconds, the default kernel is \"" << names[ProductType::GetKernel()] << "\"\n"
+              << "and the blocked engines are used above " << ProductType::GetThreshold() << " multiply-adds.\n\n";
+
+    /* header */
+    size_t kernel, index;
+    std::cout << cmnPrintf("%6s") << "size";
+    for (kernel = 0; kernel < numberOfKernels; ++kernel) {
+        std::cout << cmnPrintf("%15s") << names[kernel];
+    }
+    std::cout << std::endl;
+
+    /* always use the selected kernel */
+    const ProductType::KernelType defaultKernel = ProductType::GetKernel();
+    const ProductType::size_type defaultThreshold = ProductType::GetThreshold();
+    ProductType::SetThreshold(0);
+
+    MatrixType input1, input2, output;
+    for (index = 0; index < numberOfSizes; ++index) {
+        const size_t size = sizes[index];
+        input1.SetSize(size, size);
+        input2.SetSize(size, size);
+        output.SetSize(size, size);
+        vctRandom(input1, value_type(-20), value_type(20));
+        vctRandom(input2, value_type(-20), value_type(20));
+
+        std::cout << cmnPrintf("%6d") << size;
+        for (kernel = 0; kernel < numberOfKernels; ++kernel) {
+            if (ProductType::SetKernel(kernels[kernel])) {
+                std::cout << cmnPrintf("%15.4f") << TimeProduct(output, input1, input2);
+            } else {
+                std::cout << cmnPrintf("%15s") << "n/a";
+            }
+            std::cout << std::flush;
+        }
+        std::cout << std::endl;
+    }
+
+    ProductType::SetKernel(defaultKernel);
+    ProductType::SetThreshold(defaultThreshold);
+    return 0;
+}
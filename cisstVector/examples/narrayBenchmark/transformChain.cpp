@@ -0,0 +1,169 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstVector/vctTransformationTypes.h>
+#include <cisstVector/vctFrame4x4.h>
+#include <cisstVector/vctFixedSizeSIMD.h>
+#include <cisstCommon/cmnRandomSequence.h>
+#include <cisstOSAbstraction/osaStopwatch.h>
+#include <cisstCommon/cmnPrintf.h>
+#include <iostream>
+
+/* test "parameters" */
+const size_t numberOfLinks = 7; // e.g. a 7 DOF arm
+const double minimumTime = 0.5; // in seconds, per representation
+
+typedef vctFrame4x4<double> Frame4x4Type;
+
+/* transformation of a revolute joint using modified DH parameters,
+   as in robManipulator::ForwardKinematics */
+Frame4x4Type LinkTransformation(const double alpha, const double a, const double theta, const double d)
+{
+    const double ca = cos(alpha), sa = sin(alpha), ct = cos(theta), st = sin(theta);
+    vctMatRot3 rotation(ct,      -st,      0.0,
+                        st * ca,  ct * ca, -sa,
+                        st * sa,  ct * sa,  ca,
+                        VCT_DO_NOT_NORMALIZE);
+    return Frame4x4Type(rotation, vct3(a, -sa * d, ca * d));
+}
+
+
+/* reference implementation using plain arrays and loops, 4x4 row major */
+void ReferenceChain(const double links[][16], double * result)
+{
+    double current[16], next[16];
+    size_t link, row, col, index;
+    for (index = 0; index < 16; ++index) {
+        current[index] = links[0][index];
+    }
+    for (link = 1; link < numberOfLinks; ++link) {
+        for (row = 0; row < 4; ++row) {
+            for (col = 0; col < 4; ++col) {
+                double sum = 0.0;
+                for (index = 0; index < 4; ++index) {
+                    sum += current[row * 4 + index] * links[link][index * 4 + col];
+                }
+                next[row * 4 + col] = sum;
+            }
+        }
+        for (index = 0; index < 16; ++index) {
+            current[index] = next[index];
+        }
+    }
+    for (index = 0; index < 16; ++index) {
+        result[index] = current[index];
+    }
+}
+
+
+/* average time in nanoseconds for a chain of products, result = links[0] * links[1] * ... */
+template <class _frameType>
+double TimeChain(const _frameType * links, _frameType & result)
+{
+    osaStopwatch timer;
+    unsigned int iterations = 0;
+    timer.Reset();
+    timer.Start();
+    do {
+        for (size_t repeat = 0; repeat < 1000; ++repeat) {
+            result = links[0];
+            for (size_t link = 1; link < numberOfLinks; ++link) {
+                result = result * links[link];
+            }
+        }
+        iterations += 1000;
+    } while (timer.GetElapsedTime() < minimumTime);
+    timer.Stop();
+    return 1.0e9 * timer.GetElapsedTime() / iterations;
+}
+
+
+double TimeReferenceChain(const double links[][16], double * result)
+{
+    osaStopwatch timer;
+    unsigned int iterations = 0;
+    timer.Reset();
+    timer.Start();
+    do {
+        for (size_t repeat = 0; repeat < 1000; ++repeat) {
+            ReferenceChain(links, result);
+        }
+        iterations += 1000;
+    } while (timer.GetElapsedTime() < minimumTime);
+    timer.Stop();
+    return 1.0e9 * timer.GetElapsedTime() / iterations;
+}
+
+
+int main()
+{
+    std::cout << "This program measures the time to compose a chain of " << numberOfLinks << " transformations,\n"
+              << "as in robManipulator::ForwardKinematics.  Fixed size kernels use \""
+              << vctFixedSizeSIMD::InstructionSet() << "\",\n"
+              << "configure with CISST_VCT_FIXED_SIZE_SIMD OFF to compare with the loop engines.\n\n";
+
+    /* random links, same transformations for all representations */
+    Frame4x4Type frames4x4[numberOfLinks];
+    vctFrm3 frames[numberOfLinks];
+    vctQuatFrm3 quaternionFrames[numberOfLinks];
+    double arrays[numberOfLinks][16];
+    cmnRandomSequence & random = cmnRandomSequence::GetInstance();
+    size_t link;
+    for (link = 0; link < numberOfLinks; ++link) {
+        frames4x4[link] = LinkTransformation(random.ExtractRandomDouble(-cmnPI_2, cmnPI_2),
+                                             random.ExtractRandomDouble(0.0, 0.5),
+                                             random.ExtractRandomDouble(-cmnPI, cmnPI),
+                                             random.ExtractRandomDouble(0.0, 0.5));
+        frames[link].Rotation().Assign(frames4x4[link].Rotation());
+        frames[link].Translation().Assign(frames4x4[link].Translation());
+        quaternionFrames[link].Rotation().From(frames[link].Rotation());
+        quaternionFrames[link].Translation().Assign(frames4x4[link].Translation());
+        vctFixedSizeMatrixRef<double, 4, 4, 4, 1> arrayRef(arrays[link]);
+        arrayRef.Assign(frames4x4[link]);
+    }
+
+    Frame4x4Type result4x4;
+    vctFrm3 result;
+    vctQuatFrm3 quaternionResult;
+    double resultArray[16];
+
+    std::cout << cmnPrintf("%-32s") << "representation";
+    std::cout << cmnPrintf("%12s") << "ns/chain";
+    std::cout << std::endl;
+    std::cout << cmnPrintf("%-32s") << "reference loops (double[16])";
+    std::cout << cmnPrintf("%12.1f") << TimeReferenceChain(arrays, resultArray);
+    std::cout << std::endl;
+    std::cout << cmnPrintf("%-32s") << "vctFrame4x4<double>";
+    std::cout << cmnPrintf("%12.1f") << TimeChain(frames4x4, result4x4);
+    std::cout << std::endl;
+    std::cout << cmnPrintf("%-32s") << "vctFrm3 (rotation matrix)";
+    std::cout << cmnPrintf("%12.1f") << TimeChain(frames, result);
+    std::cout << std::endl;
+    std::cout << cmnPrintf("%-32s") << "vctQuatFrm3 (quaternion)";
+    std::cout << cmnPrintf("%12.1f") << TimeChain(quaternionFrames, quaternionResult);
+    std::cout << std::endl;
+
+    /* all representations should give the same end effector position */
+    const vctFixedSizeConstMatrixRef<double, 4, 4, 4, 1> resultArrayRef(resultArray);
+    std::cout << "\nDifferences with reference loops (translation): "
+              << (result4x4.Translation() - resultArrayRef.Column(3).Ref<3>()).MaxAbsElement() << " "
+              << (result.Translation() - resultArrayRef.Column(3).Ref<3>()).MaxAbsElement() << " "
+              << (quaternionResult.Translation() - resultArrayRef.Column(3).Ref<3>()).MaxAbsElement() << std::endl;
+    return 0;
+}
@@ -6,7 +6,7 @@
   Author(s):  Anton Deguet
   Created on: 2004-07-09
   
-  (C) Copyright 2004-2007 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -26,6 +26,8 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstVector/vctDynamicMatrix.h>
 #include <cisstVector/vctDynamicConstMatrixRef.h>
+#include <cisstVector/vctDynamicMatrixExpression.h>
+#include <cisstVector/vctParallel.h>
 #include <cisstVector/vctRandomDynamicVector.h>
 #include <cisstVector/vctRandomDynamicMatrix.h>
 #include <cisstVector/vctRandomFixedSizeMatrix.h>
@@ -499,6 +501,30 @@ void vctDynamicMatrixTest::TestProductOperations(void) {
     matrix1.SetSize(COMSIZE, COMSIZE);
     matrix2.SetSize(COMSIZE, COMSIZE);
     vctGenericMatrixTest::TestMatrixMatrixProductExceptions(matrix1, matrix2);
+
+    // larger sizes, above vctDynamicMatrixProduct default thresholds
+    // for float and double.  Sizes are not multiple of the blocks.
+    enum {LARGE_ROWS = 67, LARGE_COLS = 53, LARGE_COMSIZE = 83};
+    matrix1.SetSize(LARGE_ROWS, LARGE_COMSIZE);
+    vctDynamicMatrix<value_type> columnMajor2(LARGE_COMSIZE, LARGE_COLS, VCT_COL_MAJOR);
+    matrix3.SetSize(LARGE_ROWS, LARGE_COLS);
+    vctRandom(matrix1, value_type(-1), value_type(1));
+    vctRandom(columnMajor2, value_type(-1), value_type(1));
+    vctGenericMatrixTest::TestMatrixMatrixProductOperations(matrix1, columnMajor2, matrix3);
+
+    // non compact operands and output
+    vctDynamicMatrix<value_type> parent1(LARGE_ROWS, 2 * LARGE_COMSIZE);
+    vctDynamicMatrix<value_type> parent2(2 * LARGE_COMSIZE, LARGE_COLS);
+    vctDynamicMatrix<value_type> parent3(2 * LARGE_ROWS, 2 * LARGE_COLS);
+    vctRandom(parent1, value_type(-1), value_type(1));
+    vctRandom(parent2, value_type(-1), value_type(1));
+    vctDynamicMatrixRef<value_type> nonCompact1(LARGE_ROWS, LARGE_COMSIZE,
+                                                parent1.row_stride(), 2, parent1.Pointer());
+    vctDynamicMatrixRef<value_type> nonCompact2(LARGE_COMSIZE, LARGE_COLS,
+                                                2 * parent2.row_stride(), 1, parent2.Pointer());
+    vctDynamicMatrixRef<value_type> nonCompact3(LARGE_ROWS, LARGE_COLS,
+                                                2 * parent3.row_stride(), 2, parent3.Pointer());
+    vctGenericMatrixTest::TestMatrixMatrixProductOperations(nonCompact1, nonCompact2, nonCompact3);
 }
 
 void vctDynamicMatrixTest::TestProductOperationsDouble(void) {
@@ -837,5 +863,201 @@ void vctDynamicMatrixTest::TestFastCopyOfInt(void) {
 }
 
 
+template <class _elementType>
+void vctDynamicMatrixTest::TestLazyExpressions(void) {
+    enum {ROWS = 5, COLS = 7};
+    typedef _elementType value_type;
+    const value_type tolerance = cmnTypeTraits<value_type>::Tolerance();
+    vctDynamicMatrix<value_type> matrix1(ROWS, COLS), matrix2(ROWS, COLS), matrix3(ROWS, COLS, VCT_COL_MAJOR);
+    vctDynamicMatrix<value_type> result(ROWS, COLS), expected;
+    vctRandom(matrix1, value_type(-10), value_type(10));
+    vctRandom(matrix2, value_type(-10), value_type(10));
+    vctRandom(matrix3, value_type(-10), value_type(10));
+    const value_type scalar = value_type(3);
+
+    // compact, same storage order
+    const value_type * data = result.Pointer();
+    result = vctLazy(matrix1) * scalar - matrix2 / scalar;
+    expected = matrix1 * scalar - matrix2 / scalar;
+    CPPUNIT_ASSERT(result.AlmostEqual(expected, tolerance));
+    CPPUNIT_ASSERT(data == result.Pointer());
+
+    // different storage orders
+    result = vctLazy(matrix1) + vctLazy(matrix3) - scalar;
+    expected = matrix1 + matrix3 - scalar;
+    CPPUNIT_ASSERT(result.AlmostEqual(expected, tolerance));
+
+    result.Assign(matrix2);
+    result += scalar * -vctLazy(matrix3);
+    expected = matrix2 - matrix3 * scalar;
+    CPPUNIT_ASSERT(result.AlmostEqual(expected, tolerance));
+
+    result -= vctLazy(matrix1) + matrix2;
+    expected -= matrix1 + matrix2;
+    CPPUNIT_ASSERT(result.AlmostEqual(expected, tolerance));
+
+    // transposed and non compact references
+    vctDynamicMatrix<value_type> transposed(vctLazy(matrix1.TransposeRef()) * scalar);
+    CPPUNIT_ASSERT(transposed.AlmostEqual(matrix1.Transpose() * scalar, tolerance));
+    vctDynamicMatrix<value_type> larger(ROWS + 2, COLS + 2);
+    vctRandom(larger, value_type(-10), value_type(10));
+    vctDynamicMatrixRef<value_type> subMatrix(larger, 1, 1, ROWS, COLS);
+    expected = subMatrix * scalar + matrix3;
+    subMatrix = vctLazy(subMatrix) * scalar + matrix3;
+    CPPUNIT_ASSERT(subMatrix.AlmostEqual(expected, tolerance));
+
+    // conversion to the type returned by the regular operators
+    vctDynamicMatrix<value_type> converted(vctLazy(matrix1) - matrix2);
+    CPPUNIT_ASSERT(converted.AlmostEqual(matrix1 - matrix2, tolerance));
+
+    // size mismatch
+    bool exceptionReceived = false;
+    try {
+        result = vctLazy(matrix1) + transposed;
+    } catch (std::runtime_error &) {
+        exceptionReceived = true;
+    }
+    CPPUNIT_ASSERT(exceptionReceived);
+    exceptionReceived = false;
+    try {
+        transposed.Assign(vctLazy(matrix1) * scalar);
+    } catch (std::runtime_error &) {
+        exceptionReceived = true;
+    }
+    CPPUNIT_ASSERT(exceptionReceived);
+}
+
+void vctDynamicMatrixTest::TestLazyExpressionsDouble(void) {
+    TestLazyExpressions<double>();
+}
+void vctDynamicMatrixTest::TestLazyExpressionsFloat(void) {
+    TestLazyExpressions<float>();
+}
+
+
+template <class _elementType>
+void vctDynamicMatrixTest::TestStorage(void) {
+    typedef _elementType value_type;
+    typedef typename vctDynamicMatrix<value_type>::OwnerType::StorageType StorageType;
+    const size_t smallRows = 2;
+    const size_t smallCols = StorageType::INLINE_CAPACITY / smallRows;
+    const size_t largeRows = smallRows + 5;
+    const size_t largeCols = smallCols + 5;
+
+    // small matrices are stored inline, larger ones are aligned on the heap
+    vctDynamicMatrix<value_type> small(smallRows, smallCols, VCT_COL_MAJOR), large(largeRows, largeCols);
+    vctRandom(small, value_type(-10), value_type(10));
+    vctRandom(large, value_type(-10), value_type(10));
+    if (small.size() != 0) {
+        CPPUNIT_ASSERT(small.Owner().IsInline());
+    }
+    CPPUNIT_ASSERT(!large.Owner().IsInline());
+    CPPUNIT_ASSERT((reinterpret_cast<size_t>(large.Pointer()) % StorageType::HEAP_ALIGNMENT) == 0);
+
+    // results returned by operators preserve the storage order
+    vctDynamicMatrix<value_type> result;
+    result = small + small;
+    CPPUNIT_ASSERT(result.Equal(small * value_type(2)));
+    CPPUNIT_ASSERT(result.IsColMajor());
+    CPPUNIT_ASSERT(result.Owner().IsInline() == small.Owner().IsInline());
+    result = large - large;
+    CPPUNIT_ASSERT(result.Equal(value_type(0)));
+    CPPUNIT_ASSERT(result.IsRowMajor());
+
+    // resize from and to the inline storage
+    vctDynamicMatrix<value_type> copy(large);
+    copy.resize(smallRows, smallCols);
+    CPPUNIT_ASSERT(copy.Equal(vctDynamicConstMatrixRef<value_type>(large, 0, 0, smallRows, smallCols)));
+    CPPUNIT_ASSERT(copy.Owner().IsInline() == small.Owner().IsInline());
+    copy.resize(largeRows, largeCols);
+    CPPUNIT_ASSERT(vctDynamicConstMatrixRef<value_type>(copy, 0, 0, smallRows, smallCols).Equal(vctDynamicConstMatrixRef<value_type>(large, 0, 0, smallRows, smallCols)));
+    CPPUNIT_ASSERT(!copy.Owner().IsInline());
+}
+
+void vctDynamicMatrixTest::TestStorageDouble(void) {
+    TestStorage<double>();
+}
+void vctDynamicMatrixTest::TestStorageInt(void) {
+    TestStorage<int>();
+}
+
+
+template <class _elementType>
+void vctDynamicMatrixTest::TestParallel(void) {
+    typedef _elementType value_type;
+    const value_type tolerance = cmnTypeTraits<value_type>::Tolerance();
+    const vctParallel::size_type defaultNumberOfThreads = vctParallel::GetNumberOfThreads();
+    const vctParallel::size_type defaultThreshold = vctParallel::GetThreshold();
+    // large enough for a few blocks of uneven sizes
+    const size_t rows = 301;
+    const size_t cols = 211;
+
+    vctDynamicMatrix<value_type> input1(rows, cols), input2(rows, cols, VCT_COL_MAJOR);
+    vctRandom(input1, value_type(-10), value_type(10));
+    vctRandom(input2, value_type(-10), value_type(10));
+    vctDynamicVector<size_t> indices(2 * rows);
+    size_t index;
+    for (index = 0; index < indices.size(); ++index) {
+        indices[index] = (index * 7) % rows;
+    }
+    const vctDynamicConstMatrixRef<value_type> slice(input1, 1, 1, rows - 2, cols - 2);
+
+    // sequential results, compact and non compact (different storage orders)
+    vctParallel::SetNumberOfThreads(1);
+    vctDynamicMatrix<value_type> sum(rows, cols), product(rows, cols, VCT_COL_MAJOR), selected(indices.size(), cols);
+    sum.SumOf(input1, input2);
+    sum.Multiply(value_type(2));
+    product.ElementwiseProductOf(input1, input1);
+    product.Subtract(input2);
+    selected.SelectRowsFrom(input1, indices);
+    const value_type sumOfElements = input1.SumOfElements();
+    const value_type normSquare = slice.NormSquare();
+    const value_type maxAbsElement = product.MaxAbsElement();
+
+    // parallel results don't depend on the number of threads
+    vctDynamicMatrix<value_type> parallelSum, parallelProduct, parallelSelected;
+    value_type parallelSumOfElements = value_type(0);
+    value_type parallelNormSquare = value_type(0);
+    const vctParallel::size_type numberOfThreads[] = {2, 4};
+    for (index = 0; index < 2; ++index) {
+        vctParallel::SetNumberOfThreads(numberOfThreads[index]);
+        vctParallel::SetThreshold(1000);
+        CPPUNIT_ASSERT_EQUAL(numberOfThreads[index], vctParallel::GetNumberOfThreads());
+        parallelSum.SetSize(rows, cols);
+        parallelSum.SumOf(input1, input2);
+        parallelSum.Multiply(value_type(2));
+        CPPUNIT_ASSERT(parallelSum.Equal(sum));
+        parallelProduct.SetSize(rows, cols, VCT_COL_MAJOR);
+        parallelProduct.ElementwiseProductOf(input1, input1);
+        parallelProduct.Subtract(input2);
+        CPPUNIT_ASSERT(parallelProduct.Equal(product));
+        parallelSelected.SetSize(indices.size(), cols);
+        parallelSelected.SelectRowsFrom(input1, indices);
+        CPPUNIT_ASSERT(parallelSelected.Equal(selected));
+        CPPUNIT_ASSERT_EQUAL(maxAbsElement, parallelProduct.MaxAbsElement());
+        if (index == 0) {
+            parallelSumOfElements = input1.SumOfElements();
+            parallelNormSquare = slice.NormSquare();
+            // sums can differ slightly from the sequential loop
+            CPPUNIT_ASSERT(std::fabs(static_cast<double>(parallelSumOfElements) - static_cast<double>(sumOfElements)) <= tolerance * rows * cols);
+            CPPUNIT_ASSERT(std::fabs(static_cast<double>(parallelNormSquare) - static_cast<double>(normSquare)) <= tolerance * normSquare);
+        } else {
+            CPPUNIT_ASSERT_EQUAL(parallelSumOfElements, input1.SumOfElements());
+            CPPUNIT_ASSERT_EQUAL(parallelNormSquare, slice.NormSquare());
+        }
+    }
+
+    vctParallel::SetNumberOfThreads(defaultNumberOfThreads);
+    vctParallel::SetThreshold(defaultThreshold);
+}
+
+void vctDynamicMatrixTest::TestParallelDouble(void) {
+    TestParallel<double>();
+}
+void vctDynamicMatrixTest::TestParallelInt(void) {
+    TestParallel<int>();
+}
+
+
 CPPUNIT_TEST_SUITE_REGISTRATION(vctDynamicMatrixTest);
 
@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2004-07-09
 
-  (C) Copyright 2004-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -25,6 +25,8 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstVector/vctDynamicVector.h>
 #include <cisstVector/vctDynamicVectorRef.h>
 #include <cisstVector/vctDynamicConstVectorRef.h>
+#include <cisstVector/vctDynamicVectorExpression.h>
+#include <cisstVector/vctParallel.h>
 #include <cisstVector/vctRandomFixedSizeVector.h>
 #include <cisstVector/vctRandomDynamicVector.h>
 
@@ -856,4 +858,196 @@ void vctDynamicVectorTest::TestNormalizationFloat(void) {
     TestNormalization<float>();
 }
 
+
+template <class _elementType>
+void vctDynamicVectorTest::TestLazyExpressions(void) {
+    enum {SIZE = 12};
+    typedef _elementType value_type;
+    const value_type tolerance = cmnTypeTraits<value_type>::Tolerance();
+    vctDynamicVector<value_type> vector1(SIZE), vector2(SIZE), vector3(SIZE);
+    vctDynamicVector<value_type> result(SIZE), expected;
+    vctRandom(vector1, value_type(-10), value_type(10));
+    vctRandom(vector2, value_type(-10), value_type(10));
+    vctRandom(vector3, value_type(-10), value_type(10));
+    const value_type scalar = value_type(3);
+
+    // compare to the regular operators
+    const value_type * data = result.Pointer();
+    result = vctLazy(vector1) + vctLazy(vector2) * scalar - vector3;
+    expected = vector1 + vector2 * scalar - vector3;
+    CPPUNIT_ASSERT(result.AlmostEqual(expected, tolerance));
+    CPPUNIT_ASSERT(data == result.Pointer());
+
+    result = scalar - vctLazy(vector1) / scalar;
+    expected = scalar - vector1 / scalar;
+    CPPUNIT_ASSERT(result.AlmostEqual(expected, tolerance));
+
+    result.Assign(vector3);
+    result += -vctLazy(vector1) * scalar;
+    expected = vector3 - vector1 * scalar;
+    CPPUNIT_ASSERT(result.AlmostEqual(expected, tolerance));
+
+    result -= vctLazy(vector2) + scalar;
+    expected -= vector2 + scalar;
+    CPPUNIT_ASSERT(result.AlmostEqual(expected, tolerance));
+
+    // self assignment and resize
+    result.SetSize(1);
+    result = vctLazy(vector1) * scalar;
+    CPPUNIT_ASSERT(result.AlmostEqual(vector1 * scalar, tolerance));
+    result = vctLazy(result) + vector1;
+    CPPUNIT_ASSERT(result.AlmostEqual(vector1 * (scalar + value_type(1)), tolerance));
+
+    // non compact references
+    vctDynamicVector<value_type> larger(2 * SIZE);
+    vctRandom(larger, value_type(-10), value_type(10));
+    vctDynamicVectorRef<value_type> evenRef(SIZE, larger.Pointer(0), 2);
+    vctDynamicVectorRef<value_type> oddRef(SIZE, larger.Pointer(1), 2);
+    expected = evenRef + vector1 * scalar;
+    oddRef = vctLazy(evenRef) + vctLazy(vector1) * scalar;
+    CPPUNIT_ASSERT(oddRef.AlmostEqual(expected, tolerance));
+
+    // conversion to the type returned by the regular operators
+    vctDynamicVector<value_type> converted(vctLazy(vector1) - vector2);
+    CPPUNIT_ASSERT(converted.AlmostEqual(vector1 - vector2, tolerance));
+
+    // size mismatch
+    vctDynamicVector<value_type> smaller(SIZE - 1);
+    bool exceptionReceived = false;
+    try {
+        result = vctLazy(vector1) + smaller;
+    } catch (std::runtime_error &) {
+        exceptionReceived = true;
+    }
+    CPPUNIT_ASSERT(exceptionReceived);
+    exceptionReceived = false;
+    try {
+        smaller.Assign(vctLazy(vector1) * scalar);
+    } catch (std::runtime_error &) {
+        exceptionReceived = true;
+    }
+    CPPUNIT_ASSERT(exceptionReceived);
+}
+
+void vctDynamicVectorTest::TestLazyExpressionsDouble(void) {
+    TestLazyExpressions<double>();
+}
+void vctDynamicVectorTest::TestLazyExpressionsFloat(void) {
+    TestLazyExpressions<float>();
+}
+
+
+template <class _elementType>
+void vctDynamicVectorTest::TestStorage(void) {
+    typedef _elementType value_type;
+    typedef typename vctDynamicVector<value_type>::OwnerType::StorageType StorageType;
+    const size_t smallSize = StorageType::INLINE_CAPACITY;
+    const size_t largeSize = smallSize + 20;
+
+    // small vectors are stored inline, larger ones are aligned on the heap
+    vctDynamicVector<value_type> small(smallSize), large(largeSize);
+    vctRandom(small, value_type(-10), value_type(10));
+    vctRandom(large, value_type(-10), value_type(10));
+    if (smallSize != 0) {
+        CPPUNIT_ASSERT(small.Owner().IsInline());
+    }
+    CPPUNIT_ASSERT(!large.Owner().IsInline());
+    CPPUNIT_ASSERT((reinterpret_cast<size_t>(large.Pointer()) % StorageType::HEAP_ALIGNMENT) == 0);
+
+    // results returned by operators and copies
+    vctDynamicVector<value_type> result;
+    result = small + small;
+    CPPUNIT_ASSERT(result.Equal(small * value_type(2)));
+    CPPUNIT_ASSERT(result.Owner().IsInline() == small.Owner().IsInline());
+    vctDynamicVector<value_type> copy(large);
+    result = large - copy;
+    CPPUNIT_ASSERT(result.Equal(value_type(0)));
+    CPPUNIT_ASSERT(!result.Owner().IsInline());
+
+    // resize from and to the inline storage
+    copy.resize(smallSize);
+    CPPUNIT_ASSERT(copy.Equal(vctDynamicConstVectorRef<value_type>(large, 0, smallSize)));
+    CPPUNIT_ASSERT(copy.Owner().IsInline() == small.Owner().IsInline());
+    copy.resize(largeSize);
+    CPPUNIT_ASSERT(vctDynamicConstVectorRef<value_type>(copy, 0, smallSize).Equal(vctDynamicConstVectorRef<value_type>(large, 0, smallSize)));
+    CPPUNIT_ASSERT(!copy.Owner().IsInline());
+
+    // released memory is always on the heap
+    const size_t size = small.size();
+    value_type * released = small.Owner().Release();
+    CPPUNIT_ASSERT(small.size() == 0);
+    small.Owner().Own(size, released);
+    CPPUNIT_ASSERT(!small.Owner().IsInline());
+    CPPUNIT_ASSERT(small.Equal(result = small));
+}
+
+void vctDynamicVectorTest::TestStorageDouble(void) {
+    TestStorage<double>();
+}
+void vctDynamicVectorTest::TestStorageInt(void) {
+    TestStorage<int>();
+}
+
+
+template <class _elementType>
+void vctDynamicVectorTest::TestParallel(void) {
+    typedef _elementType value_type;
+    const value_type tolerance = cmnTypeTraits<value_type>::Tolerance();
+    const vctParallel::size_type defaultNumberOfThreads = vctParallel::GetNumberOfThreads();
+    const vctParallel::size_type defaultThreshold = vctParallel::GetThreshold();
+    // large enough for a few blocks of uneven sizes
+    const size_t size = 100003;
+
+    vctDynamicVector<value_type> input1(size), input2(size);
+    vctRandom(input1, value_type(-10), value_type(10));
+    vctRandom(input2, value_type(-10), value_type(10));
+
+    // sequential results
+    vctParallel::SetNumberOfThreads(1);
+    vctDynamicVector<value_type> result(size);
+    result.DifferenceOf(input1, input2);
+    result.Multiply(value_type(3));
+    result.Add(input1);
+    const value_type dotProduct = input1.DotProduct(input2);
+    const value_type sumOfElements = result.SumOfElements();
+    const value_type maxAbsElement = result.MaxAbsElement();
+
+    // parallel results don't depend on the number of threads
+    vctDynamicVector<value_type> parallelResult(size);
+    value_type parallelDotProduct = value_type(0);
+    value_type parallelSumOfElements = value_type(0);
+    const vctParallel::size_type numberOfThreads[] = {2, 4};
+    size_t index;
+    for (index = 0; index < 2; ++index) {
+        vctParallel::SetNumberOfThreads(numberOfThreads[index]);
+        vctParallel::SetThreshold(1000);
+        CPPUNIT_ASSERT_EQUAL(numberOfThreads[index], vctParallel::GetNumberOfThreads());
+        parallelResult.DifferenceOf(input1, input2);
+        parallelResult.Multiply(value_type(3));
+        parallelResult.Add(input1);
+        CPPUNIT_ASSERT(parallelResult.Equal(result));
+        CPPUNIT_ASSERT_EQUAL(maxAbsElement, parallelResult.MaxAbsElement());
+        if (index == 0) {
+            parallelDotProduct = input1.DotProduct(input2);
+            parallelSumOfElements = parallelResult.SumOfElements();
+            // sums can differ slightly from the sequential loop
+            CPPUNIT_ASSERT(std::fabs(static_cast<double>(parallelDotProduct) - static_cast<double>(dotProduct)) <= tolerance * size);
+            CPPUNIT_ASSERT(std::fabs(static_cast<double>(parallelSumOfElements) - static_cast<double>(sumOfElements)) <= tolerance * size);
+        } else {
+            CPPUNIT_ASSERT_EQUAL(parallelDotProduct, input1.DotProduct(input2));
+            CPPUNIT_ASSERT_EQUAL(parallelSumOfElements, parallelResult.SumOfElements());
+        }
+    }
+
+    vctParallel::SetNumberOfThreads(defaultNumberOfThreads);
+    vctParallel::SetThreshold(defaultThreshold);
+}
+
+void vctDynamicVectorTest::TestParallelDouble(void) {
+    TestParallel<double>();
+}
+void vctDynamicVectorTest::TestParallelInt(void) {
+    TestParallel<int>();
+}
+
 CPPUNIT_TEST_SUITE_REGISTRATION(vctDynamicVectorTest);
@@ -6,7 +6,7 @@
   Author(s):  Anton Deguet
   Created on: 2004-07-09
 
-  (C) Copyright 2004-2013 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -130,6 +130,15 @@ class vctDynamicVectorTest : public CppUnit::TestFixture
     CPPUNIT_TEST(TestNormalizationDouble);
     CPPUNIT_TEST(TestNormalizationFloat);
 
+    CPPUNIT_TEST(TestLazyExpressionsDouble);
+    CPPUNIT_TEST(TestLazyExpressionsFloat);
+
+    CPPUNIT_TEST(TestStorageDouble);
+    CPPUNIT_TEST(TestStorageInt);
+
+    CPPUNIT_TEST(TestParallelDouble);
+    CPPUNIT_TEST(TestParallelInt);
+
     CPPUNIT_TEST_SUITE_END();
 
  public:
@@ -329,6 +338,24 @@ class vctDynamicVectorTest : public CppUnit::TestFixture
     void TestNormalizationDouble(void);
     void TestNormalizationFloat(void);
 
+    /*! Test lazy expressions */
+    template<class _elementType>
+        void TestLazyExpressions(void);
+    void TestLazyExpressionsDouble(void);
+    void TestLazyExpressionsFloat(void);
+
+    /*! Test inline and aligned storage */
+    template<class _elementType>
+        void TestStorage(void);
+    void TestStorageDouble(void);
+    void TestStorageInt(void);
+
+    /*! Test parallel loop engines */
+    template<class _elementType>
+        void TestParallel(void);
+    void TestParallelDouble(void);
+    void TestParallelInt(void);
+
 };
 
 
@@ -6,7 +6,7 @@
   Author(s):  Anton Deguet
   Created on: 2003-12-16
 
-  (C) Copyright 2003-2013 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2003-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -667,5 +667,91 @@ void vctFixedSizeMatrixTest::TestFastCopyOfInt(void) {
 }
 
 
+template <vct::size_type _size>
+void vctFixedSizeMatrixTest::TestSIMDProducts(void) {
+    typedef double value_type;
+    enum {SIZE = _size, LARGER_SIZE = _size + 1};
+    // results can differ slightly from the loops if FMA is used
+    const value_type tolerance = cmnTypeTraits<value_type>::Tolerance();
+
+    vctFixedSizeMatrix<value_type, SIZE, SIZE> matrix1, matrix2, result, expected;
+    vctFixedSizeMatrix<value_type, LARGER_SIZE, LARGER_SIZE> larger, largerResult;
+    vctFixedSizeVector<value_type, SIZE> vector, vectorResult, expectedVector;
+    vctRandom(matrix1, value_type(-10), value_type(10));
+    vctRandom(matrix2, value_type(-10), value_type(10));
+    vctRandom(larger, value_type(-10), value_type(10));
+    vctRandom(vector, value_type(-10), value_type(10));
+    largerResult.SetAll(value_type(0));
+
+    // references with row strides larger than the number of columns, as in vctFrame4x4
+    vctFixedSizeMatrixRef<value_type, SIZE, SIZE, LARGER_SIZE, 1> largerRef(larger.Pointer());
+    vctFixedSizeMatrixRef<value_type, SIZE, SIZE, LARGER_SIZE, 1> largerResultRef(largerResult.Pointer());
+    typename vctFixedSizeMatrix<value_type, LARGER_SIZE, LARGER_SIZE>::ColumnRefType largerColumn = larger.Column(0);
+    vctFixedSizeVectorRef<value_type, SIZE, LARGER_SIZE> columnRef(largerColumn.Pointer());
+
+    vct::index_type row, col, index;
+    // matrix * matrix
+    result.ProductOf(matrix1, matrix2);
+    for (row = 0; row < SIZE; ++row) {
+        for (col = 0; col < SIZE; ++col) {
+            expected.Element(row, col) = value_type(0);
+            for (index = 0; index < SIZE; ++index) {
+                expected.Element(row, col) += matrix1.Element(row, index) * matrix2.Element(index, col);
+            }
+        }
+    }
+    CPPUNIT_ASSERT(result.AlmostEqual(expected, tolerance * expected.MaxAbsElement()));
+
+    // strided matrix * matrix, stored in a strided matrix
+    largerResultRef.ProductOf(largerRef, matrix2);
+    for (row = 0; row < SIZE; ++row) {
+        for (col = 0; col < SIZE; ++col) {
+            expected.Element(row, col) = value_type(0);
+            for (index = 0; index < SIZE; ++index) {
+                expected.Element(row, col) += larger.Element(row, index) * matrix2.Element(index, col);
+            }
+        }
+    }
+    CPPUNIT_ASSERT(largerResultRef.AlmostEqual(expected, tolerance * expected.MaxAbsElement()));
+    // elements outside of the reference are not modified
+    CPPUNIT_ASSERT(largerResult.Row(SIZE).Equal(value_type(0)));
+    CPPUNIT_ASSERT(largerResult.Column(SIZE).Equal(value_type(0)));
+
+    // matrix * vector, contiguous and strided
+    vectorResult.ProductOf(matrix1, vector);
+    for (row = 0; row < SIZE; ++row) {
+        expectedVector[row] = value_type(0);
+        for (index = 0; index < SIZE; ++index) {
+            expectedVector[row] += matrix1.Element(row, index) * vector[index];
+        }
+    }
+    CPPUNIT_ASSERT(vectorResult.AlmostEqual(expectedVector, tolerance * expectedVector.MaxAbsElement()));
+    vectorResult.ProductOf(largerRef, columnRef);
+    for (row = 0; row < SIZE; ++row) {
+        expectedVector[row] = value_type(0);
+        for (index = 0; index < SIZE; ++index) {
+            expectedVector[row] += larger.Element(row, index) * larger.Element(index, 0);
+        }
+    }
+    CPPUNIT_ASSERT(vectorResult.AlmostEqual(expectedVector, tolerance * expectedVector.MaxAbsElement()));
+
+    // output can't be one of the inputs
+    bool exceptionReceived = false;
+    try {
+        result.ProductOf(result, matrix2);
+    } catch (std::runtime_error &) {
+        exceptionReceived = true;
+    }
+    CPPUNIT_ASSERT(exceptionReceived);
+}
+
+void vctFixedSizeMatrixTest::TestSIMDProducts3x3(void) {
+    TestSIMDProducts<3>();
+}
+void vctFixedSizeMatrixTest::TestSIMDProducts4x4(void) {
+    TestSIMDProducts<4>();
+}
+
+
 CPPUNIT_TEST_SUITE_REGISTRATION(vctFixedSizeMatrixTest);
 
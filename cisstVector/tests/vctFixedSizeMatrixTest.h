@@ -117,6 +117,9 @@ class vctFixedSizeMatrixTest : public CppUnit::TestFixture
     CPPUNIT_TEST(TestFastCopyOfFloat);
     CPPUNIT_TEST(TestFastCopyOfInt);
 
+    CPPUNIT_TEST(TestSIMDProducts3x3);
+    CPPUNIT_TEST(TestSIMDProducts4x4);
+
     CPPUNIT_TEST_SUITE_END();
 
  public:
@@ -280,5 +283,11 @@ class vctFixedSizeMatrixTest : public CppUnit::TestFixture
     void TestFastCopyOfFloat(void);
     void TestFastCopyOfInt(void);
 
+    /*! Test products computed using vctFixedSizeSIMD */
+    template<vct::size_type _size>
+        void TestSIMDProducts(void);
+    void TestSIMDProducts3x3(void);
+    void TestSIMDProducts4x4(void);
+
 };
 
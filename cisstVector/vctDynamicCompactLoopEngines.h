@@ -6,7 +6,7 @@
   Author(s):	Anton Deguet
   Created on:	2007-07-07
 
-  (C) Copyright 2007-2013 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -29,6 +29,8 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstCommon/cmnPortability.h>
 #include <cisstCommon/cmnThrow.h>
+#include <cisstVector/vctDynamicVectorRefOwner.h>
+#include <cisstVector/vctParallel.h>
 
 /*!  \brief Container class for the loop based engines for compact
   containers.
@@ -50,6 +52,10 @@ http://www.cisst.org/cisst/license.txt.
   \note These engines operate directly on the owners as the engines
   calling them already a pointer on the owner.
 
+  \note When enabled with vctParallel::SetNumberOfThreads, the
+  operations on large containers are split in blocks of elements
+  computed in parallel (except MinAndMax).
+
   \sa vctDynamicVectorLoopEngines, vctDynamicMatrixLoopEngines,
   vctDynamicNArrayLoopEngines.
 */
@@ -57,6 +63,16 @@ class vctDynamicCompactLoopEngines {
 
  public:
 
+    /*! Pointer on the element at a given index of a compact container,
+      used to create the blocks of elements computed in parallel.  The
+      blocks are always vctDynamicVectorRefOwner so the engines are
+      not instantiated recursively. */
+    template <class _ownerType>
+    static inline typename _ownerType::pointer BlockPointer(const _ownerType & owner,
+                                                            const vct::index_type index) {
+        return const_cast<typename _ownerType::pointer>(owner.Pointer()) + index;
+    }
+
     /*!  \brief Implement operation of the form \f$v_o = op(v_{i1},
       v_{i2})\f$ for compact containers.
 
@@ -88,6 +104,18 @@ class vctDynamicCompactLoopEngines {
 
             const size_type size = outputOwner.size();
 
+            // large containers, run the engine in parallel on blocks of elements
+            if (vctParallel::IsEnabled(size)) {
+                vctParallel::For(size, vctParallel::NumberOfBlocks(size, size),
+                                 [&](size_type begin, size_type end) {
+                                     vctDynamicVectorRefOwner<typename _outputOwnerType::value_type> outputBlock(end - begin, BlockPointer(outputOwner, begin));
+                                     const vctDynamicVectorRefOwner<typename _input1OwnerType::value_type> input1Block(end - begin, BlockPointer(input1Owner, begin));
+                                     const vctDynamicVectorRefOwner<typename _input2OwnerType::value_type> input2Block(end - begin, BlockPointer(input2Owner, begin));
+                                     Run(outputBlock, input1Block, input2Block);
+                                 });
+                return;
+            }
+
             OutputPointerType outputPointer = outputOwner.Pointer();
             const OutputPointerType outputEnd = outputPointer + size;
 
@@ -130,6 +158,17 @@ class vctDynamicCompactLoopEngines {
 
             const size_type size = inputOutputOwner.size();
 
+            // large containers, run the engine in parallel on blocks of elements
+            if (vctParallel::IsEnabled(size)) {
+                vctParallel::For(size, vctParallel::NumberOfBlocks(size, size),
+                                 [&](size_type begin, size_type end) {
+                                     vctDynamicVectorRefOwner<typename _inputOutputOwnerType::value_type> inputOutputBlock(end - begin, BlockPointer(inputOutputOwner, begin));
+                                     const vctDynamicVectorRefOwner<typename _inputOwnerType::value_type> inputBlock(end - begin, BlockPointer(inputOwner, begin));
+                                     Run(inputOutputBlock, inputBlock);
+                                 });
+                return;
+            }
+
             InputOutputPointerType inputOutputPointer = inputOutputOwner.Pointer();
             const InputOutputPointerType inputOutputEnd = inputOutputPointer + size;
 
@@ -172,6 +211,17 @@ class vctDynamicCompactLoopEngines {
 
             const size_type size = inputOutput1Owner.size();
 
+            // large containers, run the engine in parallel on blocks of elements
+            if (vctParallel::IsEnabled(size)) {
+                vctParallel::For(size, vctParallel::NumberOfBlocks(size, size),
+                                 [&](size_type begin, size_type end) {
+                                     vctDynamicVectorRefOwner<typename _inputOutput1OwnerType::value_type> inputOutput1Block(end - begin, BlockPointer(inputOutput1Owner, begin));
+                                     vctDynamicVectorRefOwner<typename _inputOutput2OwnerType::value_type> inputOutput2Block(end - begin, BlockPointer(inputOutput2Owner, begin));
+                                     Run(inputOutput1Block, inputOutput2Block);
+                                 });
+                return;
+            }
+
             InputOutput1PointerType inputOutput1Pointer = inputOutput1Owner.Pointer();
             const InputOutput1PointerType inputOutput1End = inputOutput1Pointer + size;
 
@@ -214,6 +264,17 @@ class vctDynamicCompactLoopEngines {
 
             const size_type size = outputOwner.size();
 
+            // large containers, run the engine in parallel on blocks of elements
+            if (vctParallel::IsEnabled(size)) {
+                vctParallel::For(size, vctParallel::NumberOfBlocks(size, size),
+                                 [&](size_type begin, size_type end) {
+                                     vctDynamicVectorRefOwner<typename _outputOwnerType::value_type> outputBlock(end - begin, BlockPointer(outputOwner, begin));
+                                     const vctDynamicVectorRefOwner<typename _inputOwnerType::value_type> inputBlock(end - begin, BlockPointer(inputOwner, begin));
+                                     Run(outputBlock, inputBlock, inputScalar);
+                                 });
+                return;
+            }
+
             OutputPointerType outputPointer = outputOwner.Pointer();
             const OutputPointerType outputEnd = outputPointer + size;
 
@@ -256,6 +317,17 @@ class vctDynamicCompactLoopEngines {
 
             const size_type size = outputOwner.size();
 
+            // large containers, run the engine in parallel on blocks of elements
+            if (vctParallel::IsEnabled(size)) {
+                vctParallel::For(size, vctParallel::NumberOfBlocks(size, size),
+                                 [&](size_type begin, size_type end) {
+                                     vctDynamicVectorRefOwner<typename _outputOwnerType::value_type> outputBlock(end - begin, BlockPointer(outputOwner, begin));
+                                     const vctDynamicVectorRefOwner<typename _inputOwnerType::value_type> inputBlock(end - begin, BlockPointer(inputOwner, begin));
+                                     Run(outputBlock, inputScalar, inputBlock);
+                                 });
+                return;
+            }
+
             OutputPointerType outputPointer = outputOwner.Pointer();
             const OutputPointerType outputEnd = outputPointer + size;
 
@@ -295,6 +367,16 @@ class vctDynamicCompactLoopEngines {
 
             const size_type size = inputOutputOwner.size();
 
+            // large containers, run the engine in parallel on blocks of elements
+            if (vctParallel::IsEnabled(size)) {
+                vctParallel::For(size, vctParallel::NumberOfBlocks(size, size),
+                                 [&](size_type begin, size_type end) {
+                                     vctDynamicVectorRefOwner<typename _inputOutputOwnerType::value_type> inputOutputBlock(end - begin, BlockPointer(inputOutputOwner, begin));
+                                     Run(inputOutputBlock, inputScalar);
+                                 });
+                return;
+            }
+
             InputOutputPointerType inputOutputPointer = inputOutputOwner.Pointer();
             const InputOutputPointerType inputOutputEnd = inputOutputPointer + size;;
 
@@ -334,6 +416,17 @@ class vctDynamicCompactLoopEngines {
 
             OutputPointerType outputPointer = outputOwner.Pointer();
             const size_type size = outputOwner.size();
+
+            // large containers, run the engine in parallel on blocks of elements
+            if (vctParallel::IsEnabled(size)) {
+                vctParallel::For(size, vctParallel::NumberOfBlocks(size, size),
+                                 [&](size_type begin, size_type end) {
+                                     vctDynamicVectorRefOwner<typename _outputOwnerType::value_type> outputBlock(end - begin, BlockPointer(outputOwner, begin));
+                                     const vctDynamicVectorRefOwner<typename _inputOwnerType::value_type> inputBlock(end - begin, BlockPointer(inputOwner, begin));
+                                     Run(outputBlock, inputBlock);
+                                 });
+                return;
+            }
             const OutputPointerType outputEnd = outputPointer + size;
 
             InputPointerType inputPointer = inputOwner.Pointer();
@@ -372,6 +465,16 @@ class vctDynamicCompactLoopEngines {
 
             const size_type size = inputOutputOwner.size();
 
+            // large containers, run the engine in parallel on blocks of elements
+            if (vctParallel::IsEnabled(size)) {
+                vctParallel::For(size, vctParallel::NumberOfBlocks(size, size),
+                                 [&](size_type begin, size_type end) {
+                                     vctDynamicVectorRefOwner<typename _inputOutputOwnerType::value_type> inputOutputBlock(end - begin, BlockPointer(inputOutputOwner, begin));
+                                     Run(inputOutputBlock);
+                                 });
+                return;
+            }
+
             InputOutputPointerType inputOutputPointer = inputOutputOwner.Pointer();
             const InputOutputPointerType inputOutputEnd = inputOutputPointer + size;
 
@@ -410,6 +513,16 @@ class vctDynamicCompactLoopEngines {
             typedef typename InputOwnerType::size_type size_type;
 
             const size_type size = inputOwner.size();
+
+            // large containers, run the engine in parallel on blocks of elements
+            if (vctParallel::IsEnabled(size)) {
+                return vctParallel::Reduce<_incrementalOperationType>(size, vctParallel::NumberOfBlocks(size, size),
+                                                                      [&](size_type begin, size_type end) {
+                                                                          const vctDynamicVectorRefOwner<typename _inputOwnerType::value_type> inputBlock(end - begin, BlockPointer(inputOwner, begin));
+                                                                          return Run(inputBlock);
+                                                                      });
+            }
+
             OutputType incrementalResult = _incrementalOperationType::NeutralElement();
 
             InputPointerType inputPointer = inputOwner.Pointer();
@@ -459,6 +572,16 @@ class vctDynamicCompactLoopEngines {
 
             const size_type size = input1Owner.size();
 
+            // large containers, run the engine in parallel on blocks of elements
+            if (vctParallel::IsEnabled(size)) {
+                return vctParallel::Reduce<_incrementalOperationType>(size, vctParallel::NumberOfBlocks(size, size),
+                                                                      [&](size_type begin, size_type end) {
+                                                                          const vctDynamicVectorRefOwner<typename _input1OwnerType::value_type> input1Block(end - begin, BlockPointer(input1Owner, begin));
+                                                                          const vctDynamicVectorRefOwner<typename _input2OwnerType::value_type> input2Block(end - begin, BlockPointer(input2Owner, begin));
+                                                                          return Run(input1Block, input2Block);
+                                                                      });
+            }
+
             OutputType incrementalResult = _incrementalOperationType::NeutralElement();
 
             Input1PointerType input1Pointer = input1Owner.Pointer();
@@ -509,6 +632,17 @@ class vctDynamicCompactLoopEngines {
 
             const size_type size = ioOwner.size();
 
+            // large containers, run the engine in parallel on blocks of elements
+            if (vctParallel::IsEnabled(size)) {
+                vctParallel::For(size, vctParallel::NumberOfBlocks(size, size),
+                                 [&](size_type begin, size_type end) {
+                                     vctDynamicVectorRefOwner<typename _ioOwnerType::value_type> ioBlock(end - begin, BlockPointer(ioOwner, begin));
+                                     const vctDynamicVectorRefOwner<typename _inputOwnerType::value_type> inputBlock(end - begin, BlockPointer(inputOwner, begin));
+                                     Run(ioBlock, inputScalar, inputBlock);
+                                 });
+                return;
+            }
+
             IoPointerType ioPointer = ioOwner.Pointer();
             const IoPointerType ioEnd = ioPointer + size;
 
@@ -561,6 +695,18 @@ class vctDynamicCompactLoopEngines {
 
             const size_type size = ioOwner.size();
 
+            // large containers, run the engine in parallel on blocks of elements
+            if (vctParallel::IsEnabled(size)) {
+                vctParallel::For(size, vctParallel::NumberOfBlocks(size, size),
+                                 [&](size_type begin, size_type end) {
+                                     vctDynamicVectorRefOwner<typename _ioOwnerType::value_type> ioBlock(end - begin, BlockPointer(ioOwner, begin));
+                                     const vctDynamicVectorRefOwner<typename _input1OwnerType::value_type> input1Block(end - begin, BlockPointer(input1Owner, begin));
+                                     const vctDynamicVectorRefOwner<typename _input2OwnerType::value_type> input2Block(end - begin, BlockPointer(input2Owner, begin));
+                                     Run(ioBlock, input1Block, input2Block);
+                                 });
+                return;
+            }
+
             IoPointerType ioPointer = ioOwner.Pointer();
             const IoPointerType ioEnd = ioPointer + size;
 
@@ -608,6 +754,16 @@ class vctDynamicCompactLoopEngines {
             typedef typename InputOwnerType::size_type size_type;
 
             const size_type size = inputOwner.size();
+
+            // large containers, run the engine in parallel on blocks of elements
+            if (vctParallel::IsEnabled(size)) {
+                return vctParallel::Reduce<_incrementalOperationType>(size, vctParallel::NumberOfBlocks(size, size),
+                                                                      [&](size_type begin, size_type end) {
+                                                                          const vctDynamicVectorRefOwner<typename _inputOwnerType::value_type> inputBlock(end - begin, BlockPointer(inputOwner, begin));
+                                                                          return Run(inputBlock, inputScalar);
+                                                                      });
+            }
+
             OutputType incrementalResult = _incrementalOperationType::NeutralElement();
 
             InputPointerType inputPointer = inputOwner.Pointer();
@@ -6,7 +6,7 @@
   Author(s):	Ofri Sadowsky, Anton Deguet
   Created on: 2004-07-01
 
-  (C) Copyright 2004-2007 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -244,6 +244,14 @@ public:
     }
 
 
+    /*! Constructor from a lazy expression (see
+      vctDynamicMatrixExpression).  The storage order is row major. */
+    template <class __expressionType>
+    explicit vctDynamicMatrix(const vctDynamicMatrixExpression<__expressionType, value_type> & expression) {
+        this->SetSize(expression.rows(), expression.cols(), VCT_ROW_MAJOR);
+        this->Assign(expression);
+    }
+
     /*!  Assignment from a dynamic matrix to a matrix.  The
       operation discards the old memory allocated for this matrix, and
       allocates new memory the size of the input matrix.  Then the
@@ -295,6 +303,19 @@ public:
     */
     ThisType & operator = (const vctReturnDynamicMatrix<value_type> & otherMatrix);
 
+    /*! Assignment from a lazy expression (see
+      vctDynamicMatrixExpression).  This matrix is resized only if
+      the size of the expression is different, the storage order is
+      preserved.  The expression is then evaluated in a single loop,
+      without any temporary matrix.
+    */
+    template <class __expressionType>
+    ThisType & operator = (const vctDynamicMatrixExpression<__expressionType, value_type> & expression) {
+        this->SetSize(expression.rows(), expression.cols());
+        this->Assign(expression);
+        return *this;
+    }
+
     /*! Assignement of a scalar to all elements.  See also SetAll. */
     inline ThisType & operator = (const value_type & value) {
         this->SetAll(value);
@@ -351,8 +372,7 @@ public:
         vctDynamicConstMatrixRef<value_type> myDataMinSpaceRef(*this, corner, minSizes);
         vctDynamicMatrixRef<value_type> newDataMinSpaceRef(newData, corner, minSizes);
         newDataMinSpaceRef.Assign(myDataMinSpaceRef);
-        this->Matrix.Disown();
-        this->Matrix.Own(newSizes, isRowMajor, newData.Matrix.Release());
+        this->Matrix.Acquire(newData.Matrix);
     }
     //@}
 
@@ -426,11 +446,7 @@ public:
     explicit vctReturnDynamicMatrix(const BaseType & other)
     {
         BaseType & nonConstOther = const_cast<BaseType &>(other);
-        // if we don't save it in a variable, it will be destroyed in the Release operation
-        const size_type rows = other.rows();
-        const size_type cols = other.cols();
-        const bool storageOrder = other.StorageOrder();
-        this->Matrix.Own(rows, cols, storageOrder, nonConstOther.Matrix.Release());
+        this->Matrix.Acquire(nonConstOther.Matrix);
     }
 };
 
@@ -440,11 +456,7 @@ template <class _elementType>
 vctDynamicMatrix<_elementType>::vctDynamicMatrix(const vctReturnDynamicMatrix<_elementType> & other) {
     vctReturnDynamicMatrix<_elementType> & nonConstOther =
         const_cast< vctReturnDynamicMatrix<_elementType> & >(other);
-    // if we don't save it in a variable, it will be destroyed in the Release operation
-    const size_type rows = other.rows();
-    const size_type cols = other.cols();
-    const bool storageOrder = other.StorageOrder();
-    this->Matrix.Own(rows, cols, storageOrder, nonConstOther.Matrix.Release());
+    this->Matrix.Acquire(nonConstOther.Matrix);
 }
 
 
@@ -454,12 +466,7 @@ vctDynamicMatrix<_elementType> &
 vctDynamicMatrix<_elementType>::operator = (const vctReturnDynamicMatrix<_elementType> & other) {
     vctReturnDynamicMatrix<_elementType> & nonConstOther =
         const_cast< vctReturnDynamicMatrix<_elementType> & >(other);
-    // if we don't save it in a variable, it will be destroyed in the Release operation
-    const size_type rows = other.rows();
-    const size_type cols = other.cols();
-    const bool storageOrder = other.StorageOrder();
-    this->Matrix.Disown();
-    this->Matrix.Own(rows, cols, storageOrder, nonConstOther.Matrix.Release());
+    this->Matrix.Acquire(nonConstOther.Matrix);
     return *this;
 }
 
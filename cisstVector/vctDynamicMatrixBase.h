@@ -5,7 +5,7 @@
   Author(s):  Ofri Sadowsky, Anton Deguet
   Created on: 2004-07-01
 
-  (C) Copyright 2004-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -519,6 +519,29 @@ public:
     }
     //@}
 
+    /*!
+      \name Assignment from a lazy expression (see
+      vctDynamicMatrixExpression).  The expression is evaluated in a
+      single loop, without any temporary matrix.  The sizes must
+      match.
+
+      \param expression The expression to evaluate.
+    */
+    //@{
+    template <class __expressionType>
+    inline ThisType & Assign(const vctDynamicMatrixExpression<__expressionType, value_type> & expression) {
+        vctDynamicMatrixLoopEngines::
+            MioEi<typename vctStoreBackBinaryOperations<value_type>::SecondOperand>::
+            Run(*this, expression.Expression());
+        return *this;
+    }
+
+    template <class __expressionType>
+    inline ThisType & operator = (const vctDynamicMatrixExpression<__expressionType, value_type> & expression) {
+        return this->Assign(expression);
+    }
+    //@}
+
 
     /*!
       \name Assignment operation between matrices of different types.
@@ -929,6 +952,25 @@ public:
     inline ThisType & operator -= (const vctDynamicConstMatrixBase<__matrixOwnerType, _elementType> & otherMatrix) {
         return this->Subtract(otherMatrix);
     }
+
+    /*! Add or subtract the result of a lazy expression (see
+      vctDynamicMatrixExpression), evaluated in a single loop. */
+    template <class __expressionType>
+    inline ThisType & operator += (const vctDynamicMatrixExpression<__expressionType, _elementType> & expression) {
+        vctDynamicMatrixLoopEngines::
+            MioEi<typename vctStoreBackBinaryOperations<value_type>::Addition>::
+            Run(*this, expression.Expression());
+        return *this;
+    }
+
+    /* documented above */
+    template <class __expressionType>
+    inline ThisType & operator -= (const vctDynamicMatrixExpression<__expressionType, _elementType> & expression) {
+        vctDynamicMatrixLoopEngines::
+            MioEi<typename vctStoreBackBinaryOperations<value_type>::Subtraction>::
+            Run(*this, expression.Expression());
+        return *this;
+    }
     //@}
 
 
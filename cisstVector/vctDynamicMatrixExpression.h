@@ -0,0 +1,408 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#pragma once
+#ifndef _vctDynamicMatrixExpression_h
+#define _vctDynamicMatrixExpression_h
+
+/*!
+  \file
+  \brief Declaration of vctDynamicMatrixExpression and lazy operators
+*/
+
+#include <cisstVector/vctDynamicMatrix.h>
+#include <cisstVector/vctUnaryOperations.h>
+#include <cisstVector/vctBinaryOperations.h>
+
+/*!
+  \brief Base class for lazy expressions on dynamic matrices.
+
+  This is the matrix equivalent of vctDynamicVectorExpression.  Lazy
+  expressions are built using vctLazy on the operands and are
+  evaluated elementwise in a single loop when assigned to a matrix
+  (see vctDynamicMatrixLoopEngines::MioEi):
+  \code
+  vctDoubleMat a(3, 4), b(3, 4), c(3, 4);
+  a = vctLazy(b) * 0.5 + c;
+  a -= vctLazy(c) / s;
+  \endcode
+  When the matrix assigned to and all the matrices used in the
+  expression are compact with the same storage order, the expression
+  is evaluated in a single linear loop.  Otherwise, the elements are
+  computed row by row.
+
+  \note As for vector expressions, the matrices used must outlive the
+  expression so don't store an expression (e.g. using
+  <code>auto</code>).
+
+  \param _expressionType The actual type of the expression (CRTP).
+  \param _elementType The type of the elements.
+
+  \sa vctLazy
+*/
+template <class _expressionType, class _elementType>
+class vctDynamicMatrixExpression
+{
+public:
+    /* define most types from vctContainerTraits */
+    VCT_CONTAINER_TRAITS_TYPEDEFS(_elementType);
+    /* define types for matrices */
+    VCT_NARRAY_TRAITS_TYPEDEFS(2);
+    typedef _expressionType ExpressionType;
+
+    /*! Actual expression */
+    inline const ExpressionType & Expression(void) const {
+        return *static_cast<const ExpressionType *>(this);
+    }
+
+    /*! Number of rows of the result */
+    inline size_type rows(void) const {
+        return Expression().rows();
+    }
+
+    /*! Number of columns of the result */
+    inline size_type cols(void) const {
+        return Expression().cols();
+    }
+
+    /*! Sizes of the result */
+    inline nsize_type sizes(void) const {
+        return nsize_type(this->rows(), this->cols());
+    }
+
+    /*! True if all the matrices used in the expression are compact
+      and have the given strides, i.e. the elements can be accessed
+      using a single index (see CompactElement). */
+    inline bool IsCompact(const nstride_type & strides) const {
+        return Expression().IsCompact(strides);
+    }
+
+    /*! Compute one element of the result */
+    inline value_type Element(index_type rowIndex, index_type colIndex) const {
+        return Expression().Element(rowIndex, colIndex);
+    }
+
+    /*! Compute one element of the result using a single index,
+      assuming all matrices are compact with the same strides */
+    inline value_type CompactElement(index_type index) const {
+        return Expression().CompactElement(index);
+    }
+
+    /*! Evaluate the expression in a new matrix (row major). */
+    inline vctReturnDynamicMatrix<value_type> Eval(void) const {
+        vctDynamicMatrix<value_type> result(this->rows(), this->cols());
+        result.Assign(*this);
+        return vctReturnDynamicMatrix<value_type>(result);
+    }
+
+    /*! Conversion to the type returned by the regular operators. */
+    inline operator vctReturnDynamicMatrix<value_type>(void) const {
+        return this->Eval();
+    }
+};
+
+
+/*! Leaf of a lazy expression, refers to the elements of a dynamic matrix. */
+template <class _elementType>
+class vctDynamicMatrixExpressionRef:
+    public vctDynamicMatrixExpression<vctDynamicMatrixExpressionRef<_elementType>, _elementType>
+{
+public:
+    VCT_CONTAINER_TRAITS_TYPEDEFS(_elementType);
+    VCT_NARRAY_TRAITS_TYPEDEFS(2);
+
+    template <class __matrixOwnerType>
+    inline explicit vctDynamicMatrixExpressionRef(const vctDynamicConstMatrixBase<__matrixOwnerType, _elementType> & matrix):
+        Data(matrix.Pointer()),
+        Rows(matrix.rows()),
+        Cols(matrix.cols()),
+        RowStride(matrix.row_stride()),
+        ColStride(matrix.col_stride()),
+        Compact(matrix.IsCompact())
+    {}
+
+    inline size_type rows(void) const {
+        return Rows;
+    }
+
+    inline size_type cols(void) const {
+        return Cols;
+    }
+
+    inline bool IsCompact(const nstride_type & strides) const {
+        return Compact && (RowStride == strides[0]) && (ColStride == strides[1]);
+    }
+
+    inline value_type Element(index_type rowIndex, index_type colIndex) const {
+        return Data[static_cast<stride_type>(rowIndex) * RowStride + static_cast<stride_type>(colIndex) * ColStride];
+    }
+
+    inline value_type CompactElement(index_type index) const {
+        return Data[index];
+    }
+
+protected:
+    const_pointer Data;
+    size_type Rows, Cols;
+    stride_type RowStride, ColStride;
+    bool Compact;
+};
+
+
+/*! Lazy expression of the form \f$op(e_1, e_2)\f$ */
+template <class _expression1Type, class _expression2Type, class _elementOperationType>
+class vctDynamicMatrixExpressionEiEi:
+    public vctDynamicMatrixExpression<vctDynamicMatrixExpressionEiEi<_expression1Type, _expression2Type, _elementOperationType>,
+                                      typename _expression1Type::value_type>
+{
+public:
+    VCT_CONTAINER_TRAITS_TYPEDEFS(typename _expression1Type::value_type);
+    VCT_NARRAY_TRAITS_TYPEDEFS(2);
+
+    inline vctDynamicMatrixExpressionEiEi(const _expression1Type & expression1, const _expression2Type & expression2):
+        Operand1(expression1),
+        Operand2(expression2)
+    {
+        if ((expression1.rows() != expression2.rows()) || (expression1.cols() != expression2.cols())) {
+            vctDynamicMatrixLoopEngines::ThrowSizeMismatchException(expression1.sizes(), expression2.sizes());
+        }
+    }
+
+    inline size_type rows(void) const {
+        return Operand1.rows();
+    }
+
+    inline size_type cols(void) const {
+        return Operand1.cols();
+    }
+
+    inline bool IsCompact(const nstride_type & strides) const {
+        return Operand1.IsCompact(strides) && Operand2.IsCompact(strides);
+    }
+
+    inline value_type Element(index_type rowIndex, index_type colIndex) const {
+        return _elementOperationType::Operate(Operand1.Element(rowIndex, colIndex), Operand2.Element(rowIndex, colIndex));
+    }
+
+    inline value_type CompactElement(index_type index) const {
+        return _elementOperationType::Operate(Operand1.CompactElement(index), Operand2.CompactElement(index));
+    }
+
+protected:
+    const _expression1Type Operand1;
+    const _expression2Type Operand2;
+};
+
+
+/*! Lazy expression of the form \f$op(e, s)\f$ */
+template <class _expressionType, class _elementOperationType>
+class vctDynamicMatrixExpressionEiSi:
+    public vctDynamicMatrixExpression<vctDynamicMatrixExpressionEiSi<_expressionType, _elementOperationType>,
+                                      typename _expressionType::value_type>
+{
+public:
+    VCT_CONTAINER_TRAITS_TYPEDEFS(typename _expressionType::value_type);
+    VCT_NARRAY_TRAITS_TYPEDEFS(2);
+
+    inline vctDynamicMatrixExpressionEiSi(const _expressionType & expression, const value_type & scalar):
+        Operand(expression),
+        Scalar(scalar)
+    {}
+
+    inline size_type rows(void) const {
+        return Operand.rows();
+    }
+
+    inline size_type cols(void) const {
+        return Operand.cols();
+    }
+
+    inline bool IsCompact(const nstride_type & strides) const {
+        return Operand.IsCompact(strides);
+    }
+
+    inline value_type Element(index_type rowIndex, index_type colIndex) const {
+        return _elementOperationType::Operate(Operand.Element(rowIndex, colIndex), Scalar);
+    }
+
+    inline value_type CompactElement(index_type index) const {
+        return _elementOperationType::Operate(Operand.CompactElement(index), Scalar);
+    }
+
+protected:
+    const _expressionType Operand;
+    const value_type Scalar;
+};
+
+
+/*! Lazy expression of the form \f$op(s, e)\f$ */
+template <class _expressionType, class _elementOperationType>
+class vctDynamicMatrixExpressionSiEi:
+    public vctDynamicMatrixExpression<vctDynamicMatrixExpressionSiEi<_expressionType, _elementOperationType>,
+                                      typename _expressionType::value_type>
+{
+public:
+    VCT_CONTAINER_TRAITS_TYPEDEFS(typename _expressionType::value_type);
+    VCT_NARRAY_TRAITS_TYPEDEFS(2);
+
+    inline vctDynamicMatrixExpressionSiEi(const value_type & scalar, const _expressionType & expression):
+        Scalar(scalar),
+        Operand(expression)
+    {}
+
+    inline size_type rows(void) const {
+        return Operand.rows();
+    }
+
+    inline size_type cols(void) const {
+        return Operand.cols();
+    }
+
+    inline bool IsCompact(const nstride_type & strides) const {
+        return Operand.IsCompact(strides);
+    }
+
+    inline value_type Element(index_type rowIndex, index_type colIndex) const {
+        return _elementOperationType::Operate(Scalar, Operand.Element(rowIndex, colIndex));
+    }
+
+    inline value_type CompactElement(index_type index) const {
+        return _elementOperationType::Operate(Scalar, Operand.CompactElement(index));
+    }
+
+protected:
+    const value_type Scalar;
+    const _expressionType Operand;
+};
+
+
+/*! Lazy expression of the form \f$op(e)\f$ */
+template <class _expressionType, class _elementOperationType>
+class vctDynamicMatrixExpressionEi:
+    public vctDynamicMatrixExpression<vctDynamicMatrixExpressionEi<_expressionType, _elementOperationType>,
+                                      typename _expressionType::value_type>
+{
+public:
+    VCT_CONTAINER_TRAITS_TYPEDEFS(typename _expressionType::value_type);
+    VCT_NARRAY_TRAITS_TYPEDEFS(2);
+
+    inline explicit vctDynamicMatrixExpressionEi(const _expressionType & expression):
+        Operand(expression)
+    {}
+
+    inline size_type rows(void) const {
+        return Operand.rows();
+    }
+
+    inline size_type cols(void) const {
+        return Operand.cols();
+    }
+
+    inline bool IsCompact(const nstride_type & strides) const {
+        return Operand.IsCompact(strides);
+    }
+
+    inline value_type Element(index_type rowIndex, index_type colIndex) const {
+        return _elementOperationType::Operate(Operand.Element(rowIndex, colIndex));
+    }
+
+    inline value_type CompactElement(index_type index) const {
+        return _elementOperationType::Operate(Operand.CompactElement(index));
+    }
+
+protected:
+    const _expressionType Operand;
+};
+
+
+/*! Start a lazy expression with a dynamic matrix (see
+  vctDynamicMatrixExpression). */
+template <class _matrixOwnerType, class _elementType>
+inline vctDynamicMatrixExpressionRef<_elementType>
+vctLazy(const vctDynamicConstMatrixBase<_matrixOwnerType, _elementType> & matrix) {
+    return vctDynamicMatrixExpressionRef<_elementType>(matrix);
+}
+
+
+// helper macros to define all the lazy operators between expressions and matrices
+#define VCT_DYNAMIC_MATRIX_EXPRESSION_EIEI(_operator, _operation) \
+template <class _expression1Type, class _expression2Type, class _elementType> \
+inline vctDynamicMatrixExpressionEiEi<_expression1Type, _expression2Type, \
+                                      typename vctBinaryOperations<_elementType>::_operation> \
+operator _operator (const vctDynamicMatrixExpression<_expression1Type, _elementType> & expression1, \
+                    const vctDynamicMatrixExpression<_expression2Type, _elementType> & expression2) { \
+    return vctDynamicMatrixExpressionEiEi<_expression1Type, _expression2Type, \
+        typename vctBinaryOperations<_elementType>::_operation>(expression1.Expression(), expression2.Expression()); \
+} \
+template <class _expressionType, class _matrixOwnerType, class _elementType> \
+inline vctDynamicMatrixExpressionEiEi<_expressionType, vctDynamicMatrixExpressionRef<_elementType>, \
+                                      typename vctBinaryOperations<_elementType>::_operation> \
+operator _operator (const vctDynamicMatrixExpression<_expressionType, _elementType> & expression, \
+                    const vctDynamicConstMatrixBase<_matrixOwnerType, _elementType> & matrix) { \
+    return vctDynamicMatrixExpressionEiEi<_expressionType, vctDynamicMatrixExpressionRef<_elementType>, \
+        typename vctBinaryOperations<_elementType>::_operation>(expression.Expression(), \
+                                                                vctDynamicMatrixExpressionRef<_elementType>(matrix)); \
+} \
+template <class _matrixOwnerType, class _expressionType, class _elementType> \
+inline vctDynamicMatrixExpressionEiEi<vctDynamicMatrixExpressionRef<_elementType>, _expressionType, \
+                                      typename vctBinaryOperations<_elementType>::_operation> \
+operator _operator (const vctDynamicConstMatrixBase<_matrixOwnerType, _elementType> & matrix, \
+                    const vctDynamicMatrixExpression<_expressionType, _elementType> & expression) { \
+    return vctDynamicMatrixExpressionEiEi<vctDynamicMatrixExpressionRef<_elementType>, _expressionType, \
+        typename vctBinaryOperations<_elementType>::_operation>(vctDynamicMatrixExpressionRef<_elementType>(matrix), \
+                                                                expression.Expression()); \
+}
+
+#define VCT_DYNAMIC_MATRIX_EXPRESSION_EISI(_operator, _operation) \
+template <class _expressionType, class _elementType> \
+inline vctDynamicMatrixExpressionEiSi<_expressionType, typename vctBinaryOperations<_elementType>::_operation> \
+operator _operator (const vctDynamicMatrixExpression<_expressionType, _elementType> & expression, \
+                    const _elementType & scalar) { \
+    return vctDynamicMatrixExpressionEiSi<_expressionType, \
+        typename vctBinaryOperations<_elementType>::_operation>(expression.Expression(), scalar); \
+} \
+template <class _expressionType, class _elementType> \
+inline vctDynamicMatrixExpressionSiEi<_expressionType, typename vctBinaryOperations<_elementType>::_operation> \
+operator _operator (const _elementType & scalar, \
+                    const vctDynamicMatrixExpression<_expressionType, _elementType> & expression) { \
+    return vctDynamicMatrixExpressionSiEi<_expressionType, \
+        typename vctBinaryOperations<_elementType>::_operation>(scalar, expression.Expression()); \
+}
+
+
+/*! \name Lazy elementwise operations (see vctDynamicMatrixExpression) */
+//@{
+VCT_DYNAMIC_MATRIX_EXPRESSION_EIEI(+, Addition)
+VCT_DYNAMIC_MATRIX_EXPRESSION_EIEI(-, Subtraction)
+VCT_DYNAMIC_MATRIX_EXPRESSION_EISI(+, Addition)
+VCT_DYNAMIC_MATRIX_EXPRESSION_EISI(-, Subtraction)
+VCT_DYNAMIC_MATRIX_EXPRESSION_EISI(*, Multiplication)
+VCT_DYNAMIC_MATRIX_EXPRESSION_EISI(/, Division)
+
+template <class _expressionType, class _elementType>
+inline vctDynamicMatrixExpressionEi<_expressionType, typename vctUnaryOperations<_elementType>::Negation>
+operator - (const vctDynamicMatrixExpression<_expressionType, _elementType> & expression) {
+    return vctDynamicMatrixExpressionEi<_expressionType,
+        typename vctUnaryOperations<_elementType>::Negation>(expression.Expression());
+}
+//@}
+
+#undef VCT_DYNAMIC_MATRIX_EXPRESSION_EIEI
+#undef VCT_DYNAMIC_MATRIX_EXPRESSION_EISI
+
+#endif // _vctDynamicMatrixExpression_h
@@ -5,7 +5,7 @@
   Author(s):  Ofri Sadowsky, Anton Deguet
   Created on: 2003-12-16
 
-  (C) Copyright 2003-2019 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2003-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -28,11 +28,20 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstCommon/cmnPortability.h>
 #include <cisstCommon/cmnThrow.h>
 #include <cisstVector/vctDynamicCompactLoopEngines.h>
+#include <cisstVector/vctDynamicMatrixProduct.h>
+#include <cisstVector/vctDynamicMatrixRefOwner.h>
+#include <cisstVector/vctParallel.h>
 
 /*!
   \brief Container class for the dynamic matrix engines.
 
-  \sa MoMiMi MioMi MoMiSi MoSiMi MioSi MoMi Mio SoMi SoMiMi
+  When enabled with vctParallel::SetNumberOfThreads, the elementwise
+  operations, reductions and SelectRowsByIndex on large non-compact
+  matrices are split in blocks of rows computed in parallel (see
+  RowBlock).  Compact matrices are handled by
+  vctDynamicCompactLoopEngines.
+
+  \sa MoMiMi MioMi MioEi MoMiSi MoSiMi MioSi MoMi Mio SoMi SoMiMi
 */
 class vctDynamicMatrixLoopEngines {
 
@@ -57,6 +66,61 @@ public:
     }
 
 
+    /*! Block of rows of a matrix, used to run the engines in parallel
+      on large matrices (see vctParallel).  This class provides the
+      methods used by the engines and a block of a block has the same
+      type so the engines are not instantiated recursively. */
+    template <class _elementType>
+    class RowBlock {
+    public:
+        /* define most types from vctContainerTraits */
+        VCT_CONTAINER_TRAITS_TYPEDEFS(_elementType);
+        typedef vctDynamicMatrixRefOwner<_elementType> OwnerType;
+
+        /*! Reference rows [firstRow, endRow) of a matrix owner. */
+        template <class _ownerType>
+        inline RowBlock(const _ownerType & owner, const index_type firstRow, const index_type endRow) {
+            BlockOwner.SetRef(endRow - firstRow, owner.cols(), owner.row_stride(), owner.col_stride(),
+                              const_cast<pointer>(owner.Pointer()) + static_cast<stride_type>(firstRow) * owner.row_stride());
+        }
+
+        inline OwnerType & Owner(void) {
+            return BlockOwner;
+        }
+
+        inline const OwnerType & Owner(void) const {
+            return BlockOwner;
+        }
+
+        inline size_type rows(void) const {
+            return BlockOwner.rows();
+        }
+
+        inline size_type cols(void) const {
+            return BlockOwner.cols();
+        }
+
+        inline stride_type row_stride(void) const {
+            return BlockOwner.row_stride();
+        }
+
+        inline stride_type col_stride(void) const {
+            return BlockOwner.col_stride();
+        }
+
+        inline pointer Pointer(index_type rowIndex = 0, index_type colIndex = 0) {
+            return BlockOwner.Pointer(rowIndex, colIndex);
+        }
+
+        inline const_pointer Pointer(index_type rowIndex = 0, index_type colIndex = 0) const {
+            return BlockOwner.Pointer(rowIndex, colIndex);
+        }
+
+    protected:
+        OwnerType BlockOwner;
+    };
+
+
     /*! Perform elementwise operation between matrices of identical
       size and element type.  The operation semantics is
       \code
@@ -135,6 +199,17 @@ public:
                 && (outputOwner.strides() == input2Owner.strides())) {
                 vctDynamicCompactLoopEngines::CoCiCi<_elementOperationType>::Run(outputOwner, input1Owner, input2Owner);
             } else {
+                // large matrices, run the engine in parallel on blocks of rows
+                if (vctParallel::IsEnabled(rows * cols)) {
+                    vctParallel::For(rows, vctParallel::NumberOfBlocks(rows * cols, rows),
+                                     [&](size_type begin, size_type end) {
+                                         RowBlock<typename OutputOwnerType::value_type> outputBlock(outputOwner, begin, end);
+                                         const RowBlock<typename Input1OwnerType::value_type> input1Block(input1Owner, begin, end);
+                                         const RowBlock<typename Input2OwnerType::value_type> input2Block(input2Owner, begin, end);
+                                         Run(outputBlock, input1Block, input2Block);
+                                     });
+                    return;
+                }
                 const stride_type outputColStride = outputOwner.col_stride();
                 const stride_type outputRowStride = outputOwner.row_stride();
                 const stride_type outputStrideToNextRow = outputRowStride - cols * outputColStride;
@@ -203,6 +278,16 @@ public:
                 && (outputOwner.strides() == inputOwner.strides())) {
                 vctDynamicCompactLoopEngines::CoCi<_elementOperationType>::Run(outputOwner, inputOwner);
             } else {
+                // large matrices, run the engine in parallel on blocks of rows
+                if (vctParallel::IsEnabled(rows * cols)) {
+                    vctParallel::For(rows, vctParallel::NumberOfBlocks(rows * cols, rows),
+                                     [&](size_type begin, size_type end) {
+                                         RowBlock<typename OutputOwnerType::value_type> outputBlock(outputOwner, begin, end);
+                                         const RowBlock<typename InputOwnerType::value_type> inputBlock(inputOwner, begin, end);
+                                         Run(outputBlock, inputBlock);
+                                     });
+                    return;
+                }
                 // otherwise
                 const stride_type outputColStride = outputOwner.col_stride();
                 const stride_type outputRowStride = outputOwner.row_stride();
@@ -255,6 +340,16 @@ public:
                 const size_type rows = inputOutputOwner.rows();
                 const size_type cols = inputOutputOwner.cols();
 
+                // large matrices, run the engine in parallel on blocks of rows
+                if (vctParallel::IsEnabled(rows * cols)) {
+                    vctParallel::For(rows, vctParallel::NumberOfBlocks(rows * cols, rows),
+                                     [&](size_type begin, size_type end) {
+                                         RowBlock<typename InputOutputOwnerType::value_type> inputOutputBlock(inputOutputOwner, begin, end);
+                                         Run(inputOutputBlock);
+                                     });
+                    return;
+                }
+
                 const stride_type colStride = inputOutputOwner.col_stride();
                 const stride_type rowStride = inputOutputOwner.row_stride();
                 const stride_type strideToNextRow = rowStride - cols * colStride;
@@ -311,6 +406,16 @@ public:
                 && (inputOutputOwner.strides() == inputOwner.strides())) {
                 vctDynamicCompactLoopEngines::CioCi<_elementOperationType>::Run(inputOutputOwner, inputOwner);
             } else {
+                // large matrices, run the engine in parallel on blocks of rows
+                if (vctParallel::IsEnabled(rows * cols)) {
+                    vctParallel::For(rows, vctParallel::NumberOfBlocks(rows * cols, rows),
+                                     [&](size_type begin, size_type end) {
+                                         RowBlock<typename InputOutputOwnerType::value_type> inputOutputBlock(inputOutputOwner, begin, end);
+                                         const RowBlock<typename InputOwnerType::value_type> inputBlock(inputOwner, begin, end);
+                                         Run(inputOutputBlock, inputBlock);
+                                     });
+                    return;
+                }
                 const stride_type inputOutputColStride = inputOutputOwner.col_stride();
                 const stride_type inputOutputRowStride = inputOutputOwner.row_stride();
                 const stride_type inputOutputStrideToNextRow = inputOutputRowStride - cols * inputOutputColStride;
@@ -340,6 +445,62 @@ public:
     };  // MioMi class
 
 
+    /*! Implement operation of the form \f$m_{io} = op(m_{io}, e_i)\f$
+      where \f$e_i\f$ is a lazy expression (see
+      vctDynamicMatrixExpression) evaluated elementwise in a single
+      loop, without any temporary matrix.  For an assignment, use
+      vctStoreBackBinaryOperations::SecondOperand.  The input output
+      matrix can be used in the expression as long as it refers to the
+      same elements.
+    */
+    template<class _elementOperationType>
+    class MioEi {
+    public:
+        template<class _inputOutputMatrixType, class _inputExpressionType>
+        static inline void Run(_inputOutputMatrixType & inputOutputMatrix,
+                               const _inputExpressionType & inputExpression)
+        {
+            typedef _inputOutputMatrixType InputOutputMatrixType;
+            typedef typename InputOutputMatrixType::OwnerType InputOutputOwnerType;
+            typedef typename InputOutputOwnerType::size_type size_type;
+            typedef typename InputOutputOwnerType::stride_type stride_type;
+            typedef typename InputOutputOwnerType::index_type index_type;
+            typedef typename InputOutputOwnerType::pointer InputOutputPointerType;
+
+            // retrieve owner
+            InputOutputOwnerType & inputOutputOwner = inputOutputMatrix.Owner();
+
+            const size_type rows = inputOutputOwner.rows();
+            const size_type cols = inputOutputOwner.cols();
+
+            // check sizes
+            if ((rows != inputExpression.rows()) || (cols != inputExpression.cols())) {
+                ThrowSizeMismatchException(inputOutputOwner.sizes(), inputExpression.sizes());
+            }
+
+            InputOutputPointerType inputOutputPointer = inputOutputOwner.Pointer();
+
+            // if all compact and same strides
+            if (inputOutputOwner.IsCompact() && inputExpression.IsCompact(inputOutputOwner.strides())) {
+                const size_type size = rows * cols;
+                for (index_type index = 0; index < size; ++index) {
+                    _elementOperationType::Operate(inputOutputPointer[index], inputExpression.CompactElement(index));
+                }
+            } else {
+                const stride_type inputOutputColStride = inputOutputOwner.col_stride();
+                const stride_type inputOutputRowStride = inputOutputOwner.row_stride();
+                index_type rowIndex, colIndex;
+                for (rowIndex = 0; rowIndex < rows; ++rowIndex) {
+                    InputOutputPointerType inputOutputRowPointer = inputOutputPointer + rowIndex * inputOutputRowStride;
+                    for (colIndex = 0; colIndex < cols; ++colIndex, inputOutputRowPointer += inputOutputColStride) {
+                        _elementOperationType::Operate(*inputOutputRowPointer, inputExpression.Element(rowIndex, colIndex));
+                    }
+                }
+            }
+        }  // Run method
+    };  // MioEi class
+
+
     template<class _elementOperationType>
     class MoMiSi {
     public:
@@ -375,6 +536,16 @@ public:
                 && (outputOwner.strides() == inputOwner.strides())) {
                 vctDynamicCompactLoopEngines::CoCiSi<_elementOperationType>::Run(outputOwner, inputOwner, inputScalar);
             } else {
+                // large matrices, run the engine in parallel on blocks of rows
+                if (vctParallel::IsEnabled(rows * cols)) {
+                    vctParallel::For(rows, vctParallel::NumberOfBlocks(rows * cols, rows),
+                                     [&](size_type begin, size_type end) {
+                                         RowBlock<typename OutputOwnerType::value_type> outputBlock(outputOwner, begin, end);
+                                         const RowBlock<typename InputOwnerType::value_type> inputBlock(inputOwner, begin, end);
+                                         Run(outputBlock, inputBlock, inputScalar);
+                                     });
+                    return;
+                }
                 // otherwise
                 const stride_type outputColStride = outputOwner.col_stride();
                 const stride_type outputRowStride = outputOwner.row_stride();
@@ -440,6 +611,16 @@ public:
                 && (outputOwner.strides() == inputOwner.strides())) {
                 vctDynamicCompactLoopEngines::CoSiCi<_elementOperationType>::Run(outputOwner, inputScalar, inputOwner);
             } else {
+                // large matrices, run the engine in parallel on blocks of rows
+                if (vctParallel::IsEnabled(rows * cols)) {
+                    vctParallel::For(rows, vctParallel::NumberOfBlocks(rows * cols, rows),
+                                     [&](size_type begin, size_type end) {
+                                         RowBlock<typename OutputOwnerType::value_type> outputBlock(outputOwner, begin, end);
+                                         const RowBlock<typename InputOwnerType::value_type> inputBlock(inputOwner, begin, end);
+                                         Run(outputBlock, inputScalar, inputBlock);
+                                     });
+                    return;
+                }
                 // otherwise
                 const stride_type outputColStride = outputOwner.col_stride();
                 const stride_type outputRowStride = outputOwner.row_stride();
@@ -492,6 +673,16 @@ public:
                 const size_type rows = inputOutputOwner.rows();
                 const size_type cols = inputOutputOwner.cols();
 
+                // large matrices, run the engine in parallel on blocks of rows
+                if (vctParallel::IsEnabled(rows * cols)) {
+                    vctParallel::For(rows, vctParallel::NumberOfBlocks(rows * cols, rows),
+                                     [&](size_type begin, size_type end) {
+                                         RowBlock<typename InputOutputOwnerType::value_type> inputOutputBlock(inputOutputOwner, begin, end);
+                                         Run(inputOutputBlock, inputScalar);
+                                     });
+                    return;
+                }
+
                 const stride_type colStride = inputOutputOwner.col_stride();
                 const stride_type rowStride = inputOutputOwner.row_stride();
                 const stride_type strideToNextRow = rowStride - cols * colStride;
@@ -538,6 +729,15 @@ public:
                 const size_type rows = inputOwner.rows();
                 const size_type cols = inputOwner.cols();
 
+                // large matrices, run the engine in parallel on blocks of rows
+                if (vctParallel::IsEnabled(rows * cols)) {
+                    return vctParallel::Reduce<_incrementalOperationType>(rows, vctParallel::NumberOfBlocks(rows * cols, rows),
+                                                                          [&](size_type begin, size_type end) {
+                                                                              const RowBlock<typename InputOwnerType::value_type> inputBlock(inputOwner, begin, end);
+                                                                              return Run(inputBlock);
+                                                                          });
+                }
+
                 OutputType incrementalResult = _incrementalOperationType::NeutralElement();
 
                 const stride_type inputColStride = inputOwner.col_stride();
@@ -598,6 +798,15 @@ public:
                 && (input1Owner.strides() == input2Owner.strides())) {
                 return vctDynamicCompactLoopEngines::SoCiCi<_incrementalOperationType, _elementOperationType>::Run(input1Owner, input2Owner);
             } else {
+                // large matrices, run the engine in parallel on blocks of rows
+                if (vctParallel::IsEnabled(rows * cols)) {
+                    return vctParallel::Reduce<_incrementalOperationType>(rows, vctParallel::NumberOfBlocks(rows * cols, rows),
+                                                                          [&](size_type begin, size_type end) {
+                                                                              const RowBlock<typename Input1OwnerType::value_type> input1Block(input1Owner, begin, end);
+                                                                              const RowBlock<typename Input2OwnerType::value_type> input2Block(input2Owner, begin, end);
+                                                                              return Run(input1Block, input2Block);
+                                                                          });
+                }
                 // otherwise
                 OutputType incrementalResult = _incrementalOperationType::NeutralElement();
                 const stride_type input1ColStride = input1Owner.col_stride();
@@ -693,6 +902,16 @@ public:
                 && (ioOwner.strides() == inputOwner.strides())) {
                 vctDynamicCompactLoopEngines::CioSiCi<_ioElementOperationType, _scalarMatrixElementOperationType>::Run(ioOwner, inputScalar, inputOwner);
             } else {
+                // large matrices, run the engine in parallel on blocks of rows
+                if (vctParallel::IsEnabled(rows * cols)) {
+                    vctParallel::For(rows, vctParallel::NumberOfBlocks(rows * cols, rows),
+                                     [&](size_type begin, size_type end) {
+                                         RowBlock<typename IoOwnerType::value_type> ioBlock(ioOwner, begin, end);
+                                         const RowBlock<typename InputOwnerType::value_type> inputBlock(inputOwner, begin, end);
+                                         Run(ioBlock, inputScalar, inputBlock);
+                                     });
+                    return;
+                }
                 // otherwise
                 const stride_type ioColStride = ioOwner.col_stride();
                 const stride_type ioRowStride = ioOwner.row_stride();
@@ -796,6 +1015,17 @@ public:
                 && (ioOwner.strides() == input2Owner.strides())) {
                 vctDynamicCompactLoopEngines::CioCiCi<_ioElementOperationType, _matrixElementOperationType>::Run(ioOwner, input1Owner, input2Owner);
             } else {
+                // large matrices, run the engine in parallel on blocks of rows
+                if (vctParallel::IsEnabled(rows * cols)) {
+                    vctParallel::For(rows, vctParallel::NumberOfBlocks(rows * cols, rows),
+                                     [&](size_type begin, size_type end) {
+                                         RowBlock<typename IoOwnerType::value_type> ioBlock(ioOwner, begin, end);
+                                         const RowBlock<typename Input1OwnerType::value_type> input1Block(input1Owner, begin, end);
+                                         const RowBlock<typename Input2OwnerType::value_type> input2Block(input2Owner, begin, end);
+                                         Run(ioBlock, input1Block, input2Block);
+                                     });
+                    return;
+                }
                 // otherwise
                 const stride_type ioColStride = ioOwner.col_stride();
                 const stride_type ioRowStride = ioOwner.row_stride();
@@ -858,6 +1088,14 @@ public:
             if (inputOwner.IsCompact()) {
                 return vctDynamicCompactLoopEngines::SoCiSi<_incrementalOperationType, _elementOperationType>::Run(inputOwner, inputScalar);
             } else {
+                // large matrices, run the engine in parallel on blocks of rows
+                if (vctParallel::IsEnabled(rows * cols)) {
+                    return vctParallel::Reduce<_incrementalOperationType>(rows, vctParallel::NumberOfBlocks(rows * cols, rows),
+                                                                          [&](size_type begin, size_type end) {
+                                                                              const RowBlock<typename InputOwnerType::value_type> inputBlock(inputOwner, begin, end);
+                                                                              return Run(inputBlock, inputScalar);
+                                                                          });
+                }
                 // otherwise
                 OutputType incrementalResult = _incrementalOperationType::NeutralElement();
 
@@ -948,6 +1186,14 @@ public:
                 ThrowSharedPointersException();
             }
 
+            // large products of doubles or floats use the cache-blocked engine
+            if (vctDynamicMatrixProduct::Run(rows, cols, input1Cols,
+                                             input1Pointer, input1RowStride, input1ColStride,
+                                             input2Pointer, input2RowStride, input2ColStride,
+                                             outputPointer, outputRowStride, outputColStride)) {
+                return;
+            }
+
             for (; outputPointer != outputRowEnd;
                 outputPointer += outputStrideToNextRow,
                 input1Pointer += input1RowStride,
@@ -1062,6 +1308,20 @@ public:
                 cmnThrow(std::runtime_error(message.str()));
             }
 
+            // large matrices, copy the rows in parallel
+            if (vctParallel::IsEnabled(rows * cols)) {
+                typedef typename IndexVectorType::value_type IndexType;
+                vctParallel::For(rows, vctParallel::NumberOfBlocks(rows * cols, rows),
+                                 [&](size_type begin, size_type end) {
+                                     RowBlock<typename OutputMatrixType::value_type> outputBlock(outputMatrix, begin, end);
+                                     const vctDynamicVectorRefOwner<IndexType> indexBlock(end - begin,
+                                                                                          const_cast<IndexType *>(indexVector.Pointer(begin)),
+                                                                                          indexVector.stride());
+                                     Run(outputBlock, inputMatrix, indexBlock);
+                                 });
+                return;
+            }
+
             // otherwise
             const stride_type outputColStride = outputMatrix.col_stride();
             const stride_type outputRowStride = outputMatrix.row_stride();
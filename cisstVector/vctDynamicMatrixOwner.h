@@ -6,7 +6,7 @@
   Author(s):	Ofri Sadowsky, Anton Deguet
   Created on: 2004-07-01
 
-  (C) Copyright 2004-2007 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -30,10 +30,14 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstVector/vctForwardDeclarations.h>
 #include <cisstVector/vctVarStrideMatrixIterator.h>
 #include <cisstVector/vctDynamicMatrixRefOwner.h>
+#include <cisstVector/vctDynamicStorage.h>
+
+#include <algorithm>
 
 /*!
   This templated class owns a dynamically allocated array, but does
-  not provide any other operations */
+  not provide any other operations.  Small matrices are stored inline
+  and larger ones are aligned on the heap, see vctDynamicStorage. */
 template<class _elementType>
 class vctDynamicMatrixOwner
 {
@@ -45,6 +49,9 @@ public:
 
     typedef vctDynamicMatrixOwner<value_type> ThisType;
 
+    /*! The type used to allocate memory. */
+    typedef vctDynamicStorage<value_type> StorageType;
+
     /* iterators are container specific */
     typedef vctVarStrideMatrixConstIterator<value_type> const_iterator;
     typedef vctVarStrideMatrixConstIterator<value_type> const_reverse_iterator;
@@ -171,6 +178,9 @@ public:
 
       \note If the size is set to zero, the data pointer is set to
       null (0).
+
+      \note If the new size fits in the inline storage, no memory is
+      allocated on the heap.
      */
     //@{
     void  SetSize(size_type rows, size_type cols, bool rowMajor) {
@@ -181,16 +191,25 @@ public:
         if ((newSizes == this->sizes()) && (rowMajor == RowMajor)) return;
         Disown();
         const size_type totalSize = newSizes.ProductOfElements();
-        Own(newSizes, rowMajor, (totalSize == 0) ? 0 : new value_type[totalSize]);
+        Own(newSizes, rowMajor, Storage.Allocate(totalSize));
     }
     //@}
 
     /*! Release the currently owned data pointer from being owned.
       Reset this owner's data pointer and size to zero.  Return the
-      old data pointer without freeing memory.
+      old data pointer without freeing memory.  If the data was stored
+      inline, it is first copied on the heap.  The memory returned
+      must be released using StorageType::DeallocateHeap (or owned by
+      another owner), not <code>delete[]</code>.
      */
     pointer Release() {
         pointer oldData = Data;
+        if (Storage.IsInline(Data)) {
+            const size_type totalSize = this->size();
+            oldData = StorageType::AllocateHeap(totalSize);
+            std::copy(Data, Data + totalSize, oldData);
+            Storage.Deallocate(Data, totalSize);
+        }
         Data = 0;
         SizesMember.SetAll(0);
         RowMajor = VCT_DEFAULT_STORAGE;
@@ -202,7 +221,8 @@ public:
 
       \note This method returns a pointer to the previously owned
       memory block but doesn't tell if the old block was row or column
-      major nor the size of the block.
+      major nor the size of the block.  The data must have been
+      allocated using StorageType::AllocateHeap, e.g. by Release.
     */
     //@{
     pointer Own(size_type rows, size_type cols, bool rowMajor, pointer data) {
@@ -220,11 +240,30 @@ public:
     }
     //@}
 
+    /*! Take ownership of the data of another owner, which is left
+      empty.  The data pointer is transferred if it was allocated on
+      the heap, otherwise the elements are copied in the inline
+      storage of this owner.  The storage order is preserved.
+    */
+    void Acquire(ThisType & other) {
+        if (&other == this) return;
+        Disown();
+        const nsize_type sizes(other.sizes());
+        const bool rowMajor = other.IsRowMajor();
+        if (other.Storage.IsInline(other.Data)) {
+            SetSize(sizes, rowMajor);
+            std::copy(other.Data, other.Data + other.size(), Data);
+            other.Disown();
+        } else {
+            Own(sizes, rowMajor, other.Release());
+        }
+    }
+
     /*! Free the memory allocated for the data pointer.  Reset data
       pointer and size to zero.
     */
     void Disown(void) {
-        delete[] Data;
+        Storage.Deallocate(Data, this->size());
         SizesMember.SetAll(0);
         StridesMember.Element(0) = RowMajor ? 0 : 1;
         StridesMember.Element(1) = RowMajor ? 1 : 0;
@@ -247,11 +286,18 @@ public:
         return RowMajor;
     }
 
+    /*! Indicates if the data is stored inline, i.e. without any
+      memory allocated on the heap. */
+    inline bool IsInline(void) const {
+        return Storage.IsInline(Data);
+    }
+
 protected:
     nsize_type SizesMember;
     nstride_type StridesMember;
     bool RowMajor;
     value_type* Data;
+    StorageType Storage;
 
 private:
     // copy constructor private to prevent any call
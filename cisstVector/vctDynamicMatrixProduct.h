@@ -0,0 +1,119 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#pragma once
+#ifndef _vctDynamicMatrixProduct_h
+#define _vctDynamicMatrixProduct_h
+
+/*!
+  \file
+  \brief Declaration of vctDynamicMatrixProduct
+*/
+
+#include <cisstCommon/cmnPortability.h>
+#include <cisstVector/vctContainerTraits.h>
+
+// Always include last
+#include <cisstVector/vctExport.h>
+
+/*!
+  \brief Blocked matrix-matrix product for large dynamic matrices.
+
+  vctDynamicMatrixLoopEngines::Product computes each element of the
+  result as the dot product of a row and a column.  This is optimal
+  for small matrices but, as the size grows, most of the time is
+  spent waiting for memory.  This class implements a cache-blocked
+  product: blocks of both operands are copied ("packed") in small
+  contiguous buffers sized for the processor caches and the result is
+  computed by a register-blocked kernel, using AVX2 and FMA
+  instructions when supported by the processor.  The operands can
+  have any strides, including non-compact references and transposed
+  matrices.
+
+  When cisstVector is compiled with CISST_VCT_HAS_BLAS, the product
+  can also be delegated to the external BLAS (e.g. OpenBLAS)
+  function <code>?gemm</code>, provided that each matrix has a unit
+  stride in one direction.
+
+  Products of matrices of doubles or floats are automatically computed
+  with this class by vctDynamicMatrixBase::ProductOf (hence
+  <code>operator *</code>) when the number of multiply-add operations
+  (rows * cols * common size) is greater than or equal to
+  GetThreshold.  Products of other element types always use the
+  loop engine.
+*/
+class CISST_EXPORT vctDynamicMatrixProduct
+{
+public:
+    typedef vct::size_type size_type;
+    typedef vct::stride_type stride_type;
+
+    /*! Kernels used to compute the product.  KERNEL_NONE disables
+      this class so all products are computed by the loop engine. */
+    typedef enum {KERNEL_NONE, KERNEL_SCALAR, KERNEL_AVX2, KERNEL_BLAS} KernelType;
+
+    /*! Indicates if a given kernel can be used, i.e. has been
+      compiled and is supported by the processor. */
+    static bool IsKernelSupported(const KernelType kernel);
+
+    /*! Kernel currently used.  By default, the external BLAS if
+      available, otherwise AVX2 if supported by the processor. */
+    static KernelType GetKernel(void);
+
+    /*! Select the kernel used for all products.  Returns false and
+      leaves the current kernel unchanged if the kernel is not
+      supported. */
+    static bool SetKernel(const KernelType kernel);
+
+    /*! Minimum number of multiply-add operations (rows * cols *
+      common size) for which the product is computed by this class.
+      Smaller products are more efficiently computed by the loop
+      engine. */
+    static size_type GetThreshold(void);
+    static void SetThreshold(const size_type multiplyAdds);
+
+    /*! Compute output = input1 * input2 if the element type is
+      supported and the product is large enough.  Sizes are expected
+      to be correct and the output must not overlap the inputs.
+      Returns false if the product has not been computed, in which
+      case the caller should use the loop engine. */
+    static bool Run(const size_type rows, const size_type cols, const size_type common,
+                    const double * input1, const stride_type input1RowStride, const stride_type input1ColStride,
+                    const double * input2, const stride_type input2RowStride, const stride_type input2ColStride,
+                    double * output, const stride_type outputRowStride, const stride_type outputColStride);
+
+    static bool Run(const size_type rows, const size_type cols, const size_type common,
+                    const float * input1, const stride_type input1RowStride, const stride_type input1ColStride,
+                    const float * input2, const stride_type input2RowStride, const stride_type input2ColStride,
+                    float * output, const stride_type outputRowStride, const stride_type outputColStride);
+
+    /*! Other element types, or mixed element types, are not
+      supported. */
+    template <class _outputElementType, class _input1ElementType, class _input2ElementType>
+    inline static bool Run(const size_type CMN_UNUSED(rows), const size_type CMN_UNUSED(cols), const size_type CMN_UNUSED(common),
+                           const _input1ElementType * CMN_UNUSED(input1),
+                           const stride_type CMN_UNUSED(input1RowStride), const stride_type CMN_UNUSED(input1ColStride),
+                           const _input2ElementType * CMN_UNUSED(input2),
+                           const stride_type CMN_UNUSED(input2RowStride), const stride_type CMN_UNUSED(input2ColStride),
+                           _outputElementType * CMN_UNUSED(output),
+                           const stride_type CMN_UNUSED(outputRowStride), const stride_type CMN_UNUSED(outputColStride)) {
+        return false;
+    }
+};
+
+#endif // _vctDynamicMatrixProduct_h
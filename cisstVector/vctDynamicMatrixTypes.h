@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2003-09-12
 
-  (C) Copyright 2003-2014 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2003-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -27,6 +27,7 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include <cisstVector/vctDynamicMatrix.h>
+#include <cisstVector/vctDynamicMatrixExpression.h>
 
 #include <cisstVector/vctDataFunctionsDynamicMatrix.h>
 
@@ -0,0 +1,194 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#pragma once
+#ifndef _vctDynamicStorage_h
+#define _vctDynamicStorage_h
+
+/*!
+  \file
+  \brief Declaration of vctDynamicStorage
+*/
+
+#include <cisstCommon/cmnPortability.h>
+#include <cisstVector/vctContainerTraits.h>
+#include <cisstVector/vctConfig.h>
+
+#include <new>
+#include <cstdlib>
+#include <type_traits>
+
+#if (CISST_OS == CISST_WINDOWS)
+#include <malloc.h>
+#endif
+
+/*!
+  \brief Memory management for vctDynamicVectorOwner and
+  vctDynamicMatrixOwner.
+
+  Small containers (e.g. the joint vectors used for most robots) are
+  stored in a buffer embedded in the owner so they never use the heap.
+  The size of this buffer is CISST_VCT_DYNAMIC_INLINE_BYTES (CMake
+  option, 64 bytes by default i.e. 8 doubles), set it to 0 to disable
+  the inline storage.
+
+  Larger containers are allocated on the heap, aligned on
+  CISST_VCT_DYNAMIC_ALIGNMENT bytes (CMake option, 64 by default) so
+  loops can use aligned SIMD loads and stores.  Memory allocated on
+  the heap must be released using DeallocateHeap, not
+  <code>delete[]</code>.
+*/
+template <class _elementType>
+class vctDynamicStorage
+{
+public:
+    /* define most types from vctContainerTraits */
+    VCT_CONTAINER_TRAITS_TYPEDEFS(_elementType);
+
+    typedef vctDynamicStorage<_elementType> ThisType;
+
+    enum {INLINE_BYTES = CISST_VCT_DYNAMIC_INLINE_BYTES,
+          INLINE_CAPACITY = CISST_VCT_DYNAMIC_INLINE_BYTES / sizeof(_elementType),
+          HEAP_ALIGNMENT = CISST_VCT_DYNAMIC_ALIGNMENT};
+
+    vctDynamicStorage(void) {}
+
+    /*! Indicates if a data pointer refers to the inline buffer. */
+    inline bool IsInline(const_pointer data) const {
+        return (INLINE_CAPACITY != 0) && (data == InlinePointer());
+    }
+
+    /*! Allocate and default construct the elements, using the inline
+      buffer if the size allows it.  Returns a null pointer for a size
+      of zero. */
+    pointer Allocate(size_type size) {
+        if (size == 0) {
+            return 0;
+        }
+        if (size <= static_cast<size_type>(INLINE_CAPACITY)) {
+            pointer data = InlinePointer();
+            Construct(data, size);
+            return data;
+        }
+        return AllocateHeap(size);
+    }
+
+    /*! Destruct the elements and free the memory if it was allocated
+      on the heap. */
+    void Deallocate(pointer data, size_type size) {
+        if (data == 0) {
+            return;
+        }
+        if (IsInline(data)) {
+            Destruct(data, size);
+        } else {
+            DeallocateHeap(data, size);
+        }
+    }
+
+    /*! Allocate and default construct the elements on the heap,
+      aligned on HEAP_ALIGNMENT bytes. */
+    static pointer AllocateHeap(size_type size) {
+        if (size == 0) {
+            return 0;
+        }
+        pointer data = static_cast<pointer>(AllocateAligned(size * sizeof(value_type)));
+        try {
+            Construct(data, size);
+        } catch (...) {
+            FreeAligned(data);
+            throw;
+        }
+        return data;
+    }
+
+    /*! Destruct the elements and free memory allocated with
+      AllocateHeap. */
+    static void DeallocateHeap(pointer data, size_type size) {
+        if (data == 0) {
+            return;
+        }
+        Destruct(data, size);
+        FreeAligned(data);
+    }
+
+protected:
+    /*! Default construct the elements, for built-in types this doesn't
+      initialize the memory, as <code>new[]</code>. */
+    static void Construct(pointer data, size_type size) {
+        size_type index = 0;
+        try {
+            for (; index < size; ++index) {
+                new (data + index) value_type;
+            }
+        } catch (...) {
+            Destruct(data, index);
+            throw;
+        }
+    }
+
+    static void Destruct(pointer data, size_type size) {
+        for (size_type index = 0; index < size; ++index) {
+            data[index].~value_type();
+        }
+    }
+
+    static void * AllocateAligned(size_type bytes) {
+        void * memory = 0;
+#if (CISST_OS == CISST_WINDOWS)
+        memory = _aligned_malloc(bytes, HEAP_ALIGNMENT);
+#else
+        if (posix_memalign(&memory, HEAP_ALIGNMENT, bytes) != 0) {
+            memory = 0;
+        }
+#endif
+        if (memory == 0) {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+
+    static void FreeAligned(void * memory) {
+#if (CISST_OS == CISST_WINDOWS)
+        _aligned_free(memory);
+#else
+        free(memory);
+#endif
+    }
+
+    inline pointer InlinePointer(void) {
+        return reinterpret_cast<pointer>(&InlineBuffer);
+    }
+
+    inline const_pointer InlinePointer(void) const {
+        return reinterpret_cast<const_pointer>(&InlineBuffer);
+    }
+
+    /*! Inline buffer, at least one byte to avoid an empty array.  The
+      alignment is limited to 16 bytes so the owners don't require
+      over-aligned allocations. */
+    typename std::aligned_storage<(INLINE_BYTES > 0) ? INLINE_BYTES : 1,
+                                  (alignof(value_type) > 16) ? alignof(value_type) : 16>::type InlineBuffer;
+
+private:
+    // copy constructor private to prevent any call
+    vctDynamicStorage(const ThisType & CMN_UNUSED(other)) {}
+};
+
+
+#endif // _vctDynamicStorage_h
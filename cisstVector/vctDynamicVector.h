@@ -5,7 +5,7 @@
   Author(s):  Ofri Sadowsky, Anton Deguet
   Created on: 2004-07-01
 
-  (C) Copyright 2004-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -234,6 +234,13 @@ public:
         this->Assign(fixedVector);
     }
 
+    /*! Constructor from a lazy expression (see vctDynamicVectorExpression) */
+    template <class __expressionType>
+    explicit vctDynamicVector(const vctDynamicVectorExpression<__expressionType, value_type> & expression) {
+        this->SetSize(expression.size());
+        this->Assign(expression);
+    }
+
     /*!  Assignment from a dynamic vector to a vector.  The
       operation discards the old memory allocated for this vector, and
       allocates new memory the size of the input vector.  Then the
@@ -273,6 +280,18 @@ public:
         return *this;
     }
 
+    /*! Assignment from a lazy expression (see
+      vctDynamicVectorExpression).  This vector is resized only if
+      the size of the expression is different, then the expression is
+      evaluated in a single loop, without any temporary vector.
+    */
+    template <class __expressionType>
+    ThisType & operator = (const vctDynamicVectorExpression<__expressionType, value_type> & expression) {
+        this->SetSize(expression.size());
+        this->Assign(expression);
+        return *this;
+    }
+
     // documented in base class
     template <class __vectorOwnerType, typename __elementType>
     inline ThisType & ForceAssign(const vctDynamicConstVectorBase<__vectorOwnerType, __elementType> & other) {
@@ -304,8 +323,7 @@ public:
         vctDynamicConstVectorRef<value_type> myDataMinSpaceRef(*this, corner, minSizes);
         vctDynamicVectorRef<value_type> newDataMinSpaceRef(newData, corner, minSizes);
         newDataMinSpaceRef.Assign(myDataMinSpaceRef);
-        this->Vector.Disown();
-        this->Vector.Own(size, newData.Vector.Release());
+        this->Vector.Acquire(newData.Vector);
     }
 
     /*! DESTRUCTIVE size change.  Change the size to the specified
@@ -398,9 +416,7 @@ public:
     typedef vctDynamicVector<_elementType> BaseType;
     explicit vctReturnDynamicVector(const BaseType & other) {
         BaseType & nonConstOther = const_cast<BaseType &>(other);
-        // if we don't save it in a variable, it will be destroyed in the Release operation
-        const vct::size_type size = other.size();
-        this->Vector.Own(size, nonConstOther.Vector.Release());
+        this->Vector.Acquire(nonConstOther.Vector);
     }
 };
 
@@ -410,9 +426,7 @@ template <class _elementType>
 vctDynamicVector<_elementType>::vctDynamicVector(const vctReturnDynamicVector<_elementType> & other) {
     vctReturnDynamicVector<_elementType> & nonConstOther =
         const_cast< vctReturnDynamicVector<_elementType> & >(other);
-    // if we don't save it in a variable, it will be destroyed in the Release operation
-    const size_type size = other.size();
-    this->Vector.Own(size, nonConstOther.Vector.Release());
+    this->Vector.Acquire(nonConstOther.Vector);
 }
 
 
@@ -422,10 +436,7 @@ vctDynamicVector<_elementType> &
 vctDynamicVector<_elementType>::operator = (const vctReturnDynamicVector<_elementType> & other) {
     vctReturnDynamicVector<_elementType> & nonConstOther =
         const_cast< vctReturnDynamicVector<_elementType> & >(other);
-    // if we don't save it in a variable, it will be destroyed in the Release operation
-    const vct::size_type size = other.size();
-    this->Vector.Disown();
-    this->Vector.Own(size, nonConstOther.Vector.Release());
+    this->Vector.Acquire(nonConstOther.Vector);
     return *this;
 }
 
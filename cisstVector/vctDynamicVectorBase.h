@@ -5,7 +5,7 @@
   Author(s):  Ofri Sadowsky, Anton Deguet
   Created on: 2004-07-01
 
-  (C) Copyright 2004-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -299,6 +299,29 @@ public:
     }
     //@}
 
+    /*!
+      \name Assignment from a lazy expression (see
+      vctDynamicVectorExpression).  The expression is evaluated in a
+      single loop, without any temporary vector.  The sizes must
+      match.
+
+      \param expression The expression to evaluate.
+    */
+    //@{
+    template <class __expressionType>
+    inline ThisType & Assign(const vctDynamicVectorExpression<__expressionType, value_type> & expression) {
+        vctDynamicVectorLoopEngines::
+            VioEi<typename vctStoreBackBinaryOperations<value_type>::SecondOperand>::
+            Run(*this, expression.Expression());
+        return *this;
+    }
+
+    template <class __expressionType>
+    inline ThisType & operator = (const vctDynamicVectorExpression<__expressionType, value_type> & expression) {
+        return this->Assign(expression);
+    }
+    //@}
+
 
     /*!  \name Forced assignment operation between vectors of
       different types.  This method will use SetSize on the
@@ -903,6 +926,25 @@ public:
     inline ThisType & operator -= (const vctDynamicConstVectorBase<__vectorOwnerType, _elementType> & otherVector) {
         return this->Subtract(otherVector);
     }
+
+    /*! Add or subtract the result of a lazy expression (see
+      vctDynamicVectorExpression), evaluated in a single loop. */
+    template <class __expressionType>
+    inline ThisType & operator += (const vctDynamicVectorExpression<__expressionType, _elementType> & expression) {
+        vctDynamicVectorLoopEngines::
+            VioEi<typename vctStoreBackBinaryOperations<value_type>::Addition>::
+            Run(*this, expression.Expression());
+        return *this;
+    }
+
+    /* documented above */
+    template <class __expressionType>
+    inline ThisType & operator -= (const vctDynamicVectorExpression<__expressionType, _elementType> & expression) {
+        vctDynamicVectorLoopEngines::
+            VioEi<typename vctStoreBackBinaryOperations<value_type>::Subtraction>::
+            Run(*this, expression.Expression());
+        return *this;
+    }
     //@}
 
 
@@ -0,0 +1,372 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#pragma once
+#ifndef _vctDynamicVectorExpression_h
+#define _vctDynamicVectorExpression_h
+
+/*!
+  \file
+  \brief Declaration of vctDynamicVectorExpression and lazy operators
+*/
+
+#include <cisstVector/vctDynamicVector.h>
+#include <cisstVector/vctUnaryOperations.h>
+#include <cisstVector/vctBinaryOperations.h>
+
+/*!
+  \brief Base class for lazy expressions on dynamic vectors.
+
+  The operators on dynamic vectors (see vctDynamicVector) are
+  evaluated immediately and return a vctReturnDynamicVector.  For an
+  expression with several operators, e.g. <code>a = b + c * s -
+  d</code>, a new vector is allocated for each intermediate result.
+
+  Lazy expressions are built using vctLazy on the operands.  Once an
+  operand is lazy, the operators (+ and - between vectors, + - * /
+  with a scalar and the unary -) don't compute anything and return
+  a small object describing the expression.  The expression is
+  evaluated elementwise in a single loop when it is assigned to a
+  vector (see vctDynamicVectorLoopEngines::VioEi):
+  \code
+  vctDoubleVec a(3), b(3), c(3), d(3);
+  a = vctLazy(b) + vctLazy(c) * s - d;
+  a += vctLazy(c) * s;
+  \endcode
+  No memory is allocated if the vector assigned to already has the
+  correct size.  An expression can also be converted to a
+  vctReturnDynamicVector (see Eval) so it can be used wherever the
+  result of the regular operators is expected.
+
+  \note Expressions keep pointers on the data of the vectors used, so
+  they must be evaluated in the statement that creates them.  Don't
+  store an expression (e.g. using <code>auto</code>).
+
+  \param _expressionType The actual type of the expression (CRTP).
+  \param _elementType The type of the elements.
+
+  \sa vctLazy
+*/
+template <class _expressionType, class _elementType>
+class vctDynamicVectorExpression
+{
+public:
+    /* define most types from vctContainerTraits */
+    VCT_CONTAINER_TRAITS_TYPEDEFS(_elementType);
+    typedef _expressionType ExpressionType;
+
+    /*! Actual expression */
+    inline const ExpressionType & Expression(void) const {
+        return *static_cast<const ExpressionType *>(this);
+    }
+
+    /*! Number of elements of the result */
+    inline size_type size(void) const {
+        return Expression().size();
+    }
+
+    /*! True if all the vectors used in the expression are compact */
+    inline bool IsCompact(void) const {
+        return Expression().IsCompact();
+    }
+
+    /*! Compute one element of the result */
+    inline value_type Element(index_type index) const {
+        return Expression().Element(index);
+    }
+
+    /*! Compute one element of the result, assuming all vectors are
+      compact */
+    inline value_type CompactElement(index_type index) const {
+        return Expression().CompactElement(index);
+    }
+
+    /*! Evaluate the expression in a new vector. */
+    inline vctReturnDynamicVector<value_type> Eval(void) const {
+        vctDynamicVector<value_type> result(this->size());
+        result.Assign(*this);
+        return vctReturnDynamicVector<value_type>(result);
+    }
+
+    /*! Conversion to the type returned by the regular operators. */
+    inline operator vctReturnDynamicVector<value_type>(void) const {
+        return this->Eval();
+    }
+};
+
+
+/*! Leaf of a lazy expression, refers to the elements of a dynamic vector. */
+template <class _elementType>
+class vctDynamicVectorExpressionRef:
+    public vctDynamicVectorExpression<vctDynamicVectorExpressionRef<_elementType>, _elementType>
+{
+public:
+    VCT_CONTAINER_TRAITS_TYPEDEFS(_elementType);
+
+    template <class __vectorOwnerType>
+    inline explicit vctDynamicVectorExpressionRef(const vctDynamicConstVectorBase<__vectorOwnerType, _elementType> & vector):
+        Data(vector.Pointer()),
+        Size(vector.size()),
+        Stride(vector.stride())
+    {}
+
+    inline size_type size(void) const {
+        return Size;
+    }
+
+    inline bool IsCompact(void) const {
+        return (Stride == 1);
+    }
+
+    inline value_type Element(index_type index) const {
+        return Data[static_cast<stride_type>(index) * Stride];
+    }
+
+    inline value_type CompactElement(index_type index) const {
+        return Data[index];
+    }
+
+protected:
+    const_pointer Data;
+    size_type Size;
+    stride_type Stride;
+};
+
+
+/*! Lazy expression of the form \f$op(e_1, e_2)\f$ */
+template <class _expression1Type, class _expression2Type, class _elementOperationType>
+class vctDynamicVectorExpressionEiEi:
+    public vctDynamicVectorExpression<vctDynamicVectorExpressionEiEi<_expression1Type, _expression2Type, _elementOperationType>,
+                                      typename _expression1Type::value_type>
+{
+public:
+    VCT_CONTAINER_TRAITS_TYPEDEFS(typename _expression1Type::value_type);
+
+    inline vctDynamicVectorExpressionEiEi(const _expression1Type & expression1, const _expression2Type & expression2):
+        Operand1(expression1),
+        Operand2(expression2)
+    {
+        if (expression1.size() != expression2.size()) {
+            vctDynamicVectorLoopEngines::ThrowException(expression1.size(), expression2.size());
+        }
+    }
+
+    inline size_type size(void) const {
+        return Operand1.size();
+    }
+
+    inline bool IsCompact(void) const {
+        return Operand1.IsCompact() && Operand2.IsCompact();
+    }
+
+    inline value_type Element(index_type index) const {
+        return _elementOperationType::Operate(Operand1.Element(index), Operand2.Element(index));
+    }
+
+    inline value_type CompactElement(index_type index) const {
+        return _elementOperationType::Operate(Operand1.CompactElement(index), Operand2.CompactElement(index));
+    }
+
+protected:
+    const _expression1Type Operand1;
+    const _expression2Type Operand2;
+};
+
+
+/*! Lazy expression of the form \f$op(e, s)\f$ */
+template <class _expressionType, class _elementOperationType>
+class vctDynamicVectorExpressionEiSi:
+    public vctDynamicVectorExpression<vctDynamicVectorExpressionEiSi<_expressionType, _elementOperationType>,
+                                      typename _expressionType::value_type>
+{
+public:
+    VCT_CONTAINER_TRAITS_TYPEDEFS(typename _expressionType::value_type);
+
+    inline vctDynamicVectorExpressionEiSi(const _expressionType & expression, const value_type & scalar):
+        Operand(expression),
+        Scalar(scalar)
+    {}
+
+    inline size_type size(void) const {
+        return Operand.size();
+    }
+
+    inline bool IsCompact(void) const {
+        return Operand.IsCompact();
+    }
+
+    inline value_type Element(index_type index) const {
+        return _elementOperationType::Operate(Operand.Element(index), Scalar);
+    }
+
+    inline value_type CompactElement(index_type index) const {
+        return _elementOperationType::Operate(Operand.CompactElement(index), Scalar);
+    }
+
+protected:
+    const _expressionType Operand;
+    const value_type Scalar;
+};
+
+
+/*! Lazy expression of the form \f$op(s, e)\f$ */
+template <class _expressionType, class _elementOperationType>
+class vctDynamicVectorExpressionSiEi:
+    public vctDynamicVectorExpression<vctDynamicVectorExpressionSiEi<_expressionType, _elementOperationType>,
+                                      typename _expressionType::value_type>
+{
+public:
+    VCT_CONTAINER_TRAITS_TYPEDEFS(typename _expressionType::value_type);
+
+    inline vctDynamicVectorExpressionSiEi(const value_type & scalar, const _expressionType & expression):
+        Scalar(scalar),
+        Operand(expression)
+    {}
+
+    inline size_type size(void) const {
+        return Operand.size();
+    }
+
+    inline bool IsCompact(void) const {
+        return Operand.IsCompact();
+    }
+
+    inline value_type Element(index_type index) const {
+        return _elementOperationType::Operate(Scalar, Operand.Element(index));
+    }
+
+    inline value_type CompactElement(index_type index) const {
+        return _elementOperationType::Operate(Scalar, Operand.CompactElement(index));
+    }
+
+protected:
+    const value_type Scalar;
+    const _expressionType Operand;
+};
+
+
+/*! Lazy expression of the form \f$op(e)\f$ */
+template <class _expressionType, class _elementOperationType>
+class vctDynamicVectorExpressionEi:
+    public vctDynamicVectorExpression<vctDynamicVectorExpressionEi<_expressionType, _elementOperationType>,
+                                      typename _expressionType::value_type>
+{
+public:
+    VCT_CONTAINER_TRAITS_TYPEDEFS(typename _expressionType::value_type);
+
+    inline explicit vctDynamicVectorExpressionEi(const _expressionType & expression):
+        Operand(expression)
+    {}
+
+    inline size_type size(void) const {
+        return Operand.size();
+    }
+
+    inline bool IsCompact(void) const {
+        return Operand.IsCompact();
+    }
+
+    inline value_type Element(index_type index) const {
+        return _elementOperationType::Operate(Operand.Element(index));
+    }
+
+    inline value_type CompactElement(index_type index) const {
+        return _elementOperationType::Operate(Operand.CompactElement(index));
+    }
+
+protected:
+    const _expressionType Operand;
+};
+
+
+/*! Start a lazy expression with a dynamic vector (see
+  vctDynamicVectorExpression). */
+template <class _vectorOwnerType, class _elementType>
+inline vctDynamicVectorExpressionRef<_elementType>
+vctLazy(const vctDynamicConstVectorBase<_vectorOwnerType, _elementType> & vector) {
+    return vctDynamicVectorExpressionRef<_elementType>(vector);
+}
+
+
+// helper macros to define all the lazy operators between expressions and vectors
+#define VCT_DYNAMIC_VECTOR_EXPRESSION_EIEI(_operator, _operation) \
+template <class _expression1Type, class _expression2Type, class _elementType> \
+inline vctDynamicVectorExpressionEiEi<_expression1Type, _expression2Type, \
+                                      typename vctBinaryOperations<_elementType>::_operation> \
+operator _operator (const vctDynamicVectorExpression<_expression1Type, _elementType> & expression1, \
+                    const vctDynamicVectorExpression<_expression2Type, _elementType> & expression2) { \
+    return vctDynamicVectorExpressionEiEi<_expression1Type, _expression2Type, \
+        typename vctBinaryOperations<_elementType>::_operation>(expression1.Expression(), expression2.Expression()); \
+} \
+template <class _expressionType, class _vectorOwnerType, class _elementType> \
+inline vctDynamicVectorExpressionEiEi<_expressionType, vctDynamicVectorExpressionRef<_elementType>, \
+                                      typename vctBinaryOperations<_elementType>::_operation> \
+operator _operator (const vctDynamicVectorExpression<_expressionType, _elementType> & expression, \
+                    const vctDynamicConstVectorBase<_vectorOwnerType, _elementType> & vector) { \
+    return vctDynamicVectorExpressionEiEi<_expressionType, vctDynamicVectorExpressionRef<_elementType>, \
+        typename vctBinaryOperations<_elementType>::_operation>(expression.Expression(), \
+                                                                vctDynamicVectorExpressionRef<_elementType>(vector)); \
+} \
+template <class _vectorOwnerType, class _expressionType, class _elementType> \
+inline vctDynamicVectorExpressionEiEi<vctDynamicVectorExpressionRef<_elementType>, _expressionType, \
+                                      typename vctBinaryOperations<_elementType>::_operation> \
+operator _operator (const vctDynamicConstVectorBase<_vectorOwnerType, _elementType> & vector, \
+                    const vctDynamicVectorExpression<_expressionType, _elementType> & expression) { \
+    return vctDynamicVectorExpressionEiEi<vctDynamicVectorExpressionRef<_elementType>, _expressionType, \
+        typename vctBinaryOperations<_elementType>::_operation>(vctDynamicVectorExpressionRef<_elementType>(vector), \
+                                                                expression.Expression()); \
+}
+
+#define VCT_DYNAMIC_VECTOR_EXPRESSION_EISI(_operator, _operation) \
+template <class _expressionType, class _elementType> \
+inline vctDynamicVectorExpressionEiSi<_expressionType, typename vctBinaryOperations<_elementType>::_operation> \
+operator _operator (const vctDynamicVectorExpression<_expressionType, _elementType> & expression, \
+                    const _elementType & scalar) { \
+    return vctDynamicVectorExpressionEiSi<_expressionType, \
+        typename vctBinaryOperations<_elementType>::_operation>(expression.Expression(), scalar); \
+} \
+template <class _expressionType, class _elementType> \
+inline vctDynamicVectorExpressionSiEi<_expressionType, typename vctBinaryOperations<_elementType>::_operation> \
+operator _operator (const _elementType & scalar, \
+                    const vctDynamicVectorExpression<_expressionType, _elementType> & expression) { \
+    return vctDynamicVectorExpressionSiEi<_expressionType, \
+        typename vctBinaryOperations<_elementType>::_operation>(scalar, expression.Expression()); \
+}
+
+
+/*! \name Lazy elementwise operations (see vctDynamicVectorExpression) */
+//@{
+VCT_DYNAMIC_VECTOR_EXPRESSION_EIEI(+, Addition)
+VCT_DYNAMIC_VECTOR_EXPRESSION_EIEI(-, Subtraction)
+VCT_DYNAMIC_VECTOR_EXPRESSION_EISI(+, Addition)
+VCT_DYNAMIC_VECTOR_EXPRESSION_EISI(-, Subtraction)
+VCT_DYNAMIC_VECTOR_EXPRESSION_EISI(*, Multiplication)
+VCT_DYNAMIC_VECTOR_EXPRESSION_EISI(/, Division)
+
+template <class _expressionType, class _elementType>
+inline vctDynamicVectorExpressionEi<_expressionType, typename vctUnaryOperations<_elementType>::Negation>
+operator - (const vctDynamicVectorExpression<_expressionType, _elementType> & expression) {
+    return vctDynamicVectorExpressionEi<_expressionType,
+        typename vctUnaryOperations<_elementType>::Negation>(expression.Expression());
+}
+//@}
+
+#undef VCT_DYNAMIC_VECTOR_EXPRESSION_EIEI
+#undef VCT_DYNAMIC_VECTOR_EXPRESSION_EISI
+
+#endif // _vctDynamicVectorExpression_h
@@ -5,7 +5,7 @@
   Author(s):  Ofri Sadowsky, Anton Deguet
   Created on:  2004-07-01
 
-  (C) Copyright 2004-2022 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -59,7 +59,7 @@ http://www.cisst.org/cisst/license.txt.
   std::runtime_error is thrown.
 
   \sa vctFixedSizeVectorRecursiveEngines VoViVi VioVi VoViSi VoSiVi VioSi
-  VoVi Vio SoVi SoViVi SoVoSi
+  VoVi Vio VioEi SoVi SoViVi SoVoSi
 */
 class vctDynamicVectorLoopEngines {
 
@@ -233,6 +233,75 @@ class vctDynamicVectorLoopEngines {
     };
 
 
+    /*!  \brief Implement operation of the form \f$v_{io} = op(v_{io},
+      e_i)\f$ for dynamic vectors and lazy expressions
+
+      This class uses a single loop to evaluate a lazy expression (see
+      vctDynamicVectorExpression) and store the result in a vector:
+      \f[
+      v_{io} = \mathrm{op}(v_{io}, e_{i})
+      \f]
+
+      where \f$v_{io}\f$ is the input output vector, and \f$e_{i}\f$
+      is the expression, evaluated elementwise.  No temporary vector is
+      created for the intermediate results of the expression.  For an
+      assignment, use vctStoreBackBinaryOperations::SecondOperand.
+
+      The input output vector can be used in the expression as long as
+      it refers to the same elements, e.g. \f$v = v + 2 w\f$.
+
+      \param _elementOperationType The type of the binary operation.
+
+      \sa vctDynamicVectorLoopEngines
+    */
+    template<class _elementOperationType>
+    class VioEi {
+    public:
+        /*! Unroll the loop
+
+        \param inputOutputVector The input output vector.
+        \param inputExpression The expression.
+        */
+        template<class _inputOutputVectorType, class _inputExpressionType>
+        static void Run(_inputOutputVectorType & inputOutputVector,
+                        const _inputExpressionType & inputExpression) {
+            // check size
+            typedef _inputOutputVectorType InputOutputVectorType;
+            typedef typename InputOutputVectorType::OwnerType InputOutputOwnerType;
+            typedef typename InputOutputOwnerType::pointer InputOutputPointerType;
+            typedef typename InputOutputOwnerType::size_type size_type;
+            typedef typename InputOutputOwnerType::stride_type stride_type;
+            typedef typename InputOutputOwnerType::index_type index_type;
+
+            // retrieve owner
+            InputOutputOwnerType & inputOutputOwner = inputOutputVector.Owner();
+
+            const size_type size = inputOutputOwner.size();
+            if (size != inputExpression.size()) {
+                ThrowException(size, inputExpression.size());
+            }
+
+            const stride_type inputOutputStride = inputOutputOwner.stride();
+            InputOutputPointerType inputOutputPointer = inputOutputOwner.Pointer();
+            index_type index;
+
+            if ((inputOutputStride == 1) && inputExpression.IsCompact()) {
+                for (index = 0; index < size; ++index) {
+                    _elementOperationType::Operate(inputOutputPointer[index], inputExpression.CompactElement(index));
+                }
+            } else {
+                // otherwise
+                for (index = 0;
+                     index < size;
+                     ++index,
+                         inputOutputPointer += inputOutputStride) {
+                    _elementOperationType::Operate(*inputOutputPointer, inputExpression.Element(index));
+                }
+            }
+        }
+    };
+
+
     /*!  \brief Implement operation of the form \f$(v_{1}, v_{2}) = op(v_{1},
       v_{2})\f$ for dynamic vectors
 
@@ -6,7 +6,7 @@
   Author(s):	Ofri Sadowsky, Anton Deguet
   Created on: 2004-07-01
 
-  (C) Copyright 2004-2007 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -28,10 +28,14 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include <cisstVector/vctFixedStrideVectorIterator.h>
+#include <cisstVector/vctDynamicStorage.h>
+
+#include <algorithm>
 
 /*!
   This templated class owns a dynamically allocated array, but does
-  not provide any other operations */
+  not provide any other operations.  Small arrays are stored inline
+  and larger ones are aligned on the heap, see vctDynamicStorage. */
 template<class _elementType>
 class vctDynamicVectorOwner
 {
@@ -42,6 +46,9 @@ public:
     /*! The type of this owner. */
     typedef vctDynamicVectorOwner<_elementType> ThisType;
 
+    /*! The type used to allocate memory. */
+    typedef vctDynamicStorage<_elementType> StorageType;
+
     /* iterators are container specific */
     enum { DEFAULT_STRIDE = 1 };
 #ifndef SWIG
@@ -123,27 +130,40 @@ public:
 
       \note If the size is set to zero, the data pointer is set to
       null (0).
+
+      \note If the new size fits in the inline storage, no memory is
+      allocated on the heap.
      */
     void SetSize(size_type size) {
         if (size == Size) return;
         Disown();
-        Own(size, (size == 0) ? 0 : new value_type[size]);
+        Own(size, Storage.Allocate(size));
     }
 
     /*! Release the currently owned data pointer from being owned.
       Reset this owner's data pointer and size to zero.  Return the
-      old data pointer without freeing memory.
+      old data pointer without freeing memory.  If the data was stored
+      inline, it is first copied on the heap.  The memory returned
+      must be released using StorageType::DeallocateHeap (or owned by
+      another owner), not <code>delete[]</code>.
      */
     value_type * Release()
     {
         value_type * oldData = Data;
+        if (Storage.IsInline(Data)) {
+            oldData = StorageType::AllocateHeap(Size);
+            std::copy(Data, Data + Size, oldData);
+            Storage.Deallocate(Data, Size);
+        }
         Data = 0;
         Size = 0;
         return oldData;
     }
 
     /*! Have this owner take ownership of a new data pointer. Return
-      the old data pointer without freeing memory.
+      the old data pointer without freeing memory.  The data must
+      have been allocated using StorageType::AllocateHeap, e.g. by
+      Release.
     */
     value_type * Own(size_type size, value_type * data) {
         value_type * oldData = Data;
@@ -152,19 +172,44 @@ public:
         return oldData;
     }
 
+    /*! Take ownership of the data of another owner, which is left
+      empty.  The data pointer is transferred if it was allocated on
+      the heap, otherwise the elements are copied in the inline
+      storage of this owner.
+    */
+    void Acquire(ThisType & other) {
+        if (&other == this) return;
+        Disown();
+        if (other.Storage.IsInline(other.Data)) {
+            SetSize(other.Size);
+            std::copy(other.Data, other.Data + other.Size, Data);
+            other.Disown();
+        } else {
+            const size_type size = other.Size;
+            Own(size, other.Release());
+        }
+    }
+
     /*! Free the memory allocated for the data pointer.  Reset data
       pointer and size to zero.
     */
     void Disown(void) {
-        delete[] Data;
+        Storage.Deallocate(Data, Size);
         Size = 0;
         Data = 0;
     }
 
+    /*! Indicates if the data is stored inline, i.e. without any
+      memory allocated on the heap. */
+    inline bool IsInline(void) const {
+        return Storage.IsInline(Data);
+    }
+
 
 protected:
     size_type Size;
     value_type* Data;
+    StorageType Storage;
 
 private:
     // copy constructor private to prevent any call
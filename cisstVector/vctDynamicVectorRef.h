@@ -5,7 +5,7 @@
   Author(s):  Ofri Sadowsky, Anton Deguet
   Created on: 2004-07-01
 
-  (C) Copyright 2004-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -250,6 +250,11 @@ public:
     (const vctFixedSizeConstVectorBase<__size, __stride, __elementType, __dataPtrType> & other) {
         return reinterpret_cast<ThisType &>(this->Assign(other));
     }
+
+    template <class __expressionType>
+    inline ThisType & operator = (const vctDynamicVectorExpression<__expressionType, value_type> & expression) {
+        return reinterpret_cast<ThisType &>(this->Assign(expression));
+    }
     //@}
 
     /*! Assignement of a scalar to all elements.  See also SetAll. */
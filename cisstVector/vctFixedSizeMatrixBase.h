@@ -5,7 +5,7 @@
   Author(s):  Ofri Sadowsky, Anton Deguet
   Created on: 2003-11-04
 
-  (C) Copyright 2003-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2003-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -28,6 +28,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstCommon/cmnPortability.h>
 #include <cisstCommon/cmnTypeTraits.h>
 #include <cisstVector/vctFixedSizeConstMatrixBase.h>
+#include <cisstVector/vctFixedSizeSIMD.h>
 
 #include <cstdarg>
 
@@ -1255,6 +1256,17 @@ class vctFixedSizeMatrixBase : public vctFixedSizeConstMatrixBase
             _elementType, __input2DataPtrType> Input2MatrixType;
         typedef typename Input1MatrixType::ConstRowRefType Input1RowRefType;
         typedef typename Input2MatrixType::ConstColumnRefType Input2ColumnRefType;
+        // 3x3 and 4x4 products of doubles, including by a vector (see vctFixedSizeSIMD)
+        typedef vctFixedSizeSIMDProduct<_elementType, _rows, __input1Cols, _cols, _rowStride, _colStride,
+            __input1RowStride, __input1ColStride, __input2RowStride, __input2ColStride> SIMDProductType;
+        if (SIMDProductType::ENABLED) {
+            if ((this->Pointer() == input1Matrix.Pointer())
+                || (this->Pointer() == input2Matrix.Pointer())) {
+                vctFixedSizeMatrixLoopEngines::ThrowSharedPointersException();
+            }
+            SIMDProductType::Run(this->Pointer(), input1Matrix.Pointer(), input2Matrix.Pointer());
+            return;
+        }
         vctFixedSizeMatrixLoopEngines::
             Product<typename vctBinaryOperations<value_type, Input1RowRefType, Input2ColumnRefType>::DotProduct>::
             Run((*this), input1Matrix, input2Matrix);
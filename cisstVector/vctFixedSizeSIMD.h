@@ -0,0 +1,483 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#pragma once
+#ifndef _vctFixedSizeSIMD_h
+#define _vctFixedSizeSIMD_h
+
+/*!
+  \file
+  \brief Declaration of vctFixedSizeSIMD
+*/
+
+#include <cisstCommon/cmnPortability.h>
+#include <cisstVector/vctContainerTraits.h>
+#include <cisstVector/vctConfig.h>
+
+// instruction set selected when cisst is configured, all translation
+// units must use the same kernels since they are inline
+#if (CISST_VCT_FIXED_SIZE_SIMD_LEVEL >= 1)
+  #define CISST_VCT_SIMD_SSE2 1
+  #include <emmintrin.h>
+  #if !(defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+    #error "cisstVector was configured with SSE2 fixed size kernels (see CISST_VCT_FIXED_SIZE_SIMD_ISA), compile with SSE2 enabled"
+  #endif
+#else
+  #define CISST_VCT_SIMD_SSE2 0
+#endif
+
+#if (CISST_VCT_FIXED_SIZE_SIMD_LEVEL >= 2)
+  #define CISST_VCT_SIMD_AVX 1
+  #include <immintrin.h>
+  #if !defined(__AVX__)
+    #error "cisstVector was configured with AVX fixed size kernels (see CISST_VCT_FIXED_SIZE_SIMD_ISA), compile with AVX enabled (e.g. -mavx or /arch:AVX)"
+  #endif
+#else
+  #define CISST_VCT_SIMD_AVX 0
+#endif
+
+#if (CISST_VCT_FIXED_SIZE_SIMD_LEVEL >= 3)
+  #define CISST_VCT_SIMD_FMA 1
+  #if !(defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__)))
+    #error "cisstVector was configured with AVX and FMA fixed size kernels (see CISST_VCT_FIXED_SIZE_SIMD_ISA), compile with FMA enabled (e.g. -mfma or /arch:AVX2)"
+  #endif
+#else
+  #define CISST_VCT_SIMD_FMA 0
+#endif
+
+
+/*!
+  \brief SIMD kernels for small fixed size containers of doubles.
+
+  These kernels are used by the fixed size containers for the
+  operations used in most kinematic chains:
+
+  - product of 3x3 and 4x4 matrices (e.g. vctMatrixRotation3,
+    vctFrm3 and vctFrame4x4 composition);
+  - product of a 3x3 or 4x4 matrix by a vector (e.g. ApplyTo);
+  - cross product of two 3 elements vectors;
+  - product of two quaternions (e.g. vctQuaternionRotation3).
+
+  The instruction set is selected when cisst is configured, using the
+  CMake option CISST_VCT_FIXED_SIZE_SIMD_ISA (SSE2 by default, AVX or
+  AVX_FMA), and saved in vctConfig.h.  Since the kernels are inline,
+  all the code using cisstVector must agree on the instruction set,
+  compiler flags such as <code>-march=native</code> don't change the
+  kernels used.  AVX and AVX_FMA require the matching compiler flags
+  (e.g. <code>-mavx -mfma</code> or <code>/arch:AVX2</code>).  The
+  kernels can be disabled with the CMake option
+  CISST_VCT_FIXED_SIZE_SIMD.
+
+  The kernels perform the additions in the same order as the loop
+  engines so, unless FMA is used, the results are identical.  Matrices
+  must be stored in row major order with contiguous columns, other
+  layouts and element types use the loop engines (see
+  vctFixedSizeSIMDProduct, vctFixedSizeSIMDCrossProduct and
+  vctFixedSizeSIMDQuaternionProduct).
+*/
+class vctFixedSizeSIMD
+{
+public:
+    typedef vct::stride_type stride_type;
+
+    /*! Name of the instruction set used by the kernels, "none" if the
+      kernels are not used. */
+    inline static const char * InstructionSet(void) {
+#if CISST_VCT_SIMD_FMA
+        return "AVX+FMA";
+#elif CISST_VCT_SIMD_AVX
+        return "AVX";
+#elif CISST_VCT_SIMD_SSE2
+        return "SSE2";
+#else
+        return "none";
+#endif
+    }
+
+#if CISST_VCT_SIMD_SSE2
+    /*! output = input1 * input2 for 3x3 matrices. */
+    template <stride_type _outputRowStride, stride_type _input1RowStride, stride_type _input2RowStride>
+    inline static void Product3x3(double * output, const double * input1, const double * input2) {
+#if CISST_VCT_SIMD_AVX
+        // masked loads so the 4th element is never accessed
+        const __m256i mask = _mm256_set_epi64x(0, -1, -1, -1);
+        const __m256d row0 = _mm256_maskload_pd(input2, mask);
+        const __m256d row1 = _mm256_maskload_pd(input2 + _input2RowStride, mask);
+        const __m256d row2 = _mm256_maskload_pd(input2 + 2 * _input2RowStride, mask);
+        __m256d result[3];
+        for (stride_type row = 0; row < 3; ++row) {
+            const double * left = input1 + row * _input1RowStride;
+            result[row] = _mm256_mul_pd(_mm256_broadcast_sd(left), row0);
+            result[row] = MultiplyAdd(_mm256_broadcast_sd(left + 1), row1, result[row]);
+            result[row] = MultiplyAdd(_mm256_broadcast_sd(left + 2), row2, result[row]);
+        }
+        // masked stores are slow on some processors, store each row in two parts
+        for (stride_type row = 0; row < 3; ++row) {
+            _mm_storeu_pd(output + row * _outputRowStride, _mm256_castpd256_pd128(result[row]));
+            _mm_store_sd(output + row * _outputRowStride + 2, _mm256_extractf128_pd(result[row], 1));
+        }
+#else
+        const __m128d row0 = _mm_loadu_pd(input2);
+        const __m128d row1 = _mm_loadu_pd(input2 + _input2RowStride);
+        const __m128d row2 = _mm_loadu_pd(input2 + 2 * _input2RowStride);
+        const __m128d last0 = _mm_load_sd(input2 + 2);
+        const __m128d last1 = _mm_load_sd(input2 + _input2RowStride + 2);
+        const __m128d last2 = _mm_load_sd(input2 + 2 * _input2RowStride + 2);
+        __m128d result[3], resultLast[3];
+        for (stride_type row = 0; row < 3; ++row) {
+            const double * left = input1 + row * _input1RowStride;
+            const __m128d left0 = _mm_set1_pd(left[0]);
+            const __m128d left1 = _mm_set1_pd(left[1]);
+            const __m128d left2 = _mm_set1_pd(left[2]);
+            result[row] = _mm_add_pd(_mm_add_pd(_mm_mul_pd(left0, row0), _mm_mul_pd(left1, row1)),
+                                     _mm_mul_pd(left2, row2));
+            resultLast[row] = _mm_add_sd(_mm_add_sd(_mm_mul_sd(left0, last0), _mm_mul_sd(left1, last1)),
+                                         _mm_mul_sd(left2, last2));
+        }
+        for (stride_type row = 0; row < 3; ++row) {
+            _mm_storeu_pd(output + row * _outputRowStride, result[row]);
+            _mm_store_sd(output + row * _outputRowStride + 2, resultLast[row]);
+        }
+#endif
+    }
+
+    /*! output = input1 * input2 for 4x4 matrices. */
+    template <stride_type _outputRowStride, stride_type _input1RowStride, stride_type _input2RowStride>
+    inline static void Product4x4(double * output, const double * input1, const double * input2) {
+#if CISST_VCT_SIMD_AVX
+        const __m256d row0 = _mm256_loadu_pd(input2);
+        const __m256d row1 = _mm256_loadu_pd(input2 + _input2RowStride);
+        const __m256d row2 = _mm256_loadu_pd(input2 + 2 * _input2RowStride);
+        const __m256d row3 = _mm256_loadu_pd(input2 + 3 * _input2RowStride);
+        __m256d result[4];
+        for (stride_type row = 0; row < 4; ++row) {
+            const double * left = input1 + row * _input1RowStride;
+            result[row] = _mm256_mul_pd(_mm256_broadcast_sd(left), row0);
+            result[row] = MultiplyAdd(_mm256_broadcast_sd(left + 1), row1, result[row]);
+            result[row] = MultiplyAdd(_mm256_broadcast_sd(left + 2), row2, result[row]);
+            result[row] = MultiplyAdd(_mm256_broadcast_sd(left + 3), row3, result[row]);
+        }
+        for (stride_type row = 0; row < 4; ++row) {
+            _mm256_storeu_pd(output + row * _outputRowStride, result[row]);
+        }
+#else
+        __m128d right[4][2];
+        for (stride_type row = 0; row < 4; ++row) {
+            right[row][0] = _mm_loadu_pd(input2 + row * _input2RowStride);
+            right[row][1] = _mm_loadu_pd(input2 + row * _input2RowStride + 2);
+        }
+        __m128d result[4][2];
+        for (stride_type row = 0; row < 4; ++row) {
+            const double * left = input1 + row * _input1RowStride;
+            for (stride_type half = 0; half < 2; ++half) {
+                result[row][half] = _mm_mul_pd(_mm_set1_pd(left[0]), right[0][half]);
+                result[row][half] = _mm_add_pd(result[row][half], _mm_mul_pd(_mm_set1_pd(left[1]), right[1][half]));
+                result[row][half] = _mm_add_pd(result[row][half], _mm_mul_pd(_mm_set1_pd(left[2]), right[2][half]));
+                result[row][half] = _mm_add_pd(result[row][half], _mm_mul_pd(_mm_set1_pd(left[3]), right[3][half]));
+            }
+        }
+        for (stride_type row = 0; row < 4; ++row) {
+            _mm_storeu_pd(output + row * _outputRowStride, result[row][0]);
+            _mm_storeu_pd(output + row * _outputRowStride + 2, result[row][1]);
+        }
+#endif
+    }
+
+    /*! output = matrix * vector for a 3x3 matrix.  AVX doesn't help
+      for 3 elements so this kernel always uses SSE2. */
+    template <stride_type _outputStride, stride_type _matrixRowStride, stride_type _vectorStride>
+    inline static void MatrixVector3(double * output, const double * matrix, const double * vector) {
+        const __m128d vector0 = _mm_set1_pd(vector[0]);
+        const __m128d vector1 = _mm_set1_pd(vector[_vectorStride]);
+        const __m128d vector2 = _mm_set1_pd(vector[2 * _vectorStride]);
+        // first two rows, by columns
+        const double * row1 = matrix + _matrixRowStride;
+        const __m128d column0 = _mm_loadh_pd(_mm_load_sd(matrix), row1);
+        const __m128d column1 = _mm_loadh_pd(_mm_load_sd(matrix + 1), row1 + 1);
+        const __m128d column2 = _mm_loadh_pd(_mm_load_sd(matrix + 2), row1 + 2);
+        const __m128d result = _mm_add_pd(_mm_add_pd(_mm_mul_pd(column0, vector0), _mm_mul_pd(column1, vector1)),
+                                          _mm_mul_pd(column2, vector2));
+        // last row
+        const double * row2 = matrix + 2 * _matrixRowStride;
+        const __m128d resultLast = _mm_add_sd(_mm_add_sd(_mm_mul_sd(_mm_load_sd(row2), vector0),
+                                                         _mm_mul_sd(_mm_load_sd(row2 + 1), vector1)),
+                                              _mm_mul_sd(_mm_load_sd(row2 + 2), vector2));
+        _mm_storel_pd(output, result);
+        _mm_storeh_pd(output + _outputStride, result);
+        _mm_store_sd(output + 2 * _outputStride, resultLast);
+    }
+
+    /*! output = matrix * vector for a 4x4 matrix. */
+    template <stride_type _outputStride, stride_type _matrixRowStride, stride_type _vectorStride>
+    inline static void MatrixVector4(double * output, const double * matrix, const double * vector) {
+#if CISST_VCT_SIMD_AVX
+        // transpose the matrix to compute the product by columns
+        const __m256d row0 = _mm256_loadu_pd(matrix);
+        const __m256d row1 = _mm256_loadu_pd(matrix + _matrixRowStride);
+        const __m256d row2 = _mm256_loadu_pd(matrix + 2 * _matrixRowStride);
+        const __m256d row3 = _mm256_loadu_pd(matrix + 3 * _matrixRowStride);
+        const __m256d low01 = _mm256_unpacklo_pd(row0, row1);
+        const __m256d high01 = _mm256_unpackhi_pd(row0, row1);
+        const __m256d low23 = _mm256_unpacklo_pd(row2, row3);
+        const __m256d high23 = _mm256_unpackhi_pd(row2, row3);
+        __m256d result = _mm256_mul_pd(_mm256_permute2f128_pd(low01, low23, 0x20), _mm256_broadcast_sd(vector));
+        result = MultiplyAdd(_mm256_permute2f128_pd(high01, high23, 0x20), _mm256_broadcast_sd(vector + _vectorStride), result);
+        result = MultiplyAdd(_mm256_permute2f128_pd(low01, low23, 0x31), _mm256_broadcast_sd(vector + 2 * _vectorStride), result);
+        result = MultiplyAdd(_mm256_permute2f128_pd(high01, high23, 0x31), _mm256_broadcast_sd(vector + 3 * _vectorStride), result);
+        if (_outputStride == 1) {
+            _mm256_storeu_pd(output, result);
+        } else {
+            const __m128d result01 = _mm256_castpd256_pd128(result);
+            const __m128d result23 = _mm256_extractf128_pd(result, 1);
+            _mm_storel_pd(output, result01);
+            _mm_storeh_pd(output + _outputStride, result01);
+            _mm_storel_pd(output + 2 * _outputStride, result23);
+            _mm_storeh_pd(output + 3 * _outputStride, result23);
+        }
+#else
+        __m128d result01 = _mm_setzero_pd();
+        __m128d result23 = _mm_setzero_pd();
+        const double * row1 = matrix + _matrixRowStride;
+        const double * row2 = matrix + 2 * _matrixRowStride;
+        const double * row3 = matrix + 3 * _matrixRowStride;
+        for (stride_type col = 0; col < 4; ++col) {
+            const __m128d element = _mm_set1_pd(vector[col * _vectorStride]);
+            const __m128d column01 = _mm_loadh_pd(_mm_load_sd(matrix + col), row1 + col);
+            const __m128d column23 = _mm_loadh_pd(_mm_load_sd(row2 + col), row3 + col);
+            if (col == 0) {
+                result01 = _mm_mul_pd(column01, element);
+                result23 = _mm_mul_pd(column23, element);
+            } else {
+                result01 = _mm_add_pd(result01, _mm_mul_pd(column01, element));
+                result23 = _mm_add_pd(result23, _mm_mul_pd(column23, element));
+            }
+        }
+        _mm_storel_pd(output, result01);
+        _mm_storeh_pd(output + _outputStride, result01);
+        _mm_storel_pd(output + 2 * _outputStride, result23);
+        _mm_storeh_pd(output + 3 * _outputStride, result23);
+#endif
+    }
+
+    /*! output = input1 x input2 for 3 elements vectors.  The inputs
+      are read before the output is written so they can overlap. */
+    template <stride_type _outputStride, stride_type _input1Stride, stride_type _input2Stride>
+    inline static void CrossProduct(double * output, const double * input1, const double * input2) {
+        const double * input1Y = input1 + _input1Stride;
+        const double * input1Z = input1 + 2 * _input1Stride;
+        const double * input2Y = input2 + _input2Stride;
+        const double * input2Z = input2 + 2 * _input2Stride;
+        // (y1 * z2 - z1 * y2, z1 * x2 - x1 * z2)
+        const __m128d result = _mm_sub_pd(_mm_mul_pd(_mm_loadh_pd(_mm_load_sd(input1Y), input1Z),
+                                                     _mm_loadh_pd(_mm_load_sd(input2Z), input2)),
+                                          _mm_mul_pd(_mm_loadh_pd(_mm_load_sd(input1Z), input1),
+                                                     _mm_loadh_pd(_mm_load_sd(input2Y), input2Z)));
+        // x1 * y2 - y1 * x2
+        const __m128d resultZ = _mm_sub_sd(_mm_mul_sd(_mm_load_sd(input1), _mm_load_sd(input2Y)),
+                                           _mm_mul_sd(_mm_load_sd(input1Y), _mm_load_sd(input2)));
+        _mm_storel_pd(output, result);
+        _mm_storeh_pd(output + _outputStride, result);
+        _mm_store_sd(output + 2 * _outputStride, resultZ);
+    }
+
+    /*! output = input1 * input2 for quaternions stored as X, Y, Z, R
+      in contiguous memory.  The product is computed as:
+      \code
+      output = R1 * (X2, Y2, Z2, R2) + X1 * (R2, -Z2, Y2, -X2)
+             + Y1 * (Z2, R2, -X2, -Y2) + Z1 * (-Y2, X2, R2, -Z2)
+      \endcode
+    */
+    inline static void QuaternionProduct(double * output, const double * input1, const double * input2) {
+#if CISST_VCT_SIMD_AVX
+        const __m256d right = _mm256_loadu_pd(input2);                   // X2 Y2 Z2 R2
+        const __m256d swapped = _mm256_permute2f128_pd(right, right, 1); // Z2 R2 X2 Y2
+        const __m256d permuted1 = _mm256_xor_pd(_mm256_permute_pd(swapped, 5), _mm256_set_pd(-0.0, 0.0, -0.0, 0.0));
+        const __m256d permuted2 = _mm256_xor_pd(swapped, _mm256_set_pd(-0.0, -0.0, 0.0, 0.0));
+        const __m256d permuted3 = _mm256_xor_pd(_mm256_permute_pd(right, 5), _mm256_set_pd(-0.0, 0.0, 0.0, -0.0));
+        __m256d result = _mm256_mul_pd(_mm256_broadcast_sd(input1 + 3), right);
+        result = MultiplyAdd(_mm256_broadcast_sd(input1), permuted1, result);
+        result = MultiplyAdd(_mm256_broadcast_sd(input1 + 1), permuted2, result);
+        result = MultiplyAdd(_mm256_broadcast_sd(input1 + 2), permuted3, result);
+        _mm256_storeu_pd(output, result);
+#else
+        const __m128d rightXY = _mm_loadu_pd(input2);
+        const __m128d rightZR = _mm_loadu_pd(input2 + 2);
+        const __m128d negateY = _mm_set_pd(-0.0, 0.0);
+        const __m128d negateX = _mm_set_pd(0.0, -0.0);
+        const __m128d negateXY = _mm_set_pd(-0.0, -0.0);
+        const __m128d left0 = _mm_set1_pd(input1[0]);
+        const __m128d left1 = _mm_set1_pd(input1[1]);
+        const __m128d left2 = _mm_set1_pd(input1[2]);
+        const __m128d left3 = _mm_set1_pd(input1[3]);
+        // first half (X, Y) then second half (Z, R)
+        __m128d resultXY = _mm_mul_pd(left3, rightXY);
+        resultXY = _mm_add_pd(resultXY, _mm_mul_pd(left0, _mm_xor_pd(_mm_shuffle_pd(rightZR, rightZR, 1), negateY)));
+        resultXY = _mm_add_pd(resultXY, _mm_mul_pd(left1, rightZR));
+        resultXY = _mm_add_pd(resultXY, _mm_mul_pd(left2, _mm_xor_pd(_mm_shuffle_pd(rightXY, rightXY, 1), negateX)));
+        __m128d resultZR = _mm_mul_pd(left3, rightZR);
+        resultZR = _mm_add_pd(resultZR, _mm_mul_pd(left0, _mm_xor_pd(_mm_shuffle_pd(rightXY, rightXY, 1), negateY)));
+        resultZR = _mm_add_pd(resultZR, _mm_mul_pd(left1, _mm_xor_pd(rightXY, negateXY)));
+        resultZR = _mm_add_pd(resultZR, _mm_mul_pd(left2, _mm_xor_pd(_mm_shuffle_pd(rightZR, rightZR, 1), negateY)));
+        _mm_storeu_pd(output, resultXY);
+        _mm_storeu_pd(output + 2, resultZR);
+#endif
+    }
+
+protected:
+#if CISST_VCT_SIMD_AVX
+    /*! a * b + c, using FMA if available. */
+    inline static __m256d MultiplyAdd(const __m256d a, const __m256d b, const __m256d c) {
+#if CISST_VCT_SIMD_FMA
+        return _mm256_fmadd_pd(a, b, c);
+#else
+        return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+    }
+#endif
+
+#endif // CISST_VCT_SIMD_SSE2
+};
+
+
+/*!
+  \brief Selection of the SIMD kernel used by
+  vctFixedSizeMatrixBase::ProductOf.
+
+  ENABLED is false unless the element type, sizes and strides match
+  one of the kernels of vctFixedSizeSIMD: double precision 3x3 and 4x4
+  row major matrices multiplied by a matrix or by a column (the
+  product of a matrix by a vector uses a matrix with one column, see
+  MultiplyMatrixVector).
+*/
+template <class _elementType, vct::size_type _rows, vct::size_type _common, vct::size_type _cols,
+          vct::stride_type _outputRowStride, vct::stride_type _outputColStride,
+          vct::stride_type _input1RowStride, vct::stride_type _input1ColStride,
+          vct::stride_type _input2RowStride, vct::stride_type _input2ColStride>
+class vctFixedSizeSIMDProduct
+{
+public:
+    enum {ENABLED = 0};
+    inline static void Run(_elementType * CMN_UNUSED(output),
+                           const _elementType * CMN_UNUSED(input1),
+                           const _elementType * CMN_UNUSED(input2)) {}
+};
+
+
+/*!
+  \brief Selection of the SIMD kernel used by
+  vctFixedSizeVectorBase::CrossProductOf.
+*/
+template <class _elementType, vct::stride_type _outputStride, vct::stride_type _input1Stride, vct::stride_type _input2Stride>
+class vctFixedSizeSIMDCrossProduct
+{
+public:
+    enum {ENABLED = 0};
+    inline static void Run(_elementType * CMN_UNUSED(output),
+                           const _elementType * CMN_UNUSED(input1),
+                           const _elementType * CMN_UNUSED(input2)) {}
+};
+
+
+/*!
+  \brief Selection of the SIMD kernel used by
+  vctQuaternionBase::ProductOf, only for contiguous quaternions.
+*/
+template <class _elementType, vct::stride_type _outputStride, vct::stride_type _input1Stride, vct::stride_type _input2Stride>
+class vctFixedSizeSIMDQuaternionProduct
+{
+public:
+    enum {ENABLED = 0};
+    inline static void Run(_elementType * CMN_UNUSED(output),
+                           const _elementType * CMN_UNUSED(input1),
+                           const _elementType * CMN_UNUSED(input2)) {}
+};
+
+
+#ifndef DOXYGEN
+#if CISST_VCT_SIMD_SSE2
+
+template <vct::stride_type _outputRowStride, vct::stride_type _input1RowStride, vct::stride_type _input2RowStride>
+class vctFixedSizeSIMDProduct<double, 3, 3, 3, _outputRowStride, 1, _input1RowStride, 1, _input2RowStride, 1>
+{
+public:
+    enum {ENABLED = 1};
+    inline static void Run(double * output, const double * input1, const double * input2) {
+        vctFixedSizeSIMD::Product3x3<_outputRowStride, _input1RowStride, _input2RowStride>(output, input1, input2);
+    }
+};
+
+template <vct::stride_type _outputRowStride, vct::stride_type _input1RowStride, vct::stride_type _input2RowStride>
+class vctFixedSizeSIMDProduct<double, 4, 4, 4, _outputRowStride, 1, _input1RowStride, 1, _input2RowStride, 1>
+{
+public:
+    enum {ENABLED = 1};
+    inline static void Run(double * output, const double * input1, const double * input2) {
+        vctFixedSizeSIMD::Product4x4<_outputRowStride, _input1RowStride, _input2RowStride>(output, input1, input2);
+    }
+};
+
+// product by a column, the column strides are not used
+template <vct::stride_type _outputRowStride, vct::stride_type _outputColStride,
+          vct::stride_type _input1RowStride,
+          vct::stride_type _input2RowStride, vct::stride_type _input2ColStride>
+class vctFixedSizeSIMDProduct<double, 3, 3, 1, _outputRowStride, _outputColStride, _input1RowStride, 1, _input2RowStride, _input2ColStride>
+{
+public:
+    enum {ENABLED = 1};
+    inline static void Run(double * output, const double * input1, const double * input2) {
+        vctFixedSizeSIMD::MatrixVector3<_outputRowStride, _input1RowStride, _input2RowStride>(output, input1, input2);
+    }
+};
+
+template <vct::stride_type _outputRowStride, vct::stride_type _outputColStride,
+          vct::stride_type _input1RowStride,
+          vct::stride_type _input2RowStride, vct::stride_type _input2ColStride>
+class vctFixedSizeSIMDProduct<double, 4, 4, 1, _outputRowStride, _outputColStride, _input1RowStride, 1, _input2RowStride, _input2ColStride>
+{
+public:
+    enum {ENABLED = 1};
+    inline static void Run(double * output, const double * input1, const double * input2) {
+        vctFixedSizeSIMD::MatrixVector4<_outputRowStride, _input1RowStride, _input2RowStride>(output, input1, input2);
+    }
+};
+
+template <vct::stride_type _outputStride, vct::stride_type _input1Stride, vct::stride_type _input2Stride>
+class vctFixedSizeSIMDCrossProduct<double, _outputStride, _input1Stride, _input2Stride>
+{
+public:
+    enum {ENABLED = 1};
+    inline static void Run(double * output, const double * input1, const double * input2) {
+        vctFixedSizeSIMD::CrossProduct<_outputStride, _input1Stride, _input2Stride>(output, input1, input2);
+    }
+};
+
+template <>
+class vctFixedSizeSIMDQuaternionProduct<double, 1, 1, 1>
+{
+public:
+    enum {ENABLED = 1};
+    inline static void Run(double * output, const double * input1, const double * input2) {
+        vctFixedSizeSIMD::QuaternionProduct(output, input1, input2);
+    }
+};
+
+#endif // CISST_VCT_SIMD_SSE2
+#endif // DOXYGEN
+
+
+#endif // _vctFixedSizeSIMD_h
@@ -5,7 +5,7 @@
   Author(s):  Ofri Sadowsky, Anton Deguet
   Created on: 2003-09-30
 
-  (C) Copyright 2003-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2003-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -27,6 +27,7 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstCommon/cmnDeSerializer.h>
 #include <cisstVector/vctFixedSizeConstVectorBase.h>
+#include <cisstVector/vctFixedSizeSIMD.h>
 
 #include <cstdarg>
 
@@ -783,6 +784,12 @@ class vctFixedSizeVectorBase : public vctFixedSizeConstVectorBase<_size, _stride
                                const vctFixedSizeConstVectorBase<3, __stride2, _elementType, __dataPtr2Type> & inputVector2)
     {
         CMN_ASSERT(SIZE == 3);
+        // vectors of doubles (see vctFixedSizeSIMD)
+        typedef vctFixedSizeSIMDCrossProduct<_elementType, _stride, __stride1, __stride2> SIMDCrossProductType;
+        if (SIMDCrossProductType::ENABLED) {
+            SIMDCrossProductType::Run(this->Pointer(), inputVector1.Pointer(), inputVector2.Pointer());
+            return;
+        }
         (*this)[0] = inputVector1[1] *  inputVector2[2] - inputVector1[2] * inputVector2[1];
         (*this)[1] = inputVector1[2] *  inputVector2[0] - inputVector1[0] * inputVector2[2];
         (*this)[2] = inputVector1[0] *  inputVector2[1] - inputVector1[1] * inputVector2[0];
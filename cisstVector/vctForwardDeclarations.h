@@ -5,7 +5,7 @@
   Author(s):	Anton Deguet
   Created on:	2004-10-25
 
-  (C) Copyright 2004-2020 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -139,6 +139,9 @@ class vctDynamicVectorOwner;
 template <class _elementType>
 class vctDynamicVectorRefOwner;
 
+template <class _expressionType, class _elementType>
+class vctDynamicVectorExpression;
+
 
 // dynamic matrices
 template <class _matrixOwnerType, class _elementType>
@@ -165,6 +168,9 @@ class vctDynamicMatrixOwner;
 template <class _elementType>
 class vctDynamicMatrixRefOwner;
 
+template <class _expressionType, class _elementType>
+class vctDynamicMatrixExpression;
+
 
 // dynamic nArrays
 template <class _nArrayOwnerType, class _elementType, vct::size_type _dimension>
@@ -0,0 +1,192 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#pragma once
+#ifndef _vctParallel_h
+#define _vctParallel_h
+
+/*!
+  \file
+  \brief Declaration of vctParallel
+*/
+
+#include <cisstCommon/cmnPortability.h>
+#include <cisstVector/vctContainerTraits.h>
+
+#include <atomic>
+
+// Always include last
+#include <cisstVector/vctExport.h>
+
+/*!
+  \brief Parallel execution policy for the dynamic loop engines.
+
+  By default, all the operations on dynamic containers run on the
+  calling thread.  When enabled with SetNumberOfThreads, operations on
+  large containers (at least GetThreshold elements) are split in blocks
+  processed by a pool of threads:
+
+  - elementwise operations and reductions on compact containers (see
+    vctDynamicCompactLoopEngines), including vectors, matrices and
+    nArrays;
+  - elementwise operations, reductions and SelectRowsByIndex on
+    non-compact matrices (see vctDynamicMatrixLoopEngines), split by
+    blocks of rows.
+
+  The number of blocks only depends on the size of the containers, not
+  on the number of threads, and the partial results of reductions
+  (e.g. SumOfElements, NormSquare, MaxAbsElement) are always combined
+  in the same order so the results are deterministic.  Note that the
+  floating point results of sums might still differ slightly from the
+  sequential loop.
+
+  \code
+  vctParallel::SetNumberOfThreads(0); // use all the processors
+  vctDoubleVec points(3000000);
+  double sum = points.SumOfElements(); // computed in parallel
+  \endcode
+
+  Operations started from a thread of the pool or while the pool is
+  already used by another thread are computed sequentially.
+*/
+class CISST_EXPORT vctParallel
+{
+public:
+    typedef vct::size_type size_type;
+    typedef vct::index_type index_type;
+
+    /*! Blocks have at least MINIMUM_BLOCK_SIZE elements and there are
+      at most MAXIMUM_NUMBER_OF_BLOCKS blocks. */
+    enum {MINIMUM_BLOCK_SIZE = 16384, MAXIMUM_NUMBER_OF_BLOCKS = 64};
+
+    /*! Number of threads used, including the calling thread.  1
+      (default) disables the parallel execution. */
+    static size_type GetNumberOfThreads(void);
+
+    /*! Set the number of threads used, 0 to use as many threads as
+      processors.  The thread pool is created or resized immediately. */
+    static void SetNumberOfThreads(const size_type numberOfThreads);
+
+    /*! Minimum number of elements for which operations are computed
+      in parallel.  Smaller containers always use the sequential loops
+      without any overhead. */
+    static size_type GetThreshold(void);
+    static void SetThreshold(const size_type numberOfElements);
+
+    /*! Indicates if an operation on a given number of elements should
+      be computed in parallel. */
+    inline static bool IsEnabled(const size_type numberOfElements) {
+        return (numberOfElements >= EnabledThreshold.load(std::memory_order_relaxed)) && IsAvailable();
+    }
+
+    /*! Number of blocks used for a given number of elements, split in
+      numberOfItems items (e.g. rows).  This doesn't depend on the
+      number of threads. */
+    inline static size_type NumberOfBlocks(const size_type numberOfElements, const size_type numberOfItems) {
+        size_type numberOfBlocks = numberOfElements / MINIMUM_BLOCK_SIZE;
+        if (numberOfBlocks > MAXIMUM_NUMBER_OF_BLOCKS) {
+            numberOfBlocks = MAXIMUM_NUMBER_OF_BLOCKS;
+        }
+        if (numberOfBlocks > numberOfItems) {
+            numberOfBlocks = numberOfItems;
+        }
+        return (numberOfBlocks == 0) ? 1 : numberOfBlocks;
+    }
+
+    /*! Call function(begin, end) for numberOfBlocks contiguous ranges
+      covering [0, numberOfItems), using the thread pool.  Returns once
+      all the blocks have been processed.  If the function throws an
+      exception, the first one is re-thrown by this method. */
+    template <class _functionType>
+    static void For(const size_type numberOfItems, const size_type numberOfBlocks,
+                    const _functionType & function) {
+        ForData<_functionType> data(function, numberOfItems, numberOfBlocks, 0);
+        Run(numberOfBlocks, &ForTask<_functionType>, &data);
+    }
+
+    /*! Compute partial results using function(begin, end) for
+      numberOfBlocks contiguous ranges covering [0, numberOfItems) and
+      combine them in order using _incrementalOperationType.  The
+      number of blocks is limited to MAXIMUM_NUMBER_OF_BLOCKS. */
+    template <class _incrementalOperationType, class _functionType>
+    static typename _incrementalOperationType::OutputType
+    Reduce(const size_type numberOfItems, size_type numberOfBlocks,
+           const _functionType & function) {
+        typedef typename _incrementalOperationType::OutputType OutputType;
+        if (numberOfBlocks > MAXIMUM_NUMBER_OF_BLOCKS) {
+            numberOfBlocks = MAXIMUM_NUMBER_OF_BLOCKS;
+        }
+        OutputType partialResults[MAXIMUM_NUMBER_OF_BLOCKS];
+        ForData<_functionType, OutputType> data(function, numberOfItems, numberOfBlocks, partialResults);
+        Run(numberOfBlocks, &ReduceTask<_functionType, OutputType>, &data);
+        OutputType result = _incrementalOperationType::NeutralElement();
+        for (index_type block = 0; block < numberOfBlocks; ++block) {
+            result = _incrementalOperationType::Operate(result, partialResults[block]);
+        }
+        return result;
+    }
+
+    /*! Type of tasks executed by the thread pool. */
+    typedef void (*TaskType)(void * data, const index_type task);
+
+    /*! Execute task(data, index) for all indices in [0, numberOfTasks)
+      using the thread pool, including the calling thread. */
+    static void Run(const size_type numberOfTasks, TaskType task, void * data);
+
+protected:
+    /*! Threshold used by IsEnabled, maximum size_type if the parallel
+      execution is disabled.  Atomic since it can be changed while
+      other threads use the loop engines. */
+    static std::atomic<size_type> EnabledThreshold;
+
+    /*! False if called from a thread of the pool. */
+    static bool IsAvailable(void);
+
+    template <class _functionType, class _outputType = int>
+    class ForData {
+    public:
+        inline ForData(const _functionType & function, const size_type numberOfItems,
+                       const size_type numberOfBlocks, _outputType * results):
+            Function(function),
+            NumberOfItems(numberOfItems),
+            NumberOfBlocks(numberOfBlocks),
+            Results(results)
+        {}
+        inline size_type Begin(const index_type block) const {
+            return (NumberOfItems / NumberOfBlocks) * block + ((block < NumberOfItems % NumberOfBlocks) ? block : NumberOfItems % NumberOfBlocks);
+        }
+        const _functionType & Function;
+        const size_type NumberOfItems;
+        const size_type NumberOfBlocks;
+        _outputType * Results;
+    };
+
+    template <class _functionType>
+    static void ForTask(void * data, const index_type block) {
+        const ForData<_functionType> & forData = *static_cast<ForData<_functionType> *>(data);
+        forData.Function(forData.Begin(block), forData.Begin(block + 1));
+    }
+
+    template <class _functionType, class _outputType>
+    static void ReduceTask(void * data, const index_type block) {
+        const ForData<_functionType, _outputType> & forData = *static_cast<ForData<_functionType, _outputType> *>(data);
+        forData.Results[block] = forData.Function(forData.Begin(block), forData.Begin(block + 1));
+    }
+};
+
+#endif // _vctParallel_h
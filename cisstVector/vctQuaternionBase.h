@@ -6,7 +6,7 @@
   Author(s):	Anton Deguet
   Created on:	2005-08-18
 
-  (C) Copyright 2005-2007 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2005-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -30,6 +30,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstCommon/cmnTypeTraits.h>
 #include <cisstVector/vctContainerTraits.h>
 #include <cisstVector/vctDynamicVector.h>
+#include <cisstVector/vctFixedSizeSIMD.h>
 // always the last file to include
 #include <cisstVector/vctExport.h>
 
@@ -148,6 +149,12 @@ protected:
     template <class __containerType1, class __containerType2>
     inline ThisType & ProductOf(const vctQuaternionBase<__containerType1> & quat1,
                                 const vctQuaternionBase<__containerType2> & quat2) {
+        // contiguous quaternions of doubles (see vctFixedSizeSIMD)
+        typedef vctFixedSizeSIMDQuaternionProduct<value_type, BaseType::STRIDE, __containerType1::STRIDE, __containerType2::STRIDE> SIMDQuaternionProductType;
+        if (SIMDQuaternionProductType::ENABLED) {
+            SIMDQuaternionProductType::Run(this->Pointer(), quat1.Pointer(), quat2.Pointer());
+            return *this;
+        }
         this->X() = quat1.R() * quat2.X() +  quat1.X() * quat2.R() +  quat1.Y() * quat2.Z() -  quat1.Z() * quat2.Y();
         this->Y() = quat1.R() * quat2.Y() -  quat1.X() * quat2.Z() +  quat1.Y() * quat2.R() +  quat1.Z() * quat2.X();
         this->Z() = quat1.R() * quat2.Z() +  quat1.X() * quat2.Y() -  quat1.Y() * quat2.X() +  quat1.Z() * quat2.R();